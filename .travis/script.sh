@@ -85,6 +85,10 @@ case "${BUILD_TARGET}" in
         ./configure -C --enable-coverage --with-target-network=lwip --with-lwip=internal --disable-java && make && sudo make check
         ;;
 
+    linux-device-layer-gcc-check)
+        ./configure -C --with-device-layer=linux && make && make check
+        ;;
+
     osx-auto-clang)
         make -f Makefile-Standalone DEBUG=1 HAPPY=0 USE_LWIP=0 stage
         ;;
@@ -30,4 +30,12 @@
 // Experimentation has shown that four (4) tends to be a reasonable number.
 #define BLE_LAYER_NUM_BLE_ENDPOINTS 4
 
+// Negotiate fragments of up to 244 bytes, the most an ATT write or
+// indication can carry in one LE link layer packet of 251 bytes.
+#define BLE_CONFIG_MAX_FRAGMENT_SIZE 244
+
+// Hand out GATT sends one at a time, round-robin, across concurrent
+// end points so that the multi-connection tests exercise fair scheduling.
+#define BLE_LAYER_MAX_GATT_SENDS_IN_FLIGHT 1
+
 #endif /* BLEPROJECTCONFIG_H */
@@ -29,4 +29,7 @@
 //#define WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX 9050
 #endif
 
+// Record latency histograms at the hot points of the stack (see nl::Weave::System::Stats::LatencyPoint).
+#define WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS 1
+
 #endif /* SYSTEMPROJECTCONFIG_H */
@@ -41,6 +41,24 @@
 
 #define WDM_UPDATE_MAX_ITEMS_IN_TRAIT_DIRTY_PATH_STORE 300
 
+// Share encoded trait data across subscribers within a notification engine run
+#define WDM_PUBLISHER_NOTIFY_ENCODE_CACHE_SIZE 4096
+
+// Allow pipelined notifies on established subscriptions
+#define WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE 4
+
+// Send trait deltas relative to the last acknowledged version where possible
+#define WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE 16
+
+// Allow pipelined update requests from subscription clients
+#define WDM_CLIENT_MAX_UPDATE_WINDOW_SIZE 4
+
+// Coalesce solitary WRMP acks for exchanges with the same peer
+#define WEAVE_CONFIG_WRMP_MAX_COALESCED_ACKS 8
+
+// Query all time sync contacts at once instead of one at a time
+#define WEAVE_CONFIG_TIME_CLIENT_CONCURRENT_SYNC 1
+
 // Uncomment this for a large Tunnel MTU.
 //#define WEAVE_CONFIG_TUNNEL_INTERFACE_MTU                           (9000)
 
@@ -55,6 +73,9 @@
 // properly when WEAVE_CONFIG_RNG_IMPLEMENTATION_NESTDRBG is enabled.
 #define WEAVE_CONFIG_DEV_RANDOM_DRBG_SEED 1
 
+// Serve small DRBG requests from a buffer of pre-generated output.
+#define WEAVE_CONFIG_DRBG_OUTPUT_BUFFER_SIZE 256
+
 #define WEAVE_CONFIG_SECURITY_TEST_MODE 1
 
 #define WDM_ENFORCE_EXPIRY_TIME 1
@@ -78,4 +99,14 @@
 
 #define WEAVE_CONFIG_MAX_SOFTWARE_VERSION_LENGTH 128
 
+// Allow test applications to exercise windowed and hashed BDX transfers.
+#define WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE 8
+
+#define WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT 1
+
+// Checkpoint BDX transfers often enough for the small files used in tests to resume part way.
+#define WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT 1
+
+#define WEAVE_CONFIG_BDX_CHECKPOINT_INTERVAL 1024
+
 #endif /* WEAVEPROJECTCONFIG_H */
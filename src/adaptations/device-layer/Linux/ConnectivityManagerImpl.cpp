@@ -0,0 +1,41 @@
+/*
+ *
+ *    Copyright (c) 2018 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <Weave/DeviceLayer/internal/WeaveDeviceLayerInternal.h>
+#include <Weave/DeviceLayer/ConnectivityManager.h>
+
+namespace nl {
+namespace Weave {
+namespace DeviceLayer {
+
+ConnectivityManagerImpl ConnectivityManagerImpl::sInstance;
+
+WEAVE_ERROR ConnectivityManagerImpl::_Init()
+{
+    // The host manages its own network interfaces and routes, so there is nothing
+    // further to initialize here.  In particular, Warm is not used on Linux.
+    return WEAVE_NO_ERROR;
+}
+
+void ConnectivityManagerImpl::_OnPlatformEvent(const WeaveDeviceEvent * event)
+{
+}
+
+} // namespace DeviceLayer
+} // namespace Weave
+} // namespace nl
@@ -0,0 +1,577 @@
+/*
+ *
+ *    Copyright (c) 2018 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *          Utilities for accessing persisted device configuration on
+ *          Linux platforms.
+ */
+
+#include <Weave/DeviceLayer/internal/WeaveDeviceLayerInternal.h>
+#include <Weave/DeviceLayer/Linux/LinuxConfig.h>
+#include <Weave/Core/WeaveEncoding.h>
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include <map>
+#include <string>
+
+namespace nl {
+namespace Weave {
+namespace DeviceLayer {
+namespace Internal {
+
+// *** CAUTION ***: Changing the names or namespaces of these values will *break* existing devices.
+
+// Namespaces used to store device configuration information.
+const char LinuxConfig::kConfigNamespace_WeaveFactory[]                    = "weave-factory";
+const char LinuxConfig::kConfigNamespace_WeaveConfig[]                     = "weave-config";
+const char LinuxConfig::kConfigNamespace_WeaveCounters[]                   = "weave-counters";
+
+// Keys stored in the weave-factory namespace
+const LinuxConfig::Key LinuxConfig::kConfigKey_SerialNum                   = { kConfigNamespace_WeaveFactory, "serial-num"         };
+const LinuxConfig::Key LinuxConfig::kConfigKey_MfrDeviceId                 = { kConfigNamespace_WeaveFactory, "device-id"          };
+const LinuxConfig::Key LinuxConfig::kConfigKey_MfrDeviceCert               = { kConfigNamespace_WeaveFactory, "device-cert"        };
+const LinuxConfig::Key LinuxConfig::kConfigKey_MfrDeviceICACerts           = { kConfigNamespace_WeaveFactory, "device-ca-certs"    };
+const LinuxConfig::Key LinuxConfig::kConfigKey_MfrDevicePrivateKey         = { kConfigNamespace_WeaveFactory, "device-key"         };
+const LinuxConfig::Key LinuxConfig::kConfigKey_ProductRevision             = { kConfigNamespace_WeaveFactory, "product-rev"        };
+const LinuxConfig::Key LinuxConfig::kConfigKey_ManufacturingDate           = { kConfigNamespace_WeaveFactory, "mfg-date"           };
+const LinuxConfig::Key LinuxConfig::kConfigKey_PairingCode                 = { kConfigNamespace_WeaveFactory, "pairing-code"       };
+
+// Keys stored in the weave-config namespace
+const LinuxConfig::Key LinuxConfig::kConfigKey_FabricId                    = { kConfigNamespace_WeaveConfig,  "fabric-id"          };
+const LinuxConfig::Key LinuxConfig::kConfigKey_ServiceConfig               = { kConfigNamespace_WeaveConfig,  "service-config"     };
+const LinuxConfig::Key LinuxConfig::kConfigKey_PairedAccountId             = { kConfigNamespace_WeaveConfig,  "account-id"         };
+const LinuxConfig::Key LinuxConfig::kConfigKey_ServiceId                   = { kConfigNamespace_WeaveConfig,  "service-id"         };
+const LinuxConfig::Key LinuxConfig::kConfigKey_FabricSecret                = { kConfigNamespace_WeaveConfig,  "fabric-secret"      };
+const LinuxConfig::Key LinuxConfig::kConfigKey_GroupKeyIndex               = { kConfigNamespace_WeaveConfig,  "group-key-index"    };
+const LinuxConfig::Key LinuxConfig::kConfigKey_LastUsedEpochKeyId          = { kConfigNamespace_WeaveConfig,  "last-ek-id"         };
+const LinuxConfig::Key LinuxConfig::kConfigKey_FailSafeArmed               = { kConfigNamespace_WeaveConfig,  "fail-safe-armed"    };
+const LinuxConfig::Key LinuxConfig::kConfigKey_OperationalDeviceId         = { kConfigNamespace_WeaveConfig,  "op-device-id"       };
+const LinuxConfig::Key LinuxConfig::kConfigKey_OperationalDeviceCert       = { kConfigNamespace_WeaveConfig,  "op-device-cert"     };
+const LinuxConfig::Key LinuxConfig::kConfigKey_OperationalDeviceICACerts   = { kConfigNamespace_WeaveConfig,  "op-device-ca-certs" };
+const LinuxConfig::Key LinuxConfig::kConfigKey_OperationalDevicePrivateKey = { kConfigNamespace_WeaveConfig,  "op-device-key"      };
+
+// Prefix used for names of values that contain Weave group encryption keys.
+const char LinuxConfig::kGroupKeyNamePrefix[]                              = "gk-";
+
+namespace {
+
+/**
+ * In-memory copy of the values stored in one namespace file.
+ */
+struct ConfigNamespace
+{
+    const char * Name;
+    bool Loaded;
+    std::map<std::string, std::string> Values;
+};
+
+ConfigNamespace sNamespaces[] =
+{
+    { LinuxConfig::kConfigNamespace_WeaveFactory,  false, { } },
+    { LinuxConfig::kConfigNamespace_WeaveConfig,   false, { } },
+    { LinuxConfig::kConfigNamespace_WeaveCounters, false, { } },
+};
+
+pthread_mutex_t sConfigLock = PTHREAD_MUTEX_INITIALIZER;
+std::string sConfigDir = WEAVE_DEVICE_CONFIG_LINUX_CONFIG_DIR;
+
+std::string GetNamespacePath(const ConfigNamespace & ns)
+{
+    return sConfigDir + "/" + ns.Name + ".conf";
+}
+
+int HexDigitValue(char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+WEAVE_ERROR LoadNamespace(ConfigNamespace & ns)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    std::string path = GetNamespacePath(ns);
+    FILE * file = NULL;
+    char * line = NULL;
+    size_t lineSize = 0;
+    ssize_t lineLen;
+
+    ns.Values.clear();
+
+    file = fopen(path.c_str(), "r");
+    if (file == NULL)
+    {
+        // A missing file is an empty namespace.
+        VerifyOrExit(errno == ENOENT, err = System::MapErrorPOSIX(errno));
+        ExitNow();
+    }
+
+    while ((lineLen = getline(&line, &lineSize, file)) >= 0)
+    {
+        const char * sep = static_cast<const char *>(memchr(line, '=', lineLen));
+        std::string value;
+
+        while (lineLen > 0 && (line[lineLen - 1] == '\n' || line[lineLen - 1] == '\r'))
+        {
+            lineLen--;
+        }
+
+        // Skip lines that aren't of the form <name>=<hex value>.
+        if (sep == NULL || sep == line || ((line + lineLen) - (sep + 1)) % 2 != 0)
+        {
+            continue;
+        }
+
+        for (const char * p = sep + 1; p < line + lineLen; p += 2)
+        {
+            int hi = HexDigitValue(p[0]);
+            int lo = HexDigitValue(p[1]);
+            if (hi < 0 || lo < 0)
+            {
+                break;
+            }
+            value.push_back(static_cast<char>((hi << 4) | lo));
+        }
+
+        ns.Values[std::string(line, sep - line)] = value;
+    }
+
+exit:
+    if (file != NULL)
+    {
+        fclose(file);
+    }
+    free(line);
+    if (err == WEAVE_NO_ERROR)
+    {
+        ns.Loaded = true;
+    }
+    else
+    {
+        WeaveLogError(DeviceLayer, "Failed to load config file %s: %s", path.c_str(), ErrorStr(err));
+    }
+    return err;
+}
+
+WEAVE_ERROR StoreNamespace(ConfigNamespace & ns)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    std::string path = GetNamespacePath(ns);
+    std::string tmpPath = path + ".tmp";
+    FILE * file;
+
+    file = fopen(tmpPath.c_str(), "w");
+    VerifyOrExit(file != NULL, err = System::MapErrorPOSIX(errno));
+
+    for (std::map<std::string, std::string>::const_iterator it = ns.Values.begin(); it != ns.Values.end(); ++it)
+    {
+        fprintf(file, "%s=", it->first.c_str());
+        for (size_t i = 0; i < it->second.size(); i++)
+        {
+            fprintf(file, "%02X", static_cast<uint8_t>(it->second[i]));
+        }
+        fputc('\n', file);
+    }
+
+    // Make sure the new contents are on disk before they replace the old file.
+    if (fflush(file) != 0 || fsync(fileno(file)) != 0)
+    {
+        err = System::MapErrorPOSIX(errno);
+    }
+    fclose(file);
+    SuccessOrExit(err);
+
+    VerifyOrExit(rename(tmpPath.c_str(), path.c_str()) == 0, err = System::MapErrorPOSIX(errno));
+
+exit:
+    if (err != WEAVE_NO_ERROR)
+    {
+        WeaveLogError(DeviceLayer, "Failed to store config file %s: %s", path.c_str(), ErrorStr(err));
+        unlink(tmpPath.c_str());
+
+        // Discard the unsaved changes; the namespace is reloaded from the file when next accessed.
+        ns.Loaded = false;
+        ns.Values.clear();
+    }
+    return err;
+}
+
+WEAVE_ERROR GetNamespace(const char * name, ConfigNamespace *& ns)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    ns = NULL;
+
+    for (size_t i = 0; i < sizeof(sNamespaces) / sizeof(sNamespaces[0]); i++)
+    {
+        if (strcmp(sNamespaces[i].Name, name) == 0)
+        {
+            ns = &sNamespaces[i];
+            break;
+        }
+    }
+    VerifyOrExit(ns != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    if (!ns->Loaded)
+    {
+        err = LoadNamespace(*ns);
+        SuccessOrExit(err);
+    }
+
+exit:
+    return err;
+}
+
+} // unnamed namespace
+
+void LinuxConfig::SetConfigDir(const char * dir)
+{
+    pthread_mutex_lock(&sConfigLock);
+
+    sConfigDir = dir;
+
+    // Reload every namespace from the new location when next accessed.
+    for (size_t i = 0; i < sizeof(sNamespaces) / sizeof(sNamespaces[0]); i++)
+    {
+        sNamespaces[i].Loaded = false;
+        sNamespaces[i].Values.clear();
+    }
+
+    pthread_mutex_unlock(&sConfigLock);
+}
+
+WEAVE_ERROR LinuxConfig::Init(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    pthread_mutex_lock(&sConfigLock);
+
+    // Create the configuration directory if it doesn't already exist.
+    if (mkdir(sConfigDir.c_str(), 0700) != 0 && errno != EEXIST)
+    {
+        err = System::MapErrorPOSIX(errno);
+        WeaveLogError(DeviceLayer, "Failed to create config directory %s: %s", sConfigDir.c_str(), ErrorStr(err));
+    }
+
+    pthread_mutex_unlock(&sConfigLock);
+
+    return err;
+}
+
+WEAVE_ERROR LinuxConfig::ReadConfigValue(Key key, bool & val)
+{
+    WEAVE_ERROR err;
+    uint32_t intVal;
+
+    err = ReadConfigValue(key, intVal);
+    SuccessOrExit(err);
+
+    val = (intVal != 0);
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR LinuxConfig::ReadConfigValue(Key key, uint32_t & val)
+{
+    WEAVE_ERROR err;
+    uint8_t storedVal[sizeof(uint32_t)];
+    size_t storedValLen;
+
+    err = ReadValue(key, storedVal, sizeof(storedVal), storedValLen);
+    if (err == WEAVE_ERROR_BUFFER_TOO_SMALL)
+    {
+        err = WEAVE_ERROR_INVALID_ARGUMENT;
+    }
+    SuccessOrExit(err);
+
+    VerifyOrExit(storedValLen == sizeof(storedVal), err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    val = Encoding::LittleEndian::Get32(storedVal);
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR LinuxConfig::ReadConfigValue(Key key, uint64_t & val)
+{
+    WEAVE_ERROR err;
+    uint8_t storedVal[sizeof(uint64_t)];
+    size_t storedValLen;
+
+    err = ReadValue(key, storedVal, sizeof(storedVal), storedValLen);
+    if (err == WEAVE_ERROR_BUFFER_TOO_SMALL)
+    {
+        err = WEAVE_ERROR_INVALID_ARGUMENT;
+    }
+    SuccessOrExit(err);
+
+    VerifyOrExit(storedValLen == sizeof(storedVal), err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    val = Encoding::LittleEndian::Get64(storedVal);
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR LinuxConfig::ReadConfigValueStr(Key key, char * buf, size_t bufSize, size_t & outLen)
+{
+    WEAVE_ERROR err;
+
+    // NOTE: the caller is allowed to pass NULL for buf to query the length of the stored
+    // value.
+
+    err = ReadValue(key, NULL, 0, outLen);
+    SuccessOrExit(err);
+
+    if (buf != NULL)
+    {
+        VerifyOrExit(bufSize > outLen, err = WEAVE_ERROR_BUFFER_TOO_SMALL);
+
+        err = ReadValue(key, (uint8_t *)buf, bufSize, outLen);
+        SuccessOrExit(err);
+
+        buf[outLen] = 0;
+    }
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR LinuxConfig::ReadConfigValueBin(Key key, uint8_t * buf, size_t bufSize, size_t & outLen)
+{
+    // NOTE: the caller is allowed to pass NULL for buf to query the length of the stored
+    // value.
+    return ReadValue(key, buf, bufSize, outLen);
+}
+
+WEAVE_ERROR LinuxConfig::WriteConfigValue(Key key, bool val)
+{
+    WEAVE_ERROR err;
+
+    err = WriteConfigValue(key, (uint32_t)((val) ? 1 : 0));
+    SuccessOrExit(err);
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR LinuxConfig::WriteConfigValue(Key key, uint32_t val)
+{
+    WEAVE_ERROR err;
+    uint8_t storedVal[sizeof(uint32_t)];
+
+    Encoding::LittleEndian::Put32(storedVal, val);
+
+    err = WriteValue(key, storedVal, sizeof(storedVal));
+    SuccessOrExit(err);
+
+    WeaveLogProgress(DeviceLayer, "Config set: %s/%s = %" PRIu32 " (0x%" PRIX32 ")", key.Namespace, key.Name, val, val);
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR LinuxConfig::WriteConfigValue(Key key, uint64_t val)
+{
+    WEAVE_ERROR err;
+    uint8_t storedVal[sizeof(uint64_t)];
+
+    Encoding::LittleEndian::Put64(storedVal, val);
+
+    err = WriteValue(key, storedVal, sizeof(storedVal));
+    SuccessOrExit(err);
+
+    WeaveLogProgress(DeviceLayer, "Config set: %s/%s = %" PRIu64 " (0x%" PRIX64 ")", key.Namespace, key.Name, val, val);
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR LinuxConfig::WriteConfigValueStr(Key key, const char * str)
+{
+    return WriteConfigValueStr(key, str, (str != NULL) ? strlen(str) : 0);
+}
+
+WEAVE_ERROR LinuxConfig::WriteConfigValueStr(Key key, const char * str, size_t strLen)
+{
+    WEAVE_ERROR err;
+
+    if (str != NULL)
+    {
+        err = WriteValue(key, (const uint8_t *)str, strLen);
+        SuccessOrExit(err);
+
+        WeaveLogProgress(DeviceLayer, "Config set: %s/%s = \"%.*s\"", key.Namespace, key.Name, (int)strLen, str);
+    }
+
+    else
+    {
+        err = ClearConfigValue(key);
+        SuccessOrExit(err);
+    }
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR LinuxConfig::WriteConfigValueBin(Key key, const uint8_t * data, size_t dataLen)
+{
+    WEAVE_ERROR err;
+
+    if (data != NULL)
+    {
+        err = WriteValue(key, data, dataLen);
+        SuccessOrExit(err);
+
+        WeaveLogProgress(DeviceLayer, "Config set: %s/%s = (blob length %u)", key.Namespace, key.Name, (unsigned)dataLen);
+    }
+
+    else
+    {
+        err = ClearConfigValue(key);
+        SuccessOrExit(err);
+    }
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR LinuxConfig::ClearConfigValue(Key key)
+{
+    WEAVE_ERROR err;
+    ConfigNamespace * ns;
+
+    pthread_mutex_lock(&sConfigLock);
+
+    err = GetNamespace(key.Namespace, ns);
+    SuccessOrExit(err);
+
+    if (ns->Values.erase(key.Name) != 0)
+    {
+        err = StoreNamespace(*ns);
+        SuccessOrExit(err);
+
+        WeaveLogProgress(DeviceLayer, "Config delete: %s/%s", key.Namespace, key.Name);
+    }
+
+exit:
+    pthread_mutex_unlock(&sConfigLock);
+    return err;
+}
+
+bool LinuxConfig::ConfigValueExists(Key key)
+{
+    size_t valueLen;
+    return ReadValue(key, NULL, 0, valueLen) == WEAVE_NO_ERROR;
+}
+
+WEAVE_ERROR LinuxConfig::FactoryResetConfig(void)
+{
+    WEAVE_ERROR err;
+    ConfigNamespace * ns;
+
+    pthread_mutex_lock(&sConfigLock);
+
+    // Erase all values in the weave-config namespace.  Factory values and persisted
+    // counters are retained.
+    err = GetNamespace(kConfigNamespace_WeaveConfig, ns);
+    SuccessOrExit(err);
+
+    ns->Values.clear();
+
+    err = StoreNamespace(*ns);
+    SuccessOrExit(err);
+
+exit:
+    pthread_mutex_unlock(&sConfigLock);
+    return err;
+}
+
+WEAVE_ERROR LinuxConfig::ReadValue(Key key, uint8_t * buf, size_t bufSize, size_t & outLen)
+{
+    WEAVE_ERROR err;
+    ConfigNamespace * ns;
+    std::map<std::string, std::string>::const_iterator it;
+
+    pthread_mutex_lock(&sConfigLock);
+
+    err = GetNamespace(key.Namespace, ns);
+    SuccessOrExit(err);
+
+    it = ns->Values.find(key.Name);
+    VerifyOrExit(it != ns->Values.end(), err = WEAVE_DEVICE_ERROR_CONFIG_NOT_FOUND);
+
+    outLen = it->second.size();
+
+    if (buf != NULL)
+    {
+        VerifyOrExit(bufSize >= outLen, err = WEAVE_ERROR_BUFFER_TOO_SMALL);
+
+        memcpy(buf, it->second.data(), outLen);
+    }
+
+exit:
+    pthread_mutex_unlock(&sConfigLock);
+    return err;
+}
+
+WEAVE_ERROR LinuxConfig::WriteValue(Key key, const uint8_t * data, size_t dataLen)
+{
+    WEAVE_ERROR err;
+    ConfigNamespace * ns;
+    std::map<std::string, std::string>::iterator it;
+
+    VerifyOrExit(strlen(key.Name) <= kMaxConfigKeyNameLength, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    pthread_mutex_lock(&sConfigLock);
+
+    err = GetNamespace(key.Namespace, ns);
+    if (err == WEAVE_NO_ERROR)
+    {
+        it = ns->Values.find(key.Name);
+
+        // Don't rewrite the file if the value hasn't changed.
+        if (it == ns->Values.end() || it->second.size() != dataLen || memcmp(it->second.data(), data, dataLen) != 0)
+        {
+            ns->Values[key.Name].assign((const char *)data, dataLen);
+            err = StoreNamespace(*ns);
+        }
+    }
+
+    pthread_mutex_unlock(&sConfigLock);
+
+exit:
+    return err;
+}
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace Weave
+} // namespace nl
@@ -25,6 +25,8 @@
 #include <Weave/DeviceLayer/internal/WeaveDeviceLayerInternal.h>
 #include <Weave/DeviceLayer/PlatformManager.h>
 
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP
+
 namespace nl {
 namespace Weave {
 namespace System {
@@ -65,3 +67,5 @@ System::Error DispatchEvent(System::Layer & aLayer, void * aContext, const Weave
 } // namespace System
 } // namespace Weave
 } // namespace nl
+
+#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
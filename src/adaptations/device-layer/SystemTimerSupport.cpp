@@ -25,6 +25,8 @@
 #include <Weave/DeviceLayer/internal/WeaveDeviceLayerInternal.h>
 #include <Weave/DeviceLayer/PlatformManager.h>
 
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP
+
 namespace nl {
 namespace Weave {
 namespace System {
@@ -43,3 +45,5 @@ System::Error StartTimer(System::Layer & aLayer, void * aContext, uint32_t aMill
 } // namespace System
 } // namespace Weave
 } // namespace nl
+
+#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
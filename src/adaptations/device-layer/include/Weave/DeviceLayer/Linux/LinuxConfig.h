@@ -0,0 +1,133 @@
+/*
+ *
+ *    Copyright (c) 2018 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *          Utilities for accessing persisted device configuration on
+ *          Linux platforms.
+ */
+
+#ifndef LINUX_CONFIG_H
+#define LINUX_CONFIG_H
+
+#include <Weave/DeviceLayer/internal/WeaveDeviceLayerInternal.h>
+
+#include <string.h>
+
+namespace nl {
+namespace Weave {
+namespace DeviceLayer {
+namespace Internal {
+
+/**
+ * Provides functions and definitions for accessing persisted device configuration
+ * on Linux platforms.
+ *
+ * Configuration values are kept in one file per namespace, within the directory given by
+ * WEAVE_DEVICE_CONFIG_LINUX_CONFIG_DIR (or SetConfigDir()).  Each file holds one value per
+ * line, in the form `<name>=<hex-encoded value>`.  The contents of a namespace are cached
+ * in memory when first accessed, and each change rewrites the namespace's file and
+ * atomically replaces the previous one.
+ *
+ * NOTE: This class is designed to be mixed-in to the concrete subclass of the
+ * GenericConfigurationManagerImpl<> template.  When used this way, the class
+ * naturally provides implementations for the delegated members referenced by
+ * the template class (e.g. the ReadConfigValue() method).
+ */
+class LinuxConfig
+{
+public:
+
+    struct Key;
+
+    // Maximum length of a config value name.
+    static constexpr size_t kMaxConfigKeyNameLength = 31;
+
+    // Namespaces used to store device configuration information.
+    static const char kConfigNamespace_WeaveFactory[];
+    static const char kConfigNamespace_WeaveConfig[];
+    static const char kConfigNamespace_WeaveCounters[];
+
+    // Key definitions for well-known keys.
+    static const Key kConfigKey_SerialNum;
+    static const Key kConfigKey_MfrDeviceId;
+    static const Key kConfigKey_MfrDeviceCert;
+    static const Key kConfigKey_MfrDeviceICACerts;
+    static const Key kConfigKey_MfrDevicePrivateKey;
+    static const Key kConfigKey_ProductRevision;
+    static const Key kConfigKey_ManufacturingDate;
+    static const Key kConfigKey_PairingCode;
+    static const Key kConfigKey_FabricId;
+    static const Key kConfigKey_ServiceConfig;
+    static const Key kConfigKey_PairedAccountId;
+    static const Key kConfigKey_ServiceId;
+    static const Key kConfigKey_FabricSecret;
+    static const Key kConfigKey_GroupKeyIndex;
+    static const Key kConfigKey_LastUsedEpochKeyId;
+    static const Key kConfigKey_FailSafeArmed;
+    static const Key kConfigKey_OperationalDeviceId;
+    static const Key kConfigKey_OperationalDeviceCert;
+    static const Key kConfigKey_OperationalDeviceICACerts;
+    static const Key kConfigKey_OperationalDevicePrivateKey;
+
+    static const char kGroupKeyNamePrefix[];
+
+    static WEAVE_ERROR Init(void);
+    static void SetConfigDir(const char * dir);
+
+    // Configuration methods used by the GenericConfigurationManagerImpl<> template.
+    static WEAVE_ERROR ReadConfigValue(Key key, bool & val);
+    static WEAVE_ERROR ReadConfigValue(Key key, uint32_t & val);
+    static WEAVE_ERROR ReadConfigValue(Key key, uint64_t & val);
+    static WEAVE_ERROR ReadConfigValueStr(Key key, char * buf, size_t bufSize, size_t & outLen);
+    static WEAVE_ERROR ReadConfigValueBin(Key key, uint8_t * buf, size_t bufSize, size_t & outLen);
+    static WEAVE_ERROR WriteConfigValue(Key key, bool val);
+    static WEAVE_ERROR WriteConfigValue(Key key, uint32_t val);
+    static WEAVE_ERROR WriteConfigValue(Key key, uint64_t val);
+    static WEAVE_ERROR WriteConfigValueStr(Key key, const char * str);
+    static WEAVE_ERROR WriteConfigValueStr(Key key, const char * str, size_t strLen);
+    static WEAVE_ERROR WriteConfigValueBin(Key key, const uint8_t * data, size_t dataLen);
+    static WEAVE_ERROR ClearConfigValue(Key key);
+    static bool ConfigValueExists(Key key);
+    static WEAVE_ERROR FactoryResetConfig(void);
+
+private:
+
+    static WEAVE_ERROR ReadValue(Key key, uint8_t * buf, size_t bufSize, size_t & outLen);
+    static WEAVE_ERROR WriteValue(Key key, const uint8_t * data, size_t dataLen);
+};
+
+struct LinuxConfig::Key
+{
+    const char * Namespace;
+    const char * Name;
+
+    bool operator ==(const Key & other) const;
+};
+
+inline bool LinuxConfig::Key::operator==(const Key & other) const
+{
+    return strcmp(Namespace, other.Namespace) == 0 && strcmp(Name, other.Name) == 0;
+}
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace Weave
+} // namespace nl
+
+#endif // LINUX_CONFIG_H
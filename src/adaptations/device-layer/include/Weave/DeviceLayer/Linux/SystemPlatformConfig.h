@@ -0,0 +1,43 @@
+/*
+ *
+ *    Copyright (c) 2018 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *          Platform-specific configuration overrides for the OpenWeave System
+ *          Layer on Linux platforms.
+ *
+ */
+
+#ifndef SYSTEM_PLATFORM_CONFIG_H
+#define SYSTEM_PLATFORM_CONFIG_H
+
+#include <stdint.h>
+
+// ==================== Platform Adaptations ====================
+
+#define WEAVE_SYSTEM_CONFIG_POSIX_LOCKING 1
+#define WEAVE_SYSTEM_CONFIG_FREERTOS_LOCKING 0
+#define WEAVE_SYSTEM_CONFIG_NO_LOCKING 0
+
+// ========== Platform-specific Configuration Overrides =========
+
+#ifndef WEAVE_SYSTEM_CONFIG_NUM_TIMERS
+#define WEAVE_SYSTEM_CONFIG_NUM_TIMERS 32
+#endif // WEAVE_SYSTEM_CONFIG_NUM_TIMERS
+
+#endif // SYSTEM_PLATFORM_CONFIG_H
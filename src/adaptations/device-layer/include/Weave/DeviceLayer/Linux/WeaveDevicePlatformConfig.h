@@ -0,0 +1,69 @@
+/*
+ *
+ *    Copyright (c) 2018 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *          Platform-specific configuration overrides for the Weave Device Layer
+ *          on Linux platforms.
+ */
+
+
+#ifndef WEAVE_DEVICE_PLATFORM_CONFIG_H
+#define WEAVE_DEVICE_PLATFORM_CONFIG_H
+
+// ==================== Platform Adaptations ====================
+
+#define WEAVE_DEVICE_CONFIG_ENABLE_WIFI_STATION 0
+#define WEAVE_DEVICE_CONFIG_ENABLE_WIFI_AP 0
+
+#define WEAVE_DEVICE_CONFIG_ENABLE_THREAD 0
+
+#define WEAVE_DEVICE_CONFIG_ENABLE_WOBLE 0
+
+#define WEAVE_DEVICE_CONFIG_ENABLE_WEAVE_TIME_SERVICE_TIME_SYNC 0
+#define WEAVE_DEVICE_CONFIG_ENABLE_SERVICE_DIRECTORY_TIME_SYNC 0
+
+// ========== Platform-specific Configuration =========
+
+// These are configuration options that are unique to Linux platforms.
+// These can be overridden by the application as needed.
+
+/**
+ * @def WEAVE_DEVICE_CONFIG_LINUX_CONFIG_DIR
+ *
+ * The directory in which the Linux platform keeps its persisted device
+ * configuration files.  The directory is created on startup if it does not
+ * exist.  Applications can select another directory at runtime by calling
+ * LinuxConfig::SetConfigDir() before the Weave stack is initialized.
+ */
+#ifndef WEAVE_DEVICE_CONFIG_LINUX_CONFIG_DIR
+#define WEAVE_DEVICE_CONFIG_LINUX_CONFIG_DIR "/tmp/weave"
+#endif // WEAVE_DEVICE_CONFIG_LINUX_CONFIG_DIR
+
+// ========== Platform-specific Configuration Overrides =========
+
+#ifndef WEAVE_DEVICE_CONFIG_ENABLE_TRAIT_MANAGER
+#define WEAVE_DEVICE_CONFIG_ENABLE_TRAIT_MANAGER 1
+#endif // WEAVE_DEVICE_CONFIG_ENABLE_TRAIT_MANAGER
+
+#define WEAVE_DEVICE_CONFIG_ENABLE_WIFI_TELEMETRY 0
+#define WEAVE_DEVICE_CONFIG_ENABLE_THREAD_TELEMETRY 0
+#define WEAVE_DEVICE_CONFIG_ENABLE_THREAD_TELEMETRY_FULL 0
+#define WEAVE_DEVICE_CONFIG_ENABLE_TUNNEL_TELEMETRY 0
+
+#endif // WEAVE_DEVICE_PLATFORM_CONFIG_H
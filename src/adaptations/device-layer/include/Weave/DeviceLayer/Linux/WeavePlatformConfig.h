@@ -0,0 +1,88 @@
+/*
+ *
+ *    Copyright (c) 2018 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *          Platform-specific configuration overrides for OpenWeave on
+ *          Linux platforms.
+ */
+
+#ifndef WEAVE_PLATFORM_CONFIG_H
+#define WEAVE_PLATFORM_CONFIG_H
+
+// ==================== General Platform Adaptations ====================
+
+#define WEAVE_CONFIG_ENABLE_TUNNELING 0
+#define WEAVE_CONFIG_MAX_TUNNELS 0
+
+#define WEAVE_CONFIG_PERSISTED_STORAGE_KEY_TYPE const char *
+#define WEAVE_CONFIG_PERSISTED_STORAGE_ENC_MSG_CNTR_ID "enc-msg-counter"
+#define WEAVE_CONFIG_PERSISTED_STORAGE_MAX_KEY_LENGTH 31
+
+#define WEAVE_CONFIG_TIME_ENABLE_CLIENT 1
+#define WEAVE_CONFIG_TIME_ENABLE_SERVER 0
+
+// ==================== Security Adaptations ====================
+
+#define WEAVE_CONFIG_ENABLE_PASE_INITIATOR 0
+#define WEAVE_CONFIG_ENABLE_PASE_RESPONDER 1
+#define WEAVE_CONFIG_ENABLE_CASE_INITIATOR 1
+
+#define WEAVE_CONFIG_SUPPORT_PASE_CONFIG0 0
+#define WEAVE_CONFIG_SUPPORT_PASE_CONFIG1 0
+#define WEAVE_CONFIG_SUPPORT_PASE_CONFIG2 0
+#define WEAVE_CONFIG_SUPPORT_PASE_CONFIG3 0
+#define WEAVE_CONFIG_SUPPORT_PASE_CONFIG4 1
+
+#define WEAVE_CONFIG_ENABLE_KEY_EXPORT_INITIATOR 0
+
+#define WEAVE_CONFIG_ENABLE_PROVISIONING_BUNDLE_SUPPORT 0
+
+// ==================== General Configuration Overrides ====================
+
+#ifndef WEAVE_CONFIG_MAX_PEER_NODES
+#define WEAVE_CONFIG_MAX_PEER_NODES 16
+#endif // WEAVE_CONFIG_MAX_PEER_NODES
+
+#ifndef WEAVE_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS
+#define WEAVE_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS 16
+#endif // WEAVE_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS
+
+#ifndef WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS
+#define WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS 16
+#endif // WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS
+
+#ifndef WEAVE_LOG_FILTERING
+#define WEAVE_LOG_FILTERING 0
+#endif // WEAVE_LOG_FILTERING
+
+// ==================== Security Configuration Overrides ====================
+
+#ifndef WEAVE_CONFIG_MAX_APPLICATION_GROUPS
+#define WEAVE_CONFIG_MAX_APPLICATION_GROUPS 4
+#endif // WEAVE_CONFIG_MAX_APPLICATION_GROUPS
+
+#ifndef WEAVE_CONFIG_DEBUG_CERT_VALIDATION
+#define WEAVE_CONFIG_DEBUG_CERT_VALIDATION 0
+#endif // WEAVE_CONFIG_DEBUG_CERT_VALIDATION
+
+#ifndef WEAVE_CONFIG_ENABLE_CASE_RESPONDER
+#define WEAVE_CONFIG_ENABLE_CASE_RESPONDER 1
+#endif // WEAVE_CONFIG_ENABLE_CASE_RESPONDER
+
+#endif /* WEAVE_PLATFORM_CONFIG_H */
@@ -0,0 +1,139 @@
+/*
+ *
+ *    Copyright (c) 2018 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *          Provides an generic implementation of PlatformManager features
+ *          for use on POSIX platforms using the sockets-based System Layer.
+ */
+
+
+#ifndef GENERIC_PLATFORM_MANAGER_IMPL_POSIX_H
+#define GENERIC_PLATFORM_MANAGER_IMPL_POSIX_H
+
+#include <Weave/DeviceLayer/internal/GenericPlatformManagerImpl.h>
+
+#include <atomic>
+#include <pthread.h>
+#include <sys/select.h>
+
+namespace nl {
+namespace Weave {
+namespace DeviceLayer {
+namespace Internal {
+
+/**
+ * Provides a generic implementation of PlatformManager features that works on POSIX platforms.
+ *
+ * This template contains implementations of select features from the PlatformManager abstract
+ * interface that are suitable for use on Linux-based platforms where the Weave System and Inet
+ * Layers use sockets.  It is intended to be inherited (directly or indirectly) by the
+ * PlatformManagerImpl class, which also appears as the template's ImplClass parameter.
+ *
+ * The event loop waits with epoll(7) on the sockets of the System and Inet Layers, and on an
+ * eventfd that is signaled when a device event is posted.  The epoll registrations are refreshed
+ * from the fd sets built by the layers on each pass, and only ready sockets are reported back to
+ * the layers.
+ *
+ * Device events are passed to the event loop through a bounded, lock-free queue, allowing any
+ * thread to post an event without taking the Weave stack lock.
+ */
+template<class ImplClass>
+class GenericPlatformManagerImpl_POSIX
+    : public GenericPlatformManagerImpl<ImplClass>
+{
+protected:
+
+    // Capacity of the device event queue; rounded up to a power of two so that queue
+    // positions can be mapped to slots with a mask.
+    static constexpr uint32_t kEventQueueSize = (WEAVE_DEVICE_CONFIG_MAX_EVENT_QUEUE_SIZE <= 1) ? 1 :
+            (1U << (32 - __builtin_clz((uint32_t)WEAVE_DEVICE_CONFIG_MAX_EVENT_QUEUE_SIZE - 1)));
+
+    // Maximum number of ready file descriptors handled per wait.
+    static constexpr int kMaxReadyEvents = 32;
+
+    // Longest time the event loop sleeps when no Weave timers are active.
+    static constexpr uint32_t kMaxSleepTimeMS = 60000;
+
+    struct EventQueueSlot
+    {
+        std::atomic<uint32_t> Seq;
+        WeaveDeviceEvent Event;
+    };
+
+    EventQueueSlot mEventQueue[kEventQueueSize];
+    std::atomic<uint32_t> mEventQueueHead;
+    uint32_t mEventQueueTail;
+
+    pthread_mutex_t mWeaveStackLock;
+    pthread_t mEventLoopThread;
+    std::atomic<bool> mWakePending;
+#if WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
+    std::atomic<uint64_t> mWakeTime;
+#endif
+    int mEpollFD;
+    int mWakeEventFD;
+    int mNumWatchedFDs;
+    bool mHasEventLoopThread;
+    uint8_t mWatchedEvents[FD_SETSIZE];
+
+    // ===== Methods that implement the PlatformManager abstract interface.
+
+    WEAVE_ERROR _InitWeaveStack();
+    void _LockWeaveStack(void);
+    bool _TryLockWeaveStack(void);
+    void _UnlockWeaveStack(void);
+    void _PostEvent(const WeaveDeviceEvent * event);
+    void _RunEventLoop(void);
+    WEAVE_ERROR _StartEventLoopTask(void);
+    WEAVE_ERROR _StartWeaveTimer(uint32_t durationMS);
+
+private:
+
+    // ===== Private members for use by this class only.
+
+    friend class TestPlatformManager;
+
+    enum
+    {
+        kWatch_Read             = 0x01,
+        kWatch_Write            = 0x02,
+        kWatch_Except           = 0x04,
+    };
+
+    inline ImplClass * Impl() { return static_cast<ImplClass*>(this); }
+
+    WEAVE_ERROR InitEventLoop(void);
+    bool PushEvent(const WeaveDeviceEvent * event);
+    bool PopEvent(WeaveDeviceEvent & event);
+    void WakeEventLoop(void);
+    void UpdateWatchedFDs(int numFDs, fd_set * readFDs, fd_set * writeFDs, fd_set * exceptFDs);
+    void WaitForEvents(void);
+
+    static void * EventLoopTaskMain(void * arg);
+};
+
+// Instruct the compiler to instantiate the template only when explicitly told to do so.
+extern template class GenericPlatformManagerImpl_POSIX<PlatformManagerImpl>;
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace Weave
+} // namespace nl
+
+#endif // GENERIC_PLATFORM_MANAGER_IMPL_POSIX_H
@@ -0,0 +1,505 @@
+/*
+ *
+ *    Copyright (c) 2018 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *          Contains non-inline method definitions for the
+ *          GenericPlatformManagerImpl_POSIX<> template.
+ */
+
+#ifndef GENERIC_PLATFORM_MANAGER_IMPL_POSIX_IPP
+#define GENERIC_PLATFORM_MANAGER_IMPL_POSIX_IPP
+
+#include <Weave/DeviceLayer/internal/WeaveDeviceLayerInternal.h>
+#include <Weave/DeviceLayer/PlatformManager.h>
+#include <Weave/DeviceLayer/POSIX/GenericPlatformManagerImpl_POSIX.h>
+
+// Include the non-inline definitions for the GenericPlatformManagerImpl<> template,
+// from which the GenericPlatformManagerImpl_POSIX<> template inherits.
+#include <Weave/DeviceLayer/internal/GenericPlatformManagerImpl.ipp>
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+
+namespace nl {
+namespace Weave {
+namespace DeviceLayer {
+namespace Internal {
+
+// Fully instantiate the generic implementation class in whatever compilation unit includes this file.
+template class GenericPlatformManagerImpl_POSIX<PlatformManagerImpl>;
+
+template<class ImplClass>
+WEAVE_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_InitWeaveStack(void)
+{
+    WEAVE_ERROR err;
+
+    // Set up the event queue and the epoll instance used by the event loop.
+    err = InitEventLoop();
+    SuccessOrExit(err);
+
+    // Call up to the base class _InitWeaveStack() to perform the bulk of the initialization.
+    err = GenericPlatformManagerImpl<ImplClass>::_InitWeaveStack();
+    SuccessOrExit(err);
+
+exit:
+    return err;
+}
+
+template<class ImplClass>
+void GenericPlatformManagerImpl_POSIX<ImplClass>::_LockWeaveStack(void)
+{
+    pthread_mutex_lock(&mWeaveStackLock);
+}
+
+template<class ImplClass>
+bool GenericPlatformManagerImpl_POSIX<ImplClass>::_TryLockWeaveStack(void)
+{
+    return pthread_mutex_trylock(&mWeaveStackLock) == 0;
+}
+
+template<class ImplClass>
+void GenericPlatformManagerImpl_POSIX<ImplClass>::_UnlockWeaveStack(void)
+{
+    pthread_mutex_unlock(&mWeaveStackLock);
+}
+
+template<class ImplClass>
+void GenericPlatformManagerImpl_POSIX<ImplClass>::_PostEvent(const WeaveDeviceEvent * event)
+{
+    if (!PushEvent(event))
+    {
+        WeaveLogError(DeviceLayer, "Failed to post event to Weave Platform event queue");
+        return;
+    }
+
+    WakeEventLoop();
+}
+
+template<class ImplClass>
+void GenericPlatformManagerImpl_POSIX<ImplClass>::_RunEventLoop(void)
+{
+    WeaveDeviceEvent event;
+
+    VerifyOrDie(!mHasEventLoopThread);
+
+    // Capture the thread running the event loop.
+    mEventLoopThread = pthread_self();
+    mHasEventLoopThread = true;
+
+    // Lock the Weave stack.
+    Impl()->LockWeaveStack();
+
+    while (true)
+    {
+        // Wait for socket activity, an expired Weave timer or a posted event, and
+        // dispatch any socket I/O and timers.  The Weave stack is unlocked while waiting.
+        WaitForEvents();
+
+        // Dispatch the events in the queue until it is empty.
+        while (PopEvent(event))
+        {
+            Impl()->DispatchEvent(&event);
+        }
+    }
+}
+
+template<class ImplClass>
+WEAVE_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_StartEventLoopTask(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    pthread_t thread;
+    int res;
+
+    res = pthread_create(&thread, NULL, EventLoopTaskMain, this);
+    VerifyOrExit(res == 0, err = System::MapErrorPOSIX(res));
+
+    pthread_detach(thread);
+
+exit:
+    return err;
+}
+
+template<class ImplClass>
+void * GenericPlatformManagerImpl_POSIX<ImplClass>::EventLoopTaskMain(void * arg)
+{
+    WeaveLogDetail(DeviceLayer, "Weave task running");
+    static_cast<GenericPlatformManagerImpl_POSIX<ImplClass>*>(arg)->Impl()->RunEventLoop();
+    return NULL;
+}
+
+template<class ImplClass>
+WEAVE_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_StartWeaveTimer(uint32_t aMilliseconds)
+{
+    // The sockets-based System Layer schedules its timers through PrepareSelect().  If a timer
+    // is started by a thread other than the event loop thread, wake the event loop so that it
+    // recalculates its wait time.
+    if (!mHasEventLoopThread || !pthread_equal(pthread_self(), mEventLoopThread))
+    {
+        WakeEventLoop();
+    }
+
+    return WEAVE_NO_ERROR;
+}
+
+template<class ImplClass>
+WEAVE_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::InitEventLoop(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    struct epoll_event wakeEvent;
+    int res;
+
+    mEpollFD = -1;
+    mWakeEventFD = -1;
+    mNumWatchedFDs = 0;
+    mHasEventLoopThread = false;
+    mWakePending.store(false);
+#if WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
+    mWakeTime.store(0);
+#endif
+    memset(mWatchedEvents, 0, sizeof(mWatchedEvents));
+
+    // Initialize the event queue such that each slot is ready to be claimed by the producer
+    // whose queue position matches the slot's sequence number.
+    for (uint32_t i = 0; i < kEventQueueSize; i++)
+    {
+        mEventQueue[i].Seq.store(i, std::memory_order_relaxed);
+    }
+    mEventQueueHead.store(0, std::memory_order_relaxed);
+    mEventQueueTail = 0;
+
+    res = pthread_mutex_init(&mWeaveStackLock, NULL);
+    if (res != 0)
+    {
+        WeaveLogError(DeviceLayer, "Failed to create Weave stack lock");
+        ExitNow(err = System::MapErrorPOSIX(res));
+    }
+
+    mEpollFD = epoll_create1(EPOLL_CLOEXEC);
+    if (mEpollFD < 0)
+    {
+        WeaveLogError(DeviceLayer, "Failed to create Weave event loop epoll instance");
+        ExitNow(err = System::MapErrorPOSIX(errno));
+    }
+
+    mWakeEventFD = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (mWakeEventFD < 0)
+    {
+        WeaveLogError(DeviceLayer, "Failed to create Weave event loop wake eventfd");
+        ExitNow(err = System::MapErrorPOSIX(errno));
+    }
+
+    memset(&wakeEvent, 0, sizeof(wakeEvent));
+    wakeEvent.events = EPOLLIN;
+    wakeEvent.data.fd = mWakeEventFD;
+    res = epoll_ctl(mEpollFD, EPOLL_CTL_ADD, mWakeEventFD, &wakeEvent);
+    VerifyOrExit(res == 0, err = System::MapErrorPOSIX(errno));
+
+exit:
+    return err;
+}
+
+/**
+ * Add an event to the tail of the event queue.
+ *
+ * May be called concurrently by any number of threads.  Each producer claims a queue position
+ * by advancing the head, copies its event into the slot for that position and then publishes
+ * the slot by advancing its sequence number.
+ *
+ * @return false if the queue is full.
+ */
+template<class ImplClass>
+bool GenericPlatformManagerImpl_POSIX<ImplClass>::PushEvent(const WeaveDeviceEvent * event)
+{
+    EventQueueSlot * slot;
+    uint32_t pos = mEventQueueHead.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+        slot = &mEventQueue[pos & (kEventQueueSize - 1)];
+
+        int32_t diff = static_cast<int32_t>(slot->Seq.load(std::memory_order_acquire) - pos);
+
+        // If the slot is free for this position, try to claim it.
+        if (diff == 0)
+        {
+            if (mEventQueueHead.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+
+        // If the slot still holds the event from the previous lap, the queue is full.
+        else if (diff < 0)
+        {
+            return false;
+        }
+
+        // Otherwise another producer claimed the position first; try again with the current head.
+        else
+        {
+            pos = mEventQueueHead.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->Event = *event;
+    slot->Seq.store(pos + 1, std::memory_order_release);
+
+    return true;
+}
+
+/**
+ * Remove an event from the head of the event queue.
+ *
+ * Must only be called by the event loop thread.
+ *
+ * @return false if the queue is empty, or the event at its head has not yet been published.
+ */
+template<class ImplClass>
+bool GenericPlatformManagerImpl_POSIX<ImplClass>::PopEvent(WeaveDeviceEvent & event)
+{
+    EventQueueSlot * slot = &mEventQueue[mEventQueueTail & (kEventQueueSize - 1)];
+
+    if (static_cast<int32_t>(slot->Seq.load(std::memory_order_acquire) - (mEventQueueTail + 1)) < 0)
+    {
+        return false;
+    }
+
+    event = slot->Event;
+
+    // Release the slot for use by the producer that reaches this position on the next lap.
+    slot->Seq.store(mEventQueueTail + kEventQueueSize, std::memory_order_release);
+    mEventQueueTail++;
+
+    return true;
+}
+
+template<class ImplClass>
+void GenericPlatformManagerImpl_POSIX<ImplClass>::WakeEventLoop(void)
+{
+#if WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
+    // Stamp the first wake up requested since the event loop last handled one.
+    if (mWakeTime.load(std::memory_order_relaxed) == 0)
+    {
+        uint64_t expected = 0;
+        mWakeTime.compare_exchange_strong(expected, System::Stats::GetLatencyTimestamp());
+    }
+#endif
+
+    // Only signal the eventfd if a wake up isn't already pending; the event loop clears the
+    // pending flag before it empties the queue, so no posted event can be missed.
+    if (mWakeEventFD >= 0 && !mWakePending.exchange(true))
+    {
+        uint64_t count = 1;
+        if (write(mWakeEventFD, &count, sizeof(count)) != sizeof(count) && errno != EAGAIN)
+        {
+            WeaveLogError(DeviceLayer, "Failed to wake Weave event loop: %s", strerror(errno));
+        }
+    }
+}
+
+/**
+ * Bring the epoll registrations in line with the fd sets built by the System and Inet Layers.
+ *
+ * Every watched descriptor is added to the epoll set on each pass.  A socket that was closed
+ * is dropped from the epoll set by the kernel, and its descriptor number may have been reused
+ * by a new socket watched for the same events, so the previous mask says nothing about whether
+ * the descriptor is still registered.  An addition that fails because the descriptor is already
+ * registered falls back to a modification when the watched events changed.
+ */
+template<class ImplClass>
+void GenericPlatformManagerImpl_POSIX<ImplClass>::UpdateWatchedFDs(int numFDs, fd_set * readFDs, fd_set * writeFDs, fd_set * exceptFDs)
+{
+    int maxFDs = (numFDs > mNumWatchedFDs) ? numFDs : mNumWatchedFDs;
+    int newNumWatchedFDs = 0;
+
+    for (int fd = 0; fd < maxFDs; fd++)
+    {
+        struct epoll_event epollEvent;
+        uint8_t watch = 0;
+        int res;
+
+        if (fd < numFDs)
+        {
+            if (FD_ISSET(fd, readFDs))
+                watch |= kWatch_Read;
+            if (FD_ISSET(fd, writeFDs))
+                watch |= kWatch_Write;
+            if (FD_ISSET(fd, exceptFDs))
+                watch |= kWatch_Except;
+        }
+
+        if (watch == 0 && mWatchedEvents[fd] == 0)
+        {
+            continue;
+        }
+
+        memset(&epollEvent, 0, sizeof(epollEvent));
+        epollEvent.events = ((watch & kWatch_Read) ? EPOLLIN : 0) |
+                            ((watch & kWatch_Write) ? EPOLLOUT : 0) |
+                            ((watch & kWatch_Except) ? EPOLLPRI : 0);
+        epollEvent.data.fd = fd;
+
+        if (watch == 0)
+        {
+            // The descriptor may already have been closed, in which case the kernel has
+            // dropped it from the epoll set and the removal fails harmlessly.
+            epoll_ctl(mEpollFD, EPOLL_CTL_DEL, fd, &epollEvent);
+        }
+        else
+        {
+            res = epoll_ctl(mEpollFD, EPOLL_CTL_ADD, fd, &epollEvent);
+            if (res != 0 && errno == EEXIST)
+            {
+                res = (watch != mWatchedEvents[fd]) ? epoll_ctl(mEpollFD, EPOLL_CTL_MOD, fd, &epollEvent) : 0;
+            }
+            if (res != 0)
+            {
+                WeaveLogError(DeviceLayer, "Failed to watch fd %d: %s", fd, strerror(errno));
+                watch = 0;
+            }
+        }
+
+        mWatchedEvents[fd] = watch;
+
+        if (watch != 0)
+        {
+            newNumWatchedFDs = fd + 1;
+        }
+    }
+
+    mNumWatchedFDs = newNumWatchedFDs;
+}
+
+template<class ImplClass>
+void GenericPlatformManagerImpl_POSIX<ImplClass>::WaitForEvents(void)
+{
+    struct epoll_event readyEvents[kMaxReadyEvents];
+    struct timeval sleepTime;
+    fd_set readFDs, writeFDs, exceptFDs;
+    int numFDs = 0;
+    int numReady;
+    int timeoutMS;
+    int selectRes = 0;
+
+    FD_ZERO(&readFDs);
+    FD_ZERO(&writeFDs);
+    FD_ZERO(&exceptFDs);
+
+    sleepTime.tv_sec = kMaxSleepTimeMS / 1000;
+    sleepTime.tv_usec = (kMaxSleepTimeMS % 1000) * 1000;
+
+    // Collect the sockets the System and Inet Layers are waiting on, and the time until the
+    // next Weave timer expires.
+    if (SystemLayer.State() == System::kLayerState_Initialized)
+        SystemLayer.PrepareSelect(numFDs, &readFDs, &writeFDs, &exceptFDs, sleepTime);
+    if (InetLayer.State == Inet::InetLayer::kState_Initialized)
+        InetLayer.PrepareSelect(numFDs, &readFDs, &writeFDs, &exceptFDs, sleepTime);
+
+    UpdateWatchedFDs(numFDs, &readFDs, &writeFDs, &exceptFDs);
+
+    // Round the wait time up so that the loop doesn't wake before the next timer is due.
+    timeoutMS = static_cast<int>(sleepTime.tv_sec * 1000 + (sleepTime.tv_usec + 999) / 1000);
+
+    // Don't sleep if events were posted since the queue was last emptied.
+    if (mWakePending.load(std::memory_order_acquire))
+    {
+        timeoutMS = 0;
+    }
+
+    // Unlock the Weave stack, allowing other threads to enter Weave while the event loop thread is sleeping.
+    Impl()->UnlockWeaveStack();
+
+    numReady = epoll_wait(mEpollFD, readyEvents, kMaxReadyEvents, timeoutMS);
+
+    // Lock the Weave stack.
+    Impl()->LockWeaveStack();
+
+    if (numReady < 0)
+    {
+        if (errno != EINTR)
+        {
+            WeaveLogError(DeviceLayer, "epoll_wait() failed: %s", strerror(errno));
+        }
+        numReady = 0;
+    }
+
+    // Translate the ready events back into fd sets for the System and Inet Layers.
+    FD_ZERO(&readFDs);
+    FD_ZERO(&writeFDs);
+    FD_ZERO(&exceptFDs);
+
+    for (int i = 0; i < numReady; i++)
+    {
+        const int fd = readyEvents[i].data.fd;
+        const uint32_t events = readyEvents[i].events;
+
+        if (fd == mWakeEventFD)
+        {
+            uint64_t count;
+            if (read(mWakeEventFD, &count, sizeof(count)) < 0 && errno != EAGAIN)
+            {
+                WeaveLogError(DeviceLayer, "Failed to read Weave event loop eventfd: %s", strerror(errno));
+            }
+            continue;
+        }
+
+        // Report errors and hang-ups as readiness for whichever directions were being watched,
+        // as select() would.
+        if ((events & (EPOLLIN | EPOLLERR | EPOLLHUP)) != 0 && (mWatchedEvents[fd] & kWatch_Read) != 0)
+            FD_SET(fd, &readFDs);
+        if ((events & (EPOLLOUT | EPOLLERR | EPOLLHUP)) != 0 && (mWatchedEvents[fd] & kWatch_Write) != 0)
+            FD_SET(fd, &writeFDs);
+        if ((events & EPOLLPRI) != 0 && (mWatchedEvents[fd] & kWatch_Except) != 0)
+            FD_SET(fd, &exceptFDs);
+
+        selectRes++;
+    }
+
+    // Clear the pending wake up before the caller empties the event queue.  Any event posted
+    // after this point signals the eventfd again.
+    mWakePending.store(false, std::memory_order_seq_cst);
+
+#if WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
+    {
+        const uint64_t wakeTime = mWakeTime.exchange(0);
+        if (wakeTime != 0)
+        {
+            System::Stats::RecordLatency(System::Stats::kLatency_WakeToDispatch,
+                                         System::Stats::GetLatencyTimestamp() - wakeTime);
+        }
+    }
+#endif
+
+    // Dispatch the socket I/O and the callbacks of any expired timers.
+    if (SystemLayer.State() == System::kLayerState_Initialized)
+        SystemLayer.HandleSelectResult(selectRes, &readFDs, &writeFDs, &exceptFDs);
+    if (InetLayer.State == Inet::InetLayer::kState_Initialized)
+        InetLayer.HandleSelectResult(selectRes, &readFDs, &writeFDs, &exceptFDs);
+}
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace Weave
+} // namespace nl
+
+#endif // GENERIC_PLATFORM_MANAGER_IMPL_POSIX_IPP
@@ -28,6 +28,9 @@
 
 namespace nl {
 namespace Weave {
+
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP
+
 namespace System {
 namespace Platform {
 namespace Layer {
@@ -41,6 +44,8 @@ System::Error StartTimer(System::Layer&, void*, uint32_t);
 } // namespace Platform
 } // namespace System
 
+#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
+
 namespace DeviceLayer {
 
 class PlatformManagerImpl;
@@ -55,6 +60,7 @@ class BLEManagerImpl;
 template<class> class GenericConfigurationManagerImpl;
 template<class> class GenericPlatformManagerImpl;
 template<class> class GenericPlatformManagerImpl_FreeRTOS;
+template<class> class GenericPlatformManagerImpl_POSIX;
 template<class> class GenericConnectivityManagerImpl_Thread;
 template<class> class GenericThreadStackManagerImpl_OpenThread;
 template<class> class GenericThreadStackManagerImpl_OpenThread_LwIP;
@@ -99,15 +105,18 @@ private:
     friend class Internal::BLEManagerImpl;
     template<class> friend class Internal::GenericPlatformManagerImpl;
     template<class> friend class Internal::GenericPlatformManagerImpl_FreeRTOS;
+    template<class> friend class Internal::GenericPlatformManagerImpl_POSIX;
     template<class> friend class Internal::GenericConnectivityManagerImpl_Thread;
     template<class> friend class Internal::GenericThreadStackManagerImpl_OpenThread;
     template<class> friend class Internal::GenericThreadStackManagerImpl_OpenThread_LwIP;
     template<class> friend class Internal::GenericConfigurationManagerImpl;
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP
     // Parentheses used to fix clang parsing issue with these declarations
     friend ::nl::Weave::System::Error (::nl::Weave::System::Platform::Layer::PostEvent(::nl::Weave::System::Layer & aLayer, void * aContext, ::nl::Weave::System::Object & aTarget, ::nl::Weave::System::EventType aType, uintptr_t aArgument));
     friend ::nl::Weave::System::Error (::nl::Weave::System::Platform::Layer::DispatchEvents(::nl::Weave::System::Layer & aLayer, void * aContext));
     friend ::nl::Weave::System::Error (::nl::Weave::System::Platform::Layer::DispatchEvent(::nl::Weave::System::Layer & aLayer, void * aContext, ::nl::Weave::System::Event aEvent));
     friend ::nl::Weave::System::Error (::nl::Weave::System::Platform::Layer::StartTimer(::nl::Weave::System::Layer & aLayer, void * aContext, uint32_t aMilliseconds));
+#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
 
     void PostEvent(const WeaveDeviceEvent * event);
     void DispatchEvent(const WeaveDeviceEvent * event);
@@ -123,6 +123,12 @@ public:
          *  of PartialImageLenInBytes to 0 to indicate that no partial image exists or
          *  that the URI of the partial image does not match.
          *
+         *  If the application persisted a download checkpoint for the partial image (see
+         *  the StoreImageCheckpoint event), it may also return it in the Checkpoint and
+         *  CheckpointLen output parameters, in which case PartialImageLen must be the
+         *  offset the checkpoint was stored with.  The checkpoint must remain valid until
+         *  the next StoreImageBlock or Finished event.
+         *
          *  The application may choose to ignore this event by passing it to the default
          *  event handler. If this is done, the system will always download the entirety
          *  of the available firmware image.
@@ -225,6 +231,27 @@ public:
          */
         kEvent_Finished,
 
+        /**
+         *  Store a download checkpoint
+         *
+         *  Generated periodically during an image download, once all image data up to the
+         *  given offset has been delivered in StoreImageBlock events.  The checkpoint is an
+         *  opaque record of the download's progress (the server, the image URI and the
+         *  offset) that lets an interrupted download be resumed from that offset.  It does
+         *  not carry the image hash, so the integrity of a resumed image is always checked
+         *  by reading the stored image back in a ComputeImageIntegrity event.
+         *
+         *  To support resuming an interrupted download, the application should make the
+         *  stored image data durable up to the given offset, persist the checkpoint along
+         *  with the offset, and return both when handling subsequent FetchPartialImageInfo
+         *  events.  The checkpoint should be discarded along with the rest of the partial
+         *  image state when handling the ResetPartialImageInfo event.
+         *
+         *  The application may choose to ignore this event by passing it to the default
+         *  event handler.
+         */
+        kEvent_StoreImageCheckpoint,
+
         /**
          *  Check default event handling behavior.
          *
@@ -421,6 +448,14 @@ union SoftwareUpdateManager::InEventParam
         WEAVE_ERROR Error;
         Profiles::StatusReporting::StatusReport *StatusReport;
     } Finished;
+
+    struct
+    {
+        const char *URI;
+        uint64_t Offset;                // Offset in the image up to which the data is stored.
+        const uint8_t *Checkpoint;
+        uint16_t CheckpointLen;
+    } StoreImageCheckpoint;
 };
 
 union SoftwareUpdateManager::OutEventParam
@@ -448,6 +483,8 @@ union SoftwareUpdateManager::OutEventParam
     struct
     {
         uint64_t PartialImageLen;
+        const uint8_t *Checkpoint;      // Checkpoint stored at PartialImageLen, or NULL if none.
+        uint16_t CheckpointLen;
     } FetchPartialImageInfo;
 
     struct
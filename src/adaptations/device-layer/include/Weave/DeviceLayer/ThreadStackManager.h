@@ -134,6 +134,8 @@ extern ThreadStackManagerImpl & ThreadStackMgrImpl(void);
 } // namespace Weave
 } // namespace nl
 
+#if WEAVE_DEVICE_CONFIG_ENABLE_THREAD
+
 /* Include a header file containing the implementation of the ThreadStackManager
  * object for the selected platform.
  */
@@ -290,4 +292,6 @@ inline WEAVE_ERROR ThreadStackManager::GetPrimary802154MACAddress(uint8_t * buf)
 } // namespace Weave
 } // namespace nl
 
+#endif // WEAVE_DEVICE_CONFIG_ENABLE_THREAD
+
 #endif // THREAD_STACK_MANAGER_H
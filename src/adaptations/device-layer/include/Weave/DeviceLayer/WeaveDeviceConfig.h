@@ -969,4 +969,17 @@
  */
 #define WEAVE_DEVICE_CONFIG_SWU_BDX_BLOCK_SIZE		1024
 
+/**
+ * WEAVE_DEVICE_CONFIG_SWU_BDX_WINDOW_SIZE
+ *
+ * Specifies the number of blocks to keep outstanding during software download over BDX.
+ * Values above 1 are proposed to the BDX server in the metadata of the ReceiveInit message,
+ * and are only used if WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE allows them and the server grants
+ * a window.  A server that doesn't support windowed transfers downloads the image one
+ * block at a time.
+ */
+#ifndef WEAVE_DEVICE_CONFIG_SWU_BDX_WINDOW_SIZE
+#define WEAVE_DEVICE_CONFIG_SWU_BDX_WINDOW_SIZE 1
+#endif
+
 #endif // WEAVE_DEVICE_CONFIG_H
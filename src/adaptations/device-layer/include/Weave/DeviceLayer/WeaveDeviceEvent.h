@@ -287,12 +287,14 @@ struct WeaveDeviceEvent final
     union
     {
         WeaveDevicePlatformEvent Platform;
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP
         struct
         {
             ::nl::Weave::System::EventType Type;
             ::nl::Weave::System::Object * Target;
             uintptr_t Argument;
         } WeaveSystemLayerEvent;
+#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
         struct
         {
             AsyncWorkFunct WorkFunct;
@@ -61,6 +61,7 @@ public:
     WEAVE_ERROR _SetBLEAdvertisingEnabled(bool val);
     bool _IsBLEFastAdvertisingEnabled(void);
     WEAVE_ERROR _SetBLEFastAdvertisingEnabled(bool val);
+    bool _IsBLEAdvertising(void);
     WEAVE_ERROR _GetBLEDeviceName(char * buf, size_t bufSize);
     WEAVE_ERROR _SetBLEDeviceName(const char * deviceName);
     uint16_t _NumBLEConnections(void);
@@ -107,6 +108,12 @@ inline WEAVE_ERROR GenericConnectivityManagerImpl_NoBLE<ImplClass>::_SetBLEFastA
     return WEAVE_ERROR_UNSUPPORTED_WEAVE_FEATURE;
 }
 
+template<class ImplClass>
+inline bool GenericConnectivityManagerImpl_NoBLE<ImplClass>::_IsBLEAdvertising(void)
+{
+    return false;
+}
+
 template<class ImplClass>
 inline WEAVE_ERROR GenericConnectivityManagerImpl_NoBLE<ImplClass>::_GetBLEDeviceName(char * buf, size_t bufSize)
 {
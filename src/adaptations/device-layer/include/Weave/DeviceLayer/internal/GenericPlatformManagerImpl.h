@@ -62,7 +62,9 @@ protected:
 
     // ===== Support methods that can be overridden by the implementation subclass.
 
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP
     void DispatchEventToSystemLayer(const WeaveDeviceEvent * event);
+#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
     void DispatchEventToDeviceLayer(const WeaveDeviceEvent * event);
     void DispatchEventToApplication(const WeaveDeviceEvent * event);
     static void HandleSessionEstablished(WeaveSecurityManager * sm, WeaveConnection * con,
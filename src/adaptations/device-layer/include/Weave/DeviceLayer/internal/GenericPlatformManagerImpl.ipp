@@ -365,10 +365,12 @@ void GenericPlatformManagerImpl<ImplClass>::_DispatchEvent(const WeaveDeviceEven
         // Do nothing for no-op events.
         break;
 
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP
     case DeviceEventType::kWeaveSystemLayerEvent:
         // If the event is a Weave System or Inet Layer event, deliver it to the SystemLayer event handler.
         Impl()->DispatchEventToSystemLayer(event);
         break;
+#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
 
     case DeviceEventType::kCallWorkFunct:
         // If the event is a "call work function" event, call the specified function.
@@ -399,6 +401,8 @@ void GenericPlatformManagerImpl<ImplClass>::_DispatchEvent(const WeaveDeviceEven
 #endif // WEAVE_PROGRESS_LOGGING
 }
 
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP
+
 template<class ImplClass>
 void GenericPlatformManagerImpl<ImplClass>::DispatchEventToSystemLayer(const WeaveDeviceEvent * event)
 {
@@ -415,6 +419,8 @@ void GenericPlatformManagerImpl<ImplClass>::DispatchEventToSystemLayer(const Wea
     }
 }
 
+#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
+
 template<class ImplClass>
 void GenericPlatformManagerImpl<ImplClass>::DispatchEventToDeviceLayer(const WeaveDeviceEvent * event)
 {
@@ -70,11 +70,15 @@ protected:
 
     void DoInit();
     void DownloadComplete(void);
+    void DownloadComplete(const uint8_t * aImageSHA256);
     void SoftwareUpdateFailed(WEAVE_ERROR aError, StatusReport * aStatusReport);
     void SoftwareUpdateFinished(WEAVE_ERROR aError);
 
     WEAVE_ERROR InstallImage(void);
     WEAVE_ERROR StoreImageBlock(uint32_t aLength, uint8_t *aData);
+    void StoreImageCheckpoint(uint64_t aOffset, const uint8_t * aCheckpoint, uint16_t aCheckpointLen);
+    const uint8_t * GetImageCheckpoint(uint16_t & aCheckpointLen);
+    void DiscardPartialImage(void);
     WEAVE_ERROR GetIntegrityTypeList(::nl::Weave::Profiles::SoftwareUpdate::IntegrityTypeList * aIntegrityTypeList);
 
 private:
@@ -82,7 +86,7 @@ private:
 
     void Cleanup(void);
     void CheckImageState(void);
-    void CheckImageIntegrity(void);
+    void CheckImageIntegrity(const uint8_t * aImageSHA256);
     void DriveState(SoftwareUpdateManager::State aNextState);
     void GetEventState(int32_t& aEventState);
     void HandleImageQueryResponse(PacketBuffer * aPayload);
@@ -137,6 +141,9 @@ private:
     uint64_t mNumBytesToDownload;
     uint64_t mStartOffset;
 
+    const uint8_t * mImageCheckpoint;
+    uint16_t mImageCheckpointLen;
+
     uint32_t mMinWaitTimeMs;
     uint32_t mMaxWaitTimeMs;
     uint32_t mEventId;
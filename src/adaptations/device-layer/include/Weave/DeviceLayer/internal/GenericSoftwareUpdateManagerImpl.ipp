@@ -64,6 +64,9 @@ void GenericSoftwareUpdateManagerImpl<ImplClass>::DoInit()
     mScheduledCheckEnabled = false;
     mIgnorePartialImage = false;
 
+    mImageCheckpoint = NULL;
+    mImageCheckpointLen = 0;
+
     mEventHandlerCallback = NULL;
     mRetryPolicyCallback = DefaultRetryPolicyCallback;
 
@@ -644,8 +647,11 @@ void GenericSoftwareUpdateManagerImpl<ImplClass>::HandleImageQueryResponse(Packe
             // If some part of the desired image has already been downloaded...
             if (outParam.FetchPartialImageInfo.PartialImageLen != 0)
             {
-                // Use the length of the partial image as the starting offset for the download.
+                // Use the length of the partial image as the starting offset for the download,
+                // along with the checkpoint the application stored at that offset, if any.
                 mStartOffset = outParam.FetchPartialImageInfo.PartialImageLen;
+                mImageCheckpoint = outParam.FetchPartialImageInfo.Checkpoint;
+                mImageCheckpointLen = (mImageCheckpoint != NULL) ? outParam.FetchPartialImageInfo.CheckpointLen : 0;
 
                 // Resume downloading the image.
                 DriveState(SoftwareUpdateManager::kState_Download);
@@ -656,6 +662,8 @@ void GenericSoftwareUpdateManagerImpl<ImplClass>::HandleImageQueryResponse(Packe
 
         // Start downloading from the image from the beginning.
         mStartOffset = 0;
+        mImageCheckpoint = NULL;
+        mImageCheckpointLen = 0;
 
         // Initiate the process of preparing local storage for new the image.
         DriveState(SoftwareUpdateManager::kState_PrepareImageStorage);
@@ -929,6 +937,68 @@ exit:
     return err;
 }
 
+/**
+ * Called by the download implementation to hand the application a checkpoint of the download.
+ *
+ * @param[in] aOffset           Offset in the image up to which all data has been stored.
+ * @param[in] aCheckpoint       The checkpoint, to be returned in a later FetchPartialImageInfo event.
+ * @param[in] aCheckpointLen    Length of the checkpoint.
+ */
+template<class ImplClass>
+void GenericSoftwareUpdateManagerImpl<ImplClass>::StoreImageCheckpoint(uint64_t aOffset, const uint8_t * aCheckpoint,
+                                                                      uint16_t aCheckpointLen)
+{
+    SoftwareUpdateManager::InEventParam inParam;
+    SoftwareUpdateManager::OutEventParam outParam;
+
+    inParam.Clear();
+    outParam.Clear();
+
+    inParam.StoreImageCheckpoint.URI = mURI;
+    inParam.StoreImageCheckpoint.Offset = aOffset;
+    inParam.StoreImageCheckpoint.Checkpoint = aCheckpoint;
+    inParam.StoreImageCheckpoint.CheckpointLen = aCheckpointLen;
+
+    mEventHandlerCallback(mAppState, SoftwareUpdateManager::kEvent_StoreImageCheckpoint, inParam, outParam);
+}
+
+/**
+ * Returns the checkpoint the application supplied for the partial image being resumed.
+ *
+ * The checkpoint was stored at the start offset of the download.  Returns NULL if the
+ * download starts from the beginning or the application did not supply a checkpoint.
+ */
+template<class ImplClass>
+const uint8_t * GenericSoftwareUpdateManagerImpl<ImplClass>::GetImageCheckpoint(uint16_t & aCheckpointLen)
+{
+    aCheckpointLen = mImageCheckpointLen;
+    return mImageCheckpoint;
+}
+
+/**
+ * Requests the application to forget the partial image, so that the next software update
+ * attempt downloads the image from the beginning.
+ */
+template<class ImplClass>
+void GenericSoftwareUpdateManagerImpl<ImplClass>::DiscardPartialImage(void)
+{
+    SoftwareUpdateManager::InEventParam inParam;
+    SoftwareUpdateManager::OutEventParam outParam;
+
+    inParam.Clear();
+    outParam.Clear();
+    mEventHandlerCallback(mAppState, SoftwareUpdateManager::kEvent_ResetPartialImageInfo, inParam, outParam);
+
+    mImageCheckpoint = NULL;
+    mImageCheckpointLen = 0;
+
+    // Arrange to ignore any partial image on the next software update attempt.
+    // This is a defensive measure against an infinite software update loop in the
+    // case where the application does not properly handle the ResetPartialImageInfo
+    // event.
+    mIgnorePartialImage = true;
+}
+
 template<class ImplClass>
 void GenericSoftwareUpdateManagerImpl<ImplClass>::PrepareImageStorage(void)
 {
@@ -990,6 +1060,21 @@ exit:
 
 template<class ImplClass>
 void GenericSoftwareUpdateManagerImpl<ImplClass>::DownloadComplete()
+{
+    DownloadComplete(NULL);
+}
+
+/**
+ * Called by the download implementation when the whole image has been stored.
+ *
+ * @param[in] aImageSHA256  The SHA-256 hash of the image, computed as it was downloaded,
+ *                          or NULL if it was not (e.g. the download resumed part way
+ *                          through the image).  When given, it is used to check an image
+ *                          with a SHA-256 integrity spec instead of asking the application
+ *                          to read the stored image back.
+ */
+template<class ImplClass>
+void GenericSoftwareUpdateManagerImpl<ImplClass>::DownloadComplete(const uint8_t * aImageSHA256)
 {
     DownloadFinishEvent ev;
     EventOptions evOptions(true);
@@ -998,11 +1083,11 @@ void GenericSoftwareUpdateManagerImpl<ImplClass>::DownloadComplete()
     nl::LogEvent(&ev, evOptions);
 
     // Download is complete. Check Image Integrity.
-    CheckImageIntegrity();
+    CheckImageIntegrity(aImageSHA256);
 }
 
 template<class ImplClass>
-void GenericSoftwareUpdateManagerImpl<ImplClass>::CheckImageIntegrity(void)
+void GenericSoftwareUpdateManagerImpl<ImplClass>::CheckImageIntegrity(const uint8_t * aImageSHA256)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     int result = 0;
@@ -1032,17 +1117,25 @@ void GenericSoftwareUpdateManagerImpl<ImplClass>::CheckImageIntegrity(void)
 
     uint8_t computedIntegrityValue[typeLength];
 
-    inParam.ComputeImageIntegrity.IntegrityType = mIntegritySpec.type;
-    inParam.ComputeImageIntegrity.IntegrityValueBuf = computedIntegrityValue;
-    inParam.ComputeImageIntegrity.IntegrityValueBufLen = typeLength;
-    outParam.ComputeImageIntegrity.Error = WEAVE_NO_ERROR;
-
-    // Request the application to compute an integrity check value for the stored image.
-    // Fail if the application returns an error.
-    mEventHandlerCallback(mAppState, SoftwareUpdateManager::kEvent_ComputeImageIntegrity, inParam, outParam);
-    VerifyOrExit(mState == SoftwareUpdateManager::kState_Download, err = WEAVE_DEVICE_ERROR_SOFTWARE_UPDATE_ABORTED);
-    err = outParam.ComputeImageIntegrity.Error;
-    SuccessOrExit(err);
+    if (mIntegritySpec.type == kIntegrityType_SHA256 && aImageSHA256 != NULL)
+    {
+        // The image was hashed as it was downloaded, so there is no need to read it back.
+        memcpy(computedIntegrityValue, aImageSHA256, typeLength);
+    }
+    else
+    {
+        inParam.ComputeImageIntegrity.IntegrityType = mIntegritySpec.type;
+        inParam.ComputeImageIntegrity.IntegrityValueBuf = computedIntegrityValue;
+        inParam.ComputeImageIntegrity.IntegrityValueBufLen = typeLength;
+        outParam.ComputeImageIntegrity.Error = WEAVE_NO_ERROR;
+
+        // Request the application to compute an integrity check value for the stored image.
+        // Fail if the application returns an error.
+        mEventHandlerCallback(mAppState, SoftwareUpdateManager::kEvent_ComputeImageIntegrity, inParam, outParam);
+        VerifyOrExit(mState == SoftwareUpdateManager::kState_Download, err = WEAVE_DEVICE_ERROR_SOFTWARE_UPDATE_ABORTED);
+        err = outParam.ComputeImageIntegrity.Error;
+        SuccessOrExit(err);
+    }
 
     // Verify the computed integrity value matches the expected value given
     // in the SoftwareUpdate:ImageQueryResponse.
@@ -1070,17 +1163,9 @@ exit:
          * the persisted image state. This will make sure the image is downloaded from
          * scratch on the next attempt.
          */
-        inParam.Clear();
-        outParam.Clear();
-        mEventHandlerCallback(mAppState, SoftwareUpdateManager::kEvent_ResetPartialImageInfo, inParam, outParam);
+        DiscardPartialImage();
         err = (mState == SoftwareUpdateManager::kState_Download) ? WEAVE_DEVICE_ERROR_SOFTWARE_UPDATE_ABORTED : err;
 
-        // Arrange to ignore any partial image on the next software update attempt.
-        // This is a defensive measure against an infinite software update loop in the
-        // case where the application does not properly handle the ResetPartialImageInfo
-        // event.
-        mIgnorePartialImage = true;
-
         Impl()->SoftwareUpdateFailed(err, NULL);
     }
 }
@@ -74,6 +74,9 @@ private:
     static void ReceiveRejectHandler(BDXTransfer * aXfer, nl::Weave::StatusReport * aReport);
     static void XferErrorHandler(BDXTransfer * aXfer, ::nl::Weave::StatusReport * aXferError);
     static void XferDoneHandler(BDXTransfer * aXfer);
+#if WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+    static void CheckpointHandler(BDXTransfer * aXfer, uint64_t aOffset);
+#endif // WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
 
     static void HandleBindingEvent(void * apAppState, ::nl::Weave::Binding::EventType aEvent,
                                    const ::nl::Weave::Binding::InEventParam & aInParam,
@@ -102,6 +102,9 @@ WEAVE_ERROR GenericSoftwareUpdateManagerImpl_BDX<ImplClass>::StartDownload(void)
         XferErrorHandler,
         XferDoneHandler,
         ErrorHandler,
+#if WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+        CheckpointHandler,
+#endif // WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
     };
 
     VerifyOrExit(mBDXTransfer == NULL, err = WEAVE_ERROR_INCORRECT_STATE);
@@ -123,6 +126,47 @@ WEAVE_ERROR GenericSoftwareUpdateManagerImpl_BDX<ImplClass>::StartDownload(void)
     mBDXTransfer->mMaxBlockSize = WEAVE_DEVICE_CONFIG_SWU_BDX_BLOCK_SIZE;
     mBDXTransfer->mStartOffset  = mStartOffset;
     mBDXTransfer->mLength       = 0;
+    mBDXTransfer->mWindowSize   = WEAVE_DEVICE_CONFIG_SWU_BDX_WINDOW_SIZE;
+
+#if WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT
+    // Hash the image as it arrives so its integrity can be checked without reading it
+    // back. This is only possible when the whole image is downloaded in one transfer.
+    if (mStartOffset == 0)
+    {
+        mBDXTransfer->StartBlockHash();
+    }
+#endif // WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT
+
+#if WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+    // When resuming, restore the progress from the checkpoint the application stored with
+    // the partial image.  Without one, or if it doesn't match this download, fall back to
+    // a plain resume from the start offset.
+    if (mStartOffset != 0)
+    {
+        uint16_t checkpointLen;
+        const uint8_t * checkpoint = Impl()->GetImageCheckpoint(checkpointLen);
+
+        if (checkpoint != NULL)
+        {
+            WEAVE_ERROR resumeErr = mBDXTransfer->ResumeFromCheckpoint(checkpoint, checkpointLen, false);
+
+            if (resumeErr != WEAVE_NO_ERROR || mBDXTransfer->mStartOffset != mStartOffset)
+            {
+                WeaveLogProgress(DeviceLayer, "Ignoring software update download checkpoint: %s",
+                        (resumeErr != WEAVE_NO_ERROR) ? nl::ErrorStr(resumeErr) : "offset mismatch");
+                mBDXTransfer->mStartOffset = mStartOffset;
+            }
+        }
+
+#if WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT
+        // Restoring the image hash would require feeding the stored part of the image back
+        // through AddBlockHashData(), which the application has no event for.  Don't hash
+        // the rest of the download; the application checks the whole image once it's done.
+        mBDXTransfer->mHashBlocks = false;
+        mBDXTransfer->mBlockHashPendingLength = 0;
+#endif // WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT
+    }
+#endif // WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
 
     err = mBDXClient.InitBdxReceive(*mBDXTransfer, true, false, false, NULL);
     SuccessOrExit(err);
@@ -161,6 +205,14 @@ void GenericSoftwareUpdateManagerImpl_BDX<ImplClass>::ReceiveRejectHandler(BDXTr
     }
     else
     {
+        // A server that can't resume the download from the requested offset rejects it with
+        // kStatus_StartOffsetNotSupported.  Forget the partial image so the next attempt
+        // downloads the whole image.
+        if (aReport->mProfileId == kWeaveProfile_BDX && aReport->mStatusCode == kStatus_StartOffsetNotSupported)
+        {
+            self->Impl()->DiscardPartialImage();
+        }
+
         self->Impl()->SoftwareUpdateFailed(WEAVE_ERROR_STATUS_REPORT_RECEIVED, aReport);
     }
 }
@@ -197,9 +249,34 @@ void GenericSoftwareUpdateManagerImpl_BDX<ImplClass>::XferDoneHandler(BDXTransfe
 {
     GenericSoftwareUpdateManagerImpl_BDX<ImplClass> * self = &SoftwareUpdateMgrImpl();
 
+#if WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT
+    uint8_t imageHash[::nl::Weave::Platform::Security::SHA256::kHashLength];
+    bool imageHashed = (aXfer->FinishBlockHash(imageHash) == WEAVE_NO_ERROR);
+
+    self->ResetState();
+    self->Impl()->DownloadComplete(imageHashed ? imageHash : NULL);
+#else
     self->ResetState();
     self->Impl()->DownloadComplete();
+#endif // WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT
+}
+
+#if WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+template<class ImplClass>
+void GenericSoftwareUpdateManagerImpl_BDX<ImplClass>::CheckpointHandler(BDXTransfer * aXfer, uint64_t aOffset)
+{
+    GenericSoftwareUpdateManagerImpl_BDX<ImplClass> * self = &SoftwareUpdateMgrImpl();
+    uint8_t checkpoint[BDXTransfer::kMaxCheckpointLength];
+    uint16_t checkpointLen;
+
+    // Every block up to aOffset has been handed to the application in a StoreImageBlock
+    // event, so the application can persist the checkpoint along with the image data.
+    if (aXfer->EncodeCheckpoint(checkpoint, sizeof(checkpoint), checkpointLen) == WEAVE_NO_ERROR)
+    {
+        self->Impl()->StoreImageCheckpoint(aOffset, checkpoint, checkpointLen);
+    }
 }
+#endif // WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
 
 template<class ImplClass>
 void GenericSoftwareUpdateManagerImpl_BDX<ImplClass>::ErrorHandler(BDXTransfer * aXfer, WEAVE_ERROR aErrorCode)
@@ -0,0 +1,342 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This is a unit test suite for the event queue and the epoll-based
+ *      event loop of <tt>GenericPlatformManagerImpl_POSIX</tt>.
+ *
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+
+#include <nlunit-test.h>
+
+#include <Weave/DeviceLayer/internal/WeaveDeviceLayerInternal.h>
+#include <Weave/DeviceLayer/PlatformManager.h>
+
+namespace nl {
+namespace Weave {
+namespace DeviceLayer {
+namespace Internal {
+
+class TestPlatformManager
+{
+public:
+    static int Setup(void * inContext);
+    static void CheckEventQueueOrder(nlTestSuite * inSuite, void * inContext);
+    static void CheckConcurrentProducers(nlTestSuite * inSuite, void * inContext);
+    static void CheckWakeOnPostEvent(nlTestSuite * inSuite, void * inContext);
+    static void CheckReusedFD(nlTestSuite * inSuite, void * inContext);
+
+private:
+    typedef GenericPlatformManagerImpl_POSIX<PlatformManagerImpl> Impl;
+
+    enum
+    {
+        kNumProducers           = 4,
+        kEventsPerProducer      = 10000,
+    };
+
+    static Impl & Mgr(void) { return PlatformMgrImpl(); }
+    static void MakeEvent(WeaveDeviceEvent & event, intptr_t arg);
+    static void * ProducerMain(void * arg);
+    static void * DelayedPostMain(void * arg);
+    static void NoOpWork(intptr_t arg);
+    static uint64_t GetTimeMS(void);
+};
+
+int TestPlatformManager::Setup(void * inContext)
+{
+    return (Mgr().InitEventLoop() == WEAVE_NO_ERROR) ? SUCCESS : FAILURE;
+}
+
+void TestPlatformManager::MakeEvent(WeaveDeviceEvent & event, intptr_t arg)
+{
+    memset(&event, 0, sizeof(event));
+    event.Type = DeviceEventType::kCallWorkFunct;
+    event.CallWorkFunct.WorkFunct = NULL;
+    event.CallWorkFunct.Arg = arg;
+}
+
+uint64_t TestPlatformManager::GetTimeMS(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000 + now.tv_nsec / 1000000;
+}
+
+/**
+ * Fill the queue, check that it refuses further events, and drain it over two laps of the
+ * slot array, checking that events come out in the order they were pushed.
+ */
+void TestPlatformManager::CheckEventQueueOrder(nlTestSuite * inSuite, void * inContext)
+{
+    WeaveDeviceEvent event;
+    intptr_t next = 0;
+    intptr_t expected = 0;
+
+    NL_TEST_ASSERT(inSuite, !Mgr().PopEvent(event));
+
+    for (uint32_t i = 0; i < Impl::kEventQueueSize; i++)
+    {
+        MakeEvent(event, next++);
+        NL_TEST_ASSERT(inSuite, Mgr().PushEvent(&event));
+    }
+
+    MakeEvent(event, next);
+    NL_TEST_ASSERT(inSuite, !Mgr().PushEvent(&event));
+
+    // Free half of the slots and refill them, so that the head wraps around the slot array.
+    for (uint32_t i = 0; i < (Impl::kEventQueueSize + 1) / 2; i++)
+    {
+        NL_TEST_ASSERT(inSuite, Mgr().PopEvent(event));
+        NL_TEST_ASSERT(inSuite, event.CallWorkFunct.Arg == expected++);
+    }
+
+    for (uint32_t i = 0; i < (Impl::kEventQueueSize + 1) / 2; i++)
+    {
+        MakeEvent(event, next++);
+        NL_TEST_ASSERT(inSuite, Mgr().PushEvent(&event));
+    }
+
+    MakeEvent(event, next);
+    NL_TEST_ASSERT(inSuite, !Mgr().PushEvent(&event));
+
+    while (Mgr().PopEvent(event))
+    {
+        NL_TEST_ASSERT(inSuite, event.CallWorkFunct.Arg == expected++);
+    }
+
+    NL_TEST_ASSERT(inSuite, expected == next);
+}
+
+void * TestPlatformManager::ProducerMain(void * arg)
+{
+    const intptr_t producer = reinterpret_cast<intptr_t>(arg);
+    WeaveDeviceEvent event;
+
+    for (intptr_t i = 0; i < kEventsPerProducer; i++)
+    {
+        MakeEvent(event, producer * kEventsPerProducer + i);
+
+        // Back off while the consumer makes room in the queue.
+        while (!Mgr().PushEvent(&event))
+        {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Push events from several threads at once while the test thread consumes them, and check
+ * that each event is received exactly once and in the order its producer pushed it.
+ */
+void TestPlatformManager::CheckConcurrentProducers(nlTestSuite * inSuite, void * inContext)
+{
+    pthread_t producers[kNumProducers];
+    intptr_t nextSeq[kNumProducers];
+    WeaveDeviceEvent event;
+    int received = 0;
+    bool inOrder = true;
+
+    for (intptr_t i = 0; i < kNumProducers; i++)
+    {
+        nextSeq[i] = 0;
+        NL_TEST_ASSERT(inSuite, pthread_create(&producers[i], NULL, ProducerMain, reinterpret_cast<void *>(i)) == 0);
+    }
+
+    while (received < kNumProducers * kEventsPerProducer)
+    {
+        if (!Mgr().PopEvent(event))
+        {
+            sched_yield();
+            continue;
+        }
+
+        const intptr_t producer = event.CallWorkFunct.Arg / kEventsPerProducer;
+        const intptr_t seq = event.CallWorkFunct.Arg % kEventsPerProducer;
+
+        if (producer < 0 || producer >= kNumProducers || seq != nextSeq[producer])
+        {
+            inOrder = false;
+            break;
+        }
+
+        nextSeq[producer]++;
+        received++;
+    }
+
+    NL_TEST_ASSERT(inSuite, inOrder);
+
+    for (int i = 0; i < kNumProducers; i++)
+    {
+        pthread_join(producers[i], NULL);
+    }
+
+    // Drain anything left behind by a failed run, so that later tests start with an empty queue.
+    while (Mgr().PopEvent(event))
+        ;
+}
+
+void TestPlatformManager::NoOpWork(intptr_t arg)
+{
+}
+
+void * TestPlatformManager::DelayedPostMain(void * arg)
+{
+    usleep(50000);
+
+    PlatformMgr().ScheduleWork(NoOpWork, reinterpret_cast<intptr_t>(arg));
+
+    return NULL;
+}
+
+/**
+ * Check that an event posted by another thread wakes an event loop pass that has no timers
+ * to wait for, and that the event is then available to the loop.
+ */
+void TestPlatformManager::CheckWakeOnPostEvent(nlTestSuite * inSuite, void * inContext)
+{
+    const intptr_t kArg = 0x5A5A;
+    WeaveDeviceEvent event;
+    pthread_t poster;
+    uint64_t startTime;
+    bool popped = false;
+
+    PlatformMgr().LockWeaveStack();
+
+    NL_TEST_ASSERT(inSuite, pthread_create(&poster, NULL, DelayedPostMain, reinterpret_cast<void *>(kArg)) == 0);
+
+    // Without the wake up, a pass would sleep for the maximum sleep time.
+    startTime = GetTimeMS();
+    while (!popped && GetTimeMS() - startTime < Impl::kMaxSleepTimeMS / 2)
+    {
+        Mgr().WaitForEvents();
+        popped = Mgr().PopEvent(event);
+    }
+
+    PlatformMgr().UnlockWeaveStack();
+
+    pthread_join(poster, NULL);
+
+    NL_TEST_ASSERT(inSuite, popped);
+    NL_TEST_ASSERT(inSuite, popped && event.Type == DeviceEventType::kCallWorkFunct);
+    NL_TEST_ASSERT(inSuite, popped && event.CallWorkFunct.WorkFunct == NoOpWork && event.CallWorkFunct.Arg == kArg);
+    NL_TEST_ASSERT(inSuite, GetTimeMS() - startTime < 5000);
+    NL_TEST_ASSERT(inSuite, !Mgr().PopEvent(event));
+}
+
+/**
+ * Close a watched socket and reuse its descriptor number for a new one watched for the same
+ * events, and check that the new socket is still reported by the epoll set.
+ */
+void TestPlatformManager::CheckReusedFD(nlTestSuite * inSuite, void * inContext)
+{
+    struct epoll_event readyEvents[4];
+    fd_set readFDs, writeFDs, exceptFDs;
+    int pipeFDs[2];
+    int watchedFD;
+    int numReady;
+    bool ready = false;
+
+    NL_TEST_ASSERT(inSuite, pipe(pipeFDs) == 0);
+    watchedFD = pipeFDs[0];
+
+    FD_ZERO(&readFDs);
+    FD_ZERO(&writeFDs);
+    FD_ZERO(&exceptFDs);
+    FD_SET(watchedFD, &readFDs);
+
+    Mgr().UpdateWatchedFDs(watchedFD + 1, &readFDs, &writeFDs, &exceptFDs);
+
+    // Closing the read end drops it from the epoll set; the next pipe reuses its number.
+    close(pipeFDs[0]);
+    close(pipeFDs[1]);
+
+    NL_TEST_ASSERT(inSuite, pipe(pipeFDs) == 0);
+    NL_TEST_ASSERT(inSuite, pipeFDs[0] == watchedFD);
+
+    Mgr().UpdateWatchedFDs(watchedFD + 1, &readFDs, &writeFDs, &exceptFDs);
+
+    NL_TEST_ASSERT(inSuite, write(pipeFDs[1], "x", 1) == 1);
+
+    numReady = epoll_wait(Mgr().mEpollFD, readyEvents, 4, 0);
+    for (int i = 0; i < numReady; i++)
+    {
+        if (readyEvents[i].data.fd == watchedFD && (readyEvents[i].events & EPOLLIN) != 0)
+        {
+            ready = true;
+        }
+    }
+
+    NL_TEST_ASSERT(inSuite, ready);
+
+    // Stop watching the descriptor before closing it.
+    FD_ZERO(&readFDs);
+    Mgr().UpdateWatchedFDs(0, &readFDs, &writeFDs, &exceptFDs);
+    NL_TEST_ASSERT(inSuite, Mgr().mNumWatchedFDs == 0);
+
+    close(pipeFDs[0]);
+    close(pipeFDs[1]);
+}
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace Weave
+} // namespace nl
+
+using nl::Weave::DeviceLayer::Internal::TestPlatformManager;
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("PlatformManager::TestEventQueueOrder",        TestPlatformManager::CheckEventQueueOrder),
+    NL_TEST_DEF("PlatformManager::TestConcurrentProducers",    TestPlatformManager::CheckConcurrentProducers),
+    NL_TEST_DEF("PlatformManager::TestWakeOnPostEvent",        TestPlatformManager::CheckWakeOnPostEvent),
+    NL_TEST_DEF("PlatformManager::TestReusedFD",               TestPlatformManager::CheckReusedFD),
+    NL_TEST_SENTINEL()
+};
+
+int main(int argc, char *argv[])
+{
+    nlTestSuite theSuite = {
+        "weave-device-platform-manager",
+        &sTests[0],
+        TestPlatformManager::Setup,
+        NULL
+    };
+
+    // Generate machine-readable, comma-separated value (CSV) output.
+    nl_test_set_output_style(OUTPUT_CSV);
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, NULL);
+
+    return nlTestRunnerStats(&theSuite);
+}
@@ -483,6 +483,10 @@ void BLEEndPoint::ReleaseBleConnection()
 
 void BLEEndPoint::Free()
 {
+#if BLE_LAYER_MAX_GATT_SENDS_IN_FLIGHT
+    BleLayer * bleLayer = mBle;
+#endif
+
     // Release BLE connection. Will close connection if AutoClose enabled for this end point. Otherwise, informs
     // application that Weave is done with this BLE connection, and application makes decision about whether to close
     // and clean up or retain connection.
@@ -516,6 +520,11 @@ void BLEEndPoint::Free()
 
     // Release the AddRef() that happened when the end point was allocated.
     Release();
+
+#if BLE_LAYER_MAX_GATT_SENDS_IN_FLIGHT
+    // Any GATT send slot held by this end point is now free for end points waiting their turn.
+    bleLayer->DriveSending();
+#endif
 }
 
 void BLEEndPoint::FreeWoBle()
@@ -1049,6 +1058,18 @@ BLE_ERROR BLEEndPoint::DriveSending()
         ExitNow();
     }
 
+#if BLE_LAYER_MAX_GATT_SENDS_IN_FLIGHT
+    // If we have something to send but the BleLayer's GATT send slots are taken, or other end points are already
+    // waiting for one, wait for BleLayer::DriveSending() to give us our turn.
+    if ((mAckToSend != NULL || mSendQueue != NULL || mWoBle.TxState() == WoBle::kState_InProgress) &&
+        !mBle->AcquireGattSendSlot(this))
+    {
+        WeaveLogDebugBleEndPoint(Ble, "NO SEND: waiting for GATT send slot");
+        SetFlag(mConnStateFlags, kConnState_AwaitingSendSlot, true);
+        ExitNow();
+    }
+#endif
+
     // Otherwise, let's see what we can send.
 
     if (mAckToSend != NULL) // If immediate, stand-alone ack is pending, send it.
@@ -1174,6 +1195,9 @@ BLE_ERROR BLEEndPoint::HandleCapabilitiesRequestReceived(PacketBuffer * data)
     else if ((resp.mSelectedProtocolVersion == kBleTransportProtocolVersion_V1) ||
              (resp.mSelectedProtocolVersion == kBleTransportProtocolVersion_V2))
     {
+        // The central receives at the selected fragment size too, so keep it within what an older central accepts.
+        resp.mFragmentSize = nl::Weave::min(resp.mFragmentSize, WoBle::sMaxSymmetricFragmentSize);
+
         // Set Rx and Tx fragment sizes to the same value
         mWoBle.SetRxFragmentSize(resp.mFragmentSize);
         mWoBle.SetTxFragmentSize(resp.mFragmentSize);
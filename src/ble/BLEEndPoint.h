@@ -115,8 +115,10 @@ private:
         kConnState_CapabilitiesMsgReceived  = 0x04, // Capabilities request or response message received.
         kConnState_DidBeginSubscribe        = 0x08, // GATT subscribe request sent; must unsubscribe on close.
         kConnState_StandAloneAckInFlight    = 0x10, // Stand-alone ack in flight, awaiting GATT confirmation.
-        kConnState_GattOperationInFlight    = 0x20  // GATT write, indication, subscribe, or unsubscribe in flight,
+        kConnState_GattOperationInFlight    = 0x20, // GATT write, indication, subscribe, or unsubscribe in flight,
                                                     // awaiting GATT confirmation.
+        kConnState_AwaitingSendSlot         = 0x40  // Data or ack to send, waiting for BleLayer to grant a free
+                                                    // GATT send slot.
     };
 
     enum TimerStateFlags
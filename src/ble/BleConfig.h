@@ -101,6 +101,20 @@
 #error "BLE_LAYER_NUM_BLE_ENDPOINTS must be greater than 0. configure options may be used to disable Weave over BLE."
 #endif
 
+/**
+ *  @def BLE_LAYER_MAX_GATT_SENDS_IN_FLIGHT
+ *
+ *  @brief
+ *    The maximum number of GATT writes and indications a BleLayer keeps in flight across all of its end points, or
+ *    0 for no limit. Platforms whose BLE stack shares a small transmit queue between connections should set this, so
+ *    that end points with data to send take turns at each free slot instead of the busiest connection starving the
+ *    others.
+ *
+ */
+#ifndef BLE_LAYER_MAX_GATT_SENDS_IN_FLIGHT
+#define BLE_LAYER_MAX_GATT_SENDS_IN_FLIGHT 0
+#endif // BLE_LAYER_MAX_GATT_SENDS_IN_FLIGHT
+
 /**
  *  @def BLE_CONNECTION_OBJECT
  *
@@ -189,6 +203,28 @@
 #error "BLE_MAX_RECEIVE_WINDOW_SIZE must be greater than 2 for BLE transport protocol stability."
 #endif
 
+/**
+ *  @def BLE_CONFIG_MAX_FRAGMENT_SIZE
+ *
+ *  @brief
+ *    This is the largest BTP fragment, in bytes, that a BLE end point will negotiate. The fragment size selected for a
+ *    connection is the smaller of this value and the connection's ATT MTU less the 3-byte ATT operation header.
+ *
+ *    This value must not exceed the size of the platform's WoBLE write and indication characteristic values.
+ *
+ *    Fragments larger than 128 bytes are only negotiated under BTP v3 and later, where each direction has its own
+ *    fragment size. Under BTP v1 and v2 both peers use the fragment size selected by the peripheral, and older
+ *    peers can't receive fragments larger than 128 bytes.
+ *
+ */
+#ifndef BLE_CONFIG_MAX_FRAGMENT_SIZE
+#define BLE_CONFIG_MAX_FRAGMENT_SIZE                           128
+#endif
+
+#if (BLE_CONFIG_MAX_FRAGMENT_SIZE < 20) || (BLE_CONFIG_MAX_FRAGMENT_SIZE > 512)
+#error "BLE_CONFIG_MAX_FRAGMENT_SIZE must be between 20 and 512."
+#endif
+
 /**
  *  @def BLE_CONFIG_ERROR_TYPE
  *
@@ -65,6 +65,7 @@
 #include <Weave/Core/WeaveEncoding.h>
 #include <Weave/Support/logging/WeaveLogging.h>
 #include <Weave/Support/CodeUtils.h>
+#include <Weave/Support/FlagUtils.hpp>
 
 // clang-format off
 
@@ -118,7 +119,7 @@ public:
         }
     }
 
-    BLEEndPoint * Find(BLE_CONNECTION_OBJECT c)
+    BLEEndPoint * Find(const BleLayer * l, BLE_CONNECTION_OBJECT c)
     {
         if (c == BLE_CONNECTION_UNINITIALIZED)
         {
@@ -128,7 +129,7 @@ public:
         for (int i = 0; i < BLE_LAYER_NUM_BLE_ENDPOINTS; i++)
         {
             BLEEndPoint * elem = Get(i);
-            if (elem->mBle != NULL && elem->mConnObj == c)
+            if (elem->mBle == l && elem->mConnObj == c)
             {
                 return elem;
             }
@@ -317,7 +318,22 @@ BLE_ERROR BleLayer::Init(BlePlatformDelegate * platformDelegate, BleApplicationD
     mApplicationDelegate = appDelegate;
     mSystemLayer         = systemLayer;
 
-    memset(&sBLEEndPointPool, 0, sizeof(sBLEEndPointPool));
+    // Reset any end points left over from a previous initialization of this layer. The pool is shared by all
+    // BleLayer objects, so leave end points owned by other layers alone.
+    for (int i = 0; i < BLE_LAYER_NUM_BLE_ENDPOINTS; i++)
+    {
+        BLEEndPoint * elem = sBLEEndPointPool.Get(i);
+
+        if (elem->mBle == this)
+        {
+            memset(elem, 0, sizeof(BLEEndPoint));
+        }
+    }
+
+#if BLE_LAYER_MAX_GATT_SENDS_IN_FLIGHT
+    mSendSlotGrantee       = NULL;
+    mNextSendEndPointIndex = 0;
+#endif
 
     mState = kState_Initialized;
 
@@ -338,8 +354,8 @@ BLE_ERROR BleLayer::Shutdown()
     {
         BLEEndPoint * elem = sBLEEndPointPool.Get(i);
 
-        // If end point was initialized, and has not since been freed...
-        if (elem->mBle != NULL)
+        // If end point belongs to this layer, and has not since been freed...
+        if (elem->mBle == this)
         {
             // If end point hasn't already been closed...
             if (elem->mState != BLEEndPoint::kState_Closed)
@@ -446,7 +462,7 @@ bool BleLayer::HandleWriteReceived(BLE_CONNECTION_OBJECT connObj, const WeaveBle
         }
 
         // Find matching connection end point.
-        BLEEndPoint * endPoint = sBLEEndPointPool.Find(connObj);
+        BLEEndPoint * endPoint = sBLEEndPointPool.Find(this, connObj);
 
         if (endPoint != NULL)
         {
@@ -498,7 +514,7 @@ bool BleLayer::HandleIndicationReceived(BLE_CONNECTION_OBJECT connObj, const Wea
         }
 
         // find matching connection end point.
-        BLEEndPoint * endPoint = sBLEEndPointPool.Find(connObj);
+        BLEEndPoint * endPoint = sBLEEndPointPool.Find(this, connObj);
 
         if (endPoint != NULL)
         {
@@ -569,7 +585,7 @@ bool BleLayer::HandleIndicationConfirmation(BLE_CONNECTION_OBJECT connObj, const
 void BleLayer::HandleAckReceived(BLE_CONNECTION_OBJECT connObj)
 {
     // find matching connection end point.
-    BLEEndPoint * endPoint = sBLEEndPointPool.Find(connObj);
+    BLEEndPoint * endPoint = sBLEEndPointPool.Find(this, connObj);
 
     if (endPoint != NULL)
     {
@@ -584,6 +600,83 @@ void BleLayer::HandleAckReceived(BLE_CONNECTION_OBJECT connObj)
     {
         WeaveLogError(Ble, "no endpoint for BLE sent data ack");
     }
+
+    // A GATT send slot was freed, so let waiting end points take their turns.
+    DriveSending();
+}
+
+#if BLE_LAYER_MAX_GATT_SENDS_IN_FLIGHT
+// Returns true if the given end point may start a GATT write or indication now. An end point may not take a free slot
+// ahead of other end points already waiting for one, unless DriveSending() has granted it its turn.
+bool BleLayer::AcquireGattSendSlot(const BLEEndPoint * endPoint) const
+{
+    int numInFlight    = 0;
+    bool othersWaiting = false;
+
+    for (int i = 0; i < BLE_LAYER_NUM_BLE_ENDPOINTS; i++)
+    {
+        BLEEndPoint * elem = sBLEEndPointPool.Get(i);
+
+        if (elem->mBle != this)
+        {
+            continue;
+        }
+
+        if (GetFlag(elem->mConnStateFlags, BLEEndPoint::kConnState_GattOperationInFlight))
+        {
+            numInFlight++;
+        }
+        else if (elem != endPoint && GetFlag(elem->mConnStateFlags, BLEEndPoint::kConnState_AwaitingSendSlot))
+        {
+            othersWaiting = true;
+        }
+    }
+
+    return (numInFlight < BLE_LAYER_MAX_GATT_SENDS_IN_FLIGHT) && (!othersWaiting || endPoint == mSendSlotGrantee);
+}
+#endif // BLE_LAYER_MAX_GATT_SENDS_IN_FLIGHT
+
+// Hands free GATT send slots to waiting end points in round-robin order.
+void BleLayer::DriveSending()
+{
+#if BLE_LAYER_MAX_GATT_SENDS_IN_FLIGHT
+    // Don't hand out send slots while end points are being torn down.
+    if (mState != kState_Initialized)
+    {
+        return;
+    }
+
+    for (int n = 0; n < BLE_LAYER_NUM_BLE_ENDPOINTS; n++)
+    {
+        int i              = (mNextSendEndPointIndex + n) % BLE_LAYER_NUM_BLE_ENDPOINTS;
+        BLEEndPoint * elem = sBLEEndPointPool.Get(i);
+
+        if (elem->mBle != this || !GetFlag(elem->mConnStateFlags, BLEEndPoint::kConnState_AwaitingSendSlot))
+        {
+            continue;
+        }
+
+        mSendSlotGrantee = elem;
+
+        if (!AcquireGattSendSlot(elem))
+        {
+            mSendSlotGrantee = NULL;
+            break;
+        }
+
+        SetFlag(elem->mConnStateFlags, BLEEndPoint::kConnState_AwaitingSendSlot, false);
+        mNextSendEndPointIndex = (i + 1) % BLE_LAYER_NUM_BLE_ENDPOINTS;
+
+        BLE_ERROR err = elem->DriveSending();
+
+        mSendSlotGrantee = NULL;
+
+        if (err != BLE_NO_ERROR)
+        {
+            elem->DoClose(kBleCloseFlag_AbortTransmission, err);
+        }
+    }
+#endif // BLE_LAYER_MAX_GATT_SENDS_IN_FLIGHT
 }
 
 bool BleLayer::HandleSubscribeReceived(BLE_CONNECTION_OBJECT connObj, const WeaveBleUUID * svcId, const WeaveBleUUID * charId)
@@ -596,7 +689,7 @@ bool BleLayer::HandleSubscribeReceived(BLE_CONNECTION_OBJECT connObj, const Weav
     if (UUIDsMatch(&WEAVE_BLE_CHAR_2_ID, charId))
     {
         // Find end point already associated with BLE connection, if any.
-        BLEEndPoint * endPoint = sBLEEndPointPool.Find(connObj);
+        BLEEndPoint * endPoint = sBLEEndPointPool.Find(this, connObj);
 
         if (endPoint != NULL)
         {
@@ -620,7 +713,7 @@ bool BleLayer::HandleSubscribeComplete(BLE_CONNECTION_OBJECT connObj, const Weav
 
     if (UUIDsMatch(&WEAVE_BLE_CHAR_2_ID, charId))
     {
-        BLEEndPoint * endPoint = sBLEEndPointPool.Find(connObj);
+        BLEEndPoint * endPoint = sBLEEndPointPool.Find(this, connObj);
 
         if (endPoint != NULL)
         {
@@ -630,6 +723,9 @@ bool BleLayer::HandleSubscribeComplete(BLE_CONNECTION_OBJECT connObj, const Weav
         {
             WeaveLogError(Ble, "no endpoint for sub complete");
         }
+
+        // The subscribe held a GATT send slot, so let waiting end points take their turns.
+        DriveSending();
     }
 
     return true;
@@ -645,7 +741,7 @@ bool BleLayer::HandleUnsubscribeReceived(BLE_CONNECTION_OBJECT connObj, const We
     if (UUIDsMatch(&WEAVE_BLE_CHAR_2_ID, charId))
     {
         // Find end point already associated with BLE connection, if any.
-        BLEEndPoint * endPoint = sBLEEndPointPool.Find(connObj);
+        BLEEndPoint * endPoint = sBLEEndPointPool.Find(this, connObj);
 
         if (endPoint != NULL)
         {
@@ -670,7 +766,7 @@ bool BleLayer::HandleUnsubscribeComplete(BLE_CONNECTION_OBJECT connObj, const We
     if (UUIDsMatch(&WEAVE_BLE_CHAR_2_ID, charId))
     {
         // Find end point already associated with BLE connection, if any.
-        BLEEndPoint * endPoint = sBLEEndPointPool.Find(connObj);
+        BLEEndPoint * endPoint = sBLEEndPointPool.Find(this, connObj);
 
         if (endPoint != NULL)
         {
@@ -688,7 +784,7 @@ bool BleLayer::HandleUnsubscribeComplete(BLE_CONNECTION_OBJECT connObj, const We
 void BleLayer::HandleConnectionError(BLE_CONNECTION_OBJECT connObj, BLE_ERROR err)
 {
     // BLE connection has failed somehow, we must find and abort matching connection end point.
-    BLEEndPoint * endPoint = sBLEEndPointPool.Find(connObj);
+    BLEEndPoint * endPoint = sBLEEndPointPool.Find(this, connObj);
 
     if (endPoint != NULL)
     {
@@ -346,12 +346,19 @@ private:
     BlePlatformDelegate * mPlatformDelegate;
     BleApplicationDelegate * mApplicationDelegate;
     Weave::System::Layer * mSystemLayer;
+#if BLE_LAYER_MAX_GATT_SENDS_IN_FLIGHT
+    BLEEndPoint * mSendSlotGrantee; // End point granted a GATT send slot by DriveSending(), if any.
+    uint8_t mNextSendEndPointIndex; // Pool index at which DriveSending() resumes its round-robin scan.
+#endif
 
 private:
     // Private functions:
     void HandleDataReceived(BLE_CONNECTION_OBJECT connObj, PacketBuffer * pBuf);
     void HandleAckReceived(BLE_CONNECTION_OBJECT connObj);
     void DriveSending(void);
+#if BLE_LAYER_MAX_GATT_SENDS_IN_FLIGHT
+    bool AcquireGattSendSlot(const BLEEndPoint * endPoint) const;
+#endif
     BLE_ERROR HandleBleTransportConnectionInitiated(BLE_CONNECTION_OBJECT connObj, PacketBuffer * pBuf);
 
     static BleTransportProtocolVersion GetHighestSupportedProtocolVersion(const BleTransportCapabilitiesRequestMessage & reqMsg);
@@ -117,6 +117,7 @@ WEAVE_ERROR WeaveDeviceManager::Init(WeaveExchangeManager *exchangeMgr, WeaveSec
     mAssistingDeviceId = kNodeIdNotSpecified;
     mConTimeout = secondsToMilliseconds(60);
     mConTryCount = 0;
+    mSecurityMgrBusyTryCount = 0;
     mSessionKeyId = WeaveKeyId::kNone;
     mEncType = kWeaveEncryptionType_None;
     mAuthType = kAuthType_None;
@@ -1328,6 +1329,7 @@ void WeaveDeviceManager::CloseDeviceConnection(bool graceful)
     //
     mConState = kConnectionState_NotConnected;
     mConTryCount = 0;
+    mSecurityMgrBusyTryCount = 0;
     mSessionKeyId = WeaveKeyId::kNone;
     mEncType = kWeaveEncryptionType_None;
     mConnectedToRemoteDevice = false;
@@ -2853,6 +2855,7 @@ WEAVE_ERROR WeaveDeviceManager::InitiateConnection()
                 ? "Initiating rendezvous for device"
                 : "Initiating connection to device");
         mConTryCount = 0;
+        mSecurityMgrBusyTryCount = 0;
     }
 
     // Enable UDP if not already enabled.
@@ -3563,6 +3566,30 @@ WEAVE_ERROR WeaveDeviceManager::StartSession()
         break;
     }
 
+    // The security manager establishes one session at a time. If it is busy with a session for another
+    // device manager sharing the same stack, wait for it to finish rather than failing. These retries
+    // don't count towards the session retry limit, but give up once they would outlast the connect
+    // timeout (or kMaxSecurityMgrBusyRetryCount if there is none) and report the error.
+    if (err == WEAVE_ERROR_SECURITY_MANAGER_BUSY)
+    {
+        mSecurityMgrBusyTryCount++;
+
+        if (mSecurityMgrBusyTryCount < kMaxSecurityMgrBusyRetryCount &&
+            (mConTimeout == 0 || static_cast<uint32_t>(mSecurityMgrBusyTryCount) * kSecurityMgrBusyRetryInterval < mConTimeout))
+        {
+            mConTryCount--;
+            err = mSystemLayer->StartTimer(kSecurityMgrBusyRetryInterval, RetrySession, this);
+        }
+        else
+        {
+            WeaveLogError(DeviceManager, "Security manager still busy after %u retries", mSecurityMgrBusyTryCount);
+        }
+    }
+    else
+    {
+        mSecurityMgrBusyTryCount = 0;
+    }
+
     return err;
 }
 
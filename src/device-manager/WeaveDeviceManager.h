@@ -329,6 +329,8 @@ private:
         kEnumerateDevicesRetryInterval                   = 500, // ms
         kSessionRetryInterval                            = 1000, // ms
         kMaxSessionRetryCount                            = 20,
+        kSecurityMgrBusyRetryInterval                    = 50,   // ms
+        kMaxSecurityMgrBusyRetryCount                    = 1200, // 60 s at kSecurityMgrBusyRetryInterval
     };
 
     enum
@@ -404,6 +406,7 @@ private:
     uint64_t mAssistingDeviceId;
     uint32_t mConTimeout;                                       // in ms; 0 means disabled.
     uint32_t mConTryCount;
+    uint16_t mSecurityMgrBusyTryCount;
     uint16_t mSessionKeyId;
     uint8_t mEncType;
     uint8_t mAuthType;
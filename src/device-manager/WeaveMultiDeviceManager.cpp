@@ -0,0 +1,757 @@
+/*
+ *
+ *    Copyright (c) 2020 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Implementation of Weave Multi-Device Manager, which drives provisioning
+ *      sessions with many devices concurrently over a single Weave stack.
+ *
+ */
+
+#ifndef __STDC_LIMIT_MACROS
+#define __STDC_LIMIT_MACROS
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <Weave/Core/WeaveCore.h>
+#include <Weave/DeviceManager/WeaveMultiDeviceManager.h>
+#include <Weave/Support/CodeUtils.h>
+#include <Weave/Support/crypto/WeaveCrypto.h>
+#include <Weave/Support/logging/WeaveLogging.h>
+#include <Weave/Support/ErrorStr.h>
+
+namespace nl {
+namespace Weave {
+namespace DeviceManager {
+
+DeviceSession::DeviceSession()
+{
+    AppState = NULL;
+    mManager = NULL;
+    mNext = NULL;
+    mRequestHead = NULL;
+    mRequestTail = NULL;
+    mDeviceId = kNodeIdNotSpecified;
+    mLastAddedNetworkId = 0;
+    mNumRequests = 0;
+    mCallbackDepth = 0;
+    mRequestInProgress = false;
+    mReleasePending = false;
+    mDeleteOnCallbackExit = false;
+}
+
+DeviceSession::~DeviceSession()
+{
+    Shutdown();
+}
+
+WEAVE_ERROR DeviceSession::Init(WeaveMultiDeviceManager *manager, WeaveExchangeManager *exchangeMgr, WeaveSecurityManager *securityMgr)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    err = mDeviceMgr.Init(exchangeMgr, securityMgr);
+    SuccessOrExit(err);
+
+    // Completions from the device manager are mapped back to the session through its AppState.
+    mDeviceMgr.AppState = this;
+    mManager = manager;
+
+exit:
+    return err;
+}
+
+void DeviceSession::Shutdown()
+{
+    Request *requests;
+
+    if (mManager == NULL)
+        return;
+
+    mManager->mSystemLayer->CancelTimer(HandleIssueNextRequest, this);
+
+    // Drop queued requests without calling their completion functions.
+    requests = DetachRequests();
+    while (requests != NULL)
+    {
+        Request *req = requests;
+        requests = req->Next;
+        FreeRequest(req);
+    }
+
+    mDeviceMgr.Shutdown();
+    mManager = NULL;
+}
+
+/**
+ *  Queue a request to connect to a device and authenticate with its pairing code (PASE).
+ *
+ *  @param[in] deviceId         The node id of the device, or kAnyNodeId.
+ *  @param[in] deviceAddr       The address of the device, or IPAddress::Any to locate it by node id.
+ *  @param[in] pairingCode      The device's pairing code.
+ *  @param[in] appReqState      Application state passed back to @a onComplete.
+ *  @param[in] onComplete       Called when the request completes or fails.
+ */
+WEAVE_ERROR DeviceSession::ConnectDevice(uint64_t deviceId, IPAddress deviceAddr, const char *pairingCode,
+                                         void *appReqState, DeviceRequestCompleteFunct onComplete)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    Request *req = NULL;
+
+    VerifyOrExit(pairingCode != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    err = NewRequest(kRequest_ConnectDevice, appReqState, onComplete, req);
+    SuccessOrExit(err);
+
+    req->Id = deviceId;
+    req->Addr = deviceAddr;
+
+    // Keep the NUL terminator so that the copy can be passed back as a C string.
+    req->DataLen[0] = strlen(pairingCode) + 1;
+    err = CopyData(pairingCode, req->DataLen[0], req->Data[0]);
+    SuccessOrExit(err);
+
+    err = EnqueueRequest(req);
+    SuccessOrExit(err);
+    req = NULL;
+
+exit:
+    FreeRequest(req);
+    return err;
+}
+
+WEAVE_ERROR DeviceSession::AddNetwork(const NetworkInfo *netInfo, void *appReqState, DeviceRequestCompleteFunct onComplete)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    Request *req = NULL;
+
+    VerifyOrExit(netInfo != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    err = NewRequest(kRequest_AddNetwork, appReqState, onComplete, req);
+    SuccessOrExit(err);
+
+    req->NetInfo = new NetworkInfo();
+    VerifyOrExit(req->NetInfo != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+    err = const_cast<NetworkInfo *>(netInfo)->CopyTo(*req->NetInfo);
+    SuccessOrExit(err);
+
+    err = EnqueueRequest(req);
+    SuccessOrExit(err);
+    req = NULL;
+
+exit:
+    FreeRequest(req);
+    return err;
+}
+
+/**
+ *  Queue a request to enable a network on the device.
+ *
+ *  @param[in] networkId        The id of the network, or kLastAddedNetworkId for the network
+ *                              added by this session's most recent AddNetwork request.
+ */
+WEAVE_ERROR DeviceSession::EnableNetwork(uint32_t networkId, void *appReqState, DeviceRequestCompleteFunct onComplete)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    Request *req = NULL;
+
+    err = NewRequest(kRequest_EnableNetwork, appReqState, onComplete, req);
+    SuccessOrExit(err);
+
+    req->Value = networkId;
+
+    err = EnqueueRequest(req);
+    SuccessOrExit(err);
+    req = NULL;
+
+exit:
+    FreeRequest(req);
+    return err;
+}
+
+/**
+ *  Queue a request to test the device's connectivity on a network.
+ *
+ *  @param[in] networkId        The id of the network, or kLastAddedNetworkId for the network
+ *                              added by this session's most recent AddNetwork request.
+ */
+WEAVE_ERROR DeviceSession::TestNetworkConnectivity(uint32_t networkId, void *appReqState, DeviceRequestCompleteFunct onComplete)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    Request *req = NULL;
+
+    err = NewRequest(kRequest_TestNetworkConnectivity, appReqState, onComplete, req);
+    SuccessOrExit(err);
+
+    req->Value = networkId;
+
+    err = EnqueueRequest(req);
+    SuccessOrExit(err);
+    req = NULL;
+
+exit:
+    FreeRequest(req);
+    return err;
+}
+
+WEAVE_ERROR DeviceSession::CreateFabric(void *appReqState, DeviceRequestCompleteFunct onComplete)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    Request *req = NULL;
+
+    err = NewRequest(kRequest_CreateFabric, appReqState, onComplete, req);
+    SuccessOrExit(err);
+
+    err = EnqueueRequest(req);
+    SuccessOrExit(err);
+    req = NULL;
+
+exit:
+    FreeRequest(req);
+    return err;
+}
+
+WEAVE_ERROR DeviceSession::JoinExistingFabric(const uint8_t *fabricConfig, uint32_t fabricConfigLen,
+                                              void *appReqState, DeviceRequestCompleteFunct onComplete)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    Request *req = NULL;
+
+    VerifyOrExit(fabricConfig != NULL && fabricConfigLen != 0, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    err = NewRequest(kRequest_JoinExistingFabric, appReqState, onComplete, req);
+    SuccessOrExit(err);
+
+    err = CopyData(fabricConfig, fabricConfigLen, req->Data[0]);
+    SuccessOrExit(err);
+    req->DataLen[0] = fabricConfigLen;
+
+    err = EnqueueRequest(req);
+    SuccessOrExit(err);
+    req = NULL;
+
+exit:
+    FreeRequest(req);
+    return err;
+}
+
+WEAVE_ERROR DeviceSession::RegisterServicePairAccount(uint64_t serviceId, const char *accountId,
+                                                      const uint8_t *serviceConfig, uint16_t serviceConfigLen,
+                                                      const uint8_t *pairingToken, uint16_t pairingTokenLen,
+                                                      const uint8_t *pairingInitData, uint16_t pairingInitDataLen,
+                                                      void *appReqState, DeviceRequestCompleteFunct onComplete)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    Request *req = NULL;
+
+    VerifyOrExit(accountId != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    err = NewRequest(kRequest_RegisterServicePairAccount, appReqState, onComplete, req);
+    SuccessOrExit(err);
+
+    req->Id = serviceId;
+
+    req->DataLen[0] = strlen(accountId) + 1;
+    err = CopyData(accountId, req->DataLen[0], req->Data[0]);
+    SuccessOrExit(err);
+
+    err = CopyData(serviceConfig, serviceConfigLen, req->Data[1]);
+    SuccessOrExit(err);
+    req->DataLen[1] = serviceConfigLen;
+
+    err = CopyData(pairingToken, pairingTokenLen, req->Data[2]);
+    SuccessOrExit(err);
+    req->DataLen[2] = pairingTokenLen;
+
+    err = CopyData(pairingInitData, pairingInitDataLen, req->Data[3]);
+    SuccessOrExit(err);
+    req->DataLen[3] = pairingInitDataLen;
+
+    err = EnqueueRequest(req);
+    SuccessOrExit(err);
+    req = NULL;
+
+exit:
+    FreeRequest(req);
+    return err;
+}
+
+WEAVE_ERROR DeviceSession::ArmFailSafe(uint8_t armMode, uint32_t failSafeToken, void *appReqState, DeviceRequestCompleteFunct onComplete)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    Request *req = NULL;
+
+    err = NewRequest(kRequest_ArmFailSafe, appReqState, onComplete, req);
+    SuccessOrExit(err);
+
+    req->ArmMode = armMode;
+    req->Value = failSafeToken;
+
+    err = EnqueueRequest(req);
+    SuccessOrExit(err);
+    req = NULL;
+
+exit:
+    FreeRequest(req);
+    return err;
+}
+
+WEAVE_ERROR DeviceSession::DisarmFailSafe(void *appReqState, DeviceRequestCompleteFunct onComplete)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    Request *req = NULL;
+
+    err = NewRequest(kRequest_DisarmFailSafe, appReqState, onComplete, req);
+    SuccessOrExit(err);
+
+    err = EnqueueRequest(req);
+    SuccessOrExit(err);
+    req = NULL;
+
+exit:
+    FreeRequest(req);
+    return err;
+}
+
+WEAVE_ERROR DeviceSession::Ping(void *appReqState, DeviceRequestCompleteFunct onComplete)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    Request *req = NULL;
+
+    err = NewRequest(kRequest_Ping, appReqState, onComplete, req);
+    SuccessOrExit(err);
+
+    err = EnqueueRequest(req);
+    SuccessOrExit(err);
+    req = NULL;
+
+exit:
+    FreeRequest(req);
+    return err;
+}
+
+/**
+ *  Close the connection to the device and cancel all outstanding requests.
+ *
+ *  The completion functions of cancelled requests are called with WEAVE_ERROR_CONNECTION_ABORTED.
+ *  The session remains usable, starting with a new ConnectDevice request.
+ */
+void DeviceSession::Close()
+{
+    if (mManager == NULL)
+        return;
+
+    mManager->mSystemLayer->CancelTimer(HandleIssueNextRequest, this);
+    mDeviceMgr.Close();
+
+    mCallbackDepth++;
+
+    CompleteCancelledRequests(DetachRequests(), WEAVE_ERROR_CONNECTION_ABORTED);
+
+    EndCallback();
+}
+
+WEAVE_ERROR DeviceSession::NewRequest(RequestType type, void *appReqState, DeviceRequestCompleteFunct onComplete, Request *& req)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    VerifyOrExit(mManager != NULL, err = WEAVE_ERROR_INCORRECT_STATE);
+    VerifyOrExit(onComplete != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    req = new Request();
+    VerifyOrExit(req != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+    memset(req->Data, 0, sizeof(req->Data));
+    memset(req->DataLen, 0, sizeof(req->DataLen));
+    req->Next = NULL;
+    req->Type = type;
+    req->AppReqState = appReqState;
+    req->OnComplete = onComplete;
+    req->Id = kNodeIdNotSpecified;
+    req->Addr = IPAddress::Any;
+    req->Value = 0;
+    req->ArmMode = 0;
+    req->NetInfo = NULL;
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR DeviceSession::CopyData(const void *data, uint32_t dataLen, uint8_t *& copy)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    copy = NULL;
+
+    if (data != NULL && dataLen != 0)
+    {
+        copy = static_cast<uint8_t *>(malloc(dataLen));
+        VerifyOrExit(copy != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+        memcpy(copy, data, dataLen);
+    }
+
+exit:
+    return err;
+}
+
+void DeviceSession::FreeRequest(Request *req)
+{
+    if (req == NULL)
+        return;
+
+    // Request data may hold pairing codes and tokens.
+    for (int i = 0; i < kMaxRequestData; i++)
+    {
+        if (req->Data[i] != NULL)
+        {
+            nl::Weave::Crypto::ClearSecretData(req->Data[i], req->DataLen[i]);
+            free(req->Data[i]);
+        }
+    }
+
+    delete req->NetInfo;
+    delete req;
+}
+
+WEAVE_ERROR DeviceSession::EnqueueRequest(Request *req)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    // Start the request straight away if the session is idle.
+    if (mRequestHead == NULL)
+    {
+        err = ScheduleNextRequest();
+        SuccessOrExit(err);
+    }
+
+    if (mRequestTail != NULL)
+        mRequestTail->Next = req;
+    else
+        mRequestHead = req;
+    mRequestTail = req;
+    mNumRequests++;
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR DeviceSession::ScheduleNextRequest()
+{
+    // Requests are always issued from a fresh call stack, never from within a device manager callback,
+    // so the device manager has finished with the previous operation by the time the next one starts.
+    mManager->mSystemLayer->CancelTimer(HandleIssueNextRequest, this);
+    return mManager->mSystemLayer->ScheduleWork(HandleIssueNextRequest, this);
+}
+
+void DeviceSession::HandleIssueNextRequest(System::Layer *aSystemLayer, void *aAppState, System::Error aError)
+{
+    static_cast<DeviceSession *>(aAppState)->IssueNextRequest();
+}
+
+void DeviceSession::IssueNextRequest()
+{
+    WEAVE_ERROR err;
+
+    if (mRequestInProgress || mRequestHead == NULL)
+        return;
+
+    mRequestInProgress = true;
+
+    err = IssueRequest(mRequestHead);
+    if (err != WEAVE_NO_ERROR)
+    {
+        CompleteRequest(err, NULL);
+    }
+}
+
+WEAVE_ERROR DeviceSession::IssueRequest(Request *req)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    uint32_t networkId = (req->Value == kLastAddedNetworkId) ? mLastAddedNetworkId : req->Value;
+
+    switch (req->Type)
+    {
+    case kRequest_ConnectDevice:
+        mDeviceId = req->Id;
+        err = mDeviceMgr.ConnectDevice(req->Id, req->Addr, reinterpret_cast<const char *>(req->Data[0]),
+                                       this, HandleRequestComplete, HandleRequestError);
+        break;
+    case kRequest_AddNetwork:
+        err = mDeviceMgr.AddNetwork(req->NetInfo, this, HandleAddNetworkComplete, HandleRequestError);
+        break;
+    case kRequest_EnableNetwork:
+        err = mDeviceMgr.EnableNetwork(networkId, this, HandleRequestComplete, HandleRequestError);
+        break;
+    case kRequest_TestNetworkConnectivity:
+        err = mDeviceMgr.TestNetworkConnectivity(networkId, this, HandleRequestComplete, HandleRequestError);
+        break;
+    case kRequest_CreateFabric:
+        err = mDeviceMgr.CreateFabric(this, HandleRequestComplete, HandleRequestError);
+        break;
+    case kRequest_JoinExistingFabric:
+        err = mDeviceMgr.JoinExistingFabric(req->Data[0], req->DataLen[0], this, HandleRequestComplete, HandleRequestError);
+        break;
+    case kRequest_RegisterServicePairAccount:
+        err = mDeviceMgr.RegisterServicePairAccount(req->Id, reinterpret_cast<const char *>(req->Data[0]),
+                                                    req->Data[1], static_cast<uint16_t>(req->DataLen[1]),
+                                                    req->Data[2], static_cast<uint16_t>(req->DataLen[2]),
+                                                    req->Data[3], static_cast<uint16_t>(req->DataLen[3]),
+                                                    this, HandleRequestComplete, HandleRequestError);
+        break;
+    case kRequest_ArmFailSafe:
+        err = mDeviceMgr.ArmFailSafe(req->ArmMode, req->Value, this, HandleRequestComplete, HandleRequestError);
+        break;
+    case kRequest_DisarmFailSafe:
+        err = mDeviceMgr.DisarmFailSafe(this, HandleRequestComplete, HandleRequestError);
+        break;
+    case kRequest_Ping:
+        err = mDeviceMgr.Ping(this, HandleRequestComplete, HandleRequestError);
+        break;
+    default:
+        err = WEAVE_ERROR_INCORRECT_STATE;
+        break;
+    }
+
+    return err;
+}
+
+void DeviceSession::CompleteRequest(WEAVE_ERROR err, DeviceStatus *devStatus)
+{
+    Request *req = mRequestHead;
+    Request *cancelled = NULL;
+    WEAVE_ERROR cancelErr = WEAVE_ERROR_CONNECTION_ABORTED;
+
+    mRequestInProgress = false;
+
+    if (req == NULL)
+        return;
+
+    mRequestHead = req->Next;
+    if (mRequestHead == NULL)
+        mRequestTail = NULL;
+    mNumRequests--;
+
+    if (err != WEAVE_NO_ERROR)
+    {
+        WeaveLogError(DeviceManager, "Request to device %016" PRIX64 " failed: %s", mDeviceId, ErrorStr(err));
+
+        // Nothing queued behind a failed request can succeed, so close the connection and cancel the rest.
+        mDeviceMgr.Close();
+        cancelled = DetachRequests();
+    }
+    else if (mRequestHead != NULL)
+    {
+        cancelErr = ScheduleNextRequest();
+        if (cancelErr != WEAVE_NO_ERROR)
+            cancelled = DetachRequests();
+    }
+
+    mCallbackDepth++;
+
+    req->OnComplete(this, req->AppReqState, err, devStatus);
+    FreeRequest(req);
+
+    CompleteCancelledRequests(cancelled, cancelErr);
+
+    EndCallback();
+}
+
+void DeviceSession::EndCallback()
+{
+    if (--mCallbackDepth == 0 && mDeleteOnCallbackExit)
+        delete this;
+}
+
+void DeviceSession::HandleReleasedSession(System::Layer *aSystemLayer, void *aAppState, System::Error aError)
+{
+    DeviceSession *session = static_cast<DeviceSession *>(aAppState);
+
+    if (session->mCallbackDepth > 0)
+        session->mDeleteOnCallbackExit = true;
+    else
+        delete session;
+}
+
+DeviceSession::Request *DeviceSession::DetachRequests()
+{
+    Request *requests = mRequestHead;
+
+    mRequestHead = NULL;
+    mRequestTail = NULL;
+    mNumRequests = 0;
+    mRequestInProgress = false;
+
+    return requests;
+}
+
+void DeviceSession::CompleteCancelledRequests(Request *cancelled, WEAVE_ERROR err)
+{
+    while (cancelled != NULL)
+    {
+        Request *req = cancelled;
+        cancelled = req->Next;
+
+        // Once the session has been released, drop the remaining requests silently.
+        if (!mReleasePending)
+            req->OnComplete(this, req->AppReqState, err, NULL);
+        FreeRequest(req);
+    }
+}
+
+void DeviceSession::HandleRequestComplete(WeaveDeviceManager *deviceMgr, void *appReqState)
+{
+    static_cast<DeviceSession *>(appReqState)->CompleteRequest(WEAVE_NO_ERROR, NULL);
+}
+
+void DeviceSession::HandleAddNetworkComplete(WeaveDeviceManager *deviceMgr, void *appReqState, uint32_t networkId)
+{
+    DeviceSession *session = static_cast<DeviceSession *>(appReqState);
+
+    session->mLastAddedNetworkId = networkId;
+    session->CompleteRequest(WEAVE_NO_ERROR, NULL);
+}
+
+void DeviceSession::HandleRequestError(WeaveDeviceManager *deviceMgr, void *appReqState, WEAVE_ERROR err, DeviceStatus *devStatus)
+{
+    static_cast<DeviceSession *>(appReqState)->CompleteRequest(err, devStatus);
+}
+
+WeaveMultiDeviceManager::WeaveMultiDeviceManager()
+{
+    State = kState_NotInitialized;
+    AppState = NULL;
+    mSystemLayer = NULL;
+    mExchangeMgr = NULL;
+    mSecurityMgr = NULL;
+    mSessions = NULL;
+    mNumSessions = 0;
+    mMaxSessions = 0;
+}
+
+/**
+ *  Initialize the manager.
+ *
+ *  @param[in] exchangeMgr      The exchange manager shared by all sessions.
+ *  @param[in] securityMgr      The security manager shared by all sessions.
+ *  @param[in] maxSessions      The maximum number of device sessions open at once.
+ */
+WEAVE_ERROR WeaveMultiDeviceManager::Init(WeaveExchangeManager *exchangeMgr, WeaveSecurityManager *securityMgr, uint16_t maxSessions)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    VerifyOrExit(State == kState_NotInitialized, err = WEAVE_ERROR_INCORRECT_STATE);
+    VerifyOrExit(exchangeMgr != NULL && securityMgr != NULL && maxSessions != 0, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    mSystemLayer = exchangeMgr->MessageLayer->SystemLayer;
+    mExchangeMgr = exchangeMgr;
+    mSecurityMgr = securityMgr;
+    mSessions = NULL;
+    mNumSessions = 0;
+    mMaxSessions = maxSessions;
+
+    State = kState_Initialized;
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR WeaveMultiDeviceManager::Shutdown()
+{
+    while (mSessions != NULL)
+    {
+        ReleaseSession(mSessions);
+    }
+
+    State = kState_NotInitialized;
+
+    return WEAVE_NO_ERROR;
+}
+
+/**
+ *  Open a new device session.
+ *
+ *  @retval #WEAVE_ERROR_TOO_MANY_CONNECTIONS  If maxSessions sessions are already open.
+ */
+WEAVE_ERROR WeaveMultiDeviceManager::NewSession(DeviceSession *& session)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    session = NULL;
+
+    VerifyOrExit(State == kState_Initialized, err = WEAVE_ERROR_INCORRECT_STATE);
+    VerifyOrExit(mNumSessions < mMaxSessions, err = WEAVE_ERROR_TOO_MANY_CONNECTIONS);
+
+    session = new DeviceSession();
+    VerifyOrExit(session != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+    err = session->Init(this, mExchangeMgr, mSecurityMgr);
+    SuccessOrExit(err);
+
+    session->mNext = mSessions;
+    mSessions = session;
+    mNumSessions++;
+
+exit:
+    if (err != WEAVE_NO_ERROR && session != NULL)
+    {
+        delete session;
+        session = NULL;
+    }
+
+    return err;
+}
+
+/**
+ *  Close a device session and free its resources. Outstanding requests are dropped without
+ *  calling their completion functions. May be called from within the session's completion
+ *  functions.
+ */
+void WeaveMultiDeviceManager::ReleaseSession(DeviceSession *session)
+{
+    for (DeviceSession **link = &mSessions; *link != NULL; link = &(*link)->mNext)
+    {
+        if (*link == session)
+        {
+            *link = session->mNext;
+            mNumSessions--;
+
+            session->Shutdown();
+
+            // A session released from within one of its own completion functions may still be on the
+            // device manager's call stack, so free it from a fresh one.
+            if (session->mCallbackDepth > 0)
+            {
+                session->mReleasePending = true;
+                if (mSystemLayer->ScheduleWork(DeviceSession::HandleReleasedSession, session) != WEAVE_NO_ERROR)
+                    session->mDeleteOnCallbackExit = true;
+            }
+            else
+            {
+                delete session;
+            }
+            break;
+        }
+    }
+}
+
+} // namespace DeviceManager
+} // namespace Weave
+} // namespace nl
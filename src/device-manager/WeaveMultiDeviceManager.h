@@ -0,0 +1,208 @@
+/*
+ *
+ *    Copyright (c) 2020 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Declaration of Weave Multi-Device Manager, which drives provisioning
+ *      sessions with many devices concurrently over a single Weave stack.
+ *
+ */
+
+#ifndef __WEAVEMULTIDEVICEMANAGER_H
+#define __WEAVEMULTIDEVICEMANAGER_H
+
+#include <Weave/DeviceManager/WeaveDeviceManager.h>
+
+namespace nl {
+namespace Weave {
+namespace DeviceManager {
+
+class WeaveMultiDeviceManager;
+class DeviceSession;
+
+extern "C"
+{
+typedef void (*DeviceRequestCompleteFunct)(DeviceSession *session, void *appReqState, WEAVE_ERROR err, DeviceStatus *devStatus);
+};
+
+/**
+ *  A provisioning session with a single device, owned by a WeaveMultiDeviceManager.
+ *
+ *  Requests made on a session are queued and issued to the device one at a time, in order,
+ *  through the session's own WeaveDeviceManager. Each request's completion function is called
+ *  with WEAVE_NO_ERROR when the device completes it, or with the error that caused it to fail.
+ *  A failed request cancels the requests queued behind it, which complete with
+ *  WEAVE_ERROR_CONNECTION_ABORTED, and closes the connection to the device.
+ *
+ *  All arguments are copied when a request is queued.
+ */
+class NL_DLL_EXPORT DeviceSession
+{
+    friend class WeaveMultiDeviceManager;
+
+public:
+    enum
+    {
+        kLastAddedNetworkId = 0xFFFFFFFF    ///< Network id placeholder for the network added by the last AddNetwork request.
+    };
+
+    void *AppState;
+
+    WeaveMultiDeviceManager *GetManager(void) const { return mManager; }
+    WeaveDeviceManager &GetDeviceManager(void) { return mDeviceMgr; }
+    uint64_t GetDeviceId(void) const { return mDeviceId; }
+    uint32_t GetLastAddedNetworkId(void) const { return mLastAddedNetworkId; }
+    uint16_t GetPendingRequestCount(void) const { return mNumRequests; }
+
+    WEAVE_ERROR ConnectDevice(uint64_t deviceId, IPAddress deviceAddr, const char *pairingCode,
+                              void *appReqState, DeviceRequestCompleteFunct onComplete);
+    WEAVE_ERROR AddNetwork(const NetworkInfo *netInfo, void *appReqState, DeviceRequestCompleteFunct onComplete);
+    WEAVE_ERROR EnableNetwork(uint32_t networkId, void *appReqState, DeviceRequestCompleteFunct onComplete);
+    WEAVE_ERROR TestNetworkConnectivity(uint32_t networkId, void *appReqState, DeviceRequestCompleteFunct onComplete);
+    WEAVE_ERROR CreateFabric(void *appReqState, DeviceRequestCompleteFunct onComplete);
+    WEAVE_ERROR JoinExistingFabric(const uint8_t *fabricConfig, uint32_t fabricConfigLen,
+                                   void *appReqState, DeviceRequestCompleteFunct onComplete);
+    WEAVE_ERROR RegisterServicePairAccount(uint64_t serviceId, const char *accountId,
+                                           const uint8_t *serviceConfig, uint16_t serviceConfigLen,
+                                           const uint8_t *pairingToken, uint16_t pairingTokenLen,
+                                           const uint8_t *pairingInitData, uint16_t pairingInitDataLen,
+                                           void *appReqState, DeviceRequestCompleteFunct onComplete);
+    WEAVE_ERROR ArmFailSafe(uint8_t armMode, uint32_t failSafeToken, void *appReqState, DeviceRequestCompleteFunct onComplete);
+    WEAVE_ERROR DisarmFailSafe(void *appReqState, DeviceRequestCompleteFunct onComplete);
+    WEAVE_ERROR Ping(void *appReqState, DeviceRequestCompleteFunct onComplete);
+
+    void Close(void);
+
+private:
+    enum RequestType
+    {
+        kRequest_ConnectDevice                          = 0,
+        kRequest_AddNetwork                             = 1,
+        kRequest_EnableNetwork                          = 2,
+        kRequest_TestNetworkConnectivity                = 3,
+        kRequest_CreateFabric                           = 4,
+        kRequest_JoinExistingFabric                     = 5,
+        kRequest_RegisterServicePairAccount             = 6,
+        kRequest_ArmFailSafe                            = 7,
+        kRequest_DisarmFailSafe                         = 8,
+        kRequest_Ping                                   = 9,
+    };
+
+    enum
+    {
+        kMaxRequestData = 4
+    };
+
+    struct Request
+    {
+        Request *Next;
+        RequestType Type;
+        void *AppReqState;
+        DeviceRequestCompleteFunct OnComplete;
+        uint64_t Id;                            // Device id or service id.
+        IPAddress Addr;
+        uint32_t Value;                         // Network id or fail-safe token.
+        uint8_t ArmMode;
+        NetworkInfo *NetInfo;
+        uint8_t *Data[kMaxRequestData];         // Pairing code, fabric config or service pairing arguments.
+        uint32_t DataLen[kMaxRequestData];
+    };
+
+    DeviceSession(void);
+    ~DeviceSession(void);
+
+    WEAVE_ERROR Init(WeaveMultiDeviceManager *manager, WeaveExchangeManager *exchangeMgr, WeaveSecurityManager *securityMgr);
+    void Shutdown(void);
+
+    WEAVE_ERROR NewRequest(RequestType type, void *appReqState, DeviceRequestCompleteFunct onComplete, Request *& req);
+    static WEAVE_ERROR CopyData(const void *data, uint32_t dataLen, uint8_t *& copy);
+    static void FreeRequest(Request *req);
+    WEAVE_ERROR EnqueueRequest(Request *req);
+    WEAVE_ERROR ScheduleNextRequest(void);
+    void IssueNextRequest(void);
+    WEAVE_ERROR IssueRequest(Request *req);
+    void CompleteRequest(WEAVE_ERROR err, DeviceStatus *devStatus);
+    Request *DetachRequests(void);
+    void CompleteCancelledRequests(Request *cancelled, WEAVE_ERROR err);
+    void EndCallback(void);
+
+    static void HandleIssueNextRequest(System::Layer *aSystemLayer, void *aAppState, System::Error aError);
+    static void HandleReleasedSession(System::Layer *aSystemLayer, void *aAppState, System::Error aError);
+    static void HandleRequestComplete(WeaveDeviceManager *deviceMgr, void *appReqState);
+    static void HandleAddNetworkComplete(WeaveDeviceManager *deviceMgr, void *appReqState, uint32_t networkId);
+    static void HandleRequestError(WeaveDeviceManager *deviceMgr, void *appReqState, WEAVE_ERROR err, DeviceStatus *devStatus);
+
+    WeaveMultiDeviceManager *mManager;
+    DeviceSession *mNext;
+    WeaveDeviceManager mDeviceMgr;
+    Request *mRequestHead;
+    Request *mRequestTail;
+    uint64_t mDeviceId;
+    uint32_t mLastAddedNetworkId;
+    uint16_t mNumRequests;
+    uint8_t mCallbackDepth;
+    bool mRequestInProgress;
+    bool mReleasePending;
+    bool mDeleteOnCallbackExit;
+};
+
+/**
+ *  Drives provisioning sessions with many devices concurrently.
+ *
+ *  Each DeviceSession wraps its own WeaveDeviceManager. All sessions share the exchange manager
+ *  and security manager passed to Init(), so connections, PASE and provisioning exchanges for
+ *  different devices proceed in parallel on one Weave stack. The security manager establishes one
+ *  secure session at a time; device managers that find it busy wait for it and try again.
+ */
+class NL_DLL_EXPORT WeaveMultiDeviceManager
+{
+    friend class DeviceSession;
+
+public:
+    enum
+    {
+        kState_NotInitialized = 0,
+        kState_Initialized = 1
+    } State;                        // [READ-ONLY] Current state
+
+    WeaveMultiDeviceManager(void);
+
+    void *AppState;
+
+    WEAVE_ERROR Init(WeaveExchangeManager *exchangeMgr, WeaveSecurityManager *securityMgr, uint16_t maxSessions);
+    WEAVE_ERROR Shutdown(void);
+
+    WEAVE_ERROR NewSession(DeviceSession *& session);
+    void ReleaseSession(DeviceSession *session);
+
+    uint16_t GetSessionCount(void) const { return mNumSessions; }
+
+private:
+    System::Layer *mSystemLayer;
+    WeaveExchangeManager *mExchangeMgr;
+    WeaveSecurityManager *mSecurityMgr;
+    DeviceSession *mSessions;
+    uint16_t mNumSessions;
+    uint16_t mMaxSessions;
+};
+
+} // namespace DeviceManager
+} // namespace Weave
+} // namespace nl
+
+#endif // __WEAVEMULTIDEVICEMANAGER_H
@@ -1556,6 +1556,8 @@ void InetLayer::HandleSelectResult(int selectRes, fd_set *readfds, fd_set *write
 #endif // INET_CONFIG_ENABLE_TUN_ENDPOINT
 
         // Now call each active endpoint to handle its pending I/O.
+        SYSTEM_STATS_LATENCY_SCOPE(nl::Weave::System::Stats::kLatency_SocketIODispatch);
+
 #if INET_CONFIG_ENABLE_RAW_ENDPOINT
         for (size_t i = 0; i < RawEndPoint::sPool.Size(); i++)
         {
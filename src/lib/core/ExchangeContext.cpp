@@ -66,6 +66,7 @@ enum {
     kFlagAutoReleaseKey         = 0x0100, /// Automatically release the message encryption key when the exchange context is freed.
     kFlagAutoReleaseConnection  = 0x0200, /// Automatically release the associated WeaveConnection when the exchange context is freed.
     kFlagUseEphemeralUDPPort    = 0x0400, /// When set, use the local ephemeral UDP port as the source port for outbound messages.
+    kFlagAcceptsChainedPayloads = 0x0800, /// When set, received payloads may be delivered as a chain of buffers.
 };
 
 /**
@@ -314,6 +315,32 @@ void ExchangeContext::SetShouldAutoReleaseConnection(bool autoReleaseCon)
     SetFlag(mFlags, static_cast<uint16_t>(kFlagAutoReleaseConnection), autoReleaseCon);
 }
 
+/**
+ * Return whether received messages may be delivered to the application as a
+ * chain of buffers.
+ */
+bool ExchangeContext::AcceptsChainedPayloads() const
+{
+    return GetFlag(mFlags, static_cast<uint16_t>(kFlagAcceptsChainedPayloads));
+}
+
+/**
+ * Set whether received messages may be delivered to the application as a
+ * chain of buffers.
+ *
+ * Messages received over a WeaveConnection are decoded where they lie in the
+ * connection's receive buffers.  By default, a payload spanning several of
+ * those buffers is gathered into one before it is delivered; an application
+ * that walks the chain itself can set this to receive it without the copy.
+ *
+ * @param[in] acceptsChained        True if the application handles payloads
+ *                                  held in a chain of buffers.
+ */
+void ExchangeContext::SetAcceptsChainedPayloads(bool acceptsChained)
+{
+    SetFlag(mFlags, static_cast<uint16_t>(kFlagAcceptsChainedPayloads), acceptsChained);
+}
+
 /**
  * @fn  bool ExchangeContext::UseEphemeralUDPPort(void) const
  *
@@ -671,6 +698,9 @@ exit:
  */
 WEAVE_ERROR ExchangeContext::SendCommonNullMessage(void)
 {
+#if WEAVE_CONFIG_WRMP_MAX_COALESCED_ACKS > 0
+    return SendCommonNullMessage(NULL, 0);
+#else
     WEAVE_ERROR  err     = WEAVE_NO_ERROR;
     PacketBuffer *msgBuf = NULL;
 
@@ -698,8 +728,96 @@ exit:
     }
 
     return err;
+#endif // WEAVE_CONFIG_WRMP_MAX_COALESCED_ACKS > 0
 }
 
+#if WEAVE_CONFIG_WRMP_MAX_COALESCED_ACKS > 0
+/**
+ *  Send a Common::Null message that also acknowledges the pending acks of other exchanges with the same peer.
+ *
+ *  @note  Over WRMP, the message always carries an ack list, even an empty one, which advertises to the peer that we
+ *  understand coalesced acks. Legacy peers ignore the payload of a Common::Null message. The pending ack of each
+ *  coalesced exchange is cleared once the message has been sent.
+ *
+ *  @param[in]    coalescedAcks      The exchanges whose pending ack should be carried along; each one must be able to
+ *                                   share an ack with this exchange.
+ *
+ *  @param[in]    numCoalescedAcks   The number of entries in coalescedAcks.
+ *
+ *  @retval  #WEAVE_ERROR_NO_MEMORY   If no available PacketBuffers.
+ *  @retval  #WEAVE_NO_ERROR          If the method succeeded or the error wasn't critical.
+ *  @retval  other                    Another critical error returned by SendMessage().
+ *
+ */
+WEAVE_ERROR ExchangeContext::SendCommonNullMessage(ExchangeContext * const coalescedAcks[], uint8_t numCoalescedAcks)
+{
+    WEAVE_ERROR  err         = WEAVE_NO_ERROR;
+    PacketBuffer *msgBuf     = NULL;
+    const bool   sendAckList = (mMsgProtocolVersion == kWeaveMessageVersion_V2);
+    uint16_t     msgLen      = 0;
+    uint8_t      *p          = NULL;
+
+    if (sendAckList)
+    {
+        msgLen = WeaveExchangeManager::kWRMPAckListHeaderLength + numCoalescedAcks * WeaveExchangeManager::kWRMPAckListEntryLength;
+    }
+
+    // Allocate a buffer for the null message
+    msgBuf = PacketBuffer::NewWithAvailableSize(msgLen);
+    VerifyOrExit(msgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+    if (sendAckList)
+    {
+        p = msgBuf->Start();
+
+        Write8(p, WeaveExchangeManager::kWRMPAckListVersion);
+        Write8(p, numCoalescedAcks);
+
+        for (uint8_t i = 0; i < numCoalescedAcks; i++)
+        {
+            Write8(p, coalescedAcks[i]->IsInitiator() ? WeaveExchangeManager::kWRMPAckListFlag_FromInitiator : 0);
+            LittleEndian::Write16(p, coalescedAcks[i]->ExchangeId);
+            LittleEndian::Write32(p, coalescedAcks[i]->mPendingPeerAckId);
+        }
+
+        msgBuf->SetDataLength(msgLen);
+    }
+
+    // Send the null message
+    err = SendMessage(nl::Weave::Profiles::kWeaveProfile_Common,
+                      nl::Weave::Profiles::Common::kMsgType_Null, msgBuf,
+                      kSendFlag_NoAutoRequestAck);
+    msgBuf = NULL;
+
+    if (err == WEAVE_NO_ERROR)
+    {
+        for (uint8_t i = 0; i < numCoalescedAcks; i++)
+        {
+#if defined(DEBUG)
+            WeaveLogProgress(ExchangeManager, "Coalesced ack for MsgId:%08" PRIX32 " into solitary ack for MsgId:%08" PRIX32,
+                             coalescedAcks[i]->mPendingPeerAckId, mPendingPeerAckId);
+#endif
+            coalescedAcks[i]->SetAckPending(false);
+        }
+    }
+
+exit:
+    if (WeaveMessageLayer::IsSendErrorNonCritical(err))
+    {
+        WeaveLogError(ExchangeManager, "Non-crit err %ld sending solitary ack",
+                      long(err));
+        err = WEAVE_NO_ERROR;
+    }
+    if (err != WEAVE_NO_ERROR)
+    {
+        WeaveLogError(ExchangeManager, "Failed to send Solitary ack for MsgId:%08" PRIX32 " to Peer %016" PRIX64 ":%ld",
+                      mPendingPeerAckId, PeerNodeId, (long)err);
+    }
+
+    return err;
+}
+#endif // WEAVE_CONFIG_WRMP_MAX_COALESCED_ACKS > 0
+
 /**
  *  Encode the exchange header into a message buffer.
  *
@@ -1214,6 +1332,28 @@ WEAVE_ERROR ExchangeContext::WRMPFlushAcks(void)
     return err;
 }
 
+#if WEAVE_CONFIG_WRMP_MAX_COALESCED_ACKS > 0
+/**
+ *  Determine whether the pending ack of another exchange may be carried in a solitary ack sent on this one, i.e.
+ *  whether both exchanges reach the same peer over the same path and under the same key.
+ */
+bool ExchangeContext::CanShareAckWith(const ExchangeContext *other) const
+{
+    if (other->PeerNodeId != PeerNodeId || other->Con != Con || other->EncryptionType != EncryptionType ||
+        other->KeyId != KeyId || other->mMsgProtocolVersion != mMsgProtocolVersion)
+    {
+        return false;
+    }
+
+    if (Con == NULL)
+    {
+        return (other->PeerAddr == PeerAddr && other->PeerPort == PeerPort && other->PeerIntf == PeerIntf);
+    }
+
+    return true;
+}
+#endif // WEAVE_CONFIG_WRMP_MAX_COALESCED_ACKS > 0
+
 /**
  *  Get the current retransmit timeout. It would be either the initial or
  *  the active retransmit timeout based on whether the ExchangeContext has
@@ -1352,16 +1492,31 @@ exit:
  *
  */
 WEAVE_ERROR ExchangeContext::WRMPHandleRcvdAck(const WeaveExchangeHeader *exchHeader, const WeaveMessageInfo *msgInfo)
+{
+    return WRMPHandleRcvdAck(exchHeader->AckMsgId);
+}
+
+/**
+ *  Process an acknowledgment of the given message, received either in an exchange header or in the ack list of a
+ *  coalesced solitary ack.
+ *
+ *  @param[in]    ackMsgId           The message identifier being acknowledged.
+ *
+ *  @retval  #WEAVE_ERROR_INVALID_ACK_ID                 if the msgId of received Ack is not in the RetransTable.
+ *  @retval  #WEAVE_NO_ERROR                             if the context was removed.
+ *
+ */
+WEAVE_ERROR ExchangeContext::WRMPHandleRcvdAck(uint32_t ackMsgId)
 {
     void         *msgCtxt  = NULL;
     WEAVE_ERROR  err     = WEAVE_NO_ERROR;
 
     //Msg is an Ack; Check Retrans Table and remove message context
-    if (!WRMPCheckAndRemRetransTable(exchHeader->AckMsgId, &msgCtxt))
+    if (!WRMPCheckAndRemRetransTable(ackMsgId, &msgCtxt))
     {
 #if defined(DEBUG)
         WeaveLogError(ExchangeManager, "Weave MsgId:%08" PRIX32" not in RetransTable",
-                      exchHeader->AckMsgId);
+                      ackMsgId);
 #endif
         err = WEAVE_ERROR_INVALID_ACK_ID;
         //Optionally call an application callback with this error.
@@ -1380,7 +1535,7 @@ WEAVE_ERROR ExchangeContext::WRMPHandleRcvdAck(const WeaveExchangeHeader *exchHe
         }
 #if defined(DEBUG)
         WeaveLogProgress(ExchangeManager, "Removed Weave MsgId:%08" PRIX32 " from RetransTable",
-                         exchHeader->AckMsgId);
+                         ackMsgId);
 #endif
     }
 
@@ -1605,15 +1760,31 @@ WEAVE_ERROR ExchangeContext::HandleMessage(WeaveMessageInfo *msgInfo, const Weav
         // is implicitly that response.
         SetResponseExpected(false);
 
+        // Gather a payload held in a chain of buffers unless the application handles the chain itself.  If that
+        // fails, drop the message rather than the connection it arrived on.
+        if (msgBuf->Next() != NULL && !AcceptsChainedPayloads())
+        {
+            err = WeaveMessageLayer::CoalescePayload(msgBuf);
+            if (err != WEAVE_NO_ERROR)
+            {
+                WeaveLogError(ExchangeManager, "Dropping Msg(MsgId:%08" PRIX32 "): %ld", msgInfo->MessageId, (long)err);
+                ExitNow();
+            }
+        }
+
         // Deliver the message to the app via its callback.
         if (umhandler)
         {
+            SYSTEM_STATS_LATENCY_SCOPE(nl::Weave::System::Stats::kLatency_HandlerExecution);
+
             umhandler(this, msgInfo->InPacketInfo, const_cast<WeaveMessageInfo *>(msgInfo), exchHeader->ProfileId,
                     exchHeader->MessageType, msgBuf);
             msgBuf = NULL;
         }
         else if (OnMessageReceived != NULL)
         {
+            SYSTEM_STATS_LATENCY_SCOPE(nl::Weave::System::Stats::kLatency_HandlerExecution);
+
             OnMessageReceived(this, msgInfo->InPacketInfo, const_cast<WeaveMessageInfo *>(msgInfo), exchHeader->ProfileId,
                               exchHeader->MessageType, msgBuf);
             msgBuf = NULL;
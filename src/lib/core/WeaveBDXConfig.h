@@ -145,6 +145,96 @@
 #define WEAVE_CONFIG_BDX_SEND_INIT_MAX_METADATA_BYTES 64
 #endif // WEAVE_CONFIG_BDX_SEND_INIT_MAX_METADATA_BYTES
 
+/**
+ *  @def WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE
+ *
+ *  @brief
+ *      Maximum number of blocks a V1 transfer may have outstanding at once.
+ *
+ *  A value greater than 1 compiles support for windowed transfers, in which
+ *      the driver keeps up to this many BlockSend or BlockQuery messages in
+ *      flight instead of waiting one round trip per block.  An initiator
+ *      whose transfer's mWindowSize is set above 1 proposes it in a TLV
+ *      element appended to the metadata of its init message, and the
+ *      responder may lower it in its accept.  A responder that doesn't
+ *      support windowed transfers sees the proposal as one more metadata
+ *      element and accepts a lock-step transfer.
+ *
+ *  Windowed transfers rely on the transport to deliver every block, so they
+ *      are only used over TCP or WRMP.  Blocks that arrive out of order are
+ *      held by the receiver until the missing ones arrive, so a lost block is
+ *      resent on its own by WRMP rather than with the rest of the window.
+ *
+ *  Defaults to 1 (lock-step transfers only).
+ */
+#ifndef WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE
+#define WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE 1
+#endif // WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE
+
+#if (WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE < 1) || (WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 255)
+#error "WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE must be between 1 and 255"
+#endif // (WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE < 1) || (WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 255)
+
+/**
+ *  @def WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT
+ *
+ *  @brief
+ *      Compile support for hashing received blocks as they arrive.
+ *
+ *  When enabled, a receiver can ask a transfer to compute a SHA-256 hash
+ *      over the blocks it delivers to the PutBlockHandler, in order, so the
+ *      integrity of a downloaded image can be checked without reading it
+ *      back from storage.  Disabled by default.
+ */
+#ifndef WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT
+#define WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT 0
+#endif // WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT
+
+/**
+ *  @def WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+ *
+ *  @brief
+ *      Compile support for checkpointing and resuming transfers.
+ *
+ *  When enabled, a transfer tracks how many bytes past its start offset the
+ *      receiver is known to hold and periodically hands the application an
+ *      opaque checkpoint (peer, file designator, verified offset and, when
+ *      streaming hash support is enabled, how much of the data before that
+ *      offset the running hash covers) through
+ *      its CheckpointHandler.  The application persists the checkpoint and,
+ *      after the transfer is interrupted, restores it into a new transfer
+ *      with BDXTransfer::ResumeFromCheckpoint(), which sets the start offset
+ *      carried in the SendInit or ReceiveInit.  Disabled by default.
+ */
+#ifndef WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+#define WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT 0
+#endif // WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+
+/**
+ *  @def WEAVE_CONFIG_BDX_CHECKPOINT_INTERVAL
+ *
+ *  @brief
+ *      Number of verified bytes between two checkpoints of a transfer.
+ *
+ *  Smaller values lose less data when a transfer is interrupted at the cost
+ *      of more frequent writes to persistent storage.
+ */
+#ifndef WEAVE_CONFIG_BDX_CHECKPOINT_INTERVAL
+#define WEAVE_CONFIG_BDX_CHECKPOINT_INTERVAL 16384
+#endif // WEAVE_CONFIG_BDX_CHECKPOINT_INTERVAL
+
+/**
+ *  @def WEAVE_CONFIG_BDX_CHECKPOINT_MAX_FILE_DESIGNATOR_LENGTH
+ *
+ *  @brief
+ *      Longest file designator that can be recorded in a checkpoint.
+ *
+ *  Transfers with longer file designators are not checkpointed.
+ */
+#ifndef WEAVE_CONFIG_BDX_CHECKPOINT_MAX_FILE_DESIGNATOR_LENGTH
+#define WEAVE_CONFIG_BDX_CHECKPOINT_MAX_FILE_DESIGNATOR_LENGTH 128
+#endif // WEAVE_CONFIG_BDX_CHECKPOINT_MAX_FILE_DESIGNATOR_LENGTH
+
 
 #if (WEAVE_CONFIG_BDX_CLIENT_SEND_SUPPORT == 0) && (WEAVE_CONFIG_BDX_CLIENT_RECEIVE_SUPPORT == 0)
 #error "At least one of WEAVE_CONFIG_BDX_CLIENT_SEND_SUPPORT or WEAVE_CONFIG_BDX_CLIENT_RECEIVE_SUPPORT must be enabled"
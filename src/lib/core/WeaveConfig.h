@@ -716,6 +716,30 @@
 #define WEAVE_CONFIG_DEV_RANDOM_DEVICE_NAME                 "/dev/urandom"
 #endif // WEAVE_CONFIG_DEV_RANDOM_DEVICE_NAME
 
+/**
+ *  @def WEAVE_CONFIG_DRBG_OUTPUT_BUFFER_SIZE
+ *
+ *  @brief
+ *    The size, in bytes, of a buffer of random data generated ahead of time
+ *    by the DRBG, from which small requests are served.
+ *
+ *    Each DRBG generate request ends with an update of the DRBG state, and
+ *    every #WEAVE_CONFIG_DRBG_RESEED_INTERVAL requests with a reseed from the
+ *    entropy source.  Filling a buffer spreads that cost over many small requests,
+ *    such as those for message ids, exchange ids and nonces.  The bytes served
+ *    from the buffer are erased from it, and the whole buffer is discarded
+ *    when the DRBG is reseeded or uninstantiated.
+ *
+ *    Requests larger than the buffer are served directly by the DRBG.
+ *    Set to 0 to disable the buffer.
+ *
+ *  @note Only meaningful when #WEAVE_CONFIG_RNG_IMPLEMENTATION_NESTDRBG is enabled.
+ *
+ */
+#ifndef WEAVE_CONFIG_DRBG_OUTPUT_BUFFER_SIZE
+#define WEAVE_CONFIG_DRBG_OUTPUT_BUFFER_SIZE                0
+#endif // WEAVE_CONFIG_DRBG_OUTPUT_BUFFER_SIZE
+
 
 
 /**
@@ -2242,6 +2266,34 @@
 #define WEAVE_CONFIG_PERSISTED_COUNTER_DEBUG_LOGGING 0
 #endif
 
+/**
+ * @def WEAVE_CONFIG_PERSISTED_STORAGE_BATCH_MAX_KEYS
+ *
+ * @brief
+ *   The maximum number of distinct keys a PersistedStorageBatch can
+ *   hold staged values for, which is also the maximum number of
+ *   PersistedCounters that can share one batch.
+ */
+#ifndef WEAVE_CONFIG_PERSISTED_STORAGE_BATCH_MAX_KEYS
+#define WEAVE_CONFIG_PERSISTED_STORAGE_BATCH_MAX_KEYS 4
+#endif
+
+/**
+ * @def WEAVE_CONFIG_PERSISTED_STORAGE_BATCH_WRITE
+ *
+ * @brief
+ *   Enable (1) or disable (0) use of the platform's
+ *   nl::Weave::Platform::PersistedStorage::WriteBatch() function.
+ *
+ *   When enabled, a PersistedStorageBatch writes all of its staged
+ *   values in one call, which platforms can implement as a single
+ *   storage transaction.  When disabled, the staged values are written
+ *   one at a time with nl::Weave::Platform::PersistedStorage::Write().
+ */
+#ifndef WEAVE_CONFIG_PERSISTED_STORAGE_BATCH_WRITE
+#define WEAVE_CONFIG_PERSISTED_STORAGE_BATCH_WRITE 0
+#endif
+
 /**
  * @def WEAVE_CONFIG_EVENT_LOGGING_VERBOSE_DEBUG_LOGS
  *
@@ -1378,6 +1378,7 @@ void WeaveConnection::HandleDataReceived(TCPEndPoint *endPoint, PacketBuffer *da
     WEAVE_ERROR err;
     WeaveConnection *con = (WeaveConnection *) endPoint->AppState;
     WeaveMessageLayer *msgLayer = con->MessageLayer;
+    const MessageReceiveFunct exchangeMgrHandler = WeaveExchangeManager::HandleMessageReceived;
 
     // While in a state that allows receiving, process the received data...
     while (data != NULL &&
@@ -1391,8 +1392,6 @@ void WeaveConnection::HandleDataReceived(TCPEndPoint *endPoint, PacketBuffer *da
     {
         IPPacketInfo        packetInfo;
         WeaveMessageInfo    msgInfo;
-        uint8_t*            payload;
-        uint16_t            payloadLen;
         PacketBuffer*       payloadBuf = NULL;
         uint32_t            frameLen;
 
@@ -1403,66 +1402,18 @@ void WeaveConnection::HandleDataReceived(TCPEndPoint *endPoint, PacketBuffer *da
         msgInfo.InPacketInfo = &packetInfo;
         msgInfo.InCon = con;
 
-        // Attempt to parse an message from the head of the received queue.
-        err = msgLayer->DecodeMessageWithLength(data, con->PeerNodeId, con, &msgInfo, &payload, &payloadLen, &frameLen);
+        // Attempt to parse a message from the head of the received queue.  The message may span any number of
+        // buffers in the queue; it is decrypted and authenticated where it lies, and its payload is detached from
+        // the queue as a chain of buffers, leaving the queue holding whatever data follows the message.
+        err = msgLayer->DecodeMessageWithLength(data, con->PeerNodeId, con, &msgInfo, payloadBuf, &frameLen);
 
-        // If the initial buffer in the receive queue is not big enough to hold the entirety of
-        // the incoming message...
-        if (err == WEAVE_ERROR_MESSAGE_TOO_LONG)
-        {
-            // The Weave message decoding logic expects message data to be in contiguous memory.
-            // Therefore, if the packet buffer containing the initial portion of the message is
-            // not big enough to hold the entirety of the message, the data must be moved into
-            // a new buffer that is big enough.
-            //
-            // This situation can arise, for example, when when a TCP segment arrives containing
-            // part of a Weave message and the underlying network interface chooses to place the
-            // packet into a buffer that is smaller than the Weave message.
-            //
-            // Note that the logic here implies that when a system runs low on buffers, message
-            // reception can fail for lack of an appropriately sized buffer, resulting in the TCP
-            // connection being aborted.  The only way to avoid this is for the underlying network
-            // interface to always place packets into buffers that are big enough to hold the
-            // maximum size Weave message. If such a buffer is not available when a packet comes
-            // in, the network interface can simply discard the packet, resulting in the peer
-            // retransmitting it and the system recovering gracefully once the buffer pressure
-            // subsides.
-
-            // Attempt to allocate a buffer big enough to hold the entire message.  Fail with
-            // WEAVE_ERROR_MESSAGE_TOO_LONG if no such buffer is available.
-            PacketBuffer * newBuf = PacketBuffer::NewWithAvailableSize(0, frameLen);
-            if (newBuf == NULL)
-            {
-                break;
-            }
-
-            // Prepend the new buffer to the receive queue and copy the received message data into
-            // the new buffer, discarding the original buffer(s).
-            newBuf->AddToEnd(data);
-            data = newBuf;
-            data->CompactHead();
-
-            // Try again to decode the message.
-            continue;
-        }
-
-        // If the initial buffer in the receive queue contains only part of the next message...
+        // If the received queue contains only part of the next message, we must wait for more data from the peer...
         if (err == WEAVE_ERROR_MESSAGE_INCOMPLETE)
         {
-            // If there are more buffers in the queue, move as much data as possible into the head buffer
-            // and try again.
-            if (data->Next() != NULL)
-            {
-                data->CompactHead();
-                continue;
-            }
-
-            // Otherwise, we must wait for more data from the peer...
-
             // Open the receive window just enough to allow the remainder of the message to be received.
             // This is necessary in the case where the message size exceeds the TCP window size to ensure
             // the peer has enough window to send us the entire message.
-            uint16_t neededLen = frameLen - data->DataLength();
+            uint16_t neededLen = frameLen - data->TotalLength();
             err = endPoint->AckReceive(neededLen);
             if (err == WEAVE_NO_ERROR)
                 break;
@@ -1479,41 +1430,24 @@ void WeaveConnection::HandleDataReceived(TCPEndPoint *endPoint, PacketBuffer *da
                 err = WEAVE_ERROR_INVALID_DESTINATION_NODE_ID;
         }
 
-        if (err == WEAVE_NO_ERROR)
-        {
-            // If there's no more data in the current buffer beyond the message that was just parsed,
-            // then avoid a copy by giving the buffer to the application layer.
-            if (data->DataLength() == 0)
-            {
-                // Detach the buffer from the data queue.
-                payloadBuf = data;
-                data = data->DetachTail();
-
-                // Adjust the buffer to point at the payload of the message.
-                payloadBuf->SetStart(payload);
-                payloadBuf->SetDataLength(payloadLen);
-            }
-
-            // Otherwise we need to keep the buffer so we can parse the remaining data, so copy the
-            // payload data into a new buffer and arrange to pass the new buffer to the application.
-            else
-            {
-                payloadBuf = PacketBuffer::New(0);
-                if (payloadBuf != NULL)
-                {
-                    memcpy(payloadBuf->Start(), payload, payloadLen);
-                    payloadBuf->SetDataLength(payloadLen);
-                }
-                else
-                    err = WEAVE_ERROR_NO_MEMORY;
-            }
-        }
+        // The message was authenticated and decrypted where it lay, possibly across several receive buffers.  The
+        // exchange manager accepts its payload as a chain of buffers and gathers it only for the exchanges that need
+        // it contiguous; gather it here for tunnels and other raw users of the connection, which expect contiguous data.
+        if (err == WEAVE_NO_ERROR && payloadBuf->Next() != NULL &&
+            ((msgInfo.Flags & kWeaveMessageFlag_TunneledData) != 0 || con->OnMessageReceived != exchangeMgrHandler))
+            err = WeaveMessageLayer::CoalescePayload(payloadBuf);
 
         // Disconnect if an error occurred.
         if (err != WEAVE_NO_ERROR)
         {
             WeaveLogError(MessageLayer, "Con rcv data err %04X %ld", con->LogId(), err);
 
+            if (payloadBuf != NULL)
+            {
+                PacketBuffer::Free(payloadBuf);
+                payloadBuf = NULL;
+            }
+
             // Send key error response to the peer if required.
             if (msgLayer->SecurityMgr->IsKeyError(err))
             {
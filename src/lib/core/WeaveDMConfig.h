@@ -403,6 +403,25 @@
 #define WDM_PUBLISHER_MAX_ITEMS_IN_TRAIT_DIRTY_STORE  10
 #endif
 
+/**
+ *  @def WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE
+ *
+ *  @brief
+ *    Determines the number of changed property handles each trait data source remembers, along with the data version
+ *    they were changed on top of. When the intermediate solver would otherwise fall back to sending a whole trait
+ *    instance (on a resubscribe, or when the dirty store overflows), it uses this journal to send only the paths that
+ *    changed since the version the subscriber last acknowledged, as long as the journal still covers that version.
+ *
+ *    Costs 12 bytes per entry per trait data source. Setting this to 0 disables the journal.
+ */
+#ifndef WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE
+#define WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE 0
+#endif
+
+#if WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE > 255
+#error "WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE must not exceed 255"
+#endif
+
 /**
  *  @def WDM_PUBLISHER_INTERMEDIATE_SOLVER_MAX_MERGE_HANDLE_SET
  *
@@ -428,6 +447,48 @@
 #define WDM_UPDATE_MAX_ITEMS_IN_TRAIT_DIRTY_PATH_STORE  10
 #endif
 
+/**
+ *  @def WDM_TRAIT_PATH_STORE_MAX_ITEMS
+ *
+ *  @brief
+ *    The largest number of items any TraitPathStore of the build may be initialized with. Stores of up to 254
+ *    items index their Records with bytes; a larger value switches every TraitPathStore to 16-bit indices, which
+ *    add four bytes to each Record. Defaults to 254, or to #WDM_UPDATE_MAX_ITEMS_IN_TRAIT_DIRTY_PATH_STORE when
+ *    the update path stores are larger.
+ */
+#ifndef WDM_TRAIT_PATH_STORE_MAX_ITEMS
+#if WDM_UPDATE_MAX_ITEMS_IN_TRAIT_DIRTY_PATH_STORE > 254
+#define WDM_TRAIT_PATH_STORE_MAX_ITEMS WDM_UPDATE_MAX_ITEMS_IN_TRAIT_DIRTY_PATH_STORE
+#else
+#define WDM_TRAIT_PATH_STORE_MAX_ITEMS 254
+#endif
+#endif
+
+#if WDM_TRAIT_PATH_STORE_MAX_ITEMS > 65534
+#error "WDM_TRAIT_PATH_STORE_MAX_ITEMS must be at most 65534"
+#endif
+
+#if WDM_UPDATE_MAX_ITEMS_IN_TRAIT_DIRTY_PATH_STORE > WDM_TRAIT_PATH_STORE_MAX_ITEMS
+#error "WDM_UPDATE_MAX_ITEMS_IN_TRAIT_DIRTY_PATH_STORE must not exceed WDM_TRAIT_PATH_STORE_MAX_ITEMS"
+#endif
+
+/**
+ *  @def WDM_CLIENT_MAX_UPDATE_WINDOW_SIZE
+ *
+ *  @brief
+ *    The largest update window a SubscriptionClient may be configured with through
+ *    SubscriptionClient::SetUpdateWindowSize(). A window larger than 1 lets the client keep several
+ *    UpdateRequests outstanding, each on its own exchange, instead of waiting for the StatusReport of one
+ *    update before dispatching the next. Updates to the same trait instance are still sent one at a time.
+ *
+ *    Each slot of the window carries its own in-progress path list of #WDM_UPDATE_MAX_ITEMS_IN_TRAIT_DIRTY_PATH_STORE
+ *    items and its own UpdateClient.
+ *
+ */
+#ifndef WDM_CLIENT_MAX_UPDATE_WINDOW_SIZE
+#define WDM_CLIENT_MAX_UPDATE_WINDOW_SIZE 1
+#endif
+
 /**
  *  @def WDM_PUBLISHER_MAX_NOTIFIES_IN_FLIGHT
  *
@@ -441,6 +502,53 @@
 #define WDM_PUBLISHER_MAX_NOTIFIES_IN_FLIGHT 4
 #endif
 
+/**
+ *  @def WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE
+ *
+ *  @brief
+ *    The largest notify window a single established subscription may be configured with through
+ *    SubscriptionHandler::SetNotifyWindowSize(). A window larger than 1 lets the publisher pipeline NotifyRequests, each on its
+ *    own exchange, instead of waiting for the StatusReport of one notify before building the next. This mainly helps on
+ *    high-latency paths such as the service tunnel. Notifies sent while the subscription is being primed are never pipelined.
+ *    The total number of notifies in flight is still bounded by #WDM_PUBLISHER_MAX_NOTIFIES_IN_FLIGHT.
+ *
+ *    Setting this to 1 compiles out the windowed notify support.
+ *
+ */
+#ifndef WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE
+#define WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE 1
+#endif
+
+/**
+ *  @def WDM_PUBLISHER_NOTIFY_ENCODE_CACHE_SIZE
+ *
+ *  @brief
+ *    Size in bytes of the notification engine's encode-once cache. Within a single run of the engine, data elements encoded
+ *    for one subscriber are kept in this buffer and spliced into the notifies of other subscribers that need the same trait
+ *    instance at the same data and schema version, instead of re-reading and re-encoding the trait data. The cache is
+ *    emptied whenever trait data is marked dirty. Set to 0 to disable the cache (the default, since it costs RAM that most
+ *    single-subscriber devices would never use).
+ *
+ */
+#ifndef WDM_PUBLISHER_NOTIFY_ENCODE_CACHE_SIZE
+#define WDM_PUBLISHER_NOTIFY_ENCODE_CACHE_SIZE 0
+#endif
+#if WDM_PUBLISHER_NOTIFY_ENCODE_CACHE_SIZE > 65535
+#error "WDM_PUBLISHER_NOTIFY_ENCODE_CACHE_SIZE must not exceed 65535"
+#endif
+
+/**
+ *  @def WDM_PUBLISHER_NOTIFY_ENCODE_CACHE_MAX_ENTRIES
+ *
+ *  @brief
+ *    Maximum number of data elements that can be held in the encode-once cache at any time. Only meaningful when
+ *    #WDM_PUBLISHER_NOTIFY_ENCODE_CACHE_SIZE is non-zero.
+ *
+ */
+#ifndef WDM_PUBLISHER_NOTIFY_ENCODE_CACHE_MAX_ENTRIES
+#define WDM_PUBLISHER_NOTIFY_ENCODE_CACHE_MAX_ENTRIES 16
+#endif
+
 /**
  * The auto-generated schema tables key off this define to enable/disable certain fields in the tables. Enable this for now, but remove this define
  * once it has been similarly removed from the auto-generated code since all products are expected to need dictionary support, so the savings in flash/ram
@@ -60,6 +60,19 @@
 #define WEAVE_CONFIG_EVENT_LOGGING_BDX_OFFLOAD 0
 #endif /* WEAVE_CONFIG_EVENT_LOGGING_BDX_OFFLOAD */
 
+/**
+ *  @def WEAVE_CONFIG_EVENT_LOGGING_BDX_WINDOW_SIZE
+ *
+ *  @brief
+ *    Number of blocks to keep outstanding when offloading logs over BDX
+ *
+ *   Values above 1 are only used if the BDX endpoint supports windowed
+ *   transfers and WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE allows them.
+ */
+#ifndef WEAVE_CONFIG_EVENT_LOGGING_BDX_WINDOW_SIZE
+#define WEAVE_CONFIG_EVENT_LOGGING_BDX_WINDOW_SIZE 1
+#endif /* WEAVE_CONFIG_EVENT_LOGGING_BDX_WINDOW_SIZE */
+
 /**
  *  @def WEAVE_CONFIG_EVENT_LOGGING_WDM_OFFLOAD
  *
@@ -106,6 +106,11 @@ WEAVE_ERROR WeaveExchangeManager::Init(WeaveMessageLayer *msgLayer)
     mWRMPTimeStampBase = System::Timer::GetCurrentEpoch();
 
     mWRMPCurrentTimerExpiry = 0;
+
+#if WEAVE_CONFIG_WRMP_MAX_COALESCED_ACKS > 0
+    mWRMPNumCoalescedAckPeers = 0;
+    mWRMPNextCoalescedAckPeer = 0;
+#endif
 #endif
 
     State = kState_Initialized;
@@ -644,11 +649,31 @@ void WeaveExchangeManager::DispatchMessage(WeaveMessageInfo *msgInfo, PacketBuff
     bool peerGroupMsgIdNotSynchronized;
 #endif
     WEAVE_ERROR  err                       = WEAVE_NO_ERROR;
+    enum { kMaxExchangeHeaderLength = 12 }; // Version/Flags + Msg Type + Exch Id + Profile Id + Ack Id
+
+    SYSTEM_STATS_LATENCY_SCOPE(nl::Weave::System::Stats::kLatency_ExchangeDispatch);
+
+    // A message received over a connection may be held in a chain of buffers.  Make sure its exchange header lies
+    // in the first one.
+    if (msgBuf->Next() != NULL)
+    {
+        msgBuf->PullUpHead(msgBuf->TotalLength() < kMaxExchangeHeaderLength ? msgBuf->TotalLength() : kMaxExchangeHeaderLength);
+    }
 
     // Decode the exchange header.
     err = DecodeHeader(&exchangeHeader, msgInfo, msgBuf);
     SuccessOrExit(err);
 
+    // The exchange and security layers read the payloads of Common and Security profile messages in place, so gather
+    // those into one buffer.  Other payloads stay chained until the exchange that handles them is known.
+    if (msgBuf->Next() != NULL &&
+        (exchangeHeader.ProfileId == nl::Weave::Profiles::kWeaveProfile_Common ||
+         exchangeHeader.ProfileId == nl::Weave::Profiles::kWeaveProfile_Security))
+    {
+        err = WeaveMessageLayer::CoalescePayload(msgBuf);
+        SuccessOrExit(err);
+    }
+
     //Check if the version is supported
     if ((msgInfo->MessageVersion != kWeaveMessageVersion_V1) &&
         (msgInfo->MessageVersion != kWeaveMessageVersion_V2))
@@ -666,7 +691,7 @@ void WeaveExchangeManager::DispatchMessage(WeaveMessageInfo *msgInfo, PacketBuff
 
     WeaveLogRetain(ExchangeManager, "Msg %s %08" PRIX32 ":%d %d %016" PRIX64 " %04" PRIX16 " %04" PRIX16 " %ld MsgId:%08" PRIX32,
                    "rcvd", exchangeHeader.ProfileId, exchangeHeader.MessageType,
-                   (int)msgBuf->DataLength(), msgInfo->SourceNodeId, msgCon->LogId(), exchangeHeader.ExchangeId,
+                   (int)msgBuf->TotalLength(), msgInfo->SourceNodeId, msgCon->LogId(), exchangeHeader.ExchangeId,
                    (long)err, msgInfo->MessageId);
 
 #if WEAVE_CONFIG_USE_APP_GROUP_KEYS_FOR_MSG_ENC
@@ -723,6 +748,23 @@ void WeaveExchangeManager::DispatchMessage(WeaveMessageInfo *msgInfo, PacketBuff
         //Return after processing Delayed Delivery message
         ExitNow(err = WEAVE_NO_ERROR);
     }//If delayed delivery Msg
+
+#if WEAVE_CONFIG_WRMP_MAX_COALESCED_ACKS > 0
+    //Received solitary ack carrying acks for other exchanges: process those here, the ack in the exchange
+    //header is handled by the matching exchange below as usual
+    if (exchangeHeader.ProfileId == nl::Weave::Profiles::kWeaveProfile_Common &&
+        exchangeHeader.MessageType == nl::Weave::Profiles::Common::kMsgType_Null &&
+        msgInfo->MessageVersion == kWeaveMessageVersion_V2 && msgBuf->DataLength() > 0 &&
+        (msgInfo->Flags & kWeaveMessageFlag_DuplicateMessage) == 0)
+    {
+        err = WRMPProcessAckList(msgCon, msgInfo, msgBuf);
+        if (err != WEAVE_NO_ERROR)
+        {
+            WeaveLogError(ExchangeManager, "Ignoring ack list from %016" PRIX64 ": %s", msgInfo->SourceNodeId, ErrorStr(err));
+            err = WEAVE_NO_ERROR;
+        }
+    }
+#endif
 #endif
 
     // Search for an existing exchange that the message applies to. If a match is found...
@@ -1292,8 +1334,16 @@ void WeaveExchangeManager::WRMPExecuteActions(void)
 #if defined(WRMP_TICKLESS_DEBUG)
                 WeaveLogProgress(ExchangeManager, "WRMPExecuteActions sending ACK");
 #endif
+#if WEAVE_CONFIG_WRMP_MAX_COALESCED_ACKS > 0
+                //Send the Ack in a Common::Null message, along with any other acks pending for the same peer
+                ExchangeContext *coalescedAcks[WEAVE_CONFIG_WRMP_MAX_COALESCED_ACKS];
+                uint8_t numCoalescedAcks = WRMPGatherCoalescedAcks(ec, coalescedAcks);
+
+                ec->SendCommonNullMessage(coalescedAcks, numCoalescedAcks);
+#else
                 //Send the Ack in a Common::Null message
                 ec->SendCommonNullMessage();
+#endif
                 ec->SetAckPending(false);
             }
         }
@@ -1356,6 +1406,130 @@ void WeaveExchangeManager::WRMPExecuteActions(void)
     TicklessDebugDumpRetransTable("WRMPExecuteActions Dumping RetransTable entries after processing");
 }
 
+#if WEAVE_CONFIG_WRMP_MAX_COALESCED_ACKS > 0
+/**
+ *  Collect the other exchanges whose pending ack can ride along in the solitary ack about to be sent on the given
+ *  exchange. Acks that are not due yet are included too; sending them early only saves the peer a retransmission.
+ *
+ *  @param[in]   ec             The exchange sending the solitary ack.
+ *
+ *  @param[out]  coalescedAcks  An array of WEAVE_CONFIG_WRMP_MAX_COALESCED_ACKS entries that receives the exchanges.
+ *
+ *  @return the number of exchanges collected; always 0 if the peer is not known to understand coalesced acks.
+ */
+uint8_t WeaveExchangeManager::WRMPGatherCoalescedAcks(ExchangeContext *ec, ExchangeContext *coalescedAcks[])
+{
+    ExchangeContext *other = (ExchangeContext *)ContextPool;
+    uint8_t count          = 0;
+
+    if (ec->mMsgProtocolVersion != kWeaveMessageVersion_V2 || !WRMPIsCoalescedAckPeer(ec->PeerNodeId))
+    {
+        return 0;
+    }
+
+    for (int i = 0; i < WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS && count < WEAVE_CONFIG_WRMP_MAX_COALESCED_ACKS; i++, other++)
+    {
+        if (other != ec && other->ExchangeMgr != NULL && other->IsAckPending() && ec->CanShareAckWith(other))
+        {
+            coalescedAcks[count++] = other;
+        }
+    }
+
+    return count;
+}
+
+/**
+ *  Process the ack list carried by a solitary ack, acknowledging messages on other exchanges with the sender.
+ *
+ *  Only exchanges reached over the same connection and under the same key as the solitary ack itself are considered,
+ *  so that an ack list cannot acknowledge traffic it could not have authenticated.
+ *
+ *  @param[in]   msgCon         The connection the solitary ack arrived on, or NULL for UDP.
+ *
+ *  @param[in]   msgInfo        The message information of the solitary ack.
+ *
+ *  @param[in]   msgBuf         The payload of the solitary ack.
+ *
+ *  @retval  #WEAVE_ERROR_INVALID_MESSAGE_LENGTH      If the ack list is truncated.
+ *  @retval  #WEAVE_ERROR_UNSUPPORTED_MESSAGE_VERSION If the ack list format is not understood.
+ *  @retval  #WEAVE_NO_ERROR                          On success, whether or not any listed message was awaiting an ack.
+ */
+WEAVE_ERROR WeaveExchangeManager::WRMPProcessAckList(WeaveConnection *msgCon, const WeaveMessageInfo *msgInfo,
+                                                    const PacketBuffer *msgBuf)
+{
+    WEAVE_ERROR err  = WEAVE_NO_ERROR;
+    const uint8_t *p = msgBuf->Start();
+    uint16_t len     = msgBuf->DataLength();
+    uint8_t count;
+
+    VerifyOrExit(len >= kWRMPAckListHeaderLength, err = WEAVE_ERROR_INVALID_MESSAGE_LENGTH);
+
+    // Future versions are expected to remain a superset of this one
+    VerifyOrExit(Read8(p) >= kWRMPAckListVersion, err = WEAVE_ERROR_UNSUPPORTED_MESSAGE_VERSION);
+    count = Read8(p);
+    VerifyOrExit(len >= kWRMPAckListHeaderLength + count * kWRMPAckListEntryLength, err = WEAVE_ERROR_INVALID_MESSAGE_LENGTH);
+
+    WRMPAddCoalescedAckPeer(msgInfo->SourceNodeId);
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        const bool fromInitiator = (Read8(p) & kWRMPAckListFlag_FromInitiator) != 0;
+        const uint16_t exchangeId = LittleEndian::Read16(p);
+        const uint32_t ackMsgId = LittleEndian::Read32(p);
+        ExchangeContext *ec = (ExchangeContext *)ContextPool;
+
+        for (int j = 0; j < WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS; j++, ec++)
+        {
+            if (ec->ExchangeMgr != NULL && ec->ExchangeId == exchangeId && ec->IsInitiator() != fromInitiator &&
+                ec->PeerNodeId == msgInfo->SourceNodeId && ec->Con == msgCon && ec->EncryptionType == msgInfo->EncryptionType &&
+                ec->KeyId == msgInfo->KeyId)
+            {
+                // Guard against the exchange being closed from the ack callback
+                ec->AddRef();
+                ec->WRMPHandleRcvdAck(ackMsgId);
+                ec->Release();
+                break;
+            }
+        }
+    }
+
+exit:
+    return err;
+}
+
+bool WeaveExchangeManager::WRMPIsCoalescedAckPeer(uint64_t peerNodeId) const
+{
+    for (uint8_t i = 0; i < mWRMPNumCoalescedAckPeers; i++)
+    {
+        if (mWRMPCoalescedAckPeers[i] == peerNodeId)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void WeaveExchangeManager::WRMPAddCoalescedAckPeer(uint64_t peerNodeId)
+{
+    if (WRMPIsCoalescedAckPeer(peerNodeId))
+    {
+        return;
+    }
+
+    if (mWRMPNumCoalescedAckPeers < WEAVE_CONFIG_WRMP_COALESCED_ACK_PEER_TABLE_SIZE)
+    {
+        mWRMPCoalescedAckPeers[mWRMPNumCoalescedAckPeers++] = peerNodeId;
+    }
+    else
+    {
+        // Replace the oldest entry
+        mWRMPCoalescedAckPeers[mWRMPNextCoalescedAckPeer] = peerNodeId;
+        mWRMPNextCoalescedAckPeer = (mWRMPNextCoalescedAckPeer + 1) % WEAVE_CONFIG_WRMP_COALESCED_ACK_PEER_TABLE_SIZE;
+    }
+}
+#endif // WEAVE_CONFIG_WRMP_MAX_COALESCED_ACKS > 0
+
 /**
 * Calculate number of virtual WRMP ticks that have expired since we last
 * called this function. Iterate through active exchange contexts and
@@ -187,6 +187,8 @@ public:
     void SetAutoReleaseKey(bool autoReleaseKey);
     bool ShouldAutoReleaseConnection() const;
     void SetShouldAutoReleaseConnection(bool autoReleaseCon);
+    bool AcceptsChainedPayloads() const;
+    void SetAcceptsChainedPayloads(bool acceptsChained);
     bool UseEphemeralUDPPort(void) const;
 #if WEAVE_CONFIG_ENABLE_EPHEMERAL_UDP_PORT
     void SetUseEphemeralUDPPort(bool val);
@@ -378,8 +380,13 @@ private:
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
     bool WRMPCheckAndRemRetransTable(uint32_t msgId, void **rCtxt);
     WEAVE_ERROR WRMPHandleRcvdAck(const WeaveExchangeHeader *exchHeader, const WeaveMessageInfo *msgInfo);
+    WEAVE_ERROR WRMPHandleRcvdAck(uint32_t ackMsgId);
     WEAVE_ERROR WRMPHandleNeedsAck(const WeaveMessageInfo *msgInfo);
     WEAVE_ERROR HandleThrottleFlow(uint32_t PauseTimeMillis);
+#if WEAVE_CONFIG_WRMP_MAX_COALESCED_ACKS > 0
+    WEAVE_ERROR SendCommonNullMessage(ExchangeContext * const coalescedAcks[], uint8_t numCoalescedAcks);
+    bool CanShareAckWith(const ExchangeContext *other) const;
+#endif
 #endif
 
     uint8_t mRefCount;
@@ -402,6 +409,7 @@ class NL_DLL_EXPORT WeaveExchangeManager
     friend class WeaveConnection;
     friend class WeaveSecurityManager;
     friend class WeaveFabricState;
+    friend class WeaveMessageLayerTestObject;
 
 public:
     enum State
@@ -485,6 +493,25 @@ private:
     void     WRMPStartTimer(void);
     void     WRMPStopTimer(void);
     void     WRMPProcessDDMessage(uint32_t PauseTimeMillis, uint64_t DelayedNodeId);
+#if WEAVE_CONFIG_WRMP_MAX_COALESCED_ACKS > 0
+    /**
+     *  Format of the optional payload of a solitary ack (Common::Null message), carrying acknowledgments for
+     *  other exchanges with the same peer. Its presence also tells the recipient that the sender understands it.
+     *
+     *      version (1) | count (1) | count x { flags (1) | exchange id (2) | acked message id (4) }
+     */
+    enum
+    {
+        kWRMPAckListVersion             = 1,
+        kWRMPAckListHeaderLength        = 2,
+        kWRMPAckListEntryLength         = 7,
+        kWRMPAckListFlag_FromInitiator  = 0x01,  /**< The acknowledged exchange was initiated by the sender of the ack. */
+    };
+    uint8_t  WRMPGatherCoalescedAcks(ExchangeContext *ec, ExchangeContext *coalescedAcks[]);
+    WEAVE_ERROR WRMPProcessAckList(WeaveConnection *msgCon, const WeaveMessageInfo *msgInfo, const PacketBuffer *msgBuf);
+    bool     WRMPIsCoalescedAckPeer(uint64_t peerNodeId) const;
+    void     WRMPAddCoalescedAckPeer(uint64_t peerNodeId);
+#endif
     uint32_t GetTickCounterFromTimeDelta (uint64_t newTime,
                                           uint64_t oldTime);
     static void WRMPTimeout(System::Layer* aSystemLayer, void* aAppState, System::Error aError);
@@ -501,6 +528,13 @@ private:
 
     //WRMP Global tables for timer context
     RetransTableEntry RetransTable[WEAVE_CONFIG_WRMP_RETRANS_TABLE_SIZE];
+
+#if WEAVE_CONFIG_WRMP_MAX_COALESCED_ACKS > 0
+    //Peers known to understand coalesced acks
+    uint64_t mWRMPCoalescedAckPeers[WEAVE_CONFIG_WRMP_COALESCED_ACK_PEER_TABLE_SIZE];
+    uint8_t  mWRMPNumCoalescedAckPeers;
+    uint8_t  mWRMPNextCoalescedAckPeer;
+#endif
 #endif // WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
 
     class UnsolicitedMessageHandler
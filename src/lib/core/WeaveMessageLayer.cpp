@@ -88,7 +88,9 @@ using namespace nl::Weave::Encoding;
 enum
 {
     kKeyIdLen = 2,
-    kMinPayloadLen = 1
+    kMinPayloadLen = 1,
+    kMaxHeaderLen = 2 + 4 + 8 + 8 + kKeyIdLen,  // header field, message id, source and destination node ids, key id
+    kMaxFramedHeaderLen = 2 + kMaxHeaderLen     // message length field followed by the header
 };
 
 /**
@@ -1294,6 +1296,9 @@ WEAVE_ERROR WeaveMessageLayer::EncodeMessage(WeaveMessageInfo *msgInfo, PacketBu
 {
     WEAVE_ERROR err;
     uint8_t *p1;
+
+    SYSTEM_STATS_LATENCY_SCOPE(nl::Weave::System::Stats::kLatency_MessageEncode);
+
     // Error if an unsupported message version requested.
     if (msgInfo->MessageVersion != kWeaveMessageVersion_V1 &&
         msgInfo->MessageVersion != kWeaveMessageVersion_V2)
@@ -1456,12 +1461,45 @@ WEAVE_ERROR WeaveMessageLayer::EncodeMessage(WeaveMessageInfo *msgInfo, PacketBu
 
 WEAVE_ERROR WeaveMessageLayer::DecodeMessage(PacketBuffer *msgBuf, uint64_t sourceNodeId, WeaveConnection *con,
         WeaveMessageInfo *msgInfo, uint8_t **rPayload, uint16_t *rPayloadLen) // TODO: use references
+{
+    uint16_t payloadOffset;
+
+    WEAVE_ERROR err = DecodeChainedMessage(msgBuf, msgBuf->DataLength(), sourceNodeId, con, msgInfo, &payloadOffset, rPayloadLen);
+    if (err != WEAVE_NO_ERROR)
+        return err;
+
+    // Return the position of the payload within the message.
+    *rPayload = msgBuf->Start() + payloadOffset;
+
+    return err;
+}
+
+/**
+ *  Decode, authenticate and decrypt, in place, a message of the given length that starts at the beginning of the
+ *  given buffer and may continue into the buffers chained after it.
+ *
+ *  The message header must be contiguous in the first buffer.  The payload and integrity check value may be split
+ *  across any number of buffers; they are decrypted and authenticated one segment at a time, so the message never
+ *  needs to be copied into a single buffer.
+ *
+ *  @param[in]    msgBuf          The buffer chain holding the message.
+ *  @param[in]    msgLen          The length of the message, which may be less than the length of the chain.
+ *  @param[in]    sourceNodeId    The node id of the peer, if not carried in the message.
+ *  @param[in]    con             The connection over which the message was received, or NULL.
+ *  @param[out]   msgInfo         The decoded message information.
+ *  @param[out]   rPayloadOffset  The offset of the payload from the start of the message.
+ *  @param[out]   rPayloadLen     The length of the payload.
+ */
+WEAVE_ERROR WeaveMessageLayer::DecodeChainedMessage(PacketBuffer *msgBuf, uint16_t msgLen, uint64_t sourceNodeId,
+        WeaveConnection *con, WeaveMessageInfo *msgInfo, uint16_t *rPayloadOffset, uint16_t *rPayloadLen)
 {
     WEAVE_ERROR err;
     uint8_t *msgStart = msgBuf->Start();
-    uint16_t msgLen = msgBuf->DataLength();
-    uint8_t *msgEnd = msgStart + msgLen;
     uint8_t *p = msgStart;
+    uint16_t headerLen;
+
+    SYSTEM_STATS_LATENCY_SCOPE(nl::Weave::System::Stats::kLatency_MessageDecode);
+
     msgInfo->SourceNodeId = sourceNodeId;
     err = DecodeHeader(msgBuf, msgInfo, &p);
     sourceNodeId = msgInfo->SourceNodeId;
@@ -1469,6 +1507,12 @@ WEAVE_ERROR WeaveMessageLayer::DecodeMessage(PacketBuffer *msgBuf, uint64_t sour
     if (err != WEAVE_NO_ERROR)
         return err;
 
+    // Error if the header extends beyond the end of the message.  (The header itself was bounded by the first buffer,
+    // which may also hold data that follows the message).
+    headerLen = p - msgStart;
+    if (headerLen > msgLen)
+        return WEAVE_ERROR_INVALID_MESSAGE_LENGTH;
+
     // Get the session state for the given source node and encryption key.
     WeaveSessionState sessionState;
 
@@ -1480,37 +1524,27 @@ WEAVE_ERROR WeaveMessageLayer::DecodeMessage(PacketBuffer *msgBuf, uint64_t sour
     {
     case kWeaveEncryptionType_None:
         // Return the position and length of the payload within the message.
-        *rPayloadLen = msgLen - (p - msgStart);
-        *rPayload = p;
-
-        // Skip over the payload.
-        p += *rPayloadLen;
+        *rPayloadLen = msgLen - headerLen;
+        *rPayloadOffset = headerLen;
         break;
 
     case kWeaveEncryptionType_AES128CTRSHA1:
     {
         // Error if the message is short given the expected fields.
-        if ((p + kMinPayloadLen + HMACSHA1::kDigestLength) > msgEnd)
+        if (headerLen + kMinPayloadLen + HMACSHA1::kDigestLength > msgLen)
             return WEAVE_ERROR_INVALID_MESSAGE_LENGTH;
 
         // Return the position and length of the payload within the message.
-        uint16_t payloadLen = msgLen - ((p - msgStart) + HMACSHA1::kDigestLength);
+        uint16_t payloadLen = msgLen - (headerLen + HMACSHA1::kDigestLength);
         *rPayloadLen = payloadLen;
-        *rPayload = p;
-
-        // Decrypt the message payload and the integrity check value that follows it, in place, in the message buffer.
-        Encrypt_AES128CTRSHA1(msgInfo, sessionState.MsgEncKey->EncKey.AES128CTRSHA1.DataKey,
-                              p, payloadLen + HMACSHA1::kDigestLength, p);
+        *rPayloadOffset = headerLen;
 
-        // Compute the expected integrity check value from the decrypted payload.
-        uint8_t expectedIntegrityCheck[HMACSHA1::kDigestLength];
-        ComputeIntegrityCheck_AES128CTRSHA1(msgInfo, sessionState.MsgEncKey->EncKey.AES128CTRSHA1.IntegrityKey,
-                                            p, payloadLen, expectedIntegrityCheck);
-        // Error if the expected integrity check doesn't match the integrity check in the message.
-        if (!ConstantTimeCompare(p + payloadLen, expectedIntegrityCheck, HMACSHA1::kDigestLength))
-            return WEAVE_ERROR_INTEGRITY_CHECK_FAILED;
-        // Skip past the payload and the integrity check value.
-        p += payloadLen + HMACSHA1::kDigestLength;
+        // Decrypt the message payload and the integrity check value that follows it, in place, in the message buffers,
+        // and verify the integrity check.
+        err = Decrypt_AES128CTRSHA1(msgInfo, sessionState.MsgEncKey->EncKey.AES128CTRSHA1.DataKey,
+                                    sessionState.MsgEncKey->EncKey.AES128CTRSHA1.IntegrityKey, msgBuf, headerLen, payloadLen);
+        if (err != WEAVE_NO_ERROR)
+            return err;
 
         break;
     }
@@ -1608,6 +1642,190 @@ WEAVE_ERROR WeaveMessageLayer::DecodeMessageWithLength(PacketBuffer *msgBuf, uin
     return err;
 }
 
+/**
+ *  Remove a decoded message from the front of a buffer chain and return its payload.
+ *
+ *  Buffers that hold nothing but the message are moved, trimmed to the payload, onto the returned payload chain;
+ *  buffers that hold only the header or the integrity check value are freed.  If the message ends part way through
+ *  a buffer, whichever is shorter of the payload bytes in that buffer and the data that follows the message is
+ *  copied into a new buffer, so the rest of the chain can be kept for the messages that follow.
+ *
+ *  @param[inout] msgBuf          The buffer chain, which starts with the message.  On return, the remaining data
+ *                                that follows the message, or NULL if there is none.
+ *  @param[in]    msgLen          The length of the message.
+ *  @param[in]    payloadOffset   The offset of the payload from the start of the message.
+ *  @param[in]    payloadLen      The length of the payload.
+ *  @param[out]   rPayload        The payload chain.
+ *
+ *  @retval #WEAVE_ERROR_NO_MEMORY  If a buffer could not be allocated to split the last buffer of the message.
+ */
+static WEAVE_ERROR DetachPayload(PacketBuffer *& msgBuf, uint16_t msgLen, uint16_t payloadOffset, uint16_t payloadLen,
+        PacketBuffer *& rPayload)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    PacketBuffer *payload = NULL;
+    const uint32_t payloadEnd = static_cast<uint32_t>(payloadOffset) + payloadLen;
+    uint32_t pos = 0;
+
+    while (pos < msgLen)
+    {
+        PacketBuffer *buf = msgBuf;
+        PacketBuffer *segment = NULL;
+        uint16_t bufLen = buf->DataLength();
+        uint16_t msgBytes = (msgLen - pos < bufLen) ? static_cast<uint16_t>(msgLen - pos) : bufLen;
+
+        // Locate the payload bytes within the part of this buffer that belongs to the message.
+        uint16_t first = (payloadOffset > pos) ? static_cast<uint16_t>(payloadOffset - pos) : 0;
+        uint16_t last = (payloadEnd > pos) ? static_cast<uint16_t>(payloadEnd - pos) : 0;
+
+        if (first > msgBytes)
+            first = msgBytes;
+        if (last > msgBytes)
+            last = msgBytes;
+
+        if (msgBytes < bufLen)
+        {
+            // The message ends within this buffer, which also holds the start of the data that follows.
+            uint16_t restLen = bufLen - msgBytes;
+
+            if (last - first <= restLen)
+            {
+                // Copy the payload bytes, if any, and leave the buffer at the head of the chain.
+                if (last > first)
+                {
+                    segment = PacketBuffer::NewWithAvailableSize(0, last - first);
+                    VerifyOrExit(segment != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+                    memcpy(segment->Start(), buf->Start() + first, last - first);
+                    segment->SetDataLength(last - first);
+                }
+
+                buf->SetStart(buf->Start() + msgBytes);
+            }
+            else
+            {
+                // Copy the data that follows the message, and move the buffer onto the payload chain.
+                PacketBuffer *rest = PacketBuffer::NewWithAvailableSize(0, restLen);
+                VerifyOrExit(rest != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+                memcpy(rest->Start(), buf->Start() + msgBytes, restLen);
+                rest->SetDataLength(restLen);
+
+                msgBuf = buf->DetachTail();
+                if (msgBuf != NULL)
+                    rest->AddToEnd(msgBuf);
+                msgBuf = rest;
+
+                segment = buf;
+            }
+        }
+        else
+        {
+            msgBuf = buf->DetachTail();
+
+            if (last > first)
+                segment = buf;
+            else
+                PacketBuffer::Free(buf);
+        }
+
+        if (segment == buf)
+        {
+            buf->SetDataLength(last);
+            buf->SetStart(buf->Start() + first);
+        }
+
+        if (segment != NULL)
+        {
+            if (payload == NULL)
+                payload = segment;
+            else
+                payload->AddToEnd(segment);
+        }
+
+        pos += msgBytes;
+    }
+
+    // An empty payload is still delivered in a buffer of its own.
+    if (payload == NULL)
+    {
+        payload = PacketBuffer::New(0);
+        VerifyOrExit(payload != NULL, err = WEAVE_ERROR_NO_MEMORY);
+    }
+
+    rPayload = payload;
+    payload = NULL;
+
+exit:
+    if (payload != NULL)
+        PacketBuffer::Free(payload);
+    return err;
+}
+
+/**
+ *  Decode a message that is preceded by its length, from the front of a chain of received buffers.
+ *
+ *  Unlike the single buffer form of this method, the message may be split across any number of buffers in the
+ *  chain.  It is decrypted and authenticated where it lies, and its payload is returned as a buffer chain, so a
+ *  large message is never copied into a contiguous buffer.
+ *
+ *  @param[inout] msgBuf          The received data.  On success, the data that follows the message, or NULL if
+ *                                there is none.
+ *  @param[in]    sourceNodeId    The node id of the peer.
+ *  @param[in]    con             The connection over which the data was received.
+ *  @param[out]   msgInfo         The decoded message information.
+ *  @param[out]   rPayload        On success, the payload of the message, possibly as a chain of buffers.
+ *  @param[out]   rFrameLen       The length of the message, including its length field, or the minimum frame
+ *                                length if the length field has not been received.
+ *
+ *  @retval #WEAVE_ERROR_MESSAGE_INCOMPLETE  If the chain does not yet hold the whole message.
+ */
+WEAVE_ERROR WeaveMessageLayer::DecodeMessageWithLength(PacketBuffer *& msgBuf, uint64_t sourceNodeId, WeaveConnection *con,
+        WeaveMessageInfo *msgInfo, PacketBuffer *& rPayload, uint32_t *rFrameLen)
+{
+    WEAVE_ERROR err;
+    uint8_t *dataStart;
+    uint16_t msgLen;
+    uint16_t payloadOffset;
+    uint16_t payloadLen;
+
+    // Error if the received data doesn't contain the entire message length field.
+    if (!msgBuf->PullUpHead(2))
+    {
+        *rFrameLen = 8; // Assume absolute minimum frame length.
+        return WEAVE_ERROR_MESSAGE_INCOMPLETE;
+    }
+
+    // Read the message length.
+    msgLen = LittleEndian::Get16(msgBuf->Start());
+
+    // The frame length is the length of the message plus the length of the length field.
+    *rFrameLen = static_cast<uint32_t>(msgLen) + 2;
+
+    // Error if the received data doesn't contain the entire message.
+    if (msgBuf->TotalLength() < *rFrameLen)
+        return WEAVE_ERROR_MESSAGE_INCOMPLETE;
+
+    // Make the message header contiguous in the first buffer, copying no more than the longest possible header
+    // from the buffers that follow.
+    if (!msgBuf->PullUpHead(*rFrameLen < kMaxFramedHeaderLen ? *rFrameLen : kMaxFramedHeaderLen))
+        return WEAVE_ERROR_BUFFER_TOO_SMALL;
+
+    // Decode the message that follows the length field.
+    dataStart = msgBuf->Start();
+    msgBuf->SetStart(dataStart + 2);
+
+    err = DecodeChainedMessage(msgBuf, msgLen, sourceNodeId, con, msgInfo, &payloadOffset, &payloadLen);
+    if (err != WEAVE_NO_ERROR)
+    {
+        msgBuf->SetStart(dataStart);
+        return err;
+    }
+
+    // Split the payload from the data that follows the message.
+    return DetachPayload(msgBuf, msgLen, payloadOffset, payloadLen, rPayload);
+}
+
 void WeaveMessageLayer::HandleUDPMessage(UDPEndPoint *endPoint, PacketBuffer *msg, const IPPacketInfo *pktInfo)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
@@ -2210,10 +2428,9 @@ void WeaveMessageLayer::Encrypt_AES128CTRSHA1(const WeaveMessageInfo *msgInfo, c
     aes128CTR.EncryptData(inData, inLen, outBuf);
 }
 
-void WeaveMessageLayer::ComputeIntegrityCheck_AES128CTRSHA1(const WeaveMessageInfo *msgInfo, const uint8_t *key,
-                                                            const uint8_t *inData, uint16_t inLen, uint8_t *outBuf)
+// Begin computing the integrity check of a message, hashing the header fields that it covers.
+static void BeginIntegrityCheck_AES128CTRSHA1(HMACSHA1 &hmacSHA1, const WeaveMessageInfo *msgInfo, const uint8_t *key)
 {
-    HMACSHA1 hmacSHA1;
     uint8_t encodedBuf[2 * sizeof(uint64_t) + sizeof(uint16_t) + sizeof(uint32_t)];
     uint8_t *p = encodedBuf;
 
@@ -2240,6 +2457,14 @@ void WeaveMessageLayer::ComputeIntegrityCheck_AES128CTRSHA1(const WeaveMessageIn
 
     // Hash encoded message header fields.
     hmacSHA1.AddData(encodedBuf, p - encodedBuf);
+}
+
+void WeaveMessageLayer::ComputeIntegrityCheck_AES128CTRSHA1(const WeaveMessageInfo *msgInfo, const uint8_t *key,
+                                                            const uint8_t *inData, uint16_t inLen, uint8_t *outBuf)
+{
+    HMACSHA1 hmacSHA1;
+
+    BeginIntegrityCheck_AES128CTRSHA1(hmacSHA1, msgInfo, key);
 
     // Handle payload data.
     hmacSHA1.AddData(inData, inLen);
@@ -2248,6 +2473,76 @@ void WeaveMessageLayer::ComputeIntegrityCheck_AES128CTRSHA1(const WeaveMessageIn
     hmacSHA1.Finish(outBuf);
 }
 
+/**
+ *  Decrypt, in place, the payload of a message and the integrity check value that follows it, and verify the
+ *  integrity check.
+ *
+ *  The payload starts at the given offset into the first buffer of the chain and may continue through any
+ *  number of the buffers that follow.  Decryption and the integrity check are computed one buffer at a time;
+ *  only the integrity check value, which may itself be split across buffers, is gathered into a local copy.
+ */
+WEAVE_ERROR WeaveMessageLayer::Decrypt_AES128CTRSHA1(const WeaveMessageInfo *msgInfo, const uint8_t *dataKey,
+                                                     const uint8_t *integrityKey, PacketBuffer *msgBuf,
+                                                     uint16_t payloadOffset, uint16_t payloadLen)
+{
+    AES128CTRMode aes128CTR;
+    HMACSHA1 hmacSHA1;
+    uint8_t integrityCheck[HMACSHA1::kDigestLength];
+    uint8_t expectedIntegrityCheck[HMACSHA1::kDigestLength];
+    uint32_t remainingLen = static_cast<uint32_t>(payloadLen) + HMACSHA1::kDigestLength;
+    uint16_t pos = 0;
+    uint16_t offset = payloadOffset;
+
+    aes128CTR.SetKey(dataKey);
+    aes128CTR.SetWeaveMessageCounter(msgInfo->SourceNodeId, msgInfo->MessageId);
+
+    BeginIntegrityCheck_AES128CTRSHA1(hmacSHA1, msgInfo, integrityKey);
+
+    for (PacketBuffer *buf = msgBuf; remainingLen > 0; buf = buf->Next())
+    {
+        if (buf == NULL || buf->DataLength() < offset)
+            return WEAVE_ERROR_INVALID_MESSAGE_LENGTH;
+
+        uint8_t *segment = buf->Start() + offset;
+        uint16_t segmentLen = buf->DataLength() - offset;
+        uint16_t segmentPayloadLen = 0;
+
+        if (segmentLen > remainingLen)
+            segmentLen = remainingLen;
+
+        // The counter mode state carries over from one segment to the next.
+        aes128CTR.EncryptData(segment, segmentLen, segment);
+
+        // Hash the part of the segment that belongs to the payload, and save the part that belongs to the
+        // integrity check value.
+        if (pos < payloadLen)
+        {
+            segmentPayloadLen = payloadLen - pos;
+            if (segmentPayloadLen > segmentLen)
+                segmentPayloadLen = segmentLen;
+            hmacSHA1.AddData(segment, segmentPayloadLen);
+        }
+
+        if (segmentPayloadLen < segmentLen)
+        {
+            memcpy(integrityCheck + (pos + segmentPayloadLen - payloadLen), segment + segmentPayloadLen,
+                   segmentLen - segmentPayloadLen);
+        }
+
+        pos += segmentLen;
+        remainingLen -= segmentLen;
+        offset = 0;
+    }
+
+    hmacSHA1.Finish(expectedIntegrityCheck);
+
+    // Error if the expected integrity check doesn't match the integrity check in the message.
+    if (!ConstantTimeCompare(integrityCheck, expectedIntegrityCheck, HMACSHA1::kDigestLength))
+        return WEAVE_ERROR_INTEGRITY_CHECK_FAILED;
+
+    return WEAVE_NO_ERROR;
+}
+
 /**
  *  Close all open TCP and UDP endpoints. Then abort any
  *  open WeaveConnections and shutdown any open
@@ -2467,6 +2762,44 @@ uint32_t WeaveMessageLayer::GetMaxWeavePayloadSize(const PacketBuffer *msgBuf, b
         : maxWeavePayloadSize;
 }
 
+/**
+ *  Gather a message payload held in a chain of buffers into a single buffer.
+ *
+ *  Messages received over a WeaveConnection are decoded where they lie in the receive buffers and may be handed
+ *  on as a chain; this is used on behalf of the consumers that read the payload as contiguous data.
+ *
+ *  The message is moved into the first buffer if it fits there; otherwise it is copied into a new buffer large
+ *  enough to hold it, and the chain is freed.
+ *
+ *  @param[inout] msgBuf    The buffer chain holding the message.  On success, the buffer holding the whole message.
+ *
+ *  @retval #WEAVE_ERROR_NO_MEMORY  If a large enough buffer could not be allocated.
+ */
+WEAVE_ERROR WeaveMessageLayer::CoalescePayload(PacketBuffer *& msgBuf)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    uint16_t msgLen = msgBuf->TotalLength();
+    PacketBuffer *newBuf;
+
+    if (msgBuf->PullUpHead(msgLen))
+        ExitNow();
+
+    newBuf = PacketBuffer::NewWithAvailableSize(0, msgLen);
+    VerifyOrExit(newBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+    for (PacketBuffer *buf = msgBuf; buf != NULL; buf = buf->Next())
+    {
+        memcpy(newBuf->Start() + newBuf->DataLength(), buf->Start(), buf->DataLength());
+        newBuf->SetDataLength(newBuf->DataLength() + buf->DataLength());
+    }
+
+    PacketBuffer::Free(msgBuf);
+    msgBuf = newBuf;
+
+exit:
+    return err;
+}
+
 /**
  * Constructs a string describing a peer node and its associated address / connection information.
  *
@@ -337,7 +337,8 @@ public:
      *
      *  @param[in]    msgInfo       A pointer to a WeaveMessageInfo structure containing information about the message.
      *
-     *  @param[in]    msgBuf        A pointer to the PacketBuffer object holding the message.
+     *  @param[in]    msgBuf        A pointer to the PacketBuffer object holding the message.  A large message
+     *                              may be delivered as a chain of buffers.
      *
      */
     typedef void (*MessageReceiveFunct)(WeaveConnection *con, WeaveMessageInfo *msgInfo, PacketBuffer *msgBuf);
@@ -712,6 +713,7 @@ public:
     bool IsMessageLayerActive(void);
 
     static uint32_t GetMaxWeavePayloadSize(const PacketBuffer *msgBuf, bool isUDP, uint32_t udpMTU);
+    static WEAVE_ERROR CoalescePayload(PacketBuffer *&msgBuf);
 
     static void GetPeerDescription(char *buf, size_t bufSize, uint64_t nodeId, const IPAddress *addr, uint16_t port, InterfaceId interfaceId, const WeaveConnection *con);
     static void GetPeerDescription(char *buf, size_t bufSize, const WeaveMessageInfo *msgInfo);
@@ -780,6 +782,10 @@ private:
             uint16_t maxLen);
     WEAVE_ERROR DecodeMessageWithLength(PacketBuffer *msgBuf, uint64_t sourceNodeId, WeaveConnection *con,
             WeaveMessageInfo *msgInfo, uint8_t **rPayload, uint16_t *rPayloadLen, uint32_t *rFrameLen);
+    WEAVE_ERROR DecodeMessageWithLength(PacketBuffer *& msgBuf, uint64_t sourceNodeId, WeaveConnection *con,
+            WeaveMessageInfo *msgInfo, PacketBuffer *& rPayload, uint32_t *rFrameLen);
+    WEAVE_ERROR DecodeChainedMessage(PacketBuffer *msgBuf, uint16_t msgLen, uint64_t sourceNodeId, WeaveConnection *con,
+            WeaveMessageInfo *msgInfo, uint16_t *rPayloadOffset, uint16_t *rPayloadLen);
     void GetIncomingTCPConCount(const IPAddress &peerAddr, uint16_t &count, uint16_t &countFromIP);
     void CheckForceRefreshUDPEndPointsNeeded(WEAVE_ERROR udpSendErr);
 
@@ -792,6 +798,9 @@ private:
                                       const uint8_t *inData, uint16_t inLen, uint8_t *outBuf);
     static void ComputeIntegrityCheck_AES128CTRSHA1(const WeaveMessageInfo *msgInfo, const uint8_t *key,
                                                     const uint8_t *inData, uint16_t inLen, uint8_t *outBuf);
+    static WEAVE_ERROR Decrypt_AES128CTRSHA1(const WeaveMessageInfo *msgInfo, const uint8_t *dataKey,
+                                             const uint8_t *integrityKey, PacketBuffer *msgBuf,
+                                             uint16_t payloadOffset, uint16_t payloadLen);
     static WEAVE_ERROR FilterUDPSendError(WEAVE_ERROR err, bool isMulticast);
     static bool IsIgnoredMulticastSendError(WEAVE_ERROR err);
 
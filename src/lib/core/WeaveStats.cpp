@@ -67,6 +67,78 @@ void UpdateSnapshot(nl::Weave::System::Stats::Snapshot &aSnapshot)
     }
 }
 
+#if WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
+
+/**
+ * Writes the TLV encoding of a LatencySnapshot.
+ *
+ * Points at which no latency was recorded are omitted.
+ *
+ * @param[in] aWriter       The TLVWriter to write the snapshot with.
+ * @param[in] aTag          The tag of the structure holding the snapshot.
+ * @param[in] aSnapshot     The LatencySnapshot to be written.
+ *
+ * @return WEAVE_NO_ERROR on success, or any error returned by the TLVWriter.
+ */
+WEAVE_ERROR WriteLatencySnapshot(nl::Weave::TLV::TLVWriter &aWriter, uint64_t aTag,
+                                 const nl::Weave::System::Stats::LatencySnapshot &aSnapshot)
+{
+    WEAVE_ERROR err;
+    nl::Weave::TLV::TLVType snapshotContainer;
+    nl::Weave::TLV::TLVType pointContainer;
+    nl::Weave::TLV::TLVType bucketsContainer;
+
+    err = aWriter.StartContainer(aTag, nl::Weave::TLV::kTLVType_Structure, snapshotContainer);
+    SuccessOrExit(err);
+
+    for (int i = 0; i < nl::Weave::System::Stats::kLatency_NumPoints; i++)
+    {
+        const nl::Weave::System::Stats::LatencyHistogram &histogram = aSnapshot.mHistograms[i];
+        int numBuckets = nl::Weave::System::Stats::kLatency_NumBuckets;
+
+        if (histogram.mCount == 0)
+            continue;
+
+        err = aWriter.StartContainer(nl::Weave::TLV::ContextTag(i), nl::Weave::TLV::kTLVType_Structure, pointContainer);
+        SuccessOrExit(err);
+
+        err = aWriter.Put(nl::Weave::TLV::ContextTag(kTag_LatencyCount), histogram.mCount);
+        SuccessOrExit(err);
+
+        err = aWriter.Put(nl::Weave::TLV::ContextTag(kTag_LatencyMax), histogram.mMaxUS);
+        SuccessOrExit(err);
+
+        err = aWriter.Put(nl::Weave::TLV::ContextTag(kTag_LatencyTotal), histogram.mTotalUS);
+        SuccessOrExit(err);
+
+        // Trailing empty buckets are left out.
+        while (numBuckets > 0 && histogram.mBuckets[numBuckets - 1] == 0)
+            numBuckets--;
+
+        err = aWriter.StartContainer(nl::Weave::TLV::ContextTag(kTag_LatencyBuckets), nl::Weave::TLV::kTLVType_Array, bucketsContainer);
+        SuccessOrExit(err);
+
+        for (int j = 0; j < numBuckets; j++)
+        {
+            err = aWriter.Put(nl::Weave::TLV::AnonymousTag, histogram.mBuckets[j]);
+            SuccessOrExit(err);
+        }
+
+        err = aWriter.EndContainer(bucketsContainer);
+        SuccessOrExit(err);
+
+        err = aWriter.EndContainer(pointContainer);
+        SuccessOrExit(err);
+    }
+
+    err = aWriter.EndContainer(snapshotContainer);
+
+exit:
+    return err;
+}
+
+#endif // WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
+
 } // namespace Stats
 } // namespace Weave
 } // namespace nl
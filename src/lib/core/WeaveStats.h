@@ -31,6 +31,10 @@
 #include <Weave/Core/WeaveConfig.h>
 #include <SystemLayer/SystemStats.h>
 
+#if WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
+#include <Weave/Core/WeaveTLV.h>
+#endif
+
 namespace nl {
 namespace Weave {
 namespace Stats {
@@ -39,6 +43,28 @@ void UpdateSnapshot(nl::Weave::System::Stats::Snapshot &aSnapshot);
 
 void SetObjects(WeaveMessageLayer *aMessageLayer);
 
+#if WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
+
+/**
+ * Context tags of the TLV encoding of a LatencySnapshot written by WriteLatencySnapshot().
+ *
+ * The snapshot is encoded as a structure holding, under the context tag of each
+ * nl::Weave::System::Stats::LatencyPoint with recorded latencies, a structure with the
+ * fields below.
+ */
+enum
+{
+    kTag_LatencyCount       = 1,    ///< Number of latencies recorded [uint]
+    kTag_LatencyMax         = 2,    ///< Longest latency recorded, in microseconds [uint]
+    kTag_LatencyTotal       = 3,    ///< Sum of the latencies recorded, in microseconds [uint]
+    kTag_LatencyBuckets     = 4,    ///< Counts of the histogram buckets, up to the last non-empty one [array of uint]
+};
+
+WEAVE_ERROR WriteLatencySnapshot(nl::Weave::TLV::TLVWriter &aWriter, uint64_t aTag,
+                                 const nl::Weave::System::Stats::LatencySnapshot &aSnapshot);
+
+#endif // WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
+
 } // namespace Stats
 } // namespace Weave
 } // namespace nl
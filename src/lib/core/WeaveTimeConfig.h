@@ -262,6 +262,38 @@
 #define WEAVE_CONFIG_TIME_CLIENT_CONNECTION_FOR_SERVICE 1
 #endif // WEAVE_CONFIG_TIME_CLIENT_CONNECTION_FOR_SERVICE
 
+/**
+ *  @def WEAVE_CONFIG_TIME_CLIENT_CONCURRENT_SYNC
+ *
+ *  @brief
+ *    Disabled: 0, Enabled: 1. This only applies to Time Sync
+ *    Client/Coordinator roles. If enabled, each round of a local sync
+ *    sends requests to all known contacts at once, each through its
+ *    own exchange context, instead of contacting them one at a time.
+ *    A round then costs at most one unicast timeout, no matter how
+ *    many contacts are unreachable. Each contact holds an exchange
+ *    context while its request is outstanding.
+ *
+ */
+#ifndef WEAVE_CONFIG_TIME_CLIENT_CONCURRENT_SYNC
+#define WEAVE_CONFIG_TIME_CLIENT_CONCURRENT_SYNC 0
+#endif // WEAVE_CONFIG_TIME_CLIENT_CONCURRENT_SYNC
+
+/**
+ *  @def WEAVE_CONFIG_TIME_CLIENT_CONCURRENT_SYNC_MIN_RELIABLE_RESPONSES
+ *
+ *  @brief
+ *    This only applies when WEAVE_CONFIG_TIME_CLIENT_CONCURRENT_SYNC is
+ *    enabled. Number of reliable responses after which a round of local
+ *    sync completes without waiting for the remaining contacts to
+ *    respond or time out. Set to WEAVE_CONFIG_TIME_CLIENT_MAX_NUM_CONTACTS
+ *    to always wait for all contacts. Default is 2.
+ *
+ */
+#ifndef WEAVE_CONFIG_TIME_CLIENT_CONCURRENT_SYNC_MIN_RELIABLE_RESPONSES
+#define WEAVE_CONFIG_TIME_CLIENT_CONCURRENT_SYNC_MIN_RELIABLE_RESPONSES 2
+#endif // WEAVE_CONFIG_TIME_CLIENT_CONCURRENT_SYNC_MIN_RELIABLE_RESPONSES
+
 /**
  *  @def WEAVE_CONFIG_TIME_CLIENT_MIN_OFFSET_FROM_SERVER_USEC
  *
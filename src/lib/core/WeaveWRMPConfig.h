@@ -113,6 +113,36 @@ namespace Weave {
 #define WEAVE_CONFIG_WRMP_DEFAULT_MAX_RETRANS               (3)
 #endif // WEAVE_CONFIG_WRMP_DEFAULT_MAX_RETRANS
 
+/**
+ *  @def WEAVE_CONFIG_WRMP_MAX_COALESCED_ACKS
+ *
+ *  @brief
+ *    The maximum number of acknowledgments for other exchanges with the
+ *    same peer that may be carried in a single solitary ack (Common::Null
+ *    message).
+ *
+ *    Coalescing is only used towards peers that have been seen to
+ *    understand it, i.e. that sent a solitary ack carrying an ack list
+ *    themselves; legacy peers keep receiving one solitary ack per exchange.
+ *    Setting this to 0 disables the feature, including the advertisement.
+ *
+ */
+#ifndef WEAVE_CONFIG_WRMP_MAX_COALESCED_ACKS
+#define WEAVE_CONFIG_WRMP_MAX_COALESCED_ACKS                (0)
+#endif // WEAVE_CONFIG_WRMP_MAX_COALESCED_ACKS
+
+/**
+ *  @def WEAVE_CONFIG_WRMP_COALESCED_ACK_PEER_TABLE_SIZE
+ *
+ *  @brief
+ *    The number of peers remembered as understanding coalesced acks. When
+ *    the table is full the oldest entry is replaced.
+ *
+ */
+#ifndef WEAVE_CONFIG_WRMP_COALESCED_ACK_PEER_TABLE_SIZE
+#define WEAVE_CONFIG_WRMP_COALESCED_ACK_PEER_TABLE_SIZE     (8)
+#endif // WEAVE_CONFIG_WRMP_COALESCED_ACK_PEER_TABLE_SIZE
+
 /**
  *  @brief
  *    The WRMP configuration.
@@ -81,6 +81,32 @@ enum
     kMode_Asynchronous =                    0x40,
 };
 
+/*
+ * when set in the transfer control byte of an accept message, the responder
+ * granted a windowed transfer and a one byte window size (the number of
+ * blocks that may be outstanding) follows the max block size field.  an
+ * accept only carries it in reply to an init message that proposed a window
+ * size (see kTag_WindowSize), so peers that don't support windowed transfers
+ * never receive it.
+ */
+enum
+{
+    kXferCtl_Windowed =                     0x80,
+};
+
+/*
+ * tags (in the BDX profile) of the TLV elements BDX itself adds to the
+ * metadata of an init message:
+ * - window size, the number of blocks the initiator proposes to have
+ * outstanding, appended after any application metadata.  a peer that
+ * doesn't support windowed transfers hands it to its application as part
+ * of the metadata and carries out a lock-step transfer.
+ */
+enum
+{
+    kTag_WindowSize =                       0x01,
+};
+
 /*
  * with respect to range control, there are several options:
  * - definite length, if set then the transfer has definite length
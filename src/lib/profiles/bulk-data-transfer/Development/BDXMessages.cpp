@@ -26,6 +26,7 @@
 #include <Weave/Profiles/bulk-data-transfer/Development/BDXMessages.h>
 #include <Weave/Core/WeaveCore.h>
 #include <Weave/Core/WeaveMessageLayer.h>
+#include <Weave/Core/WeaveTLV.h>
 #include <Weave/Profiles/ProfileCommon.h>
 #include <Weave/Support/CodeUtils.h>
 
@@ -38,6 +39,70 @@ using namespace ::nl::Weave::Profiles::StatusReporting;
 
 #define VERSION_MASK 0x0F
 
+// Packed length of the window size element appended to the metadata of an init message:
+// <control byte>+<fully-qualified tag>+<uint8 value>
+#define WINDOW_SIZE_TLV_LENGTH (1 + 6 + 1)
+
+/*
+ * Append the proposed window size to the metadata of an init message.  The
+ * element comes after any application metadata, so a peer that doesn't
+ * support windowed transfers still parses the message correctly and just
+ * sees one more metadata element.
+ */
+static WEAVE_ERROR PackWindowSize(MessageIterator &i, uint8_t aWindowSize)
+{
+    WEAVE_ERROR err;
+    PacketBuffer *buffer = i.GetBuffer();
+    uint16_t prevDataLength = buffer->DataLength();
+    TLV::TLVWriter writer;
+
+    writer.Init(buffer, WINDOW_SIZE_TLV_LENGTH);
+
+    err = writer.Put(TLV::ProfileTag(kWeaveProfile_BDX, kTag_WindowSize), aWindowSize);
+    SuccessOrExit(err);
+
+    err = writer.Finalize();
+    SuccessOrExit(err);
+
+    i.thePoint += buffer->DataLength() - prevDataLength;
+
+exit:
+    return err;
+}
+
+/*
+ * If the metadata of a parsed init message ends with a window size element,
+ * take the window size from it and strip it from the metadata, so that the
+ * application only sees the metadata written by its peer's application.
+ */
+static WEAVE_ERROR ParseWindowSize(ReferencedTLVData &aMetaData, uint8_t &aWindowSize)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    TLV::TLVReader reader;
+
+    aWindowSize = 1;
+
+    VerifyOrExit(aMetaData.theLength >= WINDOW_SIZE_TLV_LENGTH, /* no-op */);
+
+    reader.Init(aMetaData.theData + aMetaData.theLength - WINDOW_SIZE_TLV_LENGTH, WINDOW_SIZE_TLV_LENGTH);
+
+    VerifyOrExit(reader.Next() == WEAVE_NO_ERROR && reader.GetLengthRead() == WINDOW_SIZE_TLV_LENGTH, /* no-op */);
+    VerifyOrExit(reader.GetTag() == TLV::ProfileTag(kWeaveProfile_BDX, kTag_WindowSize), /* no-op */);
+
+    err = reader.Get(aWindowSize);
+    SuccessOrExit(err);
+    VerifyOrExit(aWindowSize > 0, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    aMetaData.theLength -= WINDOW_SIZE_TLV_LENGTH;
+    if (aMetaData.theLength == 0)
+    {
+        aMetaData.theData = NULL;
+    }
+
+exit:
+    return err;
+}
+
 /*
  * -- definitions for SendInit and its supporting classes --
  *
@@ -54,6 +119,7 @@ SendInit::SendInit()
     , mStartOffsetPresent(false)
     , mWideRange(false)
     , mMaxBlockSize(32)
+    , mWindowSize(1)
     , mStartOffset(0)
     , mLength(0)
     , mMetaDataWriteCallback(NULL)
@@ -310,6 +376,12 @@ WEAVE_ERROR SendInit::pack(PacketBuffer *aBuffer)
         mMetaData.pack(i);
     }
 
+    if (mWindowSize > 1)
+    {
+        err = PackWindowSize(i, mWindowSize);
+        SuccessOrExit(err);
+    }
+
 exit:
     return err;
 }
@@ -355,7 +427,8 @@ uint16_t SendInit::GetWrittenMetaDataCallbackLength(void)
  */
 uint16_t SendInit::packedLength()
 {
-    // <xfer cctl>+<range ctl>+<max block>+<start offset (optional)>+<length (optional)>+<designator>+<metadata (optional)>
+    // <xfer cctl>+<range ctl>+<max block>+<start offset (optional)>+<length (optional)>+<designator>+<metadata (optional)>+<window (optional)>
+    uint16_t windowLength = (mWindowSize > 1) ? WINDOW_SIZE_TLV_LENGTH : 0;
     uint16_t startOffsetLength = mStartOffsetPresent ? (mWideRange ? 8 : 4) : 0;
     uint16_t lengthLength = mDefiniteLength ? (mWideRange ? 8 : 4) : 0;
     uint16_t metaDataLength = 0;
@@ -369,7 +442,7 @@ uint16_t SendInit::packedLength()
         metaDataLength = mMetaData.packedLength();
     }
 
-    return 1 + 1 + 2 + startOffsetLength + lengthLength + (2 + mFileDesignator.theLength) + metaDataLength;
+    return 1 + 1 + 2 + startOffsetLength + lengthLength + (2 + mFileDesignator.theLength) + metaDataLength + windowLength;
 }
 
 /**
@@ -409,6 +482,7 @@ WEAVE_ERROR SendInit::parse(PacketBuffer *aBuffer, SendInit &aRequest)
 
     err = i.read16(&aRequest.mMaxBlockSize);
     SuccessOrExit(err);
+
     if (aRequest.mStartOffsetPresent)
     {
         if (aRequest.mWideRange)
@@ -443,6 +517,9 @@ WEAVE_ERROR SendInit::parse(PacketBuffer *aBuffer, SendInit &aRequest)
     SuccessOrExit(err);
     ReferencedTLVData::parse(i, aRequest.mMetaData);
 
+    err = ParseWindowSize(aRequest.mMetaData, aRequest.mWindowSize);
+    SuccessOrExit(err);
+
 exit:
     return err;
 }
@@ -465,6 +542,7 @@ bool SendInit::operator == (const SendInit &another) const
             mStartOffsetPresent == another.mStartOffsetPresent &&
             mAsynchronousModeSupported == another.mAsynchronousModeSupported &&
             mMaxBlockSize == another.mMaxBlockSize &&
+            mWindowSize == another.mWindowSize &&
             mStartOffset == another.mStartOffset &&
             mFileDesignator == another.mFileDesignator &&
             mMetaData == another.mMetaData);
@@ -479,6 +557,7 @@ SendAccept::SendAccept()
     : mVersion(0)
     , mTransferMode(kMode_SenderDrive)
     , mMaxBlockSize(0)
+    , mWindowSize(1)
 {
 }
 
@@ -531,12 +610,18 @@ WEAVE_ERROR SendAccept::pack(PacketBuffer *aBuffer)
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
     i.append();
-    err = i.writeByte(mTransferMode | (mVersion & VERSION_MASK));
+    err = i.writeByte(mTransferMode | (mVersion & VERSION_MASK) | ((mWindowSize > 1) ? kXferCtl_Windowed : 0));
     SuccessOrExit(err);
 
     err = i.write16(mMaxBlockSize);
     SuccessOrExit(err);
 
+    if (mWindowSize > 1)
+    {
+        err = i.writeByte(mWindowSize);
+        SuccessOrExit(err);
+    }
+
     mMetaData.pack(i);
 
 exit:
@@ -551,8 +636,8 @@ exit:
  */
 uint16_t SendAccept::packedLength()
 {
-    // <transfer mode>+<max block size>+<meta data (optional)>
-    return 1 + 2 + mMetaData.packedLength();
+    // <transfer mode>+<max block size>+<window (optional)>+<meta data (optional)>
+    return 1 + 2 + ((mWindowSize > 1) ? 1 : 0) + mMetaData.packedLength();
 }
 
 /**
@@ -576,11 +661,19 @@ WEAVE_ERROR SendAccept::parse(PacketBuffer *aBuffer, SendAccept &aResponse)
     SuccessOrExit(err);
 
     aResponse.mVersion = tcByte & VERSION_MASK ;
-    aResponse.mTransferMode = tcByte & ~VERSION_MASK;
+    aResponse.mTransferMode = tcByte & ~(VERSION_MASK | kXferCtl_Windowed);
 
     err = i.read16(&aResponse.mMaxBlockSize);
     SuccessOrExit(err);
 
+    aResponse.mWindowSize = 1;
+    if ((tcByte & kXferCtl_Windowed) != 0)
+    {
+        err = i.readByte(&aResponse.mWindowSize);
+        SuccessOrExit(err);
+        VerifyOrExit(aResponse.mWindowSize > 0, err = WEAVE_ERROR_INVALID_ARGUMENT);
+    }
+
     ReferencedTLVData::parse(i, aResponse.mMetaData);
 
 exit:
@@ -600,6 +693,7 @@ bool SendAccept::operator == (const SendAccept &another) const
     return (mVersion == another.mVersion &&
             mTransferMode == another.mTransferMode &&
             mMaxBlockSize == another.mMaxBlockSize &&
+            mWindowSize == another.mWindowSize &&
             mMetaData == another.mMetaData);
 }
 
@@ -620,6 +714,7 @@ ReceiveInit::ReceiveInit()
     mStartOffsetPresent = false;
     mWideRange = false;
     mMaxBlockSize = 32;
+    mWindowSize = 1;
     mStartOffset = 0;
     mLength = 0;
 }
@@ -637,6 +732,7 @@ ReceiveAccept::ReceiveAccept()
     mTransferMode = kMode_ReceiverDrive;
     mVersion = 0;
     mMaxBlockSize = 0;
+    mWindowSize = 1;
 }
 
 /**
@@ -710,7 +806,7 @@ WEAVE_ERROR ReceiveAccept::pack(PacketBuffer *aBuffer)
     uint8_t rangeCtl = 0;
 
     i.append();
-    err = i.writeByte(mTransferMode | (mVersion & VERSION_MASK));
+    err = i.writeByte(mTransferMode | (mVersion & VERSION_MASK) | ((mWindowSize > 1) ? kXferCtl_Windowed : 0));
     SuccessOrExit(err);
 
     // format and pack the range control field
@@ -723,6 +819,12 @@ WEAVE_ERROR ReceiveAccept::pack(PacketBuffer *aBuffer)
     err = i.write16(mMaxBlockSize);
     SuccessOrExit(err);
 
+    if (mWindowSize > 1)
+    {
+        err = i.writeByte(mWindowSize);
+        SuccessOrExit(err);
+    }
+
     // and the length, if any
     if (mDefiniteLength)
     {
@@ -752,8 +854,8 @@ exit:
  */
 uint16_t ReceiveAccept::packedLength()
 {
-    // <transfer mode>+<range control>+<max block size>+<length (optional)>+<meta data (optional)>
-    return 1 + 1 + 2 + (mDefiniteLength ? (mWideRange ? 8 : 4) : 0) + mMetaData.packedLength();
+    // <transfer mode>+<range control>+<max block size>+<window (optional)>+<length (optional)>+<meta data (optional)>
+    return 1 + 1 + 2 + ((mWindowSize > 1) ? 1 : 0) + (mDefiniteLength ? (mWideRange ? 8 : 4) : 0) + mMetaData.packedLength();
 }
 
 /**
@@ -779,7 +881,7 @@ WEAVE_ERROR ReceiveAccept::parse(PacketBuffer *aBuffer, ReceiveAccept &aResponse
     SuccessOrExit(err);
 
     aResponse.mVersion = tcByte & VERSION_MASK ;
-    aResponse.mTransferMode = tcByte & ~VERSION_MASK;
+    aResponse.mTransferMode = tcByte & ~(VERSION_MASK | kXferCtl_Windowed);
 
     // unpack the range control byte
     err = i.readByte(&rangeCtl);
@@ -791,6 +893,14 @@ WEAVE_ERROR ReceiveAccept::parse(PacketBuffer *aBuffer, ReceiveAccept &aResponse
     err = i.read16(&aResponse.mMaxBlockSize);
     SuccessOrExit(err);
 
+    aResponse.mWindowSize = 1;
+    if ((tcByte & kXferCtl_Windowed) != 0)
+    {
+        err = i.readByte(&aResponse.mWindowSize);
+        SuccessOrExit(err);
+        VerifyOrExit(aResponse.mWindowSize > 0, err = WEAVE_ERROR_INVALID_ARGUMENT);
+    }
+
     if (aResponse.mDefiniteLength)
     {
         if (aResponse.mWideRange)
@@ -826,6 +936,7 @@ bool ReceiveAccept::operator == (const ReceiveAccept &another) const
             mDefiniteLength == another.mDefiniteLength &&
             mWideRange == another.mWideRange &&
             mMaxBlockSize == another.mMaxBlockSize &&
+            mWindowSize == another.mWindowSize &&
             mLength == another.mLength &&
             mMetaData == another.mMetaData);
 }
@@ -146,6 +146,7 @@ public:
     bool mWideRange;                    /**< True if offset and length are 64 bits. */
     // Block size and offset
     uint16_t mMaxBlockSize;             /**< Proposed max block size to use in transfer. */
+    uint8_t mWindowSize;                /**< Proposed max number of outstanding blocks, 1 for lock-step; sent in the metadata. */
     uint64_t mStartOffset;              /**< Proposed start offset of data. */
     uint64_t mLength;                   /**< Proposed length of data in transfer, 0 for indefinite. */
     // File designator
@@ -180,6 +181,7 @@ public:
     uint8_t mVersion;               /**< Version of the BDX protocol we decided on. */
     uint8_t mTransferMode;          /**< Transfer mode that we decided on. */
     uint16_t mMaxBlockSize;         /**< Maximum block size we decided on. */
+    uint8_t mWindowSize;            /**< Max number of outstanding blocks we decided on, 1 for lock-step. */
     ReferencedTLVData mMetaData;    /**< Optional TLV Metadata. */
 };
 
@@ -720,7 +720,10 @@ void BdxNode::HandleReceiveInit(ExchangeContext *anEc, const IPPacketInfo *aPktI
     xfer->mIsAccepted = false;
     xfer->mAmSender = true;
     xfer->mMaxBlockSize = receiveInit.mMaxBlockSize;
+    xfer->mStartOffset = receiveInit.mStartOffset;
     xfer->mVersion = (receiveInit.mVersion > WEAVE_CONFIG_BDX_VERSION) ? WEAVE_CONFIG_BDX_VERSION : receiveInit.mVersion;
+    // Offer the largest window we support up to the one proposed; the application may lower it
+    xfer->mWindowSize = (xfer->mVersion == 1) ? xfer->GetSupportedWindowSize(receiveInit.mWindowSize) : 1;
 
     // Verify we have a legitimate block size or reject
     VerifyOrExit(receiveInit.mMaxBlockSize > 0,
@@ -737,6 +740,8 @@ void BdxNode::HandleReceiveInit(ExchangeContext *anEc, const IPPacketInfo *aPktI
     statusCode = bdxApp->mReceiveInitHandler(xfer, &receiveInit);
     VerifyOrExit(statusCode == kStatus_Success, err = WEAVE_ERROR_INCORRECT_STATE);
 
+    xfer->mWindowSize = xfer->GetSupportedWindowSize((xfer->mWindowSize < receiveInit.mWindowSize) ? xfer->mWindowSize : receiveInit.mWindowSize);
+
     // Validate the requested transfer mode
     VerifyOrExit(!(((xfer->mTransferMode == kMode_ReceiverDrive) && !receiveInit.mReceiverDriveSupported) ||
                    ((xfer->mTransferMode == kMode_SenderDrive) && !receiveInit.mSenderDriveSupported) ||
@@ -864,9 +869,12 @@ void BdxNode::HandleSendInit(ExchangeContext *anEc, const IPPacketInfo *aPktInfo
     // Configure xfer object
     xfer->mIsAccepted = false;
     xfer->mMaxBlockSize = sendInit.mMaxBlockSize;
+    xfer->mStartOffset = sendInit.mStartOffset;
     xfer->mAmInitiator = false;
     xfer->mAmSender = false;
     xfer->mVersion = (sendInit.mVersion > WEAVE_CONFIG_BDX_VERSION) ? WEAVE_CONFIG_BDX_VERSION : sendInit.mVersion;
+    // Offer the largest window we support up to the one proposed; the application may lower it
+    xfer->mWindowSize = (xfer->mVersion == 1) ? xfer->GetSupportedWindowSize(sendInit.mWindowSize) : 1;
 
     // Fire application callback to validate request and setup transfer
     // Application should set the transfer mode and accept the transfer.
@@ -876,6 +884,8 @@ void BdxNode::HandleSendInit(ExchangeContext *anEc, const IPPacketInfo *aPktInfo
     statusCode = bdxApp->mSendInitHandler(xfer, &sendInit);
     VerifyOrExit(statusCode == kStatus_Success, err = WEAVE_ERROR_INCORRECT_STATE);
 
+    xfer->mWindowSize = xfer->GetSupportedWindowSize((xfer->mWindowSize < sendInit.mWindowSize) ? xfer->mWindowSize : sendInit.mWindowSize);
+
     // Validate the requested transfer mode
     VerifyOrExit(!(((xfer->mTransferMode == kMode_ReceiverDrive) && !sendInit.mReceiverDriveSupported) ||
                    ((xfer->mTransferMode == kMode_SenderDrive) && !sendInit.mSenderDriveSupported) ||
@@ -1006,6 +1016,8 @@ WEAVE_ERROR BdxNode::SendReceiveAccept(ExchangeContext *anEc, BDXTransfer *aXfer
     VerifyOrExit(err == WEAVE_NO_ERROR,
                  WeaveLogDetail(BDX, "SendReceiveAccept error calling Init on receiveAccept: %d", err));
 
+    receiveAccept.mWindowSize = aXfer->mWindowSize;
+
     payload = PacketBuffer::New();
     VerifyOrExit(payload != NULL,
                  err = WEAVE_ERROR_NO_MEMORY;
@@ -1029,6 +1041,14 @@ WEAVE_ERROR BdxNode::SendReceiveAccept(ExchangeContext *anEc, BDXTransfer *aXfer
     if (aXfer->IsDriver())
     {
         WeaveLogDetail(BDX, "ReceiveAccept sent: Am driving so sending first block");
+#if WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 1
+        if (aXfer->mVersion == 1 && aXfer->mWindowSize > 1)
+        {
+            aXfer->mWindowLimit = aXfer->mWindowSize;
+            err = BdxProtocol::SendBlockWindowV1(*aXfer);
+        }
+        else
+#endif // WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 1
         if (aXfer->mVersion == 1)
         {
             err = BdxProtocol::SendNextBlockV1(*aXfer);
@@ -1072,6 +1092,8 @@ WEAVE_ERROR BdxNode::SendSendAccept(ExchangeContext *anEc, BDXTransfer *aXfer)
     VerifyOrExit(err == WEAVE_NO_ERROR,
                  WeaveLogDetail(BDX, "SendSendAccept error calling Init on sendAccept: %d", err));
 
+    sendAccept.mWindowSize = aXfer->mWindowSize;
+
     payload = PacketBuffer::New();
     VerifyOrExit(payload != NULL,
                  err = WEAVE_ERROR_NO_MEMORY;
@@ -1096,6 +1118,13 @@ WEAVE_ERROR BdxNode::SendSendAccept(ExchangeContext *anEc, BDXTransfer *aXfer)
     if (aXfer->IsDriver())
     {
         WeaveLogDetail(BDX, "SendAccept sent: Am driving so sending first block query");
+#if WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 1
+        if (aXfer->mVersion == 1 && aXfer->mWindowSize > 1)
+        {
+            err = BdxProtocol::SendBlockQueryWindowV1(*aXfer);
+        }
+        else
+#endif // WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 1
         if (aXfer->mVersion == 1)
         {
             err = BdxProtocol::SendBlockQueryV1(*aXfer);
@@ -78,6 +78,10 @@ WEAVE_ERROR InitBdxReceive(BDXTransfer &aXfer, bool aICanDrive, bool aUCanDrive,
         SuccessOrExit(err);
     }
 
+    // Propose a windowed transfer if the application asked for one and we can support it
+    aXfer.mWindowSize = aXfer.GetSupportedWindowSize(aXfer.mWindowSize);
+    msg.mWindowSize = aXfer.mWindowSize;
+
     err = msg.pack(buffer);
     SuccessOrExit(err);
 
@@ -134,6 +138,10 @@ WEAVE_ERROR InitBdxSend(BDXTransfer &aXfer, bool aICanDrive, bool aUCanDrive,
         SuccessOrExit(err);
     }
 
+    // Propose a windowed transfer if the application asked for one and we can support it
+    aXfer.mWindowSize = aXfer.GetSupportedWindowSize(aXfer.mWindowSize);
+    msg.mWindowSize = aXfer.mWindowSize;
+
     err = msg.pack(buffer);
     SuccessOrExit(err);
 
@@ -190,6 +198,10 @@ WEAVE_ERROR InitBdxSend(BDXTransfer &aXfer, bool aICanDrive, bool aUCanDrive,
         SuccessOrExit(err);
     }
 
+    // Propose a windowed transfer if the application asked for one and we can support it
+    aXfer.mWindowSize = aXfer.GetSupportedWindowSize(aXfer.mWindowSize);
+    msg.mWindowSize = aXfer.mWindowSize;
+
     err = msg.pack(buffer);
     SuccessOrExit(err);
 
@@ -216,6 +228,49 @@ WEAVE_ERROR SendBadBlockCounterStatusReport(BDXTransfer & aXfer)
     return WEAVE_NO_ERROR;
 }
 
+#if WEAVE_CONFIG_BDX_CLIENT_SEND_SUPPORT || WEAVE_CONFIG_BDX_CLIENT_RECEIVE_SUPPORT
+/**
+ * @brief
+ *  Works out the window size of a transfer from the one a responder granted
+ *  in its accept message.
+ *
+ *  Only V1 transfers are windowed.  The responder may grant at most the
+ *  window we proposed; a grant of 0 is treated as lock-step.
+ *
+ * @param[in]      aVersion         Version of the accepted transfer
+ * @param[in]      aGrantedWindow   Window size in the accept message
+ * @param[in]      aProposedWindow  Window size we proposed in our init message
+ *
+ * @return  The window size to use for the transfer.
+ */
+static uint8_t GetAcceptedWindowSize(uint8_t aVersion, uint8_t aGrantedWindow, uint8_t aProposedWindow)
+{
+    uint8_t windowSize = 1;
+
+    if (aVersion == 1 && aGrantedWindow > 0)
+    {
+        windowSize = (aGrantedWindow < aProposedWindow) ? aGrantedWindow : aProposedWindow;
+    }
+
+    return (windowSize > 0) ? windowSize : 1;
+}
+#endif // WEAVE_CONFIG_BDX_CLIENT_SEND_SUPPORT || WEAVE_CONFIG_BDX_CLIENT_RECEIVE_SUPPORT
+
+#if WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+/**
+ * @brief
+ *  Records that the receiver holds every block sent up to and including
+ *  aBlockCounter, which must be one of the last blocks sent.
+ *
+ * @param[in]      aXfer            The sending BDXTransfer
+ * @param[in]      aBlockCounter    Counter of the last block known to be received
+ */
+static void VerifySentBlock(BDXTransfer &aXfer, uint32_t aBlockCounter)
+{
+    aXfer.UpdateVerifiedLength(aXfer.mSentBlockEnd[aBlockCounter % WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE]);
+}
+#endif // WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+
 #if WEAVE_CONFIG_BDX_V0_SUPPORT
 /**
  * @brief
@@ -268,6 +323,21 @@ exit:
  * @retval         #WEAVE_ERROR_NO_MEMORY   If no available PacketBuffers.
  */
 WEAVE_ERROR SendBlockQueryV1(BDXTransfer &aXfer)
+{
+    return SendBlockQueryCounterV1(aXfer, aXfer.mBlockCounter);
+}
+
+/**
+ * @brief
+ *  This function sends a BlockQueryV1 message for the given block of the given BDXTransfer.
+ *
+ * @param[in]      aXfer            The BDXTransfer we're sending a BlockQuery for.
+ * @param[in]      aBlockCounter    The block number to request.
+ *
+ * @retval         #WEAVE_NO_ERROR          If we successfully sent the message.
+ * @retval         #WEAVE_ERROR_NO_MEMORY   If no available PacketBuffers.
+ */
+WEAVE_ERROR SendBlockQueryCounterV1(BDXTransfer &aXfer, uint32_t aBlockCounter)
 {
     WEAVE_ERROR     err     = WEAVE_NO_ERROR;
     PacketBuffer*   buffer  = PacketBuffer::NewWithAvailableSize(BlockQueryV1::kPayloadLen);
@@ -276,7 +346,7 @@ WEAVE_ERROR SendBlockQueryV1(BDXTransfer &aXfer)
 
     VerifyOrExit(buffer != NULL, err = WEAVE_ERROR_NO_MEMORY);
 
-    SuccessOrExit(err = outMsg.init(aXfer.mBlockCounter));
+    SuccessOrExit(err = outMsg.init(aBlockCounter));
     SuccessOrExit(err = outMsg.pack(buffer));
 
     flags = aXfer.GetDefaultFlags(true);
@@ -627,6 +697,20 @@ WEAVE_ERROR SendNextBlockV1(BDXTransfer &aXfer)
 
     err = aXfer.mExchangeContext->SendMessage(kWeaveProfile_BDX, msgType, buffer, flags);
     buffer = NULL;
+    SuccessOrExit(err);
+
+#if WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+    aXfer.mSentLength += length;
+    aXfer.mSentBlockEnd[aXfer.mBlockCounter % WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE] = aXfer.mSentLength;
+#endif // WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+
+#if WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 1
+    if (isLast)
+    {
+        aXfer.mEOFBlockKnown = true;
+        aXfer.mEOFBlockCounter = aXfer.mBlockCounter;
+    }
+#endif // WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 1
 
 exit:
     if (buffer != NULL)
@@ -637,6 +721,63 @@ exit:
     return err;
 }
 
+#if WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 1
+/**
+ * @brief
+ *  This function sends BlockSendV1 messages for a windowed BDXTransfer until
+ *  the window is full or the last block has been sent.
+ *
+ *  When the sender drives, the window is opened by cumulative BlockAckV1
+ *  messages; when the receiver drives, each BlockQueryV1 opens it up to the
+ *  block queried.
+ *
+ * @param[in]       aXfer   The windowed BDXTransfer to send blocks for
+ *
+ * @retval          #WEAVE_NO_ERROR     If all the blocks the window allows were sent
+ */
+WEAVE_ERROR SendBlockWindowV1(BDXTransfer &aXfer)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    while (!aXfer.mEOFBlockKnown && aXfer.mBlockCounter < aXfer.mWindowLimit)
+    {
+        err = SendNextBlockV1(aXfer);
+        SuccessOrExit(err);
+
+        aXfer.mBlockCounter++;
+    }
+
+exit:
+    return err;
+}
+
+/**
+ * @brief
+ *  This function sends BlockQueryV1 messages for a windowed BDXTransfer until
+ *  mWindowSize blocks past the next expected one have been queried, or the
+ *  last block has been received.
+ *
+ * @param[in]       aXfer   The windowed BDXTransfer to query blocks for
+ *
+ * @retval          #WEAVE_NO_ERROR     If all the queries the window allows were sent
+ */
+WEAVE_ERROR SendBlockQueryWindowV1(BDXTransfer &aXfer)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    while (!aXfer.mEOFBlockKnown && aXfer.mWindowLimit < aXfer.mBlockCounter + aXfer.mWindowSize)
+    {
+        err = SendBlockQueryCounterV1(aXfer, aXfer.mWindowLimit);
+        SuccessOrExit(err);
+
+        aXfer.mWindowLimit++;
+    }
+
+exit:
+    return err;
+}
+#endif // WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 1
+
 /**
  * @brief
  *  The main handler for messages arriving on the BDX exchange.  It essentially
@@ -660,6 +801,14 @@ void HandleResponse(ExchangeContext *anEc, const IPPacketInfo *aPktInfo, const W
     VerifyOrExit(aProfileId == kWeaveProfile_BDX || (aProfileId == kWeaveProfile_Common && aMessageType == Common::kMsgType_StatusReport), err = WEAVE_ERROR_INVALID_PROFILE_ID);
     VerifyOrExit(xfer->mIsInitiated, err = WEAVE_ERROR_INCORRECT_STATE);
 
+    // Drop the transfer as if the peer went away, so that resuming can be tested
+    WEAVE_FAULT_INJECT(FaultInjection::kFault_BDXAbortTransfer,
+                       if (anEc->Con != NULL)
+                       {
+                           anEc->Con->Shutdown();
+                       }
+                       ExitNow(err = WEAVE_ERROR_CONNECTION_ABORTED));
+
     // (Re-)Initialize the next action to take
     xfer->mNext = NULL;
 
@@ -869,6 +1018,14 @@ WEAVE_ERROR HandleResponseTransmit(BDXTransfer &aXfer, uint32_t aProfileId, uint
     }
     else if (aProfileId == kWeaveProfile_BDX)
     {
+#if WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 1
+        if (aXfer.mWindowSize > 1 &&
+            (aMessageType == kMsgType_BlockAckV1 || aMessageType == kMsgType_BlockQueryV1 || aMessageType == kMsgType_BlockEOFAckV1))
+        {
+            ExitNow(err = HandleResponseTransmitWindowV1(aXfer, aMessageType, aPacketBuffer));
+        }
+#endif // WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 1
+
         switch (aMessageType)
         {
 #if WEAVE_CONFIG_BDX_V0_SUPPORT
@@ -925,6 +1082,10 @@ WEAVE_ERROR HandleResponseTransmit(BDXTransfer &aXfer, uint32_t aProfileId, uint
 
                     if (rcvdCounter == aXfer.mBlockCounter)
                     {
+#if WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+                        VerifySentBlock(aXfer, rcvdCounter);
+#endif // WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+
                         // Update the counter and send the next block
                         aXfer.mBlockCounter++;
                         aXfer.mNext = SendNextBlockV1;
@@ -1002,6 +1163,11 @@ WEAVE_ERROR HandleResponseTransmit(BDXTransfer &aXfer, uint32_t aProfileId, uint
                     // Afterwards, check that the received counter is the one after our block counter
                     else if (rcvdCounter == aXfer.mBlockCounter + 1)
                     {
+#if WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+                        // Querying the next block implies the last one was received
+                        VerifySentBlock(aXfer, aXfer.mBlockCounter);
+#endif // WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+
                         // Increment block counter after verifying block query message + block counter if it isn't the first query
                         // This is because we need to stay on the same block counter if the receiver decides to send an ack
                         // Ex. Recv BlockQuery for #2, send Block #2, get ack back for #2. Need to have block counter on
@@ -1091,6 +1257,212 @@ exit:
 }
 #endif // WEAVE_CONFIG_BDX_CLIENT_SEND_SUPPORT
 
+#if WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 1
+/*
+ * the transfer is windowed and i'm the sender.
+ * If I'm driving, each ACK acknowledges every block up to the one it
+ * names and slides the window forward.
+ * Otherwise, each BlockQuery allows me to send every block up to
+ * the one it names.
+ */
+WEAVE_ERROR HandleResponseTransmitWindowV1(BDXTransfer &aXfer, uint8_t aMessageType, PacketBuffer *aPacketBuffer)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    BlockQueryV1 inMsg;
+    uint32_t rcvdCounter;
+
+    // BlockAckV1 and BlockEOFAckV1 share the BlockQueryV1 format
+    err = BlockQueryV1::parse(aPacketBuffer, inMsg);
+    VerifyOrExit(err == WEAVE_NO_ERROR, WeaveLogDetail(BDX, "Windowed block counter message parse failed."));
+
+    rcvdCounter = inMsg.mBlockCounter;
+
+    switch (aMessageType)
+    {
+        case kMsgType_BlockAckV1:
+            VerifyOrExit(aXfer.IsDriver() && !aXfer.IsAsync(), err = WEAVE_NO_ERROR);
+
+            if (rcvdCounter >= aXfer.mBlockCounter)
+            {
+                WeaveLogDetail(BDX, "Received ack for unsent block: %d, next: %d", rcvdCounter, aXfer.mBlockCounter);
+                aXfer.mNext = SendBadBlockCounterStatusReport;
+            }
+            else if (rcvdCounter + 1 + aXfer.mWindowSize > aXfer.mWindowLimit)
+            {
+#if WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+                VerifySentBlock(aXfer, rcvdCounter);
+#endif // WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+
+                aXfer.mWindowLimit = rcvdCounter + 1 + aXfer.mWindowSize;
+                aXfer.mNext = SendBlockWindowV1;
+            }
+            // Otherwise this is a duplicate or out of date ack, ignore it
+
+            break;
+
+        case kMsgType_BlockQueryV1:
+            VerifyOrExit(!aXfer.IsDriver() && !aXfer.IsAsync(), err = WEAVE_ERROR_INVALID_MESSAGE_TYPE);
+
+            if (aXfer.mEOFBlockKnown)
+            {
+                // The receiver queries ahead without knowing where the transfer ends
+                WeaveLogDetail(BDX, "Ignoring query for block %d past the last block", rcvdCounter);
+            }
+            else if (rcvdCounter >= aXfer.mBlockCounter + aXfer.mWindowSize)
+            {
+                WeaveLogDetail(BDX, "Received query outside the window: %d, next: %d", rcvdCounter, aXfer.mBlockCounter);
+                aXfer.mNext = SendBadBlockCounterStatusReport;
+            }
+            else if (rcvdCounter >= aXfer.mWindowLimit)
+            {
+#if WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+                // The receiver only queries a window past the next block it
+                // expects, so every block before that window was received
+                if (rcvdCounter >= aXfer.mWindowSize)
+                {
+                    VerifySentBlock(aXfer, rcvdCounter - aXfer.mWindowSize);
+                }
+#endif // WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+
+                aXfer.mWindowLimit = rcvdCounter + 1;
+                aXfer.mNext = SendBlockWindowV1;
+            }
+
+            break;
+
+        case kMsgType_BlockEOFAckV1:
+            if (aXfer.mEOFBlockKnown && rcvdCounter == aXfer.mEOFBlockCounter)
+            {
+                aXfer.mIsCompletedSuccessfully = true;
+                aXfer.DispatchXferDoneHandler();
+                aXfer.mFirstQuery = true;
+            }
+            else
+            {
+                WeaveLogDetail(BDX, "Received bad block counter: %d, expected: %d", rcvdCounter, aXfer.mEOFBlockCounter);
+                aXfer.mNext = SendBadBlockCounterStatusReport;
+            }
+
+            break;
+
+        default:
+            err = WEAVE_ERROR_INVALID_MESSAGE_TYPE;
+            break;
+    }
+
+exit:
+    if (err != WEAVE_NO_ERROR)
+    {
+        WeaveLogError(BDX, "HandleResponseTransmitWindowV1 exit with error: %d", err);
+    }
+
+    return err;
+}
+
+/*
+ * the transfer is windowed and i'm the receiver. Blocks are delivered
+ * in order: a block that arrives ahead of the next expected one is held
+ * until the blocks before it arrive, so a lost block is resent on its
+ * own by the transport rather than with the rest of the window. Once the
+ * next expected block is delivered, I ACK it (acknowledging every block
+ * before it too) or, if I'm driving, query further blocks.
+ */
+WEAVE_ERROR HandleResponseReceiveWindowV1(BDXTransfer &aXfer, uint8_t aMessageType, PacketBuffer *aPacketBuffer)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    BlockSendV1 block;
+    uint32_t offset;
+    bool isLast;
+
+    // BlockEOFV1 shares the BlockSendV1 format
+    err = BlockSendV1::parse(aPacketBuffer, block);
+    VerifyOrExit(err == WEAVE_NO_ERROR, WeaveLogDetail(BDX, "BlockSendV1 parse failed."));
+
+    if (block.mBlockCounter < aXfer.mBlockCounter)
+    {
+        WeaveLogDetail(BDX, "Ignoring duplicate block: %d", block.mBlockCounter);
+        ExitNow();
+    }
+
+    offset = block.mBlockCounter - aXfer.mBlockCounter;
+
+    if (offset >= aXfer.mWindowSize ||
+        (aXfer.mEOFBlockKnown && block.mBlockCounter > aXfer.mEOFBlockCounter) ||
+        (aXfer.mEOFBlockKnown && aMessageType == kMsgType_BlockEOFV1 && block.mBlockCounter != aXfer.mEOFBlockCounter))
+    {
+        WeaveLogDetail(BDX, "Received bad block counter: %d, expected: %d", block.mBlockCounter, aXfer.mBlockCounter);
+        aXfer.mNext = SendBadBlockCounterStatusReport;
+        ExitNow();
+    }
+
+    if (aMessageType == kMsgType_BlockEOFV1)
+    {
+        aXfer.mEOFBlockKnown = true;
+        aXfer.mEOFBlockCounter = block.mBlockCounter;
+    }
+
+    if (offset > 0)
+    {
+        if (aXfer.mPendingBlocks[offset - 1] == NULL)
+        {
+            aPacketBuffer->AddRef();
+            aXfer.mPendingBlocks[offset - 1] = aPacketBuffer;
+        }
+
+        ExitNow();
+    }
+
+    isLast = aXfer.mEOFBlockKnown && block.mBlockCounter == aXfer.mEOFBlockCounter;
+    aXfer.DispatchPutBlockHandler(block.mLength, block.mData, isLast);
+
+    // Deliver any held blocks that are now in order.  Stop if the
+    // PutBlockHandler shut the transfer down.
+    while (!isLast && aXfer.mIsAccepted)
+    {
+        PacketBuffer *next = aXfer.mPendingBlocks[0];
+        BlockSendV1 pending;
+
+        aXfer.mBlockCounter++;
+
+        memmove(&aXfer.mPendingBlocks[0], &aXfer.mPendingBlocks[1], sizeof(aXfer.mPendingBlocks) - sizeof(aXfer.mPendingBlocks[0]));
+        aXfer.mPendingBlocks[ArraySize(aXfer.mPendingBlocks) - 1] = NULL;
+
+        if (next == NULL)
+        {
+            break;
+        }
+
+        err = BlockSendV1::parse(next, pending);
+        PacketBuffer::Free(next);
+        VerifyOrExit(err == WEAVE_NO_ERROR, WeaveLogDetail(BDX, "BlockSendV1 parse failed."));
+
+        isLast = aXfer.mEOFBlockKnown && pending.mBlockCounter == aXfer.mEOFBlockCounter;
+        aXfer.DispatchPutBlockHandler(pending.mLength, pending.mData, isLast);
+    }
+
+    VerifyOrExit(aXfer.mIsAccepted, WeaveLogDetail(BDX, "Transfer shut down while delivering blocks"));
+
+    if (isLast)
+    {
+        // SendBlockEOFAckV1 acknowledges mBlockCounter, which is the last block
+        aXfer.mNext = SendBlockEOFAckV1;
+    }
+    else
+    {
+        // SendBlockAckV1 acknowledges mBlockCounter - 1, the last block delivered
+        aXfer.mNext = aXfer.IsDriver() ? SendBlockQueryWindowV1 : SendBlockAckV1;
+    }
+
+exit:
+    if (err != WEAVE_NO_ERROR)
+    {
+        WeaveLogError(BDX, "HandleResponseReceiveWindowV1 exit with error: %d", err);
+    }
+
+    return err;
+}
+#endif // WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 1
+
 #if WEAVE_CONFIG_BDX_CLIENT_RECEIVE_SUPPORT
 /*
  * otherwise, I'm the receiver. I should expect to get
@@ -1114,6 +1486,13 @@ WEAVE_ERROR HandleResponseReceive(BDXTransfer &aXfer, uint32_t aProfileId, uint8
     }
     else if (aProfileId == kWeaveProfile_BDX)
     {
+#if WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 1
+        if (aXfer.mWindowSize > 1 && (aMessageType == kMsgType_BlockSendV1 || aMessageType == kMsgType_BlockEOFV1))
+        {
+            ExitNow(err = HandleResponseReceiveWindowV1(aXfer, aMessageType, aPacketBuffer));
+        }
+#endif // WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 1
+
         switch (aMessageType)
         {
 #if WEAVE_CONFIG_BDX_V0_SUPPORT
@@ -1306,6 +1685,7 @@ WEAVE_ERROR HandleResponseNotAccepted(BDXTransfer &aXfer, uint32_t aProfileId, u
                     aXfer.mMaxBlockSize = inMsg.mMaxBlockSize;
                     aXfer.mTransferMode = inMsg.mTransferMode;
                     aXfer.mVersion = inMsg.mVersion;
+                    aXfer.mWindowSize = GetAcceptedWindowSize(inMsg.mVersion, inMsg.mWindowSize, aXfer.mWindowSize);
                     err = aXfer.DispatchSendAccept(&inMsg);
                     VerifyOrExit(err == WEAVE_NO_ERROR, WeaveLogDetail(BDX, "DispatchSendAccept failed."));
 
@@ -1322,6 +1702,14 @@ WEAVE_ERROR HandleResponseNotAccepted(BDXTransfer &aXfer, uint32_t aProfileId, u
 #else
                             aXfer.mNext = aXfer.mVersion == 1 ? SendNextBlockV1 : NULL;
 #endif // WEAVE_CONFIG_BDX_V0_SUPPORT
+
+#if WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 1
+                            if (aXfer.mWindowSize > 1)
+                            {
+                                aXfer.mWindowLimit = aXfer.mWindowSize;
+                                aXfer.mNext = SendBlockWindowV1;
+                            }
+#endif // WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 1
                             break;
 
                         case kMode_ReceiverDrive:
@@ -1380,6 +1768,7 @@ WEAVE_ERROR HandleResponseNotAccepted(BDXTransfer &aXfer, uint32_t aProfileId, u
                     aXfer.mMaxBlockSize = inMsg.mMaxBlockSize;
                     aXfer.mTransferMode = inMsg.mTransferMode;
                     aXfer.mVersion = inMsg.mVersion;
+                    aXfer.mWindowSize = GetAcceptedWindowSize(inMsg.mVersion, inMsg.mWindowSize, aXfer.mWindowSize);
                     aXfer.mLength = inMsg.mLength;
                     err = aXfer.DispatchReceiveAccept(&inMsg);
                     VerifyOrExit(err == WEAVE_NO_ERROR, WeaveLogDetail(BDX, "DispatchReceiveAccept failed."));
@@ -1402,6 +1791,13 @@ WEAVE_ERROR HandleResponseNotAccepted(BDXTransfer &aXfer, uint32_t aProfileId, u
                             aXfer.mNext = aXfer.mVersion == 1 ? SendBlockQueryV1 : NULL;
 #endif // WEAVE_CONFIG_BDX_V0_SUPPORT
 
+#if WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 1
+                            if (aXfer.mWindowSize > 1)
+                            {
+                                aXfer.mNext = SendBlockQueryWindowV1;
+                            }
+#endif // WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 1
+
                             break;
 
                         case kMode_Asynchronous:
@@ -62,10 +62,18 @@ WEAVE_ERROR SendBlockQuery(BDXTransfer &aXfer);
 
 WEAVE_ERROR SendBlockQueryV1(BDXTransfer &aXfer);
 
+WEAVE_ERROR SendBlockQueryCounterV1(BDXTransfer &aXfer, uint32_t aBlockCounter);
+
 WEAVE_ERROR SendNextBlock(BDXTransfer &aXfer);
 
 WEAVE_ERROR SendNextBlockV1(BDXTransfer &aXfer);
 
+#if WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 1
+WEAVE_ERROR SendBlockWindowV1(BDXTransfer &aXfer);
+
+WEAVE_ERROR SendBlockQueryWindowV1(BDXTransfer &aXfer);
+#endif // WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 1
+
 // The following handlers are stateless callbacks meant to be passed to the
 // ExchangeContext in order to handle incoming BDX messages.
 // They handle the actual BDX protocol interaction and defer to the previously
@@ -98,6 +106,12 @@ WEAVE_ERROR HandleResponseReceive(BDXTransfer &aXfer, uint32_t aProfileId,
 WEAVE_ERROR HandleResponseNotAccepted(BDXTransfer &aXfer, uint32_t aProfileId,
                                       uint8_t aMessageType, PacketBuffer *aPacketBuffer);
 
+#if WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 1
+WEAVE_ERROR HandleResponseTransmitWindowV1(BDXTransfer &aXfer, uint8_t aMessageType, PacketBuffer *aPacketBuffer);
+
+WEAVE_ERROR HandleResponseReceiveWindowV1(BDXTransfer &aXfer, uint8_t aMessageType, PacketBuffer *aPacketBuffer);
+#endif // WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 1
+
 } // namespace BdxProtocol
 } // namespace BulkDataTransfer
 } // namespace Profiles
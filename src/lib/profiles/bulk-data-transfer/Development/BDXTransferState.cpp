@@ -22,6 +22,16 @@
  *      the state of an ongoing transfer and is managed by the BdxNode.
  */
 
+// __STDC_FORMAT_MACROS must be defined for PRIu64 to be defined for pre-C++11 clib
+#ifndef __STDC_FORMAT_MACROS
+#define __STDC_FORMAT_MACROS
+#endif // __STDC_FORMAT_MACROS
+
+#include <inttypes.h>
+#include <string.h>
+
+#include <Weave/Core/WeaveEncoding.h>
+#include <Weave/Support/CodeUtils.h>
 #include <Weave/Support/logging/WeaveLogging.h>
 
 #include <Weave/Profiles/bulk-data-transfer/Development/BDXTransferState.h>
@@ -33,6 +43,16 @@ namespace WeaveMakeManagedNamespaceIdentifier(BDX, kWeaveManagedNamespaceDesigna
 
 using namespace nl::Weave::Logging;
 
+#if WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+enum
+{
+    kCheckpointVersion          = 2,
+
+    kCheckpointFlag_AmSender    = 0x01,
+    kCheckpointFlag_BlockHash   = 0x02,
+};
+#endif // WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+
 /**
  * @brief
  *      Shuts down the current transfer, including closing any open ExchangeContext.
@@ -53,6 +73,10 @@ using namespace nl::Weave::Logging;
  */
 void BDXTransfer::Shutdown(void)
 {
+#if WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 1
+    ReleasePendingBlocks();
+#endif // WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 1
+
     if (mExchangeContext != NULL)
     {
         if (mIsCompletedSuccessfully)
@@ -83,6 +107,7 @@ void BDXTransfer::Reset(void)
     mLength                         = 0;
     mBytesSent                      = 0;
     mBlockCounter                   = 0;
+    mWindowSize                     = 1;
     mIsWideRange                    = false;
     mIsCompletedSuccessfully        = false;
     mAmInitiator                    = false;
@@ -95,6 +120,30 @@ void BDXTransfer::Reset(void)
     mHandlers.mXferErrorHandler     = NULL;
     mHandlers.mXferDoneHandler      = NULL;
     mHandlers.mErrorHandler         = NULL;
+
+#if WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 1
+    mWindowLimit                    = 0;
+    mEOFBlockCounter                = 0;
+    mEOFBlockKnown                  = false;
+
+    for (size_t i = 0; i < ArraySize(mPendingBlocks); i++)
+    {
+        mPendingBlocks[i] = NULL;
+    }
+#endif // WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 1
+
+#if WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT
+    mHashBlocks                     = false;
+    mBlockHashLength                = 0;
+    mBlockHashPendingLength         = 0;
+#endif // WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT
+
+#if WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+    mVerifiedLength                 = 0;
+    mSentLength                     = 0;
+    mCheckpointLength               = 0;
+    mHandlers.mCheckpointHandler    = NULL;
+#endif // WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
 }
 
 /**
@@ -155,6 +204,307 @@ uint16_t BDXTransfer::GetDefaultFlags(bool aExpectResponse)
             (GetBDXAckFlag(mExchangeContext)));
 }
 
+/**
+ * @brief
+ *  Returns the window size this node can use for this transfer, given the
+ *  one proposed by the initiator or counterpart.
+ *
+ *  Windowed transfers are only used with BDX V1 over transports that deliver
+ *  every message, i.e. TCP or WRMP, and are limited to
+ *  #WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE blocks.
+ *
+ * @param[in]   aProposedWindowSize The proposed number of outstanding blocks
+ *
+ * @return The window size to use, 1 for a lock-step transfer
+ */
+uint8_t BDXTransfer::GetSupportedWindowSize(uint8_t aProposedWindowSize)
+{
+    uint8_t windowSize = 1;
+
+#if WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 1
+    if (mExchangeContext != NULL &&
+        (mExchangeContext->Con != NULL || GetBDXAckFlag(mExchangeContext) != 0))
+    {
+        windowSize = (aProposedWindowSize > WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE) ? WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE : aProposedWindowSize;
+    }
+
+    if (windowSize == 0)
+    {
+        windowSize = 1;
+    }
+#endif // WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 1
+
+    return windowSize;
+}
+
+#if WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 1
+/**
+ * @brief
+ *  Frees any blocks a windowed receiver is holding for in-order delivery.
+ */
+void BDXTransfer::ReleasePendingBlocks(void)
+{
+    for (size_t i = 0; i < ArraySize(mPendingBlocks); i++)
+    {
+        if (mPendingBlocks[i] != NULL)
+        {
+            PacketBuffer::Free(mPendingBlocks[i]);
+            mPendingBlocks[i] = NULL;
+        }
+    }
+}
+#endif // WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 1
+
+#if WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT
+/**
+ * @brief
+ *  Starts computing a SHA-256 hash over the blocks this transfer delivers to
+ *  its PutBlockHandler.
+ *
+ *  Blocks are hashed in order as they arrive, so a receiver can verify the
+ *  integrity of the transferred data without reading it back once the
+ *  transfer is done.  Call this before the first block is received.
+ */
+void BDXTransfer::StartBlockHash(void)
+{
+    mBlockHash.Begin();
+    mHashBlocks = true;
+    mBlockHashLength = 0;
+    mBlockHashPendingLength = 0;
+}
+
+/**
+ * @brief
+ *  Finishes the hash started by StartBlockHash() and stops hashing blocks.
+ *
+ * @param[out]  aHashBuf    Buffer of at least Platform::Security::SHA256::kHashLength
+ *                          bytes that receives the hash
+ *
+ * @retval  #WEAVE_NO_ERROR                 If the hash was written to aHashBuf
+ * @retval  #WEAVE_ERROR_INCORRECT_STATE    If StartBlockHash() was not called, or the data
+ *                                          before a resumed transfer was not re-hashed
+ */
+WEAVE_ERROR BDXTransfer::FinishBlockHash(uint8_t *aHashBuf)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    VerifyOrExit(mHashBlocks && mBlockHashPendingLength == 0, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    mBlockHash.Finish(aHashBuf);
+    mHashBlocks = false;
+
+exit:
+    return err;
+}
+
+#if WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+/**
+ * @brief
+ *  Re-hashes data the receiver already holds, for a transfer resumed from a
+ *  checkpoint that was hashing its blocks.
+ *
+ *  The hash state itself is not checkpointed, so after ResumeFromCheckpoint()
+ *  the application passes the last mBlockHashPendingLength bytes before the
+ *  start offset through here, in order, before the transfer is started.
+ *
+ * @param[in]   aData       Data to hash
+ * @param[in]   aLength     Length of aData
+ *
+ * @retval  #WEAVE_NO_ERROR                 If the data was hashed
+ * @retval  #WEAVE_ERROR_INCORRECT_STATE    If no re-hashing is pending
+ * @retval  #WEAVE_ERROR_INVALID_ARGUMENT   If aLength is more than the data left to re-hash
+ */
+WEAVE_ERROR BDXTransfer::AddBlockHashData(const uint8_t *aData, uint32_t aLength)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    VerifyOrExit(mHashBlocks && mBlockHashPendingLength > 0, err = WEAVE_ERROR_INCORRECT_STATE);
+    VerifyOrExit(aLength <= mBlockHashPendingLength, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    mBlockHash.AddData(aData, aLength);
+    mBlockHashPendingLength -= aLength;
+
+exit:
+    return err;
+}
+#endif // WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+#endif // WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT
+
+#if WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+/**
+ * @brief
+ *  Encodes a checkpoint of this transfer that can later be passed to
+ *  ResumeFromCheckpoint() to continue the transfer where it left off.
+ *
+ *  The checkpoint records the peer node, the file designator, the direction
+ *  of the transfer, the offset up to which the data is verified and, if
+ *  received blocks are being hashed, how many bytes before that offset the
+ *  hash covers.  It is independent of the hash implementation, so it remains
+ *  valid across software updates.
+ *
+ *  A checkpoint cannot be taken while a resumed transfer is still waiting
+ *  for the data before its start offset to be re-hashed.
+ *
+ * @param[out]  aBuf            Buffer that receives the checkpoint
+ * @param[in]   aBufSize        Size of aBuf, kMaxCheckpointLength is always enough
+ * @param[out]  anEncodedLen    Length of the encoded checkpoint
+ *
+ * @retval  #WEAVE_NO_ERROR                     If the checkpoint was encoded
+ * @retval  #WEAVE_ERROR_INCORRECT_STATE        If the transfer has no exchange, or is
+ *                                              still re-hashing data before its start offset
+ * @retval  #WEAVE_ERROR_INVALID_STRING_LENGTH  If the file designator is too long to be recorded
+ * @retval  #WEAVE_ERROR_BUFFER_TOO_SMALL       If aBuf is too small
+ */
+WEAVE_ERROR BDXTransfer::EncodeCheckpoint(uint8_t *aBuf, uint16_t aBufSize, uint16_t &anEncodedLen)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    uint8_t *p = aBuf;
+    uint8_t flags = mAmSender ? kCheckpointFlag_AmSender : 0;
+    uint16_t len = 20 + mFileDesignator.theLength;
+
+    VerifyOrExit(mExchangeContext != NULL, err = WEAVE_ERROR_INCORRECT_STATE);
+    VerifyOrExit(mFileDesignator.theLength <= WEAVE_CONFIG_BDX_CHECKPOINT_MAX_FILE_DESIGNATOR_LENGTH,
+                 err = WEAVE_ERROR_INVALID_STRING_LENGTH);
+
+#if WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT
+    if (mHashBlocks)
+    {
+        VerifyOrExit(mBlockHashPendingLength == 0, err = WEAVE_ERROR_INCORRECT_STATE);
+
+        flags |= kCheckpointFlag_BlockHash;
+        len += 8;
+    }
+#endif // WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT
+
+    VerifyOrExit(aBufSize >= len, err = WEAVE_ERROR_BUFFER_TOO_SMALL);
+
+    Encoding::Write8(p, kCheckpointVersion);
+    Encoding::Write8(p, flags);
+    Encoding::LittleEndian::Write64(p, mExchangeContext->PeerNodeId);
+    Encoding::LittleEndian::Write64(p, mStartOffset + mVerifiedLength);
+    Encoding::LittleEndian::Write16(p, mFileDesignator.theLength);
+    memcpy(p, mFileDesignator.theString, mFileDesignator.theLength);
+    p += mFileDesignator.theLength;
+
+#if WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT
+    if (mHashBlocks)
+    {
+        Encoding::LittleEndian::Write64(p, mBlockHashLength);
+    }
+#endif // WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT
+
+    anEncodedLen = len;
+
+exit:
+    return err;
+}
+
+/**
+ * @brief
+ *  Sets up a new transfer to resume from a checkpoint made by EncodeCheckpoint().
+ *
+ *  Call this after NewTransfer() and before InitBdxSend() or InitBdxReceive().
+ *  The transfer's start offset is set to the checkpointed offset, so the
+ *  SendInit or ReceiveInit asks the peer to start there.  If received
+ *  blocks were being hashed, the hash is restarted and mBlockHashPendingLength
+ *  is set to the number of bytes before the start offset the application
+ *  must pass to AddBlockHashData() to bring it back up to date.  The
+ *  application is responsible for positioning its own data at the start
+ *  offset.  A peer that cannot start at that offset rejects the transfer
+ *  with kStatus_StartOffsetNotSupported, in which case the checkpoint should
+ *  be discarded and the transfer restarted from the beginning.
+ *
+ * @param[in]   aBuf        The checkpoint
+ * @param[in]   aBufLen     Length of the checkpoint
+ * @param[in]   aAmSender   True if this transfer will send the file
+ *
+ * @retval  #WEAVE_NO_ERROR                 If the transfer will resume from the checkpoint
+ * @retval  #WEAVE_ERROR_INCORRECT_STATE    If the transfer has no exchange
+ * @retval  #WEAVE_ERROR_INVALID_ARGUMENT   If the checkpoint is malformed or of an
+ *                                          unsupported version
+ * @retval  #WEAVE_ERROR_WRONG_NODE_ID      If the checkpoint was made for a different peer
+ * @retval  #WEAVE_ERROR_INVALID_TRANSFER_MODE  If the checkpoint was made for a transfer of a
+ *                                          different file or in the other direction
+ */
+WEAVE_ERROR BDXTransfer::ResumeFromCheckpoint(const uint8_t *aBuf, uint16_t aBufLen, bool aAmSender)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    const uint8_t *p = aBuf;
+    const uint8_t *end = aBuf + aBufLen;
+    uint8_t flags;
+    uint64_t peerNodeId;
+    uint64_t offset;
+    uint16_t designatorLen;
+#if WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT
+    uint64_t hashedLength;
+#endif // WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT
+
+    VerifyOrExit(mExchangeContext != NULL, err = WEAVE_ERROR_INCORRECT_STATE);
+    VerifyOrExit(aBufLen >= 20, err = WEAVE_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(Encoding::Read8(p) == kCheckpointVersion, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    flags = Encoding::Read8(p);
+    peerNodeId = Encoding::LittleEndian::Read64(p);
+    offset = Encoding::LittleEndian::Read64(p);
+    designatorLen = Encoding::LittleEndian::Read16(p);
+
+    VerifyOrExit(designatorLen <= end - p, err = WEAVE_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(peerNodeId == mExchangeContext->PeerNodeId, err = WEAVE_ERROR_WRONG_NODE_ID);
+    VerifyOrExit(((flags & kCheckpointFlag_AmSender) != 0) == aAmSender, err = WEAVE_ERROR_INVALID_TRANSFER_MODE);
+    VerifyOrExit(designatorLen == mFileDesignator.theLength &&
+                 memcmp(p, mFileDesignator.theString, designatorLen) == 0,
+                 err = WEAVE_ERROR_INVALID_TRANSFER_MODE);
+    p += designatorLen;
+
+    if (flags & kCheckpointFlag_BlockHash)
+    {
+#if WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT
+        VerifyOrExit(end - p >= 8, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+        hashedLength = Encoding::LittleEndian::Read64(p);
+        VerifyOrExit(hashedLength <= offset, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+        mBlockHash.Begin();
+        mHashBlocks = true;
+        mBlockHashLength = hashedLength;
+        mBlockHashPendingLength = hashedLength;
+#else
+        ExitNow(err = WEAVE_ERROR_INVALID_ARGUMENT);
+#endif // WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT
+    }
+
+    mStartOffset        = offset;
+    mVerifiedLength     = 0;
+    mSentLength         = 0;
+    mCheckpointLength   = 0;
+
+    WeaveLogDetail(BDX, "Resuming transfer at offset %" PRIu64, offset);
+
+exit:
+    return err;
+}
+
+/**
+ * @brief
+ *  Records that the receiver holds aVerifiedLength bytes past the start
+ *  offset and dispatches the CheckpointHandler if at least
+ *  #WEAVE_CONFIG_BDX_CHECKPOINT_INTERVAL bytes were verified since the last
+ *  checkpoint.
+ *
+ * @param[in]   aVerifiedLength     Number of bytes past mStartOffset that are verified
+ */
+void BDXTransfer::UpdateVerifiedLength(uint64_t aVerifiedLength)
+{
+    mVerifiedLength = aVerifiedLength;
+
+    if (mVerifiedLength - mCheckpointLength >= WEAVE_CONFIG_BDX_CHECKPOINT_INTERVAL)
+    {
+        mCheckpointLength = mVerifiedLength;
+        DispatchCheckpointHandler();
+    }
+}
+#endif // WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+
 /**
  * @brief
  *  If the receive accept handler has been set, call it.
@@ -223,10 +573,27 @@ void BDXTransfer::DispatchPutBlockHandler(uint64_t aLength,
                                           uint8_t *aDataBlock,
                                           bool aLastBlock)
 {
+#if WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT
+    if (mHashBlocks && aLength > 0)
+    {
+        mBlockHash.AddData(aDataBlock, static_cast<uint16_t>(aLength));
+        mBlockHashLength += aLength;
+    }
+#endif // WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT
+
     if (mHandlers.mPutBlockHandler)
     {
         mHandlers.mPutBlockHandler(this, aLength, aDataBlock, aLastBlock);
     }
+
+#if WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+    // The handler may have shut the transfer down, and there is nothing left
+    // to resume once the last block is stored.
+    if (mIsAccepted && !aLastBlock)
+    {
+        UpdateVerifiedLength(mVerifiedLength + aLength);
+    }
+#endif // WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
 }
 
 /**
@@ -302,6 +669,21 @@ void BDXTransfer::DispatchXferDoneHandler(void)
     }
 }
 
+#if WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+/**
+ * @brief
+ *  If the checkpoint handler has been set, call it with the offset up to
+ *  which the transfer is verified.
+ */
+void BDXTransfer::DispatchCheckpointHandler(void)
+{
+    if (mHandlers.mCheckpointHandler)
+    {
+        mHandlers.mCheckpointHandler(this, mStartOffset + mVerifiedLength);
+    }
+}
+#endif // WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+
 } // namespace BulkDataTransfer
 } // namespace Profiles
 } // namespace Weave
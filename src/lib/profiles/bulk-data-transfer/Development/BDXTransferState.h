@@ -31,6 +31,10 @@
 #include <Weave/Profiles/bulk-data-transfer/Development/BDXConstants.h>
 #include <Weave/Profiles/bulk-data-transfer/Development/BDXMessages.h>
 
+#if WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT
+#include <Weave/Support/crypto/HashAlgos.h>
+#endif // WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT
+
 namespace nl {
 namespace Weave {
 namespace Profiles {
@@ -227,6 +231,24 @@ typedef void (*XferDoneHandler)(BDXTransfer *aXfer);
 
 typedef void (*ErrorHandler)(BDXTransfer *aXfer, WEAVE_ERROR anErrorCode);
 
+#if WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+/**
+ * @brief
+ *  Handle a new checkpoint of the transfer.
+ *
+ *  Called each time the receiver is known to hold at least
+ *  WEAVE_CONFIG_BDX_CHECKPOINT_INTERVAL more bytes than at the previous
+ *  checkpoint.  The application should call aXfer->EncodeCheckpoint() and
+ *  persist the result, together with the data it has stored so far when it
+ *  is the receiver, so that an interrupted transfer can later be resumed
+ *  with BDXTransfer::ResumeFromCheckpoint().
+ *
+ * @param[in]   aXfer           Pointer to the BDXTransfer associated with this transfer
+ * @param[in]   anOffset        Offset in the file up to which the data is verified
+ */
+typedef void (*CheckpointHandler)(BDXTransfer *aXfer, uint64_t anOffset);
+#endif // WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+
 struct BDXHandlers
 {
     SendAcceptHandler       mSendAcceptHandler;
@@ -237,6 +259,9 @@ struct BDXHandlers
     XferErrorHandler        mXferErrorHandler;
     XferDoneHandler         mXferDoneHandler;
     ErrorHandler            mErrorHandler;
+#if WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+    CheckpointHandler       mCheckpointHandler;
+#endif // WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
 };
 
 /** This structure contains data members representing an active BDX transfer.
@@ -251,6 +276,17 @@ struct BDXHandlers
  */
 struct BDXTransfer
 {
+#if WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+    enum
+    {
+        /** Largest checkpoint EncodeCheckpoint() can produce. */
+        kMaxCheckpointLength = 20 + WEAVE_CONFIG_BDX_CHECKPOINT_MAX_FILE_DESIGNATOR_LENGTH
+#if WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT
+                               + 8
+#endif // WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT
+    };
+#endif // WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+
     ExchangeContext *   mExchangeContext;
     void *              mAppState;
 
@@ -290,6 +326,42 @@ struct BDXTransfer
      */
     uint32_t            mBlockCounter;
 
+    /** Max number of blocks that may be outstanding at once, 1 for a lock-step
+     * transfer.  An initiator proposes this value in its init message; the
+     * negotiated value is set once the transfer is accepted.
+     */
+    uint8_t             mWindowSize;
+#if WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 1
+    /** Windowed transfers only. When sending, one past the last block we may
+     * send.  When receiving and driving, one past the last block we queried.
+     */
+    uint32_t            mWindowLimit;
+    uint32_t            mEOFBlockCounter;   // Counter of the BlockEOF, once it has been sent or received
+    bool                mEOFBlockKnown;     // true once the BlockEOF has been sent or received
+    // Blocks received ahead of mBlockCounter, held until the blocks before them arrive
+    PacketBuffer *      mPendingBlocks[WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE - 1];
+#endif // WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 1
+
+#if WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT
+    bool                mHashBlocks;    // true if received blocks are being hashed
+    Platform::Security::SHA256 mBlockHash; // SHA-256 over the blocks delivered so far
+    uint64_t            mBlockHashLength;   // Number of bytes the hash covers, ending at the verified offset
+    // Bytes before mStartOffset a transfer resumed from a checkpoint still has to re-hash
+    uint64_t            mBlockHashPendingLength;
+#endif // WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT
+
+#if WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+    /** Number of bytes past mStartOffset the receiver is known to hold: the
+     * bytes delivered in order to the PutBlockHandler when receiving, or the
+     * bytes of all acknowledged blocks when sending.
+     */
+    uint64_t            mVerifiedLength;
+    uint64_t            mSentLength;        // Sending only: bytes past mStartOffset sent so far
+    // Sending only: mSentLength once each of the last blocks was sent, indexed by block counter
+    uint64_t            mSentBlockEnd[WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE];
+    uint64_t            mCheckpointLength;  // Value of mVerifiedLength at the last checkpoint
+#endif // WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+
     // application-supplied handlers
     //TODO: make these private when BdxProtocol doesn't inspect them directly
     //before calling DispatchGetBlockHandler().  We'll have to remove that check
@@ -310,6 +382,26 @@ struct BDXTransfer
 
     uint16_t GetDefaultFlags(bool aExpectResponse);
 
+    uint8_t GetSupportedWindowSize(uint8_t aProposedWindowSize);
+
+#if WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 1
+    void ReleasePendingBlocks(void);
+#endif // WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 1
+
+#if WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT
+    void StartBlockHash(void);
+    WEAVE_ERROR FinishBlockHash(uint8_t *aHashBuf);
+#if WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+    WEAVE_ERROR AddBlockHashData(const uint8_t *aData, uint32_t aLength);
+#endif // WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+#endif // WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT
+
+#if WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+    WEAVE_ERROR EncodeCheckpoint(uint8_t *aBuf, uint16_t aBufSize, uint16_t &aEncodedLen);
+    WEAVE_ERROR ResumeFromCheckpoint(const uint8_t *aBuf, uint16_t aBufLen, bool aAmSender);
+    void UpdateVerifiedLength(uint64_t aVerifiedLength);
+#endif // WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+
     /**
      * Dispatchers simply check whether a handler has been set and then call it if so.
      * Therefore, these should be used as the public interface for calling callbacks,
@@ -330,6 +422,9 @@ struct BDXTransfer
     void DispatchErrorHandler(WEAVE_ERROR anErrorCode);
     void DispatchXferErrorHandler(StatusReport *aXferError);
     void DispatchXferDoneHandler(void);
+#if WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+    void DispatchCheckpointHandler(void);
+#endif // WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
 };
 
 /**
@@ -27,9 +27,10 @@
 #ifndef _WEAVE_DATA_MANAGEMENT_GENERIC_TRAIT_CATALOG_IMPL_CURRENT_H
 #define _WEAVE_DATA_MANAGEMENT_GENERIC_TRAIT_CATALOG_IMPL_CURRENT_H
 
-#include <map>
 #include <queue>
 #include <limits>
+#include <vector>
+#include <unordered_map>
 #include <Weave/Profiles/data-management/Current/WdmManagedNamespace.h>
 #include <Weave/Profiles/data-management/TraitCatalog.h>
 
@@ -41,7 +42,9 @@ namespace WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNames
  *  @class GenericTraitCatalogImpl
  *
  *  @brief A Weave provided implementation of the TraitCatalogBase interface for a collection of trait data instances
- *         that all refer to the same resource. It provides a c++ map-backed storage for these instances.
+ *         that all refer to the same resource. Instances are stored in a flat slot array indexed by
+ *         TraitDataHandle, with secondary hash indexes on the trait path (profile id, instance id, resource id)
+ *         and on the trait instance pointer so that path resolution does not scale with the catalog size.
  */
 template <typename T>
 class GenericTraitCatalogImpl : public TraitCatalogBase<T>
@@ -93,11 +96,36 @@ private:
         PropertyPathHandle mBasePathHandle;
     };
 
+    struct CatalogKey
+    {
+        CatalogKey(uint32_t aProfileId, uint64_t aInstanceId, const ResourceIdentifier & aResourceId) :
+            mProfileId(aProfileId), mInstanceId(aInstanceId), mResourceId(aResourceId)
+        { }
+
+        bool operator==(const CatalogKey & aOther) const
+        {
+            return mProfileId == aOther.mProfileId && mInstanceId == aOther.mInstanceId && mResourceId == aOther.mResourceId;
+        }
+
+        uint32_t mProfileId;
+        uint64_t mInstanceId;
+        ResourceIdentifier mResourceId;
+    };
+
+    struct CatalogKeyHash
+    {
+        size_t operator()(const CatalogKey & aKey) const;
+    };
+
     TraitDataHandle GetNextHandle();
+    CatalogItem * GetItem(TraitDataHandle aHandle) const;
 
     uint64_t mNodeId;
-    std::map<TraitDataHandle, CatalogItem *> mItemStore;
+    uint32_t mItemCount;
+    std::vector<CatalogItem *> mItemStore;
     std::queue<TraitDataHandle> mRecycledHandles;
+    std::unordered_map<CatalogKey, TraitDataHandle, CatalogKeyHash> mPathIndex;
+    std::unordered_multimap<const T *, TraitDataHandle> mInstanceIndex;
 };
 
 typedef GenericTraitCatalogImpl<TraitDataSink> GenericTraitSinkCatalog;
@@ -19,9 +19,10 @@
 #ifndef GENERIC_TRAIT_CATALOG_IMPL_IPP
 #define GENERIC_TRAIT_CATALOG_IMPL_IPP
 
-#include <map>
 #include <queue>
 #include <limits>
+#include <vector>
+#include <unordered_map>
 #include <Weave/Profiles/data-management/Current/WdmManagedNamespace.h>
 #include <Weave/Profiles/data-management/TraitCatalog.h>
 
@@ -31,7 +32,7 @@ namespace Profiles {
 namespace WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current) {
 
 template <typename T>
-GenericTraitCatalogImpl<T>::GenericTraitCatalogImpl(void) : mNodeId(ResourceIdentifier::SELF_NODE_ID)
+GenericTraitCatalogImpl<T>::GenericTraitCatalogImpl(void) : mNodeId(ResourceIdentifier::SELF_NODE_ID), mItemCount(0)
 {
     // Nothing to do.
 }
@@ -48,6 +49,26 @@ void GenericTraitCatalogImpl<T>::SetNodeId(uint64_t aNodeId)
     mNodeId = aNodeId;
 }
 
+template <typename T>
+size_t GenericTraitCatalogImpl<T>::CatalogKeyHash::operator()(const CatalogKey & aKey) const
+{
+    // Mix the path components with the 64-bit golden ratio constant; collisions only cost an extra
+    // equality check in the bucket.
+    uint64_t hash = aKey.mInstanceId;
+
+    hash ^= aKey.mResourceId.GetResourceId() + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2);
+    hash ^= ((static_cast<uint64_t>(aKey.mResourceId.GetResourceType()) << 32) | aKey.mProfileId) + 0x9E3779B97F4A7C15ULL +
+        (hash << 6) + (hash >> 2);
+
+    return static_cast<size_t>(hash);
+}
+
+template <typename T>
+typename GenericTraitCatalogImpl<T>::CatalogItem * GenericTraitCatalogImpl<T>::GetItem(TraitDataHandle aHandle) const
+{
+    return (aHandle < mItemStore.size()) ? mItemStore[aHandle] : NULL;
+}
+
 template <typename T>
 WEAVE_ERROR GenericTraitCatalogImpl<T>::Add(const ResourceIdentifier & aResourceId, const uint64_t & aInstanceId,
                                             PropertyPathHandle basePathHandle, T * traitInstance, TraitDataHandle & aHandle)
@@ -57,7 +78,7 @@ WEAVE_ERROR GenericTraitCatalogImpl<T>::Add(const ResourceIdentifier & aResource
     TraitDataHandle handle;
 
     // Make sure there is space
-    VerifyOrExit(mItemStore.size() < std::numeric_limits<TraitDataHandle>::max(), err = WEAVE_ERROR_NO_MEMORY);
+    VerifyOrExit(mItemCount < std::numeric_limits<TraitDataHandle>::max(), err = WEAVE_ERROR_NO_MEMORY);
 
     // Create the CatalogItem
     item = new CatalogItem();
@@ -72,10 +93,22 @@ WEAVE_ERROR GenericTraitCatalogImpl<T>::Add(const ResourceIdentifier & aResource
     // Stop if this path already exists
     err = Locate(item->mProfileId, item->mInstanceId, item->mResourceId, handle);
     VerifyOrExit(err != WEAVE_NO_ERROR, err = WEAVE_ERROR_DUPLICATE_KEY_ID);
-    err                 = WEAVE_NO_ERROR;
-    // Store the item
-    aHandle             = GetNextHandle();
-    mItemStore[aHandle] = item;
+    err = WEAVE_NO_ERROR;
+
+    // Store the item and index it by path and by instance
+    aHandle = GetNextHandle();
+    if (aHandle == mItemStore.size())
+    {
+        mItemStore.push_back(item);
+    }
+    else
+    {
+        mItemStore[aHandle] = item;
+    }
+    mItemCount++;
+
+    mPathIndex.insert(std::make_pair(CatalogKey(item->mProfileId, item->mInstanceId, item->mResourceId), aHandle));
+    mInstanceIndex.insert(std::make_pair(traitInstance, aHandle));
 
 exit:
     if (err != WEAVE_NO_ERROR && item != NULL)
@@ -108,12 +141,27 @@ WEAVE_ERROR GenericTraitCatalogImpl<T>::Remove(TraitDataHandle aHandle)
     CatalogItem * item = NULL;
 
     // Make sure the handle exists
-    auto itemIterator = mItemStore.find(aHandle);
-    VerifyOrExit(itemIterator != mItemStore.end(), err = WEAVE_ERROR_INVALID_ARGUMENT);
+    item = GetItem(aHandle);
+    VerifyOrExit(item != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    // Drop the secondary indexes
+    mPathIndex.erase(CatalogKey(item->mProfileId, item->mInstanceId, item->mResourceId));
+
+    {
+        auto range = mInstanceIndex.equal_range(item->mItem);
+        for (auto indexIterator = range.first; indexIterator != range.second; indexIterator++)
+        {
+            if (indexIterator->second == aHandle)
+            {
+                mInstanceIndex.erase(indexIterator);
+                break;
+            }
+        }
+    }
 
     // Remove the item and delete it
-    item = itemIterator->second;
-    mItemStore.erase(itemIterator);
+    mItemStore[aHandle] = NULL;
+    mItemCount--;
     delete item;
     mRecycledHandles.push(aHandle);
 exit:
@@ -133,8 +181,8 @@ TraitDataHandle GenericTraitCatalogImpl<T>::GetNextHandle(void)
         rv = mRecycledHandles.front();
         mRecycledHandles.pop();
     }
-    // assert correctness: returned handle must not be an existing key in the map
-    VerifyOrDie(mItemStore.find(rv) == mItemStore.end());
+    // assert correctness: returned handle must not refer to an occupied slot
+    VerifyOrDie(GetItem(rv) == NULL);
 
     return rv;
 }
@@ -149,10 +197,13 @@ WEAVE_ERROR GenericTraitCatalogImpl<T>::Clear(void)
     // Loop through the items and remove them all
     for (auto itemIterator = mItemStore.begin(); itemIterator != mItemStore.end(); itemIterator++)
     {
-        item = itemIterator->second;
+        item = *itemIterator;
         delete item;
     }
     mItemStore.clear();
+    mItemCount = 0;
+    mPathIndex.clear();
+    mInstanceIndex.clear();
 
     std::swap(mRecycledHandles, empty);
 
@@ -216,13 +267,11 @@ WEAVE_ERROR GenericTraitCatalogImpl<T>::HandleToAddress(TraitDataHandle aHandle,
     TLV::TLVType type;
     CatalogItem * item = NULL;
     // Make sure the handle exists
-    auto itemIterator = mItemStore.find(aHandle);
-    VerifyOrExit(itemIterator != mItemStore.end(), err = WEAVE_ERROR_INVALID_ARGUMENT);
+    item = GetItem(aHandle);
+    VerifyOrExit(item != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
 
     VerifyOrExit(aSchemaVersionRange.IsValid(), err = WEAVE_ERROR_INVALID_ARGUMENT);
 
-    item = itemIterator->second;
-
     err = aWriter.StartContainer(TLV::ContextTag(Path::kCsTag_InstanceLocator), TLV::kTLVType_Structure, type);
     SuccessOrExit(err);
 
@@ -278,13 +327,13 @@ exit:
 template <typename T>
 WEAVE_ERROR GenericTraitCatalogImpl<T>::Locate(TraitDataHandle aHandle, T ** aTraitInstance) const
 {
-    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    WEAVE_ERROR err    = WEAVE_NO_ERROR;
+    CatalogItem * item = GetItem(aHandle);
     // Make sure the handle exists
-    auto itemIterator = mItemStore.find(aHandle);
-    VerifyOrExit(itemIterator != mItemStore.end(), err = WEAVE_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(item != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
 
     // Return the trait instance
-    *aTraitInstance = itemIterator->second->mItem;
+    *aTraitInstance = item->mItem;
 
 exit:
     return err;
@@ -294,15 +343,15 @@ template <typename T>
 WEAVE_ERROR GenericTraitCatalogImpl<T>::Locate(T * aTraitInstance, TraitDataHandle & aHandle) const
 {
     WEAVE_ERROR err = WEAVE_ERROR_INVALID_ARGUMENT;
-    // Iterate and find this trait instance
-    for (auto itemIterator = mItemStore.begin(); itemIterator != mItemStore.end(); itemIterator++)
+    auto range      = mInstanceIndex.equal_range(aTraitInstance);
+
+    // The same instance may be published under several paths; like a walk of the store would, return the lowest handle.
+    for (auto indexIterator = range.first; indexIterator != range.second; indexIterator++)
     {
-        CatalogItem * item = itemIterator->second;
-        if (aTraitInstance == item->mItem)
+        if (err != WEAVE_NO_ERROR || indexIterator->second < aHandle)
         {
-            aHandle = itemIterator->first;
+            aHandle = indexIterator->second;
             err     = WEAVE_NO_ERROR;
-            break;
         }
     }
 
@@ -313,17 +362,13 @@ template <typename T>
 WEAVE_ERROR GenericTraitCatalogImpl<T>::Locate(uint32_t aProfileId, uint64_t aInstanceId, ResourceIdentifier aResourceId,
                                                TraitDataHandle & aHandle) const
 {
-    WEAVE_ERROR err = WEAVE_ERROR_INVALID_PROFILE_ID;
-    // Loop through the items and check if the path matches
-    for (auto itemIterator = mItemStore.begin(); itemIterator != mItemStore.end(); itemIterator++)
+    WEAVE_ERROR err   = WEAVE_ERROR_INVALID_PROFILE_ID;
+    auto indexIterator = mPathIndex.find(CatalogKey(aProfileId, aInstanceId, aResourceId));
+
+    if (indexIterator != mPathIndex.end())
     {
-        CatalogItem * item = itemIterator->second;
-        if (item->mProfileId == aProfileId && item->mResourceId == aResourceId && item->mInstanceId == aInstanceId)
-        {
-            aHandle = itemIterator->first;
-            err     = WEAVE_NO_ERROR;
-            break;
-        }
+        aHandle = indexIterator->second;
+        err     = WEAVE_NO_ERROR;
     }
 
     return err;
@@ -333,19 +378,15 @@ template <typename T>
 WEAVE_ERROR GenericTraitCatalogImpl<T>::Locate(uint32_t aProfileId, uint64_t aInstanceId, ResourceIdentifier aResourceId,
                                                T ** aTraitInstance) const
 {
-    WEAVE_ERROR err = WEAVE_ERROR_INVALID_PROFILE_ID;
-    // Loop through the items and check if the path matches
-    for (auto itemIterator = mItemStore.begin(); itemIterator != mItemStore.end(); itemIterator++)
-    {
-        CatalogItem * item = itemIterator->second;
-        if (item->mProfileId == aProfileId && item->mResourceId == aResourceId && item->mInstanceId == aInstanceId)
-        {
-            *aTraitInstance = itemIterator->second->mItem;
-            err             = WEAVE_NO_ERROR;
-            break;
-        }
-    }
+    WEAVE_ERROR err;
+    TraitDataHandle handle;
+
+    err = Locate(aProfileId, aInstanceId, aResourceId, handle);
+    SuccessOrExit(err);
+
+    *aTraitInstance = mItemStore[handle]->mItem;
 
+exit:
     return err;
 }
 
@@ -356,8 +397,11 @@ WEAVE_ERROR GenericTraitCatalogImpl<T>::DispatchEvent(uint16_t aEvent, void * aC
     // Send the event to all the items
     for (auto itemIterator = mItemStore.begin(); itemIterator != mItemStore.end(); itemIterator++)
     {
-        CatalogItem * item = itemIterator->second;
-        item->mItem->OnEvent(aEvent, aContext);
+        CatalogItem * item = *itemIterator;
+        if (item != NULL)
+        {
+            item->mItem->OnEvent(aEvent, aContext);
+        }
     }
 
     return err;
@@ -367,9 +411,13 @@ template <typename T>
 void GenericTraitCatalogImpl<T>::Iterate(IteratorCallback aCallback, void * aContext)
 {
     // Send the event to all the items
-    for (auto itemIterator = mItemStore.begin(); itemIterator != mItemStore.end(); itemIterator++)
+    for (size_t handle = 0; handle < mItemStore.size(); handle++)
     {
-        aCallback(itemIterator->second->mItem, itemIterator->first, aContext);
+        CatalogItem * item = mItemStore[handle];
+        if (item != NULL)
+        {
+            aCallback(item->mItem, static_cast<TraitDataHandle>(handle), aContext);
+        }
     }
 }
 
@@ -377,13 +425,13 @@ void GenericTraitCatalogImpl<T>::Iterate(IteratorCallback aCallback, void * aCon
 template <typename T>
 WEAVE_ERROR GenericTraitCatalogImpl<T>::GetInstanceId(TraitDataHandle aHandle, uint64_t & aInstanceId) const
 {
-    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    WEAVE_ERROR err    = WEAVE_NO_ERROR;
+    CatalogItem * item = GetItem(aHandle);
     // Make sure the handle exists
-    auto itemIterator = mItemStore.find(aHandle);
-    VerifyOrExit(itemIterator != mItemStore.end(), err = WEAVE_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(item != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
 
     // Return the trait mInstanceId
-    aInstanceId = itemIterator->second->mInstanceId;
+    aInstanceId = item->mInstanceId;
 
 exit:
     return err;
@@ -392,13 +440,13 @@ exit:
 template <typename T>
 WEAVE_ERROR GenericTraitCatalogImpl<T>::GetResourceId(TraitDataHandle aHandle, ResourceIdentifier & aResourceId) const
 {
-    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    WEAVE_ERROR err    = WEAVE_NO_ERROR;
+    CatalogItem * item = GetItem(aHandle);
     // Make sure the handle exists
-    auto itemIterator = mItemStore.find(aHandle);
-    VerifyOrExit(itemIterator != mItemStore.end(), err = WEAVE_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(item != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
 
     // Return the trait mResourceId
-    aResourceId = itemIterator->second->mResourceId;
+    aResourceId = item->mResourceId;
 
 exit:
     return err;
@@ -408,20 +456,20 @@ exit:
 template <typename T>
 uint32_t GenericTraitCatalogImpl<T>::Size(void) const
 {
-    return mItemStore.size();
+    return mItemCount;
 }
 
 template <typename T>
 WEAVE_ERROR GenericTraitCatalogImpl<T>::PrepareSubscriptionSpecificPathList(TraitPath * pathList, uint16_t pathListSize,
                                                                             TraitDataHandle aHandle)
 {
-    WEAVE_ERROR err   = WEAVE_NO_ERROR;
-    auto itemIterator = mItemStore.find(aHandle);
-    VerifyOrExit(itemIterator != mItemStore.end(), err = WEAVE_ERROR_INVALID_ARGUMENT);
+    WEAVE_ERROR err    = WEAVE_NO_ERROR;
+    CatalogItem * item = GetItem(aHandle);
+    VerifyOrExit(item != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
 
     VerifyOrExit(pathListSize == 1, err = WEAVE_ERROR_INVALID_ARGUMENT);
 
-    *pathList = TraitPath(aHandle, itemIterator->second->mBasePathHandle);
+    *pathList = TraitPath(aHandle, item->mBasePathHandle);
 
 exit:
     return err;
@@ -434,13 +482,16 @@ WEAVE_ERROR GenericTraitCatalogImpl<T>::PrepareSubscriptionPathList(TraitPath *
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     pathListLen     = 0;
 
-    VerifyOrExit(mItemStore.size() <= pathListSize, err = WEAVE_ERROR_BUFFER_TOO_SMALL);
+    VerifyOrExit(mItemCount <= pathListSize, err = WEAVE_ERROR_BUFFER_TOO_SMALL);
 
-    for (auto itemIterator = mItemStore.begin(); itemIterator != mItemStore.end(); itemIterator++)
+    for (size_t handle = 0; handle < mItemStore.size(); handle++)
     {
-        CatalogItem * item = itemIterator->second;
-        *pathList++        = TraitPath(itemIterator->first, item->mBasePathHandle);
-        pathListLen++;
+        CatalogItem * item = mItemStore[handle];
+        if (item != NULL)
+        {
+            *pathList++ = TraitPath(static_cast<TraitDataHandle>(handle), item->mBasePathHandle);
+            pathListLen++;
+        }
     }
 
 exit:
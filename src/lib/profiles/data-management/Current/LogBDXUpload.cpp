@@ -249,6 +249,7 @@ WEAVE_ERROR LogBDXUpload::StartUpload(nl::Weave::Binding * aBinding)
     xfer->mMaxBlockSize = 1024;
     xfer->mStartOffset  = 0;
     xfer->mLength       = 0;
+    xfer->mWindowSize   = WEAVE_CONFIG_EVENT_LOGGING_BDX_WINDOW_SIZE;
 
     // start transfer
     err = mBdxNode.InitBdxSend(*xfer, true, false, false, NULL);
@@ -610,6 +610,16 @@ LoggingManagement::LoggingManagement(nl::Weave::WeaveExchangeManager * inMgr,
             {
                 WeaveLogError(EventLogging, "%s PersistedCounter[%d]->Init() failed with %d", __FUNCTION__, j, err);
             }
+            else
+            {
+                // Share epoch writes with the counters of the other importance levels.  A counter left out of the
+                // batch still writes its own epochs.
+                err = mEventIdCounterBatch.AddCounter(*inLogStorageResources[i].mCounterStorage);
+                if (err != WEAVE_NO_ERROR)
+                {
+                    WeaveLogError(EventLogging, "%s PersistedStorageBatch.AddCounter() failed for counter %d with %d", __FUNCTION__, j, err);
+                }
+            }
             current->mEventIdCounter = inLogStorageResources[i].mCounterStorage;
         }
         else
@@ -2029,6 +2039,18 @@ uint32_t LoggingManagement::GetBytesWritten(void) const
     return mBytesWritten;
 }
 
+/**
+ * @brief
+ *   Get the counts of persistent storage writes made by the
+ *   persisted event ID counters of this log
+ *
+ * @returns The write counts of the event ID counters.
+ */
+const nl::Weave::PersistedStorageBatch::Stats & LoggingManagement::GetEventIdCounterWriteStats(void) const
+{
+    return mEventIdCounterBatch.GetStats();
+}
+
 void LoggingManagement::NotifyEventsDelivered(ImportanceType inImportance, event_id_t inLastDeliveredEventID,
                                               uint64_t inRecipientNodeID)
 {
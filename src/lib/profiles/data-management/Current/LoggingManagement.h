@@ -223,6 +223,8 @@ public:
 
     uint32_t GetBytesWritten(void) const;
 
+    const nl::Weave::PersistedStorageBatch::Stats & GetEventIdCounterWriteStats(void) const;
+
     void NotifyEventsDelivered(ImportanceType inImportance, event_id_t inLastDeliveredEventID, uint64_t inRecipientNodeID);
 
     /**
@@ -308,6 +310,7 @@ private:
     uint32_t mThrottled;
     ImportanceType mMaxImportanceBuffer;
     bool mUploadRequested;
+    nl::Weave::PersistedStorageBatch mEventIdCounterBatch;
 };
 
 namespace Platform {
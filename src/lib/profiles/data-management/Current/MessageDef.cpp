@@ -1397,6 +1397,16 @@ exit:
 // 3) any tag can only appear once
 // At the top level of the structure, unknown tags are ignored for foward compatibility
 WEAVE_ERROR DataElement::Parser::CheckSchemaValidity(void) const
+{
+    return CheckSchemaValidity(true);
+}
+
+WEAVE_ERROR DataElement::Parser::CheckEnvelopeValidity(void) const
+{
+    return CheckSchemaValidity(false);
+}
+
+WEAVE_ERROR DataElement::Parser::CheckSchemaValidity(const bool aCheckData) const
 {
     WEAVE_ERROR err          = WEAVE_NO_ERROR;
     uint16_t TagPresenceMask = 0;
@@ -1454,6 +1464,14 @@ WEAVE_ERROR DataElement::Parser::CheckSchemaValidity(void) const
             VerifyOrExit(!(TagPresenceMask & (1 << kCsTag_Data)), err = WEAVE_ERROR_INVALID_TLV_TAG);
             TagPresenceMask |= (1 << kCsTag_Data);
 
+#if !WEAVE_DETAIL_LOGGING
+            // the data is left to the caller, unless it has to be pretty-printed
+            if (!aCheckData)
+            {
+                break;
+            }
+#endif // !WEAVE_DETAIL_LOGGING
+
             err = ParseData(reader, 0);
             SuccessOrExit(err);
             break;
@@ -1833,6 +1851,69 @@ exit:
 }
 #endif // WEAVE_CONFIG_DATA_MANAGEMENT_ENABLE_SCHEMA_CHECK
 
+WEAVE_ERROR DataList::Parser::Visit(Visitor & aVisitor) const
+{
+    nl::Weave::TLV::TLVReader reader;
+
+    // make a copy of the reader
+    reader.Init(mReader);
+
+    return Visit(reader, aVisitor);
+}
+
+WEAVE_ERROR DataList::Parser::Visit(nl::Weave::TLV::TLVReader & aReader, Visitor & aVisitor)
+{
+    WEAVE_ERROR err       = WEAVE_NO_ERROR;
+    uint32_t numDelivered = 0;
+
+#if WEAVE_CONFIG_DATA_MANAGEMENT_ENABLE_SCHEMA_CHECK
+    PRETTY_PRINT("DataList =");
+    PRETTY_PRINT("[");
+#endif // WEAVE_CONFIG_DATA_MANAGEMENT_ENABLE_SCHEMA_CHECK
+
+    while (WEAVE_NO_ERROR == (err = aReader.Next()))
+    {
+        DataElement::Parser element;
+
+        VerifyOrExit(nl::Weave::TLV::AnonymousTag == aReader.GetTag(), err = WEAVE_ERROR_INVALID_TLV_TAG);
+        VerifyOrExit(nl::Weave::TLV::kTLVType_Structure == aReader.GetType(), err = WEAVE_ERROR_WRONG_TLV_TYPE);
+
+        err = element.Init(aReader);
+        SuccessOrExit(err);
+
+#if WEAVE_CONFIG_DATA_MANAGEMENT_ENABLE_SCHEMA_CHECK
+        err = element.CheckEnvelopeValidity();
+        SuccessOrExit(err);
+#endif // WEAVE_CONFIG_DATA_MANAGEMENT_ENABLE_SCHEMA_CHECK
+
+        // from here on, the element counts as delivered, even if the visitor fails on it
+        ++numDelivered;
+
+        err = aVisitor.OnDataElement(element, aReader, numDelivered - 1);
+        SuccessOrExit(err);
+    }
+
+#if WEAVE_CONFIG_DATA_MANAGEMENT_ENABLE_SCHEMA_CHECK
+    PRETTY_PRINT("],");
+#endif // WEAVE_CONFIG_DATA_MANAGEMENT_ENABLE_SCHEMA_CHECK
+
+    // if we have exhausted this container
+    if (WEAVE_END_OF_TLV == err)
+    {
+        err = WEAVE_NO_ERROR;
+    }
+
+exit:
+    if (WEAVE_NO_ERROR != err)
+    {
+        WeaveLogFunctError(err);
+
+        aVisitor.OnRejected(err, numDelivered);
+    }
+
+    return err;
+}
+
 // Re-initialize the shared PathBuilder with anonymous tag
 DataElement::Builder & DataList::Builder::CreateDataElementBuilder()
 {
@@ -3511,6 +3592,16 @@ SubscribeConfirmRequest::Builder & SubscribeConfirmRequest::Builder::EndOfReques
 // 3) any tag can only appear once
 // At the top level of the message, unknown tags are ignored for foward compatibility
 WEAVE_ERROR NotificationRequest::Parser::CheckSchemaValidity(void) const
+{
+    return CheckSchemaValidity(true);
+}
+
+WEAVE_ERROR NotificationRequest::Parser::CheckEnvelopeValidity(void) const
+{
+    return CheckSchemaValidity(false);
+}
+
+WEAVE_ERROR NotificationRequest::Parser::CheckSchemaValidity(const bool aCheckDataList) const
 {
     WEAVE_ERROR err          = WEAVE_NO_ERROR;
     uint16_t TagPresenceMask = 0;
@@ -3620,12 +3711,24 @@ WEAVE_ERROR NotificationRequest::Parser::CheckSchemaValidity(void) const
 
             dataList.Init(reader);
 
-            PRETTY_PRINT_INCDEPTH();
+            if (aCheckDataList)
+            {
+                PRETTY_PRINT_INCDEPTH();
 
-            err = dataList.CheckSchemaValidity();
-            SuccessOrExit(err);
+                err = dataList.CheckSchemaValidity();
+                SuccessOrExit(err);
 
-            PRETTY_PRINT_DECDEPTH();
+                PRETTY_PRINT_DECDEPTH();
+            }
+            else
+            {
+                nl::Weave::TLV::TLVReader elementReader;
+
+                // the elements are checked as they are visited, but the list must not be empty
+                dataList.GetReader(&elementReader);
+                err = elementReader.Next();
+                SuccessOrExit(err);
+            }
         }
         else
         {
@@ -4234,7 +4337,6 @@ WEAVE_ERROR UpdateRequest::Parser::CheckSchemaValidity(void) const
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     nl::Weave::TLV::TLVReader reader;
-    DataList::Parser dataList;
 
     struct TagPresence
     {
@@ -4319,24 +4421,12 @@ WEAVE_ERROR UpdateRequest::Parser::CheckSchemaValidity(void) const
 
             case kCsTag_DataList:
                 // check if this tag has appeared before
-                VerifyOrExit(tagPresence.Argument == false, err = WEAVE_ERROR_INVALID_TLV_TAG);
-                tagPresence.Argument = true;
+                VerifyOrExit(tagPresence.DataList == false, err = WEAVE_ERROR_INVALID_TLV_TAG);
+                tagPresence.DataList = true;
 
+                // the Data Elements are checked and printed by DataList::Parser::Visit as the request is processed
                 VerifyOrExit(nl::Weave::TLV::kTLVType_Array == reader.GetType(), err = WEAVE_ERROR_WRONG_TLV_TYPE);
 
-#if WEAVE_DETAIL_LOGGING
-                {
-                    dataList.Init(reader);
-
-                    PRETTY_PRINT_INCDEPTH();
-
-                    err = dataList.CheckSchemaValidity();
-                    SuccessOrExit(err);
-
-                    PRETTY_PRINT_DECDEPTH();
-                }
-#endif // WEAVE_DETAIL_LOGGING
-
                 break;
             default:
                 WeaveLogDetail(DataManagement, "UNKONWN, IGNORE");
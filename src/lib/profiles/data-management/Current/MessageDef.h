@@ -463,6 +463,10 @@ public:
     // At the top level of the structure, unknown tags are ignored for foward compatibility
     WEAVE_ERROR CheckSchemaValidity(void) const;
 
+    // Same as CheckSchemaValidity, except that the content of the data is not walked.
+    // This is for callers that parse the data themselves right after the check.
+    WEAVE_ERROR CheckEnvelopeValidity(void) const;
+
     // WEAVE_END_OF_TLV if there is no such element
     // WEAVE_ERROR_WRONG_TLV_TYPE if there is such element but it's not a Path
     WEAVE_ERROR GetPath(Path::Parser * const apPath) const;
@@ -502,6 +506,9 @@ public:
 protected:
     // A recursively callable function to parse a data element and pretty-print it.
     WEAVE_ERROR ParseData(nl::Weave::TLV::TLVReader & aReader, int aDepth) const;
+
+private:
+    WEAVE_ERROR CheckSchemaValidity(const bool aCheckData) const;
 };
 
 /**
@@ -572,6 +579,51 @@ public:
     // 2) all elements are anonymous and of Structure type
     // 3) every Data Element is also valid in schema
     WEAVE_ERROR CheckSchemaValidity(void) const;
+
+    /**
+     *  @brief
+     *    Handler for the Data Elements of a Data List, for use with Visit()
+     */
+    class Visitor
+    {
+    public:
+        /**
+         *  @brief Act on one Data Element
+         *
+         *  @param [in] aElement    A parser initialized on the Data Element
+         *  @param [in] aReader     A reader positioned on the Data Element
+         *  @param [in] aIndex      The position of the Data Element in the list
+         *
+         *  @retval #WEAVE_NO_ERROR to continue with the next Data Element.
+         *          Any other value stops the walk and is returned by Visit().
+         */
+        virtual WEAVE_ERROR OnDataElement(const DataElement::Parser & aElement, const nl::Weave::TLV::TLVReader & aReader,
+                                          uint32_t aIndex) = 0;
+
+        /**
+         *  @brief Undo the effect of the Data Elements already handled
+         *
+         *  Called once when the walk stops on an error, whether the error came from
+         *  the list itself or from OnDataElement.
+         *
+         *  @param [in] aError          The error that stopped the walk
+         *  @param [in] aNumDelivered   The number of Data Elements passed to OnDataElement,
+         *                              including the one that returned aError, if any
+         */
+        virtual void OnRejected(WEAVE_ERROR aError, uint32_t aNumDelivered) { }
+
+    protected:
+        virtual ~Visitor(void) { }
+    };
+
+    // Walk the list once, passing every Data Element to aVisitor in order.
+    // Each element is checked to be an anonymous structure, and when schema check is enabled,
+    // its envelope is checked with DataElement::Parser::CheckEnvelopeValidity before it is passed on.
+    // Unlike CheckSchemaValidity, an empty list is not an error.
+    WEAVE_ERROR Visit(Visitor & aVisitor) const;
+
+    // Same as above, for aReader obtained through GetReader(). aReader is advanced past the last element.
+    static WEAVE_ERROR Visit(nl::Weave::TLV::TLVReader & aReader, Visitor & aVisitor);
 };
 
 class DataList::Builder : public ListBuilderBase
@@ -1129,6 +1181,11 @@ public:
     // 4) any tag can only appear once
     WEAVE_ERROR CheckSchemaValidity(void) const;
 
+    // Same as CheckSchemaValidity, except that the Data Elements in the Data List are not
+    // checked, only that there is at least one. For callers that go through the list with
+    // DataList::Parser::Visit, which checks each Data Element as it is delivered.
+    WEAVE_ERROR CheckEnvelopeValidity(void) const;
+
     // Get a TLVReader for the Paths. Next() must be called before accessing them.
     WEAVE_ERROR GetDataList(DataList::Parser * const apDataList) const;
 
@@ -1146,6 +1203,9 @@ public:
 
     // Get a TLVReader for the events. Next() must be called before accessing them.
     WEAVE_ERROR GetEventList(EventList::Parser * const apEventList) const;
+
+private:
+    WEAVE_ERROR CheckSchemaValidity(const bool aCheckDataList) const;
 };
 
 /**
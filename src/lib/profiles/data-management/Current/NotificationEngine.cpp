@@ -63,7 +63,8 @@ bool NotificationEngine::BasicGraphSolver::IsPropertyPathSupported(PropertyPathH
 
 WEAVE_ERROR NotificationEngine::BasicGraphSolver::RetrieveTraitInstanceData(NotifyRequestBuilder * aBuilder,
                                                                             TraitDataHandle aTraitDataHandle,
-                                                                            SchemaVersion aSchemaVersion, bool aRetrieveAll)
+                                                                            SchemaVersion aSchemaVersion, bool aRetrieveAll,
+                                                                            const DataVersion * aBaseVersion)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
@@ -381,9 +382,29 @@ PropertyPathHandle NotificationEngine::IntermediateGraphSolver::GetNextCandidate
     return candidateHandle;
 }
 
+#if WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE > 0
+PropertyPathHandle NotificationEngine::IntermediateGraphSolver::GetNextCandidateHandle(uint32_t & aChangeStoreCursor,
+                                                                                       TraitDataHandle aTargetDataHandle,
+                                                                                       bool & aCandidateHandleIsDelete,
+                                                                                       const TraitDataSource * aJournalSource,
+                                                                                       DataVersion aBaseVersion)
+{
+    if (aJournalSource == NULL)
+    {
+        return GetNextCandidateHandle(aChangeStoreCursor, aTargetDataHandle, aCandidateHandleIsDelete);
+    }
+
+    // The journal only holds modifications/additions.
+    aCandidateHandleIsDelete = false;
+
+    return aJournalSource->GetNextChangeSince(aBaseVersion, aChangeStoreCursor);
+}
+#endif // WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE > 0
+
 WEAVE_ERROR NotificationEngine::IntermediateGraphSolver::RetrieveTraitInstanceData(NotifyRequestBuilder * aBuilder,
                                                                                    TraitDataHandle aTraitDataHandle,
-                                                                                   SchemaVersion aSchemaVersion, bool aRetrieveAll)
+                                                                                   SchemaVersion aSchemaVersion, bool aRetrieveAll,
+                                                                                   const DataVersion * aBaseVersion)
 {
     WEAVE_ERROR err;
     PropertyPathHandle mergeHandleSet[WDM_PUBLISHER_INTERMEDIATE_SOLVER_MAX_MERGE_HANDLE_SET]  = { kNullPropertyPathHandle };
@@ -393,6 +414,7 @@ WEAVE_ERROR NotificationEngine::IntermediateGraphSolver::RetrieveTraitInstanceDa
     PropertyPathHandle currentCommonHandle                                                     = kNullPropertyPathHandle;
     TraitDataSource * dataSource;
     const TraitSchemaEngine * schemaEngine;
+    const TraitDataSource * journalSource = NULL;
 
     err = SubscriptionEngine::GetInstance()->mPublisherCatalog->Locate(aTraitDataHandle, &dataSource);
     SuccessOrExit(err);
@@ -406,14 +428,24 @@ WEAVE_ERROR NotificationEngine::IntermediateGraphSolver::RetrieveTraitInstanceDa
                    WDM_PUBLISHER_MAX_ITEMS_IN_TRAIT_DIRTY_STORE);
 #endif
 
+#if WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE > 0
+    // Rather than falling back to the whole instance, work off the data source's change journal if it still covers the version
+    // this subscriber is known to have.
+    if ((aRetrieveAll || dataSource->IsRootDirty()) && (aBaseVersion != NULL) && dataSource->HasChangesSince(*aBaseVersion))
+    {
+        WeaveLogDetail(DataManagement, "<ISolver::Retr> Changes since 0x%" PRIx64 " from journal", *aBaseVersion);
+        journalSource = dataSource;
+    }
+#endif
+
     // If we are told to retrieve all (i.e root), our job here is done
-    if (aRetrieveAll)
+    if (aRetrieveAll && (journalSource == NULL))
     {
         WeaveLogDetail(DataManagement, "<ISolver::Retr> Retrieving all!");
         currentCommonHandle = kRootPropertyPathHandle;
     }
     // If the data source as a whole has been marked dirty, our job here is done
-    else if (dataSource->IsRootDirty())
+    else if (dataSource->IsRootDirty() && (journalSource == NULL))
     {
         WeaveLogDetail(DataManagement, "<ISolver::Retr> Root is dirty!");
         currentCommonHandle = kRootPropertyPathHandle;
@@ -468,8 +500,14 @@ WEAVE_ERROR NotificationEngine::IntermediateGraphSolver::RetrieveTraitInstanceDa
         //      mergeHandleSet = set of handles that will be merged in relative to the currentCommonHandle. If empty, all children
         //                   under the commonHandle will be included.
         //
+#if WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE > 0
+        while ((candidateHandle = GetNextCandidateHandle(changeStoreCursor, aTraitDataHandle, candidateHandleIsDelete,
+                                                         journalSource, (aBaseVersion != NULL) ? *aBaseVersion : 0)) !=
+               kNullPropertyPathHandle)
+#else
         while ((candidateHandle = GetNextCandidateHandle(changeStoreCursor, aTraitDataHandle, candidateHandleIsDelete)) !=
                kNullPropertyPathHandle)
+#endif
         {
             oldCandidateHandleIsDelete = candidateHandleIsDelete;
 
@@ -742,6 +780,7 @@ WEAVE_ERROR NotificationEngine::NotifyRequestBuilder::Init(PacketBuffer * aBuf,
     mWriter         = aWriter;
     mState          = kNotifyRequestBuilder_Idle;
     mBuf            = aBuf;
+    mBufStart       = aBuf->Start() + aBuf->DataLength();
     mSub            = aSubHandler;
     mMaxPayloadSize = aMaxPayloadSize;
 
@@ -956,6 +995,19 @@ exit:
     return err;
 }
 
+WEAVE_ERROR NotificationEngine::NotifyRequestBuilder::WriteEncodedDataElement(const uint8_t * aMembers, uint32_t aMembersLen)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    VerifyOrExit(mState == kNotifyRequestBuilder_BuildDataList, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    err = mWriter->PutPreEncodedContainer(AnonymousTag, kTLVType_Structure, aMembers, aMembersLen);
+    SuccessOrExit(err);
+
+exit:
+    return err;
+}
+
 WEAVE_ERROR NotificationEngine::NotifyRequestBuilder::MoveToState(NotifyRequestBuilderState aDesiredState)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
@@ -1034,6 +1086,12 @@ WEAVE_ERROR NotificationEngine::Init()
     mCurTraitInstanceIdx       = 0;
     mNumNotifiesInFlight       = 0;
 
+    ResetEncodeStats();
+
+#if WDM_PUBLISHER_NOTIFY_ENCODE_CACHE_SIZE > 0
+    ClearEncodeCache();
+#endif
+
     return WEAVE_NO_ERROR;
 }
 
@@ -1056,6 +1114,10 @@ WEAVE_ERROR NotificationEngine::DeleteKey(TraitDataSource * aDataSource, Propert
     err = mGraphSolver.DeleteKey(dataHandle, aPropertyHandle);
     SuccessOrExit(err);
 
+#if WDM_PUBLISHER_NOTIFY_ENCODE_CACHE_SIZE > 0
+    ClearEncodeCache();
+#endif
+
 exit:
     if (isLocked)
     {
@@ -1084,6 +1146,12 @@ WEAVE_ERROR NotificationEngine::SetDirty(TraitDataSource * aDataSource, Property
     err = mGraphSolver.SetDirty(dataHandle, aPropertyHandle);
     SuccessOrExit(err);
 
+#if WDM_PUBLISHER_NOTIFY_ENCODE_CACHE_SIZE > 0
+    // The data may have changed without its version moving yet (the version is only bumped when the source is unlocked),
+    // so a cached element for the same version can no longer be trusted.
+    ClearEncodeCache();
+#endif
+
 exit:
     if (isLocked)
     {
@@ -1097,14 +1165,78 @@ WEAVE_ERROR NotificationEngine::RetrieveTraitInstanceData(SubscriptionHandler *
                                                           SubscriptionHandler::TraitInstanceInfo * aTraitInfo,
                                                           NotifyRequestBuilder * aBuilder, bool * aPacketFull)
 {
-    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    WEAVE_ERROR err                 = WEAVE_NO_ERROR;
+    bool retrieveAll                = aSubHandler->IsSubscribing();
+    uint32_t startOffset            = aBuilder->GetWriter()->GetLengthWritten();
+    const DataVersion * baseVersion = NULL;
+#if (WDM_PUBLISHER_NOTIFY_ENCODE_CACHE_SIZE > 0) || (WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE > 0)
+    TraitDataSource * dataSource;
+    DataVersion dataVersion;
+#endif
+#if WDM_PUBLISHER_NOTIFY_ENCODE_CACHE_SIZE > 0
+    const EncodeCacheEntry * cacheEntry = NULL;
+#endif
 
     *aPacketFull = false;
 
-    err = mGraphSolver.RetrieveTraitInstanceData(aBuilder, aTraitInfo->mTraitDataHandle, aTraitInfo->mRequestedVersion,
-                                                 aSubHandler->IsSubscribing());
+#if (WDM_PUBLISHER_NOTIFY_ENCODE_CACHE_SIZE > 0) || (WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE > 0)
+    err = SubscriptionEngine::GetInstance()->mPublisherCatalog->Locate(aTraitInfo->mTraitDataHandle, &dataSource);
     SuccessOrExit(err);
 
+    dataVersion = dataSource->GetVersion();
+#endif
+
+#if WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE > 0
+    if (aTraitInfo->mIsAckedVersionValid)
+    {
+        baseVersion = &aTraitInfo->mAckedVersion;
+    }
+#endif
+
+#if WDM_PUBLISHER_NOTIFY_ENCODE_CACHE_SIZE > 0
+    cacheEntry =
+        FindEncodedDataElement(aTraitInfo->mTraitDataHandle, dataVersion, aTraitInfo->mRequestedVersion, retrieveAll, baseVersion);
+
+    if (cacheEntry != NULL)
+    {
+        WeaveLogDetail(DataManagement, "<NE:Run> T%u served from encode cache (%u bytes)", aTraitInfo->mTraitDataHandle,
+                       cacheEntry->mLength);
+
+        err = aBuilder->WriteEncodedDataElement(mEncodeCache + cacheEntry->mOffset, cacheEntry->mLength);
+        SuccessOrExit(err);
+
+        mEncodeStats.mCacheHits++;
+    }
+    else
+#endif // WDM_PUBLISHER_NOTIFY_ENCODE_CACHE_SIZE > 0
+    {
+        uint32_t encodedLen;
+
+        err = mGraphSolver.RetrieveTraitInstanceData(aBuilder, aTraitInfo->mTraitDataHandle, aTraitInfo->mRequestedVersion,
+                                                     retrieveAll, baseVersion);
+        SuccessOrExit(err);
+
+        encodedLen = aBuilder->GetWriter()->GetLengthWritten() - startOffset;
+
+        mEncodeStats.mBytesEncoded += encodedLen;
+        mEncodeStats.mCacheMisses++;
+
+#if WDM_PUBLISHER_NOTIFY_ENCODE_CACHE_SIZE > 0
+        // The data element is an anonymous structure; skip its one byte control field and keep the members and the
+        // end-of-container marker, which is what WriteEncodedDataElement() expects.
+        CacheEncodedDataElement(aTraitInfo->mTraitDataHandle, dataVersion, aTraitInfo->mRequestedVersion, retrieveAll, baseVersion,
+                                aBuilder->GetEncodedData(startOffset + 1), encodedLen - 1);
+#endif // WDM_PUBLISHER_NOTIFY_ENCODE_CACHE_SIZE > 0
+    }
+
+    mEncodeStats.mBytesSent += aBuilder->GetWriter()->GetLengthWritten() - startOffset;
+
+#if WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE > 0
+    // Becomes the subscriber's acknowledged version once the notify carrying it is confirmed.
+    aTraitInfo->mSentVersion          = dataVersion;
+    aTraitInfo->mIsSentVersionPending = true;
+#endif
+
     // Clear out the dirty bit since we're done processing this trait instance.
     aTraitInfo->ClearDirty();
 
@@ -1122,7 +1254,7 @@ WEAVE_ERROR NotificationEngine::SendNotify(PacketBuffer * aBuffer, SubscriptionH
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
-    // We can only have 1 notify in flight for any given subscription - increment and break out.
+    // Account for the notify before handing it to the subscription; a failed send is backed out below.
     mNumNotifiesInFlight++;
 
     err = aSubHandler->SendNotificationRequest(aBuffer);
@@ -1136,7 +1268,81 @@ exit:
     return err;
 }
 
+#if WDM_PUBLISHER_NOTIFY_ENCODE_CACHE_SIZE > 0
+const NotificationEngine::EncodeCacheEntry * NotificationEngine::FindEncodedDataElement(TraitDataHandle aTraitDataHandle,
+                                                                                     DataVersion aDataVersion,
+                                                                                     SchemaVersion aSchemaVersion,
+                                                                                     bool aRetrieveAll,
+                                                                                     const DataVersion * aBaseVersion) const
+{
+    for (uint16_t i = 0; i < mNumEncodeCacheEntries; i++)
+    {
+        const EncodeCacheEntry & entry = mEncodeCacheEntries[i];
+
+        if (entry.mTraitDataHandle == aTraitDataHandle && entry.mDataVersion == aDataVersion &&
+            entry.mSchemaVersion == aSchemaVersion && entry.mRetrieveAll == aRetrieveAll)
+        {
+#if WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE > 0
+            // Deltas are only shared between subscribers that start from the same version
+            if (entry.mHasBaseVersion != (aBaseVersion != NULL) ||
+                (entry.mHasBaseVersion && entry.mBaseVersion != *aBaseVersion))
+            {
+                continue;
+            }
+#endif
+            return &entry;
+        }
+    }
+
+    return NULL;
+}
+
+void NotificationEngine::CacheEncodedDataElement(TraitDataHandle aTraitDataHandle, DataVersion aDataVersion,
+                                                 SchemaVersion aSchemaVersion, bool aRetrieveAll,
+                                                 const DataVersion * aBaseVersion, const uint8_t * aMembers,
+                                                 uint32_t aMembersLen)
+{
+    EncodeCacheEntry * entry;
+
+    // Once the cache is full, later elements are simply encoded per subscriber as before.
+    VerifyOrExit(mNumEncodeCacheEntries < WDM_PUBLISHER_NOTIFY_ENCODE_CACHE_MAX_ENTRIES, );
+    VerifyOrExit(aMembersLen <= static_cast<uint32_t>(WDM_PUBLISHER_NOTIFY_ENCODE_CACHE_SIZE - mEncodeCacheLen), );
+
+    entry                   = &mEncodeCacheEntries[mNumEncodeCacheEntries++];
+    entry->mDataVersion     = aDataVersion;
+    entry->mTraitDataHandle = aTraitDataHandle;
+    entry->mSchemaVersion   = aSchemaVersion;
+    entry->mRetrieveAll     = aRetrieveAll;
+#if WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE > 0
+    entry->mHasBaseVersion  = (aBaseVersion != NULL);
+    entry->mBaseVersion     = (aBaseVersion != NULL) ? *aBaseVersion : 0;
+#endif
+    entry->mOffset          = mEncodeCacheLen;
+    entry->mLength          = static_cast<uint16_t>(aMembersLen);
+
+    memcpy(mEncodeCache + mEncodeCacheLen, aMembers, aMembersLen);
+    mEncodeCacheLen = static_cast<uint16_t>(mEncodeCacheLen + aMembersLen);
+
+exit:
+    return;
+}
+
+void NotificationEngine::ClearEncodeCache(void)
+{
+    mNumEncodeCacheEntries = 0;
+    mEncodeCacheLen        = 0;
+}
+#endif // WDM_PUBLISHER_NOTIFY_ENCODE_CACHE_SIZE > 0
+
 void NotificationEngine::OnNotifyConfirm(SubscriptionHandler * aSubHandler, bool aNotifyDelivered)
+{
+    RetireNotify(aSubHandler, aNotifyDelivered, aSubHandler->mSelfVendedEvents);
+
+    // Run NE again now that a notify has come back/error'ed out and that we might be able to do more work.
+    Run();
+}
+
+void NotificationEngine::RetireNotify(SubscriptionHandler * aSubHandler, bool aNotifyDelivered, const event_id_t * aVendedEvents)
 {
     VerifyOrDie(mNumNotifiesInFlight > 0);
 
@@ -1151,12 +1357,9 @@ void NotificationEngine::OnNotifyConfirm(SubscriptionHandler * aSubHandler, bool
         {
             size_t i                  = static_cast<size_t>(iterator - kImportanceType_First);
             ImportanceType importance = (ImportanceType) iterator;
-            logger.NotifyEventsDelivered(importance, aSubHandler->mSelfVendedEvents[i] - 1, aSubHandler->GetPeerNodeId());
+            logger.NotifyEventsDelivered(importance, aVendedEvents[i] - 1, aSubHandler->GetPeerNodeId());
         }
     }
-
-    // Run NE again now that a notify has come back/error'ed out and that we might be able to do more work.
-    Run();
 }
 
 /**
@@ -1408,6 +1611,18 @@ WEAVE_ERROR NotificationEngine::BuildSingleNotifyRequestDataList(SubscriptionHan
 
     while (aSubHandler->mCurProcessingTraitInstanceIdx < aSubHandler->GetNumTraitInstances())
     {
+#if WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE > 1
+        if (traitInfo->IsDirty() && traitInfo->mIsInNotifyWindow)
+        {
+            // An earlier notify carrying this trait instance is still unconfirmed. Should it be retransmitted after this one
+            // went out, the subscriber would apply the older data last, so leave the instance dirty until it is confirmed.
+            aIsSubscriptionClean = false;
+
+            WeaveLogDetail(DataManagement, "<NE:Run> T%u is dirty, held back by notify %" PRIu32,
+                           aSubHandler->mCurProcessingTraitInstanceIdx, traitInfo->mNotifySequence);
+        }
+        else
+#endif // WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE > 1
         if (traitInfo->IsDirty())
         {
             aIsSubscriptionClean = false;
@@ -1446,6 +1661,15 @@ WEAVE_ERROR NotificationEngine::BuildSingleNotifyRequestDataList(SubscriptionHan
             else
             {
                 aNeWriteInProgress = true;
+
+#if WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE > 1
+                if (aSubHandler->IsNotifyWindowed())
+                {
+                    // The notify being built takes the next sequence number when it is sent
+                    traitInfo->mNotifySequence   = aSubHandler->mNextNotifySequence;
+                    traitInfo->mIsInNotifyWindow = true;
+                }
+#endif // WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE > 1
             }
         }
 
@@ -1580,6 +1804,15 @@ WEAVE_ERROR NotificationEngine::BuildSingleNotifyRequest(SubscriptionHandler * a
         // NULL out the buf since we've handed it over to the message layer
         buf = NULL;
         VerifyOrExit(err == WEAVE_NO_ERROR, WeaveLogError(DataManagement, "<NE:Run> Error sending out notify!"));
+
+#if WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE > 1
+        // If the subscription still has work and room in its notify window, keep building notifies for it in this
+        // run instead of waiting for the confirm of the one we just sent.
+        if (!aIsSubscriptionClean && aSubHandler->IsNotifiable())
+        {
+            aSubscriptionHandled = false;
+        }
+#endif
     }
 
 exit:
@@ -1726,6 +1959,7 @@ void NotificationEngine::Run()
     bool subscriptionHandled, isSubscriptionClean;
     bool isClean  = true;
     bool isLocked = false;
+    EncodeStats statsAtStart;
 
     // Lock before attempting to modify any of the shared data structures.
     err = subEngine->Lock();
@@ -1735,6 +1969,13 @@ void NotificationEngine::Run()
 
     WeaveLogDetail(DataManagement, "<NE:Run> NotifiesInFlight = %u", mNumNotifiesInFlight);
 
+#if WDM_PUBLISHER_NOTIFY_ENCODE_CACHE_SIZE > 0
+    // Encoded data elements are only shared within a single pass; trait data may change between runs.
+    ClearEncodeCache();
+#endif
+
+    statsAtStart = mEncodeStats;
+
     while ((mNumNotifiesInFlight < WDM_PUBLISHER_MAX_NOTIFIES_IN_FLIGHT) &&
            (numSubscriptionsHandled < SubscriptionEngine::kMaxNumSubscriptionHandlers))
     {
@@ -1776,6 +2017,14 @@ void NotificationEngine::Run()
         subHandler                 = subEngine->mHandlers + mCurSubscriptionHandlerIdx;
     }
 
+    if (mEncodeStats.mCacheMisses != statsAtStart.mCacheMisses || mEncodeStats.mCacheHits != statsAtStart.mCacheHits)
+    {
+        WeaveLogDetail(DataManagement, "<NE:Run> Encoded %" PRIu32 " bytes, sent %" PRIu32 " bytes (cache hits %" PRIu32
+                       ", misses %" PRIu32 ")", mEncodeStats.mBytesEncoded - statsAtStart.mBytesEncoded,
+                       mEncodeStats.mBytesSent - statsAtStart.mBytesSent, mEncodeStats.mCacheHits - statsAtStart.mCacheHits,
+                       mEncodeStats.mCacheMisses - statsAtStart.mCacheMisses);
+    }
+
     subHandler = subEngine->mHandlers;
     isClean    = true;
 
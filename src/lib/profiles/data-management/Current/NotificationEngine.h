@@ -130,6 +130,31 @@ public:
 
     WEAVE_ERROR DeleteKey(TraitDataSource * aDataSource, PropertyPathHandle aPropertyHandle);
 
+    /**
+     *  @brief Counters describing how much trait data the engine encoded versus how much it placed into notifies.
+     *
+     *  When the encode-once cache is enabled (see #WDM_PUBLISHER_NOTIFY_ENCODE_CACHE_SIZE), data elements shared by several
+     *  subscribers are encoded once per run and spliced into the other notifies, so mBytesSent can exceed mBytesEncoded.
+     */
+    struct EncodeStats
+    {
+        uint32_t mBytesEncoded; ///< Bytes of data elements produced by the graph solver.
+        uint32_t mBytesSent;    ///< Bytes of data elements written into notify requests, including spliced cache hits.
+        uint32_t mCacheHits;    ///< Number of data elements served from the encode-once cache.
+        uint32_t mCacheMisses;  ///< Number of data elements that had to be encoded.
+    };
+
+    /**
+     * Retrieve the encode counters accumulated since Init() or the last ResetEncodeStats(). The increments from each run of
+     * the engine are also logged at detail level.
+     */
+    const EncodeStats & GetEncodeStats(void) const { return mEncodeStats; }
+
+    /**
+     * Reset the encode counters to zero.
+     */
+    void ResetEncodeStats(void) { memset(&mEncodeStats, 0, sizeof(mEncodeStats)); }
+
 #if WDM_ENABLE_SUBSCRIPTIONLESS_NOTIFICATION
     WEAVE_ERROR SendSubscriptionlessNotification(Binding * const apBinding, TraitPath *aPathList, uint16_t aPathListSize);
 #endif // WDM_ENABLE_SUBSCRIPTIONLESS_NOTIFICATION
@@ -229,6 +254,22 @@ public:
                                      uint32_t aNumMergeDataHandles, PropertyPathHandle * aDeleteHandleSet,
                                      uint32_t aNumDeleteHandles);
 
+        /**
+         * Write out a data element that was previously encoded by WriteDataElement() into another notify.
+         *
+         * @param[in] aMembers     The encoded members of the data element structure, including its end-of-container marker.
+         * @param[in] aMembersLen  The length of aMembers in bytes.
+         *
+         * @retval #WEAVE_NO_ERROR On success.
+         * @retval other           Unable to write the data element.
+         */
+        WEAVE_ERROR WriteEncodedDataElement(const uint8_t * aMembers, uint32_t aMembersLen);
+
+        /**
+         * Return a pointer to the encoded notify at the given offset, as measured by GetWriter()->GetLengthWritten().
+         */
+        const uint8_t * GetEncodedData(uint32_t aOffset) const { return mBufStart + aOffset; }
+
         /**
          * Checkpoint the request state into a TLVWriter
          *
@@ -271,6 +312,7 @@ public:
         TLV::TLVWriter * mWriter;
         NotifyRequestBuilderState mState;
         PacketBuffer * mBuf;
+        const uint8_t * mBufStart;
         SubscriptionHandler * mSub;
         uint32_t mMaxPayloadSize;
     };
@@ -308,7 +350,8 @@ public:
     public:
         static bool IsPropertyPathSupported(PropertyPathHandle aHandle);
         WEAVE_ERROR RetrieveTraitInstanceData(NotifyRequestBuilder * aBuilder, TraitDataHandle aTraitDataHandle,
-                                              SchemaVersion aSchemaVersion, bool aRetrieveAll);
+                                              SchemaVersion aSchemaVersion, bool aRetrieveAll,
+                                              const DataVersion * aBaseVersion = NULL);
         static WEAVE_ERROR SetDirty(TraitDataHandle aTraitDataHandle, PropertyPathHandle aPropertyHandle);
         WEAVE_ERROR ClearDirty(void);
     };
@@ -333,7 +376,8 @@ public:
     public:
         static bool IsPropertyPathSupported(PropertyPathHandle aHandle);
         WEAVE_ERROR RetrieveTraitInstanceData(NotifyRequestBuilder * aBuilder, TraitDataHandle aTraitDataHandle,
-                                              SchemaVersion aSchemaVersion, bool aRetrieveAll);
+                                              SchemaVersion aSchemaVersion, bool aRetrieveAll,
+                                              const DataVersion * aBaseVersion = NULL);
         WEAVE_ERROR SetDirty(TraitDataHandle aTraitDataHandle, PropertyPathHandle aPropertyHandle);
 
 #if TDM_ENABLE_PUBLISHER_DICTIONARY_SUPPORT
@@ -364,6 +408,11 @@ public:
         static void ClearTraitInstanceDirty(void * aDataSource, TraitDataHandle aDataHandle, void * aContext);
         PropertyPathHandle GetNextCandidateHandle(uint32_t & aChangeStoreCursor, TraitDataHandle aTargetDataHandle,
                                                   bool & aCandidateHandleIsDelete);
+#if WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE > 0
+        PropertyPathHandle GetNextCandidateHandle(uint32_t & aChangeStoreCursor, TraitDataHandle aTargetDataHandle,
+                                                  bool & aCandidateHandleIsDelete, const TraitDataSource * aJournalSource,
+                                                  DataVersion aBaseVersion);
+#endif
 
         Store mDirtyStore;
 
@@ -387,6 +436,12 @@ private:
      */
     void OnNotifyConfirm(SubscriptionHandler * aSubHandler, bool aNotifyDelivered);
 
+    /**
+     * Account for a notify that has completed, without running the engine again.  When the notify was delivered,
+     * the events up to the cursors in aVendedEvents are reported to the logger as delivered to the subscriber.
+     */
+    void RetireNotify(SubscriptionHandler * aSubHandler, bool aNotifyDelivered, const event_id_t * aVendedEvents);
+
     WEAVE_ERROR BuildSingleNotifyRequestDataList(SubscriptionHandler * aSubHandler, NotifyRequestBuilder & aNotifyRequest,
                                                  bool & isSubscriptionClean, bool & aNeWriteInProgress);
     WEAVE_ERROR BuildSingleNotifyRequestEventList(SubscriptionHandler * aSubHandler, NotifyRequestBuilder & aNotifyRequest,
@@ -398,6 +453,30 @@ private:
                                           NotifyRequestBuilder * aBuilder, bool * aPacketFull);
     WEAVE_ERROR SendNotify(PacketBuffer * aBuf, SubscriptionHandler * aSubHandler);
 
+#if WDM_PUBLISHER_NOTIFY_ENCODE_CACHE_SIZE > 0
+    struct EncodeCacheEntry
+    {
+        DataVersion mDataVersion;
+#if WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE > 0
+        DataVersion mBaseVersion;
+        bool mHasBaseVersion;
+#endif
+        TraitDataHandle mTraitDataHandle;
+        SchemaVersion mSchemaVersion;
+        bool mRetrieveAll;
+        uint16_t mOffset;
+        uint16_t mLength;
+    };
+
+    const EncodeCacheEntry * FindEncodedDataElement(TraitDataHandle aTraitDataHandle, DataVersion aDataVersion,
+                                                    SchemaVersion aSchemaVersion, bool aRetrieveAll,
+                                                    const DataVersion * aBaseVersion) const;
+    void CacheEncodedDataElement(TraitDataHandle aTraitDataHandle, DataVersion aDataVersion, SchemaVersion aSchemaVersion,
+                                 bool aRetrieveAll, const DataVersion * aBaseVersion, const uint8_t * aMembers,
+                                 uint32_t aMembersLen);
+    void ClearEncodeCache(void);
+#endif // WDM_PUBLISHER_NOTIFY_ENCODE_CACHE_SIZE > 0
+
     WEAVE_ERROR SendNotifyRequest();
 
     static void Run(System::Layer * aSystemLayer, void * aAppState, System::Error);
@@ -411,6 +490,14 @@ private:
     uint32_t mNumNotifiesInFlight;
     nl::Weave::TLV::TLVType mOuterContainerType;
     WEAVE_CONFIG_WDM_PUBLISHER_GRAPH_SOLVER mGraphSolver;
+    EncodeStats mEncodeStats;
+
+#if WDM_PUBLISHER_NOTIFY_ENCODE_CACHE_SIZE > 0
+    EncodeCacheEntry mEncodeCacheEntries[WDM_PUBLISHER_NOTIFY_ENCODE_CACHE_MAX_ENTRIES];
+    uint8_t mEncodeCache[WDM_PUBLISHER_NOTIFY_ENCODE_CACHE_SIZE];
+    uint16_t mNumEncodeCacheEntries;
+    uint16_t mEncodeCacheLen;
+#endif // WDM_PUBLISHER_NOTIFY_ENCODE_CACHE_SIZE > 0
 };
 
 }; // namespace WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current)
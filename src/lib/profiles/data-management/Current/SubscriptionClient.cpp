@@ -88,12 +88,19 @@ void SubscriptionClient::Reset(void)
 
 #if WEAVE_CONFIG_ENABLE_WDM_UPDATE
     mUpdateMutex                            = NULL;
-    mUpdateInFlight                         = false;
     mMaxUpdateSize                          = 0;
-    mUpdateRequestContext.Reset();
+    mUpdateWindowSize                       = 1;
     mPendingSetState = kPendingSetEmpty;
     mPendingUpdateSet.Init(mPendingStore, ArraySize(mPendingStore));
-    mInProgressUpdateList.Init(mInProgressStore, ArraySize(mInProgressStore));
+    for (size_t i = 0; i < ArraySize(mUpdateSlots); i++)
+    {
+        UpdateRequestSlot & slot = mUpdateSlots[i];
+
+        slot.mpClient        = this;
+        slot.mUpdateInFlight = false;
+        slot.mUpdateRequestContext.Reset();
+        slot.mInProgressUpdateList.Init(slot.mInProgressStore, ArraySize(slot.mInProgressStore));
+    }
     mUpdateRetryCounter                     = 0;
     mUpdateRetryScheduled                   = false;
     mUpdateFlushScheduled                   = false;
@@ -143,7 +150,6 @@ WEAVE_ERROR SubscriptionClient::Init(Binding * const apBinding, void * const apA
 
 #if WEAVE_CONFIG_ENABLE_WDM_UPDATE
     mUpdateMutex                            = aUpdateMutex;
-    mUpdateInFlight                         = false;
     mMaxUpdateSize                          = 0;
 
 #endif // WEAVE_CONFIG_ENABLE_WDM_UPDATE
@@ -153,8 +159,13 @@ WEAVE_ERROR SubscriptionClient::Init(Binding * const apBinding, void * const apA
 
 #if WEAVE_CONFIG_ENABLE_WDM_UPDATE
 
-    err = mUpdateClient.Init(mBinding, this, UpdateEventCallback);
-    SuccessOrExit(err);
+    for (size_t i = 0; i < ArraySize(mUpdateSlots); i++)
+    {
+        mUpdateSlots[i].mUpdateInFlight = false;
+
+        err = mUpdateSlots[i].mUpdateClient.Init(mBinding, &mUpdateSlots[i], UpdateEventCallback);
+        SuccessOrExit(err);
+    }
 
     ConfigureUpdatableSinks();
 
@@ -970,7 +981,10 @@ void SubscriptionClient::_Cleanup(void)
     }
 
 #if WEAVE_CONFIG_ENABLE_WDM_UPDATE
-    mUpdateClient.Shutdown();
+    for (size_t i = 0; i < ArraySize(mUpdateSlots); i++)
+    {
+        mUpdateSlots[i].mUpdateClient.Shutdown();
+    }
 
     mDataSinkCatalog->Iterate(CleanupUpdatableSinkTrait, this);
 #endif // WEAVE_CONFIG_ENABLE_WDM_UPDATE
@@ -1211,7 +1225,10 @@ void SubscriptionClient::BindingEventCallback(void * const aAppState, const Bind
 
         // Cancel any in-progress Update request and arrange to re-try it after a delay.
 #if WEAVE_CONFIG_ENABLE_WDM_UPDATE
-        pClient->mUpdateClient.CancelUpdate();
+        for (size_t i = 0; i < ArraySize(pClient->mUpdateSlots); i++)
+        {
+            pClient->mUpdateSlots[i].mUpdateClient.CancelUpdate();
+        }
         if (pClient->IsUpdatePendingOrInProgress())
         {
             pClient->StartUpdateRetryTimer(aInParam.BindingFailed.Reason);
@@ -1570,8 +1587,8 @@ void SubscriptionClient::NotificationRequestHandler(nl::Weave::ExchangeContext *
     SuccessOrExit(err);
 
 #if WEAVE_CONFIG_DATA_MANAGEMENT_ENABLE_SCHEMA_CHECK
-    // simple schema checking
-    err = notify.CheckSchemaValidity();
+    // simple schema checking; the data elements are checked as ProcessDataList goes through them
+    err = notify.CheckEnvelopeValidity();
     SuccessOrExit(err);
 #endif // WEAVE_CONFIG_DATA_MANAGEMENT_ENABLE_SCHEMA_CHECK
 
@@ -2147,20 +2164,21 @@ void SubscriptionClient::SetMaxUpdateSize(const uint32_t aMaxSize)
  * Move paths from the dispatched store back to the pending one.
  * Skip the private ones, as they will be re-added during the recursion.
  */
-WEAVE_ERROR SubscriptionClient::MoveInProgressToPending(void)
+WEAVE_ERROR SubscriptionClient::MoveInProgressToPending(UpdateRequestSlot & aSlot)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     uint32_t count = 0;
     TraitDataSink *dataSink;
     TraitPath traitPath;
+    TraitPathStore & inProgressUpdateList = aSlot.mInProgressUpdateList;
 
-    for (size_t i = mInProgressUpdateList.GetFirstValidItem();
-            i < mInProgressUpdateList.GetPathStoreSize();
-            i = mInProgressUpdateList.GetNextValidItem(i))
+    for (size_t i = inProgressUpdateList.GetFirstValidItem();
+            i < inProgressUpdateList.GetPathStoreSize();
+            i = inProgressUpdateList.GetNextValidItem(i))
     {
-        mInProgressUpdateList.GetItemAt(i, traitPath);
+        inProgressUpdateList.GetItemAt(i, traitPath);
 
-        if ( ! mInProgressUpdateList.AreFlagsSet(i, kFlag_Private))
+        if ( ! inProgressUpdateList.AreFlagsSet(i, kFlag_Private))
         {
             // Locate() can return an error if the sink has been removed from the catalog. In that case,
             // skip this path
@@ -2172,7 +2190,7 @@ WEAVE_ERROR SubscriptionClient::MoveInProgressToPending(void)
                 count++;
             }
 
-            mInProgressUpdateList.RemoveItemAt(i);
+            inProgressUpdateList.RemoveItemAt(i);
         }
     }
 
@@ -2184,9 +2202,9 @@ WEAVE_ERROR SubscriptionClient::MoveInProgressToPending(void)
     }
 
     // Call clear to remove the private ones as well and anything else.
-    mInProgressUpdateList.Clear();
+    inProgressUpdateList.Clear();
 
-    mUpdateRequestContext.Reset();
+    aSlot.mUpdateRequestContext.Reset();
 
 exit:
     WeaveLogDetail(DataManagement, "Moved %" PRIu32 " items from InProgress to Pending; err %" PRId32 "", count, err);
@@ -2194,32 +2212,57 @@ exit:
     return err;
 }
 
-// Move the pending set to the in-progress list, grouping the
-// paths by trait instance
-WEAVE_ERROR SubscriptionClient::MovePendingToInProgress(void)
+// Move the pending set to the in-progress list of a slot, grouping the
+// paths by trait instance.
+// The paths of trait instances that are in progress in another slot of the
+// update window stay pending: updates to a trait instance are sent one at a
+// time, so that they are applied in order and a conditional update can
+// require the version created by the previous one.
+WEAVE_ERROR SubscriptionClient::MovePendingToInProgress(UpdateRequestSlot & aSlot)
 {
-    VerifyOrDie(mInProgressUpdateList.IsEmpty());
+    TraitPath traitPath;
+
+    VerifyOrDie(aSlot.mInProgressUpdateList.IsEmpty());
 
     if (mDataSinkCatalog)
     {
-        mDataSinkCatalog->Iterate(MovePendingToInProgressUpdatableSinkTrait, this);
+        mDataSinkCatalog->Iterate(MovePendingToInProgressUpdatableSinkTrait, &aSlot);
+    }
+
+    for (size_t i = mPendingUpdateSet.GetFirstValidItem();
+            i < mPendingUpdateSet.GetPathStoreSize();
+            i = mPendingUpdateSet.GetNextValidItem(i))
+    {
+        mPendingUpdateSet.GetItemAt(i, traitPath);
+
+        if (false == IsTraitInProgress(traitPath.mTraitDataHandle, &aSlot))
+        {
+            mPendingUpdateSet.RemoveItemAt(i);
+        }
     }
 
-    mPendingUpdateSet.Clear();
-    SetPendingSetState(kPendingSetEmpty);
+    if (mPendingUpdateSet.IsEmpty())
+    {
+        mPendingUpdateSet.Clear();
+        SetPendingSetState(kPendingSetEmpty);
+    }
 
     return WEAVE_NO_ERROR;
 }
 
 void SubscriptionClient::MovePendingToInProgressUpdatableSinkTrait(void * aDataSink, TraitDataHandle aDataHandle, void * aContext)
 {
-    SubscriptionClient * subClient = static_cast<SubscriptionClient *>(aContext);
+    UpdateRequestSlot * slot = static_cast<UpdateRequestSlot *>(aContext);
+    SubscriptionClient * subClient = slot->mpClient;
     TraitDataSink * dataSink = static_cast<TraitDataSink *>(aDataSink);
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     int count = 0;
 
     VerifyOrExit(dataSink->IsUpdatableDataSink() == true, /* no error */);
 
+    VerifyOrExit(false == subClient->IsTraitInProgress(aDataHandle, slot),
+            WeaveLogDetail(DataManagement, "Holding back trait %u: update in progress", aDataHandle));
+
     for (size_t i = subClient->mPendingUpdateSet.GetFirstValidItem(aDataHandle);
             i < subClient->mPendingUpdateSet.GetPathStoreSize();
             i = subClient->mPendingUpdateSet.GetNextValidItem(i, aDataHandle))
@@ -2228,7 +2271,7 @@ void SubscriptionClient::MovePendingToInProgressUpdatableSinkTrait(void * aDataS
 
         subClient->mPendingUpdateSet.GetItemAt(i, traitPath);
 
-        err = subClient->mInProgressUpdateList.AddItem(traitPath);
+        err = slot->mInProgressUpdateList.AddItem(traitPath);
         SuccessOrExit(err);
         count++;
     }
@@ -2294,9 +2337,12 @@ void SubscriptionClient::PurgeAndNotifyFailedPaths(WEAVE_ERROR aErr, TraitPathSt
     {
         SetPendingSetState(kPendingSetEmpty);
     }
-    if (&aPathStore == &mInProgressUpdateList)
+    for (size_t i = 0; i < ArraySize(mUpdateSlots); i++)
     {
-        mUpdateRequestContext.Reset();
+        if (&aPathStore == &mUpdateSlots[i].mInProgressUpdateList)
+        {
+            mUpdateSlots[i].mUpdateRequestContext.Reset();
+        }
     }
 
     return;
@@ -2349,8 +2395,12 @@ bool SubscriptionClient::FilterNotifiedPath(TraitDataHandle aTraitDataHandle,
 {
     bool retval = false;
 
-    retval = mInProgressUpdateList.Includes(TraitPath(aTraitDataHandle, aLeafPathHandle), aSchemaEngine) ||
-             mPendingUpdateSet.Includes(TraitPath(aTraitDataHandle, aLeafPathHandle), aSchemaEngine);
+    retval = mPendingUpdateSet.Includes(TraitPath(aTraitDataHandle, aLeafPathHandle), aSchemaEngine);
+
+    for (size_t i = 0; i < ArraySize(mUpdateSlots) && !retval; i++)
+    {
+        retval = mUpdateSlots[i].mInProgressUpdateList.Includes(TraitPath(aTraitDataHandle, aLeafPathHandle), aSchemaEngine);
+    }
 
     if (retval)
     {
@@ -2454,7 +2504,8 @@ void SubscriptionClient::SetPendingSetState(PendingSetState aState)
 }
 
 // TODO: Break this method down into smaller methods.
-void SubscriptionClient::OnUpdateResponse(WEAVE_ERROR aReason, nl::Weave::Profiles::StatusReporting::StatusReport * apStatus)
+void SubscriptionClient::OnUpdateResponse(UpdateRequestSlot & aSlot, WEAVE_ERROR aReason,
+                                          nl::Weave::Profiles::StatusReporting::StatusReport * apStatus)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     WEAVE_ERROR callbackerr;
@@ -2475,6 +2526,7 @@ void SubscriptionClient::OnUpdateResponse(WEAVE_ERROR aReason, nl::Weave::Profil
     bool isPathSuccessful;
     bool isPathPrivate;
     bool willRetryPath;
+    TraitPathStore & inProgressUpdateList = aSlot.mInProgressUpdateList;
 
     // This method invokes callbacks into the upper layer.
     _AddRef();
@@ -2482,9 +2534,9 @@ void SubscriptionClient::OnUpdateResponse(WEAVE_ERROR aReason, nl::Weave::Profil
     LockUpdateMutex();
 
     additionalInfo = apStatus->mAdditionalInfo;
-    ClearUpdateInFlight();
+    aSlot.mUpdateInFlight = false;
 
-    if (mUpdateRequestContext.mIsPartialUpdate)
+    if (aSlot.mUpdateRequestContext.mIsPartialUpdate)
     {
         WeaveLogDetail(DataManagement, "Got StatusReport in the middle of a long update");
     }
@@ -2560,9 +2612,9 @@ void SubscriptionClient::OnUpdateResponse(WEAVE_ERROR aReason, nl::Weave::Profil
     // TODO: validate that the version and status lists are either empty or contain
     // the same number of items as the dispatched list
 
-    for (size_t j = mInProgressUpdateList.GetFirstValidItem();
-            j < mInProgressUpdateList.GetPathStoreSize();
-            j = mInProgressUpdateList.GetNextValidItem(j))
+    for (size_t j = inProgressUpdateList.GetFirstValidItem();
+            j < inProgressUpdateList.GetPathStoreSize();
+            j = inProgressUpdateList.GetNextValidItem(j))
     {
         if (IsVersionListPresent)
         {
@@ -2596,9 +2648,9 @@ void SubscriptionClient::OnUpdateResponse(WEAVE_ERROR aReason, nl::Weave::Profil
 
         willRetryPath = WillRetryUpdate(callbackerr, profileID, statusCode);
 
-        isPathPrivate = mInProgressUpdateList.AreFlagsSet(j, kFlag_Private);
+        isPathPrivate = inProgressUpdateList.AreFlagsSet(j, kFlag_Private);
 
-        mInProgressUpdateList.GetItemAt(j, traitPath);
+        inProgressUpdateList.GetItemAt(j, traitPath);
 
         updatableDataSink = Locate(traitPath.mTraitDataHandle, mDataSinkCatalog);
 
@@ -2607,7 +2659,7 @@ void SubscriptionClient::OnUpdateResponse(WEAVE_ERROR aReason, nl::Weave::Profil
             // Locate() can return an error if the sink has been removed from the catalog. In that case, ignore this path
             WeaveLogDetail(DataManagement, "item: %zu, traitDataHandle: % potentially removed from the catalog" PRIu16 ", pathHandle: %" PRIu32 "",
                     j, traitPath.mTraitDataHandle, traitPath.mPropertyPathHandle);
-            mInProgressUpdateList.RemoveItemAt(j);
+            inProgressUpdateList.RemoveItemAt(j);
             continue;
         }
 
@@ -2618,7 +2670,7 @@ void SubscriptionClient::OnUpdateResponse(WEAVE_ERROR aReason, nl::Weave::Profil
 
         if (isPathSuccessful)
         {
-            mInProgressUpdateList.RemoveItemAt(j);
+            inProgressUpdateList.RemoveItemAt(j);
 
             if (updatableDataSink->IsConditionalUpdate())
             {
@@ -2652,7 +2704,7 @@ void SubscriptionClient::OnUpdateResponse(WEAVE_ERROR aReason, nl::Weave::Profil
             if (profileID == nl::Weave::Profiles::kWeaveProfile_WDM &&
                     statusCode == nl::Weave::Profiles::DataManagement::kStatus_VersionMismatch)
             {
-                mInProgressUpdateList.RemoveItemAt(j);
+                inProgressUpdateList.RemoveItemAt(j);
 
                 // Fail all pending ones as well for VersionMismatch and force resubscribe
                 if (mPendingUpdateSet.IsTraitPresent(traitPath.mTraitDataHandle))
@@ -2670,7 +2722,7 @@ void SubscriptionClient::OnUpdateResponse(WEAVE_ERROR aReason, nl::Weave::Profil
                 // Else, throw away all updates in the trait instance.
                 if (false == willRetryPath)
                 {
-                    mInProgressUpdateList.RemoveItemAt(j);
+                    inProgressUpdateList.RemoveItemAt(j);
 
                     if (updatableDataSink->IsConditionalUpdate() &&
                             mPendingUpdateSet.IsTraitPresent(traitPath.mTraitDataHandle))
@@ -2700,7 +2752,7 @@ void SubscriptionClient::OnUpdateResponse(WEAVE_ERROR aReason, nl::Weave::Profil
             // the next item in the list will be invalid, and the loop will terminate.
             // Either this method or DiscardUpdates will trigger a resubscription.
         }
-    } // for all paths in mInProgressUpdateList
+    } // for all paths in inProgressUpdateList
 
 exit:
 
@@ -2711,25 +2763,25 @@ exit:
         // If the loop above exited early for an error, the application
         // is notified for any remaining path by the following method.
         // These paths are not retried.
-        mInProgressUpdateList.SetFailed();
-        PurgeAndNotifyFailedPaths(err, mInProgressUpdateList, count);
+        inProgressUpdateList.SetFailed();
+        PurgeAndNotifyFailedPaths(err, inProgressUpdateList, count);
         needToResubscribe = true;
     }
     else
     {
         // Whatever was not discarded above should be retried
-        err = MoveInProgressToPending();
+        err = MoveInProgressToPending(aSlot);
         if (err != WEAVE_NO_ERROR)
         {
             AbortUpdates(err);
         }
     }
 
-    mUpdateRequestContext.Reset();
+    aSlot.mUpdateRequestContext.Reset();
 
     PurgePendingUpdate();
 
-    if (mPendingSetState == kPendingSetEmpty)
+    if (mPendingSetState == kPendingSetEmpty && false == IsUpdateInProgress())
     {
         mUpdateRetryCounter = 0;
 
@@ -2764,25 +2816,26 @@ exit:
  * This handler is optimized for the case that the request never reached the
  * responder: the dispatched paths are put back in the pending queue and retried.
  */
-void SubscriptionClient::OnUpdateNoResponse(WEAVE_ERROR aError)
+void SubscriptionClient::OnUpdateNoResponse(UpdateRequestSlot & aSlot, WEAVE_ERROR aError)
 {
     TraitPath traitPath;
     WEAVE_ERROR err = WEAVE_NO_ERROR;
+    TraitPathStore & inProgressUpdateList = aSlot.mInProgressUpdateList;
 
     _AddRef();
 
     LockUpdateMutex();
 
-    ClearUpdateInFlight();
+    aSlot.mUpdateInFlight = false;
 
     // Notify the app for all dispatched paths.
-    for (size_t j = mInProgressUpdateList.GetFirstValidItem();
-            j < mInProgressUpdateList.GetPathStoreSize();
-            j = mInProgressUpdateList.GetNextValidItem(j))
+    for (size_t j = inProgressUpdateList.GetFirstValidItem();
+            j < inProgressUpdateList.GetPathStoreSize();
+            j = inProgressUpdateList.GetNextValidItem(j))
     {
-        if (! mInProgressUpdateList.AreFlagsSet(j, kFlag_Private))
+        if (! inProgressUpdateList.AreFlagsSet(j, kFlag_Private))
         {
-            mInProgressUpdateList.GetItemAt(j, traitPath);
+            inProgressUpdateList.GetItemAt(j, traitPath);
 
             UpdateCompleteEventCbHelper(traitPath,
                                         nl::Weave::Profiles::kWeaveProfile_Common,
@@ -2793,7 +2846,7 @@ void SubscriptionClient::OnUpdateNoResponse(WEAVE_ERROR aError)
     }
 
     //Move paths from DispatchedUpdates to PendingUpdates for all TIs.
-    err = MoveInProgressToPending();
+    err = MoveInProgressToPending(aSlot);
     if (err != WEAVE_NO_ERROR)
     {
         AbortUpdates(err);
@@ -2805,7 +2858,10 @@ void SubscriptionClient::OnUpdateNoResponse(WEAVE_ERROR aError)
 
     if (mPendingUpdateSet.IsEmpty())
     {
-        NoMorePendingEventCbHelper();
+        if (false == IsUpdateInProgress())
+        {
+            NoMorePendingEventCbHelper();
+        }
     }
     else
     {
@@ -2822,7 +2878,8 @@ void SubscriptionClient::UpdateEventCallback (void * const aAppState,
                                               const UpdateClient::InEventParam & aInParam,
                                               UpdateClient::OutEventParam & aOutParam)
 {
-    SubscriptionClient * const pSubClient = reinterpret_cast<SubscriptionClient *>(aAppState);
+    UpdateRequestSlot * const pSlot = reinterpret_cast<UpdateRequestSlot *>(aAppState);
+    SubscriptionClient * const pSubClient = pSlot->mpClient;
 
     switch (aEvent)
     {
@@ -2831,17 +2888,17 @@ void SubscriptionClient::UpdateEventCallback (void * const aAppState,
 
         if (aInParam.UpdateComplete.Reason == WEAVE_NO_ERROR)
         {
-            pSubClient->OnUpdateResponse(aInParam.UpdateComplete.Reason, aInParam.UpdateComplete.StatusReportPtr);
+            pSubClient->OnUpdateResponse(*pSlot, aInParam.UpdateComplete.Reason, aInParam.UpdateComplete.StatusReportPtr);
         }
         else
         {
-            pSubClient->OnUpdateNoResponse(aInParam.UpdateComplete.Reason);
+            pSubClient->OnUpdateNoResponse(*pSlot, aInParam.UpdateComplete.Reason);
         }
 
         break;
     case UpdateClient::kEvent_UpdateContinue:
         WeaveLogDetail(DataManagement, "UpdateContinue event: %d", aEvent);
-        pSubClient->ClearUpdateInFlight();
+        pSlot->mUpdateInFlight = false;
         pSubClient->FormAndSendUpdate();
         break;
     default:
@@ -2878,7 +2935,7 @@ WEAVE_ERROR SubscriptionClient::SetUpdated(TraitUpdatableDataSink * aDataSink, P
     SuccessOrExit(err);
 
     isTraitInstanceInUpdate = mPendingUpdateSet.IsTraitPresent(dataHandle) ||
-                              mInProgressUpdateList.IsTraitPresent(dataHandle);
+                              IsTraitInProgress(dataHandle, NULL);
 
     // It is not supported to mix conditional and non-conditional updates
     // in the same trait.
@@ -2943,7 +3000,7 @@ exit:
 
 /**
  * Tells the SubscriptionClient to empty the set of TraitPaths pending to be updated and abort the
- * update request that is in progress, if any.
+ * update requests that are in progress, if any.
  * This method can be invoked from any callback.
  */
 void SubscriptionClient::DiscardUpdates()
@@ -2953,7 +3010,7 @@ void SubscriptionClient::DiscardUpdates()
 
 /**
  * Empties the set of TraitPaths pending to be updated and aborts the
- * update request that is in progress, if any.
+ * update requests that are in progress, if any.
  * Calls the application callback for every path if the error code passed is not WEAVE_NO_ERROR.
  *
  * Note that this method is written to be reentrant. If this is called internally with an
@@ -2980,9 +3037,11 @@ void SubscriptionClient::AbortUpdates(WEAVE_ERROR aErr)
 
     mUpdateFlushScheduled = false;
 
-    ClearUpdateInFlight();
-
-    mUpdateClient.CancelUpdate();
+    for (size_t i = 0; i < ArraySize(mUpdateSlots); i++)
+    {
+        mUpdateSlots[i].mUpdateInFlight = false;
+        mUpdateSlots[i].mUpdateClient.CancelUpdate();
+    }
 
     if (mDataSinkCatalog)
     {
@@ -3001,8 +3060,11 @@ void SubscriptionClient::AbortUpdates(WEAVE_ERROR aErr)
         mPendingUpdateSet.Clear();
         SetPendingSetState(kPendingSetEmpty);
 
-        numInProgress = mInProgressUpdateList.GetNumItems();
-        mInProgressUpdateList.Clear();
+        for (size_t i = 0; i < ArraySize(mUpdateSlots); i++)
+        {
+            numInProgress += mUpdateSlots[i].mInProgressUpdateList.GetNumItems();
+            mUpdateSlots[i].mInProgressUpdateList.Clear();
+        }
     }
     else
     {
@@ -3014,9 +3076,19 @@ void SubscriptionClient::AbortUpdates(WEAVE_ERROR aErr)
         // unless SetUpdated() has been by a callback for an earlier element.
 
         mPendingUpdateSet.SetFailed();
-        mInProgressUpdateList.SetFailed();
+        for (size_t i = 0; i < ArraySize(mUpdateSlots); i++)
+        {
+            mUpdateSlots[i].mInProgressUpdateList.SetFailed();
+        }
+
         PurgeAndNotifyFailedPaths(aErr, mPendingUpdateSet, numPending);
-        PurgeAndNotifyFailedPaths(aErr, mInProgressUpdateList, numInProgress);
+        for (size_t i = 0; i < ArraySize(mUpdateSlots); i++)
+        {
+            size_t numInSlot = 0;
+
+            PurgeAndNotifyFailedPaths(aErr, mUpdateSlots[i].mInProgressUpdateList, numInSlot);
+            numInProgress += numInSlot;
+        }
     }
 
     WeaveLogDetail(DataManagement, "Discarded %" PRIu32 " pending  and %" PRIu32 " inProgress paths",
@@ -3043,7 +3115,7 @@ void SubscriptionClient::RefreshUpdatableSinkTrait(void * aDataSink, TraitDataHa
         refreshTraitInstance = true;
     }
 
-    if (subClient->mInProgressUpdateList.IsTraitPresent(aDataHandle))
+    if (subClient->IsTraitInProgress(aDataHandle, NULL))
     {
         refreshTraitInstance = true;
     }
@@ -3136,16 +3208,16 @@ exit:
     return;
 }
 
-void SubscriptionClient::SetUpdateStartVersions(void)
+void SubscriptionClient::SetUpdateStartVersions(UpdateRequestSlot & aSlot)
 {
     TraitPath traitPath;
     TraitUpdatableDataSink *updatableSink;
 
-    for (size_t i = mInProgressUpdateList.GetFirstValidItem();
-            i < mInProgressUpdateList.GetPathStoreSize();
-            i = mInProgressUpdateList.GetNextValidItem(i))
+    for (size_t i = aSlot.mInProgressUpdateList.GetFirstValidItem();
+            i < aSlot.mInProgressUpdateList.GetPathStoreSize();
+            i = aSlot.mInProgressUpdateList.GetNextValidItem(i))
     {
-        mInProgressUpdateList.GetItemAt(i, traitPath);
+        aSlot.mInProgressUpdateList.GetItemAt(i, traitPath);
 
         updatableSink = Locate(traitPath.mTraitDataHandle, mDataSinkCatalog);
         if (NULL != updatableSink)
@@ -3155,7 +3227,7 @@ void SubscriptionClient::SetUpdateStartVersions(void)
     }
 }
 
-WEAVE_ERROR SubscriptionClient::SendSingleUpdateRequest(void)
+WEAVE_ERROR SubscriptionClient::SendSingleUpdateRequest(UpdateRequestSlot & aSlot)
 {
     WEAVE_ERROR err   = WEAVE_NO_ERROR;
     uint32_t maxUpdateSize;
@@ -3164,58 +3236,60 @@ WEAVE_ERROR SubscriptionClient::SendSingleUpdateRequest(void)
     UpdateEncoder::Context context;
 
     maxUpdateSize = GetMaxUpdateSize();
-    err = mUpdateClient.mpBinding->AllocateRightSizedBuffer(pBuf, maxUpdateSize, WDM_MIN_UPDATE_SIZE, maxPayloadSize);
+    err = aSlot.mUpdateClient.mpBinding->AllocateRightSizedBuffer(pBuf, maxUpdateSize, WDM_MIN_UPDATE_SIZE, maxPayloadSize);
     SuccessOrExit(err);
 
-    mUpdateRequestContext.mIsPartialUpdate = false;
+    aSlot.mUpdateRequestContext.mIsPartialUpdate = false;
 
     context.mBuf = pBuf;
     context.mMaxPayloadSize = maxPayloadSize;
-    context.mUpdateRequestIndex = mUpdateRequestContext.mUpdateRequestIndex;
+    context.mUpdateRequestIndex = aSlot.mUpdateRequestContext.mUpdateRequestIndex;
     context.mExpiryTimeMicroSecond = 0;
-    context.mItemInProgress = mUpdateRequestContext.mItemInProgress;
-    context.mNextDictionaryElementPathHandle = mUpdateRequestContext.mNextDictionaryElementPathHandle;
-    context.mInProgressUpdateList = &mInProgressUpdateList;
+    context.mItemInProgress = aSlot.mUpdateRequestContext.mItemInProgress;
+    context.mNextDictionaryElementPathHandle = aSlot.mUpdateRequestContext.mNextDictionaryElementPathHandle;
+    context.mInProgressUpdateList = &aSlot.mInProgressUpdateList;
     context.mDataSinkCatalog = mDataSinkCatalog;
 
     err = mUpdateEncoder.EncodeRequest(context);
     SuccessOrExit(err);
 
-    mUpdateRequestContext.mNextDictionaryElementPathHandle = context.mNextDictionaryElementPathHandle;
+    aSlot.mUpdateRequestContext.mNextDictionaryElementPathHandle = context.mNextDictionaryElementPathHandle;
 
-    if (context.mItemInProgress < mInProgressUpdateList.GetPathStoreSize())
+    if (context.mItemInProgress < aSlot.mInProgressUpdateList.GetPathStoreSize())
     {
         // This is a PartialUpdateRequest; increase the index for the next one
-        mUpdateRequestContext.mIsPartialUpdate = true;
-        mUpdateRequestContext.mUpdateRequestIndex++;
+        aSlot.mUpdateRequestContext.mIsPartialUpdate = true;
+        aSlot.mUpdateRequestContext.mUpdateRequestIndex++;
     }
 
 
     if (context.mNumDataElementsAddedToPayload > 0)
     {
-        if (false == mUpdateRequestContext.mIsPartialUpdate)
+        if (false == aSlot.mUpdateRequestContext.mIsPartialUpdate)
         {
             // TODO: Should this happen at the first PartialUpdateRequest, or at the final UpdateRequest?
-            SetUpdateStartVersions();
+            SetUpdateStartVersions(aSlot);
         }
 
         WeaveLogDetail(DataManagement, "Sending %sUpdateRequest with %" PRIu16 " DEs",
-                mUpdateRequestContext.mIsPartialUpdate ? "Partial" : "",
+                aSlot.mUpdateRequestContext.mIsPartialUpdate ? "Partial" : "",
                 context.mNumDataElementsAddedToPayload);
 
-        // TODO: SetUpdateInFlight is here instead of after SendUpdate
+        // TODO: mUpdateInFlight is set here instead of after SendUpdate
         // to be able to inject timeouts; must improve this..
-        SetUpdateInFlight();
+        aSlot.mUpdateInFlight = true;
 
-        err = mUpdateClient.SendUpdate(mUpdateRequestContext.mIsPartialUpdate, pBuf, context.mUpdateRequestIndex == 0);
+        err = aSlot.mUpdateClient.SendUpdate(aSlot.mUpdateRequestContext.mIsPartialUpdate, pBuf, context.mUpdateRequestIndex == 0);
         pBuf = NULL;
         SuccessOrExit(err);
 
-        mUpdateRequestContext.mItemInProgress = context.mItemInProgress;
+        WeaveLogDetail(DataManagement, "Updates in flight: %u", GetNumUpdatesInFlight());
+
+        aSlot.mUpdateRequestContext.mItemInProgress = context.mItemInProgress;
     }
     else
     {
-        mUpdateClient.CancelUpdate();
+        aSlot.mUpdateClient.CancelUpdate();
     }
 
 exit:
@@ -3237,22 +3311,36 @@ exit:
 void SubscriptionClient::FormAndSendUpdate()
 {
     WEAVE_ERROR err                  = WEAVE_NO_ERROR;
+    UpdateRequestSlot * slot         = NULL;
 
     LockUpdateMutex();
 
-    VerifyOrExit(!IsUpdateInFlight(), WeaveLogDetail(DataManagement, "Update request in flight"));
+    slot = GetFreeUpdateSlot();
+    VerifyOrExit(NULL != slot, WeaveLogDetail(DataManagement, "Update request in flight"));
 
     WeaveLogDetail(DataManagement, "Eval Subscription: (state = %s)!", GetStateStr());
 
     if (mBinding->IsReady())
     {
-        if (mInProgressUpdateList.IsEmpty() && mPendingSetState == kPendingSetReady)
+        // Keep dispatching until the update window is full or
+        // nothing else can be sent for now.
+        while (NULL != slot)
         {
-            MovePendingToInProgress();
-        }
+            if (slot->mInProgressUpdateList.IsEmpty() && mPendingSetState == kPendingSetReady)
+            {
+                MovePendingToInProgress(*slot);
+            }
 
-        err = SendSingleUpdateRequest();
-        SuccessOrExit(err);
+            err = SendSingleUpdateRequest(*slot);
+            SuccessOrExit(err);
+
+            if (false == slot->mUpdateInFlight)
+            {
+                break;
+            }
+
+            slot = GetFreeUpdateSlot();
+        }
 
         WeaveLogDetail(DataManagement, "Done update processing!");
     }
@@ -3268,7 +3356,7 @@ exit:
     {
         // If anything failed, the UpdateRequest payload was not sent.
         // Move paths back to pending and retry later.
-        OnUpdateNoResponse(err);
+        OnUpdateNoResponse(*slot, err);
     }
 
     UnlockUpdateMutex();
@@ -3312,7 +3400,7 @@ WEAVE_ERROR SubscriptionClient::FlushUpdate(bool aForce)
     VerifyOrExit(mPendingSetState == kPendingSetReady,
             WeaveLogDetail(DataManagement, "%s: PendingSetState: %d; err = %s", __func__, mPendingSetState, nl::ErrorStr(err)));
 
-    VerifyOrExit(false == IsUpdateInFlight(),
+    VerifyOrExit(NULL != GetFreeUpdateSlot(),
             WeaveLogDetail(DataManagement, "%s: update already in flight", __func__));
 
     if (aForce)
@@ -3443,6 +3531,123 @@ exit:
     return;
 }
 
+#if WDM_CLIENT_MAX_UPDATE_WINDOW_SIZE > 1
+WEAVE_ERROR SubscriptionClient::SetUpdateWindowSize(const uint8_t aWindowSize)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    VerifyOrExit((aWindowSize > 0) && (aWindowSize <= WDM_CLIENT_MAX_UPDATE_WINDOW_SIZE), err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    LockUpdateMutex();
+
+    // Shrinking the window below the number of updates in progress is fine: the slots beyond the
+    // new size are left to complete, and no new update is dispatched in them.
+    mUpdateWindowSize = aWindowSize;
+
+    UnlockUpdateMutex();
+
+exit:
+    WeaveLogFunctError(err);
+
+    return err;
+}
+#endif // WDM_CLIENT_MAX_UPDATE_WINDOW_SIZE > 1
+
+bool SubscriptionClient::IsUpdateInFlight()
+{
+    bool retval = false;
+
+    for (size_t i = 0; i < ArraySize(mUpdateSlots) && !retval; i++)
+    {
+        retval = mUpdateSlots[i].mUpdateInFlight;
+    }
+
+    return retval;
+}
+
+uint8_t SubscriptionClient::GetNumUpdatesInFlight(void) const
+{
+    uint8_t numInFlight = 0;
+
+    for (size_t i = 0; i < ArraySize(mUpdateSlots); i++)
+    {
+        if (mUpdateSlots[i].mUpdateInFlight)
+        {
+            numInFlight++;
+        }
+    }
+
+    return numInFlight;
+}
+
+bool SubscriptionClient::IsUpdateInProgress()
+{
+    bool retval = false;
+
+    for (size_t i = 0; i < ArraySize(mUpdateSlots) && !retval; i++)
+    {
+        retval = (false == mUpdateSlots[i].mInProgressUpdateList.IsEmpty());
+    }
+
+    return retval;
+}
+
+/**
+ * Whether any path of a trait instance is in progress in a slot of the update window.
+ *
+ * @param[in] aTraitDataHandle  The trait instance.
+ * @param[in] aSkipSlot         A slot to ignore, or NULL to look at all of them.
+ */
+bool SubscriptionClient::IsTraitInProgress(TraitDataHandle aTraitDataHandle, const UpdateRequestSlot * aSkipSlot)
+{
+    bool retval = false;
+
+    for (size_t i = 0; i < ArraySize(mUpdateSlots) && !retval; i++)
+    {
+        if (&mUpdateSlots[i] != aSkipSlot)
+        {
+            retval = mUpdateSlots[i].mInProgressUpdateList.IsTraitPresent(aTraitDataHandle);
+        }
+    }
+
+    return retval;
+}
+
+/**
+ * Returns the slot of the update window the next update request should be sent in,
+ * or NULL if the window is full.
+ * A slot that was interrupted in the middle of a sequence of PartialUpdateRequests
+ * is preferred over an empty one, and is resumed even if the window has been shrunk
+ * since it was started.
+ */
+SubscriptionClient::UpdateRequestSlot * SubscriptionClient::GetFreeUpdateSlot(void)
+{
+    UpdateRequestSlot * freeSlot = NULL;
+
+    for (size_t i = 0; i < ArraySize(mUpdateSlots); i++)
+    {
+        UpdateRequestSlot & slot = mUpdateSlots[i];
+
+        if (slot.mUpdateInFlight)
+        {
+            continue;
+        }
+
+        if (false == slot.mInProgressUpdateList.IsEmpty())
+        {
+            freeSlot = &slot;
+            break;
+        }
+
+        if (NULL == freeSlot && i < mUpdateWindowSize)
+        {
+            freeSlot = &slot;
+        }
+    }
+
+    return freeSlot;
+}
+
 void SubscriptionClient::UpdateRequestContext::Reset()
 {
     mItemInProgress = 0;
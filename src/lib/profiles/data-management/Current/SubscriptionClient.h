@@ -396,6 +396,26 @@ public:
     void OnCatalogChanged();
 
     bool IsUpdatePendingOrInProgress() { return (kPendingSetEmpty != mPendingSetState || IsUpdateInProgress()); }
+
+#if WDM_CLIENT_MAX_UPDATE_WINDOW_SIZE > 1
+    /**
+     * @brief Set the number of UpdateRequests that may be outstanding at the same time.
+     *
+     * With a window of 1 (the default), the client waits for the StatusReport of each update before dispatching
+     * the next one. With a larger window, each update goes out on its own exchange, and pending paths are dispatched
+     * as soon as a slot of the window is free. The paths of a trait instance that is already part of an outstanding
+     * update stay pending until that update completes, so that updates to the same trait instance are applied in
+     * order and conditional updates can chain on the version created by the previous one.
+     *
+     * @param[in] aWindowSize   Number of updates allowed in flight, between 1 and #WDM_CLIENT_MAX_UPDATE_WINDOW_SIZE.
+     *
+     * @retval #WEAVE_NO_ERROR                  On success.
+     * @retval #WEAVE_ERROR_INVALID_ARGUMENT    If the window size is out of range.
+     */
+    WEAVE_ERROR SetUpdateWindowSize(const uint8_t aWindowSize);
+
+    uint8_t GetUpdateWindowSize(void) const { return mUpdateWindowSize; }
+#endif // WDM_CLIENT_MAX_UPDATE_WINDOW_SIZE > 1
 #endif // WEAVE_CONFIG_ENABLE_WDM_UPDATE
 
 private:
@@ -553,6 +573,19 @@ private:
         uint32_t mUpdateRequestIndex;
         bool mIsPartialUpdate;
     };
+
+    // One slot of the update window: an UpdateRequest (or sequence of PartialUpdateRequests)
+    // and the paths it carries, from the moment they are taken out of the pending set
+    // until the StatusReport for them is processed.
+    struct UpdateRequestSlot
+    {
+        SubscriptionClient * mpClient;
+        UpdateClient mUpdateClient;
+        UpdateRequestContext mUpdateRequestContext;
+        TraitPathStore mInProgressUpdateList;
+        TraitPathStore::Record mInProgressStore[WDM_UPDATE_MAX_ITEMS_IN_TRAIT_DIRTY_PATH_STORE];
+        bool mUpdateInFlight;
+    };
     uint32_t mUpdateRetryCounter;
     bool mSuspendUpdateRetries;
     bool mUpdateRetryScheduled;
@@ -568,13 +601,14 @@ private:
 
     // Methods to encode and send update requests
     void FormAndSendUpdate();
-    WEAVE_ERROR SendSingleUpdateRequest(void);
+    WEAVE_ERROR SendSingleUpdateRequest(UpdateRequestSlot & aSlot);
     static WEAVE_ERROR AddElementFunc(UpdateEncoder * aEncoder, void * apCallState, TLV::TLVWriter & aOuterWriter);
-    void SetUpdateStartVersions(void);
+    void SetUpdateStartVersions(UpdateRequestSlot & aSlot);
 
     // Methods to handle update response and exchange failures (OnResponseTimeout, OnSendError)
-    void OnUpdateResponse(WEAVE_ERROR aReason, nl::Weave::Profiles::StatusReporting::StatusReport * apStatus);
-    void OnUpdateNoResponse(WEAVE_ERROR aReason);
+    void OnUpdateResponse(UpdateRequestSlot & aSlot, WEAVE_ERROR aReason,
+                          nl::Weave::Profiles::StatusReporting::StatusReport * apStatus);
+    void OnUpdateNoResponse(UpdateRequestSlot & aSlot, WEAVE_ERROR aReason);
     static bool WillRetryUpdate(WEAVE_ERROR aErr, uint32_t aStatusProfileId, uint16_t aStatusCode);
 
     // Methods to purge obsolete pending paths
@@ -601,18 +635,18 @@ private:
         kPendingSetReady
     };
     void SetPendingSetState(PendingSetState aState);
-    WEAVE_ERROR MovePendingToInProgress(void);
+    WEAVE_ERROR MovePendingToInProgress(UpdateRequestSlot & aSlot);
     WEAVE_ERROR AddItemPendingUpdateSet(const TraitPath & aItem, const TraitSchemaEngine * const aSchemaEngine);
-    WEAVE_ERROR MoveInProgressToPending(void);
+    WEAVE_ERROR MoveInProgressToPending(UpdateRequestSlot & aSlot);
 
     // Tracking if a payload is in flight
-    bool IsUpdateInFlight() { return mUpdateInFlight; }
-    void SetUpdateInFlight() { mUpdateInFlight = true; }
-    void ClearUpdateInFlight() { mUpdateInFlight = false; }
+    bool IsUpdateInFlight();
+    uint8_t GetNumUpdatesInFlight(void) const;
+    UpdateRequestSlot * GetFreeUpdateSlot(void);
 
     // Knowing if an update is pending or in progress
-    bool IsUpdateInProgress() { return (false == mInProgressUpdateList.IsEmpty()); }
-    bool IsReadyToSendNewUpdate() { return (mPendingSetState == kPendingSetReady && false == IsUpdateInProgress()); }
+    bool IsUpdateInProgress();
+    bool IsTraitInProgress(TraitDataHandle aTraitDataHandle, const UpdateRequestSlot * aSkipSlot);
 
     // Methods to notify the application
     void UpdateCompleteEventCbHelper(const TraitPath & aTraitPath, uint32_t aStatusProfileId, uint16_t aStatusCode,
@@ -633,9 +667,8 @@ private:
     static void CleanupUpdatableSinkTrait(void * aDataSink, TraitDataHandle aDataHandle, void * aContext);
 
     bool mResubscribeNeeded;
-    UpdateRequestContext mUpdateRequestContext;
     uint16_t mMaxUpdateSize;
-    bool mUpdateInFlight;
+    uint8_t mUpdateWindowSize;
 
     // Flags used with mInProgressUpdateList
     enum
@@ -656,10 +689,8 @@ private:
     TraitPathStore mPendingUpdateSet;
     TraitPathStore::Record mPendingStore[WDM_UPDATE_MAX_ITEMS_IN_TRAIT_DIRTY_PATH_STORE];
 
-    TraitPathStore mInProgressUpdateList;
-    TraitPathStore::Record mInProgressStore[WDM_UPDATE_MAX_ITEMS_IN_TRAIT_DIRTY_PATH_STORE];
+    UpdateRequestSlot mUpdateSlots[WDM_CLIENT_MAX_UPDATE_WINDOW_SIZE];
 
-    UpdateClient mUpdateClient;
     UpdateEncoder mUpdateEncoder;
 #endif // WEAVE_CONFIG_ENABLE_WDM_UPDATE
 };
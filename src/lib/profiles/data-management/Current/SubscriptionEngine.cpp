@@ -477,10 +477,35 @@ exit:
     }
 }
 
-WEAVE_ERROR SubscriptionEngine::ProcessDataList(nl::Weave::TLV::TLVReader & aReader,
-                                                const TraitCatalogBase<TraitDataSink> * aCatalog, bool & aOutIsPartialChange,
-                                                TraitDataHandle & aOutTraitDataHandle,
-                                                IDataElementAccessControlDelegate & acDelegate)
+/**
+ * Stores the Data Elements of a notification into the sinks of a catalog as the
+ * Data List is parsed. On a reject, the sinks addressed by the elements already
+ * stored lose their version, so that their data is fetched again instead of being
+ * trusted at a version it may not fully reflect.
+ */
+class DataListSinkVisitor : public DataList::Parser::Visitor
+{
+public:
+    DataListSinkVisitor(const nl::Weave::TLV::TLVReader & aListReader, const TraitCatalogBase<TraitDataSink> * aCatalog,
+                        bool & aOutIsPartialChange, TraitDataHandle & aOutTraitDataHandle,
+                        IDataElementAccessControlDelegate & acDelegate) :
+        mListReader(aListReader), mCatalog(aCatalog), mOutIsPartialChange(aOutIsPartialChange),
+        mOutTraitDataHandle(aOutTraitDataHandle), mAcDelegate(acDelegate)
+    { }
+
+    WEAVE_ERROR OnDataElement(const DataElement::Parser & aElement, const nl::Weave::TLV::TLVReader & aReader, uint32_t aIndex);
+    void OnRejected(WEAVE_ERROR aError, uint32_t aNumDelivered);
+
+private:
+    const nl::Weave::TLV::TLVReader mListReader;
+    const TraitCatalogBase<TraitDataSink> * mCatalog;
+    bool & mOutIsPartialChange;
+    TraitDataHandle & mOutTraitDataHandle;
+    IDataElementAccessControlDelegate & mAcDelegate;
+};
+
+WEAVE_ERROR DataListSinkVisitor::OnDataElement(const DataElement::Parser & aElement, const nl::Weave::TLV::TLVReader & aReader,
+                                               uint32_t aIndex)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
@@ -488,120 +513,145 @@ WEAVE_ERROR SubscriptionEngine::ProcessDataList(nl::Weave::TLV::TLVReader & aRea
     // that get aborted and restarted within the same notify. See WEAV-1586 for more details.
     bool isPartialChange = false;
     uint8_t flags;
+    nl::Weave::TLV::TLVReader pathReader;
+    TraitPath traitPath;
+    TraitDataSink * dataSink;
+    TraitDataHandle handle;
+    PropertyPathHandle pathHandle;
+    SchemaVersionRange versionRange;
 
-    VerifyOrExit(aCatalog != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
+    err = aElement.GetReaderOnPath(&pathReader);
+    SuccessOrExit(err);
 
-    while (WEAVE_NO_ERROR == (err = aReader.Next()))
-    {
-        nl::Weave::TLV::TLVReader pathReader;
+    err = aElement.GetPartialChangeFlag(&isPartialChange);
+    VerifyOrExit(err == WEAVE_NO_ERROR || err == WEAVE_END_OF_TLV, );
 
-        {
-            DataElement::Parser element;
+    err = mCatalog->AddressToHandle(pathReader, handle, versionRange);
 
-            err = element.Init(aReader);
-            SuccessOrExit(err);
+    if (err == WEAVE_ERROR_INVALID_PROFILE_ID)
+    {
+        // AddressToHandle() can return an error if the sink has been removed from the catalog. In that case,
+        // continue to next entry
+        ExitNow(err = WEAVE_NO_ERROR);
+    }
 
-            err = element.GetReaderOnPath(&pathReader);
-            SuccessOrExit(err);
+    SuccessOrExit(err);
 
-            isPartialChange = false;
-            err             = element.GetPartialChangeFlag(&isPartialChange);
-            VerifyOrExit(err == WEAVE_NO_ERROR || err == WEAVE_END_OF_TLV, );
-        }
+    if (mCatalog->Locate(handle, &dataSink) != WEAVE_NO_ERROR)
+    {
+        // Ideally, this code will not be reached as Locate() should find the entry in the catalog.
+        // Otherwise, the earlier AddressToHandle() call would have continued.
+        // However, keeping this check here for consistency and code safety
+        ExitNow();
+    }
 
-        TraitPath traitPath;
-        TraitDataSink * dataSink;
-        TraitDataHandle handle;
-        PropertyPathHandle pathHandle;
-        SchemaVersionRange versionRange;
+    err = dataSink->GetSchemaEngine()->MapPathToHandle(pathReader, pathHandle);
+#if TDM_DISABLE_STRICT_SCHEMA_COMPLIANCE
+    // if we're not in strict compliance mode, we can ignore data elements that refer to paths we can't map due to mismatching
+    // schema. The eventual call to StoreDataElement will correctly deal with the presence of a null property path handle that
+    // has been returned by the above call. It's necessary to call into StoreDataElement with this null handle to ensure
+    // the requisite OnEvent calls are made to the application despite the presence of an unknown tag. It's also necessary to
+    // ensure that we update the internal version tracked by the sink.
+    if (err == WEAVE_ERROR_TLV_TAG_NOT_FOUND)
+    {
+        WeaveLogDetail(DataManagement, "Ignoring un-mappable path!");
+        err = WEAVE_NO_ERROR;
+    }
+#endif
+    SuccessOrExit(err);
 
-        err = aCatalog->AddressToHandle(pathReader, handle, versionRange);
+    traitPath.mTraitDataHandle    = handle;
+    traitPath.mPropertyPathHandle = pathHandle;
 
-        if (err == WEAVE_ERROR_INVALID_PROFILE_ID)
-        {
-            // AddressToHandle() can return an error if the sink has been removed from the catalog. In that case,
-            // continue to next entry
-            err = WEAVE_NO_ERROR;
-            continue;
-        }
+    err = mAcDelegate.DataElementAccessCheck(traitPath, *mCatalog);
 
-        SuccessOrExit(err);
+    if (err == WEAVE_ERROR_ACCESS_DENIED)
+    {
+        WeaveLogDetail(DataManagement, "Ignoring path. Subscriptionless notification not accepted by data sink.");
 
-        if (aCatalog->Locate(handle, &dataSink) != WEAVE_NO_ERROR)
-        {
-            // Ideally, this code will not be reached as Locate() should find the entry in the catalog.
-            // Otherwise, the earlier AddressToHandle() call would have continued.
-            // However, keeping this check here for consistency and code safety
-            continue;
-        }
+        ExitNow(err = WEAVE_NO_ERROR);
+    }
+    SuccessOrExit(err);
 
-        err = dataSink->GetSchemaEngine()->MapPathToHandle(pathReader, pathHandle);
-#if TDM_DISABLE_STRICT_SCHEMA_COMPLIANCE
-        // if we're not in strict compliance mode, we can ignore data elements that refer to paths we can't map due to mismatching
-        // schema. The eventual call to StoreDataElement will correctly deal with the presence of a null property path handle that
-        // has been returned by the above call. It's necessary to call into StoreDataElement with this null handle to ensure
-        // the requisite OnEvent calls are made to the application despite the presence of an unknown tag. It's also necessary to
-        // ensure that we update the internal version tracked by the sink.
-        if (err == WEAVE_ERROR_TLV_TAG_NOT_FOUND)
-        {
-            WeaveLogDetail(DataManagement, "Ignoring un-mappable path!");
-            err = WEAVE_NO_ERROR;
-        }
-#endif
-        SuccessOrExit(err);
+    pathReader = aReader;
+    flags      = 0;
 
-        traitPath.mTraitDataHandle    = handle;
-        traitPath.mPropertyPathHandle = pathHandle;
+#if WDM_ENABLE_PROTOCOL_CHECKS
+    // If we previously had a partial change, the current handle should match the previous one.
+    // If they don't, we have a partial change violation.
+    if (mOutIsPartialChange && (mOutTraitDataHandle != handle))
+    {
+        WeaveLogError(DataManagement, "Encountered partial change flag violation (%u, %x, %x)", mOutIsPartialChange,
+                      mOutTraitDataHandle, handle);
+        ExitNow(err = WEAVE_ERROR_INVALID_DATA_LIST);
+    }
+#endif
 
-        err = acDelegate.DataElementAccessCheck(traitPath, *aCatalog);
+    if (!mOutIsPartialChange)
+    {
+        flags = TraitDataSink::kFirstElementInChange;
+    }
 
-        if (err == WEAVE_ERROR_ACCESS_DENIED)
-        {
-            WeaveLogDetail(DataManagement, "Ignoring path. Subscriptionless notification not accepted by data sink.");
+    if (!isPartialChange)
+    {
+        flags |= TraitDataSink::kLastElementInChange;
+    }
 
-            continue;
-        }
-        SuccessOrExit(err);
+    err = dataSink->StoreDataElement(pathHandle, pathReader, flags, NULL, NULL, handle);
+    SuccessOrExit(err);
 
-        pathReader = aReader;
-        flags      = 0;
+    mOutIsPartialChange = isPartialChange;
 
 #if WDM_ENABLE_PROTOCOL_CHECKS
-        // If we previously had a partial change, the current handle should match the previous one.
-        // If they don't, we have a partial change violation.
-        if (aOutIsPartialChange && (aOutTraitDataHandle != handle))
-        {
-            WeaveLogError(DataManagement, "Encountered partial change flag violation (%u, %x, %x)", aOutIsPartialChange,
-                          aOutTraitDataHandle, handle);
-            err = WEAVE_ERROR_INVALID_DATA_LIST;
-            goto exit;
-        }
+    mOutTraitDataHandle = handle;
 #endif
 
-        if (!aOutIsPartialChange)
-        {
-            flags = TraitDataSink::kFirstElementInChange;
-        }
+exit:
+    return err;
+}
+
+void DataListSinkVisitor::OnRejected(WEAVE_ERROR aError, uint32_t aNumDelivered)
+{
+    nl::Weave::TLV::TLVReader reader(mListReader);
+
+    WeaveLogError(DataManagement, "Data list rejected after %" PRIu32 " elements: %d", aNumDelivered, aError);
 
-        if (!isPartialChange)
+    // Rejects are rare, so walk the delivered elements again instead of keeping track of the sinks they touched.
+    for (uint32_t i = 0; i < aNumDelivered && reader.Next() == WEAVE_NO_ERROR; i++)
+    {
+        DataElement::Parser element;
+        nl::Weave::TLV::TLVReader pathReader;
+        TraitDataSink * dataSink;
+        TraitDataHandle handle;
+        SchemaVersionRange versionRange;
+
+        if (element.Init(reader) == WEAVE_NO_ERROR && element.GetReaderOnPath(&pathReader) == WEAVE_NO_ERROR &&
+            mCatalog->AddressToHandle(pathReader, handle, versionRange) == WEAVE_NO_ERROR &&
+            mCatalog->Locate(handle, &dataSink) == WEAVE_NO_ERROR)
         {
-            flags |= TraitDataSink::kLastElementInChange;
+            dataSink->ClearVersion();
         }
+    }
 
-        err = dataSink->StoreDataElement(pathHandle, pathReader, flags, NULL, NULL, handle);
-        SuccessOrExit(err);
+    // whatever change was in progress has been abandoned
+    mOutIsPartialChange = false;
+}
 
-        aOutIsPartialChange = isPartialChange;
+WEAVE_ERROR SubscriptionEngine::ProcessDataList(nl::Weave::TLV::TLVReader & aReader,
+                                                const TraitCatalogBase<TraitDataSink> * aCatalog, bool & aOutIsPartialChange,
+                                                TraitDataHandle & aOutTraitDataHandle,
+                                                IDataElementAccessControlDelegate & acDelegate)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
 
-#if WDM_ENABLE_PROTOCOL_CHECKS
-        aOutTraitDataHandle = handle;
-#endif
-    }
+    VerifyOrExit(aCatalog != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
 
-    // if we have exhausted this container
-    if (WEAVE_END_OF_TLV == err)
     {
-        err = WEAVE_NO_ERROR;
+        DataListSinkVisitor visitor(aReader, aCatalog, aOutIsPartialChange, aOutTraitDataHandle, acDelegate);
+
+        // Each element is validated and stored in the same pass
+        err = DataList::Parser::Visit(aReader, visitor);
+        SuccessOrExit(err);
     }
 
 exit:
@@ -660,8 +710,8 @@ void SubscriptionEngine::OnSubscriptionlessNotification(nl::Weave::ExchangeConte
     SuccessOrExit(err);
 
 #if WEAVE_CONFIG_DATA_MANAGEMENT_ENABLE_SCHEMA_CHECK
-    // simple schema checking
-    err = notify.CheckSchemaValidity();
+    // simple schema checking; the data elements are checked as ProcessDataList goes through them
+    err = notify.CheckEnvelopeValidity();
     SuccessOrExit(err);
 #endif // WEAVE_CONFIG_DATA_MANAGEMENT_ENABLE_SCHEMA_CHECK
 
@@ -1561,30 +1611,54 @@ exit:
 }
 
 /**
- * Initialize StatusDataHandleList
+ * Initialize StatusDataHandleList. This is also where the data list is validated, so that
+ * a malformed data element rejects the whole request before any data element is applied.
  */
 WEAVE_ERROR SubscriptionEngine::InitializeStatusDataHandleList(Weave::TLV::TLVReader & aReader,
                                                                StatusDataHandleElement * apStatusDataHandleList,
                                                                uint32_t & aNumDataElements, uint8_t * apBufEndAddr)
 {
+    class StatusDataHandleListVisitor : public DataList::Parser::Visitor
+    {
+    public:
+        StatusDataHandleListVisitor(StatusDataHandleElement * apList, uint8_t * apEndAddr) :
+            mNumDataElements(0), mpList(apList), mpEndAddr(apEndAddr)
+        { }
+
+        WEAVE_ERROR OnDataElement(const DataElement::Parser & aElement, const Weave::TLV::TLVReader & aReader, uint32_t aIndex)
+        {
+            WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+            // Check if mpList[aIndex] overflow the end of the buffer.
+            VerifyOrExit((uint8_t *) (mpList + aIndex + 1) <= mpEndAddr, err = WEAVE_ERROR_NO_MEMORY);
+            mpList[aIndex].mProfileId       = Weave::Profiles::kWeaveProfile_Common;
+            mpList[aIndex].mStatusCode      = Weave::Profiles::Common::kStatus_InternalError;
+            mpList[aIndex].mTraitDataHandle = 0;
+
+            mNumDataElements = aIndex + 1;
+
+        exit:
+            return err;
+        }
+
+        uint32_t mNumDataElements;
+
+    private:
+        StatusDataHandleElement * mpList;
+        uint8_t * mpEndAddr;
+    };
+
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     Weave::TLV::TLVReader dataReader;
+    StatusDataHandleListVisitor visitor(apStatusDataHandleList, apBufEndAddr);
+
     dataReader.Init(aReader);
 
-    for (aNumDataElements = 0; WEAVE_NO_ERROR == (err = dataReader.Next()); aNumDataElements++)
-    {
-        // Check if apStatusDataHandleList[aNumDataElements] overflow the end of the buffer.
-        VerifyOrExit((uint8_t *) (apStatusDataHandleList + aNumDataElements + 1) <= apBufEndAddr, err = WEAVE_ERROR_NO_MEMORY);
-        apStatusDataHandleList[aNumDataElements].mProfileId       = Weave::Profiles::kWeaveProfile_Common;
-        apStatusDataHandleList[aNumDataElements].mStatusCode      = Weave::Profiles::Common::kStatus_InternalError;
-        apStatusDataHandleList[aNumDataElements].mTraitDataHandle = 0;
-    }
+    // nothing has been applied yet, so there is nothing to undo on a reject
+    err = DataList::Parser::Visit(dataReader, visitor);
+    SuccessOrExit(err);
 
-    // if we have exhausted this container
-    if (WEAVE_END_OF_TLV == err)
-    {
-        err = WEAVE_NO_ERROR;
-    }
+    aNumDataElements = visitor.mNumDataElements;
 
 exit:
     return err;
@@ -75,6 +75,14 @@ void SubscriptionHandler::InitAsFree()
 
     memset(mSelfVendedEvents, 0, sizeof(mSelfVendedEvents));
     memset(mLastScheduledEventId, 0, sizeof(mLastScheduledEventId));
+
+#if WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE > 1
+    mNextNotifySequence  = 0;
+    mNotifyWindowSize    = 1;
+    mNotifyWindowHead    = 0;
+    mNumNotifiesInWindow = 0;
+    memset(mNotifyWindow, 0, sizeof(mNotifyWindow));
+#endif // WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE > 1
 }
 
 WEAVE_ERROR SubscriptionHandler::AcceptSubscribeRequest(const uint32_t aLivenessTimeoutSec)
@@ -425,6 +433,11 @@ WEAVE_ERROR SubscriptionHandler::ParsePathVersionEventLists(SubscribeRequest::Pa
                     WeaveLogDetail(DataManagement, "Handler[%u] Syncing is NOT necessary for trait[%u].path[%u]",
                                    SubscriptionEngine::GetInstance()->GetHandlerId(this), traitDataHandle, propertyPathHandle);
                 }
+
+#if WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE > 0
+                traitInstance->mAckedVersion        = existingVersion;
+                traitInstance->mIsAckedVersionValid = true;
+#endif
             }
 
 #if WEAVE_CONFIG_WDM_NEXT_SUBSCRIPTION_HANDLER_DEBUG
@@ -772,6 +785,14 @@ WEAVE_ERROR SubscriptionHandler::SendNotificationRequest(PacketBuffer * aMsgBuf)
     WeaveLogDetail(DataManagement, "Handler[%u] [%5.5s] %s Ref(%d)", SubscriptionEngine::GetInstance()->GetHandlerId(this),
                    GetStateStr(), __func__, mRefCount);
 
+#if WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE > 1
+    // Once the subscription is established, notifies may be pipelined, each on an exchange of its own.
+    if (IsNotifyWindowed())
+    {
+        return SendWindowedNotificationRequest(aMsgBuf);
+    }
+#endif // WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE > 1
+
     WeaveLogIfFalse((kState_Subscribing == mCurrentState) || (kState_SubscriptionEstablished_Idle == mCurrentState));
 
     // Make sure we're not freed by accident.
@@ -811,6 +832,226 @@ exit:
     return err;
 }
 
+#if WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE > 1
+WEAVE_ERROR SubscriptionHandler::SetNotifyWindowSize(const uint8_t aWindowSize)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    VerifyOrExit((aWindowSize > 0) && (aWindowSize <= WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE), err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    // Shrinking the window below the number of notifies in flight is fine: no new notify goes out until enough of
+    // them have been retired.
+    mNotifyWindowSize = aWindowSize;
+
+exit:
+    WeaveLogFunctError(err);
+
+    return err;
+}
+
+SubscriptionHandler::NotifyInFlight * SubscriptionHandler::FindNotifyInFlight(const nl::Weave::ExchangeContext * aEC)
+{
+    NotifyInFlight * notify = NULL;
+
+    for (uint8_t i = 0; (i < mNumNotifiesInWindow) && (NULL != aEC); ++i)
+    {
+        NotifyInFlight * const candidate = &mNotifyWindow[(mNotifyWindowHead + i) % WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE];
+
+        if (candidate->mEC == aEC)
+        {
+            notify = candidate;
+            break;
+        }
+    }
+
+    return notify;
+}
+
+SubscriptionHandler::NotifyInFlight * SubscriptionHandler::PushNotifyInFlight(nl::Weave::ExchangeContext * aEC)
+{
+    NotifyInFlight * const notify = &mNotifyWindow[(mNotifyWindowHead + mNumNotifiesInWindow) % WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE];
+
+    notify->mEC          = aEC;
+    notify->mSequence    = mNextNotifySequence++;
+    notify->mIsConfirmed = false;
+    memcpy(notify->mVendedEvents, mSelfVendedEvents, sizeof(notify->mVendedEvents));
+
+    ++mNumNotifiesInWindow;
+
+    return notify;
+}
+
+void SubscriptionHandler::ReleaseTraitInstances(const NotifyInFlight * aNotify)
+{
+    for (uint16_t i = 0; i < mNumTraitInstances; i++)
+    {
+        TraitInstanceInfo * const traitInstance = mTraitInstanceList + i;
+
+        if ((NULL == aNotify) || (traitInstance->mNotifySequence == aNotify->mSequence))
+        {
+            traitInstance->mIsInNotifyWindow = false;
+        }
+    }
+}
+
+WEAVE_ERROR SubscriptionHandler::SendWindowedNotificationRequest(PacketBuffer * aMsgBuf)
+{
+    WEAVE_ERROR err         = WEAVE_NO_ERROR;
+    ExchangeContext * ec    = NULL;
+    NotifyInFlight * notify = NULL;
+    InEventParam inParam;
+    OutEventParam outParam;
+
+    // Make sure we're not freed by accident.
+    _AddRef();
+
+    VerifyOrExit(mNumNotifiesInWindow < mNotifyWindowSize, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    err = mBinding->NewExchangeContext(ec);
+    SuccessOrExit(err);
+
+    InitExchangeContext(ec);
+
+    inParam.mExchangeStart.mEC      = ec;
+    inParam.mExchangeStart.mHandler = this;
+    mEventCallback(mAppState, kEvent_OnExchangeStart, inParam, outParam);
+
+    err     = ec->SendMessage(nl::Weave::Profiles::kWeaveProfile_WDM, kMsgType_NotificationRequest, aMsgBuf,
+                              nl::Weave::ExchangeContext::kSendFlag_ExpectResponse);
+    aMsgBuf = NULL;
+    SuccessOrExit(err);
+
+    // The notify is only accounted for in the window once it is on its way; a failed send is accounted for by the
+    // NotificationEngine itself.
+    notify = PushNotifyInFlight(ec);
+    ec     = NULL;
+
+    WeaveLogDetail(DataManagement, "Handler[%u] [%5.5s] %s Seq(%" PRIu32 ") InWindow(%u/%u)",
+                   SubscriptionEngine::GetInstance()->GetHandlerId(this), GetStateStr(), __func__, notify->mSequence,
+                   mNumNotifiesInWindow, mNotifyWindowSize);
+
+    mCurrentState = kState_SubscriptionEstablished_Notifying;
+
+exit:
+    WeaveLogFunctError(err);
+
+    if (NULL != aMsgBuf)
+    {
+        PacketBuffer::Free(aMsgBuf);
+        aMsgBuf = NULL;
+    }
+
+    if (NULL != ec)
+    {
+        FlushExchangeContext(ec, true);
+    }
+
+    if (WEAVE_NO_ERROR != err)
+    {
+        TerminateSubscription(err, NULL, false);
+    }
+
+    _Release();
+
+    return err;
+}
+
+WEAVE_ERROR SubscriptionHandler::ConfirmWindowedNotify(NotifyInFlight * aNotify)
+{
+    WEAVE_ERROR err                   = WEAVE_NO_ERROR;
+    NotificationEngine * const engine = SubscriptionEngine::GetInstance()->GetNotificationEngine();
+
+    // This exchange is over
+    FlushExchangeContext(aNotify->mEC, false);
+    aNotify->mIsConfirmed = true;
+
+    // The subscriber has the data this notify carried, so its trait instances may go out in new notifies again
+    ReleaseTraitInstances(aNotify);
+
+    // Confirms may arrive out of order, but notifies are retired strictly in the order they were sent, so that the
+    // event cursors reported as delivered never skip over a notify that is still in flight.
+    while ((mNumNotifiesInWindow > 0) && mNotifyWindow[mNotifyWindowHead].mIsConfirmed)
+    {
+        NotifyInFlight & oldest = mNotifyWindow[mNotifyWindowHead];
+
+        WeaveLogDetail(DataManagement, "Handler[%u] [%5.5s] %s Retire Seq(%" PRIu32 ")",
+                       SubscriptionEngine::GetInstance()->GetHandlerId(this), GetStateStr(), __func__, oldest.mSequence);
+
+        engine->RetireNotify(this, true, oldest.mVendedEvents);
+
+        oldest.mIsConfirmed = false;
+        mNotifyWindowHead   = (mNotifyWindowHead + 1) % WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE;
+        --mNumNotifiesInWindow;
+    }
+
+    if (0 == mNumNotifiesInWindow)
+    {
+#if WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE > 0
+        // With nothing left in flight, everything sent so far has been delivered
+        CommitSentTraitVersions();
+#endif
+        MoveToState(kState_SubscriptionEstablished_Idle);
+    }
+
+    // Any confirm is proof of liveness, whether or not it retired anything
+    err = RefreshTimer();
+    SuccessOrExit(err);
+
+#if WDM_ENABLE_SUBSCRIPTION_CLIENT
+    (void) SubscriptionEngine::GetInstance()->UpdateClientLiveness(mPeerNodeId, mSubscriptionId);
+#endif // WDM_ENABLE_SUBSCRIPTION_CLIENT
+
+exit:
+    WeaveLogFunctError(err);
+
+    return err;
+}
+
+uint8_t SubscriptionHandler::FlushNotifyWindow(void)
+{
+    NotificationEngine * const engine = SubscriptionEngine::GetInstance()->GetNotificationEngine();
+    const uint8_t numFlushed          = mNumNotifiesInWindow;
+
+    while (mNumNotifiesInWindow > 0)
+    {
+        NotifyInFlight & oldest = mNotifyWindow[mNotifyWindowHead];
+
+        if (NULL != oldest.mEC)
+        {
+            FlushExchangeContext(oldest.mEC, true);
+        }
+
+        // Nothing in the window is reported as delivered: the notifies before this one may never have made it
+        engine->RetireNotify(this, false, oldest.mVendedEvents);
+
+        oldest.mIsConfirmed = false;
+        mNotifyWindowHead   = (mNotifyWindowHead + 1) % WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE;
+        --mNumNotifiesInWindow;
+    }
+
+    ReleaseTraitInstances(NULL);
+
+    return numFlushed;
+}
+#endif // WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE > 1
+
+#if WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE > 0
+void SubscriptionHandler::CommitSentTraitVersions(void)
+{
+    for (uint16_t i = 0; i < mNumTraitInstances; i++)
+    {
+        TraitInstanceInfo * const traitInstance = mTraitInstanceList + i;
+
+        if (traitInstance->mIsSentVersionPending)
+        {
+            traitInstance->mAckedVersion         = traitInstance->mSentVersion;
+            traitInstance->mIsAckedVersionValid  = true;
+            traitInstance->mIsSentVersionPending = false;
+        }
+    }
+}
+#endif // WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE > 0
+
 void SubscriptionHandler::OnNotifyProcessingComplete(const bool aPossibleLossOfEvent, const LastVendedEvent aLastVendedEventList[],
                                                      const size_t aLastVendedEventListSize)
 {
@@ -922,13 +1163,18 @@ uint64_t SubscriptionHandler::GetPeerNodeId(void) const
 
 void SubscriptionHandler::InitExchangeContext()
 {
-    mEC->AppState          = this;
-    mEC->OnResponseTimeout = OnResponseTimeout;
+    InitExchangeContext(mEC);
+}
+
+void SubscriptionHandler::InitExchangeContext(nl::Weave::ExchangeContext * aEC)
+{
+    aEC->AppState          = this;
+    aEC->OnResponseTimeout = OnResponseTimeout;
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
-    mEC->OnSendError       = OnSendError;
-    mEC->OnAckRcvd         = OnAckReceived;
+    aEC->OnSendError       = OnSendError;
+    aEC->OnAckRcvd         = OnAckReceived;
 #endif
-    mEC->OnMessageReceived = OnMessageReceivedFromLocallyHeldExchange;
+    aEC->OnMessageReceived = OnMessageReceivedFromLocallyHeldExchange;
 }
 
 WEAVE_ERROR SubscriptionHandler::ReplaceExchangeContext()
@@ -964,24 +1210,29 @@ exit:
 
 void SubscriptionHandler::FlushExistingExchangeContext(const bool aAbortNow)
 {
-    if (NULL != mEC)
+    FlushExchangeContext(mEC, aAbortNow);
+}
+
+void SubscriptionHandler::FlushExchangeContext(nl::Weave::ExchangeContext *& aEC, const bool aAbortNow)
+{
+    if (NULL != aEC)
     {
-        mEC->AppState          = NULL;
-        mEC->OnMessageReceived = NULL;
-        mEC->OnResponseTimeout = NULL;
+        aEC->AppState          = NULL;
+        aEC->OnMessageReceived = NULL;
+        aEC->OnResponseTimeout = NULL;
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
-        mEC->OnSendError       = NULL;
-        mEC->OnAckRcvd         = NULL;
+        aEC->OnSendError       = NULL;
+        aEC->OnAckRcvd         = NULL;
 #endif
         if (aAbortNow)
         {
-            mEC->Abort();
+            aEC->Abort();
         }
         else
         {
-            mEC->Close();
+            aEC->Close();
         }
-        mEC = NULL;
+        aEC = NULL;
     }
 }
 
@@ -1003,6 +1254,9 @@ WEAVE_ERROR SubscriptionHandler::Cancel()
     case kState_SubscriptionEstablished_Notifying:
         // abort whatever we're doing (notification request)
         FlushExistingExchangeContext(true);
+#if WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE > 1
+        (void) FlushNotifyWindow();
+#endif
         cancel = true;
 
         break;
@@ -1138,6 +1392,15 @@ void SubscriptionHandler::TerminateSubscription(WEAVE_ERROR aReason, StatusRepor
         // Abort any in-progress exchange.
         FlushExistingExchangeContext(true);
 
+#if WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE > 1
+        // Pipelined notifies are retired here, one by one, instead of through the single OnNotifyConfirm below.
+        if (FlushNotifyWindow() > 0)
+        {
+            isNotifying = false;
+            SubscriptionEngine::GetInstance()->GetNotificationEngine()->ScheduleRun();
+        }
+#endif // WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE > 1
+
         // Clear any outstanding timer.
         (void)RefreshTimer();
 
@@ -1591,6 +1854,9 @@ void SubscriptionHandler::OnMessageReceivedFromLocallyHeldExchange(nl::Weave::Ex
     bool isStatusReportValid                   = false;
     bool isNotificationRejectedForInvalidValue = false;
     StatusReporting::StatusReport status;
+#if WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE > 1
+    NotifyInFlight * const windowedNotify = pHandler->FindNotifyInFlight(aEC);
+#endif
 
     WeaveLogDetail(DataManagement, "Handler[%u] [%5.5s] %s Ref(%d)", SubscriptionEngine::GetInstance()->GetHandlerId(pHandler),
                    pHandler->GetStateStr(), __func__, pHandler->mRefCount);
@@ -1598,7 +1864,11 @@ void SubscriptionHandler::OnMessageReceivedFromLocallyHeldExchange(nl::Weave::Ex
     // Make sure we're not freed by accident.
     pHandler->_AddRef();
 
+#if WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE > 1
+    VerifyOrExit((aEC == pHandler->mEC) || (NULL != windowedNotify), err = WEAVE_ERROR_INCORRECT_STATE);
+#else
     VerifyOrExit(aEC == pHandler->mEC, err = WEAVE_ERROR_INCORRECT_STATE);
+#endif
 
     if ((nl::Weave::Profiles::kWeaveProfile_Common == aProfileId) &&
         (nl::Weave::Profiles::Common::kMsgType_StatusReport == aMsgType))
@@ -1616,6 +1886,35 @@ void SubscriptionHandler::OnMessageReceivedFromLocallyHeldExchange(nl::Weave::Ex
         }
     }
 
+#if WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE > 1
+    if (NULL != windowedNotify)
+    {
+        // response for a pipelined notification request. The exchange belongs to the notify, not to the handler
+        VerifyOrExit(isStatusReportValid, err = WEAVE_ERROR_INVALID_MESSAGE_TYPE);
+
+        if (isNotificationRejectedForInvalidValue)
+        {
+            // we don't really support this, assume it's accepted and continue.
+            WeaveLogDetail(DataManagement, "Notification rejected, ignore rejection");
+        }
+        else if (!status.success())
+        {
+            ExitNow(err = WEAVE_ERROR_STATUS_REPORT_RECEIVED);
+        }
+
+        retainExchangeContext = true;
+        aEC                   = NULL;
+
+        err = pHandler->ConfirmWindowedNotify(windowedNotify);
+        SuccessOrExit(err);
+
+        // kick notification engine again, there is room in the window now
+        // Note that the call to NotificationEngine::Run could actually cause this particular handler to be aborted
+        SubscriptionEngine::GetInstance()->GetNotificationEngine()->Run();
+        ExitNow();
+    }
+#endif // WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE > 1
+
     switch (pHandler->mCurrentState)
     {
     case kState_Subscribing_Notifying:
@@ -1641,6 +1940,10 @@ void SubscriptionHandler::OnMessageReceivedFromLocallyHeldExchange(nl::Weave::Ex
         // only retain the EC if we're good to continue processing
         retainExchangeContext = true;
 
+#if WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE > 0
+        pHandler->CommitSentTraitVersions();
+#endif
+
         // Only prompt the NotificationEngine if we received a status report indicating success. Otherwise, the subscription will
         // get torn down and as part of that clean-up, a similar invocation of OnNotifyConfirm will happen.
         SubscriptionEngine::GetInstance()->GetNotificationEngine()->OnNotifyConfirm(pHandler, status.success());
@@ -1675,6 +1978,10 @@ void SubscriptionHandler::OnMessageReceivedFromLocallyHeldExchange(nl::Weave::Ex
         // don't call flush for us in the end
         retainExchangeContext = true;
 
+#if WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE > 0
+        pHandler->CommitSentTraitVersions();
+#endif
+
         // Only prompt the NotificationEngine if we received a status report indicating success. Otherwise, the subscription will
         // get torn down and as part of that clean-up, a similar invocation of OnNotifyConfirm will happen.
         SubscriptionEngine::GetInstance()->GetNotificationEngine()->OnNotifyConfirm(pHandler, status.success());
@@ -55,7 +55,17 @@ public:
 
     struct TraitInstanceInfo
     {
-        void Init(void) { this->ClearDirty(); }
+        void Init(void)
+        {
+            this->ClearDirty();
+#if WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE > 1
+            mIsInNotifyWindow = false;
+#endif
+#if WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE > 0
+            mIsSentVersionPending = false;
+            mIsAckedVersionValid  = false;
+#endif
+        }
         bool IsDirty(void) { return mDirty; }
         void SetDirty(void) { mDirty = true; }
         void ClearDirty(void) { mDirty = false; }
@@ -63,6 +73,20 @@ public:
         TraitDataHandle mTraitDataHandle;
         uint16_t mRequestedVersion;
         bool mDirty;
+#if WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE > 0
+        // Last data version sent to the subscriber, and the last one it is known to hold. Notifies are encoded as deltas
+        // from the latter whenever the data source's change journal still covers it.
+        DataVersion mSentVersion;
+        DataVersion mAckedVersion;
+        bool mIsSentVersionPending;
+        bool mIsAckedVersionValid;
+#endif
+#if WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE > 1
+        // Sequence number of the windowed notify carrying this trait instance. Until that notify is confirmed, the instance
+        // is left out of new notifies, so that a retransmission of its older data can't reach the subscriber after newer data.
+        uint32_t mNotifySequence;
+        bool mIsInNotifyWindow;
+#endif
     };
 
     enum EventID
@@ -187,6 +211,26 @@ public:
 
     void SetMaxNotificationSize(const uint32_t aMaxPayload);
 
+#if WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE > 1
+    /**
+     * @brief Set the number of NotifyRequests that may be outstanding on this subscription once it is established.
+     *
+     * With a window of 1 (the default), the publisher waits for the StatusReport of each notify before sending the next one.
+     * With a larger window, each notify goes out on its own exchange and the NotificationEngine keeps building notifies for this
+     * subscription until the window is full. Responses may arrive in any order; notifies are retired, and the event cursors they
+     * carried are reported as delivered, strictly in the order they were sent. A trait instance is carried by at most one
+     * unconfirmed notify at a time, so a retransmitted notify can never overwrite newer data at the subscriber.
+     *
+     * @param[in] aWindowSize   Number of notifies allowed in flight, between 1 and #WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE.
+     *
+     * @retval #WEAVE_NO_ERROR                  On success.
+     * @retval #WEAVE_ERROR_INVALID_ARGUMENT    If the window size is out of range.
+     */
+    WEAVE_ERROR SetNotifyWindowSize(const uint8_t aWindowSize);
+
+    uint8_t GetNotifyWindowSize(void) const { return mNotifyWindowSize; }
+#endif // WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE > 1
+
 private:
     friend class SubscriptionEngine;
     friend class NotificationEngine;
@@ -221,7 +265,12 @@ private:
 
     bool IsNotifiable(void)
     {
-        return (mCurrentState == kState_Subscribing || mCurrentState == kState_SubscriptionEstablished_Idle);
+        return (mCurrentState == kState_Subscribing || mCurrentState == kState_SubscriptionEstablished_Idle
+#if WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE > 1
+                || (mCurrentState == kState_SubscriptionEstablished_Notifying && mNumNotifiesInWindow > 0 &&
+                    mNumNotifiesInWindow < mNotifyWindowSize)
+#endif
+        );
     }
     bool IsSubscribing(void)
     {
@@ -270,6 +319,43 @@ private:
     // by triggering the NotificationEngine.
     size_t mBytesOffloaded;
 
+#if WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE > 1
+    // A notify sent on an established subscription that has not been retired yet.  Each one owns its exchange
+    // context, and keeps a snapshot of the event cursors it carried so that event delivery can be reported
+    // in order once all notifies before it have been confirmed.
+    struct NotifyInFlight
+    {
+        nl::Weave::ExchangeContext * mEC;
+        uint32_t mSequence;
+        bool mIsConfirmed;
+        event_id_t mVendedEvents[kImportanceType_Last - kImportanceType_First + 1];
+    };
+
+    // Ring buffer of in-flight notifies, oldest at mNotifyWindowHead
+    NotifyInFlight mNotifyWindow[WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE];
+    uint32_t mNextNotifySequence;
+    uint8_t mNotifyWindowSize;
+    uint8_t mNotifyWindowHead;
+    uint8_t mNumNotifiesInWindow;
+
+    bool IsNotifyWindowed(void)
+    {
+        return ((mCurrentState == kState_SubscriptionEstablished_Idle || mCurrentState == kState_SubscriptionEstablished_Notifying) &&
+                (mNotifyWindowSize > 1 || mNumNotifiesInWindow > 0));
+    }
+
+    NotifyInFlight * FindNotifyInFlight(const nl::Weave::ExchangeContext * aEC);
+    NotifyInFlight * PushNotifyInFlight(nl::Weave::ExchangeContext * aEC);
+    void ReleaseTraitInstances(const NotifyInFlight * aNotify);
+    WEAVE_ERROR SendWindowedNotificationRequest(PacketBuffer * aMsgBuf);
+    WEAVE_ERROR ConfirmWindowedNotify(NotifyInFlight * aNotify);
+    uint8_t FlushNotifyWindow(void);
+#endif // WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE > 1
+
+#if WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE > 0
+    void CommitSentTraitVersions(void);
+#endif
+
     // Do nothing
     SubscriptionHandler(void);
 
@@ -281,7 +367,9 @@ private:
 
     WEAVE_ERROR ReplaceExchangeContext(void);
     void InitExchangeContext(void);
+    void InitExchangeContext(nl::Weave::ExchangeContext * aEC);
     void FlushExistingExchangeContext(const bool aAbortNow = false);
+    static void FlushExchangeContext(nl::Weave::ExchangeContext *& aEC, const bool aAbortNow);
 
     void InitWithIncomingRequest(Binding * const aBinding, const uint64_t aRandomNumber, nl::Weave::ExchangeContext * aEC,
                                  const nl::Inet::IPPacketInfo * aPktInfo, const nl::Weave::WeaveMessageInfo * aMsgInfo,
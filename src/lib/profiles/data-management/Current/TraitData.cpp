@@ -1256,12 +1256,19 @@ WEAVE_ERROR TraitDataSink::SetData(PropertyPathHandle aHandle, TLVReader & aRead
 TraitDataSource::TraitDataSource(const TraitSchemaEngine * aEngine)
 {
     // Set the version to 0, indicating the lack of a valid version.
-    SetVersion(0);
+    mVersion = 0;
 
     mManagedVersion = true;
     mSetDirtyCalled = false;
     mSchemaEngine   = aEngine;
 
+#if WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE > 0
+    mChangeJournalFloor      = 0;
+    mChangeJournalHead       = 0;
+    mNumChangeJournalEntries = 0;
+    mIsChangeJournalStarted  = false;
+#endif
+
 #if (WEAVE_CONFIG_WDM_PUBLISHER_GRAPH_SOLVER == IntermediateGraphSolver)
     ClearRootDirty();
 #endif
@@ -1280,6 +1287,24 @@ uint64_t TraitDataSource::GetVersion(void)
     return mVersion;
 }
 
+void TraitDataSource::SetVersion(uint64_t version)
+{
+#if WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE > 0
+    const bool isNextVersion = (version == mVersion + 1);
+#endif
+
+    mVersion = version;
+
+#if WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE > 0
+    // The journal is keyed by version, so it cannot describe a jump: subscribers behind it need the whole trait instance.
+    if (mIsChangeJournalStarted && !isNextVersion)
+    {
+        // A subscriber already at the new version has seen everything, so changes made on top of it can still be served.
+        ResetChangeJournal(version);
+    }
+#endif
+}
+
 void TraitDataSource::IncrementVersion()
 {
     // By invoking GetVersion within here, we get the benefit of checking if the version is currently 0 and if so, randomize it.
@@ -1364,6 +1389,9 @@ void TraitDataSource::SetDirty(PropertyPathHandle aPropertyHandle)
     if (aPropertyHandle != kNullPropertyPathHandle)
     {
         mSetDirtyCalled = true;
+#if WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE > 0
+        RecordChange(aPropertyHandle);
+#endif
         SubscriptionEngine::GetInstance()->GetNotificationEngine()->SetDirty(this, aPropertyHandle);
     }
 }
@@ -1375,11 +1403,96 @@ void TraitDataSource::DeleteKey(PropertyPathHandle aPropertyHandle)
     if (mSchemaEngine->IsDictionary(mSchemaEngine->GetParent(aPropertyHandle)))
     {
         mSetDirtyCalled = true;
+#if WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE > 0
+        // The journal only records modifications; a subscriber behind this deletion needs the whole trait instance.
+        ResetChangeJournal(GetVersion() + 1);
+#endif
         SubscriptionEngine::GetInstance()->GetNotificationEngine()->DeleteKey(this, aPropertyHandle);
     }
 }
 #endif // TDM_ENABLE_PUBLISHER_DICTIONARY_SUPPORT
 
+#if WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE > 0
+void TraitDataSource::RecordChange(PropertyPathHandle aPropertyHandle)
+{
+    const DataVersion baseVersion = GetVersion();
+    ChangeJournalEntry * entry;
+
+    if (!mIsChangeJournalStarted)
+    {
+        mChangeJournalFloor     = baseVersion;
+        mIsChangeJournalStarted = true;
+    }
+
+    for (uint8_t i = 0; i < mNumChangeJournalEntries; i++)
+    {
+        entry = &mChangeJournal[(mChangeJournalHead + i) % WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE];
+
+        if (entry->mBaseVersion == baseVersion && entry->mPropertyPathHandle == aPropertyHandle)
+        {
+            // Already recorded as part of this change
+            return;
+        }
+    }
+
+    if (mNumChangeJournalEntries == WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE)
+    {
+        // Drop the oldest change. Subscribers at or below the version it was made on top of can no longer be served a delta.
+        entry = &mChangeJournal[mChangeJournalHead];
+
+        if (entry->mBaseVersion + 1 > mChangeJournalFloor)
+        {
+            mChangeJournalFloor = entry->mBaseVersion + 1;
+        }
+
+        mChangeJournalHead = (mChangeJournalHead + 1) % WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE;
+        mNumChangeJournalEntries--;
+    }
+
+    entry = &mChangeJournal[(mChangeJournalHead + mNumChangeJournalEntries) % WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE];
+    entry->mBaseVersion        = baseVersion;
+    entry->mPropertyPathHandle = aPropertyHandle;
+    mNumChangeJournalEntries++;
+}
+
+void TraitDataSource::ResetChangeJournal(DataVersion aFloor)
+{
+    mChangeJournalFloor      = aFloor;
+    mChangeJournalHead       = 0;
+    mNumChangeJournalEntries = 0;
+    mIsChangeJournalStarted  = true;
+}
+
+bool TraitDataSource::HasChangesSince(DataVersion aVersion) const
+{
+    uint32_t cursor = 0;
+
+    if (!mIsChangeJournalStarted || aVersion < mChangeJournalFloor || aVersion > mVersion)
+    {
+        return false;
+    }
+
+    return GetNextChangeSince(aVersion, cursor) != kNullPropertyPathHandle;
+}
+
+PropertyPathHandle TraitDataSource::GetNextChangeSince(DataVersion aVersion, uint32_t & aCursor) const
+{
+    while (aCursor < mNumChangeJournalEntries)
+    {
+        const ChangeJournalEntry & entry = mChangeJournal[(mChangeJournalHead + aCursor) % WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE];
+
+        aCursor++;
+
+        if (entry.mBaseVersion >= aVersion)
+        {
+            return entry.mPropertyPathHandle;
+        }
+    }
+
+    return kNullPropertyPathHandle;
+}
+#endif // WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE > 0
+
 WEAVE_ERROR TraitDataSource::Lock()
 {
     mSetDirtyCalled = false;
@@ -922,6 +922,15 @@ public:
      */
     virtual WEAVE_ERROR OnEvent(uint16_t aType, void * aInEventParam) { return WEAVE_NO_ERROR; }
 
+#if WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE > 0
+    /* Returns true if the change journal can describe every change made on top of aVersion, and there is at least one. */
+    bool HasChangesSince(DataVersion aVersion) const;
+
+    /* Iterates over the handles changed on top of aVersion or later. aCursor starts at 0; returns kNullPropertyPathHandle at the
+     * end. Handles may repeat. */
+    PropertyPathHandle GetNextChangeSince(DataVersion aVersion, uint32_t & aCursor) const;
+#endif
+
 #if (WEAVE_CONFIG_WDM_PUBLISHER_GRAPH_SOLVER == IntermediateGraphSolver)
     /* Set of functions to be called by the intermediate graph solver on the notification engine for marking/clearing this entire
      * data source as dirty */
@@ -954,8 +963,8 @@ protected: // IGetDataDelegate
     }
 #endif
 
-    // Set current version of the data in this source.
-    void SetVersion(uint64_t version) { mVersion = version; }
+    // Set current version of the data in this source. Any version other than the next one invalidates the change journal.
+    void SetVersion(uint64_t version);
 
     // Increment current version of the data in this source.
     void IncrementVersion(void);
@@ -965,6 +974,25 @@ protected: // IGetDataDelegate
     const TraitSchemaEngine * mSchemaEngine;
 
 private:
+#if WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE > 0
+    struct ChangeJournalEntry
+    {
+        DataVersion mBaseVersion; // the version this change was made on top of
+        PropertyPathHandle mPropertyPathHandle;
+    };
+
+    void RecordChange(PropertyPathHandle aPropertyHandle);
+    void ResetChangeJournal(DataVersion aFloor);
+
+    // Ring buffer of the most recent changes, oldest at mChangeJournalHead. The journal is complete for all versions at or
+    // above mChangeJournalFloor.
+    ChangeJournalEntry mChangeJournal[WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE];
+    DataVersion mChangeJournalFloor;
+    uint8_t mChangeJournalHead;
+    uint8_t mNumChangeJournalEntries;
+    bool mIsChangeJournalStarted;
+#endif // WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE > 0
+
     // Current version of the data in this source.
     uint64_t mVersion;
     // Tracks whether SetDirty was called within a Lock/Unlock 'session'
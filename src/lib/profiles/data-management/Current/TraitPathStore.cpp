@@ -45,7 +45,7 @@ using namespace ::nl::Weave::Profiles::DataManagement_Current;
  * Empty constructor
  */
 TraitPathStore::TraitPathStore()
-    : mStore(NULL), mStoreSize(0), mNumItems(0)
+    : mStore(NULL), mStoreSize(0), mNumItems(0), mFirstAvailableHint(0)
 {
 }
 
@@ -54,10 +54,14 @@ TraitPathStore::TraitPathStore()
  *
  * @param[in]   aRecordArray    Pointer to an array of Records that will be used
  *                              to store paths and flags.
- * @param[in]   aArrayLength    Length of the storage array in number of items.
+ * @param[in]   aArrayLength    Length of the storage array in number of items;
+ *                              at most kMaxStoreSize. Builds with larger stores
+ *                              must raise WDM_TRAIT_PATH_STORE_MAX_ITEMS.
  */
 void TraitPathStore::Init(TraitPathStore::Record *aRecordArray, size_t aArrayLength)
 {
+    VerifyOrDie(aArrayLength <= kMaxStoreSize);
+
     mStore = aRecordArray;
     mStoreSize = aArrayLength;
 
@@ -108,7 +112,9 @@ WEAVE_ERROR TraitPathStore::AddItem(const TraitPath &aItem, Flags aFlags)
     VerifyOrExit(i < mStoreSize, err = WEAVE_ERROR_WDM_PATH_STORE_FULL);
 
     SetItem(i, aItem, aFlags);
+    LinkItem(i);
     mNumItems++;
+    mFirstAvailableHint = i + 1;
 
 exit:
     return err;
@@ -130,6 +136,7 @@ WEAVE_ERROR TraitPathStore::AddItem(const TraitPath &aItem)
 WEAVE_ERROR TraitPathStore::AddItemDedup(const TraitPath &aItem, const TraitSchemaEngine * const aSchemaEngine)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
+    int32_t depth;
 
     if (Includes(aItem, aSchemaEngine))
     {
@@ -137,12 +144,15 @@ WEAVE_ERROR TraitPathStore::AddItemDedup(const TraitPath &aItem, const TraitSche
         ExitNow();
     }
 
+    depth = (aItem.mPropertyPathHandle != kNullPropertyPathHandle) ?
+        aSchemaEngine->GetDepth(aItem.mPropertyPathHandle) : -1;
+
     // Remove any paths of which aItem is an ancestor
     for (size_t i = GetFirstValidItem(aItem.mTraitDataHandle);
             i < GetPathStoreSize();
             i = GetNextValidItem(i, aItem.mTraitDataHandle))
     {
-        if (aSchemaEngine->IsParent(mStore[i].mTraitPath.mPropertyPathHandle, aItem.mPropertyPathHandle))
+        if (IsItemDescendant(i, aItem.mPropertyPathHandle, depth, aSchemaEngine))
         {
             WeaveLogDetail(DataManagement, "Removing item %u t%u p%u while adding p%u", i,
                     mStore[i].mTraitPath.mTraitDataHandle,
@@ -194,6 +204,10 @@ WEAVE_ERROR TraitPathStore::InsertItemAt(size_t aIndex, const TraitPath &aItem,
 
     SetItem(aIndex, aItem, aFlags);
     mNumItems++;
+    mFirstAvailableHint = mNumItems;
+
+    // The items have moved: chain them again.
+    RebuildIndex();
 
 exit:
     return err;
@@ -270,6 +284,14 @@ void TraitPathStore::RemoveItem(const TraitPath &aItem)
     }
 }
 
+/**
+ * Removes the item at a given index.
+ * It is safe to call this while iterating on the store with
+ * GetNextValidItem(); the iteration continues from the item
+ * following the one removed.
+ *
+ * @param[in]   aIndex  The index of an item in use.
+ */
 void TraitPathStore::RemoveItemAt(size_t aIndex)
 {
     VerifyOrDie(mNumItems > 0);
@@ -277,8 +299,14 @@ void TraitPathStore::RemoveItemAt(size_t aIndex)
 
     if (IsItemInUse(aIndex))
     {
+        UnlinkItem(aIndex);
         ClearItem(aIndex);
         mNumItems--;
+
+        if (aIndex < mFirstAvailableHint)
+        {
+            mFirstAvailableHint = aIndex;
+        }
     }
 }
 
@@ -310,6 +338,11 @@ void TraitPathStore::Compact()
         memmove(&mStore[i], &mStore[i+1], numBytesToMove);
         SetFlags(lastIndex, kFlag_InUse, false);
     }
+
+    mFirstAvailableHint = mNumItems;
+
+    // The items have moved: chain them again.
+    RebuildIndex();
 }
 
 /**
@@ -321,7 +354,9 @@ void TraitPathStore::Compact()
  */
 bool TraitPathStore::IsPresent(const TraitPath &aItem) const
 {
-    for (size_t i = GetFirstValidItem(); i < mStoreSize; i = GetNextValidItem(i))
+    for (size_t i = GetFirstValidItem(aItem.mTraitDataHandle);
+            i < mStoreSize;
+            i = GetNextValidItem(i, aItem.mTraitDataHandle))
     {
         if (mStore[i].mTraitPath == aItem)
         {
@@ -349,18 +384,27 @@ bool TraitPathStore::Intersects(const TraitPath &aTraitPath, const TraitSchemaEn
     bool intersects = false;
     TraitDataHandle dataHandle = aTraitPath.mTraitDataHandle;
     PropertyPathHandle pathHandle = aTraitPath.mPropertyPathHandle;
+    int32_t depth;
+
+    VerifyOrExit(IsTraitPresent(dataHandle), );
+
+    // The same path or one of its ancestors
+    intersects = Includes(aTraitPath, aSchemaEngine);
+    VerifyOrExit(false == intersects, );
+
+    // One of its descendants
+    depth = (pathHandle != kNullPropertyPathHandle) ? aSchemaEngine->GetDepth(pathHandle) : -1;
 
     for (size_t i = GetFirstValidItem(dataHandle); i < mStoreSize; i = GetNextValidItem(i, dataHandle))
     {
-        if (pathHandle == mStore[i].mTraitPath.mPropertyPathHandle ||
-                aSchemaEngine->IsParent(pathHandle, mStore[i].mTraitPath.mPropertyPathHandle) ||
-                aSchemaEngine->IsParent(mStore[i].mTraitPath.mPropertyPathHandle, pathHandle))
+        if (IsItemDescendant(i, pathHandle, depth, aSchemaEngine))
         {
             intersects = true;
             break;
         }
     }
 
+exit:
     return intersects;
 }
 
@@ -382,16 +426,18 @@ bool TraitPathStore::Includes(const TraitPath &aItem, const TraitSchemaEngine *
     TraitDataHandle dataHandle = aItem.mTraitDataHandle;
     PropertyPathHandle pathHandle = aItem.mPropertyPathHandle;
 
-    for (size_t i = GetFirstValidItem(dataHandle); i < mStoreSize; i = GetNextValidItem(i, dataHandle))
+    VerifyOrExit(IsTraitPresent(dataHandle), );
+
+    // Look up the path and each of its ancestors, instead of
+    // checking the ancestry of every path in the store.
+    while (pathHandle != kNullPropertyPathHandle && false == found)
     {
-        if (pathHandle == mStore[i].mTraitPath.mPropertyPathHandle ||
-                aSchemaEngine->IsParent(pathHandle, mStore[i].mTraitPath.mPropertyPathHandle))
-        {
-            found = true;
-            break;
-        }
+        found = IsPresent(TraitPath(dataHandle, pathHandle));
+
+        pathHandle = aSchemaEngine->GetParent(pathHandle);
     }
 
+exit:
     return found;
 }
 
@@ -401,10 +447,13 @@ bool TraitPathStore::Includes(const TraitPath &aItem, const TraitSchemaEngine *
 void TraitPathStore::Clear()
 {
     mNumItems = 0;
+    mFirstAvailableHint = 0;
 
     for (size_t i = 0; i < mStoreSize; i++)
     {
         ClearItem(i);
+        mStore[i].mNextInBucket = kNullIndex;
+        mStore[i].mBucketHead = kNullIndex;
     }
 }
 
@@ -456,18 +505,17 @@ size_t TraitPathStore::GetNextValidItem(size_t aIndex) const
  */
 size_t TraitPathStore::GetFirstValidItem(TraitDataHandle aTDH) const
 {
-    size_t i = GetFirstValidItem();
-
-    while (i < mStoreSize && mStore[i].mTraitPath.mTraitDataHandle != aTDH)
+    if (mNumItems == 0)
     {
-        i = GetNextValidItem(i);
+        return mStoreSize;
     }
 
-    return i;
+    return FindValidItemInBucket(mStore[GetBucket(aTDH)].mBucketHead, aTDH);
 }
 
 /**
- * @param[in]   aIndex   An index into the store.
+ * @param[in]   aIndex   An index into the store, returned by GetFirstValidItem(aTDH)
+ *                       or GetNextValidItem(i, aTDH).
  * @param[in] aTDH The TraitDataHandle of the trait instance to iterate on.
  *
  * @return The index of the first item of the store following i for which IsValidItem()
@@ -476,13 +524,7 @@ size_t TraitPathStore::GetFirstValidItem(TraitDataHandle aTDH) const
  */
 size_t TraitPathStore::GetNextValidItem(size_t aIndex, TraitDataHandle aTDH) const
 {
-    do
-    {
-        aIndex = GetNextValidItem(aIndex);
-    }
-    while (aIndex < mStoreSize && mStore[aIndex].mTraitPath.mTraitDataHandle != aTDH);
-
-    return aIndex;
+    return FindValidItemInBucket(mStore[aIndex].mNextInBucket, aTDH);
 }
 
 bool TraitPathStore::AreFlagsSet(size_t aIndex, Flags aFlags) const
@@ -499,7 +541,8 @@ bool TraitPathStore::AreFlagsSet(size_t aIndex, Flags aFlags) const
 
 size_t TraitPathStore::FindFirstAvailableItem() const
 {
-    size_t i = 0;
+    // All items before mFirstAvailableHint are in use.
+    size_t i = mFirstAvailableHint;
 
     while (i < mStoreSize && IsItemInUse(i))
     {
@@ -513,6 +556,7 @@ void TraitPathStore::SetItem(size_t aIndex, const TraitPath &aItem, Flags aFlags
 {
     mStore[aIndex].mTraitPath = aItem;
     mStore[aIndex].mFlags = aFlags;
+    mStore[aIndex].mDepth = kUnknownDepth;
     SetFlags(aIndex, kFlag_InUse, true);
 }
 
@@ -531,3 +575,124 @@ void TraitPathStore::SetFlags(size_t aIndex, Flags aFlags, bool aValue)
         mStore[aIndex].mFlags |= aFlags;
     }
 }
+
+/**
+ * Follows the chain of a bucket starting from a given item, and returns the first
+ * item that is valid and refers to the TraitDataHandle passed in; mStoreSize if none.
+ */
+size_t TraitPathStore::FindValidItemInBucket(size_t aIndex, TraitDataHandle aDataHandle) const
+{
+    while (aIndex != kNullIndex &&
+            (false == IsItemValid(aIndex) || mStore[aIndex].mTraitPath.mTraitDataHandle != aDataHandle))
+    {
+        aIndex = mStore[aIndex].mNextInBucket;
+    }
+
+    return (aIndex == kNullIndex) ? mStoreSize : aIndex;
+}
+
+/**
+ * Adds an item to the chain of its bucket, keeping the chain sorted by index
+ * so that the per-trait iterators visit the items in the same order as the
+ * others.
+ */
+void TraitPathStore::LinkItem(size_t aIndex)
+{
+    RecordIndex *next = &mStore[GetBucket(mStore[aIndex].mTraitPath.mTraitDataHandle)].mBucketHead;
+
+    while (*next != kNullIndex && *next < aIndex)
+    {
+        next = &mStore[*next].mNextInBucket;
+    }
+
+    mStore[aIndex].mNextInBucket = *next;
+    *next = static_cast<RecordIndex>(aIndex);
+}
+
+/**
+ * Removes an item from the chain of its bucket.
+ * The item keeps pointing to the rest of the chain, so that an iteration
+ * that has just removed it can carry on.
+ */
+void TraitPathStore::UnlinkItem(size_t aIndex)
+{
+    RecordIndex *next = &mStore[GetBucket(mStore[aIndex].mTraitPath.mTraitDataHandle)].mBucketHead;
+
+    while (*next != kNullIndex && *next != aIndex)
+    {
+        next = &mStore[*next].mNextInBucket;
+    }
+
+    if (*next == aIndex)
+    {
+        *next = mStore[aIndex].mNextInBucket;
+    }
+}
+
+void TraitPathStore::RebuildIndex()
+{
+    for (size_t i = 0; i < mStoreSize; i++)
+    {
+        mStore[i].mBucketHead = kNullIndex;
+        mStore[i].mNextInBucket = kNullIndex;
+    }
+
+    // Link the items from the last one, so that each
+    // one is added at the head of its chain.
+    for (size_t i = mStoreSize; i > 0; i--)
+    {
+        if (IsItemInUse(i - 1))
+        {
+            LinkItem(i - 1);
+        }
+    }
+}
+
+/**
+ * @return The depth of an item in the schema of its trait, computing it
+ *          the first time it is needed; kUnknownDepth if it is out of range.
+ */
+uint8_t TraitPathStore::GetItemDepth(size_t aIndex, const TraitSchemaEngine * const aSchemaEngine) const
+{
+    if (mStore[aIndex].mDepth == kUnknownDepth &&
+            mStore[aIndex].mTraitPath.mPropertyPathHandle != kNullPropertyPathHandle)
+    {
+        int32_t depth = aSchemaEngine->GetDepth(mStore[aIndex].mTraitPath.mPropertyPathHandle);
+
+        if (depth >= 0 && depth < kUnknownDepth)
+        {
+            mStore[aIndex].mDepth = static_cast<uint8_t>(depth);
+        }
+    }
+
+    return mStore[aIndex].mDepth;
+}
+
+/**
+ * @return true if the item at aIndex is a descendant of aAncestor, which is
+ *          aAncestorDepth levels deep in the same schema.
+ */
+bool TraitPathStore::IsItemDescendant(size_t aIndex, PropertyPathHandle aAncestor, int32_t aAncestorDepth,
+                                      const TraitSchemaEngine * const aSchemaEngine) const
+{
+    PropertyPathHandle pathHandle = mStore[aIndex].mTraitPath.mPropertyPathHandle;
+    uint8_t depth = GetItemDepth(aIndex, aSchemaEngine);
+
+    if (depth == kUnknownDepth || aAncestorDepth < 0)
+    {
+        return aSchemaEngine->IsParent(pathHandle, aAncestor);
+    }
+
+    if (depth <= aAncestorDepth)
+    {
+        return false;
+    }
+
+    // Walk up only as far as the depth of the ancestor.
+    for (int32_t i = depth; i > aAncestorDepth; i--)
+    {
+        pathHandle = aSchemaEngine->GetParent(pathHandle);
+    }
+
+    return (pathHandle == aAncestor);
+}
@@ -36,6 +36,21 @@ namespace Weave {
 namespace Profiles {
 namespace WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current) {
 
+/**
+ * A fixed-capacity set or list of TraitPaths, stored in an array of Records
+ * provided by the user.
+ *
+ * The Records are also used to index the paths by TraitDataHandle: each trait
+ * instance hashes to a bucket, and the Records of a bucket are chained in index
+ * order, so that the operations on the paths of a single trait instance
+ * (IsPresent, Includes, Intersects, AddItemDedup, the per-trait iterators)
+ * only visit the Records of that bucket.
+ * Includes() walks up the ancestors of the path being checked, and the depth of
+ * each stored path in its schema is cached, so that Intersects() and AddItemDedup()
+ * only walk the part of the schema between the two paths being compared.
+ *
+ * A store can hold up to kMaxStoreSize items, which is set by WDM_TRAIT_PATH_STORE_MAX_ITEMS.
+ */
 struct TraitPathStore
 {
     public:
@@ -49,8 +64,28 @@ struct TraitPathStore
         };
         typedef uint8_t Flags;
 
+        /**
+         * Index of a Record within the store. Byte indices fit in the padding of a Record;
+         * builds that set WDM_TRAIT_PATH_STORE_MAX_ITEMS above 254 use wider indices, which
+         * add four bytes to each Record.
+         */
+#if WDM_TRAIT_PATH_STORE_MAX_ITEMS > 254
+        typedef uint16_t RecordIndex;
+#else
+        typedef uint8_t RecordIndex;
+#endif
+
+        enum {
+            kNullIndex       = (1 << (8 * sizeof(RecordIndex))) - 1,
+            kMaxStoreSize    = WDM_TRAIT_PATH_STORE_MAX_ITEMS,
+            kUnknownDepth    = UINT8_MAX,
+        };
+
         struct Record {
             Flags mFlags;
+            uint8_t mDepth;             /**< Cached depth of mTraitPath in its schema */
+            RecordIndex mNextInBucket;  /**< Index of the next Record in the same bucket */
+            RecordIndex mBucketHead;    /**< Index of the first Record of the bucket with the same index as this Record */
             TraitPath mTraitPath;
         };
 
@@ -107,8 +142,18 @@ struct TraitPathStore
         void SetFlags(size_t aIndex, Flags aFlags, bool aValue);
         bool AreFlagsSet_private(size_t aIndex, Flags aFlags) const { return ((mStore[aIndex].mFlags & aFlags) == aFlags); }
 
+        size_t GetBucket(TraitDataHandle aDataHandle) const { return aDataHandle % mStoreSize; }
+        size_t FindValidItemInBucket(size_t aIndex, TraitDataHandle aDataHandle) const;
+        void LinkItem(size_t aIndex);
+        void UnlinkItem(size_t aIndex);
+        void RebuildIndex();
+        uint8_t GetItemDepth(size_t aIndex, const TraitSchemaEngine * const aSchemaEngine) const;
+        bool IsItemDescendant(size_t aIndex, PropertyPathHandle aAncestor, int32_t aAncestorDepth,
+                              const TraitSchemaEngine * const aSchemaEngine) const;
+
         size_t mStoreSize;
         size_t mNumItems;
+        size_t mFirstAvailableHint;
 };
 
 }; // namespace WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current)
@@ -958,6 +958,15 @@ protected:
     timesync_t mUnadjTimestampLastSent_usec;
     //@}
 
+#if WEAVE_CONFIG_TIME_CLIENT_CONCURRENT_SYNC
+    //@{
+    /// communication contexts for concurrent sync, indexed the same way as mContacts.
+    /// an entry is only valid while the request to that contact is outstanding
+    ExchangeContext * mConcurrentExchangeContexts[WEAVE_CONFIG_TIME_CLIENT_MAX_NUM_CONTACTS];
+    timesync_t mConcurrentUnadjTimestampSent_usec[WEAVE_CONFIG_TIME_CLIENT_MAX_NUM_CONTACTS];
+    //@}
+#endif // WEAVE_CONFIG_TIME_CLIENT_CONCURRENT_SYNC
+
 #if WEAVE_CONFIG_TIME_CLIENT_FABRIC_LOCAL_DISCOVERY
     int8_t mLastLikelihoodSent;
 #endif // WEAVE_CONFIG_TIME_CLIENT_FABRIC_LOCAL_DISCOVERY
@@ -1069,6 +1078,27 @@ protected:
     /// so caller shall check both the return code and *rIsMessageSent.
     WEAVE_ERROR SendSyncRequest(bool * const rIsMessageSent, Contact * const aContact);
 
+#if WEAVE_CONFIG_TIME_CLIENT_CONCURRENT_SYNC
+    /// get the number of contacts which have completed the current round with a reliable response
+    int16_t GetNumCompletedReliableResponses(void);
+
+    /// get the number of concurrent requests still waiting for a response
+    int16_t GetNumConcurrentRequests(void);
+
+    /// send unicast sync requests to all idle contacts at once, as far as exchange contexts allow.
+    /// communication errors with individual contacts are registered but not returned
+    WEAVE_ERROR SendConcurrentSyncRequests(void);
+
+    /// close the Weave ExchangeContext used to talk to mContacts[aIndex]
+    bool DestroyConcurrentCommContext(const int aIndex);
+
+    /// close all outstanding concurrent requests, and mark the contacts as completed
+    void AbandonConcurrentRequests(void);
+
+    /// send out more requests, or move on to the next state, after a concurrent request completed
+    void ContinueConcurrentSync(void);
+#endif // WEAVE_CONFIG_TIME_CLIENT_CONCURRENT_SYNC
+
     void SetClientState(const ClientState state);
     const char * const GetClientStateName(void) const;
 
@@ -1106,6 +1136,12 @@ protected:
 
     static void HandleUnicastResponseTimeout(ExchangeContext * const ec);
 
+#if WEAVE_CONFIG_TIME_CLIENT_CONCURRENT_SYNC
+    static void HandleConcurrentSyncResponse(ExchangeContext *ec, const IPPacketInfo *pktInfo,
+        const WeaveMessageInfo *msgInfo, uint32_t profileId, uint8_t msgType, PacketBuffer *payload);
+    static void HandleConcurrentResponseTimeout(ExchangeContext * const ec);
+#endif // WEAVE_CONFIG_TIME_CLIENT_CONCURRENT_SYNC
+
     static void HandleAutoSyncTimeout(System::Layer* aSystemLayer, void* aAppState, System::Error aError);
 
     /**
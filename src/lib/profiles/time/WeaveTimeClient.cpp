@@ -121,6 +121,14 @@ WEAVE_ERROR TimeSyncNode::_InitClient(const uint8_t aEncryptionType,
     mExchangeContext = NULL;
     mUnadjTimestampLastSent_usec = 0;
 
+#if WEAVE_CONFIG_TIME_CLIENT_CONCURRENT_SYNC
+    for (int i = 0; i < WEAVE_CONFIG_TIME_CLIENT_MAX_NUM_CONTACTS; ++i)
+    {
+        mConcurrentExchangeContexts[i] = NULL;
+        mConcurrentUnadjTimestampSent_usec[i] = TIMESYNC_INVALID;
+    }
+#endif // WEAVE_CONFIG_TIME_CLIENT_CONCURRENT_SYNC
+
 exit:
     WeaveLogFunctError(err);
     SetClientState((WEAVE_NO_ERROR == err) ? kClientState_Idle : kClientState_InitializationFailed);
@@ -444,6 +452,14 @@ bool TimeSyncNode::DestroyCommContext(void)
     mActiveContact = NULL;
     mUnadjTimestampLastSent_usec = TIMESYNC_INVALID;
 
+#if WEAVE_CONFIG_TIME_CLIENT_CONCURRENT_SYNC
+    if (GetNumConcurrentRequests() > 0)
+    {
+        AbandonConcurrentRequests();
+        HaveToClose = true;
+    }
+#endif // WEAVE_CONFIG_TIME_CLIENT_CONCURRENT_SYNC
+
     return HaveToClose;
 }
 
@@ -717,6 +733,203 @@ exit:
     return err;
 }
 
+#if WEAVE_CONFIG_TIME_CLIENT_CONCURRENT_SYNC
+int16_t TimeSyncNode::GetNumCompletedReliableResponses(void)
+{
+    int16_t rCountReliableResponses = 0;
+
+    for (int i = 0; i < WEAVE_CONFIG_TIME_CLIENT_MAX_NUM_CONTACTS; ++i)
+    {
+        if ((uint8_t(kCommState_Completed) == mContacts[i].mCommState)
+            && (uint8_t(kResponseStatus_ReliableResponse) == mContacts[i].mResponseStatus))
+        {
+            ++rCountReliableResponses;
+        }
+    }
+
+    return rCountReliableResponses;
+}
+
+int16_t TimeSyncNode::GetNumConcurrentRequests(void)
+{
+    int16_t rCountRequests = 0;
+
+    for (int i = 0; i < WEAVE_CONFIG_TIME_CLIENT_MAX_NUM_CONTACTS; ++i)
+    {
+        if (NULL != mConcurrentExchangeContexts[i])
+        {
+            ++rCountRequests;
+        }
+    }
+
+    return rCountRequests;
+}
+
+WEAVE_ERROR TimeSyncNode::SendConcurrentSyncRequests(void)
+{
+    WEAVE_ERROR     err         = WEAVE_NO_ERROR;
+    TimeSyncRequest request;
+    PacketBuffer*   msgBuf      = NULL;
+    ExchangeContext * ec        = NULL;
+
+    // since this is unicast, we're using the maximum likelihood here
+    request.Init(TimeSyncRequest::kLikelihoodForResponse_Max, (kTimeSyncRole_Coordinator == mRole) ? true : false);
+
+    for (int i = 0; i < WEAVE_CONFIG_TIME_CLIENT_MAX_NUM_CONTACTS; ++i)
+    {
+        Contact * const contact = &mContacts[i];
+
+        if (uint8_t(kCommState_Idle) != contact->mCommState)
+        {
+            continue;
+        }
+
+        // allocate buffer and then encode the request into it
+        msgBuf = PacketBuffer::NewWithAvailableSize(TimeSyncRequest::kPayloadLen);
+        if (NULL == msgBuf)
+        {
+            // we're short on buffers. the remaining contacts are picked up when outstanding requests complete
+            break;
+        }
+
+        err = request.Encode(msgBuf);
+        SuccessOrExit(err);
+
+        ec = GetExchangeMgr()->NewContext(contact->mNodeId, contact->mNodeAddr, this);
+        if (NULL == ec)
+        {
+            // same as above, but we're short on exchange contexts
+            break;
+        }
+
+        WeaveLogDetail(TimeService, "Sending concurrent sync request to %" PRIX64, contact->mNodeId);
+
+        // Configure the encryption and key used to send the request
+        ec->EncryptionType = mEncryptionType;
+        ec->KeyId = mKeyId;
+
+        ec->OnMessageReceived = HandleConcurrentSyncResponse;
+
+        ec->ResponseTimeout = WEAVE_CONFIG_TIME_CLIENT_TIMER_UNICAST_MSEC;
+        ec->OnResponseTimeout = HandleConcurrentResponseTimeout;
+
+        // we're sending request to this node
+        contact->mCommState = uint8_t(kCommState_Active);
+        mConcurrentExchangeContexts[i] = ec;
+        ec = NULL;
+
+        // acquire unadjusted timestamp
+        mConcurrentUnadjTimestampSent_usec[i] = GetClock_MonotonicHiRes();
+
+        // send out the request
+        err = mConcurrentExchangeContexts[i]->SendMessage(kWeaveProfile_Time, kTimeMessageType_TimeSyncRequest, msgBuf,
+            ExchangeContext::kSendFlag_ExpectResponse);
+        msgBuf = NULL;
+        if (WEAVE_NO_ERROR != err)
+        {
+            // just like the serial case, failing to reach this node is not fatal.
+            // clear the error, mark the comm state as completed, and carry on with other contacts
+            WeaveLogFunctError(err);
+            err = WEAVE_NO_ERROR;
+            RegisterCommError(contact);
+            DestroyConcurrentCommContext(i);
+        }
+    }
+
+exit:
+    WeaveLogFunctError(err);
+
+    if (NULL != msgBuf)
+    {
+        PacketBuffer::Free(msgBuf);
+    }
+
+    return err;
+}
+
+bool TimeSyncNode::DestroyConcurrentCommContext(const int aIndex)
+{
+    bool HaveToClose = false;
+
+    if (NULL != mConcurrentExchangeContexts[aIndex])
+    {
+        mConcurrentExchangeContexts[aIndex]->Close();
+        mConcurrentExchangeContexts[aIndex] = NULL;
+        HaveToClose = true;
+    }
+    mConcurrentUnadjTimestampSent_usec[aIndex] = TIMESYNC_INVALID;
+
+    return HaveToClose;
+}
+
+void TimeSyncNode::AbandonConcurrentRequests(void)
+{
+    for (int i = 0; i < WEAVE_CONFIG_TIME_CLIENT_MAX_NUM_CONTACTS; ++i)
+    {
+        if (DestroyConcurrentCommContext(i))
+        {
+            // we stop waiting for this node. note this is not counted as communication error,
+            // for the node might just be slower than the others. any response it gave us
+            // in the previous round is kept
+            WeaveLogDetail(TimeService, "Stop waiting for node %" PRIX64, mContacts[i].mNodeId);
+        }
+
+        if (uint8_t(kCommState_Active) == mContacts[i].mCommState)
+        {
+            mContacts[i].mCommState = uint8_t(kCommState_Completed);
+        }
+    }
+}
+
+void TimeSyncNode::ContinueConcurrentSync(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    const TimeSyncNode::ClientState state = GetClientState();
+
+    if ((GetNumCompletedReliableResponses() < WEAVE_CONFIG_TIME_CLIENT_CONCURRENT_SYNC_MIN_RELIABLE_RESPONSES)
+        && (GetNumNotYetCompletedContacts() > 0))
+    {
+        // talk to whoever we haven't talked to yet in this round
+        err = SendConcurrentSyncRequests();
+        SuccessOrExit(err);
+    }
+
+    if ((GetNumCompletedReliableResponses() < WEAVE_CONFIG_TIME_CLIENT_CONCURRENT_SYNC_MIN_RELIABLE_RESPONSES)
+        && (GetNumNotYetCompletedContacts() > 0))
+    {
+        // keep waiting for responses. if nothing is outstanding, we have idle contacts but no resource to reach them
+        VerifyOrExit(GetNumConcurrentRequests() > 0, err = WEAVE_ERROR_NO_MEMORY);
+    }
+    else
+    {
+        WEAVE_TIME_PROGRESS_LOG(TimeService, "Concurrent sync round done with %d reliable response(s)",
+            GetNumCompletedReliableResponses());
+
+        // close the requests we're no longer interested in, before we move on
+        AbandonConcurrentRequests();
+
+        if (kClientState_Sync_1 == state)
+        {
+            // Sync_1 => Sync_2
+            SetAllCompletedContactsToIdle();
+            EnterState_Sync_2();
+        }
+        else
+        {
+            // try to calculate a time fix
+            EndLocalSyncAndTryCalculateTimeFix();
+        }
+    }
+
+exit:
+    WeaveLogFunctError(err);
+
+    // abort, and let the application layer know, if we encounter any error that we cannot handle
+    AbortOnError(err);
+}
+#endif // WEAVE_CONFIG_TIME_CLIENT_CONCURRENT_SYNC
+
 void TimeSyncNode::EnterState_Sync_1(void)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
@@ -740,6 +953,12 @@ void TimeSyncNode::EnterState_Sync_1(void)
         ExitNow(err = WEAVE_ERROR_INCORRECT_STATE);
     }
 
+#if WEAVE_CONFIG_TIME_CLIENT_CONCURRENT_SYNC
+    // talk to all contacts at once. we move on to Sync_2 when enough of them have responded
+    ContinueConcurrentSync();
+    ExitNow();
+#endif // WEAVE_CONFIG_TIME_CLIENT_CONCURRENT_SYNC
+
     do
     {
         contact = GetNextIdleContact();
@@ -787,6 +1006,12 @@ void TimeSyncNode::EnterState_Sync_2(void)
         ExitNow(err = WEAVE_ERROR_INCORRECT_STATE);
     }
 
+#if WEAVE_CONFIG_TIME_CLIENT_CONCURRENT_SYNC
+    // talk to all contacts at once. we calculate a time fix when enough of them have responded
+    ContinueConcurrentSync();
+    ExitNow();
+#endif // WEAVE_CONFIG_TIME_CLIENT_CONCURRENT_SYNC
+
     do
     {
         // try to get the next contact to reach
@@ -2149,6 +2374,125 @@ void TimeSyncNode::HandleUnicastResponseTimeout(ExchangeContext * const ec)
     return;
 }
 
+#if WEAVE_CONFIG_TIME_CLIENT_CONCURRENT_SYNC
+void TimeSyncNode::HandleConcurrentSyncResponse(ExchangeContext *ec, const IPPacketInfo *pktInfo,
+    const WeaveMessageInfo *msgInfo,
+    uint32_t profileId, uint8_t msgType, PacketBuffer *payload)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    TimeSyncNode * const client = reinterpret_cast<TimeSyncNode *>(ec->AppState);
+    TimeSyncResponse response;
+    const TimeSyncNode::ClientState ClientStateAtEntry(client->GetClientState());
+    int index;
+
+    // find the contact this exchange context was created for
+    for (index = 0; index < WEAVE_CONFIG_TIME_CLIENT_MAX_NUM_CONTACTS; ++index)
+    {
+        if (client->mConcurrentExchangeContexts[index] == ec)
+        {
+            break;
+        }
+    }
+
+    VerifyOrExit(index < WEAVE_CONFIG_TIME_CLIENT_MAX_NUM_CONTACTS, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    if (kTimeMessageType_TimeSyncResponse != msgType)
+    {
+        ExitNow(err = WEAVE_ERROR_INVALID_MESSAGE_TYPE);
+    }
+
+    err = TimeSyncResponse::Decode(&response, payload);
+    SuccessOrExit(err);
+
+    if ((kClientState_Sync_1 == ClientStateAtEntry) || (kClientState_Sync_2 == ClientStateAtEntry))
+    {
+        // Verify the response was received via an authenticated session
+        // note that under this error, we just throw the whole message away, so communication with
+        // this node will be treated as timeout
+        if ((ec->KeyId != client->mKeyId) || (ec->EncryptionType != client->mEncryptionType))
+        {
+            ExitNow(err = WEAVE_ERROR_UNSUPPORTED_AUTH_MODE);
+        }
+
+        // update the record now, reusing the unicast code
+        client->mActiveContact = &client->mContacts[index];
+        client->mUnadjTimestampLastSent_usec = client->mConcurrentUnadjTimestampSent_usec[index];
+        client->UpdateUnicastSyncResponse(response);
+        client->mActiveContact = NULL;
+        client->mUnadjTimestampLastSent_usec = TIMESYNC_INVALID;
+
+        client->DestroyConcurrentCommContext(index);
+        ec = NULL;
+
+        // decide if we need to wait for more responses
+        client->ContinueConcurrentSync();
+    }
+    else
+    {
+        err = WEAVE_ERROR_INCORRECT_STATE;
+        client->DestroyCommContext();
+        client->AbortOnError(err);
+    }
+
+exit:
+    // note we have to be very careful about what we do at here
+    // as the state of 'client' might have changed due to transition
+    WeaveLogFunctError(err);
+    if (NULL != payload)
+    {
+        PacketBuffer::Free(payload);
+    }
+}
+
+void TimeSyncNode::HandleConcurrentResponseTimeout(ExchangeContext * const ec)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    TimeSyncNode * const client = reinterpret_cast<TimeSyncNode *>(ec->AppState);
+    const TimeSyncNode::ClientState ClientStateAtEntry(client->GetClientState());
+    int index;
+
+    WeaveLogDetail(TimeService, "Concurrent unicast just timed out at client state: %d (%s)", client->GetClientState(),
+        client->GetClientStateName());
+
+    for (index = 0; index < WEAVE_CONFIG_TIME_CLIENT_MAX_NUM_CONTACTS; ++index)
+    {
+        if (client->mConcurrentExchangeContexts[index] == ec)
+        {
+            break;
+        }
+    }
+
+    VerifyOrExit(index < WEAVE_CONFIG_TIME_CLIENT_MAX_NUM_CONTACTS, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    // close this context as timeout
+    client->DestroyConcurrentCommContext(index);
+
+    if ((kClientState_Sync_1 == ClientStateAtEntry) || (kClientState_Sync_2 == ClientStateAtEntry))
+    {
+        // register communication error
+        // note we don't invalidated the contact easily
+        client->RegisterCommError(&client->mContacts[index]);
+
+        // the other requests might still be outstanding
+        client->ContinueConcurrentSync();
+    }
+    else
+    {
+        err = WEAVE_ERROR_INCORRECT_STATE;
+        client->AbortOnError(err);
+    }
+
+exit:
+    // Note that we have to be careful what to do at here, as
+    // the state of 'client' might have been changed in those state transitions
+    WeaveLogFunctError(err);
+
+    return;
+}
+#endif // WEAVE_CONFIG_TIME_CLIENT_CONCURRENT_SYNC
+
 void TimeSyncNode::DisableAutoSync(void)
 {
     GetExchangeMgr()->MessageLayer->SystemLayer->CancelTimer(HandleAutoSyncTimeout, this);
@@ -38,30 +38,70 @@ namespace nl {
 namespace Weave {
 namespace ASN1 {
 
+// The OID table is sorted by enum value, while sOIDEncodedIndex lists the positions of its
+// entries in order of encoded length and then encoded value (see gen-oid-table.py).
+
+static int CompareEncodedObjectID(const OIDTableEntry& entry, const uint8_t *encodedOID, uint16_t encodedOIDLen)
+{
+    if (entry.EncodedOIDLen != encodedOIDLen)
+        return (entry.EncodedOIDLen < encodedOIDLen) ? -1 : 1;
+    return memcmp(entry.EncodedOID, encodedOID, encodedOIDLen);
+}
+
+// Returns the position of the given OID in the OID table, or sOIDTableSize if not found.
+static size_t FindObjectID(OID oid)
+{
+    size_t low = 0, high = sOIDTableSize;
+
+    while (low < high)
+    {
+        size_t mid = low + (high - low) / 2;
+
+        if (sOIDTable[mid].EnumVal == oid)
+            return mid;
+        if (sOIDTable[mid].EnumVal < oid)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    return sOIDTableSize;
+}
+
 NL_DLL_EXPORT OID ParseObjectID(const uint8_t *encodedOID, uint16_t encodedOIDLen)
 {
+    size_t low = 0, high = sOIDTableSize;
+
     if (encodedOID == NULL or encodedOIDLen == 0)
         return kOID_NotSpecified;
 
-    for (uint32_t i = 0; i < sOIDTableSize; i++)
-        if (encodedOIDLen == sOIDTable[i].EncodedOIDLen &&
-            memcmp(encodedOID, sOIDTable[i].EncodedOID, encodedOIDLen) == 0)
-            return sOIDTable[i].EnumVal;
+    while (low < high)
+    {
+        size_t mid = low + (high - low) / 2;
+        const OIDTableEntry& entry = sOIDTable[sOIDEncodedIndex[mid]];
+        int cmp = CompareEncodedObjectID(entry, encodedOID, encodedOIDLen);
+
+        if (cmp == 0)
+            return entry.EnumVal;
+        if (cmp < 0)
+            low = mid + 1;
+        else
+            high = mid;
+    }
 
     return kOID_Unknown;
 }
 
 bool GetEncodedObjectID(OID oid, const uint8_t *& encodedOID, uint16_t& encodedOIDLen)
 {
-    for (uint32_t i = 0; i < sOIDTableSize; i++)
-        if (oid == sOIDTable[i].EnumVal)
-        {
-            encodedOID = sOIDTable[i].EncodedOID;
-            encodedOIDLen = sOIDTable[i].EncodedOIDLen;
-            return true;
-        }
-
-    return false;
+    size_t i = FindObjectID(oid);
+
+    if (i == sOIDTableSize)
+        return false;
+
+    encodedOID = sOIDTable[i].EncodedOID;
+    encodedOIDLen = sOIDTable[i].EncodedOIDLen;
+    return true;
 }
 
 OIDCategory GetOIDCategory(OID oid)
@@ -79,10 +119,10 @@ const char *GetOIDName(OID oid)
         return "Unknown";
     if (oid == kOID_NotSpecified)
         return "NotSpecified";
-    for (uint32_t i = 0; i < sOIDTableSize; i++)
-        if (oid == sOIDNameTable[i].EnumVal)
-            return sOIDNameTable[i].Name;
-    return "Unknown";
+    size_t i = FindObjectID(oid);
+    if (i == sOIDTableSize)
+        return "Unknown";
+    return sOIDNameTable[i].Name;
 }
 
 ASN1_ERROR ASN1Reader::GetObjectId(OID& oid)
@@ -27,9 +27,23 @@
 #endif
 #include <ctype.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "Base64.h"
 
+// Use SSSE3 for long inputs on x86 processors that support it, as detected at run time.
+#ifndef BASE64_CONFIG_USE_SSSE3
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define BASE64_CONFIG_USE_SSSE3 1
+#else
+#define BASE64_CONFIG_USE_SSSE3 0
+#endif
+#endif // BASE64_CONFIG_USE_SSSE3
+
+#if BASE64_CONFIG_USE_SSSE3
+#include <tmmintrin.h>
+#endif
+
 namespace nl {
 
 // Convert a value in the range 0..63 to its equivalent base64 character.
@@ -110,9 +124,227 @@ static uint8_t Base64URLCharToVal(uint8_t c)
     return UINT8_MAX;
 }
 
+// The generic encode and decode loops below map each character through a caller-supplied function.
+// When that function is one of the built-in alphabets, whole 3-byte groups and whole groups of 4
+// alphabet characters are converted by the block functions that follow instead, using lookup
+// tables or SSSE3.  The generic loops then handle the rest of the input (padding, whitespace,
+// invalid characters) exactly as before.
+
+struct Base64Alphabet
+{
+    const char *Chars;          // The 64 characters of the alphabet, in value order.
+    const uint8_t *Values;      // The value of each 7-bit character, or UINT8_MAX if not in the alphabet.
+    char Char62;
+    char Char63;
+};
+
+static const char sBase64Chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static const char sBase64URLChars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+static const uint8_t sBase64Values[128] =
+{
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF, 0xFF, 0x3F,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+    0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
+static const uint8_t sBase64URLValues[128] =
+{
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+    0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0x3F,
+    0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
+static const Base64Alphabet sBase64Alphabet = { sBase64Chars, sBase64Values, '+', '/' };
+static const Base64Alphabet sBase64URLAlphabet = { sBase64URLChars, sBase64URLValues, '-', '_' };
+
+static const Base64Alphabet *GetAlphabet(Base64ValToCharFunct valToCharFunct)
+{
+    if (valToCharFunct == Base64ValToChar)
+        return &sBase64Alphabet;
+    if (valToCharFunct == Base64URLValToChar)
+        return &sBase64URLAlphabet;
+    return NULL;
+}
+
+static const Base64Alphabet *GetAlphabet(Base64CharToValFunct charToValFunct)
+{
+    if (charToValFunct == Base64CharToVal)
+        return &sBase64Alphabet;
+    if (charToValFunct == Base64URLCharToVal)
+        return &sBase64URLAlphabet;
+    return NULL;
+}
+
+#if BASE64_CONFIG_USE_SSSE3
+
+static bool HaveSSSE3(void)
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("ssse3");
+}
+
+// Encode groups of 12 bytes into 16 characters, while at least 16 bytes of input remain.
+// Returns the number of input bytes converted.
+__attribute__((target("ssse3")))
+static uint32_t EncodeBlocksSSSE3(const uint8_t *in, uint32_t inLen, char *out, const Base64Alphabet& alphabet)
+{
+    const __m128i spread = _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    uint32_t convertedLen = 0;
+
+    while (inLen - convertedLen >= 16)
+    {
+        __m128i bytes = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(in + convertedLen)), spread);
+
+        // Move each 6-bit value of a 3-byte group into its own byte.
+        __m128i vals = _mm_or_si128(
+            _mm_mulhi_epu16(_mm_and_si128(bytes, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040)),
+            _mm_mullo_epi16(_mm_and_si128(bytes, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010)));
+
+        // Map the values to characters, starting from 'A' and adding the offset of each later range.
+        __m128i chars = _mm_add_epi8(vals, _mm_set1_epi8('A'));
+        chars = _mm_add_epi8(chars, _mm_and_si128(_mm_cmpgt_epi8(vals, _mm_set1_epi8(25)), _mm_set1_epi8('a' - 'A' - 26)));
+        chars = _mm_add_epi8(chars, _mm_and_si128(_mm_cmpgt_epi8(vals, _mm_set1_epi8(51)), _mm_set1_epi8('0' - 'a' - 26)));
+        chars = _mm_add_epi8(chars, _mm_and_si128(_mm_cmpeq_epi8(vals, _mm_set1_epi8(62)), _mm_set1_epi8(alphabet.Char62 - '0' - 10)));
+        chars = _mm_add_epi8(chars, _mm_and_si128(_mm_cmpeq_epi8(vals, _mm_set1_epi8(63)), _mm_set1_epi8(alphabet.Char63 - '0' - 11)));
+
+        _mm_storeu_si128((__m128i *)(out + convertedLen / 3 * 4), chars);
+
+        convertedLen += 12;
+    }
+
+    return convertedLen;
+}
+
+// Decode groups of 16 alphabet characters into 12 bytes, stopping at the first group containing
+// any other character.  Returns the number of characters converted.
+__attribute__((target("ssse3")))
+static uint32_t DecodeBlocksSSSE3(const char *in, uint32_t inLen, uint8_t *out, const Base64Alphabet& alphabet)
+{
+    const __m128i pack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    uint32_t convertedLen = 0;
+
+    while (inLen - convertedLen >= 16)
+    {
+        __m128i chars = _mm_loadu_si128((const __m128i *)(in + convertedLen));
+        __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('A' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('Z' + 1), chars));
+        __m128i lower = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('a' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('z' + 1), chars));
+        __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), chars));
+        __m128i char62 = _mm_cmpeq_epi8(chars, _mm_set1_epi8(alphabet.Char62));
+        __m128i char63 = _mm_cmpeq_epi8(chars, _mm_set1_epi8(alphabet.Char63));
+        __m128i valid = _mm_or_si128(_mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digit, char62)), char63);
+        __m128i offsets, vals, bytes;
+        uint8_t outBlock[16];
+
+        if (_mm_movemask_epi8(valid) != 0xFFFF)
+            break;
+
+        offsets = _mm_or_si128(_mm_and_si128(upper, _mm_set1_epi8(-'A')), _mm_and_si128(lower, _mm_set1_epi8(26 - 'a')));
+        offsets = _mm_or_si128(offsets, _mm_and_si128(digit, _mm_set1_epi8(52 - '0')));
+        offsets = _mm_or_si128(offsets, _mm_and_si128(char62, _mm_set1_epi8(62 - alphabet.Char62)));
+        offsets = _mm_or_si128(offsets, _mm_and_si128(char63, _mm_set1_epi8(63 - alphabet.Char63)));
+        vals = _mm_add_epi8(chars, offsets);
+
+        // Join each group of four 6-bit values into 24 bits, then gather the bytes in order.
+        vals = _mm_maddubs_epi16(vals, _mm_set1_epi32(0x01400140));
+        vals = _mm_madd_epi16(vals, _mm_set1_epi32(0x00011000));
+        bytes = _mm_shuffle_epi8(vals, pack);
+
+        // Store only the 12 decoded bytes, as the output may overlap the input.
+        _mm_storeu_si128((__m128i *)outBlock, bytes);
+        memcpy(out + convertedLen / 4 * 3, outBlock, 12);
+
+        convertedLen += 16;
+    }
+
+    return convertedLen;
+}
+
+#endif // BASE64_CONFIG_USE_SSSE3
+
+// Encode whole 3-byte groups.  Returns the number of input bytes converted.
+static uint32_t EncodeBlocks(const uint8_t *in, uint32_t inLen, char *out, const Base64Alphabet& alphabet)
+{
+    uint32_t convertedLen = 0;
+
+#if BASE64_CONFIG_USE_SSSE3
+    if (inLen >= 16 && HaveSSSE3())
+        convertedLen = EncodeBlocksSSSE3(in, inLen, out, alphabet);
+#endif
+
+    for (; inLen - convertedLen >= 3; convertedLen += 3)
+    {
+        const uint8_t *group = in + convertedLen;
+        char *outGroup = out + convertedLen / 3 * 4;
+
+        outGroup[0] = alphabet.Chars[group[0] >> 2];
+        outGroup[1] = alphabet.Chars[((group[0] << 4) & 0x30) | (group[1] >> 4)];
+        outGroup[2] = alphabet.Chars[((group[1] << 2) & 0x3C) | (group[2] >> 6)];
+        outGroup[3] = alphabet.Chars[group[2] & 0x3F];
+    }
+
+    return convertedLen;
+}
+
+// Decode whole groups of 4 alphabet characters, stopping at the first group containing any
+// other character.  Returns the number of characters converted.
+static uint32_t DecodeBlocks(const char *in, uint32_t inLen, uint8_t *out, const Base64Alphabet& alphabet)
+{
+    uint32_t convertedLen = 0;
+
+#if BASE64_CONFIG_USE_SSSE3
+    if (inLen >= 16 && HaveSSSE3())
+        convertedLen = DecodeBlocksSSSE3(in, inLen, out, alphabet);
+#endif
+
+    for (; inLen - convertedLen >= 4; convertedLen += 4)
+    {
+        const uint8_t *group = (const uint8_t *)in + convertedLen;
+        uint8_t *outGroup = out + convertedLen / 4 * 3;
+        uint8_t a, b, c, d;
+
+        if ((group[0] | group[1] | group[2] | group[3]) & 0x80)
+            break;
+
+        a = alphabet.Values[group[0]];
+        b = alphabet.Values[group[1]];
+        c = alphabet.Values[group[2]];
+        d = alphabet.Values[group[3]];
+
+        if ((a | b | c | d) == UINT8_MAX)
+            break;
+
+        outGroup[0] = (a << 2) | (b >> 4);
+        outGroup[1] = (b << 4) | (c >> 2);
+        outGroup[2] = (c << 6) | d;
+    }
+
+    return convertedLen;
+}
+
 uint16_t Base64Encode(const uint8_t *in, uint16_t inLen, char *out, Base64ValToCharFunct valToCharFunct)
 {
     char *outStart = out;
+    const Base64Alphabet *alphabet = GetAlphabet(valToCharFunct);
+
+    if (alphabet != NULL)
+    {
+        uint16_t convertedLen = (uint16_t)EncodeBlocks(in, inLen, out, *alphabet);
+
+        in += convertedLen;
+        inLen -= convertedLen;
+        out += convertedLen / 3 * 4;
+    }
 
     while (inLen > 0)
     {
@@ -196,6 +428,16 @@ uint32_t Base64Encode32(const uint8_t *in, uint32_t inLen, char *out)
 uint16_t Base64Decode(const char *in, uint16_t inLen, uint8_t *out, Base64CharToValFunct charToValFunct)
 {
     uint8_t *outStart = out;
+    const Base64Alphabet *alphabet = GetAlphabet(charToValFunct);
+
+    if (alphabet != NULL)
+    {
+        uint16_t convertedLen = (uint16_t)DecodeBlocks(in, inLen, out, *alphabet);
+
+        in += convertedLen;
+        inLen -= convertedLen;
+        out += convertedLen / 4 * 3;
+    }
 
     // isgraph() returns false for space and ctrl chars
     while (inLen > 0 && isgraph(*in))
@@ -29,7 +29,9 @@ namespace Weave {
 PersistedCounter::PersistedCounter(void) :
     MonotonicallyIncreasingCounter(),
     mStartingCounterValue(0),
-    mEpoch(0)
+    mEpoch(0),
+    mWriteCount(0),
+    mBatch(NULL)
 {
     memset(&mId, 0, sizeof(mId));
 }
@@ -107,6 +109,33 @@ PersistedCounter::AdvanceEpochRelative(uint32_t aValue)
     return ret;
 }
 
+WEAVE_ERROR
+PersistedCounter::Reserve(uint32_t aCount, uint32_t &aFirstValue)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    uint32_t nextValue;
+
+    VerifyOrExit(aCount > 0, err = WEAVE_ERROR_INVALID_INTEGER_VALUE);
+
+    nextValue = mCounterValue + aCount;
+
+    // If the value following the range is past the current epoch, start a
+    // new epoch there, covering the whole range with a single write.
+    if ((nextValue - mStartingCounterValue) >= mEpoch)
+    {
+        err = WriteStartValue(nextValue + mEpoch);
+        SuccessOrExit(err);
+
+        mStartingCounterValue = nextValue;
+    }
+
+    aFirstValue = mCounterValue;
+    mCounterValue = nextValue;
+
+exit:
+    return err;
+}
+
 bool
 PersistedCounter::GetNextValue(uint32_t &aValue)
 {
@@ -152,7 +181,23 @@ PersistedCounter::WriteStartValue(uint32_t aStartValue)
     WeaveLogDetail(EventLogging, "PersistedCounter::WriteStartValue() aStartValue 0x%x", aStartValue);
 #endif
 
-    return nl::Weave::Platform::PersistedStorage::Write(mId, aStartValue);
+    WEAVE_ERROR err;
+
+    if (mBatch != NULL)
+    {
+        // Let the other counters sharing the batch start new epochs in the same write.
+        err = mBatch->FlushCounter(*this, aStartValue);
+    }
+    else
+    {
+        err = nl::Weave::Platform::PersistedStorage::Write(mId, aStartValue);
+        if (err == WEAVE_NO_ERROR)
+        {
+            mWriteCount++;
+        }
+    }
+
+    return err;
 }
 
 WEAVE_ERROR
@@ -28,6 +28,7 @@
 #define PERSISTED_COUNTER_H
 
 #include <Weave/Support/platform/PersistedStorage.h>
+#include <Weave/Support/PersistedStorageBatch.h>
 #include <Weave/Support/WeaveCounter.h>
 
 namespace nl {
@@ -88,7 +89,33 @@ public:
      */
     WEAVE_ERROR SetValue(uint32_t value);
 
+    /**
+     *  @brief
+     *    Reserve a range of consecutive counter values.
+     *
+     *  Vends aCount values starting at the current value and advances the
+     *  counter past them, as aCount calls to GetValue() and Advance()
+     *  would, but with at most one write to persisted storage however
+     *  large the range is.
+     *
+     *  @param[in]  aCount       The number of values to reserve.
+     *  @param[out] aFirstValue  The first value of the reserved range.
+     *
+     *  @return WEAVE_ERROR_INVALID_INTEGER_VALUE if aCount is 0.
+     *          Any error returned by a write to persisted storage.
+     *          WEAVE_NO_ERROR otherwise
+     */
+    WEAVE_ERROR Reserve(uint32_t aCount, uint32_t &aFirstValue);
+
+    /**
+     *  @brief
+     *    Get the number of times this counter has written to persisted storage.
+     */
+    uint32_t GetWriteCount(void) const { return mWriteCount; }
+
 private:
+    friend class PersistedStorageBatch;
+
     /**
      *  @brief
      *  Get the next value of the counter, based on aValue.
@@ -132,6 +159,8 @@ private:
     nl::Weave::Platform::PersistedStorage::Key mId;
     uint32_t mStartingCounterValue;
     uint32_t mEpoch;
+    uint32_t mWriteCount;
+    PersistedStorageBatch *mBatch;
 };
 
 } // Weave
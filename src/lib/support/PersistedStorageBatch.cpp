@@ -0,0 +1,186 @@
+/*
+ *
+ *    Copyright (c) 2016-2017 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <Weave/Support/CodeUtils.h>
+#include <Weave/Support/logging/WeaveLogging.h>
+#include <Weave/Support/PersistedCounter.h>
+#include <Weave/Support/PersistedStorageBatch.h>
+#include <Weave/Support/platform/PersistedStorage.h>
+
+#include <string.h>
+
+namespace nl {
+namespace Weave {
+
+PersistedStorageBatch::PersistedStorageBatch(void) :
+    mNumStaged(0),
+    mNumCounters(0)
+{
+    memset(mKeys, 0, sizeof(mKeys));
+    memset(mValues, 0, sizeof(mValues));
+    memset(mCounters, 0, sizeof(mCounters));
+    memset(&mStats, 0, sizeof(mStats));
+}
+
+// Keys that are strings name the same storage whenever they are equal, whichever buffers hold them.
+static inline bool KeysMatch(const char *aKey1, const char *aKey2)
+{
+    return aKey1 == aKey2 || (aKey1 != NULL && aKey2 != NULL && strcmp(aKey1, aKey2) == 0);
+}
+
+template <typename KeyType>
+static inline bool KeysMatch(KeyType aKey1, KeyType aKey2)
+{
+    return aKey1 == aKey2;
+}
+
+WEAVE_ERROR
+PersistedStorageBatch::AddCounter(PersistedCounter &aCounter)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    VerifyOrExit(aCounter.mBatch == NULL, err = WEAVE_ERROR_INCORRECT_STATE);
+    VerifyOrExit(mNumCounters < WEAVE_CONFIG_PERSISTED_STORAGE_BATCH_MAX_KEYS, err = WEAVE_ERROR_NO_MEMORY);
+
+    mCounters[mNumCounters++] = &aCounter;
+    aCounter.mBatch = this;
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR
+PersistedStorageBatch::Stage(nl::Weave::Platform::PersistedStorage::Key aKey, uint32_t aValue)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    uint8_t i;
+
+    // Replace the value already staged for this key, if any.
+    for (i = 0; i < mNumStaged; i++)
+    {
+        if (KeysMatch(mKeys[i], aKey))
+        {
+            mValues[i] = aValue;
+            mStats.mCoalescedWriteCount++;
+            ExitNow();
+        }
+    }
+
+    VerifyOrExit(mNumStaged < WEAVE_CONFIG_PERSISTED_STORAGE_BATCH_MAX_KEYS, err = WEAVE_ERROR_NO_MEMORY);
+
+    mKeys[mNumStaged] = aKey;
+    mValues[mNumStaged] = aValue;
+    mNumStaged++;
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR
+PersistedStorageBatch::Flush(void)
+{
+    return Flush(NULL);
+}
+
+WEAVE_ERROR
+PersistedStorageBatch::FlushCounter(PersistedCounter &aCounter, uint32_t aStartValue)
+{
+    WEAVE_ERROR err;
+
+    err = Stage(aCounter.mId, aStartValue);
+    SuccessOrExit(err);
+
+    err = Flush(&aCounter);
+    SuccessOrExit(err);
+
+    aCounter.mWriteCount++;
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR
+PersistedStorageBatch::Flush(PersistedCounter *aWritingCounter)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    PersistedCounter *advanced[WEAVE_CONFIG_PERSISTED_STORAGE_BATCH_MAX_KEYS];
+    uint8_t numAdvanced = 0;
+    uint8_t i;
+
+    VerifyOrExit(mNumStaged > 0, /* no-op */);
+
+    // Start new epochs early for the other counters that are more than half
+    // way through their current one, as long as there is room in the batch.
+    for (i = 0; i < mNumCounters && mNumStaged < WEAVE_CONFIG_PERSISTED_STORAGE_BATCH_MAX_KEYS; i++)
+    {
+        PersistedCounter *counter = mCounters[i];
+
+        if (counter != aWritingCounter &&
+            (counter->mCounterValue - counter->mStartingCounterValue) >= (counter->mEpoch / 2) &&
+            Stage(counter->mId, counter->mCounterValue + counter->mEpoch) == WEAVE_NO_ERROR)
+        {
+            advanced[numAdvanced++] = counter;
+        }
+    }
+
+    err = WriteStaged();
+    SuccessOrExit(err);
+
+    // The new epochs are only in effect once they have been written.
+    for (i = 0; i < numAdvanced; i++)
+    {
+        advanced[i]->mStartingCounterValue = advanced[i]->mCounterValue;
+        advanced[i]->mWriteCount++;
+    }
+
+    mStats.mEarlyAdvanceCount += numAdvanced;
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR
+PersistedStorageBatch::WriteStaged(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+#if WEAVE_CONFIG_PERSISTED_STORAGE_BATCH_WRITE
+    err = nl::Weave::Platform::PersistedStorage::WriteBatch(mKeys, mValues, mNumStaged);
+#else
+    for (uint8_t i = 0; i < mNumStaged && err == WEAVE_NO_ERROR; i++)
+    {
+        err = nl::Weave::Platform::PersistedStorage::Write(mKeys[i], mValues[i]);
+    }
+#endif // WEAVE_CONFIG_PERSISTED_STORAGE_BATCH_WRITE
+
+    if (err == WEAVE_NO_ERROR)
+    {
+        mStats.mFlushCount++;
+        mStats.mValueWriteCount += mNumStaged;
+    }
+    else
+    {
+        WeaveLogError(Support, "PersistedStorageBatch write of %u values failed: %d", mNumStaged, err);
+    }
+
+    mNumStaged = 0;
+
+    return err;
+}
+
+} // Weave
+} // nl
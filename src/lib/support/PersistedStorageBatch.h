@@ -0,0 +1,135 @@
+/*
+ *
+ *    Copyright (c) 2016-2017 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *
+ * @brief
+ *   Class declarations for coalescing writes of several values to the
+ *   platform's persistent storage.
+ */
+
+#ifndef PERSISTED_STORAGE_BATCH_H
+#define PERSISTED_STORAGE_BATCH_H
+
+#include <Weave/Support/platform/PersistedStorage.h>
+
+namespace nl {
+namespace Weave {
+
+class PersistedCounter;
+
+/**
+ * @class PersistedStorageBatch
+ *
+ * @brief
+ *   A class for writing several persistently-stored values together.
+ *
+ *   Values are staged with Stage() and written out by Flush().  Staging a
+ *   new value for a key that already has one staged replaces it, so only
+ *   the latest value of each key is written.
+ *
+ *   PersistedCounters can share a batch with AddCounter().  Whenever the
+ *   batch is flushed, every counter sharing it that is more than half way
+ *   through its epoch is advanced to a new epoch in the same flush, so
+ *   counters that advance at similar rates are mostly written together
+ *   instead of one at a time.
+ */
+
+class PersistedStorageBatch
+{
+public:
+    /**
+     *  Write counts for a batch, for monitoring the wear on persistent storage.
+     */
+    struct Stats
+    {
+        uint32_t mFlushCount;           ///< Number of flushes that wrote to persistent storage
+        uint32_t mValueWriteCount;      ///< Number of values written to persistent storage
+        uint32_t mCoalescedWriteCount;  ///< Number of staged values replaced before they were written
+        uint32_t mEarlyAdvanceCount;    ///< Number of counter epochs started early to share a flush
+    };
+
+    PersistedStorageBatch(void);
+
+    /**
+     *  @brief
+     *    Add a PersistedCounter to those sharing this batch.
+     *
+     *  The counter writes its next starting value through this batch from
+     *  then on.
+     *
+     *  @param[in] aCounter  An initialized PersistedCounter.
+     *
+     *  @return WEAVE_ERROR_NO_MEMORY if WEAVE_CONFIG_PERSISTED_STORAGE_BATCH_MAX_KEYS
+     *          counters already share this batch.
+     *          WEAVE_ERROR_INCORRECT_STATE if the counter already shares a batch.
+     *          WEAVE_NO_ERROR otherwise
+     */
+    WEAVE_ERROR AddCounter(PersistedCounter &aCounter);
+
+    /**
+     *  @brief
+     *    Stage a value to be written to persistent storage by the next Flush().
+     *
+     *  @param[in] aKey    A key to a persistently-stored value.
+     *  @param[in] aValue  The value.
+     *
+     *  @return WEAVE_ERROR_NO_MEMORY if values are already staged for
+     *          WEAVE_CONFIG_PERSISTED_STORAGE_BATCH_MAX_KEYS other keys.
+     *          WEAVE_NO_ERROR otherwise
+     */
+    WEAVE_ERROR Stage(nl::Weave::Platform::PersistedStorage::Key aKey, uint32_t aValue);
+
+    /**
+     *  @brief
+     *    Write all staged values to persistent storage.
+     *
+     *  When WEAVE_CONFIG_PERSISTED_STORAGE_BATCH_WRITE is enabled, the
+     *  values are written in one platform transaction.  The staged values
+     *  are discarded whether or not the write succeeds.
+     *
+     *  @return Any error returned by a write to persistent storage.
+     */
+    WEAVE_ERROR Flush(void);
+
+    /**
+     *  @brief
+     *    Get the write counts of this batch.
+     */
+    const Stats &GetStats(void) const { return mStats; }
+
+private:
+    friend class PersistedCounter;
+
+    WEAVE_ERROR FlushCounter(PersistedCounter &aCounter, uint32_t aStartValue);
+    WEAVE_ERROR Flush(PersistedCounter *aWritingCounter);
+    WEAVE_ERROR WriteStaged(void);
+
+    nl::Weave::Platform::PersistedStorage::Key mKeys[WEAVE_CONFIG_PERSISTED_STORAGE_BATCH_MAX_KEYS];
+    uint32_t mValues[WEAVE_CONFIG_PERSISTED_STORAGE_BATCH_MAX_KEYS];
+    PersistedCounter *mCounters[WEAVE_CONFIG_PERSISTED_STORAGE_BATCH_MAX_KEYS];
+    uint8_t mNumStaged;
+    uint8_t mNumCounters;
+    Stats mStats;
+};
+
+} // Weave
+} // nl
+
+#endif // PERSISTED_STORAGE_BATCH_H
@@ -51,6 +51,7 @@ static const nl::FaultInjection::Name sFaultNames[] = {
 #endif // WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
     "BDXBadBlockCounter",
     "BDXAllocTransfer",
+    "BDXAbortTransfer",
 #if WEAVE_CONFIG_ENABLE_SERVICE_DIRECTORY
     "SMConnectRequestNew",
     "SMLookup",
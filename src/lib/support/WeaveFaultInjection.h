@@ -66,6 +66,7 @@ typedef enum
 #endif // WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
     kFault_BDXBadBlockCounter,                  /**< Corrupt the BDX Block Counter in the BDX BlockSend or BlockEOF message about to be sent */
     kFault_BDXAllocTransfer,                    /**< Fail the allocation of a BDXTransfer object */
+    kFault_BDXAbortTransfer,                    /**< Abort a BDX transfer when a message arrives on it, as if the link to the peer was lost */
 #if WEAVE_CONFIG_ENABLE_SERVICE_DIRECTORY
     kFault_ServiceManager_ConnectRequestNew,    /**< Fail the allocation of a WeaveServiceManager::ConnectRequest */
     kFault_ServiceManager_Lookup,               /**< Fail the lookup of an endpoint id */
@@ -40,6 +40,64 @@ namespace Security {
 
 using namespace nl::Weave::Crypto;
 
+// Number of blocks encrypted together by EncryptBlocks().  The AES round
+// instructions are pipelined, so interleaving the rounds of independent
+// blocks hides most of their latency.
+enum
+{
+    kInterleavedBlockCount = 4
+};
+
+static void EncryptBlocksInterleaved(const __m128i *key, int roundCount, const uint8_t *inBlocks, uint8_t *outBlocks,
+                                     size_t numBlocks)
+{
+    __m128i block0, block1, block2, block3;
+
+    for (; numBlocks >= kInterleavedBlockCount; numBlocks -= kInterleavedBlockCount)
+    {
+        block0 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)inBlocks), key[0]);
+        block1 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)inBlocks + 1), key[0]);
+        block2 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)inBlocks + 2), key[0]);
+        block3 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)inBlocks + 3), key[0]);
+
+        for (int round = 1; round < roundCount; round++)
+        {
+            block0 = _mm_aesenc_si128(block0, key[round]);
+            block1 = _mm_aesenc_si128(block1, key[round]);
+            block2 = _mm_aesenc_si128(block2, key[round]);
+            block3 = _mm_aesenc_si128(block3, key[round]);
+        }
+
+        _mm_storeu_si128((__m128i *)outBlocks, _mm_aesenclast_si128(block0, key[roundCount]));
+        _mm_storeu_si128((__m128i *)outBlocks + 1, _mm_aesenclast_si128(block1, key[roundCount]));
+        _mm_storeu_si128((__m128i *)outBlocks + 2, _mm_aesenclast_si128(block2, key[roundCount]));
+        _mm_storeu_si128((__m128i *)outBlocks + 3, _mm_aesenclast_si128(block3, key[roundCount]));
+
+        inBlocks += kInterleavedBlockCount * sizeof(__m128i);
+        outBlocks += kInterleavedBlockCount * sizeof(__m128i);
+    }
+
+    for (; numBlocks > 0; numBlocks--)
+    {
+        block0 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)inBlocks), key[0]);
+
+        for (int round = 1; round < roundCount; round++)
+        {
+            block0 = _mm_aesenc_si128(block0, key[round]);
+        }
+
+        _mm_storeu_si128((__m128i *)outBlocks, _mm_aesenclast_si128(block0, key[roundCount]));
+
+        inBlocks += sizeof(__m128i);
+        outBlocks += sizeof(__m128i);
+    }
+
+    ClearSecretData((uint8_t *)&block0, sizeof(block0));
+    ClearSecretData((uint8_t *)&block1, sizeof(block1));
+    ClearSecretData((uint8_t *)&block2, sizeof(block2));
+    ClearSecretData((uint8_t *)&block3, sizeof(block3));
+}
+
 AES128BlockCipher::AES128BlockCipher()
 {
     memset(&mKey, 0, sizeof(mKey));
@@ -108,6 +166,11 @@ void AES128BlockCipherEnc::EncryptBlock(const uint8_t *inBlock, uint8_t *outBloc
     ClearSecretData((uint8_t *)&block, sizeof(block));
 }
 
+void AES128BlockCipherEnc::EncryptBlocks(const uint8_t *inBlocks, uint8_t *outBlocks, size_t numBlocks)
+{
+    EncryptBlocksInterleaved(mKey, kRoundCount, inBlocks, outBlocks, numBlocks);
+}
+
 void AES128BlockCipherDec::SetKey(const uint8_t *key)
 {
     __m128i tmp;
@@ -234,6 +297,11 @@ void AES256BlockCipherEnc::EncryptBlock(const uint8_t *inBlock, uint8_t *outBloc
     ClearSecretData((uint8_t *)&block, sizeof(block));
 }
 
+void AES256BlockCipherEnc::EncryptBlocks(const uint8_t *inBlocks, uint8_t *outBlocks, size_t numBlocks)
+{
+    EncryptBlocksInterleaved(mKey, kRoundCount, inBlocks, outBlocks, numBlocks);
+}
+
 void AES256BlockCipherDec::SetKey(const uint8_t *key)
 {
     __m128i tmp;
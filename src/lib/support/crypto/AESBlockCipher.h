@@ -105,6 +105,7 @@ class NL_DLL_EXPORT AES128BlockCipherEnc : public AES128BlockCipher
 public:
     void SetKey(const uint8_t *key);
     void EncryptBlock(const uint8_t *inBlock, uint8_t *outBlock);
+    void EncryptBlocks(const uint8_t *inBlocks, uint8_t *outBlocks, size_t numBlocks);
 };
 
 class NL_DLL_EXPORT AES128BlockCipherDec : public AES128BlockCipher
@@ -151,6 +152,7 @@ class NL_DLL_EXPORT AES256BlockCipherEnc : public AES256BlockCipher
 public:
     void SetKey(const uint8_t *key);
     void EncryptBlock(const uint8_t *inBlock, uint8_t *outBlock);
+    void EncryptBlocks(const uint8_t *inBlocks, uint8_t *outBlocks, size_t numBlocks);
 };
 
 class NL_DLL_EXPORT AES256BlockCipherDec : public AES256BlockCipher
@@ -160,6 +162,25 @@ public:
     void DecryptBlock(const uint8_t *inBlock, uint8_t *outBlock);
 };
 
+#if !WEAVE_CONFIG_AES_IMPLEMENTATION_AESNI
+
+// Implementations that cannot encrypt several independent blocks in parallel
+// encrypt them one at a time.
+
+inline void AES128BlockCipherEnc::EncryptBlocks(const uint8_t *inBlocks, uint8_t *outBlocks, size_t numBlocks)
+{
+    for (size_t i = 0; i < numBlocks; i++)
+        EncryptBlock(inBlocks + i * kBlockLength, outBlocks + i * kBlockLength);
+}
+
+inline void AES256BlockCipherEnc::EncryptBlocks(const uint8_t *inBlocks, uint8_t *outBlocks, size_t numBlocks)
+{
+    for (size_t i = 0; i < numBlocks; i++)
+        EncryptBlock(inBlocks + i * kBlockLength, outBlocks + i * kBlockLength);
+}
+
+#endif // !WEAVE_CONFIG_AES_IMPLEMENTATION_AESNI
+
 } // namespace Security
 } // namespace Platform
 } // namespace Weave
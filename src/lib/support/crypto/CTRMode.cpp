@@ -88,45 +88,107 @@ void CTRMode<BlockCipher>::SetWeaveMessageCounter(uint64_t sendingNodeId, uint32
     Counter[15] = 0;
 }
 
+// XOR a run of whole blocks a word at a time.
+static void XORBlocks(const uint8_t *inData, const uint8_t *keyStream, uint8_t *outData, size_t len)
+{
+    uint64_t data, key;
+
+    for (size_t i = 0; i < len; i += sizeof(uint64_t))
+    {
+        memcpy(&data, inData + i, sizeof(data));
+        memcpy(&key, keyStream + i, sizeof(key));
+        data ^= key;
+        memcpy(outData + i, &data, sizeof(data));
+    }
+}
+
 template <class BlockCipher>
 void CTRMode<BlockCipher>::EncryptData(const uint8_t *inData, uint16_t dataLen, uint8_t *outData)
 {
     // Index to next byte of encrypted counter to be used.
     uint32_t encryptedCounterIndex = mMsgIndex % kCounterLength;
+    uint8_t counterBlocks[kBulkBlockCount * kCounterLength];
+    uint8_t keyStream[kBulkBlockCount * kCounterLength];
+    uint32_t bulkLen;
 
-    // For each byte of input data...
-    for (uint16_t dataIndex = 0; dataIndex < dataLen && mMsgIndex < UINT32_MAX; dataIndex++, mMsgIndex++)
+    // The message size is at most UINT32_MAX.
+    if (dataLen > UINT32_MAX - mMsgIndex)
     {
-        // If we need more encrypted counter bytes...
-        if (encryptedCounterIndex == 0)
-        {
-            // Encrypt the next counter value.
-            mBlockCipher.EncryptBlock(Counter, mEncryptedCounter);
-
-            // Bump the counter. Since the message size is at most UINT32_MAX (and the counter counts blocks)
-            // we will never need to update more than the four least-significant bytes.
-            Counter[kCounterLength-1]++;
-            if (Counter[kCounterLength-1] == 0)
-            {
-                Counter[kCounterLength-2]++;
-                if (Counter[kCounterLength-2] == 0)
-                {
-                    Counter[kCounterLength-3]++;
-                    if (Counter[kCounterLength-3] == 0)
-                    {
-                        Counter[kCounterLength-4]++;
-                    }
-                }
-            }
-        }
+        dataLen = (uint16_t) (UINT32_MAX - mMsgIndex);
+    }
 
-        // XOR the data with the corresponding byte of the encrypted counter.
-        outData[dataIndex] = inData[dataIndex] ^ mEncryptedCounter[encryptedCounterIndex];
+    // Use up the encrypted counter bytes left over by the previous call.
+    while (dataLen > 0 && encryptedCounterIndex != 0)
+    {
+        *outData++ = *inData++ ^ mEncryptedCounter[encryptedCounterIndex];
 
-        // Bump the counter index.
         encryptedCounterIndex++;
         if (encryptedCounterIndex == kCounterLength)
             encryptedCounterIndex = 0;
+
+        dataLen--;
+        mMsgIndex++;
+    }
+
+    // Encrypt whole blocks in bulk, passing several counter values to the block cipher at once.
+    while (dataLen >= kCounterLength)
+    {
+        uint32_t numBlocks = dataLen / kCounterLength;
+
+        if (numBlocks > kBulkBlockCount)
+            numBlocks = kBulkBlockCount;
+
+        for (uint32_t i = 0; i < numBlocks; i++)
+        {
+            memcpy(counterBlocks + i * kCounterLength, Counter, kCounterLength);
+            IncrementCounter();
+        }
+
+        bulkLen = numBlocks * kCounterLength;
+
+        mBlockCipher.EncryptBlocks(counterBlocks, keyStream, numBlocks);
+        XORBlocks(inData, keyStream, outData, bulkLen);
+
+        inData += bulkLen;
+        outData += bulkLen;
+        dataLen -= bulkLen;
+        mMsgIndex += bulkLen;
+    }
+
+    // Encrypt the last, partial block, keeping the rest of the encrypted counter for the next call.
+    if (dataLen > 0)
+    {
+        mBlockCipher.EncryptBlock(Counter, mEncryptedCounter);
+        IncrementCounter();
+
+        for (uint16_t dataIndex = 0; dataIndex < dataLen; dataIndex++)
+        {
+            outData[dataIndex] = inData[dataIndex] ^ mEncryptedCounter[dataIndex];
+        }
+
+        mMsgIndex += dataLen;
+    }
+
+    ClearSecretData(keyStream, sizeof(keyStream));
+}
+
+template <class BlockCipher>
+void CTRMode<BlockCipher>::IncrementCounter()
+{
+    // Bump the counter. Since the message size is at most UINT32_MAX (and the counter counts blocks)
+    // we will never need to update more than the four least-significant bytes.
+    Counter[kCounterLength-1]++;
+    if (Counter[kCounterLength-1] == 0)
+    {
+        Counter[kCounterLength-2]++;
+        if (Counter[kCounterLength-2] == 0)
+        {
+            Counter[kCounterLength-3]++;
+            if (Counter[kCounterLength-3] == 0)
+            {
+                Counter[kCounterLength-4]++;
+            }
+        }
     }
 }
 
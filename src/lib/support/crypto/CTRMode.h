@@ -60,9 +60,17 @@ public:
     void Reset(void);
 
 private:
+    enum
+    {
+        // Number of counter blocks encrypted together when the data spans several blocks.
+        kBulkBlockCount = 4
+    };
+
     BlockCipher mBlockCipher;
     uint32_t mMsgIndex;
     uint8_t mEncryptedCounter[kCounterLength];
+
+    void IncrementCounter(void);
 };
 
 typedef CTRMode<Platform::Security::AES128BlockCipherEnc> AES128CTRMode;
@@ -100,6 +100,11 @@ WEAVE_ERROR CTR_DRBG<BlockCipher>::Reseed(const uint8_t *addData, uint16_t addDa
         uint8_t seed[kSeedLength];
     } u;
 
+#if WEAVE_CONFIG_DRBG_OUTPUT_BUFFER_SIZE > 0
+    // Discard any buffered data generated from the previous seed
+    DiscardBufferedData();
+#endif
+
     // Verify that DRBG was instantiated
     VerifyOrExit(mEntropyFunct != NULL, err = WEAVE_ERROR_INCORRECT_STATE);
 
@@ -131,7 +136,9 @@ WEAVE_ERROR CTR_DRBG<BlockCipher>::GenerateInternal(uint8_t *outData, uint16_t o
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     uint8_t seed[kSeedLength] = { 0 };
-    uint8_t encryptedCounter[kBlockLength];
+    uint8_t counters[kBulkBlockCount * kBlockLength];
+    uint8_t encryptedCounters[kBulkBlockCount * kBlockLength];
+    uint8_t numBlocks;
     uint8_t bytesToCopy;
 
     if (addDataLen > 0)
@@ -146,21 +153,31 @@ WEAVE_ERROR CTR_DRBG<BlockCipher>::GenerateInternal(uint8_t *outData, uint16_t o
         Update(seed);
     }
 
-    for (uint16_t j = 0; j < outDataLen; j += kBlockLength)
+    for (uint16_t j = 0; j < outDataLen; j += bytesToCopy)
     {
-        // Increment counter
-        IncrementCounter();
+        // Number of blocks needed for the rest of the output, up to kBulkBlockCount
+        numBlocks = ((outDataLen - j) >= kBulkBlockCount * kBlockLength) ? kBulkBlockCount :
+                    (outDataLen - j + kBlockLength - 1) / kBlockLength;
+
+        // Increment counter for each block
+        for (uint8_t i = 0; i < numBlocks; i++)
+        {
+            IncrementCounter();
+            memcpy(counters + i * kBlockLength, mCounter, kBlockLength);
+        }
 
-        // Encrypt counter value
-        mBlockCipher.EncryptBlock(mCounter, encryptedCounter);
+        // Encrypt counter values
+        mBlockCipher.EncryptBlocks(counters, encryptedCounters, numBlocks);
 
         // Last block can be partial if outDataLen is not multiple of block size
-        bytesToCopy = (outDataLen - j >= kBlockLength) ? kBlockLength : outDataLen - j;
+        bytesToCopy = (outDataLen - j >= numBlocks * kBlockLength) ? numBlocks * kBlockLength : outDataLen - j;
 
         // Copy result
-        memcpy(outData + j, encryptedCounter, bytesToCopy);
+        memcpy(outData + j, encryptedCounters, bytesToCopy);
     }
 
+    ClearSecretData(encryptedCounters, sizeof(encryptedCounters));
+
     // DRBG update function
     Update(seed);
 
@@ -201,11 +218,76 @@ exit:
 template <class BlockCipher>
 void CTR_DRBG<BlockCipher>::Uninstantiate()
 {
+#if WEAVE_CONFIG_DRBG_OUTPUT_BUFFER_SIZE > 0
+    DiscardBufferedData();
+#endif
     mBlockCipher.Reset();
     memset(mCounter, 0, kBlockLength);
     mEntropyFunct = NULL;
 }
 
+#if WEAVE_CONFIG_DRBG_OUTPUT_BUFFER_SIZE > 0
+
+/**
+ * Generate random data, serving requests smaller than
+ * #WEAVE_CONFIG_DRBG_OUTPUT_BUFFER_SIZE from a buffer of DRBG output.
+ *
+ * The buffer is filled by a single Generate() call, so the DRBG update and
+ * any reseed happen once per fill rather than once per request.  Bytes are
+ * erased from the buffer as they are handed out, and the whole buffer is
+ * discarded when the DRBG is reseeded or uninstantiated.
+ */
+template <class BlockCipher>
+WEAVE_ERROR CTR_DRBG<BlockCipher>::GenerateBuffered(uint8_t *outData, uint16_t outDataLen)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    // Verify that DRBG was instantiated
+    VerifyOrExit(mEntropyFunct != NULL, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    // Large requests gain nothing from the buffer
+    if (outDataLen >= WEAVE_CONFIG_DRBG_OUTPUT_BUFFER_SIZE)
+        ExitNow(err = Generate(outData, outDataLen));
+
+    TakeBufferedData(outData, outDataLen);
+
+    if (outDataLen > 0)
+    {
+        err = Generate(mOutputBuffer, WEAVE_CONFIG_DRBG_OUTPUT_BUFFER_SIZE);
+        SuccessOrExit(err);
+
+        mOutputBufferLen = WEAVE_CONFIG_DRBG_OUTPUT_BUFFER_SIZE;
+
+        TakeBufferedData(outData, outDataLen);
+    }
+
+exit:
+    return err;
+}
+
+template <class BlockCipher>
+void CTR_DRBG<BlockCipher>::TakeBufferedData(uint8_t *&outData, uint16_t &outDataLen)
+{
+    uint8_t *bufferedData = mOutputBuffer + WEAVE_CONFIG_DRBG_OUTPUT_BUFFER_SIZE - mOutputBufferLen;
+    uint16_t count = (outDataLen < mOutputBufferLen) ? outDataLen : mOutputBufferLen;
+
+    memcpy(outData, bufferedData, count);
+    ClearSecretData(bufferedData, count);
+
+    mOutputBufferLen -= count;
+    outData += count;
+    outDataLen -= count;
+}
+
+template <class BlockCipher>
+void CTR_DRBG<BlockCipher>::DiscardBufferedData()
+{
+    ClearSecretData(mOutputBuffer, WEAVE_CONFIG_DRBG_OUTPUT_BUFFER_SIZE);
+    mOutputBufferLen = 0;
+}
+
+#endif // WEAVE_CONFIG_DRBG_OUTPUT_BUFFER_SIZE > 0
+
 template <class BlockCipher>
 void CTR_DRBG<BlockCipher>::Update(const uint8_t *data)
 {
@@ -45,6 +45,10 @@
     #define WEAVE_CONFIG_DRBG_MAX_ENTROPY_LENGTH     64
 #endif
 
+#if WEAVE_CONFIG_DRBG_OUTPUT_BUFFER_SIZE > UINT16_MAX
+#error "INVALID WEAVE CONFIG: WEAVE_CONFIG_DRBG_OUTPUT_BUFFER_SIZE must not exceed UINT16_MAX."
+#endif
+
 namespace nl {
 namespace Weave {
 namespace Platform {
@@ -82,14 +86,28 @@ public:
                          const uint8_t *addData = NULL, uint16_t addDataLen = 0);
     void Uninstantiate(void);
 
+#if WEAVE_CONFIG_DRBG_OUTPUT_BUFFER_SIZE > 0
+    WEAVE_ERROR GenerateBuffered(uint8_t *outData, uint16_t outDataLen);
+#endif
+
     WEAVE_ERROR SelfTest(int verbose);
 
 private:
+    enum
+    {
+        // Number of counter blocks encrypted together by Generate().
+        kBulkBlockCount        = 4,
+    };
+
     EntropyFunct mEntropyFunct;
     BlockCipher mBlockCipher;
     uint32_t mReseedCounter;
     uint16_t mEntropyLen;
     uint8_t mCounter[kBlockLength];
+#if WEAVE_CONFIG_DRBG_OUTPUT_BUFFER_SIZE > 0
+    uint8_t mOutputBuffer[WEAVE_CONFIG_DRBG_OUTPUT_BUFFER_SIZE];
+    uint16_t mOutputBufferLen;          // Number of unused bytes at the end of mOutputBuffer
+#endif
 
     void Update(const uint8_t *data);
     void IncrementCounter(void);
@@ -97,6 +115,10 @@ private:
                             const uint8_t *data1 = NULL, uint16_t data1Len = 0);
     WEAVE_ERROR GenerateInternal(uint8_t *outData, uint16_t outDataLen,
                                  const uint8_t *addData, uint16_t addDataLen);
+#if WEAVE_CONFIG_DRBG_OUTPUT_BUFFER_SIZE > 0
+    void TakeBufferedData(uint8_t *&outData, uint16_t &outDataLen);
+    void DiscardBufferedData(void);
+#endif
 };
 
 typedef CTR_DRBG<Platform::Security::AES128BlockCipherEnc> AES128CTRDRBG;
@@ -89,12 +89,19 @@ void HMAC<H>::Begin(const uint8_t *key, uint16_t keyLen)
 }
 
 template <class H>
-void HMAC<H>::AddData(const uint8_t *msgData, uint16_t dataLen)
+void HMAC<H>::AddData(const uint8_t *msgData, uint32_t dataLen)
 {
     // Add a chunk of data to the inner hash.
     mHash.AddData(msgData, dataLen);
 }
 
+template <class H>
+void HMAC<H>::AddData(const System::PacketBuffer *buf)
+{
+    // Add the data of a chain of buffers to the inner hash.
+    mHash.AddData(buf);
+}
+
 #if WEAVE_WITH_OPENSSL
 template <class H>
 void HMAC<H>::AddData(const BIGNUM& num)
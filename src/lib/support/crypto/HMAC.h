@@ -54,7 +54,8 @@ public:
     ~HMAC(void);
 
     void Begin(const uint8_t *keyData, uint16_t keyLen);
-    void AddData(const uint8_t *msgData, uint16_t dataLen);
+    void AddData(const uint8_t *msgData, uint32_t dataLen);
+    void AddData(const System::PacketBuffer *buf);
 #if WEAVE_WITH_OPENSSL
     void AddData(const BIGNUM& num);
 #endif
@@ -37,6 +37,9 @@ namespace Security {
 
 #if WEAVE_CONFIG_HASH_IMPLEMENTATION_MINCRYPT
 
+// Largest length passed to mincrypt in one call.
+static const uint32_t kMaxUpdateLength = 0x40000000;
+
 SHA1::SHA1()
 {
 }
@@ -50,9 +53,16 @@ void SHA1::Begin()
     SHA_init(&mSHACtx);
 }
 
-void SHA1::AddData(const uint8_t *data, uint16_t dataLen)
+void SHA1::AddData(const uint8_t *data, uint32_t dataLen)
 {
-    SHA_update(&mSHACtx, data, dataLen);
+    while (dataLen > kMaxUpdateLength)
+    {
+        SHA_update(&mSHACtx, data, kMaxUpdateLength);
+        data += kMaxUpdateLength;
+        dataLen -= kMaxUpdateLength;
+    }
+
+    SHA_update(&mSHACtx, data, (int) dataLen);
 }
 
 void SHA1::Finish(uint8_t *hashBuf)
@@ -79,9 +89,16 @@ void SHA256::Begin()
     SHA256_init(&mSHACtx);
 }
 
-void SHA256::AddData(const uint8_t *data, uint16_t dataLen)
+void SHA256::AddData(const uint8_t *data, uint32_t dataLen)
 {
-    SHA256_update(&mSHACtx, data, dataLen);
+    while (dataLen > kMaxUpdateLength)
+    {
+        SHA256_update(&mSHACtx, data, kMaxUpdateLength);
+        data += kMaxUpdateLength;
+        dataLen -= kMaxUpdateLength;
+    }
+
+    SHA256_update(&mSHACtx, data, (int) dataLen);
 }
 
 void SHA256::Finish(uint8_t *hashBuf)
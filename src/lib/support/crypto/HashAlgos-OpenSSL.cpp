@@ -50,7 +50,7 @@ void SHA1::Begin()
     SHA1_Init(&mSHACtx);
 }
 
-void SHA1::AddData(const uint8_t *data, uint16_t dataLen)
+void SHA1::AddData(const uint8_t *data, uint32_t dataLen)
 {
     SHA1_Update(&mSHACtx, data, dataLen);
 }
@@ -78,7 +78,7 @@ void SHA256::Begin()
     SHA256_Init(&mSHACtx);
 }
 
-void SHA256::AddData(const uint8_t *data, uint16_t dataLen)
+void SHA256::AddData(const uint8_t *data, uint32_t dataLen)
 {
     SHA256_Update(&mSHACtx, data, dataLen);
 }
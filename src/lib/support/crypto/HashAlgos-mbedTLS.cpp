@@ -55,7 +55,7 @@ void SHA1::Begin()
     VerifyOrDie(res == 0);
 }
 
-void SHA1::AddData(const uint8_t * data, uint16_t dataLen)
+void SHA1::AddData(const uint8_t * data, uint32_t dataLen)
 {
     int res = mbedtls_sha1_update_ret(&mSHACtx, data, (size_t)dataLen);
     VerifyOrDie(res == 0);
@@ -88,7 +88,7 @@ void SHA256::Begin()
     VerifyOrDie(res == 0);
 }
 
-void SHA256::AddData(const uint8_t * data, uint16_t dataLen)
+void SHA256::AddData(const uint8_t * data, uint32_t dataLen)
 {
     int res = mbedtls_sha256_update_ret(&mSHACtx, data, (size_t)dataLen);
     VerifyOrDie(res == 0);
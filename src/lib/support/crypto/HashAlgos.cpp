@@ -0,0 +1,64 @@
+/*
+ *
+ *    Copyright (c) 2018 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements the parts of the SHA1 and SHA256 hash functions
+ *      that are common to all the hash implementations.
+ *
+ */
+
+#include "WeaveCrypto.h"
+#include "HashAlgos.h"
+#include <SystemLayer/SystemPacketBuffer.h>
+
+namespace nl {
+namespace Weave {
+namespace Platform {
+namespace Security {
+
+/**
+ * Add the data of a chain of PacketBuffers to the hash.
+ *
+ * @param[in] buf   The first buffer of the chain; may be NULL.
+ */
+void SHA1::AddData(const System::PacketBuffer *buf)
+{
+    for (; buf != NULL; buf = buf->Next())
+    {
+        AddData(buf->Start(), buf->DataLength());
+    }
+}
+
+/**
+ * Add the data of a chain of PacketBuffers to the hash.
+ *
+ * @param[in] buf   The first buffer of the chain; may be NULL.
+ */
+void SHA256::AddData(const System::PacketBuffer *buf)
+{
+    for (; buf != NULL; buf = buf->Next())
+    {
+        AddData(buf->Start(), buf->DataLength());
+    }
+}
+
+} /* namespace Security */
+} /* namespace Platform */
+} /* namespace Weave */
+} /* namespace nl */
@@ -78,6 +78,17 @@
 #include WEAVE_HASH_ALGOS_PLATFORM_INCLUDE
 #endif // WEAVE_CONFIG_HASH_IMPLEMENTATION_PLATFORM
 
+// forward declaration of the PacketBuffer class used within the header.
+namespace nl {
+namespace Weave {
+namespace System {
+
+class PacketBuffer;
+
+} // namespace System
+} // namespace Weave
+} // namespace nl
+
 namespace nl {
 namespace Weave {
 namespace Platform {
@@ -96,7 +107,8 @@ public:
     ~SHA1(void);
 
     void Begin(void);
-    void AddData(const uint8_t *data, uint16_t dataLen);
+    void AddData(const uint8_t *data, uint32_t dataLen);
+    void AddData(const System::PacketBuffer *buf);
 #if WEAVE_WITH_OPENSSL
     void AddData(const BIGNUM& num);
 #endif
@@ -128,7 +140,8 @@ public:
     ~SHA256(void);
 
     void Begin(void);
-    void AddData(const uint8_t *data, uint16_t dataLen);
+    void AddData(const uint8_t *data, uint32_t dataLen);
+    void AddData(const System::PacketBuffer *buf);
 #if WEAVE_WITH_OPENSSL
     void AddData(const BIGNUM& num);
 #endif
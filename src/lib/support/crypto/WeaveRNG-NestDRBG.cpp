@@ -110,7 +110,11 @@ WEAVE_ERROR InitSecureRandomDataSource(EntropyFunct entropyFunct, uint16_t entro
 
 WEAVE_ERROR GetSecureRandomData(uint8_t *buf, uint16_t len)
 {
+#if WEAVE_CONFIG_DRBG_OUTPUT_BUFFER_SIZE > 0
+    return CtrDRBG.GenerateBuffered(buf, len);
+#else
     return CtrDRBG.Generate(buf, len);
+#endif // WEAVE_CONFIG_DRBG_OUTPUT_BUFFER_SIZE > 0
 }
 
 #endif // WEAVE_CONFIG_RNG_IMPLEMENTATION_NESTDRBG
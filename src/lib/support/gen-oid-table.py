@@ -304,26 +304,44 @@ print("")
 
 print("extern const OIDTableEntry sOIDTable[];")
 print("extern const OIDNameTableEntry sOIDNameTable[];")
+print("extern const uint8_t sOIDEncodedIndex[];")
 print("extern const size_t sOIDTableSize;")
 print("")
 
+# The OID and OID name tables are emitted in order of enum value, allowing them to be searched by bisection.
+# The encoded index lists the positions of the OID table entries in order of encoded length, then encoded
+# value, allowing an encoded OID to be searched by bisection as well.
+categoryEnums = dict(oidCategories)
+sortedOIDs = sorted(oids, key=lambda o: categoryEnums[o[0]] + o[2])
+encodedIndex = sorted(range(len(sortedOIDs)), key=lambda i: (len(encodeOID(sortedOIDs[i][3])), encodeOID(sortedOIDs[i][3])))
+
+assert len(sortedOIDs) <= 256
+
 print("#ifdef ASN1_DEFINE_OID_TABLE")
 print("")
 
-for (catName, oidName, oidEnum, oid) in oids:
+for (catName, oidName, oidEnum, oid) in sortedOIDs:
     print("static const uint8_t sOID_%s_%s[] = { %s };" % (catName, oidName, ", ".join([ "0x%02X" % (x) for x in encodeOID(oid) ])))
 print("")
 
 print("const OIDTableEntry sOIDTable[] =")
 print("{")
 oidTableSize = 0
-for (catName, oidName, oidEnum, oid) in oids:
+for (catName, oidName, oidEnum, oid) in sortedOIDs:
     print("    { kOID_%s_%s, sOID_%s_%s, sizeof(sOID_%s_%s) }," % (catName, oidName, catName, oidName, catName, oidName))
     oidTableSize += 1
 print("    { kOID_NotSpecified, NULL, 0 }")
 print("};")
 print("")
 
+print("const uint8_t sOIDEncodedIndex[] =")
+print("{")
+for i in encodedIndex:
+    (catName, oidName, oidEnum, oid) = sortedOIDs[i]
+    print("    %d, // kOID_%s_%s" % (i, catName, oidName))
+print("};")
+print("")
+
 print("const size_t sOIDTableSize = %d;" % (oidTableSize))
 print("")
 
@@ -335,7 +353,7 @@ print("")
 
 print("const OIDNameTableEntry sOIDNameTable[] =")
 print("{")
-for (catName, oidName, oidEnum, oid) in oids:
+for (catName, oidName, oidEnum, oid) in sortedOIDs:
     print("    { kOID_%s_%s, \"%s\" }," % (catName, oidName, oidName))
 print("    { kOID_NotSpecified, NULL }")
 print("};")
@@ -27,6 +27,8 @@
 #ifndef PERSISTED_STORAGE_H
 #define PERSISTED_STORAGE_H
 
+#include <stddef.h>
+
 #include <Weave/Core/WeaveError.h>
 #include <Weave/Core/WeaveConfig.h>
 
@@ -70,6 +72,29 @@ WEAVE_ERROR Read(Key aKey, uint32_t &aValue);
  */
 WEAVE_ERROR Write(Key aKey, uint32_t aValue);
 
+#if WEAVE_CONFIG_PERSISTED_STORAGE_BATCH_WRITE
+/**
+ *  @brief
+ *    Write the integer values of several keys to persistent storage
+ *    as a single transaction.
+ *    Platform is responsible for validating the keys.
+ *    Either all of the values are written or, if an error is returned,
+ *    none of them are.
+ *
+ *  Only required when WEAVE_CONFIG_PERSISTED_STORAGE_BATCH_WRITE is enabled.
+ *
+ *  @param[in] aKeys     An array of keys to persistently-stored values.
+ *  @param[in] aValues   An array of the values, one for each key.
+ *  @param[in] aCount    The number of keys and values.
+ *
+ *  @return WEAVE_ERROR_INVALID_ARGUMENT if any key is NULL
+ *          WEAVE_ERROR_INVALID_STRING_LENGTH if any key exceeds
+ *                  WEAVE_CONFIG_PERSISTED_STORAGE_MAX_KEY_LENGTH
+ *          WEAVE_NO_ERROR otherwise
+ */
+WEAVE_ERROR WriteBatch(const Key *aKeys, const uint32_t *aValues, size_t aCount);
+#endif // WEAVE_CONFIG_PERSISTED_STORAGE_BATCH_WRITE
+
 } // PersistedStorage
 } // Platform
 } // Weave
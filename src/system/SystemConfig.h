@@ -509,6 +509,29 @@ struct LwIPEvent;
 #define WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS 0
 #endif // WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS
 
+/**
+ *  @def WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
+ *
+ *  @brief
+ *      This defines whether (1) or not (0) the Weave System Layer records latency histograms for the hot paths of the Weave
+ *      stack (message encoding and decoding, exchange dispatch, handler execution, timer lateness, socket I/O dispatch and event
+ *      loop wake ups) for diagnostic purposes.
+ */
+#ifndef WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
+#define WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS 0
+#endif // WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
+
+/**
+ *  @def WEAVE_SYSTEM_CONFIG_LATENCY_STATISTICS_MAX_THREADS
+ *
+ *  @brief
+ *      The number of threads that record latencies into histograms of their own when #WEAVE_SYSTEM_CONFIG_POSIX_LOCKING is
+ *      enabled.  Threads beyond this number share a single set of histograms.
+ */
+#ifndef WEAVE_SYSTEM_CONFIG_LATENCY_STATISTICS_MAX_THREADS
+#define WEAVE_SYSTEM_CONFIG_LATENCY_STATISTICS_MAX_THREADS 4
+#endif // WEAVE_SYSTEM_CONFIG_LATENCY_STATISTICS_MAX_THREADS
+
 /**
  *  @def WEAVE_SYSTEM_CONFIG_TEST
  *
@@ -106,6 +106,9 @@ Layer::Layer()
 #if WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
     this->mHandleSelectThread = PTHREAD_NULL;
 #endif // WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
+#if WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
+    this->mWakeSelectTime = 0;
+#endif // WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 }
 
@@ -639,6 +642,14 @@ void Layer::HandleSelectResult(int aSetSize, fd_set* aReadSet, fd_set* aWriteSet
                 if (lTmp < static_cast<int>(sizeof(lBytes)))
                     break;
             }
+
+#if WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
+            // Record the time since the first wake up request that is being handled.
+            const uint64_t kWakeTime = __sync_lock_test_and_set(&this->mWakeSelectTime, 0);
+
+            if (kWakeTime != 0)
+                Stats::RecordLatency(Stats::kLatency_WakeToDispatch, Stats::GetLatencyTimestamp() - kWakeTime);
+#endif // WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
         }
     }
 
@@ -685,6 +696,12 @@ void Layer::WakeSelect()
     }
 #endif // WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
 
+#if WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
+    // Stamp the first wake up request made since the select calling thread last woke.
+    if (this->mWakeSelectTime == 0)
+        __sync_bool_compare_and_swap(&this->mWakeSelectTime, 0, Stats::GetLatencyTimestamp());
+#endif // WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
+
     // Write a single byte to the wake pipe to wake up the select call.
     const uint8_t kByte = 0;
     const ssize_t kIOResult = ::write(this->mWakePipeOut, &kByte, 1);
@@ -202,6 +202,9 @@ private:
 #if WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
     pthread_t mHandleSelectThread;
 #endif // WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
+#if WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
+    uint64_t mWakeSelectTime;
+#endif // WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
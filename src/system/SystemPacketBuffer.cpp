@@ -301,6 +301,58 @@ void PacketBuffer::CompactHead()
     }
 }
 
+/**
+ * Move just enough data from subsequent buffers in the chain into the current buffer to make its first bytes contiguous.
+ *
+ *  Unlike `CompactHead()`, which fills the current buffer, this method copies only the bytes needed for the current buffer to hold
+ *  at least \c aLength bytes of data, so that a fixed-size header can be parsed in place without copying the rest of the chain.
+ *  The data within the current buffer is moved to the front of the buffer only if there is not enough space after it.  Subsequent
+ *  buffers that are moved into the current buffer in their entirety are removed from the chain and freed.
+ *
+ *  @param[in] aLength - number of bytes required in the current buffer.
+ *
+ *  @return \c true if the current buffer holds at least \c aLength bytes of data on return, \c false if the chain holds fewer
+ *          bytes or they do not fit in the current buffer.
+ */
+bool PacketBuffer::PullUpHead(uint16_t aLength)
+{
+    uint8_t* const kStart = reinterpret_cast<uint8_t*>(this) + WEAVE_SYSTEM_PACKETBUFFER_HEADER_SIZE;
+
+    if (this->len >= aLength)
+        return true;
+
+    if (this->tot_len < aLength || aLength > this->AllocSize())
+        return false;
+
+    if (aLength - this->len > this->AvailableDataLength())
+    {
+        memmove(kStart, this->payload, this->len);
+        this->payload = kStart;
+    }
+
+    while (this->len < aLength)
+    {
+        PacketBuffer& lNextPacket = *static_cast<PacketBuffer*>(this->next);
+        VerifyOrDieWithMsg(lNextPacket.ref == 1, WeaveSystemLayer, "next buffer %p is not exclusive to this chain", &lNextPacket);
+
+        uint16_t lMoveLength = aLength - this->len;
+        if (lMoveLength > lNextPacket.len)
+            lMoveLength = lNextPacket.len;
+
+        memcpy(static_cast<uint8_t*>(this->payload) + this->len, lNextPacket.payload, lMoveLength);
+
+        lNextPacket.payload = (uint8_t *) lNextPacket.payload + lMoveLength;
+        this->len += lMoveLength;
+        lNextPacket.len -= lMoveLength;
+        lNextPacket.tot_len -= lMoveLength;
+
+        if (lNextPacket.len == 0)
+            this->next = this->FreeHead(&lNextPacket);
+    }
+
+    return true;
+}
+
 /**
  * Adjust the current buffer to indicate the amount of data consumed.
  *
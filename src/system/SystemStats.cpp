@@ -31,6 +31,10 @@
 // Include local headers
 #include <SystemLayer/SystemTimer.h>
 
+#if WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
+#include <SystemLayer/SystemClock.h>
+#endif // WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
+
 #include <string.h>
 
 namespace nl {
@@ -145,6 +149,139 @@ bool Difference(Snapshot &result, Snapshot &after, Snapshot &before)
     return leak;
 }
 
+#if WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
+
+static const Label sLatencyStrings[kLatency_NumPoints] =
+{
+    "MessageLayer_EncodeMessage",
+    "MessageLayer_DecodeMessage",
+    "ExchangeMgr_DispatchMessage",
+    "ExchangeMgr_HandlerExecution",
+    "SystemLayer_TimerLateness",
+    "InetLayer_SocketIODispatch",
+    "SystemLayer_WakeToDispatch",
+};
+
+#if WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
+
+// Each thread records into a set of histograms of its own, so recording needs neither a lock nor atomic operations.  Threads
+// beyond the first WEAVE_SYSTEM_CONFIG_LATENCY_STATISTICS_MAX_THREADS share the last set, at the risk of losing the odd update.
+static LatencyHistogram sLatencyHistograms[WEAVE_SYSTEM_CONFIG_LATENCY_STATISTICS_MAX_THREADS][kLatency_NumPoints];
+static unsigned int sLatencyNumThreads;
+static __thread LatencyHistogram *sThreadLatencyHistograms;
+
+static LatencyHistogram *GetThreadLatencyHistograms(void)
+{
+    if (sThreadLatencyHistograms == NULL)
+    {
+        unsigned int lIndex = __sync_fetch_and_add(&sLatencyNumThreads, 1);
+
+        if (lIndex >= WEAVE_SYSTEM_CONFIG_LATENCY_STATISTICS_MAX_THREADS)
+            lIndex = WEAVE_SYSTEM_CONFIG_LATENCY_STATISTICS_MAX_THREADS - 1;
+
+        sThreadLatencyHistograms = sLatencyHistograms[lIndex];
+    }
+
+    return sThreadLatencyHistograms;
+}
+
+#define LATENCY_NUM_HISTOGRAM_SETS WEAVE_SYSTEM_CONFIG_LATENCY_STATISTICS_MAX_THREADS
+
+#else // WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
+
+static LatencyHistogram sLatencyHistograms[1][kLatency_NumPoints];
+
+static inline LatencyHistogram *GetThreadLatencyHistograms(void)
+{
+    return sLatencyHistograms[0];
+}
+
+#define LATENCY_NUM_HISTOGRAM_SETS 1
+
+#endif // WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
+
+const Label *GetLatencyStrings(void)
+{
+    return sLatencyStrings;
+}
+
+/**
+ * Returns a timestamp for measuring latencies, in microseconds since an arbitrary epoch.
+ */
+uint64_t GetLatencyTimestamp(void)
+{
+    return Platform::Layer::GetClock_MonotonicHiRes();
+}
+
+/**
+ * Records a latency in the histogram of the given point for the calling thread.
+ *
+ * @param[in] aPoint        The point at which the latency was measured.
+ * @param[in] aLatencyUS    The latency, in microseconds.
+ */
+void RecordLatency(LatencyPoint aPoint, uint64_t aLatencyUS)
+{
+    LatencyHistogram &lHistogram = GetThreadLatencyHistograms()[aPoint];
+    unsigned int lBucket = 0;
+
+    if (aLatencyUS != 0)
+    {
+        lBucket = 64 - __builtin_clzll(aLatencyUS);
+
+        if (lBucket >= kLatency_NumBuckets)
+            lBucket = kLatency_NumBuckets - 1;
+    }
+
+    lHistogram.mCount++;
+    lHistogram.mTotalUS += aLatencyUS;
+    lHistogram.mBuckets[lBucket]++;
+
+    // The longest latency saturates at the range of its field.
+    if (aLatencyUS > UINT32_MAX)
+        aLatencyUS = UINT32_MAX;
+
+    if (lHistogram.mMaxUS < aLatencyUS)
+        lHistogram.mMaxUS = static_cast<uint32_t>(aLatencyUS);
+}
+
+/**
+ * Updates a LatencySnapshot instance with the latencies recorded by all threads.
+ *
+ * @param[in] aSnapshot     The LatencySnapshot to be updated.
+ */
+void UpdateLatencySnapshot(LatencySnapshot &aSnapshot)
+{
+    memset(&aSnapshot, 0, sizeof(aSnapshot));
+
+    for (int i = 0; i < LATENCY_NUM_HISTOGRAM_SETS; i++)
+    {
+        for (int j = 0; j < kLatency_NumPoints; j++)
+        {
+            const LatencyHistogram &lFrom = sLatencyHistograms[i][j];
+            LatencyHistogram &lTo = aSnapshot.mHistograms[j];
+
+            lTo.mCount += lFrom.mCount;
+            lTo.mTotalUS += lFrom.mTotalUS;
+
+            if (lTo.mMaxUS < lFrom.mMaxUS)
+                lTo.mMaxUS = lFrom.mMaxUS;
+
+            for (int k = 0; k < kLatency_NumBuckets; k++)
+                lTo.mBuckets[k] += lFrom.mBuckets[k];
+        }
+    }
+}
+
+/**
+ * Discards the latencies recorded by all threads.
+ */
+void ResetLatency(void)
+{
+    memset(sLatencyHistograms, 0, sizeof(sLatencyHistograms));
+}
+
+#endif // WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
+
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP && LWIP_STATS && MEMP_STATS
 void UpdateLwipPbufCounts(void)
 {
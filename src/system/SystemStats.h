@@ -134,6 +134,75 @@ void UpdateLwipPbufCounts(void);
 typedef const char *Label;
 const Label *GetStrings(void);
 
+#if WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
+
+enum LatencyPoint
+{
+    kLatency_MessageEncode,         ///< WeaveMessageLayer::EncodeMessage()
+    kLatency_MessageDecode,         ///< WeaveMessageLayer::DecodeMessage()
+    kLatency_ExchangeDispatch,      ///< WeaveExchangeManager::DispatchMessage(), including the handler
+    kLatency_HandlerExecution,      ///< The message handler of an exchange or unsolicited message handler
+    kLatency_TimerLateness,         ///< Time from the expiry of a timer to its callback (millisecond resolution)
+    kLatency_SocketIODispatch,      ///< Handling of the pending socket I/O of the Inet Layer endpoints
+    kLatency_WakeToDispatch,        ///< Time from a wake up request to the event loop handling it
+
+    kLatency_NumPoints
+};
+
+enum
+{
+    /**
+     *  Bucket 0 counts latencies under 1 microsecond and bucket N (N > 0) those in [2^(N-1), 2^N) microseconds.  The last
+     *  bucket also counts all longer latencies.
+     */
+    kLatency_NumBuckets = 24
+};
+
+/**
+ *  The distribution of the latencies recorded at one point.
+ */
+struct LatencyHistogram
+{
+    uint32_t mCount;                            ///< Number of latencies recorded
+    uint32_t mMaxUS;                            ///< Longest latency recorded, in microseconds
+    uint64_t mTotalUS;                          ///< Sum of the latencies recorded, in microseconds
+    uint32_t mBuckets[kLatency_NumBuckets];     ///< Number of latencies recorded in each bucket
+};
+
+class LatencySnapshot
+{
+public:
+
+    LatencyHistogram mHistograms[kLatency_NumPoints];
+};
+
+uint64_t GetLatencyTimestamp(void);
+void RecordLatency(LatencyPoint aPoint, uint64_t aLatencyUS);
+void UpdateLatencySnapshot(LatencySnapshot &aSnapshot);
+void ResetLatency(void);
+const Label *GetLatencyStrings(void);
+
+/**
+ *  Records the time spent in the scope of the object as a latency of the given point.
+ */
+class LatencyScope
+{
+public:
+
+    LatencyScope(LatencyPoint aPoint) : mPoint(aPoint), mStart(GetLatencyTimestamp()) { }
+    ~LatencyScope(void) { RecordLatency(mPoint, GetLatencyTimestamp() - mStart); }
+
+private:
+
+    LatencyScope(const LatencyScope &);
+    LatencyScope &operator =(const LatencyScope &);
+
+    LatencyPoint mPoint;
+    uint64_t mStart;
+};
+
+#endif // WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
+
 } // namespace Stats
 } // namespace System
 } // namespace Weave
@@ -198,4 +267,28 @@ const Label *GetStrings(void);
 
 #endif // WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS
 
+#if WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
+
+#define SYSTEM_STATS_LATENCY_SCOPE(point) \
+    nl::Weave::System::Stats::LatencyScope _systemStatsLatencyScope(point)
+
+#define SYSTEM_STATS_LATENCY_START(var) \
+    uint64_t var = nl::Weave::System::Stats::GetLatencyTimestamp()
+
+#define SYSTEM_STATS_LATENCY_RECORD(point, var) \
+    do { \
+        nl::Weave::System::Stats::RecordLatency(point, \
+                                                nl::Weave::System::Stats::GetLatencyTimestamp() - (var)); \
+    } while (0)
+
+#else // WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
+
+#define SYSTEM_STATS_LATENCY_SCOPE(point)
+
+#define SYSTEM_STATS_LATENCY_START(var)
+
+#define SYSTEM_STATS_LATENCY_RECORD(point, var)
+
+#endif // WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
+
 #endif // defined(SYSTEMSTATS_H)
@@ -267,6 +267,15 @@ void Timer::HandleComplete()
     // Atomically disarm if the value has not changed.
     VerifyOrExit(__sync_bool_compare_and_swap(&this->OnComplete, lOnComplete, NULL), );
 
+#if WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
+    {
+        const Epoch kCurrentEpoch = Timer::GetCurrentEpoch();
+
+        if (!Timer::IsEarlierEpoch(kCurrentEpoch, this->mAwakenEpoch))
+            Stats::RecordLatency(Stats::kLatency_TimerLateness, (kCurrentEpoch - this->mAwakenEpoch) * 1000);
+    }
+#endif // WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
+
     // Since this thread changed the state of OnComplete, release the timer.
     AppState = NULL;
     this->Release();
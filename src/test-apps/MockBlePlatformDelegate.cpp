@@ -16,43 +16,115 @@
  *    limitations under the License.
  */
 
+#include <string.h>
+
 #include <BleLayer/BlePlatformDelegate.h>
 #include "MockBlePlatformDelegate.h"
 
+using nl::Ble::WeaveBleUUID;
+using nl::Weave::System::PacketBuffer;
+
+MockBlePlatformDelegate::MockBlePlatformDelegate(void) :
+    mSystemLayer(NULL),
+    mLocalLayer(NULL),
+    mNumLoopbacks(0),
+    mPendingOpHead(0),
+    mNumPendingOps(0),
+    mMaxValueLength(0),
+    mHoldSubscribes(false),
+    mHasHeldSubscribe(false)
+{
+}
+
+bool MockBlePlatformDelegate::AddLoopback(nl::Weave::System::Layer *systemLayer, nl::Ble::BleLayer *localLayer, BLE_CONNECTION_OBJECT localConn,
+                                          nl::Ble::BleLayer *peerLayer, BLE_CONNECTION_OBJECT peerConn, uint16_t mtu, uint32_t latencyMs)
+{
+    if (mNumLoopbacks == kMaxLoopbacks || FindLoopback(localConn) != NULL)
+    {
+        return false;
+    }
+
+    Loopback &loopback = mLoopbacks[mNumLoopbacks++];
+
+    mSystemLayer = systemLayer;
+    mLocalLayer = localLayer;
+    loopback.PeerLayer = peerLayer;
+    loopback.LocalConn = localConn;
+    loopback.PeerConn = peerConn;
+    loopback.MTU = mtu;
+    loopback.LatencyMS = latencyMs;
+
+    return true;
+}
+
+void MockBlePlatformDelegate::RemoveLoopbacks(void)
+{
+    if (mSystemLayer != NULL)
+    {
+        mSystemLayer->CancelTimer(HandleOpTimer, this);
+    }
+
+    for (; mNumPendingOps > 0; mNumPendingOps--)
+    {
+        PacketBuffer::Free(mPendingOps[mPendingOpHead].Buf);
+        mPendingOpHead = (mPendingOpHead + 1) % kMaxPendingOps;
+    }
+
+    if (mHasHeldSubscribe)
+    {
+        PacketBuffer::Free(mHeldSubscribe.Buf);
+        mHasHeldSubscribe = false;
+    }
+
+    mPendingOpHead = 0;
+    mNumLoopbacks = 0;
+    mMaxValueLength = 0;
+    mHoldSubscribes = false;
+}
+
+const MockBlePlatformDelegate::Loopback *MockBlePlatformDelegate::FindLoopback(BLE_CONNECTION_OBJECT connObj) const
+{
+    for (uint8_t i = 0; i < mNumLoopbacks; i++)
+    {
+        if (mLoopbacks[i].LocalConn == connObj)
+        {
+            return &mLoopbacks[i];
+        }
+    }
+
+    return NULL;
+}
+
 bool MockBlePlatformDelegate::SubscribeCharacteristic(BLE_CONNECTION_OBJECT connObj, const nl::Ble::WeaveBleUUID *svcId, const nl::Ble::WeaveBleUUID *charId)
 {
-    // TODO mock implementation
-    return false;
+    return QueueOp(connObj, kOp_Subscribe, charId, NULL);
 }
 
 bool MockBlePlatformDelegate::UnsubscribeCharacteristic(BLE_CONNECTION_OBJECT connObj, const nl::Ble::WeaveBleUUID *svcId, const nl::Ble::WeaveBleUUID *charId)
 {
-    // TODO mock implementation
-    return false;
+    return QueueOp(connObj, kOp_Unsubscribe, charId, NULL);
 }
 
 bool MockBlePlatformDelegate::CloseConnection(BLE_CONNECTION_OBJECT connObj)
 {
-    // TODO mock implementation
-    return false;
+    return (FindLoopback(connObj) != NULL);
 }
 
 uint16_t MockBlePlatformDelegate::GetMTU(BLE_CONNECTION_OBJECT connObj) const
 {
-    // TODO mock implementation
-    return 0;
+    const Loopback *loopback = FindLoopback(connObj);
+
+    return (loopback != NULL) ? loopback->MTU : 0;
 }
 
 bool MockBlePlatformDelegate::SendIndication(BLE_CONNECTION_OBJECT connObj, const nl::Ble::WeaveBleUUID *svcId, const nl::Ble::WeaveBleUUID *charId, nl::Weave::System::PacketBuffer *pBuf)
 {
-    // TODO mock implementation
-    return false;
+    return QueueOp(connObj, kOp_Indication, charId, pBuf);
 }
 
 bool MockBlePlatformDelegate::SendWriteRequest(BLE_CONNECTION_OBJECT connObj, const nl::Ble::WeaveBleUUID *svcId, const nl::Ble::WeaveBleUUID *charId, nl::Weave::System::PacketBuffer *pBuf)
 {
-    // TODO mock implementation
-    return false;
+    return QueueOp(connObj, kOp_Write, charId, pBuf);
 }
 
 bool MockBlePlatformDelegate::SendReadRequest(BLE_CONNECTION_OBJECT connObj, const nl::Ble::WeaveBleUUID *svcId, const nl::Ble::WeaveBleUUID *charId, nl::Weave::System::PacketBuffer *pBuf)
@@ -66,3 +138,155 @@ bool MockBlePlatformDelegate::SendReadResponse(BLE_CONNECTION_OBJECT connObj, BL
     // TODO mock implementation
     return false;
 }
+
+bool MockBlePlatformDelegate::QueueOp(BLE_CONNECTION_OBJECT connObj, OpType type, const nl::Ble::WeaveBleUUID *charId, nl::Weave::System::PacketBuffer *pBuf)
+{
+    const Loopback *loopback = FindLoopback(connObj);
+    PacketBuffer *copy = NULL;
+    bool retval = false;
+
+    if (loopback == NULL || mNumPendingOps == kMaxPendingOps)
+    {
+        goto exit;
+    }
+
+    // Copy the characteristic value, as a platform with its own transmit buffers would; the Weave stack reuses the
+    // sent buffer for the next fragment of the message.
+    if (pBuf != NULL)
+    {
+        // A characteristic value must fit in one ATT operation, after its 3-byte header.
+        if (pBuf->DataLength() + 3 > loopback->MTU)
+        {
+            goto exit;
+        }
+
+        if (pBuf->DataLength() > mMaxValueLength)
+        {
+            mMaxValueLength = pBuf->DataLength();
+        }
+
+        copy = PacketBuffer::NewWithAvailableSize(pBuf->DataLength());
+        if (copy == NULL)
+        {
+            goto exit;
+        }
+
+        memcpy(copy->Start(), pBuf->Start(), pBuf->DataLength());
+        copy->SetDataLength(pBuf->DataLength());
+    }
+
+    {
+        PendingOp op;
+
+        op.LoopbackIndex = static_cast<uint8_t>(loopback - mLoopbacks);
+        op.Type = type;
+        op.CharId = *charId;
+        op.Buf = copy;
+        op.DueTimeMS = nl::Weave::System::Layer::GetClock_MonotonicMS() + loopback->LatencyMS;
+
+        if (type == kOp_Subscribe && mHoldSubscribes && !mHasHeldSubscribe)
+        {
+            mHeldSubscribe = op;
+            mHasHeldSubscribe = true;
+        }
+        else
+        {
+            EnqueueOp(op);
+        }
+    }
+
+    retval = true;
+
+exit:
+    if (pBuf != NULL)
+    {
+        PacketBuffer::Free(pBuf);
+    }
+
+    return retval;
+}
+
+void MockBlePlatformDelegate::EnqueueOp(const PendingOp &op)
+{
+    mPendingOps[(mPendingOpHead + mNumPendingOps) % kMaxPendingOps] = op;
+
+    if (mNumPendingOps++ == 0)
+    {
+        StartOpTimer();
+    }
+}
+
+void MockBlePlatformDelegate::ReleaseHeldSubscribe(void)
+{
+    if (mHasHeldSubscribe && mNumPendingOps < kMaxPendingOps)
+    {
+        // Deliver the subscribe as soon as the operations sent before its release.
+        mHeldSubscribe.DueTimeMS = nl::Weave::System::Layer::GetClock_MonotonicMS();
+        mHasHeldSubscribe = false;
+
+        EnqueueOp(mHeldSubscribe);
+    }
+}
+
+void MockBlePlatformDelegate::DeliverOp(PendingOp &op)
+{
+    const Loopback &loopback = mLoopbacks[op.LoopbackIndex];
+    nl::Ble::BleLayer *peerLayer = loopback.PeerLayer;
+    BLE_CONNECTION_OBJECT peerConn = loopback.PeerConn;
+    BLE_CONNECTION_OBJECT localConn = loopback.LocalConn;
+
+    // Deliver the operation to the peer, then confirm it locally.
+    switch (op.Type)
+    {
+    case kOp_Subscribe:
+        peerLayer->HandleSubscribeReceived(peerConn, &nl::Ble::WEAVE_BLE_SVC_ID, &op.CharId);
+        mLocalLayer->HandleSubscribeComplete(localConn, &nl::Ble::WEAVE_BLE_SVC_ID, &op.CharId);
+        break;
+
+    case kOp_Unsubscribe:
+        peerLayer->HandleUnsubscribeReceived(peerConn, &nl::Ble::WEAVE_BLE_SVC_ID, &op.CharId);
+        mLocalLayer->HandleUnsubscribeComplete(localConn, &nl::Ble::WEAVE_BLE_SVC_ID, &op.CharId);
+        break;
+
+    case kOp_Write:
+        peerLayer->HandleWriteReceived(peerConn, &nl::Ble::WEAVE_BLE_SVC_ID, &op.CharId, op.Buf);
+        mLocalLayer->HandleWriteConfirmation(localConn, &nl::Ble::WEAVE_BLE_SVC_ID, &op.CharId);
+        break;
+
+    case kOp_Indication:
+        peerLayer->HandleIndicationReceived(peerConn, &nl::Ble::WEAVE_BLE_SVC_ID, &op.CharId, op.Buf);
+        mLocalLayer->HandleIndicationConfirmation(localConn, &nl::Ble::WEAVE_BLE_SVC_ID, &op.CharId);
+        break;
+    }
+}
+
+void MockBlePlatformDelegate::StartOpTimer(void)
+{
+    uint64_t now = nl::Weave::System::Layer::GetClock_MonotonicMS();
+    uint64_t due = mPendingOps[mPendingOpHead].DueTimeMS;
+
+    mSystemLayer->StartTimer((due > now) ? static_cast<uint32_t>(due - now) : 0, HandleOpTimer, this);
+}
+
+void MockBlePlatformDelegate::HandleOpTimer(nl::Weave::System::Layer *systemLayer, void *appState, nl::Weave::System::Error err)
+{
+    MockBlePlatformDelegate *delegate = static_cast<MockBlePlatformDelegate *>(appState);
+    uint64_t now = nl::Weave::System::Layer::GetClock_MonotonicMS();
+
+    // Operations fall due in the order they were sent, as long as all loopbacks share the same latency.
+    while (delegate->mNumPendingOps > 0 && delegate->mPendingOps[delegate->mPendingOpHead].DueTimeMS <= now)
+    {
+        PendingOp op = delegate->mPendingOps[delegate->mPendingOpHead];
+
+        // Dequeue before delivery, since delivery may queue further operations.
+        delegate->mPendingOpHead = (delegate->mPendingOpHead + 1) % kMaxPendingOps;
+        delegate->mNumPendingOps--;
+
+        delegate->DeliverOp(op);
+    }
+
+    if (delegate->mNumPendingOps > 0)
+    {
+        delegate->StartOpTimer();
+    }
+}
@@ -19,11 +19,33 @@
 #ifndef MOCKBLEPLATFORMDELEGATE_H_
 #define MOCKBLEPLATFORMDELEGATE_H_
 
+#include <BleLayer/BleLayer.h>
 #include <BleLayer/BlePlatformDelegate.h>
+#include <SystemLayer/SystemLayer.h>
 
 class MockBlePlatformDelegate :
     public nl::Ble::BlePlatformDelegate
 {
+public:
+    MockBlePlatformDelegate(void);
+
+    // Loop GATT operations on localConn back to peerLayer, as operations on peerConn, after a simulated one-way latency.
+    // May be called once per connection. GATT operations on connections without a loopback fail.
+    bool AddLoopback(nl::Weave::System::Layer *systemLayer, nl::Ble::BleLayer *localLayer, BLE_CONNECTION_OBJECT localConn,
+                     nl::Ble::BleLayer *peerLayer, BLE_CONNECTION_OBJECT peerConn, uint16_t mtu, uint32_t latencyMs);
+
+    // Remove all loopbacks, dropping any GATT operations not yet delivered.
+    void RemoveLoopbacks(void);
+
+    // While set, hold back the next GATT subscribe until ReleaseHeldSubscribe() is called, leaving it in flight.
+    void HoldSubscribes(bool hold) { mHoldSubscribes = hold; }
+    bool HasHeldSubscribe(void) const { return mHasHeldSubscribe; }
+    void ReleaseHeldSubscribe(void);
+
+    // Largest characteristic value written or indicated since the loopbacks were last removed.
+    uint16_t GetMaxValueLength(void) const { return mMaxValueLength; }
+
+private:
     bool SubscribeCharacteristic(BLE_CONNECTION_OBJECT connObj, const nl::Ble::WeaveBleUUID *svcId, const nl::Ble::WeaveBleUUID *charId);
     bool UnsubscribeCharacteristic(BLE_CONNECTION_OBJECT connObj, const nl::Ble::WeaveBleUUID *svcId, const nl::Ble::WeaveBleUUID *charId);
     bool CloseConnection(BLE_CONNECTION_OBJECT connObj);
@@ -32,6 +54,58 @@ class MockBlePlatformDelegate :
     bool SendWriteRequest(BLE_CONNECTION_OBJECT connObj, const nl::Ble::WeaveBleUUID *svcId, const nl::Ble::WeaveBleUUID *charId, nl::Weave::System::PacketBuffer *pBuf);
     bool SendReadRequest(BLE_CONNECTION_OBJECT connObj, const nl::Ble::WeaveBleUUID *svcId, const nl::Ble::WeaveBleUUID *charId, nl::Weave::System::PacketBuffer *pBuf);
     bool SendReadResponse(BLE_CONNECTION_OBJECT connObj, BLE_READ_REQUEST_CONTEXT requestContext, const nl::Ble::WeaveBleUUID *svcId, const nl::Ble::WeaveBleUUID *charId);
+
+    enum OpType
+    {
+        kOp_Subscribe,
+        kOp_Unsubscribe,
+        kOp_Write,
+        kOp_Indication
+    };
+
+    enum
+    {
+        kMaxLoopbacks = BLE_LAYER_NUM_BLE_ENDPOINTS,
+        kMaxPendingOps = kMaxLoopbacks * (2 * BLE_MAX_RECEIVE_WINDOW_SIZE + 4)
+    };
+
+    struct Loopback
+    {
+        nl::Ble::BleLayer *PeerLayer;
+        BLE_CONNECTION_OBJECT LocalConn;
+        BLE_CONNECTION_OBJECT PeerConn;
+        uint16_t MTU;
+        uint32_t LatencyMS;
+    };
+
+    struct PendingOp
+    {
+        uint8_t LoopbackIndex;
+        OpType Type;
+        nl::Ble::WeaveBleUUID CharId;
+        nl::Weave::System::PacketBuffer *Buf;
+        uint64_t DueTimeMS;
+    };
+
+    bool QueueOp(BLE_CONNECTION_OBJECT connObj, OpType type, const nl::Ble::WeaveBleUUID *charId, nl::Weave::System::PacketBuffer *pBuf);
+    void EnqueueOp(const PendingOp &op);
+    void DeliverOp(PendingOp &op);
+    void StartOpTimer(void);
+    static void HandleOpTimer(nl::Weave::System::Layer *systemLayer, void *appState, nl::Weave::System::Error err);
+
+    const Loopback *FindLoopback(BLE_CONNECTION_OBJECT connObj) const;
+
+    nl::Weave::System::Layer *mSystemLayer;
+    nl::Ble::BleLayer *mLocalLayer;
+    Loopback mLoopbacks[kMaxLoopbacks];
+    uint8_t mNumLoopbacks;
+    PendingOp mPendingOps[kMaxPendingOps];
+    uint8_t mPendingOpHead;
+    uint8_t mNumPendingOps;
+    uint16_t mMaxValueLength;
+    PendingOp mHeldSubscribe;
+    bool mHoldSubscribes;
+    bool mHasHeldSubscribe;
 };
 
 #endif /* MOCKBLEPLATFORMDELEGATE_H_ */
@@ -163,6 +163,38 @@ void MockSingleSourceTimeSyncClient::HandleSyncCompleted(void * const aApp, cons
 MockTimeSyncClient::MockTimeSyncClient()
 {
     memset(mContacts, 0, sizeof(mContacts));
+    memset(mLocalContacts, 0, sizeof(mLocalContacts));
+    mNumLocalContacts = 0;
+    mSyncPeriodMsec = 0;
+}
+
+WEAVE_ERROR MockTimeSyncClient::AddLocalContact(uint64_t nodeId, const IPAddress & nodeAddr)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    VerifyOrExit(mNumLocalContacts < WEAVE_CONFIG_TIME_CLIENT_MAX_NUM_CONTACTS, err = WEAVE_ERROR_NO_MEMORY);
+
+    mLocalContacts[mNumLocalContacts].mNodeId = nodeId;
+    mLocalContacts[mNumLocalContacts].mNodeAddr = nodeAddr;
+    ++mNumLocalContacts;
+
+exit:
+    return err;
+}
+
+void MockTimeSyncClient::SetSyncPeriod(uint32_t periodMsec)
+{
+    mSyncPeriodMsec = periodMsec;
+}
+
+WEAVE_ERROR MockTimeSyncClient::SyncWithLocalNodes(void)
+{
+    if (mNumLocalContacts > 0)
+    {
+        return mClient.SyncWithNodes(mNumLocalContacts, mLocalContacts);
+    }
+
+    return mClient.SyncWithNodes(1, &(mContacts[1]));
 }
 
 void MockTimeSyncClient::SetupContacts(void)
@@ -278,9 +310,10 @@ WEAVE_ERROR MockTimeSyncClient::Init(
 #endif // WEAVE_CONFIG_TIME_CLIENT_CONNECTION_FOR_SERVICE
     case kOperatingMode_AssignedLocalNodes:
         // periodically sync with local nodes using UDP connection
-        err = mClient.GetExchangeMgr()->MessageLayer->SystemLayer->StartTimer(20 * 1000, HandleSyncTimer, this);
+        err = mClient.GetExchangeMgr()->MessageLayer->SystemLayer->StartTimer((mSyncPeriodMsec > 0) ? mSyncPeriodMsec : 20 * 1000,
+            HandleSyncTimer, this);
         SuccessOrExit(err);
-        err = mClient.SyncWithNodes(1, &(mContacts[1]));
+        err = SyncWithLocalNodes();
         SuccessOrExit(err);
         break;
     default:
@@ -397,10 +430,10 @@ void MockTimeSyncClient::HandleSyncTimer(nl::Weave::System::Layer* aSystemLayer,
         break;
 #endif // WEAVE_CONFIG_TIME_CLIENT_CONNECTION_FOR_SERVICE
     case kOperatingMode_AssignedLocalNodes:
-        err = client->mClient.GetExchangeMgr()->MessageLayer->SystemLayer->StartTimer(30000,
-            HandleSyncTimer, &client->mClient);
+        err = client->mClient.GetExchangeMgr()->MessageLayer->SystemLayer->StartTimer(
+            (client->mSyncPeriodMsec > 0) ? client->mSyncPeriodMsec : 30000, HandleSyncTimer, &client->mClient);
         SuccessOrExit(err);
-        err = client->mClient.SyncWithNodes(1, &(client->mContacts[1]));
+        err = client->SyncWithLocalNodes();
         SuccessOrExit(err);
         break;
     default:
@@ -40,6 +40,12 @@ public:
 
     WEAVE_ERROR Shutdown(void);
 
+    // Add a node to sync with in local mode, in place of the default coordinator
+    WEAVE_ERROR AddLocalContact(uint64_t nodeId, const nl::Inet::IPAddress & nodeAddr);
+
+    // Set the period between syncs in local mode. Each sync aborts the one before it
+    void SetSyncPeriod(uint32_t periodMsec);
+
 private:
     nl::Weave::Profiles::Time::TimeSyncNode mClient;
 
@@ -48,6 +54,11 @@ private:
     nl::Weave::Profiles::Time::ServingNode mContacts[7];
     void SetupContacts(void);
 
+    nl::Weave::Profiles::Time::ServingNode mLocalContacts[WEAVE_CONFIG_TIME_CLIENT_MAX_NUM_CONTACTS];
+    int16_t mNumLocalContacts;
+    uint32_t mSyncPeriodMsec;
+    WEAVE_ERROR SyncWithLocalNodes(void);
+
     nl::Weave::Profiles::Time::ServingNode mServiceContact;
     void SetupServiceContact(uint64_t serviceNodeId, const char * serviceNodeAddr);
 
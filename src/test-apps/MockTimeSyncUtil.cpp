@@ -153,6 +153,25 @@ exit:
     return err;
 }
 
+WEAVE_ERROR MockTimeSync::AddLocalContact(uint64_t nodeId, const nl::Inet::IPAddress & nodeAddr)
+{
+#if WEAVE_CONFIG_TIME_ENABLE_CLIENT
+    return gMockClient.AddLocalContact(nodeId, nodeAddr);
+#else // WEAVE_CONFIG_TIME_ENABLE_CLIENT
+    return WEAVE_ERROR_NOT_IMPLEMENTED;
+#endif // WEAVE_CONFIG_TIME_ENABLE_CLIENT
+}
+
+WEAVE_ERROR MockTimeSync::SetSyncPeriod(uint32_t periodMsec)
+{
+#if WEAVE_CONFIG_TIME_ENABLE_CLIENT
+    gMockClient.SetSyncPeriod(periodMsec);
+    return WEAVE_NO_ERROR;
+#else // WEAVE_CONFIG_TIME_ENABLE_CLIENT
+    return WEAVE_ERROR_NOT_IMPLEMENTED;
+#endif // WEAVE_CONFIG_TIME_ENABLE_CLIENT
+}
+
 WEAVE_ERROR MockTimeSync::SetRole(const MockTimeSyncRole role)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
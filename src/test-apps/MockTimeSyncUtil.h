@@ -55,6 +55,14 @@ static WEAVE_ERROR SetRole(const MockTimeSyncRole role);
 // this function is called at the cmd line argument parsing stage of mock-device
 static WEAVE_ERROR SetMode(const OperatingMode mode);
 
+// Add a node for the Time Sync Client to sync with in local mode, in place of the default coordinator
+// this function is called at the cmd line argument parsing stage of mock-device
+static WEAVE_ERROR AddLocalContact(uint64_t nodeId, const nl::Inet::IPAddress & nodeAddr);
+
+// Set the period between syncs of the Time Sync Client in local mode
+// this function is called at the cmd line argument parsing stage of mock-device
+static WEAVE_ERROR SetSyncPeriod(uint32_t periodMsec);
+
 // Initialize this mock device for Time Services, according to the role that was set earlier
 static WEAVE_ERROR Init(nl::Weave::WeaveExchangeManager * const exchangeMgr, uint64_t serviceNodeId, const char * serviceNodeAddr);
 
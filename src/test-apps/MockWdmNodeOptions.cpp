@@ -45,6 +45,7 @@ MockWdmNodeOptions::MockWdmNodeOptions() :
     mEventGeneratorType(kGenerator_None),
     mTimeBetweenEvents(1000),
     mTimeBetweenLivenessCheckSec(NULL),
+    mNotifyWindowSize(1),
     mEnableDictionaryTest(false),
     mEnableRetry(false),
 #if WDM_ENABLE_SUBSCRIPTIONLESS_NOTIFICATION
@@ -57,6 +58,7 @@ MockWdmNodeOptions::MockWdmNodeOptions() :
     mWdmUpdateNumberOfRepeatedMutations(1),
     mWdmUpdateTiming(kTiming_AfterSub),
     mWdmUpdateDiscardOnError(false),
+    mWdmUpdateWindowSize(1),
     mWdmUpdateMaxNumberOfTraits(1)
 {
     static OptionDef optionDefs[] =
@@ -84,6 +86,7 @@ MockWdmNodeOptions::MockWdmNodeOptions() :
         { "wdm-init-mutual-sub",                            kNoArgument,        kToolOpt_WdmInitMutualSubscription },
         { "wdm-resp-mutual-sub",                            kNoArgument,        kToolOpt_WdmRespMutualSubscription },
         { "wdm-liveness-check-period",                      kArgumentRequired,  kToolOpt_TimeBetweenLivenessCheckSec },
+        { "wdm-notify-window",                              kArgumentRequired,  kToolOpt_WdmNotifyWindowSize },
         { "enable-retry",                                   kNoArgument,        kToolOpt_WdmEnableRetry },
         { "wdm-update-mutation",                            kArgumentRequired,  kToolOpt_WdmUpdateMutation },
         { "wdm-update-number-of-mutations",                 kArgumentRequired,  kToolOpt_WdmUpdateNumberOfMutations },
@@ -92,6 +95,7 @@ MockWdmNodeOptions::MockWdmNodeOptions() :
         { "wdm-update-conditionality",                      kArgumentRequired,  kToolOpt_WdmUpdateConditionality },
         { "wdm-update-timing",                              kArgumentRequired,  kToolOpt_WdmUpdateTiming },
         { "wdm-update-discard-on-error",                    kNoArgument,        kToolOpt_WdmUpdateDiscardOnError },
+        { "wdm-update-window",                              kArgumentRequired,  kToolOpt_WdmUpdateWindowSize },
 #endif // WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
         { }
     };
@@ -137,6 +141,9 @@ MockWdmNodeOptions::MockWdmNodeOptions() :
         "  --wdm-liveness-check-period\n"
         "       Specify the time, in seconds, between liveness check in WDM Next subscription as a publisher\n"
         "\n"
+        "  --wdm-notify-window <count>\n"
+        "       Number of notifies a publisher may have in flight on an established subscription (default 1)\n"
+        "\n"
         "  --test-case <test case id>\n"
         "       Further configure device behavior with this test case id\n"
         "\n"
@@ -233,6 +240,10 @@ MockWdmNodeOptions::MockWdmNodeOptions() :
         "\n"
         "  --wdm-update-discard-on-error\n"
         "       Tells the client to discard the paths on which SetUpdated was called in case of error\n"
+        "\n"
+        "  --wdm-update-window <count>\n"
+        "       Number of update requests the client may have in flight (default 1, at most\n"
+        "       WDM_CLIENT_MAX_UPDATE_WINDOW_SIZE)\n"
         "\n";
 
 }
@@ -443,6 +454,18 @@ bool MockWdmNodeOptions::HandleOption(const char *progName, OptionSet *optSet, i
         }
         mTimeBetweenLivenessCheckSec = strdup(arg);
         break;
+    case kToolOpt_WdmNotifyWindowSize:
+    {
+        int tmp;
+
+        if ((!ParseInt(arg, tmp)) || (tmp < 1) || (tmp > UINT8_MAX))
+        {
+            PrintArgError("%s: Invalid value specified for --wdm-notify-window: %s; min 1\n", progName, arg);
+            return false;
+        }
+        mNotifyWindowSize = static_cast<uint8_t>(tmp);
+        break;
+    }
     case kToolOpt_FinalStatus:
         if (NULL != mFinalStatus)
         {
@@ -569,6 +592,19 @@ bool MockWdmNodeOptions::HandleOption(const char *progName, OptionSet *optSet, i
         mWdmUpdateDiscardOnError = true;
         break;
     }
+    case kToolOpt_WdmUpdateWindowSize:
+    {
+        int tmp;
+
+        if ((!ParseInt(arg, tmp)) || (tmp < 1) || (tmp > WDM_CLIENT_MAX_UPDATE_WINDOW_SIZE))
+        {
+            PrintArgError("%s: Invalid value specified for --wdm-update-window: %s; min 1, max %d\n", progName, arg,
+                          WDM_CLIENT_MAX_UPDATE_WINDOW_SIZE);
+            return false;
+        }
+        mWdmUpdateWindowSize = static_cast<uint8_t>(tmp);
+        break;
+    }
     default:
         PrintArgError("%s: INTERNAL ERROR: Unhandled option: %s\n", progName, name);
         return false;
@@ -68,6 +68,8 @@ enum
     kToolOpt_WdmUpdateConditionality,
     kToolOpt_WdmUpdateTiming,
     kToolOpt_WdmUpdateDiscardOnError,
+    kToolOpt_WdmNotifyWindowSize,
+    kToolOpt_WdmUpdateWindowSize,
 };
 
 class MockWdmNodeOptions : public OptionSetBase
@@ -142,6 +144,7 @@ public:
     EventGeneratorType mEventGeneratorType;
     int mTimeBetweenEvents;
     const char * mTimeBetweenLivenessCheckSec;
+    uint8_t mNotifyWindowSize;
     bool mEnableDictionaryTest;
     bool mEnableRetry;
 #if WDM_ENABLE_SUBSCRIPTIONLESS_NOTIFICATION
@@ -154,6 +157,7 @@ public:
     uint32_t mWdmUpdateNumberOfRepeatedMutations;
     WdmUpdateTiming mWdmUpdateTiming;
     bool mWdmUpdateDiscardOnError;
+    uint8_t mWdmUpdateWindowSize;
 
     uint32_t mWdmUpdateMaxNumberOfTraits;
 
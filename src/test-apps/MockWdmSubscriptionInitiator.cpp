@@ -184,6 +184,7 @@ private:
     uint32_t mUpdateNumRepeatedMutations;
     bool     mUpdateDiscardOnError;
     uint32_t mUpdateSameMutationCounter;
+    uint8_t  mUpdateWindowSize;
 #endif // WEAVE_CONFIG_ENABLE_WDM_UPDATE
 
     BoltLockSettingTraitDataSink mBoltLockSettingsTraitDataSink;
@@ -290,6 +291,7 @@ private:
 #if WEAVE_CONFIG_ENABLE_WDM_UPDATE
     static void HandleMutationTimeout (nl::Weave::System::Layer *aSystemLayer, void *aAppState, nl::Weave::System::Error aErr);
     WEAVE_ERROR ApplyWdmUpdateMutations();
+    WEAVE_ERROR MutateTraitInstance(uint32_t aIndex, bool aTestATraitConditional, bool aOtherTraitsConditional);
 #endif
 
     static void MonitorPublisherCurrentState (nl::Weave::System::Layer* aSystemLayer, void *aAppState, INET_ERROR aErr);
@@ -409,6 +411,7 @@ WEAVE_ERROR MockWdmSubscriptionInitiatorImpl::Init(
     mUpdateNumRepeatedMutations = aConfig.mWdmUpdateNumberOfRepeatedMutations;
     mUpdateDiscardOnError = aConfig.mWdmUpdateDiscardOnError;
     mUpdateSameMutationCounter = 0;
+    mUpdateWindowSize = aConfig.mWdmUpdateWindowSize;
 #endif // WEAVE_CONFIG_ENABLE_WDM_UPDATE
 
     switch (mTestCaseId)
@@ -549,6 +552,11 @@ WEAVE_ERROR MockWdmSubscriptionInitiatorImpl::StartTesting(const uint64_t aPubli
                 &mSinkCatalog,
                 kResponseTimeoutMsec * 2); // max num of msec between subscribe request and subscribe response
         SuccessOrExit(err);
+
+#if WEAVE_CONFIG_ENABLE_WDM_UPDATE && WDM_CLIENT_MAX_UPDATE_WINDOW_SIZE > 1
+        err = mSubscriptionClient->SetUpdateWindowSize(mUpdateWindowSize);
+        SuccessOrExit(err);
+#endif // WEAVE_CONFIG_ENABLE_WDM_UPDATE && WDM_CLIENT_MAX_UPDATE_WINDOW_SIZE > 1
     }
 
     // TODO: EVENT-DEMO
@@ -1411,26 +1419,39 @@ WEAVE_ERROR MockWdmSubscriptionInitiatorImpl::ApplyWdmUpdateMutations()
 
     WeaveLogDetail(DataManagement, "Mutation %u of %u; %u trait instances",
             initiator->mUpdateMutationCounter, initiator->mUpdateNumMutations, initiator->mUpdateNumTraits);
-    switch (initiator->mUpdateNumTraits)
+
+    if (initiator->mUpdateWindowSize > 1 && initiator->mUpdateNumTraits > 1 && initiator->mUpdateNumTraits <= 4)
     {
-        case 4:
-            err = initiator->mTestATraitUpdatableDataSink1.Mutate(initiator->mSubscriptionClient, otherTraitsConditional, initiator->mUpdateMutation);
-            SuccessOrExit(err);
-        case 3:
-            err = initiator->mTestBTraitUpdatableDataSink.Mutate(initiator->mSubscriptionClient, otherTraitsConditional, initiator->mUpdateMutation);
-            SuccessOrExit(err);
-        case 2:
-            err = initiator->mLocaleSettingsTraitUpdatableDataSink.Mutate(initiator->mSubscriptionClient, otherTraitsConditional, initiator->mUpdateMutation);
-            SuccessOrExit(err);
-        case 1:
-            err = initiator->mTestATraitUpdatableDataSink0.Mutate(initiator->mSubscriptionClient, testATraitConditional, initiator->mUpdateMutation);
-            SuccessOrExit(err);
-            break;
-        default:
-            err = initiator->mLocaleSettingsTraitUpdatableDataSink.Mutate(initiator->mSubscriptionClient, otherTraitsConditional, initiator->mUpdateMutation);
-            SuccessOrExit(err);
-            break;
+        // Mutate one trait instance at a time, so that each one goes out in its own slot of the update window
+        // while the updates to the others are still in flight.
+        err = MutateTraitInstance((initiator->mUpdateMutationCounter - 1) % initiator->mUpdateNumTraits,
+                                  testATraitConditional, otherTraitsConditional);
+        SuccessOrExit(err);
+    }
+    else
+    {
+        switch (initiator->mUpdateNumTraits)
+        {
+            case 4:
+                err = initiator->mTestATraitUpdatableDataSink1.Mutate(initiator->mSubscriptionClient, otherTraitsConditional, initiator->mUpdateMutation);
+                SuccessOrExit(err);
+            case 3:
+                err = initiator->mTestBTraitUpdatableDataSink.Mutate(initiator->mSubscriptionClient, otherTraitsConditional, initiator->mUpdateMutation);
+                SuccessOrExit(err);
+            case 2:
+                err = initiator->mLocaleSettingsTraitUpdatableDataSink.Mutate(initiator->mSubscriptionClient, otherTraitsConditional, initiator->mUpdateMutation);
+                SuccessOrExit(err);
+            case 1:
+                err = initiator->mTestATraitUpdatableDataSink0.Mutate(initiator->mSubscriptionClient, testATraitConditional, initiator->mUpdateMutation);
+                SuccessOrExit(err);
+                break;
+            default:
+                err = initiator->mLocaleSettingsTraitUpdatableDataSink.Mutate(initiator->mSubscriptionClient, otherTraitsConditional, initiator->mUpdateMutation);
+                SuccessOrExit(err);
+                break;
+        }
     }
+
     err = initiator->mSubscriptionClient->FlushUpdate();
 
     initiator->mUpdateSameMutationCounter++;
@@ -1450,6 +1471,34 @@ WEAVE_ERROR MockWdmSubscriptionInitiatorImpl::ApplyWdmUpdateMutations()
 exit:
     return err;
 }
+
+// Mutates the aIndex-th of the trait instances ApplyWdmUpdateMutations() mutates together.
+WEAVE_ERROR MockWdmSubscriptionInitiatorImpl::MutateTraitInstance(uint32_t aIndex, bool aTestATraitConditional,
+                                                                  bool aOtherTraitsConditional)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    switch (aIndex)
+    {
+        case 0:
+            err = mTestATraitUpdatableDataSink0.Mutate(mSubscriptionClient, aTestATraitConditional, mUpdateMutation);
+            break;
+        case 1:
+            err = mLocaleSettingsTraitUpdatableDataSink.Mutate(mSubscriptionClient, aOtherTraitsConditional, mUpdateMutation);
+            break;
+        case 2:
+            err = mTestBTraitUpdatableDataSink.Mutate(mSubscriptionClient, aOtherTraitsConditional, mUpdateMutation);
+            break;
+        case 3:
+            err = mTestATraitUpdatableDataSink1.Mutate(mSubscriptionClient, aOtherTraitsConditional, mUpdateMutation);
+            break;
+        default:
+            err = WEAVE_ERROR_INVALID_ARGUMENT;
+            break;
+    }
+
+    return err;
+}
 #endif // WEAVE_CONFIG_ENABLE_WDM_UPDATE
 
 void MockWdmSubscriptionInitiatorImpl::HandleDataFlipTimeout(nl::Weave::System::Layer* aSystemLayer, void *aAppState,
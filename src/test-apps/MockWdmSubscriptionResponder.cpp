@@ -151,6 +151,7 @@ private:
 #endif // WEAVE_CONFIG_ENABLE_WDM_UPDATE
     // publisher side
     uint32_t mTimeBetweenLivenessCheckSec;
+    uint8_t mNotifyWindowSize;
     SingleResourceSourceTraitCatalog mSourceCatalog;
     SingleResourceSourceTraitCatalog::CatalogItem mSourceCatalogStore[10];
 
@@ -307,6 +308,7 @@ MockWdmSubscriptionResponder * MockWdmSubscriptionResponder::GetInstance ()
 
 MockWdmSubscriptionResponderImpl::MockWdmSubscriptionResponderImpl() :
     mTimeBetweenLivenessCheckSec(30),
+    mNotifyWindowSize(1),
     mSourceCatalog(ResourceIdentifier(ResourceIdentifier::SELF_NODE_ID), mSourceCatalogStore, sizeof(mSourceCatalogStore) / sizeof(mSourceCatalogStore[0])),
     mSinkCatalog(ResourceIdentifier(ResourceIdentifier::SELF_NODE_ID), mSinkCatalogStore, sizeof(mSinkCatalogStore) / sizeof(mSinkCatalogStore[0])),
     mCmdState(kCmdState_Idle),
@@ -373,6 +375,8 @@ WEAVE_ERROR MockWdmSubscriptionResponderImpl::Init (nl::Weave::WeaveExchangeMana
         mTimeBetweenLivenessCheckSec = 30;
     }
 
+    mNotifyWindowSize = aConfig.mNotifyWindowSize;
+
     mTestADataSource0.mTraitTestSet = 0;
     mTestADataSource1.mTraitTestSet = 1;
 
@@ -634,6 +638,15 @@ void MockWdmSubscriptionResponderImpl::PublisherEventCallback (void * const aApp
                     aInParam.mSubscribeRequestParsed.mTimeoutSecMin,
                     aInParam.mSubscribeRequestParsed.mTimeoutSecMax,
                     responder->mTimeBetweenLivenessCheckSec);
+#if WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE > 1
+            err = aInParam.mSubscribeRequestParsed.mHandler->SetNotifyWindowSize(responder->mNotifyWindowSize);
+            if (WEAVE_NO_ERROR != err)
+            {
+                WeaveLogError(DataManagement, "Notify window %u not supported, keeping %u", responder->mNotifyWindowSize,
+                              aInParam.mSubscribeRequestParsed.mHandler->GetNotifyWindowSize());
+                err = WEAVE_NO_ERROR;
+            }
+#endif // WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE > 1
             aInParam.mSubscribeRequestParsed.mHandler->AcceptSubscribeRequest(responder->mTimeBetweenLivenessCheckSec);
         }
         break;
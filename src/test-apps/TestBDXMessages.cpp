@@ -0,0 +1,201 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This is a unit test suite for the encoding of the window size
+ *      proposed in the BDX SendInit and ReceiveInit messages.
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <nlunit-test.h>
+
+#include <Weave/Core/WeaveCore.h>
+#include <Weave/Core/WeaveTLV.h>
+#include <Weave/Profiles/bulk-data-transfer/Development/BDXMessages.h>
+#include <Weave/Profiles/bulk-data-transfer/Development/BDXConstants.h>
+#include <SystemLayer/SystemPacketBuffer.h>
+
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP
+#include "lwip/tcpip.h"
+#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
+
+using namespace nl::Weave;
+using namespace nl::Weave::TLV;
+using namespace nl::Weave::Profiles;
+using namespace nl::Weave::Profiles::BulkDataTransfer;
+using nl::Weave::System::PacketBuffer;
+
+static char sFileDesignator[] = "image.bin";
+
+// An application metadata element: 1 (anonymous uint8) = 0x2A.
+static uint8_t sMetaData[] = { 0x04, 0x2A };
+
+static void InitSendInit(nlTestSuite *inSuite, SendInit &aInit, uint8_t aWindowSize, bool aWithMetaData)
+{
+    WEAVE_ERROR err;
+    ReferencedString fileDesignator;
+    ReferencedTLVData metaData;
+
+    err = fileDesignator.init((uint16_t)strlen(sFileDesignator), sFileDesignator);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = metaData.init(sizeof(sMetaData), sizeof(sMetaData), sMetaData);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = aInit.init(WEAVE_CONFIG_BDX_VERSION, true, false, false, 1024, (uint64_t)4096, (uint64_t)0, fileDesignator,
+                     aWithMetaData ? &metaData : NULL);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    aInit.mWindowSize = aWindowSize;
+}
+
+/**
+ * Check that a proposed window size survives a pack and parse, and that it is stripped
+ * from the metadata handed to the application.
+ */
+static void CheckWindowSizeRoundTrip(nlTestSuite *inSuite, void *inContext)
+{
+    for (int withMetaData = 0; withMetaData <= 1; withMetaData++)
+    {
+        SendInit init;
+        SendInit parsed;
+        PacketBuffer *buf = PacketBuffer::New();
+
+        NL_TEST_ASSERT(inSuite, buf != NULL);
+
+        InitSendInit(inSuite, init, 8, withMetaData != 0);
+
+        NL_TEST_ASSERT(inSuite, init.pack(buf) == WEAVE_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, buf->DataLength() == init.packedLength());
+
+        NL_TEST_ASSERT(inSuite, SendInit::parse(buf, parsed) == WEAVE_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, parsed.mWindowSize == 8);
+        NL_TEST_ASSERT(inSuite, parsed.mStartOffset == 4096);
+        NL_TEST_ASSERT(inSuite, parsed.mFileDesignator.theLength == strlen(sFileDesignator));
+
+        if (withMetaData)
+        {
+            NL_TEST_ASSERT(inSuite, parsed.mMetaData.theLength == sizeof(sMetaData));
+            NL_TEST_ASSERT(inSuite, memcmp(parsed.mMetaData.theData, sMetaData, sizeof(sMetaData)) == 0);
+        }
+        else
+        {
+            NL_TEST_ASSERT(inSuite, parsed.mMetaData.theLength == 0);
+        }
+
+        PacketBuffer::Free(buf);
+    }
+}
+
+/**
+ * Check that a message proposing a window only differs from a lock-step one by a TLV
+ * element appended to its metadata, so that a peer that doesn't support windowed
+ * transfers parses every field correctly and sees valid metadata.
+ */
+static void CheckWindowSizeLegacyLayout(nlTestSuite *inSuite, void *inContext)
+{
+    SendInit lockStep;
+    SendInit windowed;
+    PacketBuffer *lockStepBuf = PacketBuffer::New();
+    PacketBuffer *windowedBuf = PacketBuffer::New();
+    uint16_t lockStepLen;
+    TLVReader reader;
+    WEAVE_ERROR err;
+    uint64_t lastTag = AnonymousTag;
+    int numElements = 0;
+
+    NL_TEST_ASSERT(inSuite, lockStepBuf != NULL && windowedBuf != NULL);
+
+    InitSendInit(inSuite, lockStep, 1, true);
+    InitSendInit(inSuite, windowed, 8, true);
+
+    NL_TEST_ASSERT(inSuite, lockStep.pack(lockStepBuf) == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, windowed.pack(windowedBuf) == WEAVE_NO_ERROR);
+
+    lockStepLen = lockStepBuf->DataLength();
+    NL_TEST_ASSERT(inSuite, windowedBuf->DataLength() > lockStepLen);
+    NL_TEST_ASSERT(inSuite, memcmp(windowedBuf->Start(), lockStepBuf->Start(), lockStepLen) == 0);
+
+    // The metadata a legacy peer sees: the application's element, then the window size.
+    reader.Init(windowedBuf->Start() + lockStepLen - sizeof(sMetaData),
+                windowedBuf->DataLength() - lockStepLen + sizeof(sMetaData));
+
+    while ((err = reader.Next()) == WEAVE_NO_ERROR)
+    {
+        lastTag = reader.GetTag();
+        numElements++;
+    }
+
+    NL_TEST_ASSERT(inSuite, err == WEAVE_END_OF_TLV);
+    NL_TEST_ASSERT(inSuite, numElements == 2);
+    NL_TEST_ASSERT(inSuite, lastTag == ProfileTag(kWeaveProfile_BDX, kTag_WindowSize));
+
+    PacketBuffer::Free(lockStepBuf);
+    PacketBuffer::Free(windowedBuf);
+}
+
+/**
+ * Check that a message without a window size element is parsed as a lock-step proposal
+ * and its metadata is left alone.
+ */
+static void CheckNoWindowSize(nlTestSuite *inSuite, void *inContext)
+{
+    SendInit init;
+    SendInit parsed;
+    PacketBuffer *buf = PacketBuffer::New();
+
+    NL_TEST_ASSERT(inSuite, buf != NULL);
+
+    InitSendInit(inSuite, init, 1, true);
+
+    NL_TEST_ASSERT(inSuite, init.pack(buf) == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, SendInit::parse(buf, parsed) == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, parsed.mWindowSize == 1);
+    NL_TEST_ASSERT(inSuite, parsed.mMetaData.theLength == sizeof(sMetaData));
+
+    PacketBuffer::Free(buf);
+}
+
+int main(int argc, char *argv[])
+{
+    static const nlTest tests[] = {
+        NL_TEST_DEF("BDX::TestWindowSizeRoundTrip",         CheckWindowSizeRoundTrip),
+        NL_TEST_DEF("BDX::TestWindowSizeLegacyLayout",      CheckWindowSizeLegacyLayout),
+        NL_TEST_DEF("BDX::TestNoWindowSize",                CheckNoWindowSize),
+        NL_TEST_SENTINEL()
+    };
+
+    static nlTestSuite testSuite = {
+        "weave-bdx-messages",
+        &tests[0]
+    };
+
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP
+    tcpip_init(NULL, NULL);
+#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
+
+    nl_test_set_output_style(OUTPUT_CSV);
+
+    nlTestRunner(&testSuite, NULL);
+
+    return nlTestRunnerStats(&testSuite);
+}
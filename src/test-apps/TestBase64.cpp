@@ -0,0 +1,257 @@
+/*
+ *
+ *    Copyright (c) 2018 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a process to effect a functional test for
+ *      the base-64 encode and decode functions.
+ *
+ */
+
+#ifndef __STDC_LIMIT_MACROS
+#define __STDC_LIMIT_MACROS
+#endif
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <Weave/Support/Base64.h>
+
+#include <nlunit-test.h>
+
+using namespace nl;
+
+enum
+{
+    kMaxTestDataLen         = 2048,
+    kFuzzIterations         = 20000,
+};
+
+// Copies of the character mappings of the standard alphabet.  Passing these to the encode and
+// decode functions selects their generic per-character loops, which serve as the reference
+// for the table-driven and vectorized conversions used for the built-in alphabets.
+
+static const char sRefChars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static char RefValToChar(uint8_t val)
+{
+    return (val < 64) ? sRefChars[val] : '=';
+}
+
+static uint8_t RefCharToVal(uint8_t c)
+{
+    const char *pos = (c != 0) ? strchr(sRefChars, c) : NULL;
+    return (pos != NULL) ? (uint8_t)(pos - sRefChars) : UINT8_MAX;
+}
+
+static char RefURLValToChar(uint8_t val)
+{
+    char c = RefValToChar(val);
+    return (c == '+') ? '-' : (c == '/') ? '_' : c;
+}
+
+static uint8_t RefURLCharToVal(uint8_t c)
+{
+    if (c == '-')
+        return 62;
+    if (c == '_')
+        return 63;
+    if (c == '+' || c == '/')
+        return UINT8_MAX;
+    return RefCharToVal(c);
+}
+
+static void FillRandom(uint8_t *buf, uint32_t len)
+{
+    for (uint32_t i = 0; i < len; i++)
+        buf[i] = (uint8_t)rand();
+}
+
+// Lengths are mostly short, as for keys and tokens, with some spanning several vector blocks.
+static uint16_t RandomLength(void)
+{
+    return (rand() % 4 == 0) ? (uint16_t)(rand() % kMaxTestDataLen) : (uint16_t)(rand() % 64);
+}
+
+static void CheckKnownValues(nlTestSuite *inSuite, void *inContext)
+{
+    static const struct
+    {
+        const char *Data;
+        const char *Encoded;
+    } sTestVectors[] =
+    {
+        { "",                                   ""                                              },
+        { "f",                                  "Zg=="                                          },
+        { "fo",                                 "Zm8="                                          },
+        { "foo",                                "Zm9v"                                          },
+        { "foob",                               "Zm9vYg=="                                      },
+        { "fooba",                              "Zm9vYmE="                                      },
+        { "foobar",                             "Zm9vYmFy"                                      },
+        { "\xFB\xFF\xBF\xFB\xFF\xBF\xFB\xFF\xBF\xFB\xFF\xBF\xFB\xFF\xBF\xFB\xFF\xBF",
+                                                "+/+/+/+/+/+/+/+/+/+/+/+/"                      },
+    };
+    char encoded[64];
+    uint8_t decoded[64];
+
+    for (size_t i = 0; i < sizeof(sTestVectors) / sizeof(sTestVectors[0]); i++)
+    {
+        uint16_t dataLen = (uint16_t)strlen(sTestVectors[i].Data);
+        uint16_t encodedLen = (uint16_t)strlen(sTestVectors[i].Encoded);
+
+        NL_TEST_ASSERT(inSuite, Base64Encode((const uint8_t *)sTestVectors[i].Data, dataLen, encoded) == encodedLen);
+        NL_TEST_ASSERT(inSuite, memcmp(encoded, sTestVectors[i].Encoded, encodedLen) == 0);
+
+        NL_TEST_ASSERT(inSuite, Base64Decode(sTestVectors[i].Encoded, encodedLen, decoded) == dataLen);
+        NL_TEST_ASSERT(inSuite, memcmp(decoded, sTestVectors[i].Data, dataLen) == 0);
+    }
+
+    // Decoding stops at whitespace, and rejects invalid characters and misplaced padding.
+    NL_TEST_ASSERT(inSuite, Base64Decode("Zm9vYmFy\nZm9v", 13, decoded) == 6);
+    NL_TEST_ASSERT(inSuite, Base64Decode("Zm9vYm*y", 8, decoded) == UINT16_MAX);
+    NL_TEST_ASSERT(inSuite, Base64Decode("Zm9v=mFy", 8, decoded) == UINT16_MAX);
+    NL_TEST_ASSERT(inSuite, Base64URLDecode("Zm9v+mFy", 8, decoded) == UINT16_MAX);
+    NL_TEST_ASSERT(inSuite, Base64URLDecode("-_-_", 4, decoded) == 3);
+    NL_TEST_ASSERT(inSuite, decoded[0] == 0xFB && decoded[1] == 0xFF && decoded[2] == 0xBF);
+}
+
+static void CheckEncodeMatchesReference(nlTestSuite *inSuite, void *inContext)
+{
+    uint8_t data[kMaxTestDataLen];
+    char encoded[BASE64_ENCODED_LEN(kMaxTestDataLen)];
+    char refEncoded[BASE64_ENCODED_LEN(kMaxTestDataLen)];
+
+    for (int i = 0; i < kFuzzIterations; i++)
+    {
+        uint16_t dataLen = RandomLength();
+        uint16_t encodedLen, refEncodedLen;
+        bool url = (i % 2) != 0;
+
+        FillRandom(data, dataLen);
+
+        encodedLen = url ? Base64URLEncode(data, dataLen, encoded) : Base64Encode(data, dataLen, encoded);
+        refEncodedLen = Base64Encode(data, dataLen, refEncoded, url ? RefURLValToChar : RefValToChar);
+
+        NL_TEST_ASSERT(inSuite, encodedLen == refEncodedLen);
+        NL_TEST_ASSERT(inSuite, memcmp(encoded, refEncoded, encodedLen) == 0);
+    }
+}
+
+static void CheckDecodeMatchesReference(nlTestSuite *inSuite, void *inContext)
+{
+    static const char sNoise[] = "=\n \t*-_+/\x80\xFF";
+    uint8_t data[kMaxTestDataLen];
+    char encoded[BASE64_ENCODED_LEN(kMaxTestDataLen)];
+    uint8_t decoded[kMaxTestDataLen];
+    uint8_t refDecoded[kMaxTestDataLen];
+    uint8_t inPlace[BASE64_ENCODED_LEN(kMaxTestDataLen)];
+
+    for (int i = 0; i < kFuzzIterations; i++)
+    {
+        uint16_t dataLen = RandomLength();
+        uint16_t encodedLen, decodedLen, refDecodedLen;
+        bool url = (i % 2) != 0;
+
+        FillRandom(data, dataLen);
+        encodedLen = url ? Base64URLEncode(data, dataLen, encoded) : Base64Encode(data, dataLen, encoded);
+
+        // Damage most of the inputs with characters outside the alphabet, or truncate them.
+        if (encodedLen > 0 && rand() % 4 != 0)
+        {
+            int numChanges = 1 + rand() % 3;
+            for (int j = 0; j < numChanges; j++)
+                encoded[rand() % encodedLen] = sNoise[rand() % (sizeof(sNoise) - 1)];
+        }
+        if (encodedLen > 0 && rand() % 8 == 0)
+            encodedLen = (uint16_t)(rand() % encodedLen);
+
+        decodedLen = url ? Base64URLDecode(encoded, encodedLen, decoded) : Base64Decode(encoded, encodedLen, decoded);
+        refDecodedLen = Base64Decode(encoded, encodedLen, refDecoded, url ? RefURLCharToVal : RefCharToVal);
+
+        NL_TEST_ASSERT(inSuite, decodedLen == refDecodedLen);
+        if (decodedLen != UINT16_MAX)
+            NL_TEST_ASSERT(inSuite, memcmp(decoded, refDecoded, decodedLen) == 0);
+
+        // Decoding in place gives the same result.
+        memcpy(inPlace, encoded, encodedLen);
+        decodedLen = url ? Base64URLDecode((const char *)inPlace, encodedLen, inPlace) : Base64Decode((const char *)inPlace, encodedLen, inPlace);
+
+        NL_TEST_ASSERT(inSuite, decodedLen == refDecodedLen);
+        if (decodedLen != UINT16_MAX)
+            NL_TEST_ASSERT(inSuite, memcmp(inPlace, refDecoded, decodedLen) == 0);
+    }
+}
+
+static void CheckLongData(nlTestSuite *inSuite, void *inContext)
+{
+    // Longer than a single 16-bit conversion, to cover the chunking of the 32-bit functions.
+    const uint32_t dataLen = 100000;
+    uint8_t *data = (uint8_t *)malloc(dataLen);
+    char *encoded = (char *)malloc(BASE64_ENCODED_LEN(dataLen));
+    uint8_t *decoded = (uint8_t *)malloc(dataLen);
+    uint32_t encodedLen;
+
+    NL_TEST_ASSERT(inSuite, data != NULL && encoded != NULL && decoded != NULL);
+    if (data == NULL || encoded == NULL || decoded == NULL)
+        goto exit;
+
+    FillRandom(data, dataLen);
+
+    encodedLen = Base64Encode32(data, dataLen, encoded);
+    NL_TEST_ASSERT(inSuite, encodedLen == BASE64_ENCODED_LEN(dataLen));
+
+    NL_TEST_ASSERT(inSuite, Base64Decode32(encoded, encodedLen, decoded) == dataLen);
+    NL_TEST_ASSERT(inSuite, memcmp(decoded, data, dataLen) == 0);
+
+exit:
+    free(data);
+    free(encoded);
+    free(decoded);
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("KnownValues",            CheckKnownValues),
+    NL_TEST_DEF("EncodeMatchesReference", CheckEncodeMatchesReference),
+    NL_TEST_DEF("DecodeMatchesReference", CheckDecodeMatchesReference),
+    NL_TEST_DEF("LongData",               CheckLongData),
+
+    NL_TEST_SENTINEL()
+};
+
+int main(void)
+{
+    nlTestSuite theSuite = {
+        "Base64",
+        &sTests[0],
+        NULL,
+        NULL
+    };
+
+    srand(1);
+
+    // Generate machine-readable, comma-separated value (CSV) output.
+    nl_test_set_output_style(OUTPUT_CSV);
+
+    nlTestRunner(&theSuite, NULL);
+
+    return nlTestRunnerStats(&theSuite);
+}
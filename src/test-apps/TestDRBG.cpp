@@ -201,6 +201,123 @@ exit:
     return err;
 }
 
+#if WEAVE_CONFIG_DRBG_OUTPUT_BUFFER_SIZE > 0
+
+static int FixedEntropyFunct(uint8_t *entropy, size_t entropyLen)
+{
+    for (size_t i = 0; i < entropyLen; i++)
+        entropy[i] = (uint8_t) i;
+
+    return 0;
+}
+
+// Check that small requests served from the DRBG output buffer return the same
+// stream as buffer-sized Generate() calls on an identically seeded DRBG, that
+// large requests bypass the buffer, and that the buffer is discarded when the
+// DRBG is reseeded or uninstantiated.
+static void TestDRBGOutputBuffer(void)
+{
+    enum
+    {
+        kBufferSize   = WEAVE_CONFIG_DRBG_OUTPUT_BUFFER_SIZE,
+        kEntropyLen   = 16,
+        kMaxRequest   = 13,
+        // Enough buffer fills to cross an automatic reseed
+        kFillCount    = WEAVE_CONFIG_DRBG_RESEED_INTERVAL + 2,
+    };
+    static const uint8_t personalization[] = "TestDRBGOutputBuffer";
+    WEAVE_ERROR err;
+    AES128CTRDRBG bufferedDRBG;
+    AES128CTRDRBG referenceDRBG;
+    uint8_t expected[kBufferSize];
+    uint8_t request[kBufferSize];
+    uint8_t leftover[kMaxRequest];
+    uint32_t streamPos = 0;
+    uint16_t requestLen;
+
+    err = bufferedDRBG.Instantiate(FixedEntropyFunct, kEntropyLen, personalization, sizeof(personalization));
+    SuccessOrFail(err, "Instantiate failed\n");
+    err = referenceDRBG.Instantiate(FixedEntropyFunct, kEntropyLen, personalization, sizeof(personalization));
+    SuccessOrFail(err, "Instantiate failed\n");
+
+    // Small requests of varying size return the same stream as the reference DRBG
+    // generating a buffer's worth at a time.
+    for (uint32_t i = 0; streamPos < (uint32_t) kFillCount * kBufferSize; i++)
+    {
+        requestLen = 1 + (i % kMaxRequest);
+
+        err = bufferedDRBG.GenerateBuffered(request, requestLen);
+        SuccessOrFail(err, "GenerateBuffered failed\n");
+
+        for (uint16_t j = 0; j < requestLen; j++, streamPos++)
+        {
+            if (streamPos % kBufferSize == 0)
+            {
+                err = referenceDRBG.Generate(expected, kBufferSize);
+                SuccessOrFail(err, "Generate failed\n");
+            }
+
+            VerifyOrFail(request[j] == expected[streamPos % kBufferSize], "Buffered output differs from the reference stream\n");
+        }
+    }
+
+    // A request as large as the buffer is served directly by the DRBG, leaving any
+    // buffered data for later requests.
+    err = bufferedDRBG.GenerateBuffered(request, kBufferSize);
+    SuccessOrFail(err, "GenerateBuffered failed\n");
+
+    if (streamPos % kBufferSize != 0)
+    {
+        requestLen = kBufferSize - (streamPos % kBufferSize);
+        if (requestLen > kMaxRequest)
+            requestLen = kMaxRequest;
+
+        err = bufferedDRBG.GenerateBuffered(leftover, requestLen);
+        SuccessOrFail(err, "GenerateBuffered failed\n");
+
+        VerifyOrFail(memcmp(leftover, expected + (streamPos % kBufferSize), requestLen) == 0,
+                     "Buffered data lost by a large request\n");
+    }
+
+    err = referenceDRBG.Generate(expected, kBufferSize);
+    SuccessOrFail(err, "Generate failed\n");
+
+    VerifyOrFail(memcmp(request, expected, kBufferSize) == 0, "Large request output differs from the reference stream\n");
+
+    // Reseeding discards the buffered data generated from the previous seed.
+    err = bufferedDRBG.Instantiate(FixedEntropyFunct, kEntropyLen, personalization, sizeof(personalization));
+    SuccessOrFail(err, "Instantiate failed\n");
+    err = referenceDRBG.Instantiate(FixedEntropyFunct, kEntropyLen, personalization, sizeof(personalization));
+    SuccessOrFail(err, "Instantiate failed\n");
+
+    err = bufferedDRBG.GenerateBuffered(request, 1);
+    SuccessOrFail(err, "GenerateBuffered failed\n");
+    err = referenceDRBG.Generate(expected, kBufferSize);
+    SuccessOrFail(err, "Generate failed\n");
+    VerifyOrFail(request[0] == expected[0], "Buffered output differs from the reference stream\n");
+
+    err = bufferedDRBG.Reseed();
+    SuccessOrFail(err, "Reseed failed\n");
+    err = referenceDRBG.Reseed();
+    SuccessOrFail(err, "Reseed failed\n");
+
+    err = bufferedDRBG.GenerateBuffered(request, kMaxRequest);
+    SuccessOrFail(err, "GenerateBuffered failed\n");
+    err = referenceDRBG.Generate(expected, kBufferSize);
+    SuccessOrFail(err, "Generate failed\n");
+    VerifyOrFail(memcmp(request, expected, kMaxRequest) == 0, "Buffered data served after a reseed\n");
+
+    // Uninstantiating discards the buffered data.
+    bufferedDRBG.Uninstantiate();
+
+    err = bufferedDRBG.GenerateBuffered(request, 1);
+    VerifyOrFail(err == WEAVE_ERROR_INCORRECT_STATE, "Buffered data served after uninstantiate\n");
+
+    referenceDRBG.Uninstantiate();
+}
+
+#endif // WEAVE_CONFIG_DRBG_OUTPUT_BUFFER_SIZE > 0
+
 // Current DRBG implementation doesn't support noDF option
 #define WEAVE_CONFIG_DRBG_WITHOUT_DERIVATION_FUNCTION  0
 
@@ -332,5 +449,9 @@ int main(int argc, char *argv[])
     SuccessOrFail(err, "TestDRBG failed in NoReseed & NoDF case\n");
 #endif
 
+#if WEAVE_CONFIG_DRBG_OUTPUT_BUFFER_SIZE > 0
+    TestDRBGOutputBuffer();
+#endif
+
     printf("All tests succeeded\n");
 }
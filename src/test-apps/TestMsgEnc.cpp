@@ -35,6 +35,7 @@
 #include <Weave/Core/WeaveConfig.h>
 #include <Weave/Support/crypto/CTRMode.h>
 #include <Weave/Support/crypto/WeaveCrypto.h>
+#include <SystemLayer/SystemStats.h>
 
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
 #include "lwip/tcpip.h"
@@ -60,6 +61,23 @@ public:
     {
         return msgLayer->DecodeMessage(msgBuf, sourceNodeId, con, msgInfo, rPayload, rPayloadLen);
     }
+
+    WEAVE_ERROR EncodeMessageWithLength(WeaveMessageInfo *msgInfo, PacketBuffer *msgBuf, WeaveConnection *con,
+            uint16_t maxLen)
+    {
+        return msgLayer->EncodeMessageWithLength(msgInfo, msgBuf, con, maxLen);
+    }
+
+    WEAVE_ERROR DecodeMessageWithLength(PacketBuffer *& msgBuf, uint64_t sourceNodeId, WeaveConnection *con,
+            WeaveMessageInfo *msgInfo, PacketBuffer *& rPayload, uint32_t *rFrameLen)
+    {
+        return msgLayer->DecodeMessageWithLength(msgBuf, sourceNodeId, con, msgInfo, rPayload, rFrameLen);
+    }
+
+    void DispatchMessage(WeaveMessageInfo *msgInfo, PacketBuffer *msgBuf)
+    {
+        msgLayer->ExchangeMgr->DispatchMessage(msgInfo, msgBuf);
+    }
 };
 
 } // namespace nl
@@ -129,21 +147,13 @@ static struct TestContext sContext[] = {
 // Number of test context examples.
 static const size_t kTestElements = sizeof(sContext) / sizeof(struct TestContext);
 
-void WeaveMessageEncryption_Test1(nlTestSuite *inSuite, void *inContext)
+// Initialize a fabric state, and a session key shared by the local node and the given destination node.
+static void InitTestFabricState(nlTestSuite *inSuite, WeaveFabricState &fabricState, uint64_t destNodeId, uint16_t sessionKeyId,
+        uint64_t &srcNodeId)
 {
-    static WeaveFabricState fabricState;
-    static WeaveMessageLayer messageLayer;
-    static WeaveMessageInfo msgInfo;
-
     WEAVE_ERROR err;
-    PacketBuffer *msgBuf;
     WeaveSessionKey *sessionKey;
-    uint64_t srcNodeId;
-    uint64_t destNodeId = 0x18B4300012345678;
-    uint32_t msgId = 3;
     uint8_t encType = kWeaveEncryptionType_AES128CTRSHA1;
-    uint16_t sessionKeyId = sTestDefaultSessionKeyId;
-    uint8_t *p;
 
     const char localAddrStr[] = "fd00:0:1:1:18B4:3000::2";
     IPAddress localIPv6Addr;
@@ -176,6 +186,24 @@ void WeaveMessageEncryption_Test1(nlTestSuite *inSuite, void *inContext)
     NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
 
     fabricState.SetSessionKey(sessionKey, encType, authMode, &msgEncSessionKey);
+}
+
+void WeaveMessageEncryption_Test1(nlTestSuite *inSuite, void *inContext)
+{
+    static WeaveFabricState fabricState;
+    static WeaveMessageLayer messageLayer;
+    static WeaveMessageInfo msgInfo;
+
+    WEAVE_ERROR err;
+    PacketBuffer *msgBuf;
+    uint64_t srcNodeId;
+    uint64_t destNodeId = 0x18B4300012345678;
+    uint32_t msgId = 3;
+    uint8_t encType = kWeaveEncryptionType_AES128CTRSHA1;
+    uint16_t sessionKeyId = sTestDefaultSessionKeyId;
+    uint8_t *p;
+
+    InitTestFabricState(inSuite, fabricState, destNodeId, sessionKeyId, srcNodeId);
 
     // Initialize the MessageLayer object.
     messageLayer.FabricState = &fabricState;
@@ -340,10 +368,406 @@ void WeaveMessageEncryption_Test1(nlTestSuite *inSuite, void *inContext)
 }
 
 
+// The longest framed message header: the message length field, header field, message id, source and destination
+// node ids and key id.  DecodeMessageWithLength() makes this much of a message contiguous in the first buffer.
+static const uint16_t kMaxFramedHeaderLen = 2 + 2 + 4 + 8 + 8 + 2;
+
+// Maximum number of buffers a framed message is split across in the chained decode test.
+static const uint8_t kMaxChainBufs = 3;
+
+// Build a chain of buffers holding the given data, split at the given offsets.
+static PacketBuffer *MakeChain(const uint8_t *data, uint16_t dataLen, const uint16_t *splits, uint8_t numSplits,
+        PacketBuffer *bufs[])
+{
+    PacketBuffer *chain = NULL;
+    uint16_t start = 0;
+
+    for (uint8_t i = 0; i <= numSplits; i++)
+    {
+        uint16_t end = (i < numSplits) ? splits[i] : dataLen;
+        PacketBuffer *buf = PacketBuffer::New();
+
+        if (buf == NULL)
+        {
+            PacketBuffer::Free(chain);
+            return NULL;
+        }
+
+        memcpy(buf->Start(), data + start, end - start);
+        buf->SetDataLength(end - start);
+
+        if (chain == NULL)
+            chain = buf;
+        else
+            chain->AddToEnd(buf);
+
+        bufs[i] = buf;
+        start = end;
+    }
+
+    return chain;
+}
+
+// Return true if a buffer chain holds exactly the given data.
+static bool ChainEquals(PacketBuffer *chain, const uint8_t *data, uint16_t dataLen)
+{
+    uint16_t pos = 0;
+
+    for (PacketBuffer *buf = chain; buf != NULL; buf = buf->Next())
+    {
+        if (buf->DataLength() > dataLen - pos || memcmp(buf->Start(), data + pos, buf->DataLength()) != 0)
+            return false;
+        pos += buf->DataLength();
+    }
+
+    return pos == dataLen;
+}
+
+static uint8_t ChainCount(PacketBuffer *chain)
+{
+    uint8_t count = 0;
+
+    for (PacketBuffer *buf = chain; buf != NULL; buf = buf->Next())
+        count++;
+
+    return count;
+}
+
+// Decode a framed message, followed by trailing data, from a chain of buffers split at the given offsets, and check
+// how the payload and the trailing data are divided between the buffers.
+static void TestChainedDecode(nlTestSuite *inSuite, WeaveMessageLayerTestObject &msgLayerTestObject, uint64_t srcNodeId,
+        const uint8_t *stream, uint16_t frameLen, uint16_t streamLen, uint16_t payloadOffset, const uint16_t *splits,
+        uint8_t numSplits)
+{
+    WEAVE_ERROR err;
+    WeaveMessageInfo msgInfo;
+    PacketBuffer *bufs[kMaxChainBufs];
+    PacketBuffer *data;
+    PacketBuffer *payload = NULL;
+    PacketBuffer *lastSegment;
+    PacketBuffer *endBuf = NULL;
+    uint16_t endBufStart = 0;
+    uint16_t endBufEnd = 0;
+    uint16_t bounds[kMaxChainBufs + 2];
+    uint8_t numBounds = 0;
+    uint8_t expectedSegments = 0;
+    uint16_t pullUpLen = (frameLen < kMaxFramedHeaderLen) ? frameLen : kMaxFramedHeaderLen;
+    uint16_t payloadLen = sizeof(sMsgPayload);
+    uint32_t decodedFrameLen;
+#if WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS && !WEAVE_SYSTEM_CONFIG_USE_LWIP
+    const nl::Weave::System::Stats::count_t bufsInUse =
+            nl::Weave::System::Stats::GetResourcesInUse()[nl::Weave::System::Stats::kSystemLayer_NumPacketBufs];
+#endif
+
+    data = MakeChain(stream, streamLen, splits, numSplits, bufs);
+    NL_TEST_ASSERT(inSuite, data != NULL);
+    if (data == NULL)
+        return;
+
+    // Work out where the buffer boundaries will lie once the header has been made contiguous in the first buffer.
+    // Buffers wholly moved into the first are freed, and a buffer partly moved into it keeps the rest of its data.
+    bounds[numBounds++] = 0;
+    if (splits[0] < pullUpLen && pullUpLen < streamLen)
+        bounds[numBounds++] = pullUpLen;
+    for (uint8_t i = 0; i < numSplits; i++)
+        if (splits[i] > pullUpLen || (i == 0 && splits[i] == pullUpLen))
+            bounds[numBounds++] = splits[i];
+    bounds[numBounds] = streamLen;
+
+    for (uint8_t i = 0; i < numBounds; i++)
+    {
+        // Each buffer that holds part of the payload becomes one segment of the payload chain.  Buffers that hold
+        // only header, integrity check value or trailing data do not.
+        if (bounds[i] < payloadOffset + payloadLen && bounds[i + 1] > payloadOffset)
+            expectedSegments++;
+
+        // Find the buffer in which the message ends, if the trailing data starts part way through it.  Other than
+        // the first, each buffer still ends where it did when the chain was built.
+        if (bounds[i] < frameLen && frameLen < bounds[i + 1])
+        {
+            endBuf = bufs[0];
+            endBufStart = bounds[i];
+            endBufEnd = bounds[i + 1];
+
+            for (uint8_t j = 0; i > 0 && j <= numSplits; j++)
+                if (((j < numSplits) ? splits[j] : streamLen) == endBufEnd)
+                    endBuf = bufs[j];
+        }
+    }
+
+    err = msgLayerTestObject.DecodeMessageWithLength(data, srcNodeId, NULL, &msgInfo, payload, &decodedFrameLen);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, decodedFrameLen == frameLen);
+
+    if (err == WEAVE_NO_ERROR)
+    {
+        // The payload is returned intact, in one buffer per receive buffer it occupied.
+        NL_TEST_ASSERT(inSuite, ChainEquals(payload, sMsgPayload, payloadLen));
+        NL_TEST_ASSERT(inSuite, ChainCount(payload) == expectedSegments);
+
+        // The data that follows the message is left in the received chain.
+        NL_TEST_ASSERT(inSuite, (streamLen == frameLen) ? (data == NULL) : ChainEquals(data, stream + frameLen, streamLen - frameLen));
+
+#if WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS && !WEAVE_SYSTEM_CONFIG_USE_LWIP
+        // Buffers that held only the header or the integrity check value, or that were wholly moved into the first
+        // buffer, have been freed.
+        NL_TEST_ASSERT(inSuite, nl::Weave::System::Stats::GetResourcesInUse()[nl::Weave::System::Stats::kSystemLayer_NumPacketBufs] ==
+                                bufsInUse + ChainCount(payload) + ChainCount(data));
+#endif
+
+        // Where the message ends part way through a buffer, the shorter of the payload bytes and the trailing data in
+        // that buffer is copied: either the buffer stays at the head of the received chain, or it moves to the end
+        // of the payload chain.
+        if (endBuf != NULL)
+        {
+            uint16_t payloadBytes;
+
+            payloadBytes = (payloadOffset + payloadLen > endBufStart) ?
+                    payloadOffset + payloadLen - ((payloadOffset > endBufStart) ? payloadOffset : endBufStart) : 0;
+
+            for (lastSegment = payload; lastSegment->Next() != NULL; lastSegment = lastSegment->Next())
+                ;
+
+            if (payloadBytes <= endBufEnd - frameLen)
+                NL_TEST_ASSERT(inSuite, data == endBuf && lastSegment != endBuf);
+            else
+                NL_TEST_ASSERT(inSuite, data != endBuf && lastSegment == endBuf);
+        }
+    }
+
+    PacketBuffer::Free(payload);
+    PacketBuffer::Free(data);
+}
+
+void WeaveMessageEncryption_ChainedDecode(nlTestSuite *inSuite, void *inContext)
+{
+    static WeaveFabricState fabricState;
+    static WeaveMessageLayer messageLayer;
+
+    static const uint8_t kEncTypes[] = { kWeaveEncryptionType_None, kWeaveEncryptionType_AES128CTRSHA1 };
+    static const uint16_t kTrailingLens[] = { 0, 4, 64 };
+
+    WEAVE_ERROR err;
+    WeaveMessageLayerTestObject msgLayerTestObject;
+    uint64_t srcNodeId;
+    uint64_t destNodeId = 0x18B4300012345678;
+    uint16_t sessionKeyId = sTestDefaultSessionKeyId;
+
+    InitTestFabricState(inSuite, fabricState, destNodeId, sessionKeyId, srcNodeId);
+
+    messageLayer.FabricState = &fabricState;
+    msgLayerTestObject.msgLayer = &messageLayer;
+
+    for (size_t encIndex = 0; encIndex < sizeof(kEncTypes); encIndex++)
+    {
+        WeaveMessageInfo msgInfo;
+        PacketBuffer *msgBuf;
+        uint8_t stream[kMaxFramedHeaderLen + sizeof(sMsgPayload) + HMACSHA1::kDigestLength + 64];
+        uint16_t frameLen;
+        uint16_t payloadOffset;
+
+        // Encode a message, preceded by its length, as it is sent over a connection.
+        msgBuf = PacketBuffer::New();
+        NL_TEST_ASSERT(inSuite, msgBuf != NULL);
+        if (msgBuf == NULL)
+            continue;
+
+        memcpy(msgBuf->Start(), sMsgPayload, sizeof(sMsgPayload));
+        msgBuf->SetDataLength(sizeof(sMsgPayload));
+
+        msgInfo.Clear();
+        msgInfo.SourceNodeId = srcNodeId;
+        msgInfo.DestNodeId = destNodeId;
+        msgInfo.MessageId = 3;
+        msgInfo.EncryptionType = kEncTypes[encIndex];
+        msgInfo.KeyId = (kEncTypes[encIndex] == kWeaveEncryptionType_None) ? WeaveKeyId::kNone : sessionKeyId;
+        msgInfo.Flags = kWeaveMessageFlag_DestNodeId | kWeaveMessageFlag_SourceNodeId | kWeaveMessageFlag_ReuseMessageId;
+        msgInfo.MessageVersion = kWeaveMessageVersion_V2;
+
+        err = msgLayerTestObject.EncodeMessageWithLength(&msgInfo, msgBuf, NULL, UINT16_MAX);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+        frameLen = msgBuf->DataLength();
+        payloadOffset = frameLen - sizeof(sMsgPayload) -
+                ((kEncTypes[encIndex] == kWeaveEncryptionType_None) ? 0 : HMACSHA1::kDigestLength);
+
+        memcpy(stream, msgBuf->Start(), frameLen);
+        PacketBuffer::Free(msgBuf);
+
+        if (err != WEAVE_NO_ERROR)
+            continue;
+
+        for (size_t trailingIndex = 0; trailingIndex < sizeof(kTrailingLens) / sizeof(kTrailingLens[0]); trailingIndex++)
+        {
+            uint16_t streamLen = frameLen + kTrailingLens[trailingIndex];
+            uint16_t splits[kMaxChainBufs - 1];
+
+            // Data that follows the message in the received stream, such as the start of the next message.
+            for (uint16_t i = frameLen; i < streamLen; i++)
+                stream[i] = static_cast<uint8_t>(0xA0 + i);
+
+            // Split the stream in two, and in three, at every possible offset.  The splits cover a header that is
+            // only partly in the first buffer, a buffer that holds only the header, a payload split across buffers,
+            // an integrity check value split across buffers, and a message that ends part way through a buffer,
+            // with more or fewer payload bytes in that buffer than trailing data.
+            for (splits[0] = 1; splits[0] < streamLen; splits[0]++)
+            {
+                TestChainedDecode(inSuite, msgLayerTestObject, srcNodeId, stream, frameLen, streamLen, payloadOffset, splits, 1);
+
+                for (splits[1] = splits[0] + 1; splits[1] < streamLen; splits[1]++)
+                    TestChainedDecode(inSuite, msgLayerTestObject, srcNodeId, stream, frameLen, streamLen, payloadOffset, splits, 2);
+            }
+        }
+
+        // A corrupted integrity check value is detected when it is split across buffers.
+        if (kEncTypes[encIndex] == kWeaveEncryptionType_AES128CTRSHA1)
+        {
+            uint16_t split = frameLen - HMACSHA1::kDigestLength / 2;
+            PacketBuffer *bufs[2];
+            PacketBuffer *data;
+            PacketBuffer *payload = NULL;
+            uint32_t decodedFrameLen;
+
+            stream[frameLen - 1] ^= 0x01;
+
+            data = MakeChain(stream, frameLen, &split, 1, bufs);
+            NL_TEST_ASSERT(inSuite, data != NULL);
+
+            if (data != NULL)
+            {
+                err = msgLayerTestObject.DecodeMessageWithLength(data, srcNodeId, NULL, &msgInfo, payload, &decodedFrameLen);
+                NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_INTEGRITY_CHECK_FAILED);
+                NL_TEST_ASSERT(inSuite, payload == NULL);
+
+                PacketBuffer::Free(data);
+            }
+        }
+    }
+}
+
+// The payload delivered to the exchange in the chained dispatch test.
+static PacketBuffer *sDispatchedPayload;
+
+static void HandleDispatchedMessage(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo,
+        uint32_t profileId, uint8_t msgType, PacketBuffer *payload)
+{
+    sDispatchedPayload = payload;
+}
+
+// Dispatch a message held in a chain of buffers, as a connection hands it to the exchange manager, to an exchange
+// that accepts chained payloads and to one that doesn't, with the chain split in the exchange header and in the payload.
+void WeaveMessageEncryption_ChainedDispatch(nlTestSuite *inSuite, void *inContext)
+{
+    static WeaveFabricState fabricState;
+    static WeaveMessageLayer messageLayer;
+    static WeaveExchangeManager exchangeMgr;
+    static System::Layer systemLayer;
+
+    static const uint16_t kSplits[] = { 4, 8 + 100 };
+
+    WEAVE_ERROR err;
+    WeaveMessageLayerTestObject msgLayerTestObject;
+    uint64_t srcNodeId;
+    uint64_t destNodeId = 0x18B4300012345678;
+    uint8_t payload[300];
+
+    InitTestFabricState(inSuite, fabricState, destNodeId, sTestDefaultSessionKeyId, srcNodeId);
+
+    // The system layer is left uninitialized; the exchanges only cancel their timers.
+    messageLayer.FabricState = &fabricState;
+    messageLayer.SystemLayer = &systemLayer;
+    msgLayerTestObject.msgLayer = &messageLayer;
+
+    err = exchangeMgr.Init(&messageLayer);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    for (uint16_t i = 0; i < sizeof(payload); i++)
+        payload[i] = static_cast<uint8_t>(i);
+
+    for (size_t splitIndex = 0; splitIndex < sizeof(kSplits) / sizeof(kSplits[0]); splitIndex++)
+    {
+        for (int acceptsChained = 0; acceptsChained <= 1; acceptsChained++)
+        {
+            ExchangeContext *ec;
+            WeaveMessageInfo msgInfo;
+            PacketBuffer *bufs[2];
+            PacketBuffer *msgBuf;
+            uint8_t message[8 + sizeof(payload)];
+            uint16_t split = kSplits[splitIndex];
+            uint8_t *p = message;
+
+            ec = exchangeMgr.NewContext(destNodeId, NULL);
+            NL_TEST_ASSERT(inSuite, ec != NULL);
+            if (ec == NULL)
+                continue;
+
+            ec->OnMessageReceived = HandleDispatchedMessage;
+            ec->SetAcceptsChainedPayloads(acceptsChained != 0);
+
+            // A response from the peer: an exchange header, without the initiator flag, followed by the payload.
+            Write8(p, kWeaveExchangeVersion_V1 << 4);
+            Write8(p, 1);
+            LittleEndian::Write16(p, ec->ExchangeId);
+            LittleEndian::Write32(p, nl::Weave::Profiles::kWeaveProfile_BDX);
+            memcpy(p, payload, sizeof(payload));
+
+            msgBuf = MakeChain(message, sizeof(message), &split, 1, bufs);
+            NL_TEST_ASSERT(inSuite, msgBuf != NULL);
+            if (msgBuf == NULL)
+            {
+                ec->Close();
+                continue;
+            }
+
+            msgInfo.Clear();
+            msgInfo.SourceNodeId = destNodeId;
+            msgInfo.DestNodeId = srcNodeId;
+            msgInfo.MessageId = 3;
+            msgInfo.KeyId = WeaveKeyId::kNone;
+            msgInfo.EncryptionType = kWeaveEncryptionType_None;
+            msgInfo.MessageVersion = kWeaveMessageVersion_V2;
+
+            sDispatchedPayload = NULL;
+
+            msgLayerTestObject.DispatchMessage(&msgInfo, msgBuf);
+
+            NL_TEST_ASSERT(inSuite, sDispatchedPayload != NULL);
+            if (sDispatchedPayload == NULL)
+            {
+                ec->Close();
+                continue;
+            }
+
+            NL_TEST_ASSERT(inSuite, ChainEquals(sDispatchedPayload, payload, sizeof(payload)));
+
+            if (acceptsChained)
+            {
+                // The payload is delivered in the buffers it was received in; only the exchange header is moved.
+                NL_TEST_ASSERT(inSuite, sDispatchedPayload == bufs[0]);
+                NL_TEST_ASSERT(inSuite, sDispatchedPayload->Next() == bufs[1]);
+                NL_TEST_ASSERT(inSuite, ChainCount(sDispatchedPayload) == 2);
+            }
+            else
+            {
+                NL_TEST_ASSERT(inSuite, ChainCount(sDispatchedPayload) == 1);
+            }
+
+            PacketBuffer::Free(sDispatchedPayload);
+            sDispatchedPayload = NULL;
+
+            ec->Close();
+        }
+    }
+
+    exchangeMgr.Shutdown();
+}
+
 int main(int argc, char *argv[])
 {
     static const nlTest tests[] = {
         NL_TEST_DEF("WeaveMessageEncryption",           WeaveMessageEncryption_Test1),
+        NL_TEST_DEF("WeaveMessageChainedDecode",        WeaveMessageEncryption_ChainedDecode),
+        NL_TEST_DEF("WeaveMessageChainedDispatch",      WeaveMessageEncryption_ChainedDispatch),
         NL_TEST_SENTINEL()
     };
 
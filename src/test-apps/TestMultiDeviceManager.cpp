@@ -0,0 +1,352 @@
+/*
+ *
+ *    Copyright (c) 2020 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a provisioning throughput test for the Weave
+ *      Multi-Device Manager. It connects to a set of mock-device instances
+ *      concurrently, runs the same provisioning sequence against each of
+ *      them (PASE, network provisioning, fabric creation and a final ping)
+ *      and reports the aggregate provisioning rate.
+ *
+ */
+
+#define __STDC_FORMAT_MACROS
+#define __STDC_LIMIT_MACROS
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "ToolCommon.h"
+#include <Weave/WeaveVersion.h>
+#include <Weave/Support/CodeUtils.h>
+#include <Weave/Support/ErrorStr.h>
+#include <Weave/DeviceManager/WeaveMultiDeviceManager.h>
+
+using namespace nl::Weave::DeviceManager;
+using nl::Weave::Profiles::NetworkProvisioning::NetworkInfo;
+
+#define TOOL_NAME "TestMultiDeviceManager"
+
+static bool HandleOption(const char *progName, OptionSet *optSet, int id, const char *name, const char *arg);
+static WEAVE_ERROR StartProvisioning(uint32_t index);
+static void HandleStepComplete(DeviceSession *session, void *appReqState, WEAVE_ERROR err, DeviceStatus *devStatus);
+
+enum
+{
+    kMaxDevices = 64
+};
+
+struct TestDevice
+{
+    uint64_t NodeId;
+    IPAddress Addr;
+    uint64_t StartTimeMs;
+    uint64_t EndTimeMs;
+    WEAVE_ERROR Result;
+    bool Finished;
+};
+
+static TestDevice gDevices[kMaxDevices];
+static uint32_t gNumDevices = 0;
+static uint32_t gNumFinished = 0;
+static const char *gDevicePairingCode = "TEST";
+static const char *gWiFiSSID = "Test-Network";
+static const char *gWiFiKey = "Test-Key";
+static bool gProvisionNetwork = true;
+static bool gCreateFabric = true;
+
+static WeaveMultiDeviceManager gMultiDeviceMgr;
+static NetworkInfo gNetworkInfo;
+
+enum
+{
+    kToolOpt_Device                  = 1000,
+    kToolOpt_DevicePairingCode       = 1001,
+    kToolOpt_WiFiSSID                = 1002,
+    kToolOpt_WiFiKey                 = 1003,
+    kToolOpt_NoNetwork               = 1004,
+    kToolOpt_NoFabric                = 1005,
+};
+
+static OptionDef gToolOptionDefs[] =
+{
+    { "device",                 kArgumentRequired, kToolOpt_Device              },
+    { "device-pairing-code",    kArgumentRequired, kToolOpt_DevicePairingCode   },
+    { "ssid",                   kArgumentRequired, kToolOpt_WiFiSSID            },
+    { "wifi-key",               kArgumentRequired, kToolOpt_WiFiKey             },
+    { "no-network",             kNoArgument,       kToolOpt_NoNetwork           },
+    { "no-fabric",              kNoArgument,       kToolOpt_NoFabric            },
+    { }
+};
+
+static const char *const gToolOptionHelp =
+    "  --device <node-id>,<ip-addr>\n"
+    "       Provision the mock device with the given node id, listening at the given\n"
+    "       address. May be given multiple times; all devices are provisioned\n"
+    "       concurrently.\n"
+    "\n"
+    "  --device-pairing-code <string>\n"
+    "       The pairing code of the devices. Defaults to TEST.\n"
+    "\n"
+    "  --ssid <string>\n"
+    "  --wifi-key <string>\n"
+    "       The WiFi network to provision on each device.\n"
+    "\n"
+    "  --no-network\n"
+    "       Skip network provisioning.\n"
+    "\n"
+    "  --no-fabric\n"
+    "       Skip fabric creation.\n"
+    "\n";
+
+static OptionSet gToolOptions =
+{
+    HandleOption,
+    gToolOptionDefs,
+    "GENERAL OPTIONS",
+    gToolOptionHelp
+};
+
+static HelpOptions gHelpOptions(
+    TOOL_NAME,
+    "Usage: " TOOL_NAME " [<options...>] --device <node-id>,<ip-addr> [--device ...]\n",
+    WEAVE_VERSION_STRING "\n" WEAVE_TOOL_COPYRIGHT,
+    "Provision several mock devices concurrently with a single Weave Multi-Device Manager.\n"
+);
+
+static OptionSet *gToolOptionSets[] =
+{
+    &gToolOptions,
+    &gNetworkOptions,
+    &gWeaveNodeOptions,
+    &gFaultInjectionOptions,
+    &gHelpOptions,
+    NULL
+};
+
+int main(int argc, char *argv[])
+{
+    WEAVE_ERROR err;
+    uint64_t startTimeMs;
+    uint64_t elapsedMs;
+    uint32_t numSucceeded = 0;
+
+    InitToolCommon();
+
+    SetSIGUSR1Handler();
+
+    if (!ParseArgs(TOOL_NAME, argc, argv, gToolOptionSets) ||
+        !ResolveWeaveNetworkOptions(TOOL_NAME, gWeaveNodeOptions, gNetworkOptions))
+    {
+        exit(EXIT_FAILURE);
+    }
+
+    if (gNumDevices == 0)
+    {
+        PrintArgError("%s: Please specify at least one device with --device\n", TOOL_NAME);
+        exit(EXIT_FAILURE);
+    }
+
+    InitSystemLayer();
+
+    InitNetwork();
+
+    InitWeaveStack(false, true);
+
+    gNetworkInfo.NetworkType = kNetworkType_WiFi;
+    gNetworkInfo.WiFiSSID = strdup(gWiFiSSID);
+    gNetworkInfo.WiFiMode = kWiFiMode_Managed;
+    gNetworkInfo.WiFiRole = kWiFiRole_Station;
+    gNetworkInfo.WiFiSecurityType = kWiFiSecurityType_WPA2Personal;
+    gNetworkInfo.WiFiKeyLen = strlen(gWiFiKey);
+    gNetworkInfo.WiFiKey = reinterpret_cast<uint8_t *>(strdup(gWiFiKey));
+
+    err = gMultiDeviceMgr.Init(&ExchangeMgr, &SecurityMgr, gNumDevices);
+    FAIL_ERROR(err, "WeaveMultiDeviceManager::Init failed");
+
+    startTimeMs = NowMs();
+
+    for (uint32_t i = 0; i < gNumDevices; i++)
+    {
+        err = StartProvisioning(i);
+        if (err != WEAVE_NO_ERROR)
+        {
+            gDevices[i].Result = err;
+            gDevices[i].Finished = true;
+            gNumFinished++;
+        }
+    }
+
+    Done = (gNumFinished == gNumDevices);
+
+    ServiceNetworkUntil(&Done, NULL);
+
+    elapsedMs = NowMs() - startTimeMs;
+
+    for (uint32_t i = 0; i < gNumDevices; i++)
+    {
+        TestDevice &dev = gDevices[i];
+
+        if (dev.Result == WEAVE_NO_ERROR)
+        {
+            numSucceeded++;
+            printf("Device %016" PRIX64 " provisioned in %" PRIu64 " ms\n", dev.NodeId, dev.EndTimeMs - dev.StartTimeMs);
+        }
+        else
+        {
+            printf("Device %016" PRIX64 " failed: %s\n", dev.NodeId, nl::ErrorStr(dev.Result));
+        }
+    }
+
+    printf("%" PRIu32 " of %" PRIu32 " devices provisioned in %" PRIu64 " ms: %.2f devices/s\n",
+           numSucceeded, gNumDevices, elapsedMs, (elapsedMs > 0) ? (numSucceeded * 1000.0) / elapsedMs : 0.0);
+
+    gMultiDeviceMgr.Shutdown();
+
+    ShutdownWeaveStack();
+    ShutdownNetwork();
+    ShutdownSystemLayer();
+
+    return (numSucceeded == gNumDevices) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static WEAVE_ERROR StartProvisioning(uint32_t index)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    TestDevice &dev = gDevices[index];
+    DeviceSession *session = NULL;
+
+    dev.StartTimeMs = NowMs();
+
+    err = gMultiDeviceMgr.NewSession(session);
+    SuccessOrExit(err);
+
+    session->AppState = &dev;
+
+    // Queue the whole provisioning sequence up front; the session issues each step as the previous one completes.
+    err = session->ConnectDevice(dev.NodeId, dev.Addr, gDevicePairingCode, NULL, HandleStepComplete);
+    SuccessOrExit(err);
+
+    if (gProvisionNetwork)
+    {
+        err = session->AddNetwork(&gNetworkInfo, NULL, HandleStepComplete);
+        SuccessOrExit(err);
+
+        err = session->EnableNetwork(DeviceSession::kLastAddedNetworkId, NULL, HandleStepComplete);
+        SuccessOrExit(err);
+    }
+
+    if (gCreateFabric)
+    {
+        err = session->CreateFabric(NULL, HandleStepComplete);
+        SuccessOrExit(err);
+    }
+
+    err = session->Ping(&dev, HandleStepComplete);
+    SuccessOrExit(err);
+
+exit:
+    if (err != WEAVE_NO_ERROR && session != NULL)
+    {
+        gMultiDeviceMgr.ReleaseSession(session);
+    }
+
+    return err;
+}
+
+static void HandleStepComplete(DeviceSession *session, void *appReqState, WEAVE_ERROR err, DeviceStatus *devStatus)
+{
+    TestDevice &dev = *static_cast<TestDevice *>(session->AppState);
+
+    // The final step carries the device as its request state; any failure ends the sequence.
+    if (dev.Finished || (err == WEAVE_NO_ERROR && appReqState == NULL))
+    {
+        return;
+    }
+
+    dev.Result = err;
+    dev.EndTimeMs = NowMs();
+    dev.Finished = true;
+
+    gMultiDeviceMgr.ReleaseSession(session);
+
+    if (++gNumFinished == gNumDevices)
+    {
+        Done = true;
+    }
+}
+
+bool HandleOption(const char *progName, OptionSet *optSet, int id, const char *name, const char *arg)
+{
+    switch (id)
+    {
+    case kToolOpt_Device:
+    {
+        const char *sep = strchr(arg, ',');
+        char nodeIdStr[32];
+
+        if (gNumDevices == kMaxDevices)
+        {
+            PrintArgError("%s: Too many devices specified (max %d)\n", progName, kMaxDevices);
+            return false;
+        }
+
+        if (sep == NULL || (size_t)(sep - arg) >= sizeof(nodeIdStr))
+        {
+            PrintArgError("%s: Invalid value specified for device: %s\n", progName, arg);
+            return false;
+        }
+
+        memcpy(nodeIdStr, arg, sep - arg);
+        nodeIdStr[sep - arg] = 0;
+
+        if (!ParseNodeId(nodeIdStr, gDevices[gNumDevices].NodeId) || !IPAddress::FromString(sep + 1, gDevices[gNumDevices].Addr))
+        {
+            PrintArgError("%s: Invalid value specified for device: %s\n", progName, arg);
+            return false;
+        }
+
+        gDevices[gNumDevices].Result = WEAVE_NO_ERROR;
+        gDevices[gNumDevices].Finished = false;
+        gNumDevices++;
+        break;
+    }
+    case kToolOpt_DevicePairingCode:
+        gDevicePairingCode = arg;
+        break;
+    case kToolOpt_WiFiSSID:
+        gWiFiSSID = arg;
+        break;
+    case kToolOpt_WiFiKey:
+        gWiFiKey = arg;
+        break;
+    case kToolOpt_NoNetwork:
+        gProvisionNetwork = false;
+        break;
+    case kToolOpt_NoFabric:
+        gCreateFabric = false;
+        break;
+    default:
+        PrintArgError("%s: INTERNAL ERROR: Unhandled option: %s\n", progName, name);
+        return false;
+    }
+
+    return true;
+}
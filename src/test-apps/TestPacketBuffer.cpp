@@ -636,6 +636,89 @@ static void CheckCompactHead(nlTestSuite *inSuite, void *inContext)
     }
 }
 
+/**
+ *  Test PacketBuffer::PullUpHead() function.
+ *
+ *  Description: Take two different buffers and chain them together, with
+ *               various initial lengths.  For every value from sLengths[],
+ *               pull that many bytes up into the first buffer.  Then,
+ *               verify that the pull-up succeeds exactly when the chain
+ *               holds enough data and the first buffer has room for it,
+ *               that only the requested data is moved, and that the total
+ *               length of the chain is preserved.
+ */
+static void CheckPullUpHead(nlTestSuite *inSuite, void *inContext)
+{
+    struct TestContext *theFirstContext = static_cast<struct TestContext *>(inContext);
+
+    for (size_t ith = 0; ith < kTestElements; ith++)
+    {
+        struct TestContext *theSecondContext = static_cast<struct TestContext *>(inContext);
+
+        for (size_t jth = 0; jth < kTestElements; jth++)
+        {
+            if (theFirstContext == theSecondContext)
+            {
+                theSecondContext++;
+                continue;
+            }
+
+            for (size_t k = 0; k < kTestLengths; k++)
+            {
+                for (size_t l = 0; l < kTestLengths; l++)
+                {
+                    for (size_t m = 0; m < kTestLengths; m++)
+                    {
+                        PacketBuffer *buffer_1 = PrepareTestBuffer(theFirstContext);
+                        PacketBuffer *buffer_2 = PrepareTestBuffer(theSecondContext);
+                        uint16_t len1, totLen;
+                        bool pulledUp;
+
+                        theFirstContext->buf->next = theSecondContext->buf;
+
+                        buffer_1->SetDataLength(sLengths[k], buffer_1);
+                        buffer_2->SetDataLength(sLengths[l], buffer_1);
+                        len1 = buffer_1->DataLength();
+                        totLen = buffer_1->TotalLength();
+
+                        pulledUp = buffer_1->PullUpHead(sLengths[m]);
+
+                        NL_TEST_ASSERT(inSuite, pulledUp == (sLengths[m] <= totLen && sLengths[m] <= buffer_1->AllocSize()));
+                        NL_TEST_ASSERT(inSuite, buffer_1->TotalLength() == totLen);
+
+                        if (pulledUp && sLengths[m] > len1)
+                        {
+                            NL_TEST_ASSERT(inSuite, buffer_1->DataLength() == sLengths[m]);
+
+                            if (sLengths[m] == totLen)
+                            {
+                                /* make sure the second buffer is freed */
+                                NL_TEST_ASSERT(inSuite, theFirstContext->buf->next == NULL);
+                                theSecondContext->buf = NULL;
+                            }
+                            else
+                            {
+                                NL_TEST_ASSERT(inSuite, theFirstContext->buf->next == theSecondContext->buf);
+                                NL_TEST_ASSERT(inSuite, buffer_2->DataLength() == totLen - sLengths[m]);
+                            }
+                        }
+                        else
+                        {
+                            NL_TEST_ASSERT(inSuite, buffer_1->DataLength() == len1);
+                        }
+
+                        theFirstContext->buf->next = NULL;
+                    }
+                }
+            }
+
+            theSecondContext++;
+        }
+
+        theFirstContext++;
+    }
+}
+
 /**
  *  Test PacketBuffer::ConsumeHead() function.
  *
@@ -1124,6 +1207,7 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("PacketBuffer::AddToEnd",                       CheckAddToEnd),
     NL_TEST_DEF("PacketBuffer::DetachTail",                     CheckDetachTail),
     NL_TEST_DEF("PacketBuffer::CompactHead",                    CheckCompactHead),
+    NL_TEST_DEF("PacketBuffer::PullUpHead",                     CheckPullUpHead),
     NL_TEST_DEF("PacketBuffer::ConsumeHead",                    CheckConsumeHead),
     NL_TEST_DEF("PacketBuffer::Consume",                        CheckConsume),
     NL_TEST_DEF("PacketBuffer::EnsureReservedSize",             CheckEnsureReservedSize),
@@ -102,6 +102,8 @@ class TraitPathStoreTest {
         void TestFlags(nlTestSuite *inSuite, void *inContext);
         void TestInsertItem(nlTestSuite *inSuite, void *inContext);
         void TestSetFailedTrait(nlTestSuite *inSuite, void *inContext);
+        void TestBuckets(nlTestSuite *inSuite, void *inContext);
+        void TestUpdateStoreSize(nlTestSuite *inSuite, void *inContext);
 };
 
 TraitPathStoreTest::TraitPathStoreTest() :
@@ -644,6 +646,121 @@ void TraitPathStoreTest::TestSetFailedTrait(nlTestSuite *inSuite, void *inContex
     mStore.Clear();
 }
 
+void TraitPathStoreTest::TestBuckets(nlTestSuite *inSuite, void *inContext)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    TraitPath tp;
+    size_t i;
+    size_t count;
+    // Hashes to the same bucket as mTDH1
+    TraitDataHandle collidingTDH = mTDH1 + ArraySize(mStorage);
+    PropertyPathHandle dictItem = mSchemaEngine->GetDictionaryItemHandle(CreatePropertyPathHandle(TestHTrait::kPropertyHandle_K_Sa), 1);
+    PropertyPathHandle dictItemChild = CreatePropertyPathHandle(TestHTrait::kPropertyHandle_K_Sa_Value_Da, 1);
+
+    mStore.Clear();
+
+    // Interleave the paths of two trait instances in the same bucket
+    for (i = 0; i < 3; i++)
+    {
+        err = mStore.AddItem(TraitPath(mTDH1, CreatePropertyPathHandle(TestHTrait::kPropertyHandle_I)));
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+        err = mStore.AddItem(TraitPath(collidingTDH, dictItemChild));
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    }
+
+    NL_TEST_ASSERT(inSuite, mStore.IsPresent(TraitPath(collidingTDH, dictItemChild)));
+    NL_TEST_ASSERT(inSuite, false == mStore.IsPresent(TraitPath(mTDH1, dictItemChild)));
+    NL_TEST_ASSERT(inSuite, false == mStore.IsPresent(TraitPath(collidingTDH, CreatePropertyPathHandle(TestHTrait::kPropertyHandle_I))));
+
+    // Includes and Intersects only look at the paths of the same trait instance
+    NL_TEST_ASSERT(inSuite, false == mStore.Includes(TraitPath(mTDH1, dictItemChild), mSchemaEngine));
+    NL_TEST_ASSERT(inSuite, false == mStore.Intersects(TraitPath(mTDH1, dictItem), mSchemaEngine));
+    NL_TEST_ASSERT(inSuite, mStore.Intersects(TraitPath(collidingTDH, dictItem), mSchemaEngine));
+    NL_TEST_ASSERT(inSuite, mStore.Intersects(TraitPath(collidingTDH, kRootPropertyPathHandle), mSchemaEngine));
+    NL_TEST_ASSERT(inSuite, false == mStore.Intersects(TraitPath(collidingTDH,
+                    mSchemaEngine->GetDictionaryItemHandle(CreatePropertyPathHandle(TestHTrait::kPropertyHandle_K_Sa), 2)), mSchemaEngine));
+
+    // Remove the items of one trait instance while iterating on them
+    count = 0;
+    for (i = mStore.GetFirstValidItem(mTDH1); i < mStore.GetPathStoreSize(); i = mStore.GetNextValidItem(i, mTDH1))
+    {
+        mStore.RemoveItemAt(i);
+        count++;
+    }
+    NL_TEST_ASSERT(inSuite, 3 == count);
+    NL_TEST_ASSERT(inSuite, false == mStore.IsTraitPresent(mTDH1));
+    NL_TEST_ASSERT(inSuite, 3 == mStore.GetNumItems());
+
+    // The free items are reused
+    err = mStore.AddItem(TraitPath(mTDH1, CreatePropertyPathHandle(TestHTrait::kPropertyHandle_K)));
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, 0 == mStore.GetFirstValidItem(mTDH1));
+
+    // AddItemDedup replaces the dictionary item paths with their ancestor
+    err = mStore.AddItemDedup(TraitPath(collidingTDH, dictItem), mSchemaEngine);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, false == mStore.IsPresent(TraitPath(collidingTDH, dictItemChild)));
+    NL_TEST_ASSERT(inSuite, mStore.IsPresent(TraitPath(collidingTDH, dictItem)));
+    NL_TEST_ASSERT(inSuite, mStore.Includes(TraitPath(collidingTDH, dictItemChild), mSchemaEngine));
+    NL_TEST_ASSERT(inSuite, 2 == mStore.GetNumItems());
+
+    // Moving the items keeps the index consistent
+    mStore.Compact();
+
+    err = mStore.InsertItemAt(0, TraitPath(collidingTDH, CreatePropertyPathHandle(TestHTrait::kPropertyHandle_L)), TraitPathStore::kFlag_None);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    count = 0;
+    for (i = mStore.GetFirstValidItem(collidingTDH); i < mStore.GetPathStoreSize(); i = mStore.GetNextValidItem(i, collidingTDH))
+    {
+        mStore.GetItemAt(i, tp);
+        NL_TEST_ASSERT(inSuite, collidingTDH == tp.mTraitDataHandle);
+        count++;
+    }
+    NL_TEST_ASSERT(inSuite, 2 == count);
+    NL_TEST_ASSERT(inSuite, 0 == mStore.GetFirstValidItem(collidingTDH));
+    NL_TEST_ASSERT(inSuite, mStore.IsPresent(TraitPath(mTDH1, CreatePropertyPathHandle(TestHTrait::kPropertyHandle_K))));
+    NL_TEST_ASSERT(inSuite, mStore.Includes(TraitPath(collidingTDH, dictItemChild), mSchemaEngine));
+
+    mStore.Clear();
+}
+
+// Any store up to the configured maximum size, which covers the update path stores of the
+// subscription client, must be indexable all the way to its last item.
+void TraitPathStoreTest::TestUpdateStoreSize(nlTestSuite *inSuite, void *inContext)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    static TraitPathStore::Record storage[TraitPathStore::kMaxStoreSize];
+    TraitPathStore store;
+    const size_t last = ArraySize(storage) - 1;
+    TraitPath tp;
+    size_t i;
+
+    NL_TEST_ASSERT(inSuite, WDM_UPDATE_MAX_ITEMS_IN_TRAIT_DIRTY_PATH_STORE <= TraitPathStore::kMaxStoreSize);
+    NL_TEST_ASSERT(inSuite, TraitPathStore::kMaxStoreSize < TraitPathStore::kNullIndex);
+
+    store.Init(storage, ArraySize(storage));
+
+    for (i = 0; i < ArraySize(storage); i++)
+    {
+        err = store.AddItem(TraitPath(static_cast<TraitDataHandle>(i), kRootPropertyPathHandle));
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    }
+
+    NL_TEST_ASSERT(inSuite, store.IsFull());
+    NL_TEST_ASSERT(inSuite, store.IsPresent(TraitPath(static_cast<TraitDataHandle>(last), kRootPropertyPathHandle)));
+    NL_TEST_ASSERT(inSuite, last == store.GetFirstValidItem(static_cast<TraitDataHandle>(last)));
+
+    // Relinking after a move has to carry the wide indices too
+    store.RemoveItemAt(0);
+    store.Compact();
+
+    NL_TEST_ASSERT(inSuite, last - 1 == store.GetFirstValidItem(static_cast<TraitDataHandle>(last)));
+    store.GetItemAt(last - 1, tp);
+    NL_TEST_ASSERT(inSuite, static_cast<TraitDataHandle>(last) == tp.mTraitDataHandle);
+    NL_TEST_ASSERT(inSuite, false == store.IsTraitPresent(0));
+}
+
 } // WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current)
 }
 }
@@ -720,6 +837,16 @@ void TraitPathStoreTest_SetFailedTrait(nlTestSuite *inSuite, void *inContext)
     gPathStoreTest.TestSetFailedTrait(inSuite, inContext);
 }
 
+void TraitPathStoreTest_Buckets(nlTestSuite *inSuite, void *inContext)
+{
+    gPathStoreTest.TestBuckets(inSuite, inContext);
+}
+
+void TraitPathStoreTest_UpdateStoreSize(nlTestSuite *inSuite, void *inContext)
+{
+    gPathStoreTest.TestUpdateStoreSize(inSuite, inContext);
+}
+
 // Test Suite
 
 /**
@@ -738,6 +865,8 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Flags",  TraitPathStoreTest_Flags),
     NL_TEST_DEF("InsertItem",  TraitPathStoreTest_InsertItem),
     NL_TEST_DEF("SetFailedTrait",  TraitPathStoreTest_SetFailedTrait),
+    NL_TEST_DEF("Buckets",  TraitPathStoreTest_Buckets),
+    NL_TEST_DEF("UpdateStoreSize",  TraitPathStoreTest_UpdateStoreSize),
 
     NL_TEST_SENTINEL()
 };
@@ -173,6 +173,145 @@ static void CheckWriteNextCounterStart(nlTestSuite *inSuite, void *inContext)
     NL_TEST_ASSERT(inSuite, value == 0x20000);
 }
 
+static void CheckReserve(nlTestSuite *inSuite, void *inContext)
+{
+    TestPersistedCounterContext *context = static_cast<TestPersistedCounterContext *>(inContext);
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    nl::Weave::PersistedCounter counter, counter2;
+    const char *testKey = "testcounter";
+    uint32_t firstValue = 0;
+    uint64_t value = 0;
+
+    InitializePersistedStorage(context);
+
+    err = counter.Init(testKey, 0x100);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, counter.GetWriteCount() == 1);
+
+    // A reservation within the current epoch doesn't write anything.
+
+    err = counter.Reserve(0x10, firstValue);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, firstValue == 0);
+    NL_TEST_ASSERT(inSuite, counter.GetValue() == 0x10);
+    NL_TEST_ASSERT(inSuite, counter.GetWriteCount() == 1);
+
+    // A reservation spanning several epochs takes a single write.
+
+    err = counter.Reserve(0x1000, firstValue);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, firstValue == 0x10);
+    NL_TEST_ASSERT(inSuite, counter.GetValue() == 0x1010);
+    NL_TEST_ASSERT(inSuite, counter.GetWriteCount() == 2);
+
+    err = counter.Reserve(0, firstValue);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_INVALID_INTEGER_VALUE);
+
+    // After a "reboot", no reserved value is vended again.
+
+    err = counter2.Init(testKey, 0x100);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    value = counter2.GetValue();
+    NL_TEST_ASSERT(inSuite, value == 0x1110);
+}
+
+static void CheckBatch(nlTestSuite *inSuite, void *inContext)
+{
+    TestPersistedCounterContext *context = static_cast<TestPersistedCounterContext *>(inContext);
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    nl::Weave::PersistedStorageBatch batch;
+    nl::Weave::PersistedCounter counter1, counter2, counter3;
+    const char *testKey1 = "testcounter1";
+    const char *testKey2 = "testcounter2";
+    const char *testKey3 = "testcounter3";
+    uint32_t storedValue = 0;
+
+    InitializePersistedStorage(context);
+
+    err = counter1.Init(testKey1, 0x100);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    err = counter2.Init(testKey2, 0x100);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = batch.AddCounter(counter1);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    err = batch.AddCounter(counter2);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    err = batch.AddCounter(counter2);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_INCORRECT_STATE);
+
+    // Move counter2 more than half way through its epoch.
+
+    for (int32_t i = 0; i < 0xC0; i++)
+    {
+        err = counter2.Advance();
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, batch.GetStats().mFlushCount == 0);
+
+    // When counter1 starts a new epoch, counter2 starts one in the same flush.
+
+    for (int32_t i = 0; i < 0x100; i++)
+    {
+        err = counter1.Advance();
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    }
+
+    NL_TEST_ASSERT(inSuite, batch.GetStats().mFlushCount == 1);
+    NL_TEST_ASSERT(inSuite, batch.GetStats().mValueWriteCount == 2);
+    NL_TEST_ASSERT(inSuite, batch.GetStats().mEarlyAdvanceCount == 1);
+    NL_TEST_ASSERT(inSuite, counter1.GetWriteCount() == 2);
+    NL_TEST_ASSERT(inSuite, counter2.GetWriteCount() == 2);
+
+    err = nl::Weave::Platform::PersistedStorage::Read(testKey1, storedValue);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR && storedValue == 0x200);
+    err = nl::Weave::Platform::PersistedStorage::Read(testKey2, storedValue);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR && storedValue == 0x1C0);
+
+    // counter2 now has a full epoch ahead of it before it writes again.
+
+    for (int32_t i = 0; i < 0xFF; i++)
+    {
+        err = counter2.Advance();
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, batch.GetStats().mFlushCount == 1);
+
+    err = counter2.Advance();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, counter2.GetValue() == 0x1C0);
+    NL_TEST_ASSERT(inSuite, batch.GetStats().mFlushCount == 2);
+
+    // Staged values for the same key are coalesced into one write.
+
+    err = counter3.Init(testKey3, 0x100);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = batch.Stage(testKey3, 0x1000);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    err = batch.Stage(testKey3, 0x2000);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, batch.GetStats().mCoalescedWriteCount == 1);
+
+    // Keys are matched by value, not by the buffer holding them.
+    {
+        char testKey3Copy[sizeof("testcounter3")];
+
+        strcpy(testKey3Copy, testKey3);
+        err = batch.Stage(testKey3Copy, 0x3000);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, batch.GetStats().mCoalescedWriteCount == 2);
+    }
+
+    err = batch.Flush();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, batch.GetStats().mFlushCount == 3);
+
+    err = nl::Weave::Platform::PersistedStorage::Read(testKey3, storedValue);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR && storedValue == 0x3000);
+}
+
 // Test Suite
 
 /**
@@ -182,6 +321,8 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Out of box Test", CheckOOB),
     NL_TEST_DEF("Reboot Test", CheckReboot),
     NL_TEST_DEF("Write Next Counter Start Test", CheckWriteNextCounterStart),
+    NL_TEST_DEF("Reserve Test", CheckReserve),
+    NL_TEST_DEF("Batch Test", CheckBatch),
 
     NL_TEST_SENTINEL()
 };
@@ -0,0 +1,320 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This is a unit test suite for the latency histograms of
+ *      <tt>nl::Weave::System::Stats</tt> and their TLV encoding by
+ *      <tt>nl::Weave::Stats::WriteLatencySnapshot</tt>.
+ *
+ */
+
+#ifndef __STDC_LIMIT_MACROS
+#define __STDC_LIMIT_MACROS
+#endif
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <SystemLayer/SystemConfig.h>
+#include <SystemLayer/SystemStats.h>
+
+#include <Weave/Core/WeaveTLV.h>
+#include <Weave/Core/WeaveStats.h>
+
+#include <nlunit-test.h>
+
+#if WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
+
+using namespace nl::Weave::System::Stats;
+using namespace nl::Weave::TLV;
+
+using nl::Weave::Stats::WriteLatencySnapshot;
+using nl::Weave::Stats::kTag_LatencyCount;
+using nl::Weave::Stats::kTag_LatencyMax;
+using nl::Weave::Stats::kTag_LatencyTotal;
+using nl::Weave::Stats::kTag_LatencyBuckets;
+
+static const LatencyPoint kTestPoint = kLatency_MessageEncode;
+
+static const LatencyHistogram &GetTestHistogram(LatencySnapshot &aSnapshot)
+{
+    UpdateLatencySnapshot(aSnapshot);
+
+    return aSnapshot.mHistograms[kTestPoint];
+}
+
+// Test Sets
+
+static void CheckBucketBoundaries(nlTestSuite *inSuite, void *inContext)
+{
+    static const struct
+    {
+        uint64_t mLatencyUS;
+        unsigned int mBucket;
+    } kCases[] =
+    {
+        { 0,                            0 },
+        { 1,                            1 },
+        { 2,                            2 },
+        { 3,                            2 },
+        { 4,                            3 },
+        { 1000,                         10 },
+        { 1023,                         10 },
+        { 1024,                         11 },
+        { (1ULL << 21) - 1,             21 },
+        { 1ULL << 21,                   22 },
+        { 1ULL << 22,                   kLatency_NumBuckets - 1 },
+    };
+
+    LatencySnapshot lSnapshot;
+
+    for (size_t i = 0; i < sizeof(kCases) / sizeof(kCases[0]); i++)
+    {
+        ResetLatency();
+        RecordLatency(kTestPoint, kCases[i].mLatencyUS);
+
+        const LatencyHistogram &lHistogram = GetTestHistogram(lSnapshot);
+
+        NL_TEST_ASSERT(inSuite, lHistogram.mCount == 1);
+        NL_TEST_ASSERT(inSuite, lHistogram.mBuckets[kCases[i].mBucket] == 1);
+        NL_TEST_ASSERT(inSuite, lHistogram.mMaxUS == kCases[i].mLatencyUS);
+        NL_TEST_ASSERT(inSuite, lHistogram.mTotalUS == kCases[i].mLatencyUS);
+    }
+}
+
+static void CheckOverflow(nlTestSuite *inSuite, void *inContext)
+{
+    const uint64_t kLongLatencyUS = 1ULL << 40;
+    LatencySnapshot lSnapshot;
+
+    ResetLatency();
+
+    // Anything beyond the range of the histogram lands in the last bucket, and the longest latency saturates.
+    RecordLatency(kTestPoint, (1ULL << (kLatency_NumBuckets - 1)) - 1);
+    RecordLatency(kTestPoint, 1ULL << kLatency_NumBuckets);
+    RecordLatency(kTestPoint, kLongLatencyUS);
+
+    const LatencyHistogram &lHistogram = GetTestHistogram(lSnapshot);
+
+    NL_TEST_ASSERT(inSuite, lHistogram.mCount == 3);
+    NL_TEST_ASSERT(inSuite, lHistogram.mBuckets[kLatency_NumBuckets - 1] == 3);
+    NL_TEST_ASSERT(inSuite, lHistogram.mMaxUS == UINT32_MAX);
+
+    // The total keeps the full latencies.
+    NL_TEST_ASSERT(inSuite, lHistogram.mTotalUS ==
+                   ((1ULL << (kLatency_NumBuckets - 1)) - 1) + (1ULL << kLatency_NumBuckets) + kLongLatencyUS);
+}
+
+static void CheckSnapshotAndReset(nlTestSuite *inSuite, void *inContext)
+{
+    LatencySnapshot lSnapshot;
+
+    ResetLatency();
+
+    RecordLatency(kTestPoint, 5);
+    RecordLatency(kTestPoint, 7);
+    RecordLatency(kLatency_TimerLateness, 2000);
+
+    UpdateLatencySnapshot(lSnapshot);
+
+    NL_TEST_ASSERT(inSuite, lSnapshot.mHistograms[kTestPoint].mCount == 2);
+    NL_TEST_ASSERT(inSuite, lSnapshot.mHistograms[kTestPoint].mBuckets[3] == 2);
+    NL_TEST_ASSERT(inSuite, lSnapshot.mHistograms[kTestPoint].mMaxUS == 7);
+    NL_TEST_ASSERT(inSuite, lSnapshot.mHistograms[kTestPoint].mTotalUS == 12);
+    NL_TEST_ASSERT(inSuite, lSnapshot.mHistograms[kLatency_TimerLateness].mCount == 1);
+    NL_TEST_ASSERT(inSuite, lSnapshot.mHistograms[kLatency_TimerLateness].mBuckets[11] == 1);
+    NL_TEST_ASSERT(inSuite, lSnapshot.mHistograms[kLatency_HandlerExecution].mCount == 0);
+
+    ResetLatency();
+    UpdateLatencySnapshot(lSnapshot);
+
+    for (int i = 0; i < kLatency_NumPoints; i++)
+    {
+        NL_TEST_ASSERT(inSuite, lSnapshot.mHistograms[i].mCount == 0);
+        NL_TEST_ASSERT(inSuite, lSnapshot.mHistograms[i].mTotalUS == 0);
+    }
+
+    NL_TEST_ASSERT(inSuite, GetLatencyStrings()[kLatency_NumPoints - 1] != NULL);
+}
+
+static void CheckWriteLatencySnapshot(nlTestSuite *inSuite, void *inContext)
+{
+    uint8_t lBuffer[512];
+    TLVWriter lWriter;
+    TLVReader lReader;
+    TLVType lSnapshotContainer;
+    TLVType lPointContainer;
+    TLVType lBucketsContainer;
+    LatencySnapshot lSnapshot;
+    uint32_t lValue;
+    uint64_t lTotal;
+    WEAVE_ERROR lError;
+
+    ResetLatency();
+
+    // Buckets 0, 2 and 3 of the test point, nothing anywhere else.
+    RecordLatency(kTestPoint, 0);
+    RecordLatency(kTestPoint, 3);
+    RecordLatency(kTestPoint, 6);
+    RecordLatency(kTestPoint, 7);
+
+    UpdateLatencySnapshot(lSnapshot);
+
+    lWriter.Init(lBuffer, sizeof(lBuffer));
+
+    lError = WriteLatencySnapshot(lWriter, AnonymousTag, lSnapshot);
+    NL_TEST_ASSERT(inSuite, lError == WEAVE_NO_ERROR);
+
+    lError = lWriter.Finalize();
+    NL_TEST_ASSERT(inSuite, lError == WEAVE_NO_ERROR);
+
+    lReader.Init(lBuffer, lWriter.GetLengthWritten());
+
+    lError = lReader.Next(kTLVType_Structure, AnonymousTag);
+    NL_TEST_ASSERT(inSuite, lError == WEAVE_NO_ERROR);
+
+    lError = lReader.EnterContainer(lSnapshotContainer);
+    NL_TEST_ASSERT(inSuite, lError == WEAVE_NO_ERROR);
+
+    // Only the test point is written.
+    lError = lReader.Next(kTLVType_Structure, ContextTag(kTestPoint));
+    NL_TEST_ASSERT(inSuite, lError == WEAVE_NO_ERROR);
+
+    lError = lReader.EnterContainer(lPointContainer);
+    NL_TEST_ASSERT(inSuite, lError == WEAVE_NO_ERROR);
+
+    lError = lReader.Next(kTLVType_UnsignedInteger, ContextTag(kTag_LatencyCount));
+    NL_TEST_ASSERT(inSuite, lError == WEAVE_NO_ERROR);
+    lError = lReader.Get(lValue);
+    NL_TEST_ASSERT(inSuite, lError == WEAVE_NO_ERROR && lValue == 4);
+
+    lError = lReader.Next(kTLVType_UnsignedInteger, ContextTag(kTag_LatencyMax));
+    NL_TEST_ASSERT(inSuite, lError == WEAVE_NO_ERROR);
+    lError = lReader.Get(lValue);
+    NL_TEST_ASSERT(inSuite, lError == WEAVE_NO_ERROR && lValue == 7);
+
+    lError = lReader.Next(kTLVType_UnsignedInteger, ContextTag(kTag_LatencyTotal));
+    NL_TEST_ASSERT(inSuite, lError == WEAVE_NO_ERROR);
+    lError = lReader.Get(lTotal);
+    NL_TEST_ASSERT(inSuite, lError == WEAVE_NO_ERROR && lTotal == 16);
+
+    lError = lReader.Next(kTLVType_Array, ContextTag(kTag_LatencyBuckets));
+    NL_TEST_ASSERT(inSuite, lError == WEAVE_NO_ERROR);
+
+    lError = lReader.EnterContainer(lBucketsContainer);
+    NL_TEST_ASSERT(inSuite, lError == WEAVE_NO_ERROR);
+
+    // The array stops at the last non-empty bucket.
+    {
+        static const uint32_t kExpectedBuckets[] = { 1, 0, 1, 2 };
+
+        for (size_t i = 0; i < sizeof(kExpectedBuckets) / sizeof(kExpectedBuckets[0]); i++)
+        {
+            lError = lReader.Next(kTLVType_UnsignedInteger, AnonymousTag);
+            NL_TEST_ASSERT(inSuite, lError == WEAVE_NO_ERROR);
+            lError = lReader.Get(lValue);
+            NL_TEST_ASSERT(inSuite, lError == WEAVE_NO_ERROR && lValue == kExpectedBuckets[i]);
+        }
+    }
+
+    lError = lReader.Next();
+    NL_TEST_ASSERT(inSuite, lError == WEAVE_END_OF_TLV);
+
+    lError = lReader.ExitContainer(lBucketsContainer);
+    NL_TEST_ASSERT(inSuite, lError == WEAVE_NO_ERROR);
+
+    lError = lReader.Next();
+    NL_TEST_ASSERT(inSuite, lError == WEAVE_END_OF_TLV);
+
+    lError = lReader.ExitContainer(lPointContainer);
+    NL_TEST_ASSERT(inSuite, lError == WEAVE_NO_ERROR);
+
+    lError = lReader.Next();
+    NL_TEST_ASSERT(inSuite, lError == WEAVE_END_OF_TLV);
+
+    lError = lReader.ExitContainer(lSnapshotContainer);
+    NL_TEST_ASSERT(inSuite, lError == WEAVE_NO_ERROR);
+
+    // An empty snapshot is an empty structure.
+    ResetLatency();
+    UpdateLatencySnapshot(lSnapshot);
+
+    lWriter.Init(lBuffer, sizeof(lBuffer));
+
+    lError = WriteLatencySnapshot(lWriter, AnonymousTag, lSnapshot);
+    NL_TEST_ASSERT(inSuite, lError == WEAVE_NO_ERROR);
+
+    lError = lWriter.Finalize();
+    NL_TEST_ASSERT(inSuite, lError == WEAVE_NO_ERROR);
+
+    lReader.Init(lBuffer, lWriter.GetLengthWritten());
+
+    lError = lReader.Next(kTLVType_Structure, AnonymousTag);
+    NL_TEST_ASSERT(inSuite, lError == WEAVE_NO_ERROR);
+
+    lError = lReader.EnterContainer(lSnapshotContainer);
+    NL_TEST_ASSERT(inSuite, lError == WEAVE_NO_ERROR);
+
+    lError = lReader.Next();
+    NL_TEST_ASSERT(inSuite, lError == WEAVE_END_OF_TLV);
+}
+
+// Test Suite
+
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("Stats::TestLatencyBucketBoundaries",    CheckBucketBoundaries),
+    NL_TEST_DEF("Stats::TestLatencyOverflow",            CheckOverflow),
+    NL_TEST_DEF("Stats::TestLatencySnapshotAndReset",    CheckSnapshotAndReset),
+    NL_TEST_DEF("Stats::TestWriteLatencySnapshot",       CheckWriteLatencySnapshot),
+    NL_TEST_SENTINEL()
+};
+
+int main(int argc, char *argv[])
+{
+    nlTestSuite theSuite = {
+        "weave-system-stats",
+        &sTests[0],
+        NULL,
+        NULL
+    };
+
+    // Generate machine-readable, comma-separated value (CSV) output.
+    nl_test_set_output_style(OUTPUT_CSV);
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, NULL);
+
+    return nlTestRunnerStats(&theSuite);
+}
+
+#else // WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
+
+int main(int argc, char *argv[])
+{
+    printf("Latency statistics are disabled (WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS == 0); skipping\n");
+
+    return 0;
+}
+
+#endif // WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
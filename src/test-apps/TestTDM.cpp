@@ -38,6 +38,7 @@
 
 #include <Weave/Profiles/data-management/Current/WdmManagedNamespace.h>
 #include <Weave/Profiles/data-management/DataManagement.h>
+#include <Weave/Profiles/data-management/Current/GenericTraitCatalogImpl.h>
 
 #include <nest/test/trait/TestHTrait.h>
 #include <nest/test/trait/TestCTrait.h>
@@ -161,8 +162,21 @@ static void TestTdmDictionary_DeleteEntryTwice(nlTestSuite *inSuite, void *inCon
 static void TestRandomizedDataVersions(nlTestSuite *inSuite, void *inContext);
 
 static void TestTdmStatic_MultiInstance(nlTestSuite *inSuite, void *inContext);
+static void TestTdmStatic_RejectedDataList(nlTestSuite *inSuite, void *inContext);
+#if WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE > 0
+static void TestTdmStatic_JournalDeltaOnRootDirty(nlTestSuite *inSuite, void *inContext);
+static void TestTdmStatic_JournalResetOnVersionJump(nlTestSuite *inSuite, void *inContext);
+#endif
+#if WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE > 1
+static void TestTdmStatic_WindowedNotifiesConfirmedOutOfOrder(nlTestSuite *inSuite, void *inContext);
+#endif
+#if WDM_PUBLISHER_NOTIFY_ENCODE_CACHE_SIZE > 0
+static void TestTdmStatic_SharedEncodeCache(nlTestSuite *inSuite, void *inContext);
+#endif
 static void CheckAllocateRightSizedBufferForNotifications(nlTestSuite *inSuite, void *inContext);
 static void CheckSynchronizedTraitState(nlTestSuite *inSuite, void *inContext);
+static void CheckGenericCatalogLookup(nlTestSuite *inSuite, void *inContext);
+static void CheckGenericCatalogHashCollision(nlTestSuite *inSuite, void *inContext);
 
 // Test Suite
 
@@ -225,6 +239,22 @@ static const nlTest sTests[] = {
 
     NL_TEST_DEF("Test Tdm (Multi Instance): Multi Instance", TestTdmStatic_MultiInstance),
 
+    // Tests the rollback of a data list rejected part way through
+    NL_TEST_DEF("Test Tdm (Static schema): Data list rejected after a stored element", TestTdmStatic_RejectedDataList),
+
+#if WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE > 0
+    NL_TEST_DEF("Test Tdm (Change Journal): Delta against acknowledged version when root is dirty", TestTdmStatic_JournalDeltaOnRootDirty),
+    NL_TEST_DEF("Test Tdm (Change Journal): Reset when the version jumps", TestTdmStatic_JournalResetOnVersionJump),
+#endif
+
+#if WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE > 1
+    NL_TEST_DEF("Test Tdm (Notify Window): Notifies carrying the same trait confirmed out of order", TestTdmStatic_WindowedNotifiesConfirmedOutOfOrder),
+#endif
+
+#if WDM_PUBLISHER_NOTIFY_ENCODE_CACHE_SIZE > 0
+    NL_TEST_DEF("Test Tdm (Encode Cache): Data element shared between subscribers", TestTdmStatic_SharedEncodeCache),
+#endif
+
     // Tests the allocation of buffer for building and sending Notifies and
     // Updates.
     NL_TEST_DEF("Test Allocate Right Sized Buffer", CheckAllocateRightSizedBufferForNotifications),
@@ -232,6 +262,10 @@ static const nlTest sTests[] = {
     // Test command + data synchronizer
     NL_TEST_DEF("Test Command + State Synchronization Logic", CheckSynchronizedTraitState),
 
+    // Tests the path and instance indexes of GenericTraitCatalogImpl
+    NL_TEST_DEF("Test Generic Catalog: Lookup after add and remove", CheckGenericCatalogLookup),
+    NL_TEST_DEF("Test Generic Catalog: Paths with colliding hashes", CheckGenericCatalogHashCollision),
+
     NL_TEST_SENTINEL()
 };
 
@@ -416,6 +450,9 @@ public:
     void SetValue(PropertyPathHandle aPropertyPathHandle, uint32_t aValue);
     void Reset();
 
+    // Making this public to allow tests to access it.
+    using TraitDataSource::SetVersion;
+
 private:
     WEAVE_ERROR GetLeafData(PropertyPathHandle aLeafHandle, uint64_t aTagToWrite, TLVWriter &aWriter);
     WEAVE_ERROR GetNextDictionaryItemKey(PropertyPathHandle aDictionaryHandle, uintptr_t &aContext, PropertyDictionaryKey &aKey);
@@ -694,6 +731,10 @@ public:
     int Teardown();
     int Reset();
     int BuildAndProcessNotify();
+    int BuildNotify(PacketBuffer *&aBuf);
+    int ProcessNotify(PacketBuffer *aBuf);
+    int BuildAndProcessMalformedNotify();
+    int BuildNotifyDataList(SubscriptionHandler *aSubHandler, uint8_t *aDataList, uint32_t aDataListSize, uint32_t &aDataListLen);
 
     void TestTdmStatic_SingleLeafHandle(nlTestSuite *inSuite);
     void TestTdmStatic_SingleLevelMerge(nlTestSuite *inSuite);
@@ -740,6 +781,17 @@ public:
     void TestRandomizedDataVersions(nlTestSuite *inSuite);
 
     void TestTdmStatic_MultiInstance(nlTestSuite *inSuite);
+    void TestTdmStatic_RejectedDataList(nlTestSuite *inSuite);
+#if WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE > 0
+    void TestTdmStatic_JournalDeltaOnRootDirty(nlTestSuite *inSuite);
+    void TestTdmStatic_JournalResetOnVersionJump(nlTestSuite *inSuite);
+#endif
+#if WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE > 1
+    void TestTdmStatic_WindowedNotifiesConfirmedOutOfOrder(nlTestSuite *inSuite);
+#endif
+#if WDM_PUBLISHER_NOTIFY_ENCODE_CACHE_SIZE > 0
+    void TestTdmStatic_SharedEncodeCache(nlTestSuite *inSuite);
+#endif
 
     void CheckAllocateRightSizedBufferForNotifications(nlTestSuite *inSuite);
 
@@ -908,12 +960,125 @@ int TestTdm::Reset()
 }
 
 int TestTdm::BuildAndProcessNotify()
+{
+    PacketBuffer *buf = NULL;
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    err = BuildNotify(buf);
+    SuccessOrExit(err);
+
+    if (buf)
+    {
+        err = ProcessNotify(buf);
+        SuccessOrExit(err);
+    }
+    else
+    {
+        WeaveLogDetail(DataManagement, "nothing has been written");
+    }
+
+exit:
+    if (buf) {
+        PacketBuffer::Free(buf);
+    }
+
+    return err;
+}
+
+// Builds a notify for mSubHandler. aBuf is left NULL if nothing has been written.
+int TestTdm::BuildNotify(PacketBuffer *&aBuf)
+{
+    bool isSubscriptionClean;
+    NotificationEngine::NotifyRequestBuilder notifyRequest;
+    PacketBuffer *buf = NULL;
+    TLVWriter writer;
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    bool neWriteInProgress = false;
+    uint32_t maxNotificationSize = 0;
+    uint32_t maxPayloadSize = 0;
+
+    aBuf = NULL;
+
+    maxNotificationSize = mSubHandler->GetMaxNotificationSize();
+
+    err = mSubHandler->mBinding->AllocateRightSizedBuffer(buf, maxNotificationSize, WDM_MIN_NOTIFICATION_SIZE, maxPayloadSize);
+    SuccessOrExit(err);
+
+    err = notifyRequest.Init(buf, &writer, mSubHandler, maxPayloadSize);
+    SuccessOrExit(err);
+
+    err = mNotificationEngine->BuildSingleNotifyRequestDataList(mSubHandler, notifyRequest, isSubscriptionClean, neWriteInProgress);
+    SuccessOrExit(err);
+
+    VerifyOrExit(neWriteInProgress, );
+
+    err = notifyRequest.MoveToState(NotificationEngine::kNotifyRequestBuilder_Idle);
+    SuccessOrExit(err);
+
+    aBuf = buf;
+    buf = NULL;
+
+exit:
+    if (buf) {
+        PacketBuffer::Free(buf);
+    }
+
+    return err;
+}
+
+// Hands the data list of a notify built by BuildNotify to mSubClient.
+int TestTdm::ProcessNotify(PacketBuffer *aBuf)
+{
+    NotificationRequest::Parser notify;
+    TLVReader reader;
+    TLVType dummyType1, dummyType2;
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    reader.Init(aBuf);
+
+    err = reader.Next();
+    SuccessOrExit(err);
+
+    notify.Init(reader);
+
+    err = notify.CheckSchemaValidity();
+    SuccessOrExit(err);
+
+    // Enter the struct
+    err = reader.EnterContainer(dummyType1);
+    SuccessOrExit(err);
+
+    // SubscriptionId
+    err = reader.Next();
+    SuccessOrExit(err);
+
+    err = reader.Next();
+    SuccessOrExit(err);
+
+    VerifyOrExit(nl::Weave::TLV::kTLVType_Array == reader.GetType(), err = WEAVE_ERROR_WRONG_TLV_TYPE);
+
+    err = reader.EnterContainer(dummyType2);
+    SuccessOrExit(err);
+
+    err = mSubClient->ProcessDataList(reader);
+    SuccessOrExit(err);
+
+exit:
+    return err;
+}
+
+// Same as BuildAndProcessNotify, except that a malformed data element is added
+// to the end of the data list before it is processed.
+int TestTdm::BuildAndProcessMalformedNotify()
 {
     bool isSubscriptionClean;
     NotificationEngine::NotifyRequestBuilder notifyRequest;
     NotificationRequest::Parser notify;
+    DataList::Parser dataList;
     PacketBuffer *buf = NULL;
+    PacketBuffer *malformedBuf = NULL;
     TLVWriter writer;
+    TLVWriter malformedWriter;
     TLVReader reader;
     TLVType dummyType1, dummyType2;
     WEAVE_ERROR err = WEAVE_NO_ERROR;
@@ -932,45 +1097,134 @@ int TestTdm::BuildAndProcessNotify()
     err = mNotificationEngine->BuildSingleNotifyRequestDataList(mSubHandler, notifyRequest, isSubscriptionClean, neWriteInProgress);
     SuccessOrExit(err);
 
-    if (neWriteInProgress)
-    {
-        err = notifyRequest.MoveToState(NotificationEngine::kNotifyRequestBuilder_Idle);
-        SuccessOrExit(err);
+    VerifyOrExit(neWriteInProgress, err = WEAVE_ERROR_INCORRECT_STATE);
 
-        reader.Init(buf);
+    err = notifyRequest.MoveToState(NotificationEngine::kNotifyRequestBuilder_Idle);
+    SuccessOrExit(err);
 
-        err = reader.Next();
-        SuccessOrExit(err);
+    reader.Init(buf);
 
-        notify.Init(reader);
+    err = reader.Next();
+    SuccessOrExit(err);
 
-        err = notify.CheckSchemaValidity();
-        SuccessOrExit(err);
+    err = notify.Init(reader);
+    SuccessOrExit(err);
 
-        // Enter the struct
-        err = reader.EnterContainer(dummyType1);
-        SuccessOrExit(err);
+    err = notify.GetDataList(&dataList);
+    SuccessOrExit(err);
 
-        // SubscriptionId
-        err = reader.Next();
-        SuccessOrExit(err);
+    dataList.GetReader(&reader);
 
-        err = reader.Next();
-        SuccessOrExit(err);
+    malformedBuf = PacketBuffer::New();
+    VerifyOrExit(malformedBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
 
-        VerifyOrExit(nl::Weave::TLV::kTLVType_Array == reader.GetType(), err = WEAVE_ERROR_WRONG_TLV_TYPE);
+    malformedWriter.Init(malformedBuf);
 
-        err = reader.EnterContainer(dummyType2);
-        SuccessOrExit(err);
+    err = malformedWriter.StartContainer(AnonymousTag, kTLVType_Array, dummyType1);
+    SuccessOrExit(err);
 
-        err = mSubClient->ProcessDataList(reader);
+    while ((err = reader.Next()) == WEAVE_NO_ERROR)
+    {
+        err = malformedWriter.CopyElement(reader);
         SuccessOrExit(err);
     }
-    else
-    {
-        WeaveLogDetail(DataManagement, "nothing has been written");
+    VerifyOrExit(err == WEAVE_END_OF_TLV, );
+
+    // Data elements have to be structures
+    err = malformedWriter.Put(AnonymousTag, static_cast<uint32_t>(0));
+    SuccessOrExit(err);
+
+    err = malformedWriter.EndContainer(dummyType1);
+    SuccessOrExit(err);
+
+    err = malformedWriter.Finalize();
+    SuccessOrExit(err);
+
+    reader.Init(malformedBuf);
+
+    err = reader.Next();
+    SuccessOrExit(err);
+
+    err = reader.EnterContainer(dummyType2);
+    SuccessOrExit(err);
+
+    err = mSubClient->ProcessDataList(reader);
+
+exit:
+    if (buf) {
+        PacketBuffer::Free(buf);
+    }
+
+    if (malformedBuf) {
+        PacketBuffer::Free(malformedBuf);
     }
 
+    return err;
+}
+
+// Builds a notify for the given handler and copies out the encoded DataList, without processing it.
+int TestTdm::BuildNotifyDataList(SubscriptionHandler *aSubHandler, uint8_t *aDataList, uint32_t aDataListSize, uint32_t &aDataListLen)
+{
+    bool isSubscriptionClean;
+    NotificationEngine::NotifyRequestBuilder notifyRequest;
+    NotificationRequest::Parser notify;
+    DataList::Parser dataList;
+    PacketBuffer *buf = NULL;
+    TLVWriter writer;
+    TLVWriter dataListWriter;
+    TLVReader reader;
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    bool neWriteInProgress = false;
+    uint32_t maxNotificationSize = 0;
+    uint32_t maxPayloadSize = 0;
+
+    aDataListLen = 0;
+
+    maxNotificationSize = aSubHandler->GetMaxNotificationSize();
+
+    err = aSubHandler->mBinding->AllocateRightSizedBuffer(buf, maxNotificationSize, WDM_MIN_NOTIFICATION_SIZE, maxPayloadSize);
+    SuccessOrExit(err);
+
+    err = notifyRequest.Init(buf, &writer, aSubHandler, maxPayloadSize);
+    SuccessOrExit(err);
+
+    err = mNotificationEngine->BuildSingleNotifyRequestDataList(aSubHandler, notifyRequest, isSubscriptionClean, neWriteInProgress);
+    SuccessOrExit(err);
+
+    VerifyOrExit(neWriteInProgress, );
+
+    err = notifyRequest.MoveToState(NotificationEngine::kNotifyRequestBuilder_Idle);
+    SuccessOrExit(err);
+
+    reader.Init(buf);
+
+    err = reader.Next();
+    SuccessOrExit(err);
+
+    err = notify.Init(reader);
+    SuccessOrExit(err);
+
+    err = notify.CheckSchemaValidity();
+    SuccessOrExit(err);
+
+    err = notify.GetDataList(&dataList);
+    SuccessOrExit(err);
+
+    err = dataList.Next();
+    SuccessOrExit(err);
+
+    dataList.GetReader(&reader);
+
+    dataListWriter.Init(aDataList, aDataListSize);
+
+    err = dataListWriter.CopyElement(reader);
+    SuccessOrExit(err);
+
+    err = dataListWriter.Finalize();
+    SuccessOrExit(err);
+
+    aDataListLen = dataListWriter.GetLengthWritten();
+
 exit:
     if (buf) {
         PacketBuffer::Free(buf);
@@ -1006,6 +1260,337 @@ exit:
     NL_TEST_ASSERT(inSuite, testPass);
 }
 
+void TestTdm::TestTdmStatic_RejectedDataList(nlTestSuite *inSuite)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    bool testPass = false;
+
+    Reset();
+    mTestTdmSource.SetValue(TestHTrait::kPropertyHandle_A, 2);
+
+    // The first element is stored before the malformed one is found
+    err = BuildAndProcessMalformedNotify();
+    VerifyOrExit(err == WEAVE_ERROR_WRONG_TLV_TYPE, );
+
+    testPass = mTestTdmSink.ValidateChangeSets( { { TestHTrait::kPropertyHandle_A, 2 } },
+                                                { },
+                                                { } );
+    VerifyOrExit(testPass, );
+
+    // so the sink must not claim the version of a notification that was rejected
+    testPass = !mTestTdmSink.IsVersionValid();
+
+exit:
+    NL_TEST_ASSERT(inSuite, testPass);
+}
+
+#if WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE > 0
+void TestTdm::TestTdmStatic_JournalDeltaOnRootDirty(nlTestSuite *inSuite)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    bool testPass = false;
+    SubscriptionHandler::TraitInstanceInfo *traitInstance = mSubHandler->mTraitInstanceList;
+    uint64_t ackedVersion;
+
+    Reset();
+
+    // A change the subscriber already has
+    mTestTdmSource.Lock();
+    mTestTdmSource.SetValue(TestHTrait::kPropertyHandle_A, 2);
+    mTestTdmSource.Unlock();
+
+    ackedVersion = mTestTdmSource.GetVersion();
+
+    Reset();
+
+    // Changes it doesn't, followed by a fallback to the whole trait instance
+    mTestTdmSource.Lock();
+    mTestTdmSource.SetValue(TestHTrait::kPropertyHandle_B, 2);
+    mTestTdmSource.SetValue(TestHTrait::kPropertyHandle_C, 2);
+    mTestTdmSource.Unlock();
+
+    mTestTdmSource.SetRootDirty();
+
+    traitInstance->mAckedVersion = ackedVersion;
+    traitInstance->mIsAckedVersionValid = true;
+
+    err = BuildAndProcessNotify();
+    SuccessOrExit(err);
+
+    testPass = mTestTdmSink.ValidateChangeSets( { { TestHTrait::kPropertyHandle_B, 2 }, { TestHTrait::kPropertyHandle_C, 2 } },
+                                                { },
+                                                { });
+
+exit:
+    traitInstance->Init();
+
+    NL_TEST_ASSERT(inSuite, testPass);
+}
+
+void TestTdm::TestTdmStatic_JournalResetOnVersionJump(nlTestSuite *inSuite)
+{
+    uint64_t initialVersion;
+    uint64_t jumpedVersion;
+
+    Reset();
+
+    initialVersion = mTestTdmSource.GetVersion();
+
+    mTestTdmSource.Lock();
+    mTestTdmSource.SetValue(TestHTrait::kPropertyHandle_A, 2);
+    mTestTdmSource.Unlock();
+
+    NL_TEST_ASSERT(inSuite, mTestTdmSource.HasChangesSince(initialVersion));
+
+    // Moving to the next version keeps the journal
+    mTestTdmSource.SetVersion(mTestTdmSource.GetVersion() + 1);
+
+    NL_TEST_ASSERT(inSuite, mTestTdmSource.HasChangesSince(initialVersion));
+
+    // A jump leaves the journal unable to describe what happened in between
+    jumpedVersion = mTestTdmSource.GetVersion() + 10;
+    mTestTdmSource.SetVersion(jumpedVersion);
+
+    NL_TEST_ASSERT(inSuite, !mTestTdmSource.HasChangesSince(initialVersion));
+    NL_TEST_ASSERT(inSuite, !mTestTdmSource.HasChangesSince(jumpedVersion));
+
+    mTestTdmSource.Lock();
+    mTestTdmSource.SetValue(TestHTrait::kPropertyHandle_B, 2);
+    mTestTdmSource.Unlock();
+
+    NL_TEST_ASSERT(inSuite, mTestTdmSource.HasChangesSince(jumpedVersion));
+    NL_TEST_ASSERT(inSuite, !mTestTdmSource.HasChangesSince(initialVersion));
+
+    // So does going backwards
+    mTestTdmSource.SetVersion(initialVersion);
+
+    NL_TEST_ASSERT(inSuite, !mTestTdmSource.HasChangesSince(initialVersion));
+    NL_TEST_ASSERT(inSuite, !mTestTdmSource.HasChangesSince(jumpedVersion));
+}
+#endif // WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE > 0
+
+#if WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE > 1
+void TestTdm::TestTdmStatic_WindowedNotifiesConfirmedOutOfOrder(nlTestSuite *inSuite)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    bool testPass = false;
+    nl::Weave::System::Layer systemLayer;
+    WeaveMessageLayer * const messageLayer = ExchangeMgr.MessageLayer;
+    SubscriptionHandler::NotifyInFlight *notify1 = NULL;
+    SubscriptionHandler::NotifyInFlight *notify2 = NULL;
+    SubscriptionHandler::NotifyInFlight *notify4 = NULL;
+    PacketBuffer *buf1 = NULL;
+    PacketBuffer *buf2 = NULL;
+    PacketBuffer *buf3 = NULL;
+    PacketBuffer *buf4 = NULL;
+
+    Reset();
+
+    // Confirms refresh the liveness timer, which an uninitialized system layer ignores
+    ExchangeMgr.MessageLayer = &MessageLayer;
+    MessageLayer.SystemLayer = &systemLayer;
+
+    err = mSubHandler->SetNotifyWindowSize(2);
+    SuccessOrExit(err);
+
+    // Notify 1 carries the first trait instance, notify 2 the second one
+    mTestTdmSource.Lock();
+    mTestTdmSource.SetValue(TestHTrait::kPropertyHandle_A, 2);
+    mTestTdmSource.Unlock();
+
+    err = BuildNotify(buf1);
+    SuccessOrExit(err);
+    VerifyOrExit(buf1 != NULL, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    notify1 = mSubHandler->PushNotifyInFlight(NULL);
+    mNotificationEngine->mNumNotifiesInFlight++;
+
+    mTestTdmSource1.Lock();
+    mTestTdmSource1.SetValue(TestHTrait::kPropertyHandle_B, 2);
+    mTestTdmSource1.Unlock();
+
+    err = BuildNotify(buf2);
+    SuccessOrExit(err);
+    VerifyOrExit(buf2 != NULL, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    notify2 = mSubHandler->PushNotifyInFlight(NULL);
+    mNotificationEngine->mNumNotifiesInFlight++;
+
+    // The first trait instance changes again while notify 1 is unconfirmed: it stays out of the next notify
+    mTestTdmSource.Lock();
+    mTestTdmSource.SetValue(TestHTrait::kPropertyHandle_A, 3);
+    mTestTdmSource.Unlock();
+
+    err = BuildNotify(buf3);
+    SuccessOrExit(err);
+    VerifyOrExit(buf3 == NULL, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    // Notify 2 is confirmed first, and notify 1 only reaches the subscriber after it, as a retransmission would
+    err = ProcessNotify(buf2);
+    SuccessOrExit(err);
+
+    err = mSubHandler->ConfirmWindowedNotify(notify2);
+    SuccessOrExit(err);
+
+    err = BuildNotify(buf3);
+    SuccessOrExit(err);
+    VerifyOrExit(buf3 == NULL, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    err = ProcessNotify(buf1);
+    SuccessOrExit(err);
+
+    err = mSubHandler->ConfirmWindowedNotify(notify1);
+    SuccessOrExit(err);
+
+    VerifyOrExit(mSubHandler->mNumNotifiesInWindow == 0, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    // Only now does the newer data go out
+    err = BuildNotify(buf4);
+    SuccessOrExit(err);
+    VerifyOrExit(buf4 != NULL, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    notify4 = mSubHandler->PushNotifyInFlight(NULL);
+    mNotificationEngine->mNumNotifiesInFlight++;
+
+    err = ProcessNotify(buf4);
+    SuccessOrExit(err);
+
+    err = mSubHandler->ConfirmWindowedNotify(notify4);
+    SuccessOrExit(err);
+
+    testPass = mTestTdmSink.ValidateChangeSets( { { TestHTrait::kPropertyHandle_A, 3 } },
+                                                { },
+                                                { } );
+    VerifyOrExit(testPass, );
+
+    testPass = mTestTdmSink1.ValidateChangeSets( { { TestHTrait::kPropertyHandle_B, 2 } },
+                                                 { },
+                                                 { } );
+
+exit:
+    PacketBuffer::Free(buf1);
+    PacketBuffer::Free(buf2);
+    PacketBuffer::Free(buf3);
+    PacketBuffer::Free(buf4);
+
+    // Retire whatever a failure left in the window
+    (void) mSubHandler->FlushNotifyWindow();
+    (void) mSubHandler->SetNotifyWindowSize(1);
+
+    mSubHandler->mTraitInstanceList[0].Init();
+    mSubHandler->mTraitInstanceList[1].Init();
+
+    MessageLayer.SystemLayer = NULL;
+    ExchangeMgr.MessageLayer = messageLayer;
+
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, testPass);
+}
+#endif // WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE > 1
+
+#if WDM_PUBLISHER_NOTIFY_ENCODE_CACHE_SIZE > 0
+void TestTdm::TestTdmStatic_SharedEncodeCache(nlTestSuite *inSuite)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    SubscriptionHandler *subHandler1 = NULL;
+    SubscriptionHandler::TraitInstanceInfo *traitInstance = NULL;
+    const NotificationEngine::EncodeStats &stats = mNotificationEngine->GetEncodeStats();
+    uint8_t dataList[256];
+    uint8_t dataList1[256];
+    uint8_t previous[256];
+    uint32_t dataListLen, dataListLen1, previousLen;
+    uint32_t bytesEncoded;
+
+    Reset();
+
+    // A second subscriber to the first trait instance only
+    err = mSubscriptionEngine.NewSubscriptionHandler(&subHandler1);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    SuccessOrExit(err);
+
+    // Keep the liveness update on teardown from matching the client used by the other tests
+    subHandler1->mSubscriptionId = 1;
+
+    subHandler1->_AddRef();
+    subHandler1->mBinding = mSubHandler->mBinding;
+    subHandler1->MoveToState(SubscriptionHandler::kState_SubscriptionEstablished_Idle);
+
+    traitInstance = mSubscriptionEngine.mTraitInfoPool + mSubscriptionEngine.mNumTraitInfosInPool;
+    subHandler1->mTraitInstanceList = traitInstance;
+    subHandler1->mNumTraitInstances++;
+    ++(SubscriptionEngine::GetInstance()->mNumTraitInfosInPool);
+
+    traitInstance->Init();
+    traitInstance->mTraitDataHandle = mSubHandler->mTraitInstanceList->mTraitDataHandle;
+    traitInstance->mRequestedVersion = 1;
+
+    mNotificationEngine->ClearEncodeCache();
+    mNotificationEngine->ResetEncodeStats();
+
+    // The first subscriber pays for the encode, the second gets the same bytes from the cache
+    mTestTdmSource.SetValue(TestHTrait::kPropertyHandle_A, 2);
+
+    err = BuildNotifyDataList(mSubHandler, dataList, sizeof(dataList), dataListLen);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, dataListLen > 0);
+    NL_TEST_ASSERT(inSuite, stats.mCacheMisses == 1 && stats.mCacheHits == 0);
+    NL_TEST_ASSERT(inSuite, stats.mBytesEncoded > 0 && stats.mBytesSent == stats.mBytesEncoded);
+
+    bytesEncoded = stats.mBytesEncoded;
+
+    err = BuildNotifyDataList(subHandler1, dataList1, sizeof(dataList1), dataListLen1);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, dataListLen1 == dataListLen && memcmp(dataList1, dataList, dataListLen) == 0);
+    NL_TEST_ASSERT(inSuite, stats.mCacheMisses == 1 && stats.mCacheHits == 1);
+    NL_TEST_ASSERT(inSuite, stats.mBytesEncoded == bytesEncoded && stats.mBytesSent == 2 * bytesEncoded);
+
+    // Marking the data dirty again invalidates the cached element even though the version has not moved
+    memcpy(previous, dataList, dataListLen);
+    previousLen = dataListLen;
+
+    mTestTdmSource.SetValue(TestHTrait::kPropertyHandle_A, 3);
+
+    err = BuildNotifyDataList(mSubHandler, dataList, sizeof(dataList), dataListLen);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, stats.mCacheMisses == 2 && stats.mCacheHits == 1);
+    NL_TEST_ASSERT(inSuite, dataListLen != previousLen || memcmp(dataList, previous, dataListLen) != 0);
+
+    err = BuildNotifyDataList(subHandler1, dataList1, sizeof(dataList1), dataListLen1);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, dataListLen1 == dataListLen && memcmp(dataList1, dataList, dataListLen) == 0);
+    NL_TEST_ASSERT(inSuite, stats.mCacheMisses == 2 && stats.mCacheHits == 2);
+
+    // An element cached at one version is not served for another
+    mTestTdmSource.SetValue(TestHTrait::kPropertyHandle_A, 4);
+
+    err = BuildNotifyDataList(mSubHandler, dataList, sizeof(dataList), dataListLen);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, stats.mCacheMisses == 3 && stats.mCacheHits == 2);
+
+    mTestTdmSource.SetVersion(mTestTdmSource.GetVersion() + 1);
+
+    err = BuildNotifyDataList(subHandler1, dataList1, sizeof(dataList1), dataListLen1);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, stats.mCacheMisses == 4 && stats.mCacheHits == 2);
+    NL_TEST_ASSERT(inSuite, dataListLen1 != dataListLen || memcmp(dataList1, dataList, dataListLen) != 0);
+
+exit:
+    // There is no exchange layer behind these tests, so hand the handler back without terminating the subscription. The binding
+    // is borrowed from mSubHandler.
+    if (subHandler1 != NULL)
+    {
+        if (traitInstance != NULL)
+        {
+            --(SubscriptionEngine::GetInstance()->mNumTraitInfosInPool);
+        }
+
+        subHandler1->InitAsFree();
+    }
+
+    mNotificationEngine->ClearEncodeCache();
+}
+#endif // WDM_PUBLISHER_NOTIFY_ENCODE_CACHE_SIZE > 0
+
 void TestTdm::TestTdmStatic_SingleLeafHandle(nlTestSuite *inSuite)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
@@ -2400,6 +2985,37 @@ static void TestTdmStatic_MultiInstance(nlTestSuite *inSuite, void *inContext)
     gTestTdm->TestTdmStatic_MultiInstance(inSuite);
 }
 
+static void TestTdmStatic_RejectedDataList(nlTestSuite *inSuite, void *inContext)
+{
+    gTestTdm->TestTdmStatic_RejectedDataList(inSuite);
+}
+
+#if WDM_PUBLISHER_TRAIT_CHANGE_JOURNAL_SIZE > 0
+static void TestTdmStatic_JournalDeltaOnRootDirty(nlTestSuite *inSuite, void *inContext)
+{
+    gTestTdm->TestTdmStatic_JournalDeltaOnRootDirty(inSuite);
+}
+
+static void TestTdmStatic_JournalResetOnVersionJump(nlTestSuite *inSuite, void *inContext)
+{
+    gTestTdm->TestTdmStatic_JournalResetOnVersionJump(inSuite);
+}
+#endif
+
+#if WDM_PUBLISHER_MAX_NOTIFY_WINDOW_SIZE > 1
+static void TestTdmStatic_WindowedNotifiesConfirmedOutOfOrder(nlTestSuite *inSuite, void *inContext)
+{
+    gTestTdm->TestTdmStatic_WindowedNotifiesConfirmedOutOfOrder(inSuite);
+}
+#endif
+
+#if WDM_PUBLISHER_NOTIFY_ENCODE_CACHE_SIZE > 0
+static void TestTdmStatic_SharedEncodeCache(nlTestSuite *inSuite, void *inContext)
+{
+    gTestTdm->TestTdmStatic_SharedEncodeCache(inSuite);
+}
+#endif
+
 static void CheckAllocateRightSizedBufferForNotifications(nlTestSuite *inSuite, void *inContext)
 {
     gTestTdm->CheckAllocateRightSizedBufferForNotifications(inSuite);
@@ -2410,6 +3026,155 @@ static void CheckSynchronizedTraitState(nlTestSuite *inSuite, void *inContext)
     gTestTdm->CheckSynchronizedTraitState(inSuite);
 }
 
+static void CheckGenericCatalogLookup(nlTestSuite *inSuite, void *inContext)
+{
+    WEAVE_ERROR err;
+    GenericTraitSinkCatalog catalog;
+    TestTdmSink sinkA;
+    TestCTraitDataSink sinkC;
+    const ResourceIdentifier resourceId(ResourceIdentifier::SELF_NODE_ID);
+    const uint32_t profileA = sinkA.GetSchemaEngine()->GetProfileId();
+    const uint32_t profileC = sinkC.GetSchemaEngine()->GetProfileId();
+    const uint64_t kNumExtraInstances = 300;
+    TraitDataHandle handleA0, handleA1, handleC0, handle;
+    TraitDataSink *sink;
+
+    // The same trait instance can be published under several paths.
+    err = catalog.Add(resourceId, 0, kRootPropertyPathHandle, &sinkA, handleA0);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    err = catalog.Add(resourceId, 1, kRootPropertyPathHandle, &sinkA, handleA1);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    err = catalog.Add(resourceId, 0, kRootPropertyPathHandle, &sinkC, handleC0);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, catalog.Size() == 3);
+
+    err = catalog.Add(resourceId, 1, kRootPropertyPathHandle, &sinkA, handle);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_DUPLICATE_KEY_ID);
+
+    err = catalog.Locate(profileA, 1, resourceId, handle);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR && handle == handleA1);
+    err = catalog.Locate(profileC, 0, resourceId, &sink);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR && sink == &sinkC);
+    err = catalog.Locate(profileC, 1, resourceId, handle);
+    NL_TEST_ASSERT(inSuite, err != WEAVE_NO_ERROR);
+    err = catalog.Locate(profileA, 0, ResourceIdentifier(ResourceIdentifier::SELF_NODE_ID + 1), handle);
+    NL_TEST_ASSERT(inSuite, err != WEAVE_NO_ERROR);
+
+    // Lookup by instance returns the lowest handle of the instance.
+    err = catalog.Locate(&sinkA, handle);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR && handle == handleA0);
+
+    // Removing a path drops it from both indexes.
+    err = catalog.Remove(handleA0);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    err = catalog.Locate(profileA, 0, resourceId, handle);
+    NL_TEST_ASSERT(inSuite, err != WEAVE_NO_ERROR);
+    err = catalog.Locate(handleA0, &sink);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_INVALID_ARGUMENT);
+    err = catalog.Locate(&sinkA, handle);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR && handle == handleA1);
+    err = catalog.Remove(handleA0);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_INVALID_ARGUMENT);
+
+    // A new path reuses the freed handle and is indexed under it.
+    err = catalog.Add(resourceId, 2, kRootPropertyPathHandle, &sinkA, handle);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR && handle == handleA0);
+    err = catalog.Locate(profileA, 2, resourceId, handle);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR && handle == handleA0);
+    err = catalog.Locate(&sinkA, handle);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR && handle == handleA0);
+
+    err = catalog.Remove(&sinkC);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    err = catalog.Locate(&sinkC, handle);
+    NL_TEST_ASSERT(inSuite, err != WEAVE_NO_ERROR);
+    err = catalog.Locate(profileC, 0, resourceId, handle);
+    NL_TEST_ASSERT(inSuite, err != WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, catalog.Size() == 2);
+
+    // Enough paths to share hash buckets; every other one is removed again.
+    for (uint64_t i = 0; i < kNumExtraInstances; i++)
+    {
+        err = catalog.Add(resourceId, 100 + i, kRootPropertyPathHandle, &sinkA, handle);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    }
+
+    for (uint64_t i = 0; i < kNumExtraInstances; i += 2)
+    {
+        err = catalog.Locate(profileA, 100 + i, resourceId, handle);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+        err = catalog.Remove(handle);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    }
+
+    for (uint64_t i = 0; i < kNumExtraInstances; i++)
+    {
+        err = catalog.Locate(profileA, 100 + i, resourceId, &sink);
+        NL_TEST_ASSERT(inSuite, (i % 2 == 0) ? (err != WEAVE_NO_ERROR) : (err == WEAVE_NO_ERROR && sink == &sinkA));
+    }
+
+    NL_TEST_ASSERT(inSuite, catalog.Size() == 2 + kNumExtraInstances / 2);
+
+    err = catalog.Clear();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, catalog.Size() == 0);
+    err = catalog.Locate(&sinkA, handle);
+    NL_TEST_ASSERT(inSuite, err != WEAVE_NO_ERROR);
+    err = catalog.Locate(profileA, 1, resourceId, handle);
+    NL_TEST_ASSERT(inSuite, err != WEAVE_NO_ERROR);
+}
+
+static void CheckGenericCatalogHashCollision(nlTestSuite *inSuite, void *inContext)
+{
+    WEAVE_ERROR err;
+    GenericTraitSinkCatalog catalog;
+    TestTdmSink sinkA;
+    TestTdmSink sinkB;
+    const uint32_t profileId = sinkA.GetSchemaEngine()->GetProfileId();
+    const uint64_t kGoldenRatio = 0x9E3779B97F4A7C15ULL;
+    TraitDataHandle handleA, handleB, handle;
+    TraitDataSink *sink;
+
+    // With the catalog's path hash, instance 0 of resource r0 and instance 1 of resource r1 hash
+    // alike when r0 + K == 1 ^ (r1 + K + (1 << 6)), K being the golden ratio constant it mixes in.
+    const uint64_t resourceB = 0x18B4300000000042ULL;
+    const uint64_t resourceA = (1 ^ (resourceB + kGoldenRatio + (1 << 6))) - kGoldenRatio;
+    const ResourceIdentifier resourceIdA(Schema::Weave::Common::RESOURCE_TYPE_DEVICE, resourceA);
+    const ResourceIdentifier resourceIdB(Schema::Weave::Common::RESOURCE_TYPE_DEVICE, resourceB);
+
+    err = catalog.Add(resourceIdA, 0, kRootPropertyPathHandle, &sinkA, handleA);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    err = catalog.Add(resourceIdB, 1, kRootPropertyPathHandle, &sinkB, handleB);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, handleA != handleB);
+
+    err = catalog.Locate(profileId, 0, resourceIdA, &sink);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR && sink == &sinkA);
+    err = catalog.Locate(profileId, 1, resourceIdB, &sink);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR && sink == &sinkB);
+
+    // Crossing the components of the two paths must not match either of them.
+    err = catalog.Locate(profileId, 1, resourceIdA, handle);
+    NL_TEST_ASSERT(inSuite, err != WEAVE_NO_ERROR);
+    err = catalog.Locate(profileId, 0, resourceIdB, handle);
+    NL_TEST_ASSERT(inSuite, err != WEAVE_NO_ERROR);
+
+    // Removing one of the colliding paths leaves the other one in place.
+    err = catalog.Remove(handleA);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    err = catalog.Locate(profileId, 0, resourceIdA, handle);
+    NL_TEST_ASSERT(inSuite, err != WEAVE_NO_ERROR);
+    err = catalog.Locate(profileId, 1, resourceIdB, handle);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR && handle == handleB);
+
+    err = catalog.Add(resourceIdA, 0, kRootPropertyPathHandle, &sinkA, handle);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    err = catalog.Locate(profileId, 0, resourceIdA, &sink);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR && sink == &sinkA);
+    err = catalog.Locate(&sinkB, handle);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR && handle == handleB);
+}
+
 /**
  *  Main
  */
@@ -92,6 +92,8 @@ uint32_t appContext2 = 0xbaddcafe;
 uint32_t ThrottlePeriodicMsgCount = 0;
 uint32_t PeriodicMsgCount = 0;
 uint32_t DDTestCount = 0;
+uint32_t CoalescedAckTestMsgCount = 0;
+uint32_t CoalescedAckTestDupCount = 0;
 uint32_t ThrottlePauseTime = 2000;
 uint64_t NodeId = 0xdeadbeefcafebabe;
 uint64_t FirstDDTestTime = 0;
@@ -1423,6 +1425,108 @@ testStatus_t TestWRMPDuplicateMsgDetection(void)
     return TEST_FAIL;
 }
 
+static void HandleCoalescedAckTestMessage(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo,
+                                          uint32_t profileId, uint8_t msgType, PacketBuffer *payload)
+{
+    if (profileId == kWeaveProfile_Test && msgType == kWeaveTestMessageType_DD_Test)
+    {
+        if (msgInfo->Flags & kWeaveMessageFlag_DuplicateMessage)
+        {
+            printf("TestWRMP: Peer retransmitted DD_Test on exchange %04X\n", ec->ExchangeId);
+            CoalescedAckTestDupCount++;
+        }
+        else
+        {
+            CoalescedAckTestMsgCount++;
+        }
+    }
+
+    PacketBuffer::Free(payload);
+}
+
+//Get the peer to advertise coalesced ack support in a solitary ack, then have it send
+//a message requesting an ack on each of two exchanges at once. Our acks for both go out
+//in a single solitary ack when coalescing is enabled; either way, the peer must not
+//have to retransmit anything.
+testStatus_t TestWRMPCoalescedSolitaryAckReceipt(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    PacketBuffer *payloadBuf = NULL;
+    ExchangeContext *ecs[2] = { NULL, NULL };
+    testStatus_t testStatus = TEST_FAIL;
+    struct timeval sleepTime;
+    sleepTime.tv_sec = 0;
+    sleepTime.tv_usec = 100000;
+
+    isAckRcvd = false;
+    ackCount = 0;
+    CoalescedAckTestMsgCount = 0;
+    CoalescedAckTestDupCount = 0;
+    LastEchoTime = Now();
+
+    PrepareNewBuf(&payloadBuf);
+    err = SendCustomMessage(WRMPClient.ExchangeCtx, kWeaveProfile_Test, kWeaveTestMessageType_No_Response,
+                            ExchangeContext::kSendFlag_RequestAck, payloadBuf);
+    SuccessOrExit(err);
+
+    while (!isAckRcvd && Now() < LastEchoTime + MaxAckReceiptInterval)
+    {
+        ServiceNetwork(sleepTime);
+    }
+    VerifyOrExit(isAckRcvd, err = WEAVE_ERROR_TIMEOUT);
+
+    for (int i = 0; i < 2; i++)
+    {
+        ecs[i] = globalExchMgr->NewContext(DestNodeId, DestIPAddr, WEAVE_PORT, DestIntf, &WRMPClient);
+        VerifyOrExit(ecs[i] != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+        ecs[i]->OnAckRcvd = HandleAckRcvd;
+        ecs[i]->AllowDuplicateMsgs = true;
+    }
+
+    LastEchoTime = Now();
+
+    for (int i = 0; i < 2; i++)
+    {
+        PrepareNewBuf(&payloadBuf);
+        err = SendCustomMessage(ecs[i], kWeaveProfile_Test, kWeaveTestMessageType_DD_Test, ExchangeContext::kSendFlag_RequestAck,
+                                payloadBuf);
+        SuccessOrExit(err);
+
+        ecs[i]->OnMessageReceived = HandleCoalescedAckTestMessage;
+    }
+
+    // Leave the peer enough time to retransmit if our acks did not get through
+    while (Now() < LastEchoTime + MaxAckReceiptInterval + RetransInterval)
+    {
+        ServiceNetwork(sleepTime);
+    }
+
+    printf("\nAcks received = %d; DD_Test received = %d; retransmitted = %d\n\n", ackCount, CoalescedAckTestMsgCount,
+           CoalescedAckTestDupCount);
+
+    if (ackCount == 3 && CoalescedAckTestMsgCount == 2 && CoalescedAckTestDupCount == 0)
+    {
+        testStatus = TEST_PASS;
+    }
+
+exit:
+    if (err != WEAVE_NO_ERROR)
+    {
+        printf("TestWRMPCoalescedSolitaryAckReceipt failed: %s\n", ErrorStr(err));
+    }
+
+    for (int i = 0; i < 2; i++)
+    {
+        if (ecs[i] != NULL)
+        {
+            ecs[i]->Close();
+        }
+    }
+
+    return testStatus;
+}
+
 struct Tests {
     testStatus_t (*mTest)(void);
     const char * mTestName;
@@ -1445,7 +1549,8 @@ Tests gTests[] =
     { .mTest = TestWRMPDuplicateMsgLostAck, .mTestName = "TestWRMPDuplicateMsgLostAck" },
     { .mTest = TestWRMPDuplicateMsgAckOnClosedExResponder, .mTestName = "TestWRMPDuplicateMsgAckOnClosedExResponder" },
     { .mTest = TestWRMPDuplicateMsgAckOnClosedExInitiator, .mTestName = "TestWRMPDuplicateMsgAckOnClosedExInitiator" },
-    { .mTest = TestWRMPDuplicateMsgDetection, .mTestName = "TestWRMPDuplicateMsgDetection" }
+    { .mTest = TestWRMPDuplicateMsgDetection, .mTestName = "TestWRMPDuplicateMsgDetection" },
+    { .mTest = TestWRMPCoalescedSolitaryAckReceipt, .mTestName = "TestWRMPCoalescedSolitaryAckReceipt" }
 };
 
 #endif // WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
@@ -1127,6 +1127,97 @@ class TEST08_PrintSig(WeaveToolTestCase):
             self.assertRegexpMatches(remainingOutput, r'''(?m)^\s+r:\s+4D 0F C7 61 00 34 BF 6D 0F D1 B8 2B CD 8C 79 25\s*07 8A 1A 2A 8B D9 E1 A8 9C 5A D0 9C\s*$''')
             self.assertRegexpMatches(remainingOutput, r'''(?m)^\s+s:\s+2D 81 E4 D9 4E 76 69 89 7F FE 79 9E F5 52 14 61\s*9E 32 9F 46 9F FC 6C 7F A2 A5 86 4C\s*$''')
 
+class TEST09_ConvertCerts(WeaveToolTestCase):
+    '''Test the weave convert-certs command'''
+
+    numThreads = 4
+
+    def prepareCertDir(self):
+        '''Fill a directory with the certificates of the Weave source tree, alternately in PEM and DER form'''
+
+        certDir = os.path.join(self.tmpDir, 'certs')
+        os.mkdir(certDir)
+
+        srcCertFiles = sorted(
+            os.path.join(dirName, fileName)
+            for dirName, subDirNames, fileNames in os.walk(os.path.join(args.weaveRoot, 'certs'))
+            for fileName in fileNames if fileName.endswith('-cert.pem'))
+        self.assertTrue(len(srcCertFiles) > self.numThreads, 'Too few certificates in %s' % os.path.join(args.weaveRoot, 'certs'))
+
+        for i, srcCertFile in enumerate(srcCertFiles):
+            if i % 2 == 0:
+                shutil.copy(srcCertFile, os.path.join(certDir, '%02d.pem' % i))
+            else:
+                (res, stdout, stderr) = self.runCommand(args.weaveTool,
+                    [ 'convert-cert', '--x509-der', srcCertFile, os.path.join(certDir, '%02d.der' % i) ])
+                self.assertEqual(res, 0, 'Failed to convert %s to DER format' % srcCertFile)
+
+        return certDir
+
+    def convertCertDir(self, certDir):
+        '''Convert the certificates of a directory with convert-certs, one stream per input format'''
+
+        certFiles = sorted(os.path.join(certDir, fileName) for fileName in os.listdir(certDir))
+        results = []
+
+        for ext in [ '.pem', '.der' ]:
+            inFiles = [ fileName for fileName in certFiles if fileName.endswith(ext) ]
+            inData = ''.join(open(fileName, 'rb').read() for fileName in inFiles)
+            inFile = InFileArg('certs%s' % ext, inData)
+            outFile = OutFileArg('certs%s.b64' % ext)
+
+            (res, stdout, stderr) = self.runCommand(args.weaveTool,
+                [ 'convert-certs', '--threads', str(self.numThreads), inFile, outFile ])
+
+            results.append((inFiles, res, stderr, outFile.contents))
+
+        return results
+
+    def convertCertFile(self, certFile):
+        '''Convert a single certificate with convert-cert'''
+
+        (res, stdout, stderr) = self.runCommand(args.weaveTool, [ 'convert-cert', '--weave-b64', certFile, '-' ])
+        self.assertEqual(res, 0, 'Failed to convert %s' % certFile)
+
+        return stdout.strip()
+
+    def test_MixedDirectory(self):
+        '''Test conversion of a directory of PEM and DER certificates'''
+
+        certDir = self.prepareCertDir()
+
+        for inFiles, res, stderr, outData in self.convertCertDir(certDir):
+            self.assertEqual(res, 0, 'Command returned %d' % res)
+            self.assertEqual(stderr, '', 'Text in stderr')
+
+            # Each certificate must come out as convert-cert would convert it on its own, in input order.
+            outCerts = outData.splitlines()
+            self.assertEqual(len(outCerts), len(inFiles), 'Unexpected number of converted certificates')
+            for inFile, outCert in zip(inFiles, outCerts):
+                self.assertEqual(outCert, self.convertCertFile(inFile), 'Conversion of %s differs from convert-cert' % inFile)
+
+    def test_BadInput(self):
+        '''Test conversion of a directory holding a malformed certificate'''
+
+        certDir = self.prepareCertDir()
+
+        # A PEM certificate whose content is not a DER certificate, in the middle of the PEM stream.
+        badCertFile = os.path.join(certDir, '%02d.pem' % 5)
+        with open(badCertFile, 'w') as f:
+            f.write('-----BEGIN CERTIFICATE-----\n%s\n-----END CERTIFICATE-----\n' % base64.b64encode('\x30\x03\x02\x01\x00' * 16))
+
+        (pemResult, derResult) = self.convertCertDir(certDir)
+
+        (inFiles, res, stderr, outData) = pemResult
+        self.assertNotEqual(res, 0, 'Command succeeded on a malformed certificate')
+        self.assertIn('Error converting certificate %d' % (inFiles.index(badCertFile) + 1), stderr)
+        self.assertIsNone(outData, 'Output file left behind after a failed conversion')
+
+        # The DER stream is unaffected.
+        (inFiles, res, stderr, outData) = derResult
+        self.assertEqual(res, 0, 'Command returned %d' % res)
+        self.assertEqual(len(outData.splitlines()), len(inFiles), 'Unexpected number of converted certificates')
+
 def locateBrewOpenSSL():
     opensslPath = None
     if platform.system() == 'Darwin':
@@ -32,9 +32,11 @@
 
 #include <BleLayer/WoBle.h>
 #include <BleLayer/BleLayer.h>
+#include <BleLayer/BleApplicationDelegate.h>
 #include <nlunit-test.h>
 
 #include "ToolCommon.h"
+#include "MockBlePlatformDelegate.h"
 
 using namespace nl::Ble;
 
@@ -336,7 +338,413 @@ static void HandleCharacteristicSendThreePacket(nlTestSuite *inSuite, void *inCo
     woble.LogState();
 }
 
+#if BLE_LAYER_NUM_BLE_ENDPOINTS >= 4
 
+class LoopbackBleApplicationDelegate :
+    public nl::Ble::BleApplicationDelegate
+{
+    void NotifyWeaveConnectionClosed(BLE_CONNECTION_OBJECT connObj) { }
+};
+
+enum
+{
+    kNumMultiConnections          = 2,
+    kMultiConnectionMessageCount  = 8,
+    kMultiConnectionMessageSize   = 600,
+    kMultiConnectionMTU           = 104,
+    kLargeFragmentMTU             = 247,
+    kMultiConnectionLatencyMs     = 1,
+    kMultiConnectionTimeoutMs     = 10000,
+    kSendSlotWakeTimeoutMs        = 500
+};
+
+// One central, connected to two peripherals. Each connection has its own central end point,
+// so the central BleLayer drives two BLEEndPoints at once.
+struct MultiConnectionContext
+{
+    BleLayer CentralBle;
+    BleLayer PeripheralBle[kNumMultiConnections];
+    MockBlePlatformDelegate CentralPlatformDelegate;
+    MockBlePlatformDelegate PeripheralPlatformDelegate[kNumMultiConnections];
+    LoopbackBleApplicationDelegate ApplicationDelegate;
+    uint8_t CentralConn[kNumMultiConnections];
+    uint8_t PeripheralConn[kNumMultiConnections];
+    BLEEndPoint * CentralEndPoint[kNumMultiConnections];
+    uint32_t MessagesReceived[kNumMultiConnections];
+    uint32_t PeerMessagesReceivedAtFirstCompletion;
+    int NumConnected;
+    bool Failed;
+    bool Done;
+};
+
+static MultiConnectionContext sMultiConnectionStorage;
+static MultiConnectionContext * sMultiConnectionContext;
+
+static int MultiConnectionIndex(BleLayer * peripheralBle)
+{
+    return static_cast<int>(peripheralBle - sMultiConnectionContext->PeripheralBle);
+}
+
+static void HandleMultiConnectionMessageReceived(BLEEndPoint * endPoint, PacketBuffer * msg)
+{
+    MultiConnectionContext & ctx = *sMultiConnectionContext;
+    int index                    = MultiConnectionIndex(endPoint->mBle);
+
+    if (msg->DataLength() != kMultiConnectionMessageSize || msg->Start()[0] != static_cast<uint8_t>(index))
+    {
+        ctx.Failed = ctx.Done = true;
+    }
+
+    PacketBuffer::Free(msg);
+
+    if (++ctx.MessagesReceived[index] == kMultiConnectionMessageCount)
+    {
+        // Record how far the other connection got by the time this one finished.
+        if (ctx.MessagesReceived[1 - index] < kMultiConnectionMessageCount)
+        {
+            ctx.PeerMessagesReceivedAtFirstCompletion = ctx.MessagesReceived[1 - index];
+        }
+        else
+        {
+            ctx.Done = true;
+        }
+    }
+}
+
+static void HandleMultiConnectionClosed(BLEEndPoint * endPoint, BLE_ERROR err)
+{
+    if (!sMultiConnectionContext->Done)
+    {
+        sMultiConnectionContext->Failed = sMultiConnectionContext->Done = true;
+    }
+}
+
+static void HandleMultiConnectionConnectReceived(BLEEndPoint * endPoint)
+{
+    endPoint->OnMessageReceived  = HandleMultiConnectionMessageReceived;
+    endPoint->OnConnectionClosed = HandleMultiConnectionClosed;
+}
+
+static void HandleMultiConnectionConnectComplete(BLEEndPoint * endPoint, BLE_ERROR err)
+{
+    MultiConnectionContext & ctx = *sMultiConnectionContext;
+
+    if (err != BLE_NO_ERROR)
+    {
+        ctx.Failed = ctx.Done = true;
+        return;
+    }
+
+    // Queue every message on both connections only once both are up, so that they compete for the link.
+    if (++ctx.NumConnected < kNumMultiConnections)
+    {
+        return;
+    }
+
+    for (int i = 0; i < kNumMultiConnections; i++)
+    {
+        for (int j = 0; j < kMultiConnectionMessageCount; j++)
+        {
+            PacketBuffer * msg = PacketBuffer::New();
+
+            if (msg == NULL || msg->AvailableDataLength() < kMultiConnectionMessageSize)
+            {
+                PacketBuffer::Free(msg);
+                ctx.Failed = ctx.Done = true;
+                return;
+            }
+
+            memset(msg->Start(), i, kMultiConnectionMessageSize);
+            msg->SetDataLength(kMultiConnectionMessageSize);
+
+            if (ctx.CentralEndPoint[i]->Send(msg) != BLE_NO_ERROR)
+            {
+                ctx.Failed = ctx.Done = true;
+                return;
+            }
+        }
+    }
+}
+
+static MultiConnectionContext & InitMultiConnections(nlTestSuite *inSuite, uint16_t mtu)
+{
+    MultiConnectionContext & ctx = sMultiConnectionStorage;
+    BLE_ERROR err;
+
+    memset(ctx.CentralEndPoint, 0, sizeof(ctx.CentralEndPoint));
+    memset(ctx.MessagesReceived, 0, sizeof(ctx.MessagesReceived));
+    ctx.PeerMessagesReceivedAtFirstCompletion = 0;
+    ctx.NumConnected                          = 0;
+    ctx.Failed                                = false;
+    ctx.Done                                  = false;
+    sMultiConnectionContext                   = &ctx;
+
+    InitSystemLayer();
+
+    err = ctx.CentralBle.Init(&ctx.CentralPlatformDelegate, &ctx.ApplicationDelegate, &SystemLayer);
+    NL_TEST_ASSERT(inSuite, err == BLE_NO_ERROR);
+
+    for (int i = 0; i < kNumMultiConnections; i++)
+    {
+        err = ctx.PeripheralBle[i].Init(&ctx.PeripheralPlatformDelegate[i], &ctx.ApplicationDelegate, &SystemLayer);
+        NL_TEST_ASSERT(inSuite, err == BLE_NO_ERROR);
+
+        ctx.PeripheralBle[i].OnWeaveBleConnectReceived = HandleMultiConnectionConnectReceived;
+
+        NL_TEST_ASSERT(inSuite, ctx.CentralPlatformDelegate.AddLoopback(&SystemLayer, &ctx.CentralBle, &ctx.CentralConn[i],
+                                                                         &ctx.PeripheralBle[i], &ctx.PeripheralConn[i],
+                                                                         mtu, kMultiConnectionLatencyMs));
+        NL_TEST_ASSERT(inSuite, ctx.PeripheralPlatformDelegate[i].AddLoopback(&SystemLayer, &ctx.PeripheralBle[i], &ctx.PeripheralConn[i],
+                                                                              &ctx.CentralBle, &ctx.CentralConn[i],
+                                                                              mtu, kMultiConnectionLatencyMs));
+    }
+
+    return ctx;
+}
+
+static void ShutdownMultiConnections(void)
+{
+    MultiConnectionContext & ctx = *sMultiConnectionContext;
+
+    ctx.CentralBle.Shutdown();
+    for (int i = 0; i < kNumMultiConnections; i++)
+    {
+        ctx.PeripheralBle[i].Shutdown();
+    }
+
+    ctx.CentralPlatformDelegate.RemoveLoopbacks();
+    for (int i = 0; i < kNumMultiConnections; i++)
+    {
+        ctx.PeripheralPlatformDelegate[i].RemoveLoopbacks();
+    }
+
+    ShutdownSystemLayer();
+
+    sMultiConnectionContext = NULL;
+}
+
+static void HandleMultipleConnections(nlTestSuite *inSuite, void *inContext)
+{
+    MultiConnectionContext & ctx = InitMultiConnections(inSuite, kMultiConnectionMTU);
+    BLE_ERROR err;
+    struct timeval sleepTime;
+    uint64_t startTimeMs;
+
+    for (int i = 0; i < kNumMultiConnections; i++)
+    {
+        err = ctx.CentralBle.NewBleEndPoint(&ctx.CentralEndPoint[i], &ctx.CentralConn[i], kBleRole_Central, true);
+        NL_TEST_ASSERT(inSuite, err == BLE_NO_ERROR);
+        if (err != BLE_NO_ERROR)
+        {
+            ctx.Failed = ctx.Done = true;
+            break;
+        }
+
+        ctx.CentralEndPoint[i]->OnConnectComplete  = HandleMultiConnectionConnectComplete;
+        ctx.CentralEndPoint[i]->OnConnectionClosed = HandleMultiConnectionClosed;
+
+        err = ctx.CentralEndPoint[i]->StartConnect();
+        NL_TEST_ASSERT(inSuite, err == BLE_NO_ERROR);
+    }
+
+    sleepTime.tv_sec  = 0;
+    sleepTime.tv_usec = 1000;
+    startTimeMs       = NowMs();
+
+    while (!ctx.Done && NowMs() - startTimeMs < kMultiConnectionTimeoutMs)
+    {
+        ServiceNetwork(sleepTime);
+    }
+
+    NL_TEST_ASSERT(inSuite, ctx.Done && !ctx.Failed);
+
+    for (int i = 0; i < kNumMultiConnections; i++)
+    {
+        NL_TEST_ASSERT(inSuite, ctx.MessagesReceived[i] == kMultiConnectionMessageCount);
+    }
+
+    // Fragments are scheduled round-robin across end points, so neither connection starves the other.
+    NL_TEST_ASSERT(inSuite, ctx.PeerMessagesReceivedAtFirstCompletion + 1 >= kMultiConnectionMessageCount);
+
+    ShutdownMultiConnections();
+}
+
+static void HandleSingleConnectionConnectComplete(BLEEndPoint * endPoint, BLE_ERROR err)
+{
+    MultiConnectionContext & ctx = *sMultiConnectionContext;
+
+    if (err != BLE_NO_ERROR)
+    {
+        ctx.Failed = ctx.Done = true;
+        return;
+    }
+
+    ctx.NumConnected++;
+}
+
+static BLE_ERROR StartSingleConnection(MultiConnectionContext & ctx, int index)
+{
+    BLE_ERROR err = ctx.CentralBle.NewBleEndPoint(&ctx.CentralEndPoint[index], &ctx.CentralConn[index], kBleRole_Central, true);
+
+    if (err == BLE_NO_ERROR)
+    {
+        ctx.CentralEndPoint[index]->OnConnectComplete  = HandleSingleConnectionConnectComplete;
+        ctx.CentralEndPoint[index]->OnConnectionClosed = HandleMultiConnectionClosed;
+
+        err = ctx.CentralEndPoint[index]->StartConnect();
+    }
+
+    return err;
+}
+
+// Fragments are negotiated up to the ATT MTU, less the ATT header, within the configured maximum fragment size.
+static void HandleLargeFragments(nlTestSuite *inSuite, void *inContext)
+{
+    MultiConnectionContext & ctx = InitMultiConnections(inSuite, kLargeFragmentMTU);
+    BLE_ERROR err;
+    struct timeval sleepTime;
+    uint64_t startTimeMs;
+    PacketBuffer * msg;
+
+    sleepTime.tv_sec  = 0;
+    sleepTime.tv_usec = 1000;
+
+    err = StartSingleConnection(ctx, 0);
+    NL_TEST_ASSERT(inSuite, err == BLE_NO_ERROR);
+
+    startTimeMs = NowMs();
+    while (!ctx.Done && ctx.NumConnected < 1 && NowMs() - startTimeMs < kMultiConnectionTimeoutMs)
+    {
+        ServiceNetwork(sleepTime);
+    }
+
+    NL_TEST_ASSERT(inSuite, ctx.NumConnected == 1);
+
+    msg = PacketBuffer::New();
+    NL_TEST_ASSERT(inSuite, msg != NULL && msg->AvailableDataLength() >= kMultiConnectionMessageSize);
+
+    if (ctx.NumConnected == 1 && msg != NULL && msg->AvailableDataLength() >= kMultiConnectionMessageSize)
+    {
+        memset(msg->Start(), 0, kMultiConnectionMessageSize);
+        msg->SetDataLength(kMultiConnectionMessageSize);
+
+        err = ctx.CentralEndPoint[0]->Send(msg);
+        NL_TEST_ASSERT(inSuite, err == BLE_NO_ERROR);
+    }
+    else
+    {
+        PacketBuffer::Free(msg);
+    }
+
+    startTimeMs = NowMs();
+    while (!ctx.Done && ctx.MessagesReceived[0] < 1 && NowMs() - startTimeMs < kMultiConnectionTimeoutMs)
+    {
+        ServiceNetwork(sleepTime);
+    }
+
+    NL_TEST_ASSERT(inSuite, !ctx.Failed);
+    NL_TEST_ASSERT(inSuite, ctx.MessagesReceived[0] == 1);
+
+    // The mock refuses values that don't fit the MTU, so the message went out in the largest fragments allowed.
+    NL_TEST_ASSERT(inSuite, ctx.CentralPlatformDelegate.GetMaxValueLength() ==
+                                nl::Weave::min(static_cast<uint16_t>(kLargeFragmentMTU - 3),
+                                               static_cast<uint16_t>(BLE_CONFIG_MAX_FRAGMENT_SIZE)));
+
+    ctx.Done = true;
+
+    ShutdownMultiConnections();
+}
+
+#if BLE_LAYER_MAX_GATT_SENDS_IN_FLIGHT == 1
+
+// An end point that finds the only GATT send slot taken by another end point's subscribe waits for a slot.
+// It must be given the slot once the subscribe completes.
+static void HandleSendDuringSubscribe(nlTestSuite *inSuite, void *inContext)
+{
+    MultiConnectionContext & ctx = InitMultiConnections(inSuite, kMultiConnectionMTU);
+    BLE_ERROR err;
+    struct timeval sleepTime;
+    uint64_t startTimeMs;
+    PacketBuffer * msg;
+
+    sleepTime.tv_sec  = 0;
+    sleepTime.tv_usec = 1000;
+
+    // Bring up the first connection on its own.
+    err = StartSingleConnection(ctx, 0);
+    NL_TEST_ASSERT(inSuite, err == BLE_NO_ERROR);
+
+    startTimeMs = NowMs();
+    while (!ctx.Done && ctx.NumConnected < 1 && NowMs() - startTimeMs < kMultiConnectionTimeoutMs)
+    {
+        ServiceNetwork(sleepTime);
+    }
+
+    NL_TEST_ASSERT(inSuite, ctx.NumConnected == 1);
+
+    // Start the second connection, and leave its subscribe in flight.
+    ctx.CentralPlatformDelegate.HoldSubscribes(true);
+
+    err = StartSingleConnection(ctx, 1);
+    NL_TEST_ASSERT(inSuite, err == BLE_NO_ERROR);
+
+    startTimeMs = NowMs();
+    while (!ctx.Done && !ctx.CentralPlatformDelegate.HasHeldSubscribe() && NowMs() - startTimeMs < kMultiConnectionTimeoutMs)
+    {
+        ServiceNetwork(sleepTime);
+    }
+
+    NL_TEST_ASSERT(inSuite, ctx.CentralPlatformDelegate.HasHeldSubscribe());
+
+    // The first end point now has to wait for the send slot held by the subscribe.
+    msg = PacketBuffer::New();
+    NL_TEST_ASSERT(inSuite, msg != NULL && msg->AvailableDataLength() >= kMultiConnectionMessageSize);
+
+    if (msg != NULL && msg->AvailableDataLength() >= kMultiConnectionMessageSize)
+    {
+        memset(msg->Start(), 0, kMultiConnectionMessageSize);
+        msg->SetDataLength(kMultiConnectionMessageSize);
+
+        err = ctx.CentralEndPoint[0]->Send(msg);
+        NL_TEST_ASSERT(inSuite, err == BLE_NO_ERROR);
+    }
+    else
+    {
+        PacketBuffer::Free(msg);
+    }
+
+    startTimeMs = NowMs();
+    while (NowMs() - startTimeMs < 20 * kMultiConnectionLatencyMs)
+    {
+        ServiceNetwork(sleepTime);
+    }
+
+    NL_TEST_ASSERT(inSuite, ctx.MessagesReceived[0] == 0);
+
+    ctx.CentralPlatformDelegate.HoldSubscribes(false);
+    ctx.CentralPlatformDelegate.ReleaseHeldSubscribe();
+
+    // The waiting end point must get the slot as soon as the subscribe completes, not when a BTP ack timer
+    // next fires on its connection.
+    startTimeMs = NowMs();
+    while (!ctx.Done && (ctx.NumConnected < kNumMultiConnections || ctx.MessagesReceived[0] < 1) &&
+           NowMs() - startTimeMs < kSendSlotWakeTimeoutMs)
+    {
+        ServiceNetwork(sleepTime);
+    }
+
+    NL_TEST_ASSERT(inSuite, !ctx.Failed);
+    NL_TEST_ASSERT(inSuite, ctx.NumConnected == kNumMultiConnections);
+    NL_TEST_ASSERT(inSuite, ctx.MessagesReceived[0] == 1);
+
+    ctx.Done = true;
+
+    ShutdownMultiConnections();
+}
+
+#endif // BLE_LAYER_MAX_GATT_SENDS_IN_FLIGHT == 1
+
+#endif // BLE_LAYER_NUM_BLE_ENDPOINTS >= 4
 
 /**
  *   Test Suite. It lists all the test functions.
@@ -348,6 +756,13 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Weave Over BLE HandleCharacteristicSendOnePacket",                 HandleCharacteristicSendOnePacket),
     NL_TEST_DEF("Weave Over BLE HandleCharacteristicSendTwoPacket",                 HandleCharacteristicSendTwoPacket),
     NL_TEST_DEF("Weave Over BLE HandleCharacteristicSendThreePacket",               HandleCharacteristicSendThreePacket),
+#if BLE_LAYER_NUM_BLE_ENDPOINTS >= 4
+    NL_TEST_DEF("Weave Over BLE HandleMultipleConnections",                         HandleMultipleConnections),
+    NL_TEST_DEF("Weave Over BLE HandleLargeFragments",                              HandleLargeFragments),
+#if BLE_LAYER_MAX_GATT_SENDS_IN_FLIGHT == 1
+    NL_TEST_DEF("Weave Over BLE HandleSendDuringSubscribe",                         HandleSendDuringSubscribe),
+#endif
+#endif
     NL_TEST_SENTINEL()
 };
 
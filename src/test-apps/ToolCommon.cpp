@@ -1528,6 +1528,33 @@ void PrintStatsCounters(nl::Weave::System::Stats::count_t *counters, const char
     }
 }
 
+#if WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
+void PrintLatencyStats(const nl::Weave::System::Stats::LatencySnapshot &aSnapshot, const char *aPrefix)
+{
+    const nl::Weave::System::Stats::Label *strings = nl::Weave::System::Stats::GetLatencyStrings();
+    const char *prefix = aPrefix ? aPrefix : "";
+
+    for (int i = 0; i < nl::Weave::System::Stats::kLatency_NumPoints; i++)
+    {
+        const nl::Weave::System::Stats::LatencyHistogram &histogram = aSnapshot.mHistograms[i];
+
+        if (histogram.mCount == 0)
+            continue;
+
+        printf("%s%s:\t\tcount %" PRIu32 ", avg %" PRIu64 " us, max %" PRIu32 " us\n", prefix, strings[i],
+               histogram.mCount, histogram.mTotalUS / histogram.mCount, histogram.mMaxUS);
+
+        for (int j = 0; j < nl::Weave::System::Stats::kLatency_NumBuckets; j++)
+        {
+            if (histogram.mBuckets[j] != 0)
+            {
+                printf("%s\t< %" PRIu32 " us:\t%" PRIu32 "\n", prefix, static_cast<uint32_t>(1) << j, histogram.mBuckets[j]);
+            }
+        }
+    }
+}
+#endif // WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
+
 bool ProcessStats(nl::Weave::System::Stats::Snapshot &aBefore, nl::Weave::System::Stats::Snapshot &aAfter, bool aPrint, const char *aPrefix)
 {
     bool leak = false;
@@ -1596,6 +1623,15 @@ bool ProcessStats(nl::Weave::System::Stats::Snapshot &aBefore, nl::Weave::System
         {
             printf("\nHigh watermarks:\n");
             PrintStatsCounters(aAfter.mHighWatermarks, prefix);
+
+#if WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
+            nl::Weave::System::Stats::LatencySnapshot latency;
+
+            nl::Weave::System::Stats::UpdateLatencySnapshot(latency);
+
+            printf("\n%sLatencies:\n", prefix);
+            PrintLatencyStats(latency, prefix);
+#endif // WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
         }
     }
 
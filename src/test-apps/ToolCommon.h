@@ -169,6 +169,9 @@ extern void ServiceNetworkUntil(const bool *aDone, const uint32_t *aIntervalMs =
 
 extern void PrintStatsCounters(nl::Weave::System::Stats::count_t *counters, const char *aPrefix);
 extern bool ProcessStats(nl::Weave::System::Stats::Snapshot &aBefore, nl::Weave::System::Stats::Snapshot &aAfter, bool aPrint, const char *aPrefix);
+#if WEAVE_SYSTEM_CONFIG_PROVIDE_LATENCY_STATISTICS
+extern void PrintLatencyStats(const nl::Weave::System::Stats::LatencySnapshot &aSnapshot, const char *aPrefix);
+#endif
 extern void PrintFaultInjectionCounters(void);
 extern void SetupFaultInjectionContext(int argc, char *argv[]);
 extern void SetupFaultInjectionContext(int argc, char *argv[], int32_t (*aNumEventsAvailable)(void), void (*aInjectAsyncEvents)(int32_t index));
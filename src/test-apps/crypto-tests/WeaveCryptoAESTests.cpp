@@ -185,6 +185,64 @@ static void Check_AES128CTRMode_Test4(nlTestSuite *inSuite, void *inContext)
     aes128CTR.Reset();
 }
 
+static void Check_AES128CTRMode_Test5(nlTestSuite *inSuite, void *inContext)
+{
+    AES128CTRMode aes128CTR;
+    AES128BlockCipherEnc aes128BlockEnc;
+    bool res;
+
+    static uint8_t key[]                = { 0x76, 0x91, 0xBE, 0x03, 0x5E, 0x50, 0x20, 0xA8, 0xAC, 0x6E, 0x61, 0x85, 0x29, 0xF9, 0xA0, 0xDC };
+    // The low bytes of the counter carry while encrypting.
+    static uint8_t ctr[]                = { 0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa, 0xfb, 0x00, 0xff, 0xff, 0xfd };
+    // Sizes of the successive calls to EncryptData(), mixing partial, single and multiple blocks.
+    static const uint16_t chunkSizes[] = { 5, 11, 16, 100, 64, 3, 200, 1, 624 };
+    uint8_t plainText[1024];
+    uint8_t cipherText[sizeof(plainText)];
+    uint8_t expectedCipherText[sizeof(plainText)];
+    uint8_t counter[sizeof(ctr)];
+    uint8_t encryptedCounter[sizeof(ctr)];
+    size_t offset;
+
+    for (size_t i = 0; i < sizeof(plainText); i++)
+    {
+        plainText[i] = (uint8_t) (i * 7 + 3);
+    }
+
+    // Generate the expected ciphertext one block at a time.
+    aes128BlockEnc.SetKey(key);
+    memcpy(counter, ctr, sizeof(counter));
+
+    for (offset = 0; offset < sizeof(plainText); offset += sizeof(counter))
+    {
+        aes128BlockEnc.EncryptBlock(counter, encryptedCounter);
+
+        for (size_t i = 0; i < sizeof(counter); i++)
+        {
+            expectedCipherText[offset + i] = plainText[offset + i] ^ encryptedCounter[i];
+        }
+
+        for (size_t i = sizeof(counter); i > 12 && ++counter[i - 1] == 0; i--)
+            ;
+    }
+
+    aes128CTR.SetKey(key);
+    aes128CTR.SetCounter(ctr);
+
+    offset = 0;
+    for (size_t i = 0; i < sizeof(chunkSizes) / sizeof(chunkSizes[0]); i++)
+    {
+        aes128CTR.EncryptData(plainText + offset, chunkSizes[i], cipherText + offset);
+        offset += chunkSizes[i];
+    }
+
+    res = (offset == sizeof(plainText) && memcmp(cipherText, expectedCipherText, sizeof(plainText)) == 0);
+
+    // Invalid ciphertext generated by AES128CTRMode::EncryptData()
+    NL_TEST_ASSERT(inSuite, res == true);
+
+    aes128CTR.Reset();
+}
+
 bool AES256CTRMode_DoTest(const uint8_t *key, const uint8_t *ctr, const uint8_t *plainText, size_t plainTextLen, const uint8_t *expectedCipherText)
 {
     uint8_t cipherText[TEXT_BUFFER_LENGHT] = { 0 };
@@ -346,6 +404,37 @@ static void Check_AES128BlockCipher_Test1(nlTestSuite *inSuite, void *inContext)
     NL_TEST_ASSERT(inSuite, res == true);
 }
 
+static void Check_AES128BlockCipher_Test2(nlTestSuite *inSuite, void *inContext)
+{
+    AES128BlockCipherEnc aes128BlockEnc;
+    uint8_t plainText[7 * AES128BlockCipherEnc::kBlockLength];
+    uint8_t cipherText[sizeof(plainText)];
+    uint8_t expectedCipherText[sizeof(plainText)];
+    bool res;
+
+    static uint8_t key[]                = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+
+    for (size_t i = 0; i < sizeof(plainText); i++)
+    {
+        plainText[i] = (uint8_t) i;
+    }
+
+    aes128BlockEnc.SetKey(key);
+
+    for (size_t i = 0; i < sizeof(plainText); i += AES128BlockCipherEnc::kBlockLength)
+    {
+        aes128BlockEnc.EncryptBlock(plainText + i, expectedCipherText + i);
+    }
+
+    // Encrypt a number of blocks that is not a multiple of the interleave factor.
+    aes128BlockEnc.EncryptBlocks(plainText, cipherText, sizeof(plainText) / AES128BlockCipherEnc::kBlockLength);
+
+    res = (memcmp(cipherText, expectedCipherText, sizeof(plainText)) == 0);
+
+    // Invalid ciphertext generated by AES128BlockCipherEnc::EncryptBlocks()
+    NL_TEST_ASSERT(inSuite, res == true);
+}
+
 bool AES256BlockCipher_DoTest(const uint8_t *key, const uint8_t *plainText, const uint8_t *expectedCipherText)
 {
     uint8_t cipherText[AES256BlockCipherEnc::kBlockLength];
@@ -407,10 +496,12 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("AES128CTRMode Test2",        Check_AES128CTRMode_Test2),
     NL_TEST_DEF("AES128CTRMode Test3",        Check_AES128CTRMode_Test3),
     NL_TEST_DEF("AES128CTRMode Test4",        Check_AES128CTRMode_Test4),
+    NL_TEST_DEF("AES128CTRMode Test5",        Check_AES128CTRMode_Test5),
     NL_TEST_DEF("AES256CTRMode Test1",        Check_AES256CTRMode_Test1),
     NL_TEST_DEF("AES256CTRMode Test2",        Check_AES256CTRMode_Test2),
     NL_TEST_DEF("AES256CTRMode Test3",        Check_AES256CTRMode_Test3),
     NL_TEST_DEF("AES128BlockCipher Test1",    Check_AES128BlockCipher_Test1),
+    NL_TEST_DEF("AES128BlockCipher Test2",    Check_AES128BlockCipher_Test2),
     NL_TEST_DEF("AES256BlockCipher Test1",    Check_AES256BlockCipher_Test1),
     NL_TEST_SENTINEL()
 };
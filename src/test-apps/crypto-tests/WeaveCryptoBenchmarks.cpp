@@ -0,0 +1,150 @@
+/*
+ *
+ *    Copyright (c) 2018 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements throughput benchmarks for the Weave Crypto
+ *      hash, HMAC and HKDF functions.
+ *
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <Weave/Support/crypto/HashAlgos.h>
+#include <Weave/Support/crypto/HMAC.h>
+#include <Weave/Support/crypto/HKDF.h>
+#include <SystemLayer/SystemLayer.h>
+
+#include "WeaveCryptoTests.h"
+
+using namespace nl::Weave::Crypto;
+using namespace nl::Weave::Platform::Security;
+
+namespace {
+
+enum
+{
+    kMaxDataLength              = 16384,
+    kTargetBytes                = 16 * 1024 * 1024
+};
+
+const uint16_t sDataLengths[] = { 64, 1024, kMaxDataLength };
+
+uint8_t sData[kMaxDataLength];
+
+const uint8_t sKey[] =
+{
+    0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b,
+    0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b
+};
+
+uint64_t NowUS(void)
+{
+    return nl::Weave::System::Layer::GetClock_MonotonicHiRes();
+}
+
+void PrintResult(const char *name, uint16_t dataLen, uint32_t iterations, uint64_t elapsedUS)
+{
+    if (elapsedUS == 0)
+        elapsedUS = 1;
+
+    printf("%-16s %6u bytes: %10" PRIu64 " ns/op, %8.1f MB/s\n", name, dataLen,
+           (elapsedUS * 1000) / iterations, ((double)dataLen * iterations) / elapsedUS);
+}
+
+template <class H>
+void BenchHash(const char *name)
+{
+    H hash;
+    uint8_t hashBuf[H::kHashLength];
+
+    for (size_t i = 0; i < sizeof(sDataLengths) / sizeof(sDataLengths[0]); i++)
+    {
+        uint32_t iterations = kTargetBytes / sDataLengths[i];
+        uint64_t start = NowUS();
+
+        for (uint32_t j = 0; j < iterations; j++)
+        {
+            hash.Begin();
+            hash.AddData(sData, sDataLengths[i]);
+            hash.Finish(hashBuf);
+        }
+
+        PrintResult(name, sDataLengths[i], iterations, NowUS() - start);
+    }
+}
+
+void BenchHMACSHA256(void)
+{
+    HMACSHA256 hmac;
+    uint8_t digest[HMACSHA256::kDigestLength];
+
+    for (size_t i = 0; i < sizeof(sDataLengths) / sizeof(sDataLengths[0]); i++)
+    {
+        uint32_t iterations = kTargetBytes / sDataLengths[i];
+        uint64_t start = NowUS();
+
+        for (uint32_t j = 0; j < iterations; j++)
+        {
+            hmac.Begin(sKey, sizeof(sKey));
+            hmac.AddData(sData, sDataLengths[i]);
+            hmac.Finish(digest);
+        }
+
+        PrintResult("HMAC-SHA256", sDataLengths[i], iterations, NowUS() - start);
+    }
+}
+
+void BenchHKDFSHA256(void)
+{
+    // Derive a key the size of a Weave AES-128-CTR/HMAC-SHA1 message encryption key.
+    enum
+    {
+        kDerivedKeyLength       = 36,
+        kIterations             = 100000
+    };
+
+    uint8_t derivedKey[kDerivedKeyLength];
+    uint64_t start = NowUS();
+
+    for (uint32_t j = 0; j < kIterations; j++)
+    {
+        HKDFSHA256::DeriveKey(NULL, 0, sKey, sizeof(sKey), NULL, 0, sData, 16, derivedKey, sizeof(derivedKey), sizeof(derivedKey));
+    }
+
+    PrintResult("HKDF-SHA256", kDerivedKeyLength, kIterations, NowUS() - start);
+}
+
+} // unnamed namespace
+
+int WeaveCryptoBenchmarks(void)
+{
+    for (size_t i = 0; i < sizeof(sData); i++)
+    {
+        sData[i] = (uint8_t)i;
+    }
+
+    BenchHash<nl::Weave::Platform::Security::SHA1>("SHA1");
+    BenchHash<nl::Weave::Platform::Security::SHA256>("SHA256");
+    BenchHMACSHA256();
+    BenchHKDFSHA256();
+
+    return 0;
+}
@@ -22,17 +22,20 @@
  *
  */
 
+#include <stdlib.h>
 #include <string.h>
 
 #include <nlunit-test.h>
 
 #include <Weave/Support/crypto/HashAlgos.h>
 #include <Weave/Support/crypto/CTRMode.h>
+#include <SystemLayer/SystemPacketBuffer.h>
 
 #include "WeaveCryptoTests.h"
 
 using namespace nl::Weave::Crypto;
 using namespace nl::Weave::Platform::Security;
+using nl::Weave::System::PacketBuffer;
 
 static void Check_SHA1_Test1(nlTestSuite *inSuite, void *inContext)
 {
@@ -303,12 +306,89 @@ static void Check_SHA1_Test3(nlTestSuite *inSuite, void *inContext)
     NL_TEST_ASSERT(inSuite, memcmp(hashBuf, LongMsg6056Result, SHA1::kHashLength) == 0);
 }
 
+static void Check_SHA256_Test1(nlTestSuite *inSuite, void *inContext)
+{
+    // This is the long message test from FIPS 180-2: one million repetitions of "a",
+    // added to the hash in a single call.
+    static const uint32_t kMillionALength = 1000000;
+    static const uint8_t MillionAResult[] =
+    {
+          0xcd, 0xc7, 0x6e, 0x5c, 0x99, 0x14, 0xfb, 0x92, 0x81, 0xa1, 0xc7, 0xe2, 0x84, 0xd7, 0x3e, 0x67,
+          0xf1, 0x80, 0x9a, 0x48, 0xa4, 0x97, 0x20, 0x0e, 0x04, 0x6d, 0x39, 0xcc, 0xc7, 0x11, 0x2c, 0xd0
+    };
+
+    nl::Weave::Platform::Security::SHA256 sha256;
+    uint8_t hashBuf[SHA256::kHashLength];
+    uint8_t *msg;
+
+    msg = (uint8_t *)malloc(kMillionALength);
+
+    // Skip the test on platforms that cannot allocate the message.
+    if (msg == NULL)
+        return;
+
+    memset(msg, 'a', kMillionALength);
+
+    sha256.Begin();
+    sha256.AddData(msg, kMillionALength);
+    sha256.Finish(hashBuf);
+    // Invalid SHA256 result (one million "a")
+    NL_TEST_ASSERT(inSuite, memcmp(hashBuf, MillionAResult, SHA256::kHashLength) == 0);
+
+    free(msg);
+}
+
+static void Check_SHA256_Test2(nlTestSuite *inSuite, void *inContext)
+{
+    // This is the two block test from FIPS 180-2, added to the hash from a chain of buffers.
+    static const char Msg[] = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    static const uint16_t ChunkLengths[] = { 20, 20, 16 };
+    static const uint8_t MsgResult[] =
+    {
+          0x24, 0x8d, 0x6a, 0x61, 0xd2, 0x06, 0x38, 0xb8, 0xe5, 0xc0, 0x26, 0x93, 0x0c, 0x3e, 0x60, 0x39,
+          0xa3, 0x3c, 0xe4, 0x59, 0x64, 0xff, 0x21, 0x67, 0xf6, 0xec, 0xed, 0xd4, 0x19, 0xdb, 0x06, 0xc1
+    };
+
+    nl::Weave::Platform::Security::SHA256 sha256;
+    uint8_t hashBuf[SHA256::kHashLength];
+    PacketBuffer *msgBuf = NULL;
+    const char *chunk = Msg;
+
+    for (size_t i = 0; i < sizeof(ChunkLengths) / sizeof(ChunkLengths[0]); i++)
+    {
+        PacketBuffer *buf = PacketBuffer::New(0);
+
+        NL_TEST_ASSERT(inSuite, buf != NULL);
+        if (buf == NULL)
+            break;
+
+        memcpy(buf->Start(), chunk, ChunkLengths[i]);
+        buf->SetDataLength(ChunkLengths[i]);
+        chunk += ChunkLengths[i];
+
+        if (msgBuf == NULL)
+            msgBuf = buf;
+        else
+            msgBuf->AddToEnd(buf);
+    }
+
+    sha256.Begin();
+    sha256.AddData(msgBuf);
+    sha256.Finish(hashBuf);
+    // Invalid SHA256 result (buffer chain)
+    NL_TEST_ASSERT(inSuite, memcmp(hashBuf, MsgResult, SHA256::kHashLength) == 0);
+
+    PacketBuffer::Free(msgBuf);
+}
+
 static const nlTest sTests[] = {
     NL_TEST_DEF("SHA1 Test1",          Check_SHA1_Test1),
 #if WEAVE_WITH_OPENSSL
     NL_TEST_DEF("SHA1 Test2",          Check_SHA1_Test2),
 #endif
     NL_TEST_DEF("SHA1 Test3",          Check_SHA1_Test3),
+    NL_TEST_DEF("SHA256 Test1",        Check_SHA256_Test1),
+    NL_TEST_DEF("SHA256 Test2",        Check_SHA256_Test2),
     NL_TEST_SENTINEL()
 };
 
@@ -52,4 +52,10 @@ int WeaveCryptoHKDFTests(void);
  */
 int WeaveCryptoAESTests(void);
 
+/*
+ * Throughput benchmarks for hash, HMAC and HKDF functions.
+ * Not run as part of the tests since their results are not pass/fail.
+ */
+int WeaveCryptoBenchmarks(void);
+
 #endif /* WEAVE_CRYPTO_TESTS_H_ */
@@ -203,6 +203,11 @@ class Weave(WeaveState):
         cmd_path = self.__get_cmd_path("mock-device")
         return cmd_path
 
+    def getWeaveMultiDeviceManagerPath(self):
+        self.__check_weave_path()
+        cmd_path = self.__get_cmd_path("TestMultiDeviceManager")
+        return cmd_path
+
     def getWeaveDeviceDescriptionClientPath(self):
         self.__check_weave_path()
         cmd_path = self.__get_cmd_path("weave-dd-client")
@@ -57,6 +57,8 @@ options["server_faults"] = None
 options["strace"] = True
 options["test_tag"] = ""
 options["iterations"] = 1
+options["checkpoint"] = None
+options["window_size"] = None
 options["plaid"] = False
 
 
@@ -129,6 +131,8 @@ class WeaveBDX(HappyNode, HappyNetwork, WeaveTest):
         self.server_faults = opts["server_faults"]
         self.client_faults = opts["client_faults"]
         self.iterations = opts["iterations"]
+        self.checkpoint = opts["checkpoint"]
+        self.window_size = opts["window_size"]
 
         self.server_process_tag = "WEAVE-BDX-SERVER" + opts["test_tag"]
         self.client_process_tag = "WEAVE-BDX-CLIENT" + opts["test_tag"]
@@ -386,6 +390,12 @@ class WeaveBDX(HappyNode, HappyNetwork, WeaveTest):
                 else:
                     cmd += " -r " + self.upload + " -p -u"
 
+            if self.checkpoint != None:
+                cmd += " -c " + self.checkpoint
+
+            if self.window_size != None:
+                cmd += " -w " + str(self.window_size)
+
         if self.offset != None:
                 cmd += " -s " + self.offset
 
@@ -0,0 +1,239 @@
+#!/usr/bin/env python3
+
+
+#
+#    Copyright (c) 2020 Google LLC.
+#    All rights reserved.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+#
+
+#
+#    @file
+#       Implements WeaveMultiPairing class that provisions several mock devices
+#       concurrently from a single Weave Multi-Device Manager.
+#
+
+from __future__ import absolute_import
+from __future__ import print_function
+import re
+import sys
+
+from happy.ReturnMsg import ReturnMsg
+from happy.Utils import *
+from happy.utils.IP import IP
+from happy.HappyNode import HappyNode
+from happy.HappyNetwork import HappyNetwork
+
+from WeaveTest import WeaveTest
+
+
+options = {"quiet": False,
+           "mobile": None,
+           "devices": [],
+           "tap": None,
+           "no_network": False,
+           "no_fabric": False,
+           "timeout": None,
+           "devices_info": [],
+           "mobile_node_id": None,
+           "mobile_process_tag": "WEAVE-MULTI-PAIRING-MOBILE",
+           "device_process_tag": "WEAVE-MULTI-PAIRING-DEVICE"}
+
+
+def option():
+    return options.copy()
+
+
+class WeaveMultiPairing(HappyNode, HappyNetwork, WeaveTest):
+    """
+    weave-multi-pairing [-h --help] [-q --quiet] [-m --mobile <NAME>] [-d --devices <NAME>...]
+        [-p --tap <TAP_INTERFACE>] [--no-network] [--no-fabric]
+
+    command to provision two mock devices concurrently:
+        $ weave-multi-pairing --mobile node01 --devices node02 node03
+
+    return:
+        True if every device was provisioned
+
+    """
+
+    def __init__(self, opts=options):
+        HappyNode.__init__(self)
+        HappyNetwork.__init__(self)
+        WeaveTest.__init__(self)
+        self.__dict__.update(opts)
+
+    def __pre_check(self):
+        self.devices_info = []
+
+        # Make sure that fabric was created
+        if self.getFabricId() == None:
+            emsg = "Weave Fabric has not been created yet."
+            self.logger.error("[localhost] WeaveMultiPairing: %s" % (emsg))
+            sys.exit(1)
+
+        # Check if the mobile node is given.
+        if self.mobile == None:
+            emsg = "Missing name or address of the Weave Multi Pairing mobile node."
+            self.logger.error("[localhost] WeaveMultiPairing: %s" % (emsg))
+            sys.exit(1)
+
+        if self._nodeExists(self.mobile):
+            self.mobile_node_id = self.mobile
+
+        if IP.isIpAddress(self.mobile):
+            self.mobile_node_id = self.getNodeIdFromAddress(self.mobile)
+
+        if self.mobile_node_id == None:
+            emsg = "Unknown identity of the mobile node."
+            self.logger.error("[localhost] WeaveMultiPairing: %s" % (emsg))
+            sys.exit(1)
+
+        self.mobile_ip = self.getNodeWeaveIPAddress(self.mobile_node_id)
+
+        if self.mobile_ip == None:
+            emsg = "Could not find IP address of the mobile node."
+            self.logger.error("[localhost] WeaveMultiPairing: %s" % (emsg))
+            sys.exit(1)
+
+        if not self.devices:
+            emsg = "Missing names or addresses of the Weave Multi Pairing device nodes."
+            self.logger.error("[localhost] WeaveMultiPairing: %s" % (emsg))
+            sys.exit(1)
+
+        for device in self.devices:
+            device_node_id = None
+
+            if self._nodeExists(device):
+                device_node_id = device
+
+            if IP.isIpAddress(device):
+                device_node_id = self.getNodeIdFromAddress(device)
+
+            if device_node_id == None:
+                emsg = "Unknown identity of the device node %s." % (device)
+                self.logger.error("[localhost] WeaveMultiPairing: %s" % (emsg))
+                sys.exit(1)
+
+            device_ip = self.getNodeWeaveIPAddress(device_node_id)
+            device_weave_id = self.getWeaveNodeID(device_node_id)
+
+            if device_ip == None or device_weave_id == None:
+                emsg = "Could not find IP address or Weave node ID of the device node %s." % (device_node_id)
+                self.logger.error("[localhost] WeaveMultiPairing: %s" % (emsg))
+                sys.exit(1)
+
+            self.devices_info.append({'device': device,
+                                      'device_node_id': device_node_id,
+                                      'device_ip': device_ip,
+                                      'device_weave_id': device_weave_id,
+                                      'device_process_tag': device + "_" + self.device_process_tag})
+
+    def __start_device_side(self, device_info):
+        cmd = self.getWeaveMockDevicePath()
+        if not cmd:
+            return
+
+        cmd += " --node-addr " + device_info['device_ip'] + " --pairing-code TEST"
+
+        if self.tap:
+            cmd += " --tap-device " + self.tap
+
+        self.start_weave_process(device_info['device_node_id'], cmd, device_info['device_process_tag'],
+                                 sync_on_output=self.ready_to_service_events_str)
+
+    def __start_mobile_side(self):
+        cmd = self.getWeaveMultiDeviceManagerPath()
+        if not cmd:
+            return
+
+        cmd += " --node-addr " + self.mobile_ip
+
+        for device_info in self.devices_info:
+            cmd += " --device " + device_info['device_weave_id'] + "," + device_info['device_ip']
+
+        if self.no_network:
+            cmd += " --no-network"
+
+        if self.no_fabric:
+            cmd += " --no-fabric"
+
+        if self.tap:
+            cmd += " --tap-device " + self.tap
+
+        self.start_weave_process(self.mobile_node_id, cmd, self.mobile_process_tag)
+
+    def __process_results(self, mobile_output):
+        # e.g. "2 of 2 devices provisioned in 1234 ms: 1.62 devices/s"
+        result = False
+
+        summaryRE = re.compile(r'(\d+) of (\d+) devices provisioned')
+        for line in mobile_output.split("\n"):
+            m = summaryRE.search(line)
+            if m:
+                result = int(m.group(1)) == len(self.devices_info) and int(m.group(2)) == len(self.devices_info)
+
+        if self.quiet == False:
+            print("weave-multi-pairing from mobile %s (%s) to %d devices : " % \
+                (self.mobile_node_id, self.mobile_ip, len(self.devices_info)), end=' ')
+
+            if result:
+                print(hgreen("succeeded"))
+            else:
+                print(hred("failed"))
+
+        return result
+
+    def run(self):
+        self.logger.debug("[localhost] WeaveMultiPairing: Run.")
+
+        self.__pre_check()
+
+        for device_info in self.devices_info:
+            self.__start_device_side(device_info)
+
+        self.__start_mobile_side()
+
+        self.wait_for_test_to_end(self.mobile_node_id, self.mobile_process_tag, timeout=self.timeout)
+
+        mobile_output_value, mobile_output_data = \
+            self.get_test_output(self.mobile_node_id, self.mobile_process_tag, True)
+        mobile_strace_value, mobile_strace_data = \
+            self.get_test_strace(self.mobile_node_id, self.mobile_process_tag, True)
+
+        devices_output_data = []
+        devices_strace_data = []
+
+        for device_info in self.devices_info:
+            self.stop_weave_process(device_info['device_node_id'], device_info['device_process_tag'])
+
+            device_output_value, device_output_data = \
+                self.get_test_output(device_info['device_node_id'], device_info['device_process_tag'], True)
+            device_strace_value, device_strace_data = \
+                self.get_test_strace(device_info['device_node_id'], device_info['device_process_tag'], True)
+
+            devices_output_data.append(device_output_data)
+            devices_strace_data.append(device_strace_data)
+
+        result = self.__process_results(mobile_output_data)
+
+        data = {}
+        data["mobile_output"] = mobile_output_data
+        data["mobile_strace"] = mobile_strace_data
+        data["devices_output"] = devices_output_data
+        data["devices_strace"] = devices_strace_data
+        data["devices_info"] = self.devices_info
+
+        self.logger.debug("[localhost] WeaveMultiPairing: Done.")
+        return ReturnMsg(result, data)
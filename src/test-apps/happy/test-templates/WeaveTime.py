@@ -50,6 +50,10 @@ options = {
     "server_faults": False,
     "coordinator_faults": False,
     "iterations": None,
+    "client_contacts": None,
+    "client_sync_period": None,
+    "client_wait_str": None,
+    "client_run_secs": None,
     "test_tag": "",
     "strace": False,
     "plaid_server_env": {},
@@ -279,6 +283,13 @@ class WeaveTime(HappyNode, HappyNetwork, WeaveTest):
         if self.mode == "local":
             cmd += " --time-sync-mode-local" 
 
+            # "<node-id>,<node-addr>" strings for the client to sync with instead of the coordinator
+            for contact in self.client_contacts or []:
+                cmd += " --ts-local-contact " + contact
+
+            if self.client_sync_period:
+                cmd += " --ts-sync-period " + str(self.client_sync_period)
+
         elif self.mode == "service":                 ## TCP
             cmd += " --time-sync-mode-service"
 
@@ -299,7 +310,9 @@ class WeaveTime(HappyNode, HappyNetwork, WeaveTest):
         if self.iterations:
             cmd += " --iterations " + str(self.iterations)
 
-        if block_until_sync_succeeds:
+        if self.client_wait_str:
+            wait_str = self.client_wait_str
+        elif block_until_sync_succeeds:
             wait_str = gsync_succeeded_str
         else:
             # block until client weave node is ready to service weave events
@@ -307,6 +320,10 @@ class WeaveTime(HappyNode, HappyNetwork, WeaveTest):
 
         self.start_weave_process(self.client_node_id, cmd, self.client_process_tag, sync_on_output=wait_str, strace=self.strace, env=self.plaid_client_env)
 
+        if self.client_run_secs:
+            # let the client keep running, e.g. for late responses to reach it
+            time.sleep(self.client_run_secs)
+
 
     def __stop_client_side(self):
         self.stop_weave_process(self.client_node_id, self.client_process_tag)
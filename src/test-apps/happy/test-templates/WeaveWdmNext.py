@@ -60,6 +60,7 @@ options = { "clients": None,
             "server_inter_event_period": None,
             "wdm_client_liveness_check_period": None,
             "wdm_server_liveness_check_period": None,
+            "wdm_server_notify_window": None,
             "wdm_subless_notify_dest_node": None,
             "case": False,
             "enable_retry": False,
@@ -88,6 +89,7 @@ options = { "clients": None,
             "client_update_num_repeated_mutations": None,
             "client_update_num_traits": None,
             "client_update_discard_on_error": False,
+            "client_update_window": None,
           }
 
 
@@ -182,6 +184,12 @@ class WeaveWdmNext(HappyNode, HappyNetwork, WeaveTest):
 
        Maps to --inter-event-period
        The period used by the event generator in milliseconds
+
+
+     wdm_server_notify_window:
+
+       Maps to --wdm-notify-window on the server node
+       The number of notifies the publisher may have in flight on an established subscription.
     """
 
     def __init__(self, opts=options):
@@ -430,6 +438,9 @@ class WeaveWdmNext(HappyNode, HappyNetwork, WeaveTest):
         if self.wdm_server_liveness_check_period is not None:
             cmd += " --wdm-liveness-check-period " + str(self.wdm_server_liveness_check_period)
 
+        if self.wdm_server_notify_window is not None:
+            cmd += " --wdm-notify-window " + str(self.wdm_server_notify_window)
+
         if self.test_server_case is not None:
             cmd += " --test-case " + str(self.test_server_case)
 
@@ -571,6 +582,9 @@ class WeaveWdmNext(HappyNode, HappyNetwork, WeaveTest):
         if self.client_update_discard_on_error:
             cmd += " --wdm-update-discard-on-error"
 
+        if self.client_update_window:
+            cmd += " --wdm-update-window " + str(self.client_update_window)
+
         custom_env = {}
 
         if False:
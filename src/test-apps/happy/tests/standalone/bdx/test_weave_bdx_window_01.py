@@ -0,0 +1,200 @@
+#!/usr/bin/env python3
+
+
+#
+#    Copyright (c) 2016-2017 Nest Labs, Inc.
+#    All rights reserved.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+#
+
+#
+#    @file
+#       Calls Weave BDX between nodes with several blocks in flight, and checks that
+#       the streaming SHA-256 of the receiver matches the file that was sent.
+#
+
+from __future__ import absolute_import
+from __future__ import print_function
+import filecmp
+import hashlib
+import os
+import random
+import shutil
+import string
+import unittest
+import set_test_path
+
+from happy.Utils import *
+import happy.HappyNodeList
+import WeaveStateLoad
+import WeaveStateUnload
+import WeaveBDX
+import WeaveUtilities
+from six.moves import range
+
+gDirections = ["download", "upload"]
+gWindowSize = 4
+
+class test_weave_bdx_window_01(unittest.TestCase):
+    def setUp(self):
+        self.tap = None
+
+        if os.environ.get("WEAVE_SYSTEM_CONFIG_USE_LWIP") == "1":
+            self.topology_file = os.path.dirname(os.path.realpath(__file__)) + \
+                "/../../../topologies/standalone/three_nodes_on_tap_thread_weave.json"
+            self.tap = "wpan0"
+        else:
+            self.topology_file = os.path.dirname(os.path.realpath(__file__)) + \
+                "/../../../topologies/standalone/three_nodes_on_thread_weave.json"
+
+        self.show_strace = False
+
+        # setting Mesh for thread test
+        options = WeaveStateLoad.option()
+        options["quiet"] = True
+        options["json_file"] = self.topology_file
+
+        setup_network = WeaveStateLoad.WeaveStateLoad(options)
+        ret = setup_network.run()
+
+
+    def tearDown(self):
+        # cleaning up
+        options = WeaveStateUnload.option()
+        options["quiet"] = True
+        options["json_file"] = self.topology_file
+
+        teardown_network = WeaveStateUnload.WeaveStateUnload(options)
+        teardown_network.run()
+
+
+    def test_weave_bdx_window(self):
+        self.test_num = 0
+
+        # Many more blocks than fit in a window
+        file_size = 20000
+
+        for direction in gDirections:
+            self.__weave_bdx(direction, file_size)
+
+
+    def __weave_bdx(self, direction, file_size):
+        test_folder_path = "/tmp/happy_%08d_window_%s_%03d" % (int(os.getpid()), direction, self.test_num)
+        test_folder = self.__create_test_folder(test_folder_path)
+
+        server_temp_path = self.__create_server_temp(test_folder)
+        test_file = self.__create_file(test_folder, file_size)
+        receive_path = self.__create_receive_folder(test_folder)
+
+        options = WeaveBDX.option()
+        options["quiet"] = False
+        options["server"] = "node01"
+        options["client"] = "node02"
+        options["tmp"] = server_temp_path
+        options[direction] = test_file
+        options["receive"] = receive_path
+        options["tap"] = self.tap
+        options["window_size"] = gWindowSize
+        options["test_tag"] = "_window_" + direction
+
+        with open(test_file, 'rb') as f:
+            file_hash = hashlib.sha256(f.read()).hexdigest()
+
+        weave_bdx = WeaveBDX.WeaveBDX(options)
+        ret = weave_bdx.run()
+
+        value = ret.Value()
+        data = ret.Data()
+        copy_success = self.__file_copied(test_file, receive_path)
+        self.__delete_test_folder(test_folder)
+
+        # The receiver hashes the blocks as they are delivered
+        receiver_output = data["client_output"] if direction == "download" else data["server_output"]
+        windowed = ("Window size %d" % gWindowSize) in receiver_output
+        hash_match = ("Received data SHA-256: " + file_hash) in receiver_output
+
+        self.__process_result(value and copy_success and windowed and hash_match, data, direction, file_size)
+        self.test_num += 1
+
+
+    def __process_result(self, value, data, direction, file_size):
+        print("bdx " + direction + " of " + str(file_size) + "B with a window of " + str(gWindowSize) + " blocks ", end=' ')
+
+        if value:
+            print(hgreen("Passed"))
+        else:
+            print(hred("Failed"))
+
+        try:
+            self.assertTrue(value, "File Copied: " + str(value))
+        except AssertionError as e:
+            print(str(e))
+            print("Captured experiment result:")
+
+            print("Client Output: ")
+            for line in data["client_output"].split("\n"):
+                print("\t" + line)
+
+            print("Server Output: ")
+            for line in data["server_output"].split("\n"):
+                print("\t" + line)
+
+        if not value:
+            raise ValueError("Weave BDX Window Failed")
+
+
+    def __file_copied(self, test_file_path, receive_path):
+        file_name = os.path.basename(test_file_path)
+        receive_file_path = receive_path + "/" + file_name
+
+        if not os.path.exists(receive_file_path):
+            print("A copy of a file does not exists")
+            return False
+
+        return filecmp.cmp(test_file_path, receive_file_path)
+
+
+    def __create_test_folder(self, path):
+        os.mkdir(path)
+        return path
+
+
+    def __delete_test_folder(self, path):
+        shutil.rmtree(path)
+
+
+    def __create_server_temp(self, test_folder):
+        path = test_folder + "/server_tmp"
+        os.mkdir(path)
+        return path
+
+
+    def __create_file(self, test_folder, size = 10):
+        path = test_folder + "/test_file.txt"
+        random_content = ''.join(random.SystemRandom().choice(string.ascii_uppercase + string.digits) for _ in range(size))
+
+        with open(path, 'w+') as test_file:
+            test_file.write(random_content)
+
+        return path
+
+
+    def __create_receive_folder(self, test_folder):
+        path = test_folder + "/receive"
+        os.mkdir(path)
+        return path
+
+
+if __name__ == "__main__":
+    WeaveUtilities.run_unittest()
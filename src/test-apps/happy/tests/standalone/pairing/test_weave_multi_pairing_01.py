@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+
+
+#
+#    Copyright (c) 2020 Google LLC.
+#    All rights reserved.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+#
+
+#
+#    @file
+#       Provisions two mock devices concurrently with TestMultiDeviceManager. Both
+#       PASE sessions go through the one security manager, so one of them waits
+#       while the security manager is busy with the other.
+#
+
+from __future__ import absolute_import
+from __future__ import print_function
+import os
+import unittest
+import set_test_path
+
+from happy.Utils import *
+import WeaveStateLoad
+import WeaveStateUnload
+import WeaveMultiPairing
+import WeaveUtilities
+
+
+class test_weave_multi_pairing_01(unittest.TestCase):
+    def setUp(self):
+        self.tap = None
+
+        if "WEAVE_SYSTEM_CONFIG_USE_LWIP" in list(os.environ.keys()) and os.environ["WEAVE_SYSTEM_CONFIG_USE_LWIP"] == "1":
+            self.topology_file = os.path.dirname(os.path.realpath(__file__)) + \
+                "/../../../topologies/standalone/three_nodes_on_tap_thread_weave.json"
+            self.tap = "wpan0"
+        else:
+            self.topology_file = os.path.dirname(os.path.realpath(__file__)) + \
+                "/../../../topologies/standalone/three_nodes_on_thread_weave.json"
+
+        self.show_strace = False
+
+        # setting Mesh for thread test
+        options = WeaveStateLoad.option()
+        options["quiet"] = True
+        options["json_file"] = self.topology_file
+
+        setup_network = WeaveStateLoad.WeaveStateLoad(options)
+        ret = setup_network.run()
+
+
+    def tearDown(self):
+        # cleaning up
+        options = WeaveStateUnload.option()
+        options["quiet"] = True
+        options["json_file"] = self.topology_file
+
+        teardown_network = WeaveStateUnload.WeaveStateUnload(options)
+        teardown_network.run()
+
+
+    def test_weave_multi_pairing(self):
+        # topology has nodes: node01(mobile), node02 and node03(devices)
+        options = WeaveMultiPairing.option()
+        options["quiet"] = False
+        options["mobile"] = "node01"
+        options["devices"] = ["node02", "node03"]
+        options["tap"] = self.tap
+
+        weave_multi_pairing = WeaveMultiPairing.WeaveMultiPairing(options)
+        ret = weave_multi_pairing.run()
+
+        passed = ret.Value()
+        data = ret.Data()
+
+        if not passed:
+            print("Captured experiment result:")
+
+            print("Mobile Output: ")
+            for line in data["mobile_output"].split("\n"):
+               print("\t" + line)
+
+            for device_info, device_output in zip(data["devices_info"], data["devices_output"]):
+                print("Device %s Output: " % (device_info["device"]))
+                for line in device_output.split("\n"):
+                    print("\t" + line)
+
+            raise ValueError("The test failed")
+
+
+if __name__ == "__main__":
+    WeaveUtilities.run_unittest()
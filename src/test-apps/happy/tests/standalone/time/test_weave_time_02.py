@@ -0,0 +1,173 @@
+#!/usr/bin/env python3
+
+
+#
+#    Copyright (c) 2019 Google, LLC.
+#    All rights reserved.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+#
+
+#
+#    @file
+#       WeaveTimeSync test for local sync with several contacts queried concurrently
+#       (WEAVE_CONFIG_TIME_CLIENT_CONCURRENT_SYNC):
+#           - partial responses: one contact answers, the others time out
+#           - no responses: every contact times out
+#           - late responses: a contact answers after its request was aborted
+#
+
+from __future__ import absolute_import
+from __future__ import print_function
+import os
+import unittest
+import set_test_path
+
+from happy.Utils import *
+from happy.HappyNode import HappyNode
+import WeaveStateLoad
+import WeaveStateUnload
+import WeaveTime
+import WeaveUtilities
+
+# Nodes in three_nodes_on_thread_weave.json
+COORDINATOR_CONTACT = "18B4300000000005,fd00:0000:fab1:0006:1ab4:3000:0000:0005"
+SERVER_CONTACT = "18B430000000000A,fd00:0000:fab1:0006:1ab4:3000:0000:000A"
+SERVER_NODE_ID = "18B430000000000A"
+
+# Addresses on the fabric with nothing behind them
+UNREACHABLE_CONTACTS = ["18B43000000000F1,fd00:0000:fab1:0006:1ab4:3000:0000:00F1",
+                        "18B43000000000F2,fd00:0000:fab1:0006:1ab4:3000:0000:00F2",
+                        "18B43000000000F3,fd00:0000:fab1:0006:1ab4:3000:0000:00F3"]
+
+# Delay added to the server's responses, below the unicast timeout (WEAVE_CONFIG_TIME_CLIENT_TIMER_UNICAST_MSEC) but
+# above the client's sync period, so every request to the server is aborted before its response arrives.
+SERVER_DELAY_MS = 1500
+CLIENT_SYNC_PERIOD_MS = 1000
+CLIENT_RUN_SECS = 5
+
+gno_results_str = "Sync Completed with no results"
+
+
+class test_weave_time_02(unittest.TestCase):
+    def setUp(self):
+        self.tap = None
+
+        if "WEAVE_SYSTEM_CONFIG_USE_LWIP" in list(os.environ.keys()) and os.environ["WEAVE_SYSTEM_CONFIG_USE_LWIP"] == "1":
+            self.topology_file = os.path.dirname(os.path.realpath(__file__)) + \
+                "/../../../topologies/standalone/three_nodes_on_tap_thread_weave.json"
+            self.tap = "wpan0"
+        else:
+            self.topology_file = os.path.dirname(os.path.realpath(__file__)) + \
+                "/../../../topologies/standalone/three_nodes_on_thread_weave.json"
+
+        options = WeaveStateLoad.option()
+        options["quiet"] = True
+        options["json_file"] = self.topology_file
+
+        setup_network = WeaveStateLoad.WeaveStateLoad(options)
+        ret = setup_network.run()
+
+        self.link = HappyNode()
+        self.server_delayed = False
+
+
+    def tearDown(self):
+        if self.server_delayed:
+            self.__set_server_delay("del", None)
+
+        options = WeaveStateUnload.option()
+        options["quiet"] = True
+        options["json_file"] = self.topology_file
+
+        teardown_network = WeaveStateUnload.WeaveStateUnload(options)
+        teardown_network.run()
+
+
+    def test_weave_time_partial_responses(self):
+        value, data = self.__run_time_test("_PARTIAL", [SERVER_CONTACT] + UNREACHABLE_CONTACTS[:2])
+        client_output = data["client_output"]
+
+        self.assertTrue(value, "failed to sync with the one contact that responds")
+
+        # Both rounds wait out the unreachable contacts, then go ahead with the server alone
+        self.assertEqual(client_output.count("Concurrent sync round done with 1 reliable response(s)"), 2)
+        self.assertTrue(client_output.count("Concurrent unicast just timed out") >= 4,
+                        "unreachable contacts did not time out in both rounds")
+
+
+    def test_weave_time_no_responses(self):
+        value, data = self.__run_time_test("_NO_RESPONSES", UNREACHABLE_CONTACTS, client_wait_str=gno_results_str)
+        client_output = data["client_output"]
+
+        self.assertTrue(gno_results_str in client_output, "sync did not complete when every contact timed out")
+        self.assertEqual(client_output.count("Concurrent sync round done with 0 reliable response(s)"), 2)
+        self.assertTrue(client_output.count("Concurrent unicast just timed out") >= 2 * len(UNREACHABLE_CONTACTS),
+                        "not every contact timed out in both rounds")
+        self.__check_client_clean(client_output)
+
+
+    def test_weave_time_late_responses(self):
+        self.__set_server_delay("add", SERVER_DELAY_MS)
+        self.server_delayed = True
+
+        value, data = self.__run_time_test("_LATE_RESPONSES", [COORDINATOR_CONTACT, SERVER_CONTACT],
+                                           client_sync_period=CLIENT_SYNC_PERIOD_MS,
+                                           client_wait_str="Stop waiting for node " + SERVER_NODE_ID,
+                                           client_run_secs=CLIENT_RUN_SECS)
+        client_output = data["client_output"]
+
+        # Each sync is aborted while the server's response is still on its way, and that response then arrives on a
+        # closed exchange while the next sync is running
+        self.assertTrue(client_output.count("Stop waiting for node " + SERVER_NODE_ID) >= CLIENT_RUN_SECS - 1,
+                        "requests to the delayed server were not aborted")
+        self.assertFalse("Concurrent sync round done" in client_output,
+                         "a round completed with a response that arrived after its request was aborted")
+        self.__check_client_clean(client_output)
+
+
+    def __check_client_clean(self, client_output):
+        parser_error, leak_detected = WeaveUtilities.scan_for_leaks_and_parser_errors(client_output)
+        self.assertFalse(parser_error, "parser error on the client")
+        self.assertFalse(leak_detected, "resource leak on the client")
+
+
+    def __set_server_delay(self, action, delay_ms):
+        cmd = "tc qdisc %s dev wpan0 root netem" % action
+        if delay_ms is not None:
+            cmd += " delay %dms" % delay_ms
+        self.link.CallAtNode("node03", self.link.runAsRoot(cmd))
+
+
+    def __run_time_test(self, test_tag, contacts, client_sync_period=None, client_wait_str=None, client_run_secs=None):
+        options = WeaveTime.option()
+        options["quiet"] = False
+        options["client"] = "node01"
+        options["coordinator"] = "node02"
+        options["server"] = "node03"
+        options["mode"] = "local"
+        options["tap"] = self.tap
+        options["client_contacts"] = contacts
+        options["client_sync_period"] = client_sync_period
+        options["client_wait_str"] = client_wait_str
+        options["client_run_secs"] = client_run_secs
+        options["test_tag"] = test_tag
+
+        weave_time = WeaveTime.WeaveTime(options)
+        ret = weave_time.run()
+
+        return ret.Value(), ret.Data()
+
+
+if __name__ == "__main__":
+    WeaveUtilities.run_unittest()
@@ -0,0 +1,129 @@
+#!/usr/bin/env python3
+
+
+#
+#    Copyright (c) 2019 Google, LLC.
+#    All rights reserved.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+#
+
+#
+#    @file
+#       Calls Weave WDM one way subscribe between nodes.
+#       L12: Stress One way Subscribe: Publisher Continuous Events over a delayed link, pipelined notifies vs. a single notify in flight
+#
+
+from __future__ import absolute_import
+from __future__ import print_function
+import re
+import unittest
+import set_test_path
+from happy.HappyNode import HappyNode
+from weave_wdm_next_test_base import weave_wdm_next_test_base
+import WeaveUtilities
+
+
+# One-way delay added on the egress of each node, so every notify/status report round trip costs at least twice this.
+LINK_DELAY_MS = 100
+LINK_NODES = ["node01", "node02"]
+LINK_INTERFACE = "wpan0"
+
+
+class test_weave_wdm_next_one_way_subscribe_19(weave_wdm_next_test_base):
+
+    def setUp(self):
+        super(test_weave_wdm_next_one_way_subscribe_19, self).setUp()
+        self.link = HappyNode()
+        for node in LINK_NODES:
+            self.__set_link_delay(node, "add", LINK_DELAY_MS)
+
+    def tearDown(self):
+        for node in LINK_NODES:
+            self.__set_link_delay(node, "del", None)
+        super(test_weave_wdm_next_one_way_subscribe_19, self).tearDown()
+
+    def __set_link_delay(self, node, action, delay_ms):
+        cmd = "tc qdisc %s dev %s root netem" % (action, LINK_INTERFACE)
+        if delay_ms is not None:
+            cmd += " delay %dms" % delay_ms
+        self.link.CallAtNode(node, self.link.runAsRoot(cmd))
+
+    def __run_with_window(self, window):
+        wdm_next_args = {}
+
+        wdm_next_args['wdm_option'] = "one_way_subscribe"
+
+        wdm_next_args['total_client_count'] = 4
+        wdm_next_args['final_client_status'] = 2
+        wdm_next_args['timer_client_period'] = 16000
+        wdm_next_args['test_client_iterations'] = 2
+        wdm_next_args['test_client_delay'] = 35000
+        wdm_next_args['enable_client_flip'] = 0
+
+        wdm_next_args['total_server_count'] = 4
+        wdm_next_args['final_server_status'] = 4
+        wdm_next_args['timer_server_period'] = 15000
+        wdm_next_args['test_server_delay'] = 0
+        wdm_next_args['enable_server_flip'] = 0
+
+        wdm_next_args['server_event_generator'] = 'Security'
+
+        # Events are generated much faster than one round trip over the delayed link, so the publisher always has
+        # something to send and the number of notifies it gets out is bounded by the window.
+        wdm_next_args['server_inter_event_period'] = 20
+        wdm_next_args['wdm_server_notify_window'] = window
+
+        wdm_next_args['client_log_check'] = [('Client\[0\] \[(ALIVE|CONFM)\] TerminateSubscription ', wdm_next_args['test_client_iterations']),
+                                             ('Client\[0\] moving to \[ FREE\] Ref\(0\)', wdm_next_args['test_client_iterations'])]
+        wdm_next_args['server_log_check'] = [('Handler\[0\] \[(ALIVE|CONFM)\] TerminateSubscription ', wdm_next_args['test_client_iterations']),
+                                             ('Handler\[0\] Moving to \[ FREE\] Ref\(0\)', wdm_next_args['test_client_iterations'])]
+        wdm_next_args['test_tag'] = self.__class__.__name__[19:].upper() + "_WINDOW_" + str(window)
+        wdm_next_args['test_case_name'] = ['L12: Stress One way Subscribe: Publisher Continuous Events over a delayed link, notify window %d' % window]
+        super(test_weave_wdm_next_one_way_subscribe_19, self).weave_wdm_next_test_base(wdm_next_args)
+
+        server_output = self.result_data[0]['server_output']
+        notifies = self.weave_wdm.wdm_next_client_event_sequence_process(server_output)
+        in_flight = [int(count) for count in re.findall("SendWindowedNotificationRequest Seq\(\d+\) InWindow\((\d+)/\d+\)", server_output)]
+
+        return notifies['length'], sum(notifies['client_event_list']), in_flight
+
+    def test_weave_wdm_next_one_way_subscribe_19(self):
+        print('test file: ' + self.__class__.__name__)
+        print("weave-wdm-next test L12")
+
+        single_notifies, single_events, single_in_flight = self.__run_with_window(1)
+        windowed_notifies, windowed_events, windowed_in_flight = self.__run_with_window(4)
+
+        print("window 1: %d notifies, %d events" % (single_notifies, single_events))
+        print("window 4: %d notifies, %d events, max in flight %d" %
+              (windowed_notifies, windowed_events, max(windowed_in_flight or [0])))
+
+        # A window of one never takes the windowed path
+        self.assertEqual(single_in_flight, [], "window 1 sent windowed notifies")
+
+        # With four allowed, the publisher must actually have overlapped notifies on the delayed link
+        self.assertTrue(max(windowed_in_flight or [0]) > 1,
+                        "never had more than one notify in flight with window 4")
+        self.assertTrue(max(windowed_in_flight or [0]) <= 4, "exceeded the notify window")
+
+        # Over the same subscription period, pipelining must get more notifies across the delayed link than
+        # stop-and-wait, without delivering fewer events.
+        self.assertTrue(windowed_notifies > single_notifies,
+                        "window 4 sent %d notifies, window 1 sent %d" % (windowed_notifies, single_notifies))
+        self.assertTrue(windowed_events >= single_events,
+                        "window 4 delivered %d events, window 1 delivered %d" % (windowed_events, single_events))
+
+
+if __name__ == "__main__":
+    WeaveUtilities.run_unittest()
@@ -220,6 +220,8 @@ enum
     kToolOpt_TimeSyncServerSubnetId             = 1040, // Specify the subnet ID of the Time Sync Server we should contact with
     kToolOpt_TimeSyncServerNodeAddr             = 1041, // Specify the node address of the Time Sync Server we should contact
     kToolOpt_TimeSyncModeServiceOverTunnel      = 1042, // specify that the Time Client Sync mode is Service (time sync with Service over a tunnel)
+    kToolOpt_TimeSyncLocalContact               = 1043, // Add a node for the Time Sync Client to sync with in Local mode
+    kToolOpt_TimeSyncPeriod                     = 1044, // Specify the period between syncs of the Time Sync Client in Local mode
     kToolOpt_UseServiceDir,
     kToolOpt_SuppressAccessControl,
 
@@ -270,6 +272,8 @@ static OptionDef gToolOptionDefs[] =
     { "ts-server-node-id",          kArgumentRequired,  kToolOpt_TimeSyncServerNodeId },
     { "ts-server-node-addr",        kArgumentRequired,  kToolOpt_TimeSyncServerNodeAddr },
     { "ts-server-subnet-id",        kArgumentRequired,  kToolOpt_TimeSyncServerSubnetId },
+    { "ts-local-contact",           kArgumentRequired,  kToolOpt_TimeSyncLocalContact },
+    { "ts-sync-period",             kArgumentRequired,  kToolOpt_TimeSyncPeriod },
 #endif // WEAVE_CONFIG_TIME
     { }
 };
@@ -339,6 +343,15 @@ static const char *const gToolOptionHelp =
     "  --ts-server-subnet-id\n"
     "       Set subnet id for the time sync client to send request to\n"
     "\n"
+    "  --ts-local-contact <node-id>,<node-addr>\n"
+    "       Add a node for the time sync client to send requests to in local mode, in place\n"
+    "       of the default coordinator. May be given up to WEAVE_CONFIG_TIME_CLIENT_MAX_NUM_CONTACTS\n"
+    "       times.\n"
+    "\n"
+    "  --ts-sync-period <ms>\n"
+    "       Set the period between syncs of the time sync client in local mode. Each sync\n"
+    "       aborts the one before it.\n"
+    "\n"
 #endif // WEAVE_CONFIG_TIME
 #if WEAVE_CONFIG_ENABLE_TUNNELING
     "  --tun-border-gw\n"
@@ -1012,6 +1025,49 @@ bool HandleOption(const char *progName, OptionSet *optSet, int id, const char *n
             return false;
         }
         break;
+    case kToolOpt_TimeSyncLocalContact:
+    {
+        char nodeIdStr[24];
+        const char * nodeAddrStr = strchr(arg, ',');
+        uint64_t nodeId;
+        IPAddress nodeAddr;
+
+        if (nodeAddrStr == NULL || (size_t)(nodeAddrStr - arg) >= sizeof(nodeIdStr))
+        {
+            PrintArgError("%s: Invalid value specified for time sync local contact: %s\n", progName, arg);
+            return false;
+        }
+
+        memcpy(nodeIdStr, arg, nodeAddrStr - arg);
+        nodeIdStr[nodeAddrStr - arg] = '\0';
+        nodeAddrStr++;
+
+        if (!ParseNodeId(nodeIdStr, nodeId) || !IPAddress::FromString(nodeAddrStr, nodeAddr))
+        {
+            PrintArgError("%s: Invalid value specified for time sync local contact: %s\n", progName, arg);
+            return false;
+        }
+
+        if (MockTimeNode.AddLocalContact(nodeId, nodeAddr) != WEAVE_NO_ERROR)
+        {
+            PrintArgError("%s: Too many time sync local contacts: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    }
+    case kToolOpt_TimeSyncPeriod:
+    {
+        uint32_t periodMsec;
+
+        if (!ParseInt(arg, periodMsec) || periodMsec == 0)
+        {
+            PrintArgError("%s: Invalid value specified for time sync period: %s\n", progName, arg);
+            return false;
+        }
+
+        MockTimeNode.SetSyncPeriod(periodMsec);
+        break;
+    }
 #endif // WEAVE_CONFIG_TIME
 #if WEAVE_CONFIG_ENABLE_TUNNELING
     case kToolOpt_TunnelBorderGw:
@@ -70,6 +70,12 @@ static void HandleConnectionComplete(WeaveConnection *con, WEAVE_ERROR conErr);
 static void HandleConnectionClosed(WeaveConnection *con, WEAVE_ERROR conErr);
 static void HandleTransferTimeout(System::Layer* aSystemLayer, void* aAppState, System::Error aError);
 static WEAVE_ERROR PrepareBinding();
+#if WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+static void SetUpCheckpoint(BDXTransfer *aXfer, bool aAmSender);
+static void HandleCheckpoint(BDXTransfer *aXfer, uint64_t anOffset);
+static void HandleCheckpointedXferDone(BDXTransfer *aXfer);
+static void HandleCheckpointedReject(BDXTransfer *aXfer, StatusReport *aReport);
+#endif // WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
 static void HandleBindingEvent(void *const ctx, const Binding::EventType event, const Binding::InEventParam &inParam, Binding::OutEventParam &outParam);
 
 BdxClient BDXClient;
@@ -83,6 +89,8 @@ uint32_t ConnectMaxTry = 3;
 uint64_t StartOffset = BDX_CLIENT_DEFAULT_START_OFFSET;
 uint64_t FileLength = BDX_CLIENT_DEFAULT_FILE_LENGTH;
 uint64_t MaxBlockSize = BDX_CLIENT_DEFAULT_MAX_BLOCK_SIZE;
+uint32_t WindowSize = 1;
+const char *CheckpointFileName = NULL;
 bool Upload = false; // download by default
 bool UseTCP = true;
 const char *DestIPAddrStr = NULL;
@@ -105,6 +113,10 @@ static OptionDef gToolOptionDefs[] =
     { "start-offset",   kArgumentRequired, 's' },
     { "length",         kArgumentRequired, 'l' },
     { "block-size",     kArgumentRequired, 'b' },
+    { "window-size",    kArgumentRequired, 'w' },
+#if WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+    { "checkpoint-file", kArgumentRequired, 'c' },
+#endif // WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
     { "dest-addr",      kArgumentRequired, 'D' },
     { "received-loc",   kArgumentRequired, 'R' },
     { "debug",          kArgumentRequired, 'd' },
@@ -130,6 +142,16 @@ static const char *gToolOptionHelp =
     "  -b, --block-size <num>\n"
     "       Max block size to propose in a transfer. Defaults to 512.\n"
     "\n"
+    "  -w, --window-size <num>\n"
+    "       Max number of outstanding blocks to propose in a transfer. Defaults to 1 (lock-step).\n"
+    "\n"
+#if WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+    "  -c, --checkpoint-file <path>\n"
+    "       Save checkpoints of the transfer to <path>, and resume from the checkpoint\n"
+    "       found there, if any, instead of starting over. The file is removed once the\n"
+    "       transfer completes.\n"
+    "\n"
+#endif // WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
     "  -D, --dest-addr <ip-addr>\n"
     "       Send ReceiveInit requests to a specific address rather than one\n"
     "       derived from the destination node id.  <ip-addr> can be an IPv4 or IPv6 address.\n"
@@ -452,6 +474,11 @@ void StartUDPUpload()
     xfer->mMaxBlockSize = MaxBlockSize;
     xfer->mStartOffset = StartOffset;
     xfer->mLength = FileLength;
+    xfer->mWindowSize = WindowSize;
+
+#if WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+    SetUpCheckpoint(xfer, true);
+#endif // WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
 
     if (err == WEAVE_NO_ERROR)
     {
@@ -518,6 +545,11 @@ void StartUDPDownload()
     xfer->mMaxBlockSize = MaxBlockSize;
     xfer->mStartOffset = StartOffset;
     xfer->mLength = FileLength;
+    xfer->mWindowSize = WindowSize;
+
+#if WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+    SetUpCheckpoint(xfer, false);
+#endif // WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
 
     err = BDXClient.InitBdxReceive(*xfer, true, false, false, NULL);
 
@@ -564,6 +596,18 @@ bool HandleOption(const char *progName, OptionSet *optSet, int id, const char *n
             return false;
         }
         break;
+#if WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+    case 'c':
+        CheckpointFileName = arg;
+        break;
+#endif // WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+    case 'w':
+        if (!ParseInt(arg, WindowSize) || WindowSize < 1 || WindowSize > UINT8_MAX)
+        {
+            PrintArgError("%s: Invalid value specified for window size: %s\n", progName, arg);
+            return false;
+        }
+        break;
     case 'R':
         ReceivedFileLocation = arg;
         SetReceivedFileLocation(ReceivedFileLocation);
@@ -709,6 +753,10 @@ void HandleConnectionComplete(WeaveConnection *con, WEAVE_ERROR conErr)
 
             if (err == WEAVE_NO_ERROR)
             {
+#if WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+                SetUpCheckpoint(xfer, true);
+#endif // WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+
                 // In the test-app, we need to make sure we only send the file name
                 // in the mFileDesignator.
                 WeaveLogDetail(BDX, "%s", refRequestedFileName.theString);
@@ -721,6 +769,8 @@ void HandleConnectionComplete(WeaveConnection *con, WEAVE_ERROR conErr)
                     xfer->mFileDesignator = refFileName;
                 }
 
+                xfer->mWindowSize = WindowSize;
+
                 err = BDXClient.InitBdxSend(*xfer, true, false, false, NULL);
 
                 // Set it back to what it was before so we can grab it when we're sending
@@ -748,6 +798,10 @@ void HandleConnectionComplete(WeaveConnection *con, WEAVE_ERROR conErr)
 
             if (err == WEAVE_NO_ERROR)
             {
+                xfer->mWindowSize = WindowSize;
+#if WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+                SetUpCheckpoint(xfer, false);
+#endif // WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
                 err = BDXClient.InitBdxReceive(*xfer, true, false, false, NULL);
             }
 #endif // WEAVE_CONFIG_BDX_CLIENT_RECEIVE_SUPPORT
@@ -865,6 +919,103 @@ void HandleBindingEvent(void *const ctx, const Binding::EventType event, const B
     }
 }
 
+#if WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+// Have the transfer save checkpoints to CheckpointFileName, and resume it from
+// the checkpoint saved there by an earlier, interrupted transfer, if any.
+void SetUpCheckpoint(BDXTransfer *aXfer, bool aAmSender)
+{
+    WEAVE_ERROR err;
+    uint8_t checkpoint[BDXTransfer::kMaxCheckpointLength];
+    size_t checkpointLen;
+    BDXHandlers handlers;
+    FILE *file;
+
+    appState->mResume = false;
+
+    if (CheckpointFileName == NULL)
+    {
+        return;
+    }
+
+    handlers = aXfer->mHandlers;
+    handlers.mCheckpointHandler = HandleCheckpoint;
+    handlers.mXferDoneHandler = HandleCheckpointedXferDone;
+    handlers.mRejectHandler = HandleCheckpointedReject;
+    aXfer->SetHandlers(handlers);
+
+    file = fopen(CheckpointFileName, "rb");
+    if (file == NULL)
+    {
+        return;
+    }
+
+    checkpointLen = fread(checkpoint, 1, sizeof(checkpoint), file);
+    fclose(file);
+
+    err = aXfer->ResumeFromCheckpoint(checkpoint, static_cast<uint16_t>(checkpointLen), aAmSender);
+    if (err != WEAVE_NO_ERROR)
+    {
+        printf("Ignoring checkpoint in %s: %s\n", CheckpointFileName, ErrorStr(err));
+        return;
+    }
+
+    printf("Resuming transfer at offset %" PRIu64 "\n", aXfer->mStartOffset);
+    appState->mResume = true;
+}
+
+void HandleCheckpoint(BDXTransfer *aXfer, uint64_t anOffset)
+{
+    WEAVE_ERROR err;
+    uint8_t checkpoint[BDXTransfer::kMaxCheckpointLength];
+    uint16_t checkpointLen;
+    FILE *file;
+
+    // The data a checkpoint covers must be stored before the checkpoint is
+    if (appState->mFile != NULL && !aXfer->mAmSender)
+    {
+        fflush(appState->mFile);
+    }
+
+    err = aXfer->EncodeCheckpoint(checkpoint, sizeof(checkpoint), checkpointLen);
+    if (err != WEAVE_NO_ERROR)
+    {
+        printf("EncodeCheckpoint failed: %s\n", ErrorStr(err));
+        return;
+    }
+
+    file = fopen(CheckpointFileName, "wb");
+    if (file == NULL)
+    {
+        printf("Unable to save checkpoint to %s\n", CheckpointFileName);
+        return;
+    }
+
+    fwrite(checkpoint, 1, checkpointLen, file);
+    fclose(file);
+
+    printf("Checkpoint at offset %" PRIu64 "\n", anOffset);
+}
+
+void HandleCheckpointedXferDone(BDXTransfer *aXfer)
+{
+    // Nothing left to resume
+    remove(CheckpointFileName);
+
+    BdxXferDoneHandler(aXfer);
+}
+
+void HandleCheckpointedReject(BDXTransfer *aXfer, StatusReport *aReport)
+{
+    // The peer no longer has the data to resume from, so start over next time
+    if (aReport->mProfileId == kWeaveProfile_BDX && aReport->mStatusCode == kStatus_StartOffsetNotSupported)
+    {
+        remove(CheckpointFileName);
+    }
+
+    BdxRejectHandler(aXfer, aReport);
+}
+#endif // WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+
 // unit tests to cover the codes that functional test failed to cover
 void PreTest()
 {
@@ -96,6 +96,7 @@ void ResetAppStates()
         mAppStatePool[i].mFile = NULL;
         mAppStatePool[i].mDone = true;
         mAppStatePool[i].mBuffer = NULL;
+        mAppStatePool[i].mResume = false;
     }
 }
 
@@ -254,9 +255,11 @@ int DownloadFile(char *aFileDesignator, size_t aFileDesignatorBufferSize)
 /** Example implementation of a SendInitHandler that opens the requested file if possible
  * (in a directory specified by ReceivedFileLocation) and sets up the BDXTransfer
  * by attaching our AppState to store the open file handle and setting the appropriate
- * handlers.
+ * handlers.  A SendInit with a start offset resumes an earlier upload of the file, so
+ * the data received before that offset is kept.
  *
- * @err  #kStatus_ServerBadState        If the file to be written to couldn't be opened
+ * @err  #kStatus_ServerBadState            If the file to be written to couldn't be opened
+ * @err  #kStatus_StartOffsetNotSupported   If less than the start offset was received before
  */
 uint16_t BdxSendInitHandler(BDXTransfer *aXfer, SendInit *aSendInitMsg)
 {
@@ -283,8 +286,26 @@ uint16_t BdxSendInitHandler(BDXTransfer *aXfer, SendInit *aSendInitMsg)
 
     // The client already handles Setting transfer mode, max block size, and start sending
     // We just need to open the file and allocate a buffer for reading blocks
-    mAppState->mFile = fopen(fileDesignator, "w");
-    VerifyOrExit(mAppState->mFile != NULL, err = kStatus_ServerBadState);
+    if (aSendInitMsg->mStartOffset == 0)
+    {
+        mAppState->mFile = fopen(fileDesignator, "w");
+        VerifyOrExit(mAppState->mFile != NULL, err = kStatus_ServerBadState);
+    }
+    else
+    {
+        mAppState->mFile = fopen(fileDesignator, "r+");
+        VerifyOrExit(mAppState->mFile != NULL, err = kStatus_StartOffsetNotSupported);
+
+        fseek(mAppState->mFile, 0, SEEK_END);
+        VerifyOrExit(ftell(mAppState->mFile) >= 0 &&
+                     static_cast<uint64_t>(ftell(mAppState->mFile)) >= aSendInitMsg->mStartOffset,
+                     err = kStatus_StartOffsetNotSupported);
+
+        // Drop whatever was received past the offset the sender resumes from
+        VerifyOrExit(ftruncate(fileno(mAppState->mFile), aSendInitMsg->mStartOffset) == 0 &&
+                     fseek(mAppState->mFile, aSendInitMsg->mStartOffset, SEEK_SET) == 0,
+                     err = kStatus_StartOffsetNotSupported);
+    }
 
     //TODO: shouldn't be using dynamic memory allocation, but how to do that with dynamically negotiated maxBlockSize???
     //perhaps just go ahead and allocate our maximum size since we know the transfer won't go above that?
@@ -296,6 +317,14 @@ uint16_t BdxSendInitHandler(BDXTransfer *aXfer, SendInit *aSendInitMsg)
 
     aXfer->SetHandlers(handlers);
 
+#if WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT
+    // Hash the whole file as it arrives so the test can check what was received
+    if (aSendInitMsg->mStartOffset == 0)
+    {
+        aXfer->StartBlockHash();
+    }
+#endif // WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT
+
 exit:
     return err;
 }
@@ -441,6 +470,11 @@ WEAVE_ERROR BdxSendAcceptHandler(BDXTransfer *aXfer, SendAccept *aSendAcceptMsg)
         exit(-1);
     }
 
+    if (bdxState->mResume)
+    {
+        fseek(bdxState->mFile, aXfer->mStartOffset, SEEK_SET);
+    }
+
     //TODO: shouldn't be using dynamic memory allocation, but how to do that with dynamically negotiated maxBlockSize???
     //perhaps just go ahead and allocate our maximum size since we know the transfer won't go above that?
     bdxState->mBuffer = (uint8_t*)malloc(aSendAcceptMsg->mMaxBlockSize);
@@ -486,13 +520,59 @@ WEAVE_ERROR BdxReceiveAcceptHandler(BDXTransfer *aXfer, ReceiveAccept *aReceiveA
 
     WeaveLogDetail(BDX, "File being saved to: %s", fileDesignator);
 
-    bdxState->mFile = fopen(fileDesignator, "w");
+    // When resuming, keep what an earlier transfer stored before the start offset
+    bdxState->mFile = fopen(fileDesignator, bdxState->mResume ? "r+" : "w");
     if (!bdxState->mFile)
     {
         WeaveLogDetail(BDX, "Error opening file %s\n", fileDesignator);
         exit(-1);
     }
 
+#if WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT
+    // Hash the whole file as it arrives so the test can check what was received
+    if (!bdxState->mResume)
+    {
+        aXfer->StartBlockHash();
+    }
+#endif // WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT
+
+    if (bdxState->mResume)
+    {
+#if WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT && WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+        // Bring the hash restarted by the checkpoint back up to date with what the earlier transfer stored
+        if (aXfer->mHashBlocks && aXfer->mBlockHashPendingLength > 0)
+        {
+            uint8_t buf[512];
+            size_t len;
+
+            if (fseek(bdxState->mFile, aXfer->mStartOffset - aXfer->mBlockHashPendingLength, SEEK_SET) != 0)
+            {
+                WeaveLogDetail(BDX, "Error resuming file %s\n", fileDesignator);
+                exit(-1);
+            }
+
+            while (aXfer->mBlockHashPendingLength > 0)
+            {
+                len = (aXfer->mBlockHashPendingLength < sizeof(buf)) ? aXfer->mBlockHashPendingLength : sizeof(buf);
+
+                if (fread(buf, 1, len, bdxState->mFile) != len ||
+                    aXfer->AddBlockHashData(buf, static_cast<uint32_t>(len)) != WEAVE_NO_ERROR)
+                {
+                    WeaveLogDetail(BDX, "Error re-hashing file %s\n", fileDesignator);
+                    exit(-1);
+                }
+            }
+        }
+#endif // WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT && WEAVE_CONFIG_BDX_CHECKPOINT_SUPPORT
+
+        if (ftruncate(fileno(bdxState->mFile), aXfer->mStartOffset) != 0 ||
+            fseek(bdxState->mFile, aXfer->mStartOffset, SEEK_SET) != 0)
+        {
+            WeaveLogDetail(BDX, "Error resuming file %s\n", fileDesignator);
+            exit(-1);
+        }
+    }
+
     return err;
 }
 
@@ -591,8 +671,23 @@ void BdxXferErrorHandler(BDXTransfer *aXfer, StatusReport *aXferError)
  */
 void BdxXferDoneHandler(BDXTransfer *aXfer)
 {
-    WeaveLogDetail(BDX, "Transfer complete!");
+    WeaveLogDetail(BDX, "Transfer complete! Window size %u", aXfer->mWindowSize);
     BdxAppState *appState = (BdxAppState *)(aXfer->mAppState);
+
+#if WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT
+    uint8_t hash[Platform::Security::SHA256::kHashLength];
+    char hashStr[2 * sizeof(hash) + 1];
+
+    if (aXfer->FinishBlockHash(hash) == WEAVE_NO_ERROR)
+    {
+        for (size_t i = 0; i < sizeof(hash); i++)
+        {
+            snprintf(hashStr + 2 * i, 3, "%02x", hash[i]);
+        }
+
+        WeaveLogProgress(BDX, "Received data SHA-256: %s", hashStr);
+    }
+#endif // WEAVE_CONFIG_BDX_STREAMING_HASH_SUPPORT
     if (appState->mFile)
     {
         if (fclose(appState->mFile))
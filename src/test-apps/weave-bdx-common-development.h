@@ -47,6 +47,7 @@ struct BdxAppState
     FILE *mFile;
     bool mDone;
     uint8_t *mBuffer; // buffer to store read blocks
+    bool mResume; // true if the transfer picks up where an interrupted one left off
 };
 
 // Returns a reference to a static BdxAppState so that handlers can grab one
@@ -0,0 +1,1070 @@
+/*
+ *
+ *    Copyright (c) 2018 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a command line tool, weave-bench, that runs
+ *      microbenchmarks of the hot paths of the Weave stack and reports
+ *      the results as JSON, one object per line, for trend tracking.
+ *
+ */
+
+#ifndef __STDC_LIMIT_MACROS
+#define __STDC_LIMIT_MACROS
+#endif
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Note that the choice of namespace alias must be made up front for each and every compile unit
+// This is because many include paths could set the default alias to unintended target.
+#include <Weave/Profiles/data-management/Current/WdmManagedNamespace.h>
+
+#include "ToolCommon.h"
+#include <Weave/Core/WeaveCore.h>
+#include <Weave/Core/WeaveMessageLayer.h>
+#include <Weave/Core/WeaveTLV.h>
+#include <Weave/Profiles/data-management/DataManagement.h>
+#include <Weave/Profiles/security/WeaveCert.h>
+#include <Weave/Support/Base64.h>
+#include <Weave/Support/CodeUtils.h>
+#include <Weave/Support/ErrorStr.h>
+#include <Weave/Support/crypto/CTRMode.h>
+
+#include "TestWeaveCertData.h"
+
+using namespace nl::Weave::TLV;
+using namespace nl::Weave::Profiles::DataManagement;
+
+#define TOOL_NAME "weave-bench"
+
+static bool HandleOption(const char * progName, OptionSet * optSet, int id, const char * name, const char * arg);
+
+namespace nl {
+namespace Weave {
+
+class NL_DLL_EXPORT WeaveMessageLayerTestObject
+{
+public:
+    static WEAVE_ERROR DecodeMessage(WeaveMessageLayer & msgLayer, PacketBuffer * msgBuf, uint64_t sourceNodeId,
+                                     WeaveMessageInfo * msgInfo, uint8_t ** rPayload, uint16_t * rPayloadLen)
+    {
+        return msgLayer.DecodeMessage(msgBuf, sourceNodeId, NULL, msgInfo, rPayload, rPayloadLen);
+    }
+};
+
+namespace Profiles {
+namespace WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current) {
+namespace Platform {
+// The benchmarks are single threaded, so the dummy critical section is sufficient.
+void CriticalSectionEnter()
+{
+    return;
+}
+
+void CriticalSectionExit()
+{
+    return;
+}
+} // namespace Platform
+} // namespace WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current)
+} // namespace Profiles
+} // namespace Weave
+} // namespace nl
+
+nl::Weave::Profiles::DataManagement::SubscriptionEngine * nl::Weave::Profiles::DataManagement::SubscriptionEngine::GetInstance()
+{
+    static nl::Weave::Profiles::DataManagement::SubscriptionEngine gWdmSubscriptionEngine;
+
+    return &gWdmSubscriptionEngine;
+}
+
+typedef WEAVE_ERROR (*BenchmarkFunct)(uint32_t aIterations, uint64_t & aElapsedNS);
+
+struct Benchmark
+{
+    const char * Name;
+    BenchmarkFunct Run;
+};
+
+enum
+{
+    kMaxRepeats = 100,
+};
+
+static uint32_t gIterations           = 10000;
+static uint32_t gRepeats              = 5;
+static const char * gBenchmarkFilter  = NULL;
+static const char * gOutputFileName   = NULL;
+static bool gListBenchmarks           = false;
+
+static WeaveFabricState sFabricState;
+static WeaveMessageLayer sMessageLayer;
+static WeaveExchangeManager sExchangeMgr;
+
+static const uint64_t kLocalNodeId    = 0x18B4300000000001ULL;
+static const uint64_t kPeerNodeId     = 0x18B4300000000002ULL;
+static const uint16_t kTLVBufferSize  = 1024;
+
+// Fixed inputs, so that results are comparable from run to run.
+static const uint8_t sMsgEncKey_DataKey[] =
+{
+    0xF7, 0xE7, 0xD7, 0xC7, 0xB7, 0xA7, 0x97, 0x87, 0x07, 0x17, 0x27, 0x37, 0x47, 0x57, 0x67, 0x77
+};
+
+static const uint8_t sMsgEncKey_IntegrityKey[] =
+{
+    0xFD, 0xED, 0xDD, 0xCD, 0xBD, 0xAD, 0x9D, 0x8D, 0x0D, 0x1D, 0x2D, 0x3D, 0x4D, 0x5D, 0x6D, 0x7D,
+    0x82, 0x52, 0x78, 0x2D
+};
+
+static uint8_t sMsgPayload[256];
+
+// Size of a typical BDX block.
+static const uint16_t kBulkDataBlockSize = 1024;
+static uint8_t sBulkData[kBulkDataBlockSize];
+
+static uint64_t NowNS(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+// ===== TLV
+
+static WEAVE_ERROR EncodeSampleTLV(TLVWriter & aWriter)
+{
+    WEAVE_ERROR err;
+    TLVType outerContainer;
+    TLVType innerContainer;
+
+    err = aWriter.StartContainer(AnonymousTag, kTLVType_Structure, outerContainer);
+    SuccessOrExit(err);
+
+    err = aWriter.Put(ContextTag(1), static_cast<uint32_t>(0x12345678));
+    SuccessOrExit(err);
+
+    err = aWriter.Put(ContextTag(2), static_cast<int64_t>(-1234567890123LL));
+    SuccessOrExit(err);
+
+    err = aWriter.PutBoolean(ContextTag(3), true);
+    SuccessOrExit(err);
+
+    err = aWriter.PutString(ContextTag(4), "weave-bench sample string");
+    SuccessOrExit(err);
+
+    err = aWriter.PutBytes(ContextTag(5), sMsgPayload, 32);
+    SuccessOrExit(err);
+
+    err = aWriter.StartContainer(ContextTag(6), kTLVType_Array, innerContainer);
+    SuccessOrExit(err);
+
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        err = aWriter.Put(AnonymousTag, i * 1000);
+        SuccessOrExit(err);
+    }
+
+    err = aWriter.EndContainer(innerContainer);
+    SuccessOrExit(err);
+
+    err = aWriter.StartContainer(ProfileTag(0x235A0001, 7), kTLVType_Structure, innerContainer);
+    SuccessOrExit(err);
+
+    err = aWriter.Put(ContextTag(1), static_cast<uint8_t>(7));
+    SuccessOrExit(err);
+
+    err = aWriter.PutNull(ContextTag(2));
+    SuccessOrExit(err);
+
+    err = aWriter.EndContainer(innerContainer);
+    SuccessOrExit(err);
+
+    err = aWriter.EndContainer(outerContainer);
+    SuccessOrExit(err);
+
+    err = aWriter.Finalize();
+
+exit:
+    return err;
+}
+
+static WEAVE_ERROR ReadAllTLV(TLVReader & aReader)
+{
+    WEAVE_ERROR err;
+
+    while ((err = aReader.Next()) == WEAVE_NO_ERROR)
+    {
+        switch (aReader.GetType())
+        {
+        case kTLVType_Structure:
+        case kTLVType_Array:
+        case kTLVType_Path:
+        {
+            TLVType containerType;
+
+            err = aReader.EnterContainer(containerType);
+            SuccessOrExit(err);
+
+            err = ReadAllTLV(aReader);
+            SuccessOrExit(err);
+
+            err = aReader.ExitContainer(containerType);
+            SuccessOrExit(err);
+            break;
+        }
+
+        case kTLVType_SignedInteger:
+        {
+            int64_t value;
+            err = aReader.Get(value);
+            SuccessOrExit(err);
+            break;
+        }
+
+        case kTLVType_UnsignedInteger:
+        {
+            uint64_t value;
+            err = aReader.Get(value);
+            SuccessOrExit(err);
+            break;
+        }
+
+        case kTLVType_Boolean:
+        {
+            bool value;
+            err = aReader.Get(value);
+            SuccessOrExit(err);
+            break;
+        }
+
+        case kTLVType_UTF8String:
+        case kTLVType_ByteString:
+        {
+            const uint8_t * data;
+            err = aReader.GetDataPtr(data);
+            SuccessOrExit(err);
+            break;
+        }
+
+        default:
+            break;
+        }
+    }
+
+    if (err == WEAVE_END_OF_TLV)
+    {
+        err = WEAVE_NO_ERROR;
+    }
+
+exit:
+    return err;
+}
+
+static WEAVE_ERROR BenchTLVWriter(uint32_t aIterations, uint64_t & aElapsedNS)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    uint8_t buf[kTLVBufferSize];
+    TLVWriter writer;
+    uint64_t start = NowNS();
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        writer.Init(buf, sizeof(buf));
+
+        err = EncodeSampleTLV(writer);
+        SuccessOrExit(err);
+    }
+
+    aElapsedNS = NowNS() - start;
+
+exit:
+    return err;
+}
+
+static WEAVE_ERROR BenchTLVReader(uint32_t aIterations, uint64_t & aElapsedNS)
+{
+    WEAVE_ERROR err;
+    uint8_t buf[kTLVBufferSize];
+    TLVWriter writer;
+    TLVReader reader;
+    uint64_t start;
+
+    writer.Init(buf, sizeof(buf));
+
+    err = EncodeSampleTLV(writer);
+    SuccessOrExit(err);
+
+    start = NowNS();
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        reader.Init(buf, writer.GetLengthWritten());
+
+        err = ReadAllTLV(reader);
+        SuccessOrExit(err);
+    }
+
+    aElapsedNS = NowNS() - start;
+
+exit:
+    return err;
+}
+
+// ===== Message encryption
+
+static WEAVE_ERROR InitMessageSecurity(void)
+{
+    WEAVE_ERROR err;
+    WeaveEncryptionKey msgEncKey;
+    WeaveSessionKey * sessionKey;
+
+    memcpy(msgEncKey.AES128CTRSHA1.DataKey, sMsgEncKey_DataKey, sizeof(sMsgEncKey_DataKey));
+    memcpy(msgEncKey.AES128CTRSHA1.IntegrityKey, sMsgEncKey_IntegrityKey, sizeof(sMsgEncKey_IntegrityKey));
+
+    // The same key is installed for the peer, which the messages are encoded for, and for the
+    // local node, which the messages appear to be from when they are decoded.
+    err = sFabricState.AllocSessionKey(kPeerNodeId, sTestDefaultSessionKeyId, NULL, sessionKey);
+    SuccessOrExit(err);
+
+    sFabricState.SetSessionKey(sessionKey, kWeaveEncryptionType_AES128CTRSHA1, kWeaveAuthMode_CASE_Device, &msgEncKey);
+
+    err = sFabricState.AllocSessionKey(kLocalNodeId, sTestDefaultSessionKeyId, NULL, sessionKey);
+    SuccessOrExit(err);
+
+    sFabricState.SetSessionKey(sessionKey, kWeaveEncryptionType_AES128CTRSHA1, kWeaveAuthMode_CASE_Device, &msgEncKey);
+
+    sMessageLayer.FabricState = &sFabricState;
+
+exit:
+    return err;
+}
+
+static WEAVE_ERROR EncodeTestMessage(uint32_t aMessageId, PacketBuffer *& aMsgBuf, uint64_t & aElapsedNS)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    WeaveMessageInfo msgInfo;
+    uint64_t start;
+
+    aMsgBuf = PacketBuffer::New();
+    VerifyOrExit(aMsgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+    memcpy(aMsgBuf->Start(), sMsgPayload, sizeof(sMsgPayload));
+    aMsgBuf->SetDataLength(sizeof(sMsgPayload));
+
+    msgInfo.Clear();
+    msgInfo.SourceNodeId   = kLocalNodeId;
+    msgInfo.DestNodeId     = kPeerNodeId;
+    msgInfo.MessageId      = aMessageId;
+    msgInfo.KeyId          = sTestDefaultSessionKeyId;
+    msgInfo.Flags          = kWeaveMessageFlag_DestNodeId | kWeaveMessageFlag_SourceNodeId | kWeaveMessageFlag_ReuseMessageId;
+    msgInfo.MessageVersion = kWeaveMessageVersion_V2;
+    msgInfo.EncryptionType = kWeaveEncryptionType_AES128CTRSHA1;
+
+    start = NowNS();
+    err   = sMessageLayer.EncodeMessage(&msgInfo, aMsgBuf, NULL, UINT16_MAX, 0);
+    aElapsedNS += NowNS() - start;
+
+exit:
+    return err;
+}
+
+static WEAVE_ERROR BenchMessageEncode(uint32_t aIterations, uint64_t & aElapsedNS)
+{
+    WEAVE_ERROR err      = WEAVE_NO_ERROR;
+    PacketBuffer * msgBuf = NULL;
+
+    aElapsedNS = 0;
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        err = EncodeTestMessage(i + 1, msgBuf, aElapsedNS);
+        SuccessOrExit(err);
+
+        PacketBuffer::Free(msgBuf);
+        msgBuf = NULL;
+    }
+
+exit:
+    if (msgBuf != NULL)
+    {
+        PacketBuffer::Free(msgBuf);
+    }
+
+    return err;
+}
+
+static WEAVE_ERROR BenchMessageDecode(uint32_t aIterations, uint64_t & aElapsedNS)
+{
+    WEAVE_ERROR err      = WEAVE_NO_ERROR;
+    PacketBuffer * msgBuf = NULL;
+    uint64_t encodeNS    = 0;
+
+    aElapsedNS = 0;
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        WeaveMessageInfo msgInfo;
+        uint8_t * payload;
+        uint16_t payloadLen;
+        uint64_t start;
+
+        err = EncodeTestMessage(i + 1, msgBuf, encodeNS);
+        SuccessOrExit(err);
+
+        msgInfo.Clear();
+
+        start = NowNS();
+        err   = WeaveMessageLayerTestObject::DecodeMessage(sMessageLayer, msgBuf, kLocalNodeId, &msgInfo, &payload, &payloadLen);
+        aElapsedNS += NowNS() - start;
+        SuccessOrExit(err);
+
+        VerifyOrExit(payloadLen == sizeof(sMsgPayload), err = WEAVE_ERROR_INVALID_MESSAGE_LENGTH);
+
+        PacketBuffer::Free(msgBuf);
+        msgBuf = NULL;
+    }
+
+exit:
+    if (msgBuf != NULL)
+    {
+        PacketBuffer::Free(msgBuf);
+    }
+
+    return err;
+}
+
+static WEAVE_ERROR BenchAES128CTR(uint16_t aDataLen, uint32_t aIterations, uint64_t & aElapsedNS)
+{
+    nl::Weave::Crypto::AES128CTRMode aes128CTR;
+    uint64_t start;
+
+    aes128CTR.SetKey(sMsgEncKey_DataKey);
+
+    start = NowNS();
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        aes128CTR.SetWeaveMessageCounter(kLocalNodeId, i);
+        aes128CTR.EncryptData(sBulkData, aDataLen, sBulkData);
+    }
+
+    aElapsedNS = NowNS() - start;
+
+    aes128CTR.Reset();
+
+    return WEAVE_NO_ERROR;
+}
+
+static WEAVE_ERROR BenchAES128CTRMessage(uint32_t aIterations, uint64_t & aElapsedNS)
+{
+    return BenchAES128CTR(sizeof(sMsgPayload), aIterations, aElapsedNS);
+}
+
+static WEAVE_ERROR BenchAES128CTRBDXBlock(uint32_t aIterations, uint64_t & aElapsedNS)
+{
+    return BenchAES128CTR(kBulkDataBlockSize, aIterations, aElapsedNS);
+}
+
+static WEAVE_ERROR BenchSecureRandom(uint32_t aIterations, uint64_t & aElapsedNS)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    uint64_t randValue;
+    uint64_t start = NowNS();
+
+    // Requests the size of a message or exchange id, as made on the message path.
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        err = nl::Weave::Platform::Security::GetSecureRandomData(reinterpret_cast<uint8_t *>(&randValue), sizeof(randValue));
+        SuccessOrExit(err);
+    }
+
+    aElapsedNS = NowNS() - start;
+
+exit:
+    return err;
+}
+
+// ===== Base-64
+
+static char sBase64Data[BASE64_ENCODED_LEN(kBulkDataBlockSize)];
+
+static WEAVE_ERROR BenchBase64Encode(uint32_t aIterations, uint64_t & aElapsedNS)
+{
+    uint64_t start = NowNS();
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        nl::Base64Encode(sBulkData, kBulkDataBlockSize, sBase64Data);
+    }
+
+    aElapsedNS = NowNS() - start;
+
+    return WEAVE_NO_ERROR;
+}
+
+static WEAVE_ERROR BenchBase64Decode(uint32_t aIterations, uint64_t & aElapsedNS)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    uint16_t encodedLen = nl::Base64Encode(sBulkData, kBulkDataBlockSize, sBase64Data);
+    uint64_t start = NowNS();
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        VerifyOrExit(nl::Base64Decode(sBase64Data, encodedLen, sBulkData) == kBulkDataBlockSize, err = WEAVE_ERROR_INVALID_ARGUMENT);
+    }
+
+    aElapsedNS = NowNS() - start;
+
+exit:
+    return err;
+}
+
+// ===== Certificates
+
+// Converts each of the test certificates, once per iteration, in the given direction.
+static WEAVE_ERROR BenchCertConversion(bool aFromDER, uint32_t aIterations, uint64_t & aElapsedNS)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    uint8_t outCertBuf[nl::TestCerts::kTestCertBufSize];
+    uint32_t outCertLen;
+    uint64_t start = NowNS();
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        for (size_t j = 0; j < nl::TestCerts::gNumTestCerts; j++)
+        {
+            const uint8_t * inCert;
+            size_t inCertLen;
+
+            if (aFromDER)
+            {
+                nl::TestCerts::GetTestCert(nl::TestCerts::gTestCerts[j] | nl::TestCerts::kTestCertLoadFlag_DERForm, inCert, inCertLen);
+                err = nl::Weave::Profiles::Security::ConvertX509CertToWeaveCert(inCert, inCertLen, outCertBuf, sizeof(outCertBuf), outCertLen);
+            }
+            else
+            {
+                nl::TestCerts::GetTestCert(nl::TestCerts::gTestCerts[j], inCert, inCertLen);
+                err = nl::Weave::Profiles::Security::ConvertWeaveCertToX509Cert(inCert, inCertLen, outCertBuf, sizeof(outCertBuf), outCertLen);
+            }
+            SuccessOrExit(err);
+        }
+    }
+
+    aElapsedNS = NowNS() - start;
+
+exit:
+    return err;
+}
+
+static WEAVE_ERROR BenchX509ToWeaveCert(uint32_t aIterations, uint64_t & aElapsedNS)
+{
+    return BenchCertConversion(true, aIterations, aElapsedNS);
+}
+
+static WEAVE_ERROR BenchWeaveToX509Cert(uint32_t aIterations, uint64_t & aElapsedNS)
+{
+    return BenchCertConversion(false, aIterations, aElapsedNS);
+}
+
+// ===== System Layer
+
+static WEAVE_ERROR BenchPacketBufferAllocFree(uint32_t aIterations, uint64_t & aElapsedNS)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    uint64_t start  = NowNS();
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        PacketBuffer * buf = PacketBuffer::New();
+        VerifyOrExit(buf != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+        PacketBuffer::Free(buf);
+    }
+
+    aElapsedNS = NowNS() - start;
+
+exit:
+    return err;
+}
+
+static void HandleBenchTimer(System::Layer * aLayer, void * aAppState, System::Error aError)
+{
+}
+
+static WEAVE_ERROR BenchTimerStartCancel(uint32_t aIterations, uint64_t & aElapsedNS)
+{
+    // A few timers stay armed throughout, as they would in a running stack.
+    enum { kNumBackgroundTimers = 8 };
+    static uint8_t sTimerStates[kNumBackgroundTimers + 1];
+
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    uint64_t start;
+
+    for (int i = 0; i < kNumBackgroundTimers; i++)
+    {
+        err = SystemLayer.StartTimer(3600000, HandleBenchTimer, &sTimerStates[i]);
+        SuccessOrExit(err);
+    }
+
+    start = NowNS();
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        err = SystemLayer.StartTimer(60000, HandleBenchTimer, &sTimerStates[kNumBackgroundTimers]);
+        SuccessOrExit(err);
+
+        SystemLayer.CancelTimer(HandleBenchTimer, &sTimerStates[kNumBackgroundTimers]);
+    }
+
+    aElapsedNS = NowNS() - start;
+
+exit:
+    for (int i = 0; i < kNumBackgroundTimers; i++)
+    {
+        SystemLayer.CancelTimer(HandleBenchTimer, &sTimerStates[i]);
+    }
+
+    return err;
+}
+
+// ===== WDM
+
+static WEAVE_ERROR BuildNotification(TLVWriter & aWriter)
+{
+    enum { kNumDataElements = 8 };
+
+    WEAVE_ERROR err;
+    TLVType notificationContainer;
+    TLVType dataContainer;
+    DataList::Builder dataList;
+
+    err = aWriter.StartContainer(AnonymousTag, kTLVType_Structure, notificationContainer);
+    SuccessOrExit(err);
+
+    err = aWriter.Put(ContextTag(NotificationRequest::kCsTag_SubscriptionId), static_cast<uint64_t>(0xB6C4B7BE2C4B859AULL));
+    SuccessOrExit(err);
+
+    err = dataList.Init(&aWriter, NotificationRequest::kCsTag_DataList);
+    SuccessOrExit(err);
+
+    for (uint32_t i = 0; i < kNumDataElements; i++)
+    {
+        DataElement::Builder & dataElement = dataList.CreateDataElementBuilder();
+
+        dataElement.CreatePathBuilder()
+            .ResourceID(kLocalNodeId)
+            .ProfileID(0x235A0000 + i)
+            .InstanceID(i)
+            .EndOfPath();
+        dataElement.Version(0x1000 + i);
+        err = dataElement.GetError();
+        SuccessOrExit(err);
+
+        err = aWriter.StartContainer(ContextTag(DataElement::kCsTag_Data), kTLVType_Structure, dataContainer);
+        SuccessOrExit(err);
+
+        err = aWriter.Put(ContextTag(1), i);
+        SuccessOrExit(err);
+
+        err = aWriter.PutBoolean(ContextTag(2), (i & 1) != 0);
+        SuccessOrExit(err);
+
+        err = aWriter.PutString(ContextTag(3), "trait property");
+        SuccessOrExit(err);
+
+        err = aWriter.EndContainer(dataContainer);
+        SuccessOrExit(err);
+
+        dataElement.EndOfDataElement();
+        err = dataElement.GetError();
+        SuccessOrExit(err);
+    }
+
+    dataList.EndOfDataList();
+    err = dataList.GetError();
+    SuccessOrExit(err);
+
+    err = aWriter.EndContainer(notificationContainer);
+    SuccessOrExit(err);
+
+    err = aWriter.Finalize();
+
+exit:
+    return err;
+}
+
+static WEAVE_ERROR BenchWdmNotifyBuild(uint32_t aIterations, uint64_t & aElapsedNS)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    PacketBuffer * buf = PacketBuffer::New();
+    TLVWriter writer;
+    uint64_t start;
+
+    VerifyOrExit(buf != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+    start = NowNS();
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        buf->SetDataLength(0);
+        writer.Init(buf);
+
+        err = BuildNotification(writer);
+        SuccessOrExit(err);
+    }
+
+    aElapsedNS = NowNS() - start;
+
+exit:
+    if (buf != NULL)
+    {
+        PacketBuffer::Free(buf);
+    }
+
+    return err;
+}
+
+// ===== Event logging
+
+static uint64_t sEventBuffer[2][512];
+
+static void InitEventLogging(void)
+{
+    LogStorageResources logStorageResources[] = {
+        { static_cast<void *>(&sEventBuffer[0][0]), sizeof(sEventBuffer[0]), NULL, 0, NULL, ProductionCritical },
+        { static_cast<void *>(&sEventBuffer[1][0]), sizeof(sEventBuffer[1]), NULL, 0, NULL, Production },
+    };
+
+    // The event logging subsystem only needs an exchange manager with a fabric state holding the node id.
+    sExchangeMgr.FabricState = &sFabricState;
+    sExchangeMgr.State       = WeaveExchangeManager::kState_Initialized;
+
+    LoggingManagement::CreateLoggingManagement(&sExchangeMgr, sizeof(logStorageResources) / sizeof(logStorageResources[0]),
+                                               logStorageResources);
+    LoggingConfiguration::GetInstance().mGlobalImportance = Production;
+}
+
+static WEAVE_ERROR WriteBenchEvent(TLVWriter & ioWriter, uint8_t inDataTag, void * appData)
+{
+    WEAVE_ERROR err;
+    TLVType containerType;
+    uint32_t * counter = static_cast<uint32_t *>(appData);
+
+    err = ioWriter.StartContainer(ContextTag(inDataTag), kTLVType_Structure, containerType);
+    SuccessOrExit(err);
+
+    err = ioWriter.Put(ContextTag(1), (*counter)++);
+    SuccessOrExit(err);
+
+    err = ioWriter.PutBoolean(ContextTag(2), true);
+    SuccessOrExit(err);
+
+    err = ioWriter.PutString(ContextTag(3), "state change");
+    SuccessOrExit(err);
+
+    err = ioWriter.EndContainer(containerType);
+
+exit:
+    return err;
+}
+
+static const EventSchema sBenchEventSchema = { 0x235A0001, 1, Production, 1, 1 };
+
+static WEAVE_ERROR BenchLogEvent(uint32_t aIterations, uint64_t & aElapsedNS)
+{
+    WEAVE_ERROR err  = WEAVE_NO_ERROR;
+    uint32_t counter = 0;
+    uint64_t start   = NowNS();
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        VerifyOrExit(LogEvent(sBenchEventSchema, WriteBenchEvent, &counter) != 0, err = WEAVE_ERROR_NO_MEMORY);
+    }
+
+    aElapsedNS = NowNS() - start;
+
+exit:
+    return err;
+}
+
+static WEAVE_ERROR BenchFetchEventsSince(uint32_t aIterations, uint64_t & aElapsedNS)
+{
+    WEAVE_ERROR err  = WEAVE_NO_ERROR;
+    uint32_t counter = 0;
+    uint8_t buf[sizeof(sEventBuffer[1])];
+    TLVWriter writer;
+    uint64_t start;
+
+    // Fill the log, so that every fetch returns the same, full set of events.
+    for (size_t i = 0; i < sizeof(sEventBuffer[1]) / 16; i++)
+    {
+        LogEvent(sBenchEventSchema, WriteBenchEvent, &counter);
+    }
+
+    start = NowNS();
+
+    for (uint32_t i = 0; i < aIterations; i++)
+    {
+        event_id_t eventId = 0;
+
+        writer.Init(buf, sizeof(buf));
+
+        err = LoggingManagement::GetInstance().FetchEventsSince(writer, Production, eventId);
+        if ((err == WEAVE_END_OF_TLV) || (err == WEAVE_ERROR_TLV_UNDERRUN))
+        {
+            err = WEAVE_NO_ERROR;
+        }
+        SuccessOrExit(err);
+    }
+
+    aElapsedNS = NowNS() - start;
+
+exit:
+    return err;
+}
+
+static const Benchmark sBenchmarks[] =
+{
+    { "TLVWriter",              BenchTLVWriter },
+    { "TLVReader",              BenchTLVReader },
+    { "MessageEncode",          BenchMessageEncode },
+    { "MessageDecode",          BenchMessageDecode },
+    { "AES128CTRMessage",       BenchAES128CTRMessage },
+    { "AES128CTRBDXBlock",      BenchAES128CTRBDXBlock },
+    { "SecureRandom",           BenchSecureRandom },
+    { "Base64Encode",           BenchBase64Encode },
+    { "Base64Decode",           BenchBase64Decode },
+    { "X509ToWeaveCert",        BenchX509ToWeaveCert },
+    { "WeaveToX509Cert",        BenchWeaveToX509Cert },
+    { "PacketBufferAllocFree",  BenchPacketBufferAllocFree },
+    { "TimerStartCancel",       BenchTimerStartCancel },
+    { "WdmNotifyBuild",         BenchWdmNotifyBuild },
+    { "LogEvent",               BenchLogEvent },
+    { "FetchEventsSince",       BenchFetchEventsSince },
+};
+
+static const size_t kNumBenchmarks = sizeof(sBenchmarks) / sizeof(sBenchmarks[0]);
+
+static void SortResults(double * aResults, uint32_t aCount)
+{
+    for (uint32_t i = 1; i < aCount; i++)
+    {
+        double value = aResults[i];
+        uint32_t j   = i;
+
+        for (; j > 0 && aResults[j - 1] > value; j--)
+        {
+            aResults[j] = aResults[j - 1];
+        }
+
+        aResults[j] = value;
+    }
+}
+
+static WEAVE_ERROR RunBenchmark(const Benchmark & aBenchmark, FILE * aOutput)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    double nsPerOp[kMaxRepeats];
+    uint64_t elapsedNS;
+    double median;
+
+    // Warm up the caches and the pools with a run whose result is discarded.
+    err = aBenchmark.Run(gIterations, elapsedNS);
+    SuccessOrExit(err);
+
+    for (uint32_t i = 0; i < gRepeats; i++)
+    {
+        err = aBenchmark.Run(gIterations, elapsedNS);
+        SuccessOrExit(err);
+
+        nsPerOp[i] = static_cast<double>(elapsedNS) / gIterations;
+    }
+
+    SortResults(nsPerOp, gRepeats);
+
+    median = ((gRepeats & 1) != 0) ? nsPerOp[gRepeats / 2] : (nsPerOp[gRepeats / 2 - 1] + nsPerOp[gRepeats / 2]) / 2;
+
+    fprintf(aOutput,
+            "{\"benchmark\":\"%s\",\"iterations\":%" PRIu32 ",\"repeats\":%" PRIu32 ","
+            "\"median_ns_per_op\":%.1f,\"min_ns_per_op\":%.1f,\"max_ns_per_op\":%.1f,\"ops_per_sec\":%.0f}\n",
+            aBenchmark.Name, gIterations, gRepeats, median, nsPerOp[0], nsPerOp[gRepeats - 1],
+            (median > 0) ? 1e9 / median : 0.0);
+
+exit:
+    if (err != WEAVE_NO_ERROR)
+    {
+        fprintf(stderr, "%s: Benchmark %s failed: %s\n", TOOL_NAME, aBenchmark.Name, nl::ErrorStr(err));
+    }
+
+    return err;
+}
+
+static OptionDef gToolOptionDefs[] = { { "iterations", kArgumentRequired, 'i' },
+                                       { "repeat", kArgumentRequired, 'r' },
+                                       { "benchmark", kArgumentRequired, 'b' },
+                                       { "output", kArgumentRequired, 'o' },
+                                       { "list", kNoArgument, 'l' },
+                                       { } };
+
+static const char * gToolOptionHelp = "  -i, --iterations <num>\n"
+                                      "       Number of operations timed in each run of a benchmark. Defaults to 10000.\n"
+                                      "\n"
+                                      "  -r, --repeat <num>\n"
+                                      "       Number of timed runs of each benchmark; the median, fastest and slowest\n"
+                                      "       runs are reported. Defaults to 5.\n"
+                                      "\n"
+                                      "  -b, --benchmark <name>\n"
+                                      "       Only run the benchmarks whose name contains the given string.\n"
+                                      "\n"
+                                      "  -o, --output <filename>\n"
+                                      "       Append the results to the given file instead of writing them to stdout.\n"
+                                      "\n"
+                                      "  -l, --list\n"
+                                      "       List the benchmarks and exit.\n"
+                                      "\n";
+
+static OptionSet gToolOptions = { HandleOption, gToolOptionDefs, "GENERAL OPTIONS", gToolOptionHelp };
+
+static HelpOptions gHelpOptions(TOOL_NAME, "Usage: " TOOL_NAME " [<options...>]\n", WEAVE_VERSION_STRING "\n" WEAVE_TOOL_COPYRIGHT,
+                                "Run microbenchmarks of the Weave stack and report the results as JSON lines.\n");
+
+static OptionSet * gToolOptionSets[] = { &gToolOptions, &gHelpOptions, NULL };
+
+bool HandleOption(const char * progName, OptionSet * optSet, int id, const char * name, const char * arg)
+{
+    switch (id)
+    {
+    case 'i':
+        if (!ParseInt(arg, gIterations) || gIterations == 0)
+        {
+            PrintArgError("%s: Invalid value specified for iterations: %s\n", progName, arg);
+            return false;
+        }
+        break;
+
+    case 'r':
+        if (!ParseInt(arg, gRepeats) || gRepeats == 0 || gRepeats > kMaxRepeats)
+        {
+            PrintArgError("%s: Invalid value specified for repeat (1 to %d): %s\n", progName, kMaxRepeats, arg);
+            return false;
+        }
+        break;
+
+    case 'b':
+        gBenchmarkFilter = arg;
+        break;
+
+    case 'o':
+        gOutputFileName = arg;
+        break;
+
+    case 'l':
+        gListBenchmarks = true;
+        break;
+
+    default:
+        PrintArgError("%s: INTERNAL ERROR: Unhandled option: %s\n", progName, name);
+        return false;
+    }
+
+    return true;
+}
+
+int main(int argc, char * argv[])
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    FILE * output   = stdout;
+
+    InitToolCommon();
+
+    if (!ParseArgsFromEnvVar(TOOL_NAME, TOOL_OPTIONS_ENV_VAR_NAME, gToolOptionSets, NULL, true) ||
+        !ParseArgs(TOOL_NAME, argc, argv, gToolOptionSets))
+    {
+        exit(EXIT_FAILURE);
+    }
+
+    if (gListBenchmarks)
+    {
+        for (size_t i = 0; i < kNumBenchmarks; i++)
+        {
+            printf("%s\n", sBenchmarks[i].Name);
+        }
+        exit(EXIT_SUCCESS);
+    }
+
+    if (gOutputFileName != NULL)
+    {
+        output = fopen(gOutputFileName, "a");
+        if (output == NULL)
+        {
+            fprintf(stderr, "%s: Unable to open %s\n", TOOL_NAME, gOutputFileName);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    for (size_t i = 0; i < sizeof(sMsgPayload); i++)
+    {
+        sMsgPayload[i] = static_cast<uint8_t>(i * 7 + 3);
+    }
+
+    InitSystemLayer();
+
+    err = sFabricState.Init();
+    SuccessOrExit(err);
+
+    sFabricState.LocalNodeId = kLocalNodeId;
+
+    err = InitMessageSecurity();
+    SuccessOrExit(err);
+
+    InitEventLogging();
+
+    for (size_t i = 0; i < kNumBenchmarks; i++)
+    {
+        if (gBenchmarkFilter != NULL && strstr(sBenchmarks[i].Name, gBenchmarkFilter) == NULL)
+            continue;
+
+        err = RunBenchmark(sBenchmarks[i], output);
+        SuccessOrExit(err);
+    }
+
+exit:
+    LoggingManagement::DestroyLoggingManagement();
+
+    ShutdownSystemLayer();
+
+    if (output != stdout)
+    {
+        fclose(output);
+    }
+
+    if (err != WEAVE_NO_ERROR)
+    {
+        fprintf(stderr, "%s: %s\n", TOOL_NAME, nl::ErrorStr(err));
+    }
+
+    return (err == WEAVE_NO_ERROR) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
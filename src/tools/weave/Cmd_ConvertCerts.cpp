@@ -0,0 +1,655 @@
+/*
+ *
+ *    Copyright (c) 2018 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements the command handler for the 'weave' tool
+ *      that converts a stream of X.509 certificates to Weave form,
+ *      using multiple threads.
+ *
+ */
+
+#ifndef __STDC_LIMIT_MACROS
+#define __STDC_LIMIT_MACROS
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <getopt.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/time.h>
+
+#include "weave-tool.h"
+
+#include <Weave/Support/Base64.h>
+
+using namespace nl::Weave::Profiles::Security;
+
+#define CMD_NAME "weave convert-certs"
+
+static bool HandleOption(const char *progName, OptionSet *optSet, int id, const char *name, const char *arg);
+static bool HandleNonOptionArgs(const char *progName, int argc, char *argv[]);
+
+static OptionDef gCmdOptionDefs[] =
+{
+    { "weave",      kNoArgument,       'w' },
+    { "weave-b64",  kNoArgument,       'b' },
+    { "threads",    kArgumentRequired, 't' },
+    { "stats",      kNoArgument,       's' },
+    { }
+};
+
+static const char *const gCmdOptionHelp =
+    "  -w, --weave\n"
+    "\n"
+    "       Output the Weave certificates in raw TLV format, one after another.\n"
+    "\n"
+    "  -b --weave-b64\n"
+    "\n"
+    "       Output the Weave certificates in base-64 format, one per line. This is\n"
+    "       the default.\n"
+    "\n"
+    "  -t, --threads <num>\n"
+    "\n"
+    "       Number of threads used to convert certificates. Defaults to the number\n"
+    "       of online processors.\n"
+    "\n"
+    "  -s, --stats\n"
+    "\n"
+    "       Print the number of certificates converted and the conversion rate to\n"
+    "       stderr.\n"
+    "\n"
+    ;
+
+static OptionSet gCmdOptions =
+{
+    HandleOption,
+    gCmdOptionDefs,
+    "COMMAND OPTIONS",
+    gCmdOptionHelp
+};
+
+static HelpOptions gHelpOptions(
+    CMD_NAME,
+    "Usage: " CMD_NAME " [ <options...> ] <in-file> <out-file>\n",
+    WEAVE_VERSION_STRING "\n" COPYRIGHT_STRING,
+    "Convert a stream of X.509 certificates to Weave form.\n"
+    "\n"
+    "ARGUMENTS\n"
+    "\n"
+    "  <in-file>\n"
+    "\n"
+    "       The input file name, or - to read from stdin. The input can be any\n"
+    "       number of X.509 certificates, either in PEM format (text outside the\n"
+    "       certificate markers is ignored) or concatenated in DER format.\n"
+    "\n"
+    "  <out-file>\n"
+    "\n"
+    "       The output file name, or - to write to stdout. The certificates are\n"
+    "       written in input order.\n"
+    "\n"
+);
+
+static OptionSet *gCmdOptionSets[] =
+{
+    &gCmdOptions,
+    &gHelpOptions,
+    NULL
+};
+
+enum
+{
+    kInputBufSize       = 4 * 1024 * 1024,  // Size of the buffer holding unconverted input.
+    kMaxBatchSize       = 16384,            // Maximum number of certificates converted in one batch.
+    kMaxThreads         = 256,
+    kInitialArenaSize   = 256 * 1024,
+};
+
+static const char kPEMCertBegin[] = "-----BEGIN CERTIFICATE-----";
+static const char kPEMCertEnd[] = "-----END CERTIFICATE-----";
+static const uint32_t kPEMCertBeginLen = sizeof(kPEMCertBegin) - 1;
+static const uint32_t kPEMCertEndLen = sizeof(kPEMCertEnd) - 1;
+
+struct CertRecord
+{
+    const uint8_t *Data;
+    uint32_t DataLen;
+};
+
+/**
+ * State owned by a single conversion thread.
+ *
+ * Each thread converts a contiguous run of the certificates in a batch, appending the results
+ * to its output arena, which is then written out as a whole.  The arena is reused for every
+ * batch and only grows, so that conversion does not allocate once it reaches a steady state.
+ */
+struct ConvertWorker
+{
+    pthread_t Thread;
+    const CertRecord *Records;
+    uint32_t NumRecords;
+    uint32_t FirstCertIndex;
+    uint8_t *Arena;
+    uint32_t ArenaLen;
+    uint32_t ArenaSize;
+    uint32_t ErrorCertIndex;
+    WEAVE_ERROR Err;
+    char B64Cert[MAX_CERT_SIZE];
+    uint8_t DERCert[MAX_CERT_SIZE];
+    uint8_t WeaveCert[MAX_CERT_SIZE];
+};
+
+static const char *gInFileName = NULL;
+static const char *gOutFileName = NULL;
+static CertFormat gOutCertFormat = kCertFormat_Weave_Base64;
+static int32_t gNumThreads = 0;
+static bool gPrintStats = false;
+
+static bool FindCerts(const uint8_t *data, uint32_t dataLen, bool atEOF, CertFormat inCertFormat,
+                      CertRecord *records, uint32_t& numRecords, uint32_t& consumedLen);
+static bool ConvertBatch(ConvertWorker *workers, uint32_t numWorkers, const CertRecord *records, uint32_t numRecords,
+                         uint32_t firstCertIndex, uint32_t& numActiveWorkers);
+static void *ConvertWorkerMain(void *arg);
+static WEAVE_ERROR ConvertCert(ConvertWorker& worker, const CertRecord& record);
+static double GetTimeSeconds(void);
+
+bool Cmd_ConvertCerts(int argc, char *argv[])
+{
+    bool res = true;
+    FILE *inFile = NULL;
+    FILE *outFile = NULL;
+    bool outFileCreated = false;
+    uint8_t *inBuf = NULL;
+    uint32_t inDataLen = 0;
+    bool atEOF = false;
+    CertFormat inCertFormat = kCertFormat_Unknown;
+    CertRecord *records = NULL;
+    ConvertWorker *workers = NULL;
+    uint32_t numWorkers = 0;
+    uint32_t certCount = 0;
+    double startTime;
+
+    if (argc == 1)
+    {
+        gHelpOptions.PrintBriefUsage(stderr);
+        ExitNow(res = true);
+    }
+
+    if (!ParseArgs(CMD_NAME, argc, argv, gCmdOptionSets, HandleNonOptionArgs))
+    {
+        ExitNow(res = false);
+    }
+
+    if (gNumThreads == 0)
+    {
+        long numProcessors = sysconf(_SC_NPROCESSORS_ONLN);
+        gNumThreads = (numProcessors < 1) ? 1 : (numProcessors > kMaxThreads) ? kMaxThreads : (int32_t)numProcessors;
+    }
+    numWorkers = (uint32_t)gNumThreads;
+
+    inBuf = (uint8_t *)malloc(kInputBufSize);
+    records = (CertRecord *)malloc(kMaxBatchSize * sizeof(CertRecord));
+    workers = (ConvertWorker *)calloc(numWorkers, sizeof(ConvertWorker));
+    if (inBuf == NULL || records == NULL || workers == NULL)
+    {
+        fprintf(stderr, "weave: Memory allocation error\n");
+        ExitNow(res = false);
+    }
+
+    if (strcmp(gInFileName, "-") != 0)
+    {
+        inFile = fopen(gInFileName, "rb");
+        if (inFile == NULL)
+        {
+            fprintf(stderr, "weave: Unable to open %s\n%s\n", gInFileName, strerror(errno));
+            ExitNow(res = false);
+        }
+    }
+    else
+        inFile = stdin;
+
+    if (strcmp(gOutFileName, "-") != 0)
+    {
+        outFile = fopen(gOutFileName, "w+b");
+        if (outFile == NULL)
+        {
+            fprintf(stderr, "weave: ERROR: Unable to create %s\n%s\n", gOutFileName, strerror(errno));
+            ExitNow(res = false);
+        }
+        outFileCreated = true;
+    }
+    else
+        outFile = stdout;
+
+    startTime = GetTimeSeconds();
+
+    while (true)
+    {
+        uint32_t numRecords = 0;
+        uint32_t consumedLen = 0;
+        uint32_t numActiveWorkers = 0;
+
+        if (!atEOF && inDataLen < kInputBufSize)
+        {
+            inDataLen += fread(inBuf + inDataLen, 1, kInputBufSize - inDataLen, inFile);
+            if (ferror(inFile))
+            {
+                fprintf(stderr, "weave: Error reading %s\n%s\n", gInFileName, strerror(errno));
+                ExitNow(res = false);
+            }
+            atEOF = (feof(inFile) != 0);
+        }
+
+        // The input format is decided by the first certificate: a DER certificate always begins with a SEQUENCE tag.
+        if (inCertFormat == kCertFormat_Unknown)
+        {
+            uint32_t i = 0;
+            while (i < inDataLen && isspace(inBuf[i]))
+                i++;
+            if (i < inDataLen)
+                inCertFormat = (inBuf[i] == 0x30) ? kCertFormat_X509_DER : kCertFormat_X509_PEM;
+            else if (atEOF)
+                break;
+            else
+            {
+                inDataLen = 0;
+                continue;
+            }
+        }
+
+        if (!FindCerts(inBuf, inDataLen, atEOF, inCertFormat, records, numRecords, consumedLen))
+            ExitNow(res = false);
+
+        if (numRecords > 0)
+        {
+            if (!ConvertBatch(workers, numWorkers, records, numRecords, certCount, numActiveWorkers))
+                ExitNow(res = false);
+
+            for (uint32_t i = 0; i < numActiveWorkers; i++)
+            {
+                if (workers[i].Err != WEAVE_NO_ERROR)
+                {
+                    fprintf(stderr, "weave: Error converting certificate %u: %s\n", workers[i].ErrorCertIndex + 1, nl::ErrorStr(workers[i].Err));
+                    ExitNow(res = false);
+                }
+
+                if (fwrite(workers[i].Arena, 1, workers[i].ArenaLen, outFile) != workers[i].ArenaLen)
+                {
+                    fprintf(stderr, "weave: ERROR: Unable to write to %s\n%s\n", gOutFileName, strerror(ferror(outFile) ? errno : ENOSPC));
+                    ExitNow(res = false);
+                }
+            }
+
+            certCount += numRecords;
+        }
+        else if (atEOF)
+            break;
+        else if (consumedLen == 0 && inDataLen == kInputBufSize)
+        {
+            fprintf(stderr, "weave: Input certificate too big\n");
+            ExitNow(res = false);
+        }
+
+        memmove(inBuf, inBuf + consumedLen, inDataLen - consumedLen);
+        inDataLen -= consumedLen;
+    }
+
+    if (fflush(outFile) != 0)
+    {
+        fprintf(stderr, "weave: ERROR: Unable to write to %s\n%s\n", gOutFileName, strerror(errno));
+        ExitNow(res = false);
+    }
+
+    if (gPrintStats)
+    {
+        double elapsed = GetTimeSeconds() - startTime;
+
+        fprintf(stderr, "weave: Converted %u certificates in %.3f seconds using %u threads (%.0f certificates/second)\n",
+                certCount, elapsed, numWorkers, (elapsed > 0) ? certCount / elapsed : 0.0);
+    }
+
+exit:
+    if (inFile != NULL && inFile != stdin)
+        fclose(inFile);
+    if (outFile != NULL && outFile != stdout)
+        fclose(outFile);
+    if (gOutFileName != NULL && outFileCreated && !res)
+        unlink(gOutFileName);
+    if (workers != NULL)
+    {
+        for (uint32_t i = 0; i < numWorkers; i++)
+            free(workers[i].Arena);
+        free(workers);
+    }
+    free(records);
+    free(inBuf);
+    return res;
+}
+
+/**
+ * Locate the complete certificates at the start of the input data.
+ *
+ * @param[out] consumedLen  Length of the input up to the end of the last certificate found,
+ *                          or up to the point from which the next search must resume.
+ *
+ * @return false, after printing an error, if the input is malformed or a certificate is truncated.
+ */
+static bool FindCerts(const uint8_t *data, uint32_t dataLen, bool atEOF, CertFormat inCertFormat,
+                      CertRecord *records, uint32_t& numRecords, uint32_t& consumedLen)
+{
+    uint32_t pos = 0;
+
+    numRecords = 0;
+    consumedLen = 0;
+
+    if (inCertFormat == kCertFormat_X509_PEM)
+    {
+        while (numRecords < kMaxBatchSize)
+        {
+            const uint8_t *begin = (const uint8_t *)memmem(data + pos, dataLen - pos, kPEMCertBegin, kPEMCertBeginLen);
+            const uint8_t *end;
+
+            if (begin == NULL)
+            {
+                // Skip the text, keeping what could be the start of a marker at the end of the data.
+                if (atEOF)
+                    consumedLen = dataLen;
+                else if (dataLen - pos >= kPEMCertBeginLen)
+                    consumedLen = dataLen - (kPEMCertBeginLen - 1);
+                break;
+            }
+
+            end = (const uint8_t *)memmem(begin, dataLen - (begin - data), kPEMCertEnd, kPEMCertEndLen);
+            if (end == NULL)
+            {
+                if (atEOF)
+                {
+                    fprintf(stderr, "weave: Truncated PEM certificate at end of input\n");
+                    return false;
+                }
+                consumedLen = begin - data;
+                break;
+            }
+
+            end += kPEMCertEndLen;
+            if (end - begin > MAX_CERT_SIZE)
+            {
+                fprintf(stderr, "weave: Input certificate too big\n");
+                return false;
+            }
+
+            records[numRecords].Data = begin;
+            records[numRecords].DataLen = end - begin;
+            numRecords++;
+
+            pos = consumedLen = end - data;
+        }
+    }
+    else
+    {
+        while (numRecords < kMaxBatchSize && pos < dataLen)
+        {
+            const uint8_t *cert = data + pos;
+            uint32_t availLen = dataLen - pos;
+            uint32_t certLen;
+
+            if (cert[0] != 0x30)
+            {
+                fprintf(stderr, "weave: Invalid DER certificate at offset %u of input\n", pos);
+                return false;
+            }
+
+            if (availLen < 2)
+                break;
+
+            if (cert[1] < 0x80)
+                certLen = 2 + cert[1];
+            else
+            {
+                uint32_t lenLen = cert[1] & 0x7F;
+
+                if (lenLen == 0 || lenLen > 3)
+                {
+                    fprintf(stderr, "weave: Invalid DER certificate at offset %u of input\n", pos);
+                    return false;
+                }
+
+                if (availLen < 2 + lenLen)
+                    break;
+
+                certLen = 0;
+                for (uint32_t i = 0; i < lenLen; i++)
+                    certLen = (certLen << 8) | cert[2 + i];
+                certLen += 2 + lenLen;
+            }
+
+            if (certLen > MAX_CERT_SIZE)
+            {
+                fprintf(stderr, "weave: Input certificate too big\n");
+                return false;
+            }
+
+            if (availLen < certLen)
+                break;
+
+            records[numRecords].Data = cert;
+            records[numRecords].DataLen = certLen;
+            numRecords++;
+
+            pos += certLen;
+        }
+
+        consumedLen = pos;
+
+        if (atEOF && numRecords < kMaxBatchSize && pos < dataLen)
+        {
+            fprintf(stderr, "weave: Truncated DER certificate at end of input\n");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Convert a batch of certificates, dividing it into contiguous runs, one per thread.
+ *
+ * The calling thread converts the first run itself.  On return, the results of the batch
+ * are held, in order, in the arenas of the first numActiveWorkers workers.
+ */
+static bool ConvertBatch(ConvertWorker *workers, uint32_t numWorkers, const CertRecord *records, uint32_t numRecords,
+                         uint32_t firstCertIndex, uint32_t& numActiveWorkers)
+{
+    bool res = true;
+    uint32_t numStarted = 1;
+
+    numActiveWorkers = (numRecords < numWorkers) ? numRecords : numWorkers;
+
+    for (uint32_t i = 0; i < numActiveWorkers; i++)
+    {
+        uint32_t start = (uint32_t)(((uint64_t)numRecords * i) / numActiveWorkers);
+        uint32_t end = (uint32_t)(((uint64_t)numRecords * (i + 1)) / numActiveWorkers);
+
+        workers[i].Records = records + start;
+        workers[i].NumRecords = end - start;
+        workers[i].FirstCertIndex = firstCertIndex + start;
+    }
+
+    for (; numStarted < numActiveWorkers; numStarted++)
+    {
+        int pthreadErr = pthread_create(&workers[numStarted].Thread, NULL, ConvertWorkerMain, &workers[numStarted]);
+        if (pthreadErr != 0)
+        {
+            fprintf(stderr, "weave: Unable to start conversion thread\n%s\n", strerror(pthreadErr));
+            res = false;
+            break;
+        }
+    }
+
+    ConvertWorkerMain(&workers[0]);
+
+    for (uint32_t i = 1; i < numStarted; i++)
+        pthread_join(workers[i].Thread, NULL);
+
+    return res;
+}
+
+static void *ConvertWorkerMain(void *arg)
+{
+    ConvertWorker& worker = *(ConvertWorker *)arg;
+
+    worker.ArenaLen = 0;
+    worker.Err = WEAVE_NO_ERROR;
+
+    for (uint32_t i = 0; i < worker.NumRecords; i++)
+    {
+        worker.Err = ConvertCert(worker, worker.Records[i]);
+        if (worker.Err != WEAVE_NO_ERROR)
+        {
+            worker.ErrorCertIndex = worker.FirstCertIndex + i;
+            break;
+        }
+    }
+
+    return NULL;
+}
+
+static WEAVE_ERROR ConvertCert(ConvertWorker& worker, const CertRecord& record)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    const uint8_t *derCert = record.Data;
+    uint32_t derCertLen = record.DataLen;
+    uint32_t weaveCertLen;
+    uint32_t outLen;
+
+    if (record.Data[0] != 0x30)
+    {
+        // Gather the base-64 text between the PEM markers, without line breaks, and decode it.
+        uint32_t b64Len = 0;
+
+        for (uint32_t i = kPEMCertBeginLen; i < record.DataLen - kPEMCertEndLen; i++)
+            if (!isspace(record.Data[i]))
+                worker.B64Cert[b64Len++] = (char)record.Data[i];
+
+        derCertLen = nl::Base64Decode32(worker.B64Cert, b64Len, worker.DERCert);
+        VerifyOrExit(derCertLen != UINT32_MAX, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+        derCert = worker.DERCert;
+    }
+
+    err = ConvertX509CertToWeaveCert(derCert, derCertLen, worker.WeaveCert, sizeof(worker.WeaveCert), weaveCertLen);
+    SuccessOrExit(err);
+
+    outLen = (gOutCertFormat == kCertFormat_Weave_Base64) ? BASE64_ENCODED_LEN(weaveCertLen) + 1 : weaveCertLen;
+
+    if (worker.ArenaSize - worker.ArenaLen < outLen)
+    {
+        uint32_t newSize = (worker.ArenaSize != 0) ? worker.ArenaSize : kInitialArenaSize;
+        uint8_t *newArena;
+
+        while (newSize - worker.ArenaLen < outLen)
+            newSize *= 2;
+
+        newArena = (uint8_t *)realloc(worker.Arena, newSize);
+        VerifyOrExit(newArena != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+        worker.Arena = newArena;
+        worker.ArenaSize = newSize;
+    }
+
+    if (gOutCertFormat == kCertFormat_Weave_Base64)
+    {
+        outLen = nl::Base64Encode32(worker.WeaveCert, weaveCertLen, (char *)(worker.Arena + worker.ArenaLen));
+        worker.Arena[worker.ArenaLen + outLen] = '\n';
+        worker.ArenaLen += outLen + 1;
+    }
+    else
+    {
+        memcpy(worker.Arena + worker.ArenaLen, worker.WeaveCert, weaveCertLen);
+        worker.ArenaLen += weaveCertLen;
+    }
+
+exit:
+    return err;
+}
+
+static double GetTimeSeconds(void)
+{
+    struct timeval now;
+
+    gettimeofday(&now, NULL);
+    return now.tv_sec + now.tv_usec / 1000000.0;
+}
+
+bool HandleOption(const char *progName, OptionSet *optSet, int id, const char *name, const char *arg)
+{
+    switch (id)
+    {
+    case 'w':
+        gOutCertFormat = kCertFormat_Weave_Raw;
+        break;
+    case 'b':
+        gOutCertFormat = kCertFormat_Weave_Base64;
+        break;
+    case 't':
+        if (!ParseInt(arg, gNumThreads) || gNumThreads < 1 || gNumThreads > kMaxThreads)
+        {
+            PrintArgError("%s: Invalid value specified for number of threads: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case 's':
+        gPrintStats = true;
+        break;
+    default:
+        PrintArgError("%s: INTERNAL ERROR: Unhandled option: %s\n", progName, name);
+        return false;
+    }
+
+    return true;
+}
+
+bool HandleNonOptionArgs(const char *progName, int argc, char *argv[])
+{
+    if (argc == 0)
+    {
+        PrintArgError("%s: Please specify the name of the input certificate file, or - for stdin.\n", progName);
+        return false;
+    }
+
+    if (argc == 1)
+    {
+        PrintArgError("%s: Please specify the name of the output certificate file, or - for stdout\n", progName);
+        return false;
+    }
+
+    if (argc > 2)
+    {
+        PrintArgError("%s: Unexpected argument: %s\n", progName, argv[2]);
+        return false;
+    }
+
+    gInFileName = argv[0];
+    gOutFileName = argv[1];
+
+    return true;
+}
@@ -51,6 +51,8 @@ static const char *const sHelp =
         "\n"
         "    convert-cert -- Convert a certificate between Weave and X509 form.\n"
         "\n"
+        "    convert-certs -- Convert a stream of X509 certificates to Weave form.\n"
+        "\n"
         "    convert-key -- Convert a private key between Weave and PEM/DER form.\n"
         "\n"
         "    convert-provisioning-data -- Perform various conversions on a device provisioning data file.\n"
@@ -116,6 +118,9 @@ int main(int argc, char *argv[])
     else if (strcasecmp(argv[1], "convert-cert") == 0 || strcasecmp(argv[1], "convertcert") == 0)
         res = Cmd_ConvertCert(argc - 1, argv + 1);
 
+    else if (strcasecmp(argv[1], "convert-certs") == 0 || strcasecmp(argv[1], "convertcerts") == 0)
+        res = Cmd_ConvertCerts(argc - 1, argv + 1);
+
     else if (strcasecmp(argv[1], "convert-key") == 0 || strcasecmp(argv[1], "convertkey") == 0)
         res = Cmd_ConvertKey(argc - 1, argv + 1);
 
@@ -85,6 +85,7 @@ extern bool Cmd_GenCodeSigningCert(int argc, char *argv[]);
 extern bool Cmd_GenServiceEndpointCert(int argc, char *argv[]);
 extern bool Cmd_GenGeneralCert(int argc, char *argv[]);
 extern bool Cmd_ConvertCert(int argc, char *argv[]);
+extern bool Cmd_ConvertCerts(int argc, char *argv[]);
 extern bool Cmd_ConvertKey(int argc, char *argv[]);
 extern bool Cmd_ConvertProvisioningData(int argc, char *argv[]);
 extern bool Cmd_ResignCert(int argc, char *argv[]);